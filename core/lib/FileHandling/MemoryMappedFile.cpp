@@ -0,0 +1,133 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+/**
+ * @file MemoryMappedFile.cpp
+ * Read-only view of the complete contents of a file.
+ */
+
+#include "MemoryMappedFile.hpp"
+
+#ifdef _WIN32
+#include <fstream>
+#else
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace gpstk
+{
+   MemoryMappedFile ::
+   MemoryMappedFile()
+         : mapData(0), mapSize(0)
+   {
+   }
+
+
+   MemoryMappedFile ::
+   ~MemoryMappedFile()
+   {
+      close();
+   }
+
+
+   bool MemoryMappedFile ::
+   open(const std::string& fn)
+   {
+      close();
+
+#ifdef _WIN32
+      std::ifstream ifs(fn.c_str(), std::ios::in | std::ios::binary);
+      if (!ifs)
+         return false;
+      ifs.seekg(0, std::ios::end);
+      std::streamoff len = ifs.tellg();
+      if (len <= 0)
+         return false;
+      buffer.resize(static_cast<std::size_t>(len));
+      ifs.seekg(0, std::ios::beg);
+      if (!ifs.read(&buffer[0], len))
+      {
+         buffer.clear();
+         return false;
+      }
+      mapData = &buffer[0];
+      mapSize = buffer.size();
+#else
+      int fd = ::open(fn.c_str(), O_RDONLY);
+      if (fd < 0)
+         return false;
+      struct stat st;
+      if ((fstat(fd, &st) != 0) || !S_ISREG(st.st_mode) || (st.st_size <= 0))
+      {
+         ::close(fd);
+         return false;
+      }
+      void *addr = mmap(0, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+         // the mapping holds its own reference to the file
+      ::close(fd);
+      if (addr == MAP_FAILED)
+         return false;
+#ifdef MADV_SEQUENTIAL
+         // file formats are nearly always read front to back
+      madvise(addr, st.st_size, MADV_SEQUENTIAL);
+#endif
+      mapData = static_cast<const char*>(addr);
+      mapSize = static_cast<std::size_t>(st.st_size);
+#endif
+
+      return true;
+   }  // End of method 'MemoryMappedFile::open()'
+
+
+   void MemoryMappedFile ::
+   close()
+   {
+      if (mapData == 0)
+         return;
+#ifdef _WIN32
+      buffer.clear();
+#else
+      munmap(const_cast<char*>(mapData), mapSize);
+#endif
+      mapData = 0;
+      mapSize = 0;
+   }  // End of method 'MemoryMappedFile::close()'
+
+}  // End of namespace gpstk
@@ -0,0 +1,114 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+/**
+ * @file MemoryMappedFile.hpp
+ * Read-only view of the complete contents of a file.
+ */
+
+#ifndef GPSTK_MEMORYMAPPEDFILE_HPP
+#define GPSTK_MEMORYMAPPEDFILE_HPP
+
+#include <string>
+#include <vector>
+#include <cstddef>
+
+namespace gpstk
+{
+      /// @ingroup FileHandling
+      //@{
+
+      /**
+       * Provide read-only random access to the contents of a file
+       * without copying them through a stream buffer.  On POSIX
+       * systems the file is mapped into memory with mmap(); elsewhere
+       * the file is read into a private buffer once when opened.
+       *
+       * The view remains valid until close() is called or the object
+       * is destroyed.  The contents of a mapped file that is modified
+       * by another process while mapped are undefined.
+       *
+       * Objects of this class are not copyable.
+       */
+   class MemoryMappedFile
+   {
+   public:
+         /// Create an object with no file attached.
+      MemoryMappedFile();
+
+         /// Release the mapping, if any.
+      ~MemoryMappedFile();
+
+         /** Map the file \a fn, replacing any current mapping.
+          * @param[in] fn the name of the file to map.
+          * @return true if the file was mapped; false if it could not
+          *   be opened, is empty, or is not a regular file. */
+      bool open(const std::string& fn);
+
+         /// Release the mapping, if any.
+      void close();
+
+         /// @return true if a file is currently mapped.
+      bool isOpen() const
+      { return (mapData != 0); }
+
+         /// @return the start of the file contents, or 0 if not open.
+      const char* data() const
+      { return mapData; }
+
+         /// @return the number of bytes in the mapped file.
+      std::size_t size() const
+      { return mapSize; }
+
+   private:
+         /// Not copyable.
+      MemoryMappedFile(const MemoryMappedFile&);
+         /// Not assignable.
+      MemoryMappedFile& operator=(const MemoryMappedFile&);
+
+         /// Start of the file contents.
+      const char* mapData;
+         /// Size of the file contents in bytes.
+      std::size_t mapSize;
+         /// Copy of the file where mmap() is not available.
+      std::vector<char> buffer;
+   }; // End of class 'MemoryMappedFile'
+
+      //@}
+
+}  // End of namespace gpstk
+
+#endif   // GPSTK_MEMORYMAPPEDFILE_HPP
@@ -109,6 +109,11 @@ namespace gpstk
          /// The header for this file.
       RinexObsHeader header;
 
+         /** Time of the last epoch read that had a time.  Event
+          * records (epoch flags 2-4) may omit the time, in which case
+          * this one is used. */
+      CommonTime previousTime;
+
          /// Check if the input stream is the kind of RinexObsStream
       static bool isRinexObsStream(std::istream& i);
 
@@ -0,0 +1,346 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+/**
+ * @file Rinex3ObsColumnData.cpp
+ * RINEX observation epoch stored as flat, reusable arrays.
+ */
+
+#include <limits>
+
+#include "Rinex3ObsStream.hpp"
+#include "Rinex3ObsFields.hpp"
+#include "Rinex3ObsColumnData.hpp"
+
+using namespace std;
+
+namespace gpstk
+{
+   const unsigned char Rinex3ObsColumnData::blankFlag;
+
+
+   Rinex3ObsColumnData::Rinex3ObsColumnData()
+         : time(gpstk::CommonTime::BEGINNING_OF_TIME),
+           epochFlag(-1),
+           numSVs(-1),
+           clockOffset(0.L)
+   {
+      rowStart.push_back(0);
+   }
+
+
+   void Rinex3ObsColumnData::clear()
+   {
+      sats.clear();
+      rowStart.resize(1);
+      rowStart[0] = 0;
+      data.clear();
+      lliSsi.clear();
+   }
+
+
+   bool Rinex3ObsColumnData::findSat( const RinexSatID& sat,
+                                      size_t& index ) const
+   {
+      vector<RinexSatID>::const_iterator it;
+      it = lower_bound(sats.begin(), sats.end(), sat);
+      if(it == sats.end() || *it != sat)
+         return false;
+      index = it - sats.begin();
+      return true;
+   }
+
+
+   short Rinex3ObsColumnData::getLLI(size_t i, size_t j) const
+   {
+      unsigned char f = lliSsi[rowStart[i] + j] & 0x0F;
+      return (f == blankFlag ? 0 : f);
+   }
+
+
+   short Rinex3ObsColumnData::getSSI(size_t i, size_t j) const
+   {
+      unsigned char f = lliSsi[rowStart[i] + j] >> 4;
+      return (f == blankFlag ? 0 : f);
+   }
+
+
+   RinexDatum Rinex3ObsColumnData::getDatum(size_t i, size_t j) const
+   {
+      RinexDatum rd;
+      double d = data[rowStart[i] + j];
+      rd.dataBlank = (d != d);
+      rd.data = (rd.dataBlank ? 0. : d);
+      unsigned char f = lliSsi[rowStart[i] + j];
+      rd.lliBlank = ((f & 0x0F) == blankFlag);
+      rd.lli = (rd.lliBlank ? 0 : (f & 0x0F));
+      rd.ssiBlank = ((f >> 4) == blankFlag);
+      rd.ssi = (rd.ssiBlank ? 0 : (f >> 4));
+      return rd;
+   }
+
+
+   void Rinex3ObsColumnData::setDatum( size_t i, size_t j,
+                                       const RinexDatum& rd )
+   {
+      data[rowStart[i] + j] = (rd.dataBlank
+                               ? numeric_limits<double>::quiet_NaN()
+                               : rd.data);
+      lliSsi[rowStart[i] + j] = packFlags(rd);
+   }
+
+
+   size_t Rinex3ObsColumnData::addSat(const RinexSatID& sat, size_t nobs)
+   {
+      sats.push_back(sat);
+      size_t end = rowStart.back() + nobs;
+      rowStart.push_back(end);
+      data.resize(end, numeric_limits<double>::quiet_NaN());
+      lliSsi.resize(end, (blankFlag << 4) | blankFlag);
+      return sats.size() - 1;
+   }
+
+
+   unsigned char Rinex3ObsColumnData::packFlags(const RinexDatum& rd)
+   {
+         // The writer only leaves a blank flag blank when it is zero.
+      unsigned char lli = ((rd.lliBlank && rd.lli == 0) ? blankFlag
+                           : (rd.lli & 0x0F));
+      unsigned char ssi = ((rd.ssiBlank && rd.ssi == 0) ? blankFlag
+                           : (rd.ssi & 0x0F));
+      return (ssi << 4) | lli;
+   }
+
+
+   void Rinex3ObsColumnData::fromObsData(const Rinex3ObsData& rod)
+   {
+      time = rod.time;
+      epochFlag = rod.epochFlag;
+      numSVs = rod.numSVs;
+      clockOffset = rod.clockOffset;
+      auxHeader = rod.auxHeader;
+
+      clear();
+      Rinex3ObsData::DataMap::const_iterator it;
+      for(it = rod.obs.begin(); it != rod.obs.end(); it++)
+      {
+         size_t i = addSat(it->first, it->second.size());
+         for(size_t j = 0; j < it->second.size(); j++)
+            setDatum(i, j, it->second[j]);
+      }
+   }
+
+
+   void Rinex3ObsColumnData::toObsData(Rinex3ObsData& rod) const
+   {
+      rod.time = time;
+      rod.epochFlag = epochFlag;
+      rod.numSVs = numSVs;
+      rod.clockOffset = clockOffset;
+      rod.auxHeader = auxHeader;
+
+      rod.obs.clear();
+      for(size_t i = 0; i < sats.size(); i++)
+      {
+         Rinex3ObsData::DataMap::iterator it = rod.obs.insert(
+            rod.obs.end(), make_pair(sats[i], vector<RinexDatum>()));
+         it->second.resize(numObs(i));
+         for(size_t j = 0; j < numObs(i); j++)
+            it->second[j] = getDatum(i, j);
+      }
+   }
+
+
+   void Rinex3ObsColumnData::sortSats()
+   {
+      size_t n = sats.size();
+
+         // stable insertion sort of the row order; epochs are short
+      order.resize(n);
+      for(size_t i = 0; i < n; i++)
+      {
+         size_t k = i;
+         while(k > 0 && sats[i] < sats[order[k-1]])
+         {
+            order[k] = order[k-1];
+            k--;
+         }
+         order[k] = i;
+      }
+
+      bool sorted = true;
+      for(size_t i = 0; i < n && sorted; i++)
+         sorted = (order[i] == i && (i+1 == n || sats[i] != sats[i+1]));
+      if(sorted)
+         return;
+
+      sortSatList.clear();
+      sortStart.resize(1);
+      sortStart[0] = 0;
+      sortData.clear();
+      sortFlags.clear();
+      for(size_t k = 0; k < n; k++)
+      {
+         size_t i = order[k];
+            // a repeated satellite replaces the earlier row, as it
+            // would in Rinex3ObsData::obs
+         if(k+1 < n && sats[order[k+1]] == sats[i])
+            continue;
+         sortSatList.push_back(sats[i]);
+         sortData.insert(sortData.end(), data.begin() + rowStart[i],
+                         data.begin() + rowStart[i+1]);
+         sortFlags.insert(sortFlags.end(), lliSsi.begin() + rowStart[i],
+                          lliSsi.begin() + rowStart[i+1]);
+         sortStart.push_back(sortData.size());
+      }
+      sats.swap(sortSatList);
+      rowStart.swap(sortStart);
+      data.swap(sortData);
+      lliSsi.swap(sortFlags);
+   }  // End of method 'Rinex3ObsColumnData::sortSats()'
+
+
+   bool Rinex3ObsColumnData::getEpochVer3( Rinex3ObsStream& strm,
+                                           Rinex3ObsFields::LineReader& reader )
+   {
+      const char *line;
+      size_t len;
+      CommonTime t;
+      short flag, nsv;
+      double clk;
+
+      if(!reader.next(line, len) ||
+         !Rinex3ObsFields::getEpochLine(line, len, strm.timesystem, t,
+                                        flag, nsv, clk))
+         return false;
+
+      clear();
+      char lastSys = 0;
+      size_t nobs = 0;
+      RinexDatum rd;
+      for(short isv = 0; isv < nsv; isv++)
+      {
+         if(!reader.next(line, len) || len < 3)
+            return false;
+
+         RinexSatID sat;
+         try
+         {
+            sat = Rinex3ObsFields::getSatID(line, len);
+         }
+         catch(Exception&)
+         {
+            return false;
+         }
+
+            // Rinex3ObsData would add an empty obs type list for an
+            // unknown system to the header; leave that to it.
+         char sys = sat.systemChar();
+         if(sys != lastSys)
+         {
+            map<string, vector<RinexObsID> >::const_iterator it =
+               strm.header.mapObsTypes.find(string(1, sys));
+            if(it == strm.header.mapObsTypes.end())
+               return false;
+            nobs = it->second.size();
+            lastSys = sys;
+         }
+
+         size_t i = addSat(sat, nobs);
+         for(size_t j = 0; j < nobs; j++)
+         {
+            Rinex3ObsFields::getDatum(line, len, 3 + 16*j, rd);
+            setDatum(i, j, rd);
+         }
+      }
+      sortSats();
+
+      time = t;
+      epochFlag = flag;
+      numSVs = nsv;
+      clockOffset = clk;
+      if(auxHeader.valid != 0)
+         auxHeader = Rinex3ObsHeader();
+
+      return true;
+   }  // End of method 'Rinex3ObsColumnData::getEpochVer3()'
+
+
+   void Rinex3ObsColumnData::reallyGetRecord(FFStream& ffs)
+      throw(std::exception, FFStreamError, gpstk::StringUtils::StringException)
+   {
+      Rinex3ObsStream& strm = dynamic_cast<Rinex3ObsStream&>(ffs);
+
+         // If the header hasn't been read, read it.
+      if(!strm.headerRead) strm >> strm.header;
+
+      if(strm.header.version >= 3)
+      {
+         Rinex3ObsFields::LineReader reader(strm, lineBuffer);
+         if(reader.isValid())
+         {
+            if(getEpochVer3(strm, reader))
+            {
+               reader.commit();
+               return;
+            }
+            reader.rewind();
+         }
+      }
+
+         // everything else is read, and errors reported, by Rinex3ObsData
+      obsData.reallyGetRecord(strm);
+      fromObsData(obsData);
+   }  // End of method 'Rinex3ObsColumnData::reallyGetRecord()'
+
+
+   void Rinex3ObsColumnData::reallyPutRecord(FFStream& ffs) const
+      throw(std::exception, FFStreamError, gpstk::StringUtils::StringException)
+   {
+      Rinex3ObsData rod;
+      toObsData(rod);
+      rod.reallyPutRecord(ffs);
+   }
+
+
+   void Rinex3ObsColumnData::dump(ostream& s) const
+   {
+      Rinex3ObsData rod;
+      toObsData(rod);
+      rod.dump(s);
+   }
+
+} // End of namespace gpstk
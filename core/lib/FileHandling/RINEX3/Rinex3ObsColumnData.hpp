@@ -0,0 +1,241 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+/**
+ * @file Rinex3ObsColumnData.hpp
+ * RINEX observation epoch stored as flat, reusable arrays.
+ */
+
+#ifndef GPSTK_RINEX3OBSCOLUMNDATA_HPP
+#define GPSTK_RINEX3OBSCOLUMNDATA_HPP
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "CommonTime.hpp"
+#include "FFStream.hpp"
+#include "Rinex3ObsBase.hpp"
+#include "Rinex3ObsHeader.hpp"
+#include "Rinex3ObsData.hpp"
+#include "RinexDatum.hpp"
+
+namespace gpstk
+{
+   class Rinex3ObsStream;
+
+   namespace Rinex3ObsFields
+   {
+      class LineReader;
+   }
+
+      /// @ingroup FileHandling
+      //@{
+
+      /**
+       * This class holds the same RINEX observation epoch as
+       * Rinex3ObsData, but in a struct-of-arrays layout: a sorted
+       * satellite index, one contiguous array of observation values
+       * and one packed byte of LLI/SSI per value.  The row for
+       * satellite \c sats[i] occupies elements \c rowStart[i] to
+       * \c rowStart[i+1]-1 of \c data and \c lliSsi, and column \c j of
+       * a row is the observation type at index \c j of the header's
+       * obs type list for that satellite's system, exactly as in
+       * Rinex3ObsData::obs.
+       *
+       * Reading into the same object again reuses its arrays, so once
+       * they have grown to hold the largest epoch, reading RINEX 3
+       * observation epochs makes no heap allocations (see also
+       * Rinex3ObsStream::setMappedRead()).  RINEX 2 files and event
+       * records (epoch flags 2-5) are decoded by Rinex3ObsData and
+       * converted.
+       *
+       * Blank observations are stored as NaN, and a blank LLI or SSI
+       * as blankFlag.
+       *
+       * @sa Rinex3ObsData, Rinex3ObsStream and Rinex3ObsHeader.
+       */
+   class Rinex3ObsColumnData : public Rinex3ObsBase
+   {
+   public:
+         /// Value of an LLI or SSI field of lliSsi that is blank.
+      static const unsigned char blankFlag = 0x0F;
+
+         /// Constructor.
+      Rinex3ObsColumnData();
+
+         /// Destructor
+      virtual ~Rinex3ObsColumnData() {}
+
+         /// Time corresponding to the observations
+      CommonTime time;
+
+         /// Epoch flag, as Rinex3ObsData::epochFlag
+      short epochFlag;
+
+         /// Number of satellites in this observation, or the number of
+         /// auxiliary header records, as Rinex3ObsData::numSVs
+      short numSVs;
+
+      double clockOffset;        ///< optional clock offset in seconds
+
+      Rinex3ObsHeader auxHeader; ///< auxiliary header records (epochFlag 2-5)
+
+         /// Satellites with observations, in increasing order.
+      std::vector<RinexSatID> sats;
+
+         /// Start of the row of each satellite in data and lliSsi;
+         /// has one more element than sats, the last being the total.
+      std::vector<std::size_t> rowStart;
+
+         /// Observation values for all satellites; NaN where blank.
+      std::vector<double> data;
+
+         /// LLI in the low four bits and SSI in the high four bits for
+         /// each element of data; either may be blankFlag.
+      std::vector<unsigned char> lliSsi;
+
+         /// Remove all satellites, keeping the allocated storage.
+      void clear();
+
+         /// @return the number of satellites in this epoch.
+      std::size_t numSats() const
+      { return sats.size(); }
+
+         /// @return the number of observations for satellite index \a i.
+      std::size_t numObs(std::size_t i) const
+      { return rowStart[i+1] - rowStart[i]; }
+
+         /** Find a satellite by binary search.
+          * @param[in] sat the satellite to look for.
+          * @param[out] index the index of \a sat in sats, if found.
+          * @return true if \a sat is present. */
+      bool findSat(const RinexSatID& sat, std::size_t& index) const;
+
+         /// @return observation \a j of satellite index \a i.
+      double getValue(std::size_t i, std::size_t j) const
+      { return data[rowStart[i] + j]; }
+
+         /// @return the LLI of observation \a j of satellite index \a i
+         /// (0 if blank).
+      short getLLI(std::size_t i, std::size_t j) const;
+
+         /// @return the SSI of observation \a j of satellite index \a i
+         /// (0 if blank).
+      short getSSI(std::size_t i, std::size_t j) const;
+
+         /// @return observation \a j of satellite index \a i as a
+         /// RinexDatum.
+      RinexDatum getDatum(std::size_t i, std::size_t j) const;
+
+         /// Replace observation \a j of satellite index \a i.
+      void setDatum(std::size_t i, std::size_t j, const RinexDatum& rd);
+
+         /** Add a satellite with \a nobs blank observations.  To keep
+          * the satellites sorted, satellites must be added in
+          * increasing order.
+          * @return the index of the new satellite. */
+      std::size_t addSat(const RinexSatID& sat, std::size_t nobs);
+
+         /// Replace the contents of this object with those of \a rod.
+      void fromObsData(const Rinex3ObsData& rod);
+
+         /// Replace the contents of \a rod with those of this object.
+      void toObsData(Rinex3ObsData& rod) const;
+
+         /// Debug output, in the same form as Rinex3ObsData::dump().
+      virtual void dump(std::ostream& s) const;
+
+         /// This class is "data" so this function always returns "true".
+      virtual bool isData() const
+      { return true; }
+
+   protected:
+
+         /// Writes this epoch to \a s exactly as Rinex3ObsData would.
+      virtual void reallyPutRecord(FFStream& s) const
+         throw( std::exception, FFStreamError,
+                gpstk::StringUtils::StringException );
+
+         /** Obtain a RINEX Observation record from the given FFStream.
+          * Errors are detected and reported as by
+          * Rinex3ObsData::reallyGetRecord().
+          *
+          *  @throws StringException When a StringUtils function fails
+          *  @throws FFStreamError   When exceptions(failbit) is set and a read
+          *          or formatting error occurs.  Also resets the stream to its
+          *          pre-read position.
+          */
+      virtual void reallyGetRecord(FFStream& s)
+         throw( std::exception, FFStreamError,
+                gpstk::StringUtils::StringException );
+
+   private:
+
+         /** Read a RINEX 3 observation epoch (epoch flag 0, 1 or 6).
+          * @return false if the record must be read by Rinex3ObsData. */
+      bool getEpochVer3( Rinex3ObsStream& strm,
+                         Rinex3ObsFields::LineReader& reader );
+
+         /// Put the rows into satellite order, keeping only the last
+         /// row of any satellite that appears more than once.
+      void sortSats();
+
+         /// @return the packed LLI/SSI byte for \a rd.
+      static unsigned char packFlags(const RinexDatum& rd);
+
+         /// Line storage used when reading from the stream.
+      std::string lineBuffer;
+
+         /// Records not decoded directly are read into this, which is
+         /// kept so that it carries state from record to record just
+         /// as a Rinex3ObsData being read repeatedly would.
+      Rinex3ObsData obsData;
+
+         /// Scratch storage for sortSats(), kept to avoid reallocation.
+      std::vector<std::size_t> order;
+      std::vector<RinexSatID> sortSatList;
+      std::vector<std::size_t> sortStart;
+      std::vector<double> sortData;
+      std::vector<unsigned char> sortFlags;
+
+   }; // End of class 'Rinex3ObsColumnData'
+
+      //@}
+
+} // End of namespace gpstk
+
+#endif   // GPSTK_RINEX3OBSCOLUMNDATA_HPP
@@ -45,6 +45,7 @@
 #include "RinexObsID.hpp"
 #include "Rinex3ObsStream.hpp"
 #include "Rinex3ObsData.hpp"
+#include "Rinex3ObsFields.hpp"
 
 using namespace gpstk::StringUtils;
 using namespace std;
@@ -363,8 +364,6 @@ namespace gpstk
    void reallyGetRecordVer2(Rinex3ObsStream& strm, Rinex3ObsData& rod)
       throw(Exception)
    {
-      static CommonTime previousTime(CommonTime::BEGINNING_OF_TIME);
-
          // get the epoch line and check
       string line;
       while(line.empty())        // ignore blank lines in place of epoch lines
@@ -400,7 +399,7 @@ namespace gpstk
          GPSTK_THROW(e);
       }
       else if(noEpochTime)
-         rod.time = previousTime;
+         rod.time = strm.previousTime;
       else
       {
          try
@@ -461,7 +460,7 @@ namespace gpstk
             // end rod.time = parseTime(line, strm.header);
 
             // save for next call
-         previousTime = rod.time;
+         strm.previousTime = rod.time;
       }
 
          // number of satellites
@@ -574,6 +573,103 @@ namespace gpstk
    }  // end void reallyGetRecordVer2(Rinex3ObsStream& strm, Rinex3ObsData& rod)
 
 
+      /** Read a RINEX 3 observation epoch (epoch flag 0, 1 or 6) from
+       * the memory map of \a strm starting at the current stream
+       * position, then advance the stream past it.  The record is
+       * decoded exactly as Rinex3ObsData::reallyGetRecord() would,
+       * reusing the storage already held by \a rod.
+       * @return false, with the stream position unchanged, if the
+       *   record is not one this reader handles or is malformed in any
+       *   way; the caller must then read it with the stream reader,
+       *   which produces the appropriate result or error. */
+   bool reallyGetRecordMapped(Rinex3ObsStream& strm, Rinex3ObsData& rod)
+   {
+      string unused;
+      Rinex3ObsFields::LineReader reader(strm, unused);
+      if(!reader.isValid())
+         return false;
+
+      const char *line;
+      size_t len;
+      CommonTime time;
+      short epochFlag, numSVs;
+      double clockOffset;
+
+      if(!reader.next(line, len) ||
+         !Rinex3ObsFields::getEpochLine(line, len, strm.timesystem, time,
+                                        epochFlag, numSVs, clockOffset))
+         return false;
+
+         // SV records.  Entries already in rod.obs are overwritten in
+         // place and those not seen in this epoch are removed below,
+         // so a steady stream of epochs reuses the same storage.
+      const short maxSeen = 128;
+      RinexSatID seen[maxSeen];
+      if(numSVs > maxSeen)
+         rod.obs.clear();
+      char lastSys = 0;
+      size_t numObs = 0;
+      for(short isv = 0; isv < numSVs; isv++)
+      {
+         if(!reader.next(line, len) || len < 3)
+            return false;
+
+         RinexSatID sat;
+         try
+         {
+            sat = Rinex3ObsFields::getSatID(line, len);
+         }
+         catch(Exception&)
+         {
+            return false;
+         }
+
+            // The stream reader uses mapObsTypes[] which would add an
+            // empty entry for an unknown system; leave that to it.
+         char sys = sat.systemChar();
+         if(sys != lastSys)
+         {
+            map<string, vector<RinexObsID> >::const_iterator it =
+               strm.header.mapObsTypes.find(string(1, sys));
+            if(it == strm.header.mapObsTypes.end())
+               return false;
+            numObs = it->second.size();
+            lastSys = sys;
+         }
+
+         vector<RinexDatum>& data(rod.obs[sat]);
+         data.resize(numObs);
+         for(size_t i = 0; i < numObs; i++)
+            Rinex3ObsFields::getDatum(line, len, 3 + 16*i, data[i]);
+
+         if(isv < maxSeen)
+            seen[isv] = sat;
+      }
+
+      if(rod.obs.size() > static_cast<size_t>(numSVs))
+      {
+         Rinex3ObsData::DataMap::iterator it = rod.obs.begin();
+         while(it != rod.obs.end())
+         {
+            if(find(seen, seen + numSVs, it->first) == seen + numSVs)
+               rod.obs.erase(it++);
+            else
+               ++it;
+         }
+      }
+
+      rod.time = time;
+      rod.epochFlag = epochFlag;
+      rod.numSVs = numSVs;
+      rod.clockOffset = clockOffset;
+      if(rod.auxHeader.valid != 0)
+         rod.auxHeader = Rinex3ObsHeader();
+
+      reader.commit();
+      return true;
+   }  // end bool reallyGetRecordMapped(Rinex3ObsStream&, Rinex3ObsData&)
+
+
    void Rinex3ObsData::reallyGetRecord(FFStream& ffs)
       throw(std::exception, FFStreamError, gpstk::StringUtils::StringException)
    {
@@ -596,6 +692,10 @@ namespace gpstk
          return;
       }
 
+         // use the memory-mapped reader when it accepts this record
+      if(strm.isMappedRead() && reallyGetRecordMapped(strm, *this))
+         return;
+
       string line;
       Rinex3ObsData rod;
 
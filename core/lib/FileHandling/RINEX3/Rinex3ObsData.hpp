@@ -161,6 +161,10 @@ namespace gpstk
       void dump(std::ostream& s, Rinex3ObsHeader& head) const;
 
 
+         /// Rinex3ObsColumnData uses this class for records it does
+         /// not decode or encode itself.
+      friend class Rinex3ObsColumnData;
+
    protected:
 
 
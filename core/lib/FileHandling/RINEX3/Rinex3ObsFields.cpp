@@ -0,0 +1,328 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+/**
+ * @file Rinex3ObsFields.cpp
+ * Allocation-free parsing of the fixed-column fields of RINEX
+ * observation data records.
+ */
+
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+
+#include "CivilTime.hpp"
+#include "Rinex3ObsStream.hpp"
+#include "Rinex3ObsFields.hpp"
+
+using namespace std;
+
+namespace gpstk
+{
+   namespace Rinex3ObsFields
+   {
+      void getField( const char *line, size_t len, size_t pos, size_t n,
+                     char *tmp )
+      {
+         for(size_t i = 0; i < n; i++)
+            tmp[i] = (pos + i < len ? line[pos + i] : ' ');
+         tmp[n] = 0;
+      }
+
+
+      double asDouble(const char *f)
+      {
+            // exact powers of ten used to scale the digits
+         static const double pow10[] =
+         {
+            1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+            1e12, 1e13, 1e14, 1e15
+         };
+
+         const char *p = f;
+         while(*p == ' ')
+            p++;
+         bool neg = (*p == '-');
+         if(*p == '-' || *p == '+')
+            p++;
+         double mant = 0.;
+         int ndig = 0, nfrac = 0;
+         bool point = false;
+         for( ; ; p++)
+         {
+            if(*p >= '0' && *p <= '9')
+            {
+               mant = mant * 10. + (*p - '0');
+               ndig++;
+               if(point)
+                  nfrac++;
+            }
+            else if(*p == '.' && !point)
+               point = true;
+            else
+               break;
+         }
+         while(*p == ' ')
+            p++;
+         if(*p != 0 || ndig == 0 || ndig > 15)
+            return strtod(f, 0);
+         mant /= pow10[nfrac];
+         return (neg ? -mant : mant);
+      }
+
+
+      long asInt(const char *f)
+      {
+         const char *p = f;
+         while(*p == ' ')
+            p++;
+         bool neg = (*p == '-');
+         if(*p == '-' || *p == '+')
+            p++;
+         long val = 0;
+         int ndig = 0;
+         while(*p >= '0' && *p <= '9' && ndig < 9)
+         {
+            val = val * 10 + (*p - '0');
+            p++;
+            ndig++;
+         }
+         while(*p == ' ')
+            p++;
+         if(*p != 0 || ndig == 0)
+            return strtol(f, 0, 10);
+         return (neg ? -val : val);
+      }
+
+
+      void getDatum( const char *line, size_t len, size_t pos,
+                     RinexDatum& rd )
+      {
+         char tmp[17];
+         getField(line, len, pos, 16, tmp);
+         char lli = tmp[14], ssi = tmp[15];
+         tmp[14] = 0;
+         if(strspn(tmp, " ") == 14)
+         {
+            rd.data = 0.;
+            rd.dataBlank = true;
+         }
+         else
+         {
+            rd.data = asDouble(tmp);
+            rd.dataBlank = false;
+         }
+            // a non-digit flag reads as zero, as asInt() would return
+         rd.lliBlank = (lli == ' ');
+         rd.lli = ((lli >= '0' && lli <= '9') ? lli - '0' : 0);
+         rd.ssiBlank = (ssi == ' ');
+         rd.ssi = ((ssi >= '0' && ssi <= '9') ? ssi - '0' : 0);
+      }
+
+
+      RinexSatID getSatID(const char *line, size_t len)
+      {
+         char tmp[4];
+         getField(line, len, 0, 3, tmp);
+         SatID::SatelliteSystem sys;
+         switch(tmp[0])
+         {
+            case 'G': sys = SatID::systemGPS;      break;
+            case 'R': sys = SatID::systemGlonass;  break;
+            case 'E': sys = SatID::systemGalileo;  break;
+            case 'S': sys = SatID::systemGeosync;  break;
+            case 'J': sys = SatID::systemQZSS;     break;
+            case 'C': sys = SatID::systemBeiDou;   break;
+            case 'T': sys = SatID::systemTransit;  break;
+            case 'M': sys = SatID::systemMixed;    break;
+            default:  return RinexSatID(string(tmp));
+         }
+         if((tmp[1] != ' ' && (tmp[1] < '0' || tmp[1] > '9')) ||
+            tmp[2] < '0' || tmp[2] > '9')
+            return RinexSatID(string(tmp));
+         int prn = (tmp[1] == ' ' ? 0 : 10 * (tmp[1] - '0')) + (tmp[2] - '0');
+         RinexSatID sat(prn, sys);
+         if(prn <= 0)
+            sat.id = -1;
+         return sat;
+      }
+
+
+      bool getEpochLine( const char *line, size_t len, const TimeSystem& ts,
+                         CommonTime& time, short& epochFlag, short& numSVs,
+                         double& clockOffset )
+      {
+         char tmp[32];
+
+         if(len < 35 || line[0] != '>' || line[1] != ' ')
+            return false;
+         epochFlag = line[31] - '0';
+         if(epochFlag != 0 && epochFlag != 1 && epochFlag != 6)
+            return false;
+         if(line[ 6] != ' ' || line[ 9] != ' ' || line[12] != ' ' ||
+            line[15] != ' ' || line[18] != ' ' || line[29] != ' ' ||
+            line[30] != ' ')
+            return false;
+         getField(line, len, 2, 27, tmp);
+         if(strspn(tmp, " ") == 27)
+            return false;
+
+         try
+         {
+            int year, month, day, hour, min;
+            double sec;
+            getField(line, len,  2,  4, tmp);  year  = asInt(tmp);
+            getField(line, len,  7,  2, tmp);  month = asInt(tmp);
+            getField(line, len, 10,  2, tmp);  day   = asInt(tmp);
+            getField(line, len, 13,  2, tmp);  hour  = asInt(tmp);
+            getField(line, len, 16,  2, tmp);  min   = asInt(tmp);
+            getField(line, len, 19, 11, tmp);  sec   = asDouble(tmp);
+
+               // Real Rinex has epochs 'yy mm dd hr 59 60.0'
+               // surprisingly often.
+            double ds = 0;
+            if(sec >= 60.)
+            {
+               ds = sec;
+               sec = 0.0;
+            }
+            time = CivilTime(year,month,day,hour,min,sec).convertToCommonTime();
+            if(ds != 0) time += ds;
+            time.setTimeSystem(ts);
+         }
+         catch(Exception&)
+         {
+            return false;
+         }
+
+         getField(line, len, 32, 3, tmp);
+         long n = asInt(tmp);
+         if(n < 0)
+            return false;
+         numSVs = n;
+
+         clockOffset = 0.0;
+         if(len > 41)
+         {
+            getField(line, len, 41, std::min<size_t>(15, len-41), tmp);
+            clockOffset = asDouble(tmp);
+         }
+
+         return true;
+      }  // End of function 'getEpochLine()'
+
+
+      LineReader ::
+      LineReader(Rinex3ObsStream& s, std::string& buf)
+            : strm(s), buffer(buf), start(s.tellg()), pos(0),
+              startLine(s.lineNumber), lines(0)
+      {
+         if(start >= 0)
+            pos = static_cast<size_t>(start);
+      }
+
+
+      bool LineReader ::
+      next(const char *& line, size_t& len)
+      {
+         if(strm.isMappedRead())
+         {
+            const MemoryMappedFile& mf(strm.getMappedFile());
+            if(pos >= mf.size())
+               return false;
+            line = mf.data() + pos;
+            const char *nl = static_cast<const char*>(
+               memchr(line, '\n', mf.size() - pos));
+            len = (nl ? nl - line : mf.size() - pos);
+            if(len > maxLineLength)
+               return false;
+            pos += (nl ? len + 1 : len);
+            while(len > 0 && line[len-1] == '\r')
+               len--;
+         }
+         else
+         {
+            try
+            {
+               strm.formattedGetLine(buffer);
+            }
+            catch(Exception&)
+            {
+               return false;
+            }
+            catch(std::exception&)
+            {
+               return false;
+            }
+            line = buffer.data();
+            len = buffer.size();
+         }
+         while(len > 0 && line[len-1] == ' ')
+            len--;
+         lines++;
+         return true;
+      }  // End of method 'LineReader::next()'
+
+
+      void LineReader ::
+      commit()
+      {
+         if(strm.isMappedRead())
+         {
+            strm.lineNumber += lines;
+            strm.seekg(static_cast<streamoff>(pos), ios::beg);
+         }
+         lines = 0;
+      }
+
+
+      void LineReader ::
+      rewind()
+      {
+         if(!strm.isMappedRead())
+         {
+            strm.clear();
+            strm.seekg(start, ios::beg);
+            strm.lineNumber = startLine;
+         }
+         else
+            pos = static_cast<size_t>(start);
+         lines = 0;
+      }
+
+   } // End of namespace 'Rinex3ObsFields'
+
+} // End of namespace gpstk
@@ -0,0 +1,162 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+/**
+ * @file Rinex3ObsFields.hpp
+ * Allocation-free parsing of the fixed-column fields of RINEX
+ * observation data records.
+ */
+
+#ifndef GPSTK_RINEX3OBSFIELDS_HPP
+#define GPSTK_RINEX3OBSFIELDS_HPP
+
+#include <cstddef>
+#include <string>
+#include <iostream>
+
+#include "CommonTime.hpp"
+#include "RinexDatum.hpp"
+#include "RinexSatID.hpp"
+
+namespace gpstk
+{
+   class Rinex3ObsStream;
+
+      /// @ingroup FileHandling
+      //@{
+
+      /**
+       * Field parsers used by the fast observation record readers.
+       * Each gives the same result as the StringUtils conversion the
+       * line-oriented readers apply to a std::string copy of the
+       * field, but works directly on a span of the line, treating
+       * columns past the end of the line as blanks.
+       */
+   namespace Rinex3ObsFields
+   {
+         /// Longest line accepted by FFTextStream::formattedGetLine().
+      const std::size_t maxLineLength = 1499;
+
+         /** Copy \a n columns of a line starting at \a pos to \a tmp,
+          * padding with blanks past the end of the line, and
+          * NUL-terminate it.  \a tmp must hold \a n + 1 characters. */
+      void getField( const char *line, std::size_t len, std::size_t pos,
+                     std::size_t n, char *tmp );
+
+         /** Parse a fixed-format decimal field (e.g. F14.3) with the
+          * same result as StringUtils::asDouble().  The digits are
+          * accumulated exactly and divided by an exact power of ten, so
+          * the correctly rounded quotient is the value strtod()
+          * returns.  Anything other than blanks, a sign, up to 15
+          * digits and one decimal point is handed to strtod() itself.
+          * @param[in] f NUL-terminated field text. */
+      double asDouble(const char *f);
+
+         /** Parse a fixed-format integer field with the same result as
+          * StringUtils::asInt().
+          * @param[in] f NUL-terminated field text. */
+      long asInt(const char *f);
+
+         /// Parse the 16-column datum (F14.3,I1,I1) at \a pos the same
+         /// way RinexDatum::fromString() does.
+      void getDatum( const char *line, std::size_t len, std::size_t pos,
+                     RinexDatum& rd );
+
+         /** Parse a satellite ID from the first three columns of a
+          * line.  The usual "Xnn" form is decoded directly; any other
+          * form goes through the RinexSatID string constructor.
+          * @throw Exception for an invalid system character. */
+      RinexSatID getSatID(const char *line, std::size_t len);
+
+         /** Parse a RINEX 3 epoch line for an observation epoch
+          * (epoch flag 0, 1 or 6) as Rinex3ObsData::reallyGetRecord()
+          * would.
+          * @return false if the line is not such an epoch line or is
+          *   malformed in any way. */
+      bool getEpochLine( const char *line, std::size_t len,
+                         const TimeSystem& ts, CommonTime& time,
+                         short& epochFlag, short& numSVs,
+                         double& clockOffset );
+
+         /**
+          * Supply the lines of one record to a fast reader, either
+          * from the memory map of a Rinex3ObsStream (see
+          * Rinex3ObsStream::setMappedRead()) or from the stream
+          * itself.  Trailing carriage returns and blanks are excluded
+          * from the lines returned.  The stream is only advanced past
+          * the record by commit(); rewind() restores it to where the
+          * record began so that another reader can try again.
+          */
+      class LineReader
+      {
+      public:
+            /** @param[in] strm the stream to read.
+             * @param[in] buffer storage for lines read from the
+             *   stream; reuse it to avoid reallocation. */
+         LineReader(Rinex3ObsStream& strm, std::string& buffer);
+
+            /// @return false if the stream position is unknown, in
+            ///   which case the record cannot be rewound.
+         bool isValid() const
+         { return (start >= 0); }
+
+            /** Get the next line of the record.
+             * @return false at end of file, for a line that
+             *   formattedGetLine() would reject, or on a read error. */
+         bool next(const char *& line, std::size_t& len);
+
+            /// Leave the stream positioned after the lines read.
+         void commit();
+
+            /// Return the stream to the start of the record.
+         void rewind();
+
+      private:
+         Rinex3ObsStream& strm;   ///< stream being read
+         std::string& buffer;     ///< line storage when not mapped
+         std::streamoff start;    ///< stream position of the record
+         std::size_t pos;         ///< offset of next line in the map
+         unsigned int startLine;  ///< stream line number of the record
+         unsigned int lines;      ///< number of lines read
+      }; // End of class 'LineReader'
+
+   } // End of namespace 'Rinex3ObsFields'
+
+      //@}
+
+} // End of namespace gpstk
+
+#endif   // GPSTK_RINEX3OBSFIELDS_HPP
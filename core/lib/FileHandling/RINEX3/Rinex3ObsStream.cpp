@@ -78,6 +78,7 @@ namespace gpstk
    open( const char* fn,
          std::ios::openmode mode )
    {
+      mappedFile.close();
       FFTextStream::open(fn, mode);
    }
 
@@ -88,6 +89,7 @@ namespace gpstk
       headerRead = false;
       header = Rinex3ObsHeader();
       timesystem = TimeSystem::GPS;
+      previousTime = CommonTime::BEGINNING_OF_TIME;
    }
 
 
@@ -114,4 +116,14 @@ namespace gpstk
       return true;
    }
 
+
+   bool Rinex3ObsStream ::
+   setMappedRead(bool enable)
+   {
+      mappedFile.close();
+      if (!enable || !is_open() || filename.empty())
+         return false;
+      return mappedFile.open(filename);
+   }
+
 } // namespace gpstk
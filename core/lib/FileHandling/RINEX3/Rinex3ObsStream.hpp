@@ -48,6 +48,7 @@
 #include <string>
 
 #include "FFTextStream.hpp"
+#include "MemoryMappedFile.hpp"
 #include "Rinex3ObsHeader.hpp"
 
 namespace gpstk
@@ -110,10 +111,43 @@ namespace gpstk
          /// Time system for epochs in this file
       TimeSystem timesystem;
 
+         /** Time of the last RINEX 2 epoch read that had a time.
+          * Event records (epoch flags 2-4) may omit the time, in
+          * which case this one is used. */
+      CommonTime previousTime;
+
          /// Check if the input stream is the kind of Rinex3ObsStream
       static bool isRinex3ObsStream(std::istream& i);
 
+         /** Select the memory-mapped reader for observation records.
+          * When enabled, RINEX 3 epochs are parsed directly from a
+          * read-only memory map of the file instead of being copied
+          * line by line through the stream buffer.  The header, event
+          * records (epoch flags 2-5), RINEX 2 files and any record the
+          * fast parser does not accept are still read through the
+          * stream, so the records and errors produced are identical
+          * in either mode.  The stream position is kept in step with
+          * the map, so tellg()/seekg() continue to work.
+          *
+          * Reopening the stream reverts to ordinary stream reading.
+          *
+          * @param[in] enable true to use the memory map, false to
+          *   release it.
+          * @return true if the memory-mapped reader is active. */
+      bool setMappedRead(bool enable = true);
+
+         /// @return true if records are being read from a memory map.
+      bool isMappedRead() const
+      { return mappedFile.isOpen(); }
+
+         /// @return the memory map of the input file, if any.
+      const MemoryMappedFile& getMappedFile() const
+      { return mappedFile; }
+
    private:
+         /// Read-only map of the input file used by setMappedRead().
+      MemoryMappedFile mappedFile;
+
          /// Initialize internal data structures.
       void init();
    }; // class 'Rinex3ObsStream'
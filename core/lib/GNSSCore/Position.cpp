@@ -48,6 +48,7 @@
 #include "GNSSconstants.hpp"    // for TWO_PI, etc
 #include "GNSSconstants.hpp"             // for RAD_TO_DEG, etc
 #include "MiscMath.hpp"             // for RSS, SQRT
+#include "FixedMatrix.hpp"          // for FixedVector
 
 namespace gpstk
 {
@@ -1356,9 +1357,10 @@ namespace gpstk
       double cosUp;
       R.transformTo(Cartesian);
       S.transformTo(Cartesian);
-      Triple z;
-      // Let's get the slant vector
-      z = S.theArray - R.theArray;
+      // Let's get the slant vector (on the stack, no valarray temporaries)
+      FixedVector<double,3> z;
+      for (int i = 0; i < 3; i++)
+         z[i] = S.theArray[i] - R.theArray[i];
 
       if (z.mag()<=1e-4) // if the positions are within .1 millimeter
       {
@@ -1367,7 +1369,10 @@ namespace gpstk
       }
 
       // Compute k vector in local North-East-Up (NEU) system
-      Triple kVector(::cos(latGeodetic)*::cos(longGeodetic), ::cos(latGeodetic)*::sin(longGeodetic), ::sin(latGeodetic));
+      FixedVector<double,3> kVector(0.0);
+      kVector[0] = ::cos(latGeodetic)*::cos(longGeodetic);
+      kVector[1] = ::cos(latGeodetic)*::sin(longGeodetic);
+      kVector[2] = ::sin(latGeodetic);
       // Take advantage of dot method to get Up coordinate in local NEU system
       localUp = z.dot(kVector);
       // Let's get cos(z), being z the angle with respect to local vertical (Up);
@@ -1417,9 +1422,10 @@ namespace gpstk
       double localN, localE;
       R.transformTo(Cartesian);
       S.transformTo(Cartesian);
-      Triple z;
-      // Let's get the slant vector
-      z = S.theArray - R.theArray;
+      // Let's get the slant vector (on the stack, no valarray temporaries)
+      FixedVector<double,3> z;
+      for (int i = 0; i < 3; i++)
+         z[i] = S.theArray[i] - R.theArray[i];
 
       if (z.mag()<=1e-4) // if the positions are within .1 millimeter
       {
@@ -1428,9 +1434,14 @@ namespace gpstk
       }
 
       // Compute i vector in local North-East-Up (NEU) system
-      Triple iVector(-::sin(latGeodetic)*::cos(longGeodetic), -::sin(latGeodetic)*::sin(longGeodetic), ::cos(latGeodetic));
+      FixedVector<double,3> iVector(0.0);
+      iVector[0] = -::sin(latGeodetic)*::cos(longGeodetic);
+      iVector[1] = -::sin(latGeodetic)*::sin(longGeodetic);
+      iVector[2] = ::cos(latGeodetic);
       // Compute j vector in local North-East-Up (NEU) system
-      Triple jVector(-::sin(longGeodetic), ::cos(longGeodetic), 0);
+      FixedVector<double,3> jVector(0.0);
+      jVector[0] = -::sin(longGeodetic);
+      jVector[1] = ::cos(longGeodetic);
 
       // Now, let's use dot product to get localN and localE unitary vectors
       localN = (z.dot(iVector))/z.mag();
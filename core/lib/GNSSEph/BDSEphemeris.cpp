@@ -404,4 +404,19 @@ namespace gpstk
       return sv;
    }
 
+   // Compute satellite position at each of several times; the GEO
+   // satellites need the algorithm of svXvt().
+   void BDSEphemeris::svXvts(const vector<CommonTime>& t,
+                             vector<Xvt>& xvts) const
+   {
+      if(satID.id > 5) {
+         OrbitEph::svXvts(t, xvts);
+         return;
+      }
+
+      xvts.resize(t.size());
+      for(size_t i=0; i<t.size(); i++)
+         xvts[i] = svXvt(t[i]);
+   }
+
 } // end namespace
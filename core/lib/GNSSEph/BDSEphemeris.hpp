@@ -100,6 +100,13 @@ namespace gpstk
           * modified algorithm for deriving positions for these satellites.
           * @throw Invalid Request if the required data has not been stored. */
       Xvt svXvt(const CommonTime& t) const;
+
+         /** Compute satellite position at each of several times.
+          * MEO and IGSO satellites use OrbitEph::svXvts(); GEO
+          * satellites (PRN 1-5) call svXvt() at each time.
+          * @throw Invalid Request if the required data has not been stored. */
+      virtual void svXvts(const std::vector<CommonTime>& t,
+                          std::vector<Xvt>& xvts) const;
       
          /** Dump the orbit, etc information to the given output stream.
           * @throw Invalid Request if the required data has not been stored. */
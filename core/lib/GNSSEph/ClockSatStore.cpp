@@ -40,6 +40,8 @@
 
 #include "ClockSatStore.hpp"
 #include "MiscMath.hpp"
+#include <iterator>
+#include <vector>
 
 using namespace std;
 
@@ -69,6 +71,17 @@ namespace gpstk
    //  c) checkInterval is true and the interval is larger than maxInterval
    ClockRecord ClockSatStore::getValue(const SatID& sat, const CommonTime& ttag)
       const throw(InvalidRequest)
+   {
+      LagrangeWeights lw;
+      try { return getValue(sat, ttag, lw); }
+      catch(InvalidRequest& e) { GPSTK_RETHROW(e); }
+   }
+
+   // Return value for the given satellite at the given time, reusing the
+   // interpolation weights in lw where the nodes and time offset repeat.
+   ClockRecord ClockSatStore::getValue(const SatID& sat, const CommonTime& ttag,
+                                       LagrangeWeights& lw)
+      const throw(InvalidRequest)
    {
       try {
          checkTimeSystem(ttag.getTimeSystem());
@@ -83,101 +96,119 @@ namespace gpstk
             return rec;
          }
 
-         // pull data out of the data table
+         // pull data out of the data table; C holds bias, drift and accel
+         // of each time, padded to 4 values for LagrangeWeights::value4().
+         // They are on the stack, unless the interpolation order exceeds
+         // LagrangeWeights::MaxPoints
+         const size_t maxN(LagrangeWeights::MaxPoints);
+         const size_t N(std::distance(it1,it2)+1);
+         DataTableIterator itsFixed[maxN];
+         double dataFixed[5*maxN];
+         std::vector<DataTableIterator> itsHeap;
+         std::vector<double> dataHeap;
+         DataTableIterator *its(itsFixed);
+         double *times(dataFixed);
+         if(N > maxN) {
+            itsHeap.resize(N);
+            dataHeap.resize(5*N);
+            its = &itsHeap[0];
+            times = &dataHeap[0];
+         }
+         double *C(times+N);
          size_t n,Nlow(Nhalf-1),Nhi(Nhalf),Nmatch(Nhalf);
          CommonTime ttag0(it1->first);
-         vector<double> times,biases,drifts,accels,sig_biases,sig_drifts,sig_accels;
 
-         kt=it1; n=0;
-         while(1) {
+         kt=it1;
+         for(n=0; n<N; n++,++kt) {
             // find index of matching time tag
             if(isExact && ABS(kt->first-ttag) < 1.e-8) Nmatch = n;
-            times.push_back(kt->first - ttag0);    // sec
-            biases.push_back(kt->second.bias);     // sec
-            drifts.push_back(kt->second.drift);    // sec/sec
-            accels.push_back(kt->second.accel);    // sec/sec^2
-            sig_biases.push_back(kt->second.sig_bias);     // sec
-            sig_drifts.push_back(kt->second.sig_drift);    // sec/sec
-            sig_accels.push_back(kt->second.sig_accel);    // sec/sec^2
-            if(kt == it2) break;
-            ++kt;
-            ++n;
-         };
+            its[n] = kt;
+            times[n] = kt->first - ttag0;          // sec
+            C[4*n] = kt->second.bias;              // sec
+            C[4*n+1] = kt->second.drift;           // sec/sec
+            C[4*n+2] = kt->second.accel;           // sec/sec^2
+            C[4*n+3] = 0.0;
+         }
+
+         if(isExact && Nmatch == Nhalf-1) { Nlow++; Nhi++; }
 
-         if(isExact && Nmatch == (int)(Nhalf-1)) { Nlow++; Nhi++; }
+         const double *lo(C+4*Nlow), *hi(C+4*Nhi);  // bias,drift,accel at Nlow,Nhi
+         const ClockRecord& recLo(its[Nlow]->second);
+         const ClockRecord& recHi(its[Nhi]->second);
 
          // interpolate
          rec.accel = rec.sig_accel = 0.0;              // defaults
-         double dt(ttag-ttag0), err, slope;
+         double dt(ttag-ttag0), slope;
+         double val[4],der[4];
+         if(interpType == 2) {
+            // Lagrange interpolation, one set of weights for all components
+            lw.compute(times,n,dt);
+            lw.value4(C,val);
+            lw.derivative4(C,der);
+         }
          if(haveClockDrift) {
             if(interpType == 2) {
-               // Lagrange interpolation
-               rec.bias = LagrangeInterpolation(times,biases,dt,err);      // sec
-               rec.drift = LagrangeInterpolation(times,drifts,dt,err);     // sec/sec
+               rec.bias = val[0];                                          // sec
+               rec.drift = val[1];                                         // sec/sec
             }
             else {
                // linear interpolation
-               slope = (biases[Nhi]-biases[Nlow]) /
-                                   (times[Nhi]-times[Nlow]);               // sec/sec
-               rec.bias = biases[Nlow] + slope*(dt-times[Nlow]);           // sec
-               slope = (drifts[Nhi]-drifts[Nlow])/(times[Nhi]-times[Nlow]);
-               rec.drift = drifts[Nlow] + slope*(dt-times[Nlow]);          // sec/sec
+               slope = (hi[0]-lo[0]) / (times[Nhi]-times[Nlow]);           // sec/sec
+               rec.bias = lo[0] + slope*(dt-times[Nlow]);                  // sec
+               slope = (hi[1]-lo[1])/(times[Nhi]-times[Nlow]);
+               rec.drift = lo[1] + slope*(dt-times[Nlow]);                 // sec/sec
             }
 
             // sigmas
             if(isExact)
-               rec.sig_bias = sig_biases[Nmatch];
+               rec.sig_bias = its[Nmatch]->second.sig_bias;
             else
-               rec.sig_bias = RSS(sig_biases[Nhi],sig_biases[Nlow]);
-            rec.sig_drift = RSS(sig_drifts[Nhi],sig_drifts[Nlow]);
+               rec.sig_bias = RSS(recHi.sig_bias,recLo.sig_bias);
+            rec.sig_drift = RSS(recHi.sig_drift,recLo.sig_drift);
          }
          else {                              // must interpolate biases to get drift
             if(interpType == 2) {
-               // Lagrange interpolation
-               LagrangeInterpolation(times,biases,dt,rec.bias,rec.drift);
+               rec.bias = val[0];
+               rec.drift = der[0];
             }
             else {
                // linear interpolation
-               rec.drift = (biases[Nhi]-biases[Nlow]) /
-                                   (times[Nhi]-times[Nlow]);            // sec/sec^2
-               rec.bias = biases[Nlow] + (dt-times[Nlow])*rec.drift;    // sec/sec
+               rec.drift = (hi[0]-lo[0]) / (times[Nhi]-times[Nlow]);    // sec/sec^2
+               rec.bias = lo[0] + (dt-times[Nlow])*rec.drift;           // sec/sec
             }
 
             // sigmas
             if(isExact)
-               rec.sig_bias = sig_biases[Nmatch];
+               rec.sig_bias = its[Nmatch]->second.sig_bias;
             else
-               rec.sig_bias = RSS(sig_biases[Nhi],sig_biases[Nlow]);
+               rec.sig_bias = RSS(recHi.sig_bias,recLo.sig_bias);
             // TD ?
             rec.sig_drift = rec.sig_bias/(times[Nhi]-times[Nlow]);
          }
 
          if(haveClockAccel) {
             if(interpType == 2) {
-               // Lagrange interpolation
-               rec.accel = LagrangeInterpolation(times,accels,dt,err);  // sec/sec^2
+               rec.accel = val[2];                                      // sec/sec^2
             }
             else {
                // linear interpolation
-               slope = (drifts[Nhi]-drifts[Nlow]) /
-                                   (times[Nhi]-times[Nlow]);            // sec/sec^2
-               rec.accel = accels[Nlow] + slope*(dt-times[Nlow]);       // sec/sec^2
+               slope = (hi[1]-lo[1]) / (times[Nhi]-times[Nlow]);        // sec/sec^2
+               rec.accel = lo[2] + slope*(dt-times[Nlow]);              // sec/sec^2
             }
 
             // sigma
             if(isExact)
-               rec.sig_accel = sig_accels[Nmatch];
+               rec.sig_accel = its[Nmatch]->second.sig_accel;
             else
-               rec.sig_accel = RSS(sig_accels[Nhi],sig_accels[Nlow]);
+               rec.sig_accel = RSS(recHi.sig_accel,recLo.sig_accel);
          }
          else if(haveClockDrift) {              // must interpolate drift to get accel
             if(interpType == 2) {
-               // Lagrange interpolation  (err is a dummy here)
-               LagrangeInterpolation(times,drifts,dt,err,rec.accel);
+               rec.accel = der[1];
             }
             else {
                // linear interpolation                                  // sec/sec^2
-               rec.accel = (drifts[Nhi]-drifts[Nlow]) / (times[Nhi]-times[Nlow]);
+               rec.accel = (hi[1]-lo[1]) / (times[Nhi]-times[Nlow]);
             }
 
             // sigmas  TD is there a better way?
@@ -190,6 +221,28 @@ namespace gpstk
       catch(InvalidRequest& e) { GPSTK_RETHROW(e); }
    }
 
+   // Return values for the given satellite at each of several times,
+   // sharing one set of interpolation weights.
+   unsigned ClockSatStore::getValues(const SatID& sat,
+                                     const vector<CommonTime>& ttags,
+                                     vector<ClockRecord>& recs,
+                                     vector<bool>& valid) const
+   {
+      unsigned n(0);
+      LagrangeWeights lw;
+      recs.resize(ttags.size());
+      valid.assign(ttags.size(), false);
+      for(size_t i=0; i<ttags.size(); i++) {
+         try {
+            recs[i] = getValue(sat, ttags[i], lw);
+            valid[i] = true;
+            n++;
+         }
+         catch(InvalidRequest&) { }
+      }
+      return n;
+   }
+
    // Return the clock bias for the given satellite at the given time
    // @param[in] sat the SatID of the satellite of interest
    // @param[in] ttag the time (CommonTime) of interest
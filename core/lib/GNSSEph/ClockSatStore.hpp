@@ -45,6 +45,7 @@
 #define GPSTK_CLOCK_SAT_STORE_INCLUDE
 
 #include <map>
+#include <vector>
 #include <iostream>
 
 #include "Exception.hpp"
@@ -52,6 +53,7 @@
 #include "CommonTime.hpp"
 #include "TabularSatStore.hpp"
 #include "FileStore.hpp"
+#include "LagrangeWeights.hpp"
 
 namespace gpstk
 {
@@ -154,6 +156,35 @@ namespace gpstk
       virtual ClockRecord getValue(const SatID& sat, const CommonTime& ttag)
          const throw(InvalidRequest);
 
+         /** As getValue(sat, ttag), with the interpolation weights kept
+          * in lw; the weights are computed once for bias, drift and
+          * acceleration, and not at all when the nodes and time offset
+          * are those of the previous call with lw, as for every
+          * satellite at one epoch of a regular table.
+          * Interpolation orders above LagrangeWeights::MaxPoints are
+          * allowed; their data and weights are kept on the heap.
+          * @param[in] sat the SatID of the satellite of interest
+          * @param[in] ttag the time (CommonTime) of interest
+          * @param[in,out] lw the interpolation weights
+          * @return object of type ClockRecord containing the data value(s).
+          * @throw InvalidRequest as getValue(sat, ttag) */
+      ClockRecord getValue(const SatID& sat, const CommonTime& ttag,
+                           LagrangeWeights& lw)
+         const throw(InvalidRequest);
+
+         /** Return values for the given satellite at each of several
+          * times, as getValue(sat, ttags[i]) but sharing one set of
+          * interpolation weights.
+          * @param[in] sat the SatID of the satellite of interest
+          * @param[in] ttags the times (CommonTime) of interest
+          * @param[out] recs the value at each time
+          * @param[out] valid false where getValue() would throw
+          * @return the number of values computed */
+      unsigned getValues(const SatID& sat,
+                         const std::vector<CommonTime>& ttags,
+                         std::vector<ClockRecord>& recs,
+                         std::vector<bool>& valid) const;
+
          /** Return the clock bias for the given satellite at the given time
           * @param[in] sat the SatID of the satellite of interest
           * @param[in] ttag the time (CommonTime) of interest
@@ -39,6 +39,8 @@
 /// Ephemeris data for GLONASS.
 
 #include <iomanip>
+#include <cmath>
+#include <algorithm>
 #include "GloEphemeris.hpp"
 #include "TimeString.hpp"
 
@@ -97,56 +99,272 @@ namespace gpstk
 
       }
 
-         // Get the data out of the GloRecord structure
-      double px( x[0] );   // X coordinate (km)
-      double vx( v[0] );   // X velocity   (km/s)
-      double ax( a[0] );   // X acceleration (km/s^2)
-      double py( x[1] );   // Y coordinate
-      double vy( v[1] );   // Y velocity
-      double ay( a[1] );   // Y acceleration
-      double pz( x[2] );   // Z coordinate
-      double vz( v[2] );   // Z velocity
-      double az( a[2] );   // Z acceleration
-
          // We will need some PZ-90 ellipsoid parameters
       PZ90Ellipsoid pz90;
       double we( pz90.angVelocity() );
 
-         // Get sidereal time at Greenwich at 0 hours UT
-      double gst( getSidTime( ephTime ) );
-      double s0( gst*PI/12.0 );
+      double px, py, pz, vx, vy, vz, cs, ss;
+
+         // If there is a table covering epoch, interpolate it
+      double dt( epoch - ephTime );
+      double f( table.empty() ? -1.0 : dt/tableSpacing + tableHalf );
+      if ( f >= 0.0 && f <= 2.0*tableHalf )
+      {
+
+         int i( static_cast<int>(f) );
+         if ( i == 2*tableHalf ) --i;
+         double u( f - i );
+         double h( tableSpacing );
+         const double *n0( &table[9*i] );
+         const double *n1( n0 + 9 );
+
+            // Quintic Hermite basis on [0,1], and its derivative
+         double u2( u*u ), u3( u2*u ), u4( u3*u ), u5( u4*u );
+         double b0( 1.0 - 10.0*u3 + 15.0*u4 - 6.0*u5 );
+         double b1( (u - 6.0*u3 + 8.0*u4 - 3.0*u5)*h );
+         double b2( 0.5*(u2 - 3.0*u3 + 3.0*u4 - u5)*h*h );
+         double b3( 0.5*(u3 - 2.0*u4 + u5)*h*h );
+         double b4( (-4.0*u3 + 7.0*u4 - 3.0*u5)*h );
+         double b5( 10.0*u3 - 15.0*u4 + 6.0*u5 );
+         double d0( (-30.0*u2 + 60.0*u3 - 30.0*u4)/h );
+         double d1( 1.0 - 18.0*u2 + 32.0*u3 - 15.0*u4 );
+         double d2( 0.5*(2.0*u - 9.0*u2 + 12.0*u3 - 5.0*u4)*h );
+         double d3( 0.5*(3.0*u2 - 8.0*u3 + 5.0*u4)*h );
+         double d4( -12.0*u2 + 28.0*u3 - 15.0*u4 );
+         double d5( -d0 );
+
+         double p[3], vel[3];
+         for( int j = 0; j < 3; ++j )
+         {
+            p[j] = b0*n0[j] + b1*n0[j+3] + b2*n0[j+6]
+                 + b3*n1[j+6] + b4*n1[j+3] + b5*n1[j];
+            vel[j] = d0*n0[j] + d1*n0[j+3] + d2*n0[j+6]
+                   + d3*n1[j+6] + d4*n1[j+3] + d5*n1[j];
+         }
+         px = p[0];
+         py = p[1];
+         pz = p[2];
+         vx = vel[0];
+         vy = vel[1];
+         vz = vel[2];
+
+         double s( tableS + we*dt );
+         cs = std::cos(s);
+         ss = std::sin(s);
+
+      }
+      else
+      {
+
+            // Get sidereal time at Greenwich at 0 hours UT
+         double gst( getSidTime( ephTime ) );
+         double s0( gst*PI/12.0 );
+         YDSTime ytime( ephTime );
+         double numSeconds( ytime.sod );
+         double s( s0 + we*numSeconds );
+         cs = std::cos(s);
+         ss = std::sin(s);
+
+            // Get the reference state out of GloEphemeris object data,
+            // rotated from PZ-90 to an absolute coordinate system
+         Vector<double> state(6);
+         absoluteState( state, cs, ss );
+
+            // Integrate satellite state to desired epoch
+         CommonTime workEpoch( ephTime );
+         integrate( state, workEpoch, numSeconds, epoch, s0, cs, ss );
+
+         px = state(0);
+         py = state(2);
+         pz = state(4);
+         vx = state(1);
+         vy = state(3);
+         vz = state(5);
+
+      }
+
+      sv.x[0] = 1000.0*( px*cs + py*ss );         // X coordinate
+      sv.x[1] = 1000.0*(-px*ss + py*cs);          // Y coordinate
+      sv.x[2] = 1000.0*pz;                        // Z coordinate
+      sv.v[0] = 1000.0*( vx*cs + vy*ss + we*(sv.x[1]/1000.0) ); // X velocity
+      sv.v[1] = 1000.0*(-vx*ss + vy*cs - we*(sv.x[0]/1000.0) ); // Y velocity
+      sv.v[2] = 1000.0*vz;                        // Z velocity
+
+         // In the GLONASS system, 'clkbias' already includes the relativistic
+         // correction, therefore we must substract the late from the former.
+      sv.relcorr = sv.computeRelativityCorrection();
+      sv.clkbias = clkbias + clkdrift * (epoch - ephTime) - sv.relcorr;
+      sv.clkdrift = clkdrift;
+      sv.frame = ReferenceFrame::PZ90;
+
+         // We are done, let's return
+      return sv;
+
+
+   }  // End of method 'GloEphemeris::svXvt(const CommonTime& t)'
+
+
+      // Integrate the orbit over the fit interval into a table of nodes.
+   GloEphemeris& GloEphemeris::buildTable( double nodeSpacing )
+      throw( gpstk::InvalidRequest )
+   {
+
+      if(!valid)
+      {
+         InvalidRequest exc("buildTable(): No valid data stored.");
+         GPSTK_THROW(exc);
+      }
+
+      if( !(nodeSpacing > 0.0) )
+      {
+         InvalidRequest exc("buildTable(): Node spacing must be positive.");
+         GPSTK_THROW(exc);
+      }
+
+      PZ90Ellipsoid pz90;
+      double we( pz90.angVelocity() );
+
+      double s0( getSidTime( ephTime )*PI/12.0 );
       YDSTime ytime( ephTime );
-      double numSeconds( ytime.sod );
-      double s( s0 + we*numSeconds );
-      double cs( std::cos(s) );
-      double ss( std::sin(s) );
-
-         // Initial state matrix
-      Vector<double> initialState(6), accel(3), dxt1(6), dxt2(6), dxt3(6),
-                     dxt4(6), tempRes(6);
-
-         // Get the reference state out of GloEphemeris object data. Values
-         // must be rotated from PZ-90 to an absolute coordinate system
-         // Initial x coordinate (m)
-      initialState(0)  = (px*cs - py*ss);
-         // Initial y coordinate
-      initialState(2)  = (px*ss + py*cs);
-         // Initial z coordinate
-      initialState(4)  = pz;
-
-         // Initial x velocity   (m/s)
-      initialState(1)  = (vx*cs - vy*ss - we*initialState(2) );
-         // Initial y velocity
-      initialState(3)  = (vx*ss + vy*cs + we*initialState(0) );
-         // Initial z velocity
-      initialState(5)  = vz;
+      double sod( ytime.sod );
+      double sRef( s0 + we*sod );
+      double csRef( std::cos(sRef) );
+      double ssRef( std::sin(sRef) );
+
+      Vector<double> initialState(6);
+      absoluteState( initialState, csRef, ssRef );
+
+         // Nodes cover the fit interval of +/- 900 seconds
+      tableSpacing = nodeSpacing;
+      tableHalf = static_cast<int>( std::ceil(900.0/nodeSpacing - 1.e-9) );
+      tableS = sRef;
+      table.assign( 9*(2*tableHalf + 1), 0.0 );
+      setNode( tableHalf, initialState, csRef, ssRef );
+
+         // Integrate forward then backward, keeping the state at the
+         // middle of each interval to measure the interpolation error
+      std::vector<Triple> mid( 2*tableHalf );
+      for( int dir = 1; dir >= -1; dir -= 2 )
+      {
 
+         Vector<double> state( initialState );
+         CommonTime workEpoch( ephTime );
+         double numSeconds( sod );
+         double cs( csRef ), ss( ssRef );
+
+         for( int k = 1; k <= tableHalf; ++k )
+         {
+            integrate( state, workEpoch, numSeconds,
+                       ephTime + dir*(k - 0.5)*nodeSpacing, s0, cs, ss );
+            mid[ tableHalf + (dir > 0 ? k-1 : -k) ] =
+               Triple( state(0), state(2), state(4) );
+
+            integrate( state, workEpoch, numSeconds,
+                       ephTime + dir*k*nodeSpacing, s0, cs, ss );
+            setNode( tableHalf + dir*k, state, cs, ss );
+         }
+
+      }
+
+         // Compare the interpolation against the integrator
+      tableError = 0.0;
+      for( int i = 0; i < 2*tableHalf; ++i )
+      {
+         const double *n0( &table[9*i] );
+         const double *n1( n0 + 9 );
+         double h( nodeSpacing );
+         double err2( 0.0 );
+         for( int j = 0; j < 3; ++j )
+         {
+               // Hermite basis at u = 0.5
+            double p( 0.5*(n0[j] + n1[j]) + 0.15625*h*(n0[j+3] - n1[j+3])
+                    + 0.015625*h*h*(n0[j+6] + n1[j+6]) );
+            double d( p - mid[i][j] );
+            err2 += d*d;
+         }
+         tableError = std::max( tableError, 1000.0*std::sqrt(err2) );
+      }
+
+      return (*this);
+
+   }  // End of method 'GloEphemeris::buildTable()'
+
+
+      // Drop the interpolation table.
+   GloEphemeris& GloEphemeris::setIntegrationStep( double rkStep )
+   {
+
+      if( rkStep != step )
+      {
+         step = rkStep;
+
+            // The table was integrated with the old step
+         if( hasTable() )
+            buildTable(tableSpacing);
+      }
+
+      return (*this);
+
+   }  // End of method 'GloEphemeris::setIntegrationStep()'
+
+
+   GloEphemeris& GloEphemeris::clearTable()
+      throw()
+   {
+
+      std::vector<double>().swap(table);
+      tableSpacing = 0.0;
+      tableHalf = 0;
+      tableS = 0.0;
+      tableError = 0.0;
+
+      return (*this);
+
+   }  // End of method 'GloEphemeris::clearTable()'
+
+
+      // Absolute state at ephTime, given the sidereal angle there.
+   void GloEphemeris::absoluteState( Vector<double>& state,
+                                     double cs,
+                                     double ss ) const
+   {
+
+      PZ90Ellipsoid pz90;
+      double we( pz90.angVelocity() );
+
+         // Initial x, y, z coordinates (km)
+      state(0) = (x[0]*cs - x[1]*ss);
+      state(2) = (x[0]*ss + x[1]*cs);
+      state(4) = x[2];
+
+         // Initial x, y, z velocities (km/s)
+      state(1) = (v[0]*cs - v[1]*ss - we*state(2) );
+      state(3) = (v[0]*ss + v[1]*cs + we*state(0) );
+      state(5) = v[2];
+
+   }  // End of method 'GloEphemeris::absoluteState()'
+
+
+      // Runge-Kutta integration of the absolute state up to epoch.
+   void GloEphemeris::integrate( Vector<double>& state,
+                                 CommonTime& workEpoch,
+                                 double& numSeconds,
+                                 const CommonTime& epoch,
+                                 double s0,
+                                 double& cs,
+                                 double& ss ) const
+   {
+
+      PZ90Ellipsoid pz90;
+      double we( pz90.angVelocity() );
+
+      Vector<double> accel(3), dxt1(6), dxt2(6), dxt3(6), dxt4(6),
+                     tempRes(6);
 
          // Integrate satellite state to desired epoch using the given step
       double rkStep( step );
 
-      if ( (epoch - ephTime) < 0.0 ) rkStep = step*(-1.0);
-      CommonTime workEpoch( ephTime );
+      if ( (epoch - workEpoch) < 0.0 ) rkStep = step*(-1.0);
 
       double tolerance( 1e-9 );
       bool done( false );
@@ -167,31 +385,31 @@ namespace gpstk
          }
 
          numSeconds += rkStep;
-         s = s0 + we*( numSeconds );
+         double s( s0 + we*( numSeconds ) );
          cs = std::cos(s);
          ss = std::sin(s);
 
             // Accelerations are computed once per iteration
-         accel(0) = ax*cs - ay*ss;
-         accel(1) = ax*ss + ay*cs;
-         accel(2) = az;
+         accel(0) = a[0]*cs - a[1]*ss;
+         accel(1) = a[0]*ss + a[1]*cs;
+         accel(2) = a[2];
 
-         dxt1 = derivative( initialState, accel );
+         dxt1 = derivative( state, accel );
          for( int j = 0; j < 6; ++j )
-            tempRes(j) = initialState(j) + rkStep*dxt1(j)/2.0;
+            tempRes(j) = state(j) + rkStep*dxt1(j)/2.0;
 
          dxt2 = derivative( tempRes, accel );
          for( int j = 0; j < 6; ++j )
-            tempRes(j) = initialState(j) + rkStep*dxt2(j)/2.0;
+            tempRes(j) = state(j) + rkStep*dxt2(j)/2.0;
 
          dxt3 = derivative( tempRes, accel );
          for( int j = 0; j < 6; ++j )
-            tempRes(j) = initialState(j) + rkStep*dxt3(j);
+            tempRes(j) = state(j) + rkStep*dxt3(j);
 
          dxt4 = derivative( tempRes, accel );
          for( int j = 0; j < 6; ++j )
-            initialState(j) = initialState(j) + rkStep * ( dxt1(j)
-                            + 2.0 * ( dxt2(j) + dxt3(j) ) + dxt4(j) ) / 6.0;
+            state(j) = state(j) + rkStep * ( dxt1(j)
+                     + 2.0 * ( dxt2(j) + dxt3(j) ) + dxt4(j) ) / 6.0;
 
 
             // If we are within tolerance of the target time, we are done.
@@ -201,33 +419,32 @@ namespace gpstk
 
       }  // End of 'while (!done)...'
 
+   }  // End of method 'GloEphemeris::integrate()'
 
-      px = initialState(0);
-      py = initialState(2);
-      pz = initialState(4);
-      vx = initialState(1);
-      vy = initialState(3);
-      vz = initialState(5);
 
-      sv.x[0] = 1000.0*( px*cs + py*ss );         // X coordinate
-      sv.x[1] = 1000.0*(-px*ss + py*cs);          // Y coordinate
-      sv.x[2] = 1000.0*pz;                        // Z coordinate
-      sv.v[0] = 1000.0*( vx*cs + vy*ss + we*(sv.x[1]/1000.0) ); // X velocity
-      sv.v[1] = 1000.0*(-vx*ss + vy*cs - we*(sv.x[0]/1000.0) ); // Y velocity
-      sv.v[2] = 1000.0*vz;                        // Z velocity
+      // Store the state and its derivative as table node i.
+   void GloEphemeris::setNode( int i,
+                               const Vector<double>& state,
+                               double cs,
+                               double ss )
+   {
 
-         // In the GLONASS system, 'clkbias' already includes the relativistic
-         // correction, therefore we must substract the late from the former.
-      sv.relcorr = sv.computeRelativityCorrection();
-      sv.clkbias = clkbias + clkdrift * (epoch - ephTime) - sv.relcorr;
-      sv.clkdrift = clkdrift;
-      sv.frame = ReferenceFrame::PZ90;
+      Vector<double> accel(3);
+      accel(0) = a[0]*cs - a[1]*ss;
+      accel(1) = a[0]*ss + a[1]*cs;
+      accel(2) = a[2];
 
-         // We are done, let's return
-      return sv;
+      Vector<double> dxt( derivative( state, accel ) );
 
+      double *node( &table[9*i] );
+      for( int j = 0; j < 3; ++j )
+      {
+         node[j]   = state(2*j);       // position
+         node[j+3] = state(2*j+1);     // velocity
+         node[j+6] = dxt(2*j+1);       // acceleration
+      }
 
-   }  // End of method 'GloEphemeris::svXvt(const CommonTime& t)'
+   }  // End of method 'GloEphemeris::setNode()'
 
 
       // Get the epoch time for this ephemeris
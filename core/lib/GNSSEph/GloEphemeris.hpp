@@ -42,6 +42,7 @@
 #define GPSTK_GLOEPHEMERIS_HPP
 
 #include <iostream>
+#include <vector>
 #include "Triple.hpp"
 #include "Xvt.hpp"
 #include "CommonTime.hpp"
@@ -66,7 +67,8 @@ namespace gpstk
 
          /// Default constructor
       GloEphemeris()
-            : valid(false), step(1.0)
+            : valid(false), step(1.0), tableSpacing(0.0), tableHalf(0),
+              tableS(0.0), tableError(0.0)
       {};
 
 
@@ -148,12 +150,59 @@ namespace gpstk
       { return step; };
 
 
-         /** Set integration step for Runge-Kutta algorithm.
+         /** Set integration step for Runge-Kutta algorithm. A table
+          *  built by buildTable() is rebuilt with the new step.
           *
           * @param rkStep  Runge-Kutta integration step in seconds.
           */
-      GloEphemeris& setIntegrationStep( double rkStep )
-      { step = rkStep; return (*this); };
+      GloEphemeris& setIntegrationStep( double rkStep );
+
+
+         /** Integrate the orbit once over the whole fit interval and
+          *  keep the state at nodes nodeSpacing seconds apart, so that
+          *  svXvt() interpolates (quintic Hermite on position, velocity
+          *  and acceleration) instead of integrating from the ephemeris
+          *  epoch on every call.
+          *
+          *  The integration step is the one set with setIntegrationStep()
+          *  and should divide nodeSpacing/2; at the nodes the table then
+          *  reproduces the integrator exactly.
+          *
+          * @param nodeSpacing   Spacing of the table nodes in seconds.
+          *
+          * @throw InvalidRequest if required data has not been stored,
+          * or nodeSpacing is not positive.
+          */
+      GloEphemeris& buildTable( double nodeSpacing = 60.0 )
+         throw( gpstk::InvalidRequest );
+
+
+         /// Drop the table built by buildTable(), going back to integration.
+      GloEphemeris& clearTable()
+         throw();
+
+
+         /// Return true if svXvt() interpolates a table built by buildTable().
+      bool hasTable() const
+         throw()
+      { return !table.empty(); }
+
+
+         /// Spacing of the table nodes in seconds, or zero if there is none.
+      double getTableSpacing() const
+         throw()
+      { return tableSpacing; }
+
+
+         /** Accuracy bound of the table, in meters: the largest position
+          *  difference between the interpolation and the integrator at the
+          *  middle of every interval between nodes, which is where the
+          *  error of the two-point Hermite interpolation peaks. Zero if
+          *  there is no table.
+          */
+      double getTableErrorBound() const
+         throw()
+      { return tableError; }
 
 
          /// Get the acceleration vector.
@@ -255,6 +304,59 @@ namespace gpstk
                                  const Vector<double>& accel ) const;
 
 
+         /** Absolute (inertial) state (x,vx,y,vy,z,vz) at ephTime, given
+          *  the cosine and sine of the sidereal angle there.
+          */
+      void absoluteState( Vector<double>& state,
+                          double cs,
+                          double ss ) const;
+
+
+         /** Runge-Kutta integration of the absolute state from workEpoch
+          *  up to epoch. On return workEpoch and numSeconds (seconds of
+          *  day) are those of epoch, and cs, ss the cosine and sine of the
+          *  sidereal angle s0 + we*numSeconds.
+          */
+      void integrate( Vector<double>& state,
+                      CommonTime& workEpoch,
+                      double& numSeconds,
+                      const CommonTime& epoch,
+                      double s0,
+                      double& cs,
+                      double& ss ) const;
+
+
+         /** Store the absolute state and its derivative, with the
+          *  luni-solar acceleration rotated by cs, ss, as table node i.
+          */
+      void setNode( int i,
+                    const Vector<double>& state,
+                    double cs,
+                    double ss );
+
+
+         /// Absolute position, velocity and acceleration at each table
+         /// node [km, km/s, km/s^2], 9 values per node, first node at
+         /// ephTime - tableHalf*tableSpacing. Empty if there is no table.
+      std::vector<double> table;
+
+
+         /// Seconds between table nodes
+      double tableSpacing;
+
+
+         /// Number of table nodes on each side of ephTime
+      int tableHalf;
+
+
+         /// Sidereal angle at ephTime [rad]
+      double tableS;
+
+
+         /// Accuracy bound of the table [m]
+      double tableError;
+
+
 
 
          /// Output the contents of this ephemeris to the given stream.
@@ -40,6 +40,7 @@
  * Get GLONASS broadcast ephemeris data information
  */
 
+#include <algorithm>
 #include "GloEphemerisStore.hpp"
 #include "TimeString.hpp"
 
@@ -58,6 +59,8 @@ namespace gpstk
       {
             // Get a GloEphemeris object from Rinex3NavData object
          GloEphemeris gloEphem(data);
+         if( tableSpacing > 0.0 )
+            gloEphem.buildTable(tableSpacing);
 
          CommonTime t( data.time);
          t.setTimeSystem(TimeSystem::GLO);   // must be GLONASS time
@@ -79,6 +82,51 @@ namespace gpstk
    }  // End of method 'GloEphemerisStore::addEphemeris()'
 
 
+      // Set whether getXvt() interpolates a table built per ephemeris.
+   GloEphemerisStore& GloEphemerisStore::setInterpolation( double nodeSpacing )
+   {
+
+      tableSpacing = (nodeSpacing > 0.0 ? nodeSpacing : 0.0);
+
+      for( GloEphMap::iterator it = pe.begin(); it != pe.end(); ++it )
+      {
+         for( TimeGloMap::iterator jt = it->second.begin();
+              jt != it->second.end();
+              ++jt )
+         {
+            if( tableSpacing > 0.0 )
+               jt->second.buildTable(tableSpacing);
+            else
+               jt->second.clearTable();
+         }
+      }
+
+      return (*this);
+
+   }  // End of method 'GloEphemerisStore::setInterpolation()'
+
+
+      // Largest accuracy bound of the interpolation tables.
+   double GloEphemerisStore::getInterpolationErrorBound() const
+   {
+
+      double bound(0.0);
+
+      for( GloEphMap::const_iterator it = pe.begin(); it != pe.end(); ++it )
+      {
+         for( TimeGloMap::const_iterator jt = it->second.begin();
+              jt != it->second.end();
+              ++jt )
+         {
+            bound = std::max(bound, jt->second.getTableErrorBound());
+         }
+      }
+
+      return bound;
+
+   }  // End of method 'GloEphemerisStore::getInterpolationErrorBound()'
+
+
       /* Returns the position, velocity and clock offset of the indicated
        * satellite in ECEF coordinates (meters) at the indicated time,
        * in the PZ-90 ellipsoid.
@@ -123,27 +171,117 @@ namespace gpstk
          GPSTK_THROW(e);
       }
 
-         // Let's take the second part of the EphMap
-      const TimeGloMap& sem = svmap->second;
+         // Look for the proper reference data record in the second part
+         // of the EphMap
+      const GloEphemeris *data = findRecord( svmap->second, epoch );
 
-         // Look for 'i': the first element whose key >= epoch.
-      TimeGloMap::const_iterator i = sem.lower_bound(epoch);;
+         // Check that the given epoch is within the available time limits for
+         // this specific satellite.
+      if ( data == NULL )
+      {
+         InvalidRequest e( "Requested time is out of boundaries for satellite "
+                          + StringUtils::asString(sat) );
+         GPSTK_THROW(e);
+      }
+
+         // Compute the satellite position, velocity and clock offset
+      return data->svXvt( epoch );
+
+   }; // End of method 'GloEphemerisStore::getXvt()'
+
+
+      /* Compute the Xvt of several satellites, each at its own time.
+       * The records are selected as in getXvt(), but the satellite is
+       * looked up once for each run of requests for it, and requests
+       * that cannot be completed are flagged without a throw.
+       */
+   unsigned GloEphemerisStore::getXvts( const vector<SatID>& ids,
+                                        const vector<CommonTime>& times,
+                                        vector<Xvt>& xvts,
+                                        vector<bool>& valid ) const
+   {
+      if (ids.size() != times.size())
+      {
+         InvalidRequest e("getXvts: ids and times differ in size");
+         GPSTK_THROW(e);
+      }
+
+      unsigned n(0);
+      GloEphMap::const_iterator svmap = pe.end();
+      xvts.resize(ids.size());
+      valid.assign(ids.size(), false);
+
+      for (size_t k = 0; k < ids.size(); k++)
+      {
+         const CommonTime& epoch = times[k];
 
-         // Values to be returned will be stored here
-      Xvt sv;
+            // Same checks as getXvt()
+         if ( epoch.getTimeSystem() != initialTime.getTimeSystem() ||
+              epoch <  (initialTime - 900.0) ||
+              epoch >  (finalTime   + 900.0)   )
+         {
+            continue;
+         }
+
+         if ( k == 0 || !(ids[k] == ids[k-1]) )
+         {
+            svmap = pe.find(ids[k]);
+         }
+
+         if (svmap == pe.end())
+         {
+            continue;
+         }
+
+         const GloEphemeris *data = findRecord( svmap->second, epoch );
+         if ( data == NULL )
+         {
+            continue;
+         }
+
+         try
+         {
+            xvts[k] = data->svXvt( epoch );
+            valid[k] = true;
+            n++;
+         }
+         catch(InvalidRequest&)
+         {
+         }
+      }
+
+      return n;
+
+   }; // End of method 'GloEphemerisStore::getXvts()'
+
+
+      /* Find the record in one satellite's table to use at the given
+       * epoch, or return NULL if the epoch is out of boundaries for
+       * the satellite.
+       */
+   const GloEphemeris* GloEphemerisStore::findRecord( const TimeGloMap& sem,
+                                                      const CommonTime& epoch )
+      const
+   {
+         // Look for 'i': the first element whose key >= epoch.
+      TimeGloMap::const_iterator i = sem.lower_bound(epoch);
 
          // If we reached the end, the requested time is beyond the last
          // ephemeris record, but it may still be within the allowable time
          // span, so we can use the last record.
       if ( i == sem.end() )
       {
-         i = --i;
+         if ( i == sem.begin() )
+         {
+            return NULL;
+         }
+         --i;
       }
 
          // If key > (epoch+900), we must use the previous record if possible.
       if ( ( i->first > (epoch+900.0) ) && ( i != sem.begin() ) )
       {
-         i = --i;
+         --i;
       }
 
          // Check that the given epoch is within the available time limits for
@@ -151,21 +289,12 @@ namespace gpstk
       if ( epoch <  (i->first - 900.0) ||
            epoch >= (i->first   + 900.0)   )
       {
-         InvalidRequest e( "Requested time is out of boundaries for satellite "
-                          + StringUtils::asString(sat) );
-         GPSTK_THROW(e);
+         return NULL;
       }
 
-         // We now have the proper reference data record. Let's use it
-      GloEphemeris data( i->second );
-
-         // Compute the satellite position, velocity and clock offset
-      sv = data.svXvt( epoch );
+      return &(i->second);
 
-         // We are done, let's return
-      return sv;
-
-   }; // End of method 'GloEphemerisStore::getXvt()'
+   }; // End of method 'GloEphemerisStore::findRecord()'
 
 
       /* A debugging function that outputs in human readable form,
@@ -72,7 +72,7 @@ namespace gpstk
       GloEphemerisStore()
             : initialTime(CommonTime::END_OF_TIME),
               finalTime(CommonTime::BEGINNING_OF_TIME),
-              step(1.0), checkHealthFlag(false)
+              step(1.0), checkHealthFlag(false), tableSpacing(0.0)
       { };
 
          /** Common constructor
@@ -84,7 +84,7 @@ namespace gpstk
                          double checkHealth )
             : initialTime(CommonTime::END_OF_TIME),
               finalTime(CommonTime::BEGINNING_OF_TIME),
-              step(rkStep), checkHealthFlag(checkHealth)
+              step(rkStep), checkHealthFlag(checkHealth), tableSpacing(0.0)
       { };
 
          /// Destructor
@@ -110,6 +110,24 @@ namespace gpstk
       Xvt getXvt( const SatID& sat,
                   const CommonTime& epoch ) const;
 
+         /** Returns the position, velocity and clock offset of each of
+          *  several satellites, each at its own time; see
+          *  XvtStore::getXvts().
+          *
+          *  @param[in] ids   Satellites' identifiers
+          *  @param[in] times Time to look up for each of ids
+          *  @param[out] xvts The Xvt of each satellite
+          *  @param[out] valid False where getXvt() would throw
+          *
+          *  @return the number of Xvt computed
+          *
+          *  @throw InvalidRequest If ids and times differ in size.
+          */
+      virtual unsigned getXvts( const std::vector<SatID>& ids,
+                                const std::vector<CommonTime>& times,
+                                std::vector<Xvt>& xvts,
+                                std::vector<bool>& valid ) const;
+
          /// Get integration step for Runge-Kutta algorithm.
       double getIntegrationStep() const
       { return step; };
@@ -132,6 +150,32 @@ namespace gpstk
       GloEphemerisStore& setCheckHealthFlag( bool checkHealth )
       { checkHealthFlag = checkHealth; return (*this); };
 
+
+         /// Get the node spacing of the interpolation tables, in seconds,
+         /// or zero if each getXvt() integrates the orbit.
+      double getInterpolation() const
+      { return tableSpacing; };
+
+
+         /** Set whether getXvt() integrates the orbit from the ephemeris
+          *  epoch on every call (the default), or interpolates a table
+          *  built once per ephemeris; see GloEphemeris::buildTable().
+          *  Applies to the ephemerides already stored and to those
+          *  added afterwards.
+          *
+          * @param nodeSpacing   Table node spacing in seconds, or zero
+          *                      to integrate on every call.
+          */
+      GloEphemerisStore& setInterpolation( double nodeSpacing );
+
+
+         /** Return the largest accuracy bound, in meters, of the
+          *  interpolation tables of all the ephemerides stored; see
+          *  GloEphemeris::getTableErrorBound(). Zero if interpolation
+          *  is disabled.
+          */
+      double getInterpolationErrorBound() const;
+
          /** A debugging function that outputs in human readable form,
           *  all data stored in this object.
           * 
@@ -198,6 +242,12 @@ namespace gpstk
          /// Return true if the given SatID is present in the store
       virtual bool isPresent(const SatID& id) const;
 
+         /// The ephemerides and their interpolation tables are only read
+         /// by the const methods, so the store may be read by several
+         /// threads at once.
+      virtual bool beginConcurrentReads(void)
+      { return true; }
+
          /// Return the number of satellites present in the store
       int size(void) const
       { return pe.size(); }
@@ -267,6 +317,16 @@ namespace gpstk
          /// their health bit (by default it is false)
       bool checkHealthFlag;
 
+
+         /// Node spacing of the interpolation tables in seconds, zero if
+         /// the orbit is integrated on every call (the default)
+      double tableSpacing;
+
+         /// Return the record of table sem to use at epoch, or NULL if
+         /// epoch is out of boundaries for the satellite.
+      const GloEphemeris* findRecord( const TimeGloMap& sem,
+                                      const CommonTime& epoch ) const;
+
    };  // End of class 'GloEphemerisStore'
 
       //@}
@@ -45,6 +45,7 @@
 /// Galileo, and BeiDou, with RINEX Navigation input, among others.
 
 #include "OrbitEph.hpp"
+#include "OrbitEphKernel.hpp"
 #include "MathBase.hpp"
 #include "GNSSconstants.hpp"
 #include "CivilTime.hpp"
@@ -240,6 +241,20 @@ namespace gpstk {
       return sv;
    }
 
+   // Compute satellite position at each of several times, several at once.
+   // throw Invalid Request if the required data has not been stored.
+   void OrbitEph::svXvts(const vector<CommonTime>& t, vector<Xvt>& xvts) const
+   {
+      if(!dataLoadedFlag)
+         GPSTK_THROW(InvalidRequest("Data not loaded"));
+
+      xvts.resize(t.size());
+      if(t.empty()) return;
+
+      vector<const OrbitEph*> ephs(t.size(), this);
+      orbitEphXvt(&ephs[0], &t[0], &xvts[0], t.size());
+   }
+
    // Compute satellite relativity correction (sec) at the given time
    // throw Invalid Request if the required data has not been stored.
    double OrbitEph::svRelativity(const CommonTime& t) const
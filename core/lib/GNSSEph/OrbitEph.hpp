@@ -49,6 +49,7 @@
 #define GPSTK_ORBITEPH_HPP
 
 #include <string>
+#include <vector>
 #include "Exception.hpp"
 #include "CommonTime.hpp"
 #include "ObsID.hpp"
@@ -128,6 +129,16 @@ namespace gpstk
           * @throw Invalid Request if the required data has not been stored. */
       Xvt svXvt(const CommonTime& t) const;
 
+         /** Compute satellite position, velocity and clock at each of
+          * several times, as svXvt() does at one. The times are
+          * evaluated several at once by orbitEphXvt(); results agree
+          * with svXvt() to well under a millimeter.
+          * @param[in] t the times of interest
+          * @param[out] xvts the Xvt at each time, resized to t.size()
+          * @throw Invalid Request if the required data has not been stored. */
+      virtual void svXvts(const std::vector<CommonTime>& t,
+                          std::vector<Xvt>& xvts) const;
+
          /** Compute satellite relativity correction (sec) at the given time
           * @throw Invalid Request if the required data has not been stored. */
       double svRelativity(const CommonTime& t) const;
@@ -0,0 +1,464 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+/// @file OrbitEphKernel.cpp
+/// Evaluate the broadcast Kepler orbit of OrbitEph for many
+/// (ephemeris, time) pairs at once, several at a time on SIMD lanes.
+
+#include "OrbitEphKernel.hpp"
+#include "MathBase.hpp"
+#include "GNSSconstants.hpp"
+#include "GPSEllipsoid.hpp"
+#include "GPSWeekSecond.hpp"
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define GPSTK_ORBITEPHKERNEL_AVX
+#elif defined(__SSE2__) || defined(_M_X64) || \
+      (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define GPSTK_ORBITEPHKERNEL_SSE2
+#endif
+
+using namespace std;
+
+namespace gpstk
+{
+   namespace
+   {
+         // Lanes holds one double per SIMD lane. Comparisons return
+         // a mask in a Lanes, for use by select().
+#if defined(GPSTK_ORBITEPHKERNEL_AVX)
+      const size_t LANES = 4;
+
+      struct Lanes
+      {
+         Lanes() {}
+         Lanes(__m256d a) : v(a) {}
+         Lanes(double a) : v(_mm256_set1_pd(a)) {}
+         __m256d v;
+      };
+
+      inline Lanes load(const double *p)
+      { return _mm256_loadu_pd(p); }
+      inline void store(double *p, const Lanes& a)
+      { _mm256_storeu_pd(p, a.v); }
+      inline Lanes operator+(const Lanes& a, const Lanes& b)
+      { return _mm256_add_pd(a.v, b.v); }
+      inline Lanes operator-(const Lanes& a, const Lanes& b)
+      { return _mm256_sub_pd(a.v, b.v); }
+      inline Lanes operator*(const Lanes& a, const Lanes& b)
+      { return _mm256_mul_pd(a.v, b.v); }
+      inline Lanes operator/(const Lanes& a, const Lanes& b)
+      { return _mm256_div_pd(a.v, b.v); }
+      inline Lanes sqrt(const Lanes& a)
+      { return _mm256_sqrt_pd(a.v); }
+      inline Lanes operator>(const Lanes& a, const Lanes& b)
+      { return _mm256_cmp_pd(a.v, b.v, _CMP_GT_OQ); }
+      inline Lanes operator>=(const Lanes& a, const Lanes& b)
+      { return _mm256_cmp_pd(a.v, b.v, _CMP_GE_OQ); }
+      inline Lanes operator==(const Lanes& a, const Lanes& b)
+      { return _mm256_cmp_pd(a.v, b.v, _CMP_EQ_OQ); }
+      inline Lanes operator|(const Lanes& a, const Lanes& b)
+      { return _mm256_or_pd(a.v, b.v); }
+      inline Lanes select(const Lanes& m, const Lanes& a, const Lanes& b)
+      { return _mm256_blendv_pd(b.v, a.v, m.v); }
+
+#elif defined(GPSTK_ORBITEPHKERNEL_SSE2)
+      const size_t LANES = 2;
+
+      struct Lanes
+      {
+         Lanes() {}
+         Lanes(__m128d a) : v(a) {}
+         Lanes(double a) : v(_mm_set1_pd(a)) {}
+         __m128d v;
+      };
+
+      inline Lanes load(const double *p)
+      { return _mm_loadu_pd(p); }
+      inline void store(double *p, const Lanes& a)
+      { _mm_storeu_pd(p, a.v); }
+      inline Lanes operator+(const Lanes& a, const Lanes& b)
+      { return _mm_add_pd(a.v, b.v); }
+      inline Lanes operator-(const Lanes& a, const Lanes& b)
+      { return _mm_sub_pd(a.v, b.v); }
+      inline Lanes operator*(const Lanes& a, const Lanes& b)
+      { return _mm_mul_pd(a.v, b.v); }
+      inline Lanes operator/(const Lanes& a, const Lanes& b)
+      { return _mm_div_pd(a.v, b.v); }
+      inline Lanes sqrt(const Lanes& a)
+      { return _mm_sqrt_pd(a.v); }
+      inline Lanes operator>(const Lanes& a, const Lanes& b)
+      { return _mm_cmpgt_pd(a.v, b.v); }
+      inline Lanes operator>=(const Lanes& a, const Lanes& b)
+      { return _mm_cmpge_pd(a.v, b.v); }
+      inline Lanes operator==(const Lanes& a, const Lanes& b)
+      { return _mm_cmpeq_pd(a.v, b.v); }
+      inline Lanes operator|(const Lanes& a, const Lanes& b)
+      { return _mm_or_pd(a.v, b.v); }
+      inline Lanes select(const Lanes& m, const Lanes& a, const Lanes& b)
+      { return _mm_or_pd(_mm_and_pd(m.v, a.v), _mm_andnot_pd(m.v, b.v)); }
+
+#else
+      const size_t LANES = 1;
+
+      struct Lanes
+      {
+         Lanes() {}
+         Lanes(double a) : v(a) {}
+         double v;
+      };
+
+      inline Lanes load(const double *p)
+      { return *p; }
+      inline void store(double *p, const Lanes& a)
+      { *p = a.v; }
+      inline Lanes operator+(const Lanes& a, const Lanes& b)
+      { return a.v + b.v; }
+      inline Lanes operator-(const Lanes& a, const Lanes& b)
+      { return a.v - b.v; }
+      inline Lanes operator*(const Lanes& a, const Lanes& b)
+      { return a.v * b.v; }
+      inline Lanes operator/(const Lanes& a, const Lanes& b)
+      { return a.v / b.v; }
+      inline Lanes sqrt(const Lanes& a)
+      { return ::sqrt(a.v); }
+      inline Lanes operator>(const Lanes& a, const Lanes& b)
+      { return (a.v > b.v ? 1.0 : 0.0); }
+      inline Lanes operator>=(const Lanes& a, const Lanes& b)
+      { return (a.v >= b.v ? 1.0 : 0.0); }
+      inline Lanes operator==(const Lanes& a, const Lanes& b)
+      { return (a.v == b.v ? 1.0 : 0.0); }
+      inline Lanes operator|(const Lanes& a, const Lanes& b)
+      { return (a.v != 0.0 || b.v != 0.0 ? 1.0 : 0.0); }
+      inline Lanes select(const Lanes& m, const Lanes& a, const Lanes& b)
+      { return (m.v != 0.0 ? a : b); }
+#endif
+
+         /// Round to the nearest integer, for |x| < 2**51.
+      inline Lanes roundInt(const Lanes& x)
+      {
+         const Lanes magic(6755399441055744.0);    // 1.5 * 2**52
+         return (x + magic) - magic;
+      }
+
+         /** Sine and cosine of x, by reduction to [-pi/4,pi/4] and the
+          * polynomials of the Cephes library, accurate to about 1 ulp
+          * for the angles met here. */
+      void sincos(const Lanes& x, Lanes& s, Lanes& c)
+      {
+            // x = r + q*pi/2, with pi/2 split into three parts so that
+            // q*DP1 and q*DP2 are exact
+         const Lanes q(roundInt(x * 6.36619772367581343076e-1));
+         const Lanes r(((x - q * 1.57079625129699707031e0)
+                          - q * 7.54978941586159635335e-8)
+                          - q * 5.39030285815811905290e-15);
+
+         const Lanes z(r * r);
+         const Lanes ps((((((z * 1.58962301576546568060e-10
+                               - 2.50507477628578072866e-8) * z
+                               + 2.75573136213857245213e-6) * z
+                               - 1.98412698295895385996e-4) * z
+                               + 8.33333333332211858878e-3) * z
+                               - 1.66666666666666307295e-1));
+         const Lanes pc((((((z * -1.13585365213876817300e-11
+                               + 2.08757008419747316778e-9) * z
+                               - 2.75573141792967388112e-7) * z
+                               + 2.48015872888517045348e-5) * z
+                               - 1.38888888888730564116e-3) * z
+                               + 4.16666666666665929218e-2));
+         const Lanes sr(r + r * z * ps);
+         const Lanes cr((Lanes(1.0) - z * 0.5) + z * z * pc);
+
+            // quadrant m = q mod 4
+         const Lanes y(q * 0.25);
+         Lanes fy(roundInt(y));
+         fy = select(fy > y, fy - 1.0, fy);
+         const Lanes m(q - fy * 4.0);
+
+         const Lanes odd((m == 1.0) | (m == 3.0));
+         s = select(odd, cr, sr) * select(m >= 2.0, Lanes(-1.0), Lanes(1.0));
+         c = select(odd, sr, cr) *
+             select((m == 1.0) | (m == 2.0), Lanes(-1.0), Lanes(1.0));
+      }
+
+         /** Sine and cosine of a small angle d, |d| < 0.05, by
+          * their Taylor series. */
+      inline void sincosSmall(const Lanes& d, Lanes& s, Lanes& c)
+      {
+         const Lanes d2(d * d);
+         s = d * (Lanes(1.0) - d2 * (1.0/6.0) *
+                  (Lanes(1.0) - d2 * (1.0/20.0) *
+                   (Lanes(1.0) - d2 * (1.0/42.0))));
+         c = Lanes(1.0) - d2 * 0.5 *
+             (Lanes(1.0) - d2 * (1.0/12.0) *
+              (Lanes(1.0) - d2 * (1.0/30.0) *
+               (Lanes(1.0) - d2 * (1.0/56.0))));
+      }
+
+         /** Number of Newton steps for Kepler's equation. Starting
+          * from E = M + e sin(M), the error after 4 steps is below
+          * 1e-16 rad for e < 0.3; one more is taken for margin. */
+      const int NEWTON_STEPS = 5;
+
+         /// Largest eccentricity evaluated on the lanes.
+      const double MAX_ECC = 0.3;
+
+         /// The orbit parameters of a group of requests, one per lane.
+      struct LaneParams
+      {
+         double dt[LANES];       ///< time since Toe
+         double tc[LANES];       ///< time since Toc
+         double M0[LANES], ecc[LANES], A[LANES], Adot[LANES];
+         double n0[LANES];       ///< sqrt(GM/A**3)
+         double dn[LANES], dndot[LANES];
+         double Ahalf[LANES];    ///< sqrt(A)
+         double q[LANES];        ///< sqrt(1-e**2)
+         double cw[LANES], sw[LANES];    ///< cos(w), sin(w)
+         double i0[LANES], idot[LANES], OMEGA0[LANES], OMEGAdot[LANES];
+         double ToeSOW[LANES];
+         double Cuc[LANES], Cus[LANES], Crc[LANES], Crs[LANES];
+         double Cic[LANES], Cis[LANES];
+         double af0[LANES], af1[LANES], af2[LANES];
+      };
+
+         /// Per-ephemeris terms, kept while one ephemeris is repeated.
+      struct EphTerms
+      {
+         EphTerms() : eph(0) {}
+         const OrbitEph *eph;
+         double n0, Ahalf, q, cw, sw, ToeSOW;
+      };
+
+         /// Fill lane k of p with request (eph,t).
+      void setLane(LaneParams& p, size_t k, EphTerms& terms,
+                   const OrbitEph *eph, const CommonTime& t, double sqrtgm)
+      {
+         if(terms.eph != eph) {
+            terms.eph = eph;
+            terms.Ahalf = SQRT(eph->A);
+            terms.n0 = sqrtgm / (eph->A * terms.Ahalf);
+            terms.q = SQRT(1.0 - eph->ecc * eph->ecc);
+            terms.cw = ::cos(eph->w);
+            terms.sw = ::sin(eph->w);
+            terms.ToeSOW = GPSWeekSecond(eph->ctToe).sow;
+         }
+
+         p.dt[k] = t - eph->ctToe;
+         p.tc[k] = t - eph->ctToc;
+         p.M0[k] = eph->M0;
+         p.ecc[k] = eph->ecc;
+         p.A[k] = eph->A;
+         p.Adot[k] = eph->Adot;
+         p.n0[k] = terms.n0;
+         p.dn[k] = eph->dn;
+         p.dndot[k] = eph->dndot;
+         p.Ahalf[k] = terms.Ahalf;
+         p.q[k] = terms.q;
+         p.cw[k] = terms.cw;
+         p.sw[k] = terms.sw;
+         p.i0[k] = eph->i0;
+         p.idot[k] = eph->idot;
+         p.OMEGA0[k] = eph->OMEGA0;
+         p.OMEGAdot[k] = eph->OMEGAdot;
+         p.ToeSOW[k] = terms.ToeSOW;
+         p.Cuc[k] = eph->Cuc;
+         p.Cus[k] = eph->Cus;
+         p.Crc[k] = eph->Crc;
+         p.Crs[k] = eph->Crs;
+         p.Cic[k] = eph->Cic;
+         p.Cis[k] = eph->Cis;
+         p.af0[k] = eph->af0;
+         p.af1[k] = eph->af1;
+         p.af2[k] = eph->af2;
+      }
+
+         /** Evaluate the first count lanes of p into xvts[index[k]];
+          * this is OrbitEph::svXvt() with the lanes in place of
+          * scalars. */
+      void evaluate(const LaneParams& p, const size_t *index, size_t count,
+                    Xvt *xvts, double sqrtgm, double we)
+      {
+         const Lanes dt(load(p.dt)), ecc(load(p.ecc)), q(load(p.q));
+
+            // semi-major axis and mean motion at t
+         const Lanes Ak(load(p.A) + load(p.Adot) * dt);
+         const Lanes amm(load(p.n0) + (load(p.dn) + load(p.dndot) * dt * 0.5));
+
+            // Kepler's equation, by Newton's method with sin and cos of
+            // the eccentric anomaly carried by angle addition
+         const Lanes meana(load(p.M0) + dt * amm);
+         Lanes sinea, cosea, sd, cd;
+         sincos(meana, sinea, cosea);
+         Lanes ea(meana + ecc * sinea);
+         sincos(ea, sinea, cosea);
+         for(int i=0; i<NEWTON_STEPS; i++) {
+            const Lanes delea((meana - (ea - ecc * sinea)) /
+                              (Lanes(1.0) - ecc * cosea));
+            ea = ea + delea;
+            sincosSmall(delea, sd, cd);
+            const Lanes s(sinea * cd + cosea * sd);
+            cosea = cosea * cd - sinea * sd;
+            sinea = s;
+         }
+
+            // sin and cos of the true anomaly, G*SIN(TA) and G*COS(TA)
+            // having norm G
+         const Lanes G(Lanes(1.0) - ecc * cosea);
+         const Lanes sinta(q * sinea / G);
+         const Lanes costa((cosea - ecc) / G);
+
+            // argument of latitude and correction terms (2nd harmonic)
+         const Lanes cw(load(p.cw)), sw(load(p.sw));
+         const Lanes salat(sinta * cw + costa * sw);
+         const Lanes calat(costa * cw - sinta * sw);
+         const Lanes c2al(calat * calat - salat * salat);
+         const Lanes s2al(salat * calat * 2.0);
+
+         const Lanes Cuc(load(p.Cuc)), Cus(load(p.Cus));
+         const Lanes Crc(load(p.Crc)), Crs(load(p.Crs));
+         const Lanes Cic(load(p.Cic)), Cis(load(p.Cis));
+         const Lanes du(c2al * Cuc + s2al * Cus);
+         const Lanes dr(c2al * Crc + s2al * Crs);
+         const Lanes di(c2al * Cic + s2al * Cis);
+
+            // U = alat + du, R = radius, AINC = inclination
+         sincosSmall(du, sd, cd);
+         const Lanes sinu(salat * cd + calat * sd);
+         const Lanes cosu(calat * cd - salat * sd);
+         const Lanes R(Ak * G + dr);
+         const Lanes idot(load(p.idot));
+         const Lanes AINC(load(p.i0) + idot * dt + di);
+
+            // longitude of ascending node
+         const Lanes OMEGAdot(load(p.OMEGAdot));
+         const Lanes ANLON(load(p.OMEGA0) + (OMEGAdot - we) * dt
+                           - load(p.ToeSOW) * we);
+
+            // in plane location, and rotation to earth fixed
+         const Lanes xip(R * cosu), yip(R * sinu);
+         Lanes san, can, sinc, cinc;
+         sincos(ANLON, san, can);
+         sincos(AINC, sinc, cinc);
+
+         double x[3][LANES], v[3][LANES];
+         store(x[0], xip * can - yip * cinc * san);
+         store(x[1], xip * san + yip * cinc * can);
+         store(x[2], yip * sinc);
+
+            // velocity of rotation coordinates, and velocities
+         const Lanes dek(amm * Ak / R);
+         const Lanes dlk(load(p.Ahalf) * q * sqrtgm / (R * R));
+         const Lanes div(idot - dlk * 2.0 * (Cic * s2al - Cis * c2al));
+         const Lanes domk(OMEGAdot - we);
+         const Lanes duv(dlk * (Lanes(1.0) + (Cus * c2al - Cuc * s2al) * 2.0));
+         const Lanes drv(Ak * ecc * dek * sinea
+                         - dlk * 2.0 * (Crc * s2al - Crs * c2al));
+         const Lanes dxp(drv * cosu - R * sinu * duv);
+         const Lanes dyp(drv * sinu + R * cosu * duv);
+
+         store(v[0], dxp * can - xip * san * domk - dyp * cinc * san
+                     + yip * (sinc * san * div - cinc * can * domk));
+         store(v[1], dxp * san + xip * can * domk + dyp * cinc * can
+                     - yip * (sinc * can * div + cinc * san * domk));
+         store(v[2], dyp * sinc + yip * cinc * div);
+
+            // clock corrections
+         const Lanes tc(load(p.tc)), af1(load(p.af1)), af2(load(p.af2));
+         double relcorr[LANES], clkbias[LANES], clkdrift[LANES];
+         store(relcorr, ecc * sqrt(Ak) * sinea * REL_CONST);
+         store(clkbias, load(p.af0) + tc * (af1 + tc * af2));
+         store(clkdrift, af1 + tc * af2);
+
+         for(size_t k=0; k<count; k++) {
+            Xvt& sv(xvts[index[k]]);
+            for(int j=0; j<3; j++) {
+               sv.x[j] = x[j][k];
+               sv.v[j] = v[j][k];
+            }
+            sv.clkbias = clkbias[k];
+            sv.clkdrift = clkdrift[k];
+            sv.relcorr = relcorr[k];
+            sv.frame = ReferenceFrame::WGS84;
+         }
+      }
+   }
+
+
+   void orbitEphXvt(const OrbitEph *const *ephs, const CommonTime *times,
+                    Xvt *xvts, size_t n)
+   {
+      GPSEllipsoid ell;
+      const double sqrtgm(SQRT(ell.gm()));
+      const double we(ell.angVelocity());
+
+      LaneParams p;
+      EphTerms terms;
+      size_t index[LANES];
+      size_t count(0);
+
+      for(size_t i=0; i<n; i++) {
+         const OrbitEph *eph = ephs[i];
+         if(!eph->dataLoaded() || !(eph->ecc >= 0.0 && eph->ecc < MAX_ECC)) {
+            xvts[i] = eph->OrbitEph::svXvt(times[i]);
+            continue;
+         }
+
+         setLane(p, count, terms, eph, times[i], sqrtgm);
+         index[count++] = i;
+         if(count == LANES) {
+            evaluate(p, index, count, xvts, sqrtgm, we);
+            count = 0;
+         }
+      }
+
+      if(count > 0) {
+            // fill the unused lanes with the last request
+         for(size_t k=count; k<LANES; k++)
+            setLane(p, k, terms, ephs[index[count-1]], times[index[count-1]],
+                    sqrtgm);
+         evaluate(p, index, count, xvts, sqrtgm, we);
+      }
+   }
+
+
+   size_t orbitEphKernelLanes(void)
+   {
+      return LANES;
+   }
+
+}  // End of namespace gpstk
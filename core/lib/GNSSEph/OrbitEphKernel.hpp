@@ -0,0 +1,83 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+/// @file OrbitEphKernel.hpp
+/// Evaluate the broadcast Kepler orbit of OrbitEph for many
+/// (ephemeris, time) pairs at once, several at a time on SIMD lanes.
+
+#ifndef GPSTK_ORBITEPHKERNEL_HPP
+#define GPSTK_ORBITEPHKERNEL_HPP
+
+#include <cstddef>
+#include "CommonTime.hpp"
+#include "Xvt.hpp"
+#include "OrbitEph.hpp"
+
+namespace gpstk
+{
+      /// @ingroup GNSSEph
+      //@{
+
+      /** Compute xvts[i] = ephs[i]->OrbitEph::svXvt(times[i]) for i
+       * in [0,n). The requests are evaluated in groups of
+       * orbitEphKernelLanes() on SIMD lanes (AVX when the library is
+       * built for it, otherwise SSE2, otherwise one at a time):
+       * Kepler's equation is solved with a fixed number of Newton
+       * steps on all lanes, the trigonometric functions are evaluated
+       * on the lanes, and the true anomaly and corrected argument of
+       * latitude are formed by angle addition rather than atan2.
+       * The results agree with svXvt() to well under a millimeter.
+       * Requests with an eccentricity of 0.3 or more, for which the
+       * fixed Newton steps are not enough, are passed to svXvt().
+       * The relativity correction is computed from the eccentric
+       * anomaly of the orbit, which differs from that of
+       * OrbitEph::svRelativity() only by the dndot term of CNAV.
+       * @param[in] ephs the ephemeris for each request
+       * @param[in] times the time of each request
+       * @param[out] xvts the result of each request
+       * @param[in] n the number of requests
+       * @throw InvalidRequest if any ephemeris has no data loaded */
+   void orbitEphXvt(const OrbitEph *const *ephs, const CommonTime *times,
+                    Xvt *xvts, std::size_t n);
+
+      /// Return the number of requests orbitEphXvt() evaluates at once.
+   std::size_t orbitEphKernelLanes(void);
+
+      //@}
+
+}  // End of namespace gpstk
+
+#endif // GPSTK_ORBITEPHKERNEL_HPP
@@ -45,6 +45,7 @@
 #include <iostream>
 #include <fstream>
 #include <iomanip>
+#include <algorithm>
 
 #include "StringUtils.hpp"
 #include "MathBase.hpp"
@@ -53,6 +54,7 @@
 #include "RinexSatID.hpp"  // for dump
 
 #include "OrbitEphStore.hpp"
+#include "OrbitEphKernel.hpp"
 
 using namespace std;
 using namespace gpstk::StringUtils;
@@ -80,6 +82,54 @@ namespace gpstk
       catch(InvalidRequest& ir) { GPSTK_RETHROW(ir); }
    }
 
+   //---------------------------------------------------------------------------------
+   unsigned OrbitEphStore::getXvts(const vector<SatID>& ids,
+                                   const vector<CommonTime>& times,
+                                   vector<Xvt>& xvts,
+                                   vector<bool>& valid) const
+   {
+      if(ids.size() != times.size())
+         GPSTK_THROW(InvalidRequest("getXvts: ids and times differ in size"));
+
+      // find the OrbitEph for each request; with fastXvts, evaluate them
+      // all at once afterwards
+      vector<const OrbitEph*> ephs;
+      vector<CommonTime> ephTimes;
+      vector<Xvt> ephXvts;
+      vector<size_t> index;
+      xvts.resize(ids.size());
+      valid.assign(ids.size(), false);
+      for(size_t i=0; i<ids.size(); i++) {
+         try {
+            // no OrbitEph, or an unhealthy one, is flagged without a throw
+            const OrbitEph *eph = findOrbitEph(ids[i],times[i]);
+            if(!eph || !eph->dataLoaded() || (onlyHealthy && !eph->isHealthy()))
+               continue;
+
+            if(!fastXvts) {
+               xvts[i] = eph->svXvt(times[i]);
+               valid[i] = true;
+               index.push_back(i);
+               continue;
+            }
+
+            ephs.push_back(eph);
+            ephTimes.push_back(times[i]);
+            index.push_back(i);
+         }
+         catch(InvalidRequest&) { }    // e.g. time system mismatch
+      }
+
+      if(ephs.empty()) return index.size();
+      ephXvts.resize(ephs.size());
+      orbitEphXvt(&ephs[0], &ephTimes[0], &ephXvts[0], ephs.size());
+      for(size_t k=0; k<index.size(); k++) {
+         xvts[index[k]] = ephXvts[k];
+         valid[index[k]] = true;
+      }
+      return index.size();
+   }
+
    //---------------------------------------------------------------------------------
    void OrbitEphStore::dump(ostream& os, short detail) const
    {
@@ -194,6 +244,8 @@ namespace gpstk
    {
       OrbitEph *ret(0);
       try {
+         thawIndex();
+
          // is the satellite found in the table? If not, create one
          if(satTables.find(eph->satID) == satTables.end()) {
             TimeOrbitEphTable newtable;
@@ -292,6 +344,8 @@ namespace gpstk
    //---------------------------------------------------------------------------------
    void OrbitEphStore::edit(const CommonTime& tmin, const CommonTime& tmax)
    {
+      thawIndex();
+
       for(SatTableMap::iterator i = satTables.begin(); i != satTables.end(); i++)
       {
          TimeOrbitEphTable& eMap = i->second;
@@ -355,6 +409,24 @@ namespace gpstk
    const OrbitEph* OrbitEphStore::findUserOrbitEph(const SatID& sat,
                                                    const CommonTime& t) const
    {
+      // Same rule as below, using the lookup index: take the last element
+      // whose key is strictly before t, if it is valid at t.
+      if(indexFrozen) {
+         const FlatEphTable *ft = findFlatTable(sat,t);
+         if(ft) {
+            if(ft->ephs.empty()) return NULL;
+            const TickTime tt(t);
+            const size_t n = countKeysBefore(*ft, t, tt,
+                                             !concurrentReads);
+            if(n == 0) return NULL;
+            const size_t i = n-1;
+            if(tt < ft->beginTicks[i] || tt > ft->endTicks[i]) return NULL;
+            if(tt > ft->beginTicks[i] && tt < ft->endTicks[i])
+               return ft->ephs[i];
+            return (ft->ephs[i]->isValid(t) ? ft->ephs[i] : NULL);
+         }
+      }
+
       // Is this satellite found in the table?
       if(satTables.find(sat) == satTables.end())
          return NULL;
@@ -431,6 +503,27 @@ namespace gpstk
    const OrbitEph* OrbitEphStore::findNearOrbitEph(const SatID& sat,
                                                    const CommonTime& t) const
    {
+      // Same cases as below, using the lookup index.
+      if(indexFrozen) {
+         const FlatEphTable *ft = findFlatTable(sat,t);
+         if(ft) {
+            const size_t size = ft->ephs.size();
+            if(size == 0) return NULL;
+            const TickTime tt(t);
+            const size_t n = countKeysBefore(*ft, t, tt,
+                                             !concurrentReads);
+            if(n < size && ft->keyTicks[n] == tt && !(t < ft->keys[n]))
+               return ft->ephs[n];                  // exact match
+            if(n == 0) return ft->ephs[0];
+            if(n == size) return ft->ephs[size-1];
+            double diffToNext = ft->ephs[n]->ctToe - t;
+            double diffFromLast = t - ft->ephs[n-1]->ctToe;
+            if(diffToNext > diffFromLast)
+               return ft->ephs[n-1];
+            return ft->ephs[n];
+         }
+      }
+
 
         // Check for any OrbitEph for this SV
       if(satTables.find(sat) == satTables.end())
@@ -473,6 +566,106 @@ namespace gpstk
       return itNext->second;
    }
 
+   //---------------------------------------------------------------------------------
+   void OrbitEphStore::freezeIndex(void)
+   {
+      thawIndex();
+
+      indexSats.reserve(satTables.size());
+      indexTables.resize(satTables.size());
+
+      size_t k(0);
+      SatTableMap::const_iterator it;
+      for(it = satTables.begin(); it != satTables.end(); ++it, ++k) {
+         const TimeOrbitEphTable& table = it->second;
+         FlatEphTable& ft = indexTables[k];
+         indexSats.push_back(it->first);
+
+         ft.keyTicks.reserve(table.size());
+         ft.beginTicks.reserve(table.size());
+         ft.endTicks.reserve(table.size());
+         ft.keys.reserve(table.size());
+         ft.ephs.reserve(table.size());
+         ft.timeSystem = TimeSystem::Any;
+         ft.usable = true;
+         ft.lastHit = 0;
+
+         TimeOrbitEphTable::const_iterator ei;
+         for(ei = table.begin(); ei != table.end(); ++ei) {
+            const OrbitEph *eph = ei->second;
+            ft.keyTicks.push_back(TickTime(ei->first));
+            ft.beginTicks.push_back(TickTime(eph->beginValid));
+            ft.endTicks.push_back(TickTime(eph->endValid));
+            ft.keys.push_back(ei->first);
+            ft.ephs.push_back(eph);
+
+            // the tick comparisons are only equivalent to CommonTime
+            // comparisons when everything is in one time system
+            if(!eph->dataLoaded()) ft.usable = false;
+            const TimeSystem sys[3] = { ei->first.getTimeSystem(),
+                                        eph->beginValid.getTimeSystem(),
+                                        eph->endValid.getTimeSystem() };
+            for(int j=0; j<3; j++) {
+               if(sys[j] == TimeSystem::Any) continue;
+               if(ft.timeSystem == TimeSystem::Any) ft.timeSystem = sys[j];
+               else if(ft.timeSystem != sys[j]) ft.usable = false;
+            }
+         }
+      }
+
+      indexFrozen = true;
+   }
+
+   //---------------------------------------------------------------------------------
+   const OrbitEphStore::FlatEphTable*
+      OrbitEphStore::findFlatTable(const SatID& sat, const CommonTime& t) const
+   {
+      std::vector<SatID>::const_iterator it =
+         std::lower_bound(indexSats.begin(), indexSats.end(), sat);
+      if(it == indexSats.end() || *it != sat)
+         return NULL;
+
+      const FlatEphTable& ft = indexTables[it - indexSats.begin()];
+      if(!ft.usable)
+         return NULL;
+
+      // a mismatched time system is left to the map search, which throws
+      const TimeSystem ts(t.getTimeSystem());
+      if(ts != TimeSystem::Any && ft.timeSystem != TimeSystem::Any &&
+         ts != ft.timeSystem)
+         return NULL;
+
+      return &ft;
+   }
+
+   //---------------------------------------------------------------------------------
+   size_t OrbitEphStore::countKeysBefore(const FlatEphTable& ft,
+                                         const CommonTime& t, const TickTime& tt,
+                                         bool updateHit)
+   {
+      const size_t size = ft.keyTicks.size();
+      const TickTime *keys = &ft.keyTicks[0];
+
+      // Try the last hit, then the next element, which covers
+      // monotonic queries; ties in the tick fall through to the search.
+      size_t n = ft.lastHit;
+      if(n <= size) {
+         if((n == 0 || keys[n-1] < tt) && (n == size || keys[n] > tt))
+            return n;
+         if(n < size && keys[n] < tt && (n+1 == size || keys[n+1] > tt)) {
+            if(updateHit) ft.lastHit = n+1;
+            return n+1;
+         }
+      }
+
+      n = std::lower_bound(keys, keys+size, tt) - keys;
+      while(n < size && keys[n] == tt && ft.keys[n] < t)
+         n++;
+
+      if(updateHit) ft.lastHit = n;
+      return n;
+   }
+
    //---------------------------------------------------------------------------------
    // Add all ephemerides to an existing list<OrbitEph>.
    // If SatID sat is given, limit selections to sat's satellite system, plus if
@@ -48,12 +48,15 @@
 
 #include <iostream>
 #include <list>
+#include <vector>
 
 #include "OrbitEph.hpp"
 #include "Exception.hpp"
 #include "SatID.hpp"
 #include "CommonTime.hpp"
+#include "TickTime.hpp"
 #include "XvtStore.hpp"
+#include "gpstkplatform.h"
 //#include "Rinex3NavData.hpp"
 
 namespace gpstk
@@ -77,7 +80,8 @@ namespace gpstk
       OrbitEphStore()
             : initialTime(CommonTime::END_OF_TIME), 
               finalTime(CommonTime::BEGINNING_OF_TIME),
-              strictMethod(true), onlyHealthy(false)
+              strictMethod(true), onlyHealthy(false), fastXvts(false),
+              indexFrozen(false), concurrentReads(false)
       {
          timeSystem = TimeSystem::Any;
          initialTime.setTimeSystem(timeSystem);
@@ -101,6 +105,19 @@ namespace gpstk
           *   there are no orbit elements at time t. */
       virtual Xvt getXvt(const SatID& id, const CommonTime& t) const;
 
+         /** Compute the Xvt of several satellites, each at its own
+          * time; see XvtStore::getXvts(). Requests that find no
+          * (healthy) OrbitEph are flagged without constructing an
+          * exception; with the index built by freezeIndex(), runs of
+          * requests for one satellite also reuse its last hit. With
+          * setFastXvtsFlag(true) the orbits are evaluated several at
+          * once by orbitEphXvt(); otherwise each is evaluated by
+          * OrbitEph::svXvt(), exactly as getXvt() does. */
+      virtual unsigned getXvts(const std::vector<SatID>& ids,
+                               const std::vector<CommonTime>& times,
+                               std::vector<Xvt>& xvts,
+                               std::vector<bool>& valid) const;
+
          /** Output summary of store data in human readable form, with detail:
           *  0: Time limits and number of entries for entire store
           *  1: Level 0 plus for each satellite: one line giving
@@ -128,6 +145,8 @@ namespace gpstk
          /// Clear the dataset, meaning remove all data
       virtual void clear(void)
       {
+         thawIndex();
+
          for(SatTableMap::iterator ui=satTables.begin(); ui!=satTables.end(); ui++) {
             TimeOrbitEphTable& toet = ui->second;
             toet.clear();
@@ -211,12 +230,47 @@ namespace gpstk
       virtual TimeSystem getTimeSystem(void) const
       { return timeSystem; }
 
+         /** Prepare the store to be read by several threads at once.
+          * The lookup index, if frozen, stops remembering the last
+          * hit of each satellite until endConcurrentReads(). */
+      virtual bool beginConcurrentReads(void)
+      { concurrentReads = true; return true; }
+
+         /// End the concurrent reads started by beginConcurrentReads().
+      virtual void endConcurrentReads(void)
+      { concurrentReads = false; }
+
          //---------------------------------------------------------------
          // This ends the XvtStore<SatID> interface. Below are
          // interfaces that are unique to this class (i.e. not in the
          // parent class XvtStore<SatID>)
          // ---------------------------------------------------------------
 
+         /** Build a compact, read-only index of the store for fast
+          * lookups. Call this after all ephemerides have been added
+          * (and after rationalize(), where applicable); until the
+          * index is thawed, findUserOrbitEph() and findNearOrbitEph()
+          * search per-satellite arrays of integer time keys instead
+          * of the maps, and remember the last hit for each satellite
+          * so that monotonic queries usually avoid a search entirely.
+          * The results are identical to the map-based searches.
+          * Any change to the store (addEphemeris(), edit(), clear(),
+          * rationalize()) thaws the index; if the OrbitEph objects
+          * are modified by other means, call freezeIndex() again. */
+      void freezeIndex(void);
+
+         /// Discard the lookup index built by freezeIndex().
+      void thawIndex(void)
+      {
+         indexSats.clear();
+         indexTables.clear();
+         indexFrozen = false;
+      }
+
+         /// Return true if the lookup index built by freezeIndex() is in use.
+      bool isIndexFrozen(void) const
+      { return indexFrozen; }
+
          /** Get the number of OrbitEph objects in this collection for
           * all satellites.
           * @return the number of OrbitEph records in the map for all
@@ -326,6 +380,16 @@ namespace gpstk
       void setOnlyHealthyFlag(bool flag)
       { onlyHealthy = flag; }
 
+         /// get the flag that evaluates getXvts() with orbitEphXvt()
+      bool getFastXvtsFlag(void) const
+      { return fastXvts; }
+
+         /** set the flag that evaluates getXvts() with orbitEphXvt(),
+          * several orbits at once. The results then differ from
+          * getXvt() by about 1e-7 m (default false). */
+      void setFastXvtsFlag(bool flag)
+      { fastXvts = flag; }
+
          /** Return the satellite health at the given time.
           * @param SatID sat satellite of interest
           * @param CommonTime t time of interest
@@ -381,6 +445,62 @@ namespace gpstk
           * from getXvt, otherwise it will throw (default false) */
       bool onlyHealthy;
 
+         /** flag indicating getXvts() evaluates the orbits with
+          * orbitEphXvt() rather than svXvt() (default false) */
+      bool fastXvts;
+
+         /** Flattened copy of one TimeOrbitEphTable, built by
+          * freezeIndex(). The tick arrays hold times as TickTime and
+          * are parallel to keys and ephs; times with equal ticks are
+          * resolved with the full CommonTime comparison. */
+      struct FlatEphTable
+      {
+         std::vector<TickTime> keyTicks;   ///< table keys
+         std::vector<TickTime> beginTicks; ///< beginValid of each OrbitEph
+         std::vector<TickTime> endTicks;   ///< endValid of each OrbitEph
+         std::vector<CommonTime> keys;    ///< table keys, for ties
+         std::vector<const OrbitEph*> ephs;
+
+            /** Common time system of all the keys and validity
+             * limits; queries in any other system use the map. */
+         TimeSystem timeSystem;
+
+            /** False if the table cannot be searched by ticks (mixed
+             * time systems or unloaded data), so the map is used. */
+         bool usable;
+
+            /** Result of the last search, as the number of keys
+             * before the query time. This is only a hint: it is
+             * checked before it is used, so a stale value only costs
+             * a search. It is not updated during concurrent reads. */
+         mutable size_t lastHit;
+      };
+
+         /** Return the flattened table for sat, or NULL if the
+          * index is not frozen, the satellite is not present, or
+          * the table cannot be searched at time t. */
+      const FlatEphTable* findFlatTable(const SatID& sat,
+                                        const CommonTime& t) const;
+
+         /** Return the number of keys in table that are strictly
+          * earlier than t, whose tick is tt. The last hit of the
+          * table is updated if updateHit is true. */
+      static size_t countKeysBefore(const FlatEphTable& table,
+                                    const CommonTime& t, const TickTime& tt,
+                                    bool updateHit);
+
+         /// Sorted satellites in the lookup index, parallel to indexTables.
+      std::vector<SatID> indexSats;
+
+         /// Flattened tables of the lookup index, parallel to indexSats.
+      std::vector<FlatEphTable> indexTables;
+
+         /// True if the lookup index is current and should be used.
+      bool indexFrozen;
+
+         /// True between beginConcurrentReads() and endConcurrentReads().
+      bool concurrentReads;
+
          /// Convenience routines
       void updateTimeLimits(const OrbitEph* eph)
       {
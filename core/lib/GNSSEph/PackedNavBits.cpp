@@ -39,6 +39,7 @@
  * Engineering units navigation message abstraction.
  */
 #include <math.h>
+#include <algorithm>
 #include <iostream>
 #include <iomanip>
 
@@ -52,23 +53,56 @@
 namespace gpstk
 {
    using namespace std;
+
+      // Multiply value by 2^power2.  Gives the same result as ldexp(),
+      // but builds the power of two directly for the exponents of
+      // normal doubles, instead of calling the library.
+   static inline double scalePow2(const double value, const int power2)
+   {
+      if (power2 < -1022 || power2 > 1023)
+      {
+         return ldexp(value, power2);
+      }
+      union
+      {
+         uint64_t u;
+         double d;
+      } scale;
+      scale.u = uint64_t(power2 + 1023) << 52;
+      return value * scale.d;
+   }
+
+      // Largest value of an unsigned field of numBits bits.
+   static inline uint64_t maxUnsigned(const int numBits)
+   {
+      return (numBits >= 64 ? ~uint64_t(0) : (uint64_t(1) << numBits) - 1);
+   }
+
+      // Largest value of a two's complement field of numBits bits.
+   static inline int64_t maxSigned(const int numBits)
+   {
+      return (int64_t) (maxUnsigned(numBits) >> 1);
+   }
+
    PackedNavBits::PackedNavBits()
                  : transmitTime(CommonTime::BEGINNING_OF_TIME),
-                   bits(900),
+                   bits_size(0),
                    bits_used(0),
                    rxID(""),
                    xMitCoerced(false)
    {
+      resizeBits(900);
       transmitTime.setTimeSystem(TimeSystem::GPS);
    }
    PackedNavBits::PackedNavBits(const SatID& satSysArg, 
                                 const ObsID& obsIDArg,
                                 const CommonTime& transmitTimeArg)
-                                : bits(900),
+                                : bits_size(0),
                                   bits_used(0),
                                   rxID(""),
                                   xMitCoerced(false)
    {
+      resizeBits(900);
       satSys = satSysArg;
       obsID = obsIDArg;
       transmitTime = transmitTimeArg;
@@ -79,11 +113,12 @@ namespace gpstk
                                 const ObsID& obsIDArg,
                                 const std::string rxString,
                                 const CommonTime& transmitTimeArg)
-                                : bits(900),
+                                : bits_size(0),
                                   bits_used(0),
                                   rxID(""),
                                   xMitCoerced(false)
    {
+      resizeBits(900);
       satSys = satSysArg;
       obsID = obsIDArg;
       rxID = rxString;
@@ -99,11 +134,9 @@ namespace gpstk
       rxID   = right.rxID;
       transmitTime = right.transmitTime;
       bits_used = right.bits_used;
-      bits.resize(bits_used);
-      for (int i=0;i<bits_used;i++)
-      {
-         bits[i] = right.bits[i];
-      }
+      words = right.words;
+      bits_size = right.bits_size;
+      resizeBits(bits_used);
       xMitCoerced = right.xMitCoerced;
    }
  
@@ -155,7 +188,7 @@ namespace gpstk
    
    void PackedNavBits::clearBits()
    {
-      bits.clear();
+      resizeBits(0);
       bits_used = 0;
    }
 
@@ -184,25 +217,70 @@ namespace gpstk
       return(bits_used);
    }
 
+   //--------------------------------------------------------------------------
+   void PackedNavBits::resizeBits( const size_t numBits )
+   {
+      size_t last = numBits >> 6;
+      words.resize(last + 2, 0);
+
+         // Clear whatever is left past the new end, so that the
+         // word-wise compares and extractions see zeros there.
+      unsigned offset = numBits & 63;
+      words[last] &= (offset ? ~uint64_t(0) << (64 - offset) : 0);
+      words[last + 1] = 0;
+      bits_size = numBits;
+   }
+
+   //--------------------------------------------------------------------------
+   inline uint64_t PackedNavBits::extractBits( const size_t startBit,
+                                               const int numBits ) const
+   {
+      size_t ndx = startBit >> 6;
+      unsigned offset = startBit & 63;
+
+         // Left-justify the field, which may straddle two words.  The
+         // shift of the second word is split in two so that an offset
+         // of zero does not shift by the full word size.
+      uint64_t field = (words[ndx] << offset) |
+                       ((words[ndx + 1] >> 1) >> (63 - offset));
+
+         // Right-justify.  A zero-length field is cleared by the mask.
+      return ( (field >> ((64 - numBits) & 63)) &
+               (uint64_t(0) - uint64_t(numBits != 0)) );
+   }
+
+   //--------------------------------------------------------------------------
+   inline void PackedNavBits::insertBits( const size_t startBit,
+                                          const int numBits,
+                                          const uint64_t value )
+   {
+      if (numBits <= 0) return;
+
+      size_t ndx = startBit >> 6;
+      unsigned offset = startBit & 63;
+      uint64_t mask = ~uint64_t(0) << (64 - numBits);
+      uint64_t field = value << (64 - numBits);
+
+      words[ndx] = (words[ndx] & ~(mask >> offset)) | (field >> offset);
+      if (offset + numBits > 64)
+      {
+         words[ndx + 1] = (words[ndx + 1] & ~(mask << (64 - offset))) |
+                          (field << (64 - offset));
+      }
+   }
+
          /***    UNPACKING FUNCTIONS *********************************/
    uint64_t PackedNavBits::asUint64_t(const int startBit, 
                                       const int numBits ) const
       throw(InvalidParameter)                                    
    {
-      uint64_t temp = 0L;       // Set up a temporary variable with a known size
-                                // It needs to be AT LEAST 33 bits.
-      size_t stop = startBit + numBits;
-      if (stop>bits.size())
+      if (startBit < 0 || numBits < 0 || numBits > 64 ||
+          size_t(startBit) + numBits > bits_size)
       {
          InvalidParameter exc("Requested bits not present.");
          GPSTK_THROW(exc);
       }
-      for (size_t i=startBit; i<stop; ++i)
-      {
-         temp <<= 1;
-         if (bits[i]) temp++;
-      }
-      return( temp ); 
+      return( extractBits(startBit, numBits) ); 
    }
 
    unsigned long PackedNavBits::asUnsignedLong(const int startBit, 
@@ -229,7 +307,7 @@ namespace gpstk
       
          // Convert to double and scale
       double dval = (double) uint;
-      dval *= pow(static_cast<double>(2), power2);
+      dval = scalePow2(dval, power2);
       return( dval );
    }
 
@@ -240,7 +318,7 @@ namespace gpstk
 
          // Convert to double and scale
       double dval = (double) s;
-      dval *= pow(static_cast<double>(2), power2);
+      dval = scalePow2(dval, power2);
       return( dval );
    }
 
@@ -251,6 +329,50 @@ namespace gpstk
       return (drad*PI);
    }
 
+   void PackedNavBits::asScaledDoubles( const ScaledField fields[],
+                                        const unsigned len,
+                                        double out[] ) const
+      throw(InvalidParameter)
+   {
+      for (unsigned i = 0; i < len; ++i)
+      {
+         const ScaledField& f = fields[i];
+         if (f.startBit < 0 || f.numBits < 0 || f.numBits > 64 ||
+             size_t(f.startBit) + f.numBits > bits_size)
+         {
+            InvalidParameter exc("Requested bits not present.");
+            GPSTK_THROW(exc);
+         }
+
+         uint64_t u = extractBits(f.startBit, f.numBits);
+         double dval;
+         if (f.isSigned)
+         {
+               // Sign extend by flipping and subtracting the sign bit
+            uint64_t sign = uint64_t(1) << ((f.numBits - 1) & 63);
+            dval = (double) (int64_t) ((u ^ sign) - sign);
+         }
+         else
+         {
+            dval = (double) u;
+         }
+
+         dval = scalePow2(dval, f.power2);
+         out[i] = (f.semiCircles ? dval*PI : dval);
+      }
+   }
+
+   void PackedNavBits::asScaledDoubles( const std::vector<ScaledField>& fields,
+                                        std::vector<double>& out ) const
+      throw(InvalidParameter)
+   {
+      out.resize(fields.size());
+      if (!fields.empty())
+      {
+         asScaledDoubles(&fields[0], fields.size(), &out[0]);
+      }
+   }
+
       //----
         /*  Unpack a sign/mag long */ 
    long PackedNavBits::asSignMagLong(const int startBit, 
@@ -279,7 +401,7 @@ namespace gpstk
       
          // Convert to double and scale
       double dval = (double) smag;
-      dval *= pow(static_cast<double>(2), power2);
+      dval = scalePow2(dval, power2);
       return( dval );
    }
                              
@@ -380,7 +502,7 @@ namespace gpstk
       
          // Convert to double and scale
       double dval = (double) ulong;
-      dval *= pow(static_cast<double>(2), power2);
+      dval = scalePow2(dval, power2);
       return( dval );
    }
 
@@ -405,7 +527,7 @@ namespace gpstk
 
          // Convert to double and scale
       double dval = (double) s;
-      dval *= pow(static_cast<double>(2), power2);
+      dval = scalePow2(dval, power2);
       return( dval );
    }
 
@@ -429,7 +551,7 @@ namespace gpstk
       uint64_t out = (uint64_t) value;
       out /= scale;
 
-      uint64_t test = pow(static_cast<double>(2),numBits) - 1; 
+      uint64_t test = maxUnsigned(numBits); 
       if ( out > test )
       {
          InvalidParameter exc("Scaled value too large for specifed bit length");
@@ -449,7 +571,7 @@ namespace gpstk
       out = (int64_t) value;
       out /= scale;
 
-      int64_t test = pow(static_cast<double>(2),numBits-1) - 1; 
+      int64_t test = maxSigned(numBits); 
       if ( ( out > test ) || ( out < -( test + 1 ) ) )
       {
          InvalidParameter exc("Scaled value too large for specifed bit length");
@@ -463,7 +585,7 @@ namespace gpstk
       throw(InvalidParameter)
    {
       uint64_t out = (uint64_t) ScaleValue(value, power2);
-      uint64_t test = pow(static_cast<double>(2),numBits) - 1;
+      uint64_t test = maxUnsigned(numBits);
       if ( out > test )
       {
          InvalidParameter exc("Scaled value too large for specifed bit length");
@@ -483,7 +605,7 @@ namespace gpstk
          int64_t out;
       };
       out = (int64_t) ScaleValue(value, power2);
-      int64_t test = pow(static_cast<double>(2),numBits-1) - 1; 
+      int64_t test = maxSigned(numBits); 
       if ( ( out > test ) || ( out < -( test + 1 ) ) )
       {
          InvalidParameter exc("Scaled value too large for specifed bit length");
@@ -503,7 +625,7 @@ namespace gpstk
       };
       double temp = Radians/PI;
       out = (int64_t) ScaleValue(temp, power2);
-      int64_t test = pow(static_cast<double>(2), numBits-1) - 1; 
+      int64_t test = maxSigned(numBits); 
       if ( ( out > test ) || ( out < -( test + 1 ) ) )
       {
          InvalidParameter exc("Scaled value too large for specifed bit length");
@@ -558,30 +680,23 @@ namespace gpstk
    {
       int old_bits_used = bits_used;
       bits_used += right.bits_used;
-      bits.resize(bits_used);
+      resizeBits(bits_used);
       
-      for (int i=0;i<right.bits_used;i++)
+         // Copy a word at a time
+      for (int i=0;i<right.bits_used;i+=64)
       {
-         bits[i+old_bits_used] = right.bits[i];
+         int numBits = std::min(64, right.bits_used - i);
+         insertBits(old_bits_used + i, numBits, right.extractBits(i, numBits));
       }
    }
 
    void PackedNavBits::addUint64_t( const uint64_t value, const int numBits )
    {
-      size_t ndx = bits_used;
-      uint64_t mask = 0x0000000000000001L;
-      mask <<= (numBits-1);
-      for (int i=0; i<numBits; ++i)
+      if (bits_used + numBits > int(bits_size))
       {
-         bits[ndx] = false;
-         if (value & mask) 
-         {
-             //set the bits to true
-            bits[ndx] = true;
-         }
-         mask>>= 1;
-         ndx++;
+         resizeBits(bits_used + numBits);
       }
+      insertBits(bits_used, numBits, value);
       bits_used += numBits;
    }
 
@@ -591,9 +706,8 @@ namespace gpstk
    // bit array bit-for-bit and returning "less than" if it finds an occasion
    // in which left has a '0' whereas right has a '1'.
    //
-   // NOTE: This is one of the cases in which the PackedNavBits implementation 
-   // is probably not the fastest.  Since we are scanning a bit array rather 
-   // than testing a series of unsigned ints.
+   // The bits are tested a word at a time; bits past the end are
+   // zero in both objects.
    bool PackedNavBits::operator<(const PackedNavBits& right) const
    {
          // If the two objects don't have the same number of bits,
@@ -601,15 +715,15 @@ namespace gpstk
          // happen.  In the context of NavFilter, data SHOULD be
          // from the same system, therefore, the same length should 
          // always be true.
-      if (bits.size()!=right.bits.size())
+      if (bits_size!=right.bits_size)
       {
-         if (bits.size()<right.bits.size()) return true;
+         if (bits_size<right.bits_size) return true;
          return false;
       }
 
-      for (int i=0;i<bits.size();i++)
+      for (size_t i=0;i<words.size();i++)
       {
-         if (bits[i]<right.bits[i])
+         if (~words[i] & right.words[i])
          {
             return true;
          }
@@ -621,27 +735,24 @@ namespace gpstk
    //--------------------------------------------------------------------------
    void PackedNavBits::trimsize()
    {
-      bits.resize(bits_used);
+      resizeBits(bits_used);
    }
 
    //--------------------------------------------------------------------------
    int64_t PackedNavBits::SignExtend( const int startBit, const int numBits) const
    {
-      union
-      {
-         uint64_t u;
-         int64_t s;
-      };
-      u = asUint64_t( startBit, numBits);
-      s <<= 64 - numBits; // Move sign bit to msb.
-      s >>= 64- numBits;  // Shift result back to correct location sign bit extended.
-      return (s);
+      uint64_t u = asUint64_t( startBit, numBits);
+
+         // Flipping the sign bit and subtracting it extends the sign
+         // without a branch or a shift by the full word size.
+      uint64_t sign = uint64_t(1) << ((numBits - 1) & 63);
+      return ( (int64_t) ((u ^ sign) - sign) );
    }
 
    double PackedNavBits::ScaleValue( const double value, const int power2) const
    {
       double temp = value;
-      temp /= pow(static_cast<double>(2), power2);
+      temp = scalePow2(temp, -power2);
       if (temp >= 0) temp += 0.5; // Takes care of rounding
       else temp -= 0.5;
       return ( temp );
@@ -680,26 +791,23 @@ namespace gpstk
       s << endl;     
 
       s << endl << "Packed Bits, Left Justified, 32 Bits Long:\n";
-      int numBitInWord = 0;
       int word_count   = 0;
       uint32_t word    = 0;
-      for(size_t i = 0; i < bits.size(); ++i)
+      size_t i = 0;
+      for( ; i + 32 <= bits_size; i += 32)
       {
-         word <<= 1;
-         if (bits[i]) word++;
-       
-         numBitInWord++;
-         if (numBitInWord >= 32)
-         {
-            s << "  0x" << setw(8) << setfill('0') << hex << word;
-            numBitInWord = 0;
-            word_count++;
+         word = (uint32_t) extractBits(i, 32);
+         s << "  0x" << setw(8) << setfill('0') << hex << word;
+         word_count++;
             //Print four words per line 
-            if (word_count %5 == 0) s << endl;        
-         }
+         if (word_count %5 == 0) s << endl;        
+      }
+      int numBitInWord = bits_size - i;
+      if (numBitInWord > 0 )
+      {
+         word = (uint32_t) extractBits(i, numBitInWord) << (32 - numBitInWord);
+         s << "  0x" << setw(8) << setfill('0') << hex << word;
       }
-      word <<= 32 - numBitInWord;
-      if (numBitInWord > 0 ) s << "  0x" << setw(8) << setfill('0') << hex << word;
       s.setf(ios::fixed, ios::floatfield);
       s.precision(3);
       s.flags(oldFlags);      // Reset whatever conditions pertained on entry
@@ -718,38 +826,36 @@ namespace gpstk
       s.setf(ios::uppercase); 
       int rollover = numPerLine;
       
-      int numBitInWord = 0;
-      int bit_count    = 0; 
+         // A word holds at least one bit.  Only the last 32 bits of
+         // a longer word are printed.
+      size_t bitsPerWord = std::max<int>(numBitsPerWord, 1);
+      int numPrinted = std::min<int>(bitsPerWord, 32);
       int word_count   = 0;
       uint32_t word    = 0;
-      for(size_t i = 0; i < bits.size(); ++i)
+      size_t i = 0;
+      for( ; i + bitsPerWord <= bits_size; i += bitsPerWord)
       {
-         word <<= 1;
-         if (bits[i]) word++;
-       
-         numBitInWord++;
-         if (numBitInWord >= numBitsPerWord)
-         {
-            s << delimiter << " 0x" << setw(8) << setfill('0') << hex << word;
-            word = 0;
-            numBitInWord = 0;
-            word_count++;
+         word = (uint32_t) extractBits(i + bitsPerWord - numPrinted, numPrinted);
+         s << delimiter << " 0x" << setw(8) << setfill('0') << hex << word;
+         word_count++;
             
             //Print "numPerLine" words per line,
             //but ONLY if there are more bits left to put on the next line.
-            if (word_count>0 && 
-                word_count % rollover == 0 &&
-                (i+1) < bits.size()) s << endl;        
-         }
+         if (word_count>0 && 
+             word_count % rollover == 0 &&
+             (i + bitsPerWord) < bits_size) s << endl;        
       }
          // Need to check if there is a partial word in the buffer
-      word <<= 32 - numBitInWord;
+      int numBitInWord = bits_size - i;
       if (numBitInWord>0)
       {
+         numPrinted = std::min(numBitInWord, 32);
+         word = (uint32_t) extractBits(bits_size - numPrinted, numPrinted);
+         word <<= 32 - numPrinted;
          s << delimiter << " 0x" << setw(8) << setfill('0') << hex << word;
       }
       s.flags(oldFlags);      // Reset whatever conditions pertained on entry
-      return(bits.size()); 
+      return(bits_size); 
    }
 
    bool PackedNavBits::operator==(const PackedNavBits& right) const
@@ -800,19 +906,22 @@ namespace gpstk
    {
          // If the two objects don't have the same number of bits,
          // don't even try to compare them. 
-      if (bits.size()!=right.bits.size()) return false; 
+      if (bits_size!=right.bits_size) return false; 
+      if (bits_size==0) return true;
 
       short startBit = startBitA;
       short endBit = endBitA; 
          // Check for nonsense arguments
       if (endBit==-1 ||
-          endBit>=int(bits.size())) endBit = bits.size()-1;
+          endBit>=int(bits_size)) endBit = bits_size-1;
       if (startBit<0) startBit=0;
-      if (startBit>=int(bits.size())) startBit = bits.size()-1;
+      if (startBit>=int(bits_size)) startBit = bits_size-1;
 
-      for (int i=startBit;i<=endBit;i++)
+         // Compare up to 64 bits at a time
+      for (int i=startBit;i<=endBit;i+=64)
       {
-         if (bits[i]!=right.bits[i])
+         int numBits = std::min(64, endBit - i + 1);
+         if (extractBits(i, numBits)!=right.extractBits(i, numBits))
          {
             return false;
          }
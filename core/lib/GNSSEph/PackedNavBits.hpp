@@ -156,6 +156,34 @@ namespace gpstk
                                   const int numBits, 
                                   const int power2) const;
 
+         /* Description of one scaled field of the message, for the
+            batch unpacking method asScaledDoubles().  The value is
+            multiplied by 2^power2, and by PI when semiCircles is set. */
+      struct ScaledField
+      {
+         int startBit;       ///< first bit of the field
+         int numBits;        ///< length of the field, up to 64 bits
+         int power2;         ///< scale factor, as a power of two
+         bool isSigned;      ///< two's complement field
+         bool semiCircles;   ///< field in units of semi-circles
+      };
+
+         /* Unpack the len fields described by fields[] into out[].
+            Each field gives the same value as asUnsignedDouble(),
+            asSignedDouble() or asDoubleSemiCircles(), but the loop
+            avoids a call and a pow() per field when decoding a whole
+            message. */
+      void asScaledDoubles( const ScaledField fields[],
+                            const unsigned len,
+                            double out[] ) const
+         throw(InvalidParameter);
+
+         /* Unpack the fields described by fields into out, which is
+            resized to match. */
+      void asScaledDoubles( const std::vector<ScaledField>& fields,
+                            std::vector<double>& out ) const
+         throw(InvalidParameter);
+
          /* Unpack mehthods that join multiple disjoint 
             navigation message areas as a single field
             NOTE: startBit1 is associated with the most significant section
@@ -358,13 +386,30 @@ namespace gpstk
       ObsID obsID;             /**< Defines carrier and code tracked */
       std::string rxID;        /**< Defines the receiver that collected the data */
       CommonTime transmitTime; /**< Time nav message is transmitted */
-      std::vector<bool> bits;  /**< Holds the packed data */
+         /** Holds the packed data, 64 bits per word, first bit in
+             the MSB of words[0].  Bits beyond bits_size are always
+             zero, and one spare word past the last bit lets a field
+             be read from two adjacent words without a test. */
+      std::vector<uint64_t> words;
+      size_t bits_size;        /**< Number of bits held in words */
       int bits_used;
       
       bool xMitCoerced;        /**< Used to indicate that the transmit
                                     time is NOT directly derived from
                                     the SOW in the message */
 
+         /** Set the number of bits held, clearing any bits beyond
+             the new size */
+      void resizeBits( const size_t numBits );
+
+         /** Unpack the bits without checking the range (0 to 64 bits) */
+      uint64_t extractBits( const size_t startBit, const int numBits ) const;
+
+         /** Overwrite numBits bits (0 to 64) starting at startBit
+             with the least significant bits of value */
+      void insertBits( const size_t startBit, const int numBits,
+                       const uint64_t value );
+
          /** Unpack the bits */
       uint64_t asUint64_t(const int startBit, const int numBits ) const 
          throw(InvalidParameter);
@@ -41,6 +41,7 @@
 
 #include "PositionSatStore.hpp"
 #include "MiscMath.hpp"
+#include <iterator>
 #include <vector>
 
 using namespace std;
@@ -92,6 +93,17 @@ namespace gpstk
    //  c) checkInterval is true and the interval is larger than maxInterval
    PositionRecord PositionSatStore::getValue(const SatID& sat, const CommonTime& ttag)
       const throw(InvalidRequest)
+   {
+      LagrangeWeights lw;
+      try { return getValue(sat, ttag, lw); }
+      catch(InvalidRequest& e) { GPSTK_RETHROW(e); }
+   }
+
+   // Return value for the given satellite at the given time, reusing the
+   // interpolation weights in lw where the nodes and time offset repeat.
+   PositionRecord PositionSatStore::getValue(const SatID& sat, const CommonTime& ttag,
+                                             LagrangeWeights& lw)
+      const throw(InvalidRequest)
    {
       try {
          bool isExact;
@@ -105,76 +117,92 @@ namespace gpstk
             return rec;
          }
 
-         // pull data out of the data table
+         // pull data out of the data table, 4 values per time for
+         // LagrangeWeights::value4(); on the stack, unless the interpolation
+         // order exceeds LagrangeWeights::MaxPoints
+         const size_t maxN(LagrangeWeights::MaxPoints);
+         const size_t N(std::distance(it1,it2)+1);
+         DataTableIterator itsFixed[maxN];
+         double dataFixed[13*maxN];
+         std::vector<DataTableIterator> itsHeap;
+         std::vector<double> dataHeap;
+         DataTableIterator *its(itsFixed);
+         double *times(dataFixed);
+         if(N > maxN) {
+            itsHeap.resize(N);
+            dataHeap.resize(13*N);
+            its = &itsHeap[0];
+            times = &dataHeap[0];
+         }
+         double *P(times+N), *V(P+4*N), *A(V+4*N);
          size_t n,Nlow(Nhalf-1),Nhi(Nhalf),Nmatch(Nhalf);
          CommonTime ttag0(it1->first);
-         vector<double> times,P[3],V[3],A[3],sigP[3],sigV[3],sigA[3];
 
-         kt = it1; n=0;
-         while(1) {
+         kt = it1;
+         for(n=0; n<N; n++,++kt) {
             // find index matching ttag
             if(isExact && ABS(kt->first - ttag) < 1.e-8)
                Nmatch = n;
-            times.push_back(kt->first - ttag0);          // sec
+            its[n] = kt;
+            times[n] = kt->first - ttag0;             // sec
             for(i=0; i<3; i++) {
-               P[i].push_back(kt->second.Pos[i]);
-               V[i].push_back(kt->second.Vel[i]);
-               A[i].push_back(kt->second.Acc[i]);
-               sigP[i].push_back(kt->second.sigPos[i]);
-               sigV[i].push_back(kt->second.sigVel[i]);
-               sigA[i].push_back(kt->second.sigAcc[i]);
+               P[4*n+i] = kt->second.Pos[i];
+               V[4*n+i] = kt->second.Vel[i];
+               A[4*n+i] = kt->second.Acc[i];
             }
-            if(kt == it2) break;
-            ++kt;
-            ++n;
-         };
+            P[4*n+3] = V[4*n+3] = A[4*n+3] = 0.0;
+         }
 
-         if(isExact && Nmatch == (int)(Nhalf-1)) { Nlow++; Nhi++; }
+         if(isExact && Nmatch == Nhalf-1) { Nlow++; Nhi++; }
 
-         // Lagrange interpolation
+         // Lagrange interpolation, one set of weights for all components
+         double dt(ttag-ttag0);                // dt in seconds
+         double p[4],v[4],a[4];
+         lw.compute(times,n,dt);
+         lw.value4(P,p);
          rec.sigAcc = rec.Acc = Triple(0,0,0);        // default
-         double dt(ttag-ttag0), err;           // dt in seconds
          if(haveVelocity) {
+            lw.value4(V,v);
+            if(haveAcceleration)
+               lw.value4(A,a);                 // interpolate accelerations
+            else
+               lw.derivative4(V,a);            // velocities(dm/s) to get A
             for(i=0; i<3; i++) {
-               // interpolate the positions
-               rec.Pos[i] = LagrangeInterpolation(times,P[i],dt,err);
-               if(haveAcceleration) {
-                  // interpolate velocities and acclerations
-                  rec.Vel[i] = LagrangeInterpolation(times,V[i],dt,err);
-                  rec.Acc[i] = LagrangeInterpolation(times,A[i],dt,err);
-               }
-               else {
-                  // interpolate velocities(dm/s) to get V and A
-                  LagrangeInterpolation(times,V[i],dt,rec.Vel[i],rec.Acc[i]);
-                  rec.Acc[i] *= 0.1;      // dm/s/s -> m/s/s
-               }
+               rec.Pos[i] = p[i];
+               rec.Vel[i] = v[i];
+               rec.Acc[i] = (haveAcceleration ? a[i] : a[i]*0.1); // dm/s/s -> m/s/s
 
                if(isExact) {
-                  rec.sigPos[i] = sigP[i][Nmatch];
-                  rec.sigVel[i] = sigV[i][Nmatch];
-                  if(haveAcceleration) rec.sigAcc[i] = sigA[i][Nmatch];
+                  rec.sigPos[i] = its[Nmatch]->second.sigPos[i];
+                  rec.sigVel[i] = its[Nmatch]->second.sigVel[i];
+                  if(haveAcceleration)
+                     rec.sigAcc[i] = its[Nmatch]->second.sigAcc[i];
                }
                else {
-                  // TD is this sigma related to 'err' in the Lagrange call?
-                  rec.sigPos[i] = RSS(sigP[i][Nhi],sigP[i][Nlow]);
-                  rec.sigVel[i] = RSS(sigV[i][Nhi],sigV[i][Nlow]);
+                  // TD is this sigma related to the Lagrange interpolation error?
+                  rec.sigPos[i] = RSS(its[Nhi]->second.sigPos[i],
+                                      its[Nlow]->second.sigPos[i]);
+                  rec.sigVel[i] = RSS(its[Nhi]->second.sigVel[i],
+                                      its[Nlow]->second.sigVel[i]);
                   if(haveAcceleration)
-                     rec.sigAcc[i] = RSS(sigA[i][Nhi],sigA[i][Nlow]);
+                     rec.sigAcc[i] = RSS(its[Nhi]->second.sigAcc[i],
+                                         its[Nlow]->second.sigAcc[i]);
                }
                // else Acc=sig_Acc=0   // TD can we do better?
             }
          }
          else {               // no V data - must interpolate position to get velocity
+            lw.derivative4(P,v);
             for(i=0; i<3; i++) {
-               // interpolate positions(km) to get P and V
-               LagrangeInterpolation(times,P[i],dt,rec.Pos[i],rec.Vel[i]);
-               rec.Vel[i] *= 10000.;         // km/sec -> dm/sec
+               rec.Pos[i] = p[i];
+               rec.Vel[i] = v[i] * 10000.;         // km/sec -> dm/sec
 
                if(isExact) {
-                  rec.sigPos[i] = sigP[i][Nmatch];
+                  rec.sigPos[i] = its[Nmatch]->second.sigPos[i];
                }
                else {
-                  rec.sigPos[i] = RSS(sigP[i][Nhi],sigP[i][Nlow]);
+                  rec.sigPos[i] = RSS(its[Nhi]->second.sigPos[i],
+                                      its[Nlow]->second.sigPos[i]);
                }
                // TD
                rec.sigVel[i] = 0.0;
@@ -185,6 +213,28 @@ namespace gpstk
       catch(InvalidRequest& e) { GPSTK_RETHROW(e); }
    }
 
+   // Return values for the given satellite at each of several times,
+   // sharing one set of interpolation weights.
+   unsigned PositionSatStore::getValues(const SatID& sat,
+                                        const vector<CommonTime>& ttags,
+                                        vector<PositionRecord>& recs,
+                                        vector<bool>& valid) const
+   {
+      unsigned n(0);
+      LagrangeWeights lw;
+      recs.resize(ttags.size());
+      valid.assign(ttags.size(), false);
+      for(size_t i=0; i<ttags.size(); i++) {
+         try {
+            recs[i] = getValue(sat, ttags[i], lw);
+            valid[i] = true;
+            n++;
+         }
+         catch(InvalidRequest&) { }
+      }
+      return n;
+   }
+
    // Return the position for the given satellite at the given time
    // @param[in] sat the SatID of the satellite of interest
    // @param[in] ttag the time (CommonTime) of interest
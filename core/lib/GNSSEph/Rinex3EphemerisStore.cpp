@@ -297,6 +297,75 @@ namespace gpstk
       catch(InvalidRequest& ir) { GPSTK_RETHROW(ir); }
    }
 
+   // Compute the Xvt of several satellites, each at its own time. The requests
+   // are split by store, time tags converted as in getXvt(), and each store's
+   // getXvts() called once.
+   unsigned Rinex3EphemerisStore::getXvts(const vector<SatID>& ids,
+                                          const vector<CommonTime>& times,
+                                          vector<Xvt>& xvts,
+                                          vector<bool>& valid) const
+   {
+      if(ids.size() != times.size()) {
+         InvalidRequest e("getXvts: ids and times differ in size");
+         GPSTK_THROW(e);
+      }
+
+      // requests for each store, and their index in ids
+      vector<SatID> orbSats, gloSats;
+      vector<CommonTime> orbTimes, gloTimes;
+      vector<size_t> orbIndex, gloIndex;
+
+      xvts.resize(ids.size());
+      valid.assign(ids.size(), false);
+      for(size_t i=0; i<ids.size(); i++) {
+         const SatID& sat(ids[i]);
+         switch(sat.system) {
+            case SatID::systemGPS:
+            case SatID::systemGalileo:
+            case SatID::systemBeiDou:
+            case SatID::systemQZSS:
+               {
+                  TimeSystem ts;
+                  if(sat.system == SatID::systemGPS    ) ts = TimeSystem::GPS;
+                  if(sat.system == SatID::systemGalileo) ts = TimeSystem::GAL;
+                  if(sat.system == SatID::systemBeiDou ) ts = TimeSystem::BDT;
+                  if(sat.system == SatID::systemQZSS   ) ts = TimeSystem::QZS;
+                  orbSats.push_back(sat);
+                  orbTimes.push_back(correctTimeSystem(times[i], ts));
+                  orbIndex.push_back(i);
+               }
+               break;
+            case SatID::systemGlonass:
+               gloSats.push_back(sat);
+               gloTimes.push_back(correctTimeSystem(times[i], TimeSystem::GLO));
+               gloIndex.push_back(i);
+               break;
+            default:                         // unsupported satellite system
+               break;
+         }
+      }
+
+      vector<Xvt> subXvts;
+      vector<bool> subValid;
+      unsigned n(0);
+      if(orbSats.size() > 0) {
+         n += ORBstore.getXvts(orbSats, orbTimes, subXvts, subValid);
+         for(size_t j=0; j<orbIndex.size(); j++) {
+            xvts[orbIndex[j]] = subXvts[j];
+            valid[orbIndex[j]] = subValid[j];
+         }
+      }
+      if(gloSats.size() > 0) {
+         n += GLOstore.getXvts(gloSats, gloTimes, subXvts, subValid);
+         for(size_t j=0; j<gloIndex.size(); j++) {
+            xvts[gloIndex[j]] = subXvts[j];
+            valid[gloIndex[j]] = subValid[j];
+         }
+      }
+
+      return n;
+   }
+
    // Dump information about the store to an ostream.
    // @param[in] os ostream to receive the output; defaults to cout
    // @param[in] detail integer level of detail to provide; allowed values are
@@ -129,6 +129,20 @@ namespace gpstk
           *    information as to why the request failed. */
       virtual Xvt getXvt(const SatID& sat, const CommonTime& ttag) const;
 
+         /** Compute the Xvt of several satellites, each at its own
+          * time; see XvtStore::getXvts(). The requests are passed
+          * to the getXvts() of the Orbit-based and GLONASS stores.
+          * @param[in] ids the satellites of interest
+          * @param[in] times the time to look up for each of ids
+          * @param[out] xvts the Xvt of each satellite
+          * @param[out] valid false where getXvt() would throw
+          * @return the number of Xvt computed
+          * @throw InvalidRequest if ids and times differ in size */
+      virtual unsigned getXvts(const std::vector<SatID>& ids,
+                               const std::vector<CommonTime>& times,
+                               std::vector<Xvt>& xvts,
+                               std::vector<bool>& valid) const;
+
          /** Dump information about the store to an ostream.
           * @param[in] os ostream to receive the output; defaults to std::cout
           * @param[in] detail integer level of detail to provide;
@@ -444,6 +458,40 @@ namespace gpstk
          ORBstore.SearchUser();
       }
 
+         /** Build the fast lookup index of the Orbit-based store; see
+          * OrbitEphStore::freezeIndex(). */
+      void freezeIndex(void)
+      {
+         ORBstore.freezeIndex();
+      }
+
+         /// Discard the lookup index of the Orbit-based store
+      void thawIndex(void)
+      {
+         ORBstore.thawIndex();
+      }
+
+         /** Evaluate getXvts() of the Orbit-based store with
+          * orbitEphXvt(); see OrbitEphStore::setFastXvtsFlag(). */
+      void setFastXvtsFlag(bool flag)
+      {
+         ORBstore.setFastXvtsFlag(flag);
+      }
+
+         /// Prepare all the stores to be read by several threads at once
+      virtual bool beginConcurrentReads(void)
+      {
+         return (ORBstore.beginConcurrentReads() &&
+                 GLOstore.beginConcurrentReads());
+      }
+
+         /// End the concurrent reads of all the stores
+      virtual void endConcurrentReads(void)
+      {
+         ORBstore.endConcurrentReads();
+         GLOstore.endConcurrentReads();
+      }
+
    }; // end class Rinex3EphemerisStore
 
       //@}
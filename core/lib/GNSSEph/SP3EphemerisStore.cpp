@@ -88,27 +88,68 @@ namespace gpstk
       try { crec = clkStore.getValue(sat,ttag); }
       catch(InvalidRequest& e) { GPSTK_RETHROW(e); }
 
-      try {
-         Xvt retXvt;
-         for(int i=0; i<3; i++) {
-            retXvt.x[i] = prec.Pos[i] * 1000.0;    // km -> m
-            retXvt.v[i] = prec.Vel[i] * 0.1;       // dm/s -> m/s
-         }
-         if(useSP3clock) {                            // SP3
-            retXvt.clkbias = crec.bias * 1.e-6;       // microsec -> sec
-            retXvt.clkdrift = crec.drift * 1.e-6;     // microsec/sec -> sec/sec
-         }
-         else {                                       // RINEX clock
-            retXvt.clkbias = crec.bias;               // sec
-            retXvt.clkdrift = crec.drift;             // sec/sec
-         }
+      return makeXvt(prec, crec);
+   }
 
-            // compute relativity correction, in seconds
-         retXvt.computeRelativityCorrection();
+      // Compute the Xvt of several satellites, each at its own time.
+      // Satellites missing from either store are flagged without a throw,
+      // and the clock is not interpolated where the position fails.
+      // The interpolation weights are shared, so they are computed once
+      // for all satellites at the same epoch of the tables.
+   unsigned SP3EphemerisStore::getXvts(const vector<SatID>& ids,
+                                       const vector<CommonTime>& times,
+                                       vector<Xvt>& xvts,
+                                       vector<bool>& valid) const
+   {
+      if(ids.size() != times.size()) {
+         InvalidRequest e("getXvts: ids and times differ in size");
+         GPSTK_THROW(e);
+      }
 
-         return retXvt;
+      unsigned n(0);
+      bool present(false);
+      LagrangeWeights posWeights, clkWeights;
+      xvts.resize(ids.size());
+      valid.assign(ids.size(), false);
+      for(size_t i=0; i<ids.size(); i++) {
+         if(i == 0 || !(ids[i] == ids[i-1]))
+            present = isPresent(ids[i]);
+         if(!present) continue;
+
+         try {
+            PositionRecord prec(posStore.getValue(ids[i],times[i],posWeights));
+            ClockRecord crec(clkStore.getValue(ids[i],times[i],clkWeights));
+            xvts[i] = makeXvt(prec, crec);
+            valid[i] = true;
+            n++;
+         }
+         catch(InvalidRequest&) { }
       }
-      catch(InvalidRequest& e) { GPSTK_RETHROW(e); }
+      return n;
+   }
+
+      // Convert interpolated position and clock records to an Xvt.
+   Xvt SP3EphemerisStore::makeXvt(const PositionRecord& prec,
+                                  const ClockRecord& crec) const
+   {
+      Xvt retXvt;
+      for(int i=0; i<3; i++) {
+         retXvt.x[i] = prec.Pos[i] * 1000.0;    // km -> m
+         retXvt.v[i] = prec.Vel[i] * 0.1;       // dm/s -> m/s
+      }
+      if(useSP3clock) {                            // SP3
+         retXvt.clkbias = crec.bias * 1.e-6;       // microsec -> sec
+         retXvt.clkdrift = crec.drift * 1.e-6;     // microsec/sec -> sec/sec
+      }
+      else {                                       // RINEX clock
+         retXvt.clkbias = crec.bias;               // sec
+         retXvt.clkdrift = crec.drift;             // sec/sec
+      }
+
+         // compute relativity correction, in seconds
+      retXvt.computeRelativityCorrection();
+
+      return retXvt;
    }
 
       // Determine the earliest time for which this object can successfully 
@@ -132,6 +132,11 @@ namespace gpstk
       void loadSP3Store(const std::string& filename, bool fillClockStore)
          throw(Exception);
 
+         /** Private utility routine used by getXvt and getXvts.
+          * Convert position and clock records, as returned by the
+          * stores, to an Xvt in meters and seconds. */
+      Xvt makeXvt(const PositionRecord& prec, const ClockRecord& crec) const;
+
    public:
 
          /// Default constructor
@@ -160,6 +165,20 @@ namespace gpstk
       virtual Xvt getXvt(const SatID& sat, const CommonTime& ttag)
          const throw(InvalidRequest);
 
+         /** Compute the Xvt of several satellites, each at its own
+          * time; see XvtStore::getXvts(). Requests for satellites not
+          * in the store are flagged without constructing an exception.
+          * @param[in] ids the satellites of interest
+          * @param[in] times the time to look up for each of ids
+          * @param[out] xvts the Xvt of each satellite
+          * @param[out] valid false where getXvt() would throw
+          * @return the number of Xvt computed
+          * @throw InvalidRequest if ids and times differ in size */
+      virtual unsigned getXvts(const std::vector<SatID>& ids,
+                               const std::vector<CommonTime>& times,
+                               std::vector<Xvt>& xvts,
+                               std::vector<bool>& valid) const;
+
          /** Dump information about the store to an ostream.
           * @param[in] os ostream to receive the output; defaults to std::cout
           * @param[in] detail integer level of detail to provide;
@@ -226,6 +245,11 @@ namespace gpstk
       virtual bool isPresent(const SatID& sat) const throw()
       { return (posStore.isPresent(sat) && clkStore.isPresent(sat)); }
 
+         /// The tables are only read by the const methods, so the store
+         /// may be read by several threads at once.
+      virtual bool beginConcurrentReads(void)
+      { return true; }
+
          /// Return true if velocity is present in the data tables
       virtual bool hasVelocity() const throw()
       {  return posStore.hasVelocity(); }
@@ -44,6 +44,7 @@
 #define GPSTK_XVTSTORE_INCLUDE
 
 #include <iostream>
+#include <vector>
 
 #include "Exception.hpp"
 #include "CommonTime.hpp"
@@ -74,6 +75,50 @@ namespace gpstk
          ///    information as to why the request failed.
       virtual Xvt getXvt(const IndexType& id, const CommonTime& t) const = 0;
 
+         /// Returns the position, velocity, and clock offset of each of
+         /// several objects, each at its own time. This gives the same
+         /// results as calling getXvt() for each one, but a request that
+         /// cannot be completed is flagged rather than thrown, and
+         /// derived classes may override it to share work between the
+         /// requests. Requests for the same object should be adjacent,
+         /// and in time order, where possible.
+         /// @param[in] ids the objects' identifiers
+         /// @param[in] times the time to look up for each of ids
+         /// @param[out] xvts the Xvt of each object, resized to ids.size()
+         /// @param[out] valid resized to ids.size(); valid[i] is false
+         ///    where getXvt(ids[i],times[i]) would throw InvalidRequest,
+         ///    and xvts[i] is then undefined
+         /// @return the number of Xvt computed, i.e. of true in valid
+         /// @throw InvalidRequest if ids and times differ in size
+      virtual unsigned getXvts(const std::vector<IndexType>& ids,
+                               const std::vector<CommonTime>& times,
+                               std::vector<Xvt>& xvts,
+                               std::vector<bool>& valid) const
+      {
+         if(ids.size() != times.size())
+         {
+            InvalidRequest e("getXvts: ids and times differ in size");
+            GPSTK_THROW(e);
+         }
+
+         unsigned n(0);
+         xvts.resize(ids.size());
+         valid.assign(ids.size(), false);
+         for(size_t i=0; i<ids.size(); i++)
+         {
+            try
+            {
+               xvts[i] = getXvt(ids[i], times[i]);
+               valid[i] = true;
+               n++;
+            }
+            catch(InvalidRequest&)
+            {
+            }
+         }
+         return n;
+      }
+
          /// A debugging function that outputs in human readable form,
          /// all data stored in this object.
          /// @param[in] s the stream to receive the output; defaults to cout
@@ -110,6 +155,19 @@ namespace gpstk
          /// Return true if the given IndexType is present in the store
       virtual bool isPresent(const IndexType& id) const = 0;
 
+         /// Prepare the store to be read by several threads at once,
+         /// until endConcurrentReads(). Meanwhile only const methods
+         /// may be called, and nothing may modify the store.
+         /// @return false if the const methods of this store change
+         ///    its state, so that it must be read by one thread at a
+         ///    time; this is the default.
+      virtual bool beginConcurrentReads(void)
+      { return false; }
+
+         /// End the concurrent reads started by beginConcurrentReads().
+      virtual void endConcurrentReads(void)
+      {}
+
    }; // end class XvtStore
 
       //@}
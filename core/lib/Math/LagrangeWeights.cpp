@@ -0,0 +1,163 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+/// @file LagrangeWeights.cpp
+/// Lagrange interpolation weights for a set of nodes, computed once
+/// and applied to any number of data series sampled at those nodes.
+
+#include "LagrangeWeights.hpp"
+#include "StringUtils.hpp"
+
+#include <algorithm>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define GPSTK_LAGRANGEWEIGHTS_AVX
+#elif defined(__SSE2__) || defined(_M_X64) || \
+      (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define GPSTK_LAGRANGEWEIGHTS_SSE2
+#endif
+
+using namespace std;
+
+namespace gpstk
+{
+   const size_t LagrangeWeights::MaxPoints;
+
+   void LagrangeWeights::compute(const double *Xin, size_t n, double x)
+      throw(InvalidRequest)
+   {
+      if(n < 2) {
+         InvalidRequest e("LagrangeWeights: number of nodes "
+                          + StringUtils::asString(n) + " less than 2");
+         GPSTK_THROW(e);
+      }
+
+         // above MaxPoints nodes, X, L and Lp are in heap
+      double *XX(X), *LL(L), *LLp(Lp);
+      if(n > MaxPoints) {
+         if(heap.size() != 3*n) heap.resize(3*n);
+         XX = &heap[0];
+         LL = XX + n;
+         LLp = LL + n;
+      }
+
+         // reuse the weights of the last call
+      if(n == N && x == xq && std::equal(Xin, Xin+n, XX))
+         return;
+
+      std::copy(Xin, Xin+n, XX);
+
+         // Li = Pi/Di and Lpi = dPi/dx / Di, where Pi = PROD(j!=i)[x-Xj]
+         // and Di = PROD(j!=i)[Xi-Xj]. At x == Xk this gives Lk = 1
+         // and Li = 0 exactly, since Pk and Dk are the same product.
+      for(size_t i=0; i<n; i++) {
+         double p(1.0), dp(0.0), d(1.0);
+         for(size_t j=0; j<n; j++) {
+            if(j == i) continue;
+            double f(x - XX[j]);
+            dp = dp*f + p;
+            p *= f;
+            d *= XX[i] - XX[j];
+         }
+         LL[i] = p/d;
+         LLp[i] = dp/d;
+      }
+
+      N = n;
+      xq = x;
+      computeCount++;
+   }
+
+   double LagrangeWeights::value(const double *Y) const throw()
+   {
+      const double *W(weights());
+      double y(0.0);
+      for(size_t i=0; i<N; i++)
+         y += W[i]*Y[i];
+      return y;
+   }
+
+   double LagrangeWeights::derivative(const double *Y) const throw()
+   {
+      const double *W(derivWeights());
+      double y(0.0);
+      for(size_t i=0; i<N; i++)
+         y += W[i]*Y[i];
+      return y;
+   }
+
+   void LagrangeWeights::value4(const double *Y, double *out) const throw()
+   {
+      apply4(weights(), Y, out);
+   }
+
+   void LagrangeWeights::derivative4(const double *Y, double *out)
+      const throw()
+   {
+      apply4(derivWeights(), Y, out);
+   }
+
+      // Each lane sums in node order, so all paths give the same result.
+   void LagrangeWeights::apply4(const double *W, const double *Y,
+                                double *out) const throw()
+   {
+#if defined(GPSTK_LAGRANGEWEIGHTS_AVX)
+      __m256d acc(_mm256_setzero_pd());
+      for(size_t i=0; i<N; i++)
+         acc = _mm256_add_pd(acc, _mm256_mul_pd(_mm256_set1_pd(W[i]),
+                                                _mm256_loadu_pd(Y+4*i)));
+      _mm256_storeu_pd(out, acc);
+#elif defined(GPSTK_LAGRANGEWEIGHTS_SSE2)
+      __m128d acc01(_mm_setzero_pd()), acc23(_mm_setzero_pd());
+      for(size_t i=0; i<N; i++) {
+         __m128d w(_mm_set1_pd(W[i]));
+         acc01 = _mm_add_pd(acc01, _mm_mul_pd(w, _mm_loadu_pd(Y+4*i)));
+         acc23 = _mm_add_pd(acc23, _mm_mul_pd(w, _mm_loadu_pd(Y+4*i+2)));
+      }
+      _mm_storeu_pd(out, acc01);
+      _mm_storeu_pd(out+2, acc23);
+#else
+      out[0] = out[1] = out[2] = out[3] = 0.0;
+      for(size_t i=0; i<N; i++) {
+         for(int c=0; c<4; c++)
+            out[c] += W[i]*Y[4*i+c];
+      }
+#endif
+   }
+
+}  // namespace gpstk
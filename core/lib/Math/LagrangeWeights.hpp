@@ -0,0 +1,141 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+/// @file LagrangeWeights.hpp
+/// Lagrange interpolation weights for a set of nodes, computed once
+/// and applied to any number of data series sampled at those nodes.
+
+#ifndef GPSTK_LAGRANGEWEIGHTS_HPP
+#define GPSTK_LAGRANGEWEIGHTS_HPP
+
+#include <cstddef>
+#include <vector>
+#include "Exception.hpp"
+
+namespace gpstk
+{
+      /// @ingroup MathGroup
+      //@{
+
+      /** Weights L[i](x) and derivative weights dL[i]/dx(x) of the
+       * Lagrange polynomial through the nodes X[i], i=0,N-1, so that
+       * the interpolated value of series Y at x is SUM[L[i]*Y[i]] and
+       * its derivative SUM[Lp[i]*Y[i]]. This gives the same results
+       * as LagrangeInterpolation() in MiscMath.hpp, to rounding, but
+       * the weights are shared by every series sampled at the same
+       * nodes (e.g. X, Y, Z and clock), and compute() does nothing
+       * when called again with the same nodes and x, as happens when
+       * several satellites are interpolated at one epoch of an SP3
+       * table. Storage is fixed for up to MaxPoints nodes, so no
+       * memory is allocated; more nodes are kept on the heap. */
+   class LagrangeWeights
+   {
+   public:
+         /// Largest number of nodes kept without allocating
+      static const std::size_t MaxPoints = 32;
+
+      LagrangeWeights() throw()
+            : N(0), xq(0.0), computeCount(0)
+      {}
+
+         /** Compute the weights and derivative weights at x for nodes
+          * X[i], i=0,n-1, unless they were computed by the last call
+          * for the same nodes and x.
+          * @param[in] X the nodes, which must be distinct
+          * @param[in] n the number of nodes, at least 2
+          * @param[in] x the interpolation point
+          * @throw InvalidRequest if n is less than 2 */
+      void compute(const double *X, std::size_t n, double x)
+         throw(InvalidRequest);
+
+         /// Number of nodes of the last compute()
+      std::size_t size() const throw()
+      { return N; }
+
+         /// Number of times compute() did compute the weights
+      unsigned long getComputeCount() const throw()
+      { return computeCount; }
+
+         /// Weight of node i
+      double weight(std::size_t i) const throw()
+      { return weights()[i]; }
+
+         /// Derivative weight of node i
+      double derivWeight(std::size_t i) const throw()
+      { return derivWeights()[i]; }
+
+         /// Interpolated value of the series Y[i], i=0,size()-1
+      double value(const double *Y) const throw();
+
+         /// Interpolated derivative of the series Y[i], i=0,size()-1
+      double derivative(const double *Y) const throw();
+
+         /** Interpolate four interleaved series at once: out[c] is the
+          * value of the series Y[4*i+c], i=0,size()-1, c=0,3. */
+      void value4(const double *Y, double *out) const throw();
+
+         /// As value4(), for the derivatives of the four series
+      void derivative4(const double *Y, double *out) const throw();
+
+   private:
+         /// Form SUM[W[i]*Y[4*i+c]] for c=0,3
+      void apply4(const double *W, const double *Y, double *out)
+         const throw();
+
+         /// The weights, in L or, above MaxPoints nodes, in heap
+      const double *weights() const throw()
+      { return N > MaxPoints ? &heap[N] : L; }
+
+         /// The derivative weights, in Lp or in heap
+      const double *derivWeights() const throw()
+      { return N > MaxPoints ? &heap[2*N] : Lp; }
+
+      double X[MaxPoints];    ///< nodes of the last compute()
+      double L[MaxPoints];    ///< weights
+      double Lp[MaxPoints];   ///< derivative weights
+         /// nodes, weights and derivative weights, one after the other,
+         /// when there are more than MaxPoints nodes
+      std::vector<double> heap;
+      std::size_t N;          ///< number of nodes
+      double xq;              ///< interpolation point of the last compute()
+      unsigned long computeCount;
+   };
+
+      //@}
+
+}  // namespace gpstk
+
+#endif // GPSTK_LAGRANGEWEIGHTS_HPP
@@ -0,0 +1,433 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+/**
+ * @file FixedMatrix.hpp
+ * Matrices and vectors whose dimensions are template parameters.
+ */
+
+#ifndef GPSTK_FIXED_MATRIX_HPP
+#define GPSTK_FIXED_MATRIX_HPP
+
+#include <cmath>
+#include "Matrix.hpp"
+#include "Triple.hpp"
+
+namespace gpstk
+{
+      /// @ingroup MathGroup
+      //@{
+
+      /// Fails to compile for false, to restrict members to some sizes.
+   template <bool> struct FixedSizeCheck;
+   template <> struct FixedSizeCheck<true> { static void ok() {} };
+
+      /**
+       * A vector of N elements held in the object itself, for the
+       * 3- and 6-vectors of geometry, where a Vector<T> would cost
+       * an allocation for every temporary. The loops below all have
+       * constant trip counts, which the compiler unrolls.
+       * FixedVector<double,3> converts to and from Triple, and any
+       * FixedVector to and from a Vector<T> of the same size.
+       */
+   template <class T, size_t N>
+   class FixedVector
+   {
+   public:
+         /// Default constructor; the elements are not initialized.
+      FixedVector()
+      {}
+         /// Constructor setting every element to value.
+      explicit FixedVector(const T value)
+      { for (size_t i = 0; i < N; i++) v[i] = value; }
+         /// Constructor copying N elements from array.
+      explicit FixedVector(const T* array)
+      { for (size_t i = 0; i < N; i++) v[i] = array[i]; }
+         /// Constructor from a Triple, for FixedVector<double,3> only.
+      explicit FixedVector(const Triple& t)
+      {
+         FixedSizeCheck<N == 3>::ok();
+         v[0] = t[0]; v[1] = t[1]; v[2] = t[2];
+      }
+         /** Constructor from any other vector type.
+          * @throw VectorException if x.size() != N */
+      template <class BaseClass>
+      explicit FixedVector(const ConstVectorBase<T, BaseClass>& x)
+         throw(VectorException)
+      {
+         if (x.size() != N)
+         {
+            VectorException e("Incompatible dimensions for FixedVector");
+            GPSTK_THROW(e);
+         }
+         for (size_t i = 0; i < N; i++)
+            v[i] = x[i];
+      }
+
+         /// The number of elements
+      static size_t size()
+      { return N; }
+
+         /// Element i
+      T& operator[] (size_t i)
+      { return v[i]; }
+         /// Element i
+      T operator[] (size_t i) const
+      { return v[i]; }
+         /// Element i
+      T& operator() (size_t i)
+      { return v[i]; }
+         /// Element i
+      T operator() (size_t i) const
+      { return v[i]; }
+
+         /// STL begin
+      T* begin() { return v; }
+         /// STL const begin
+      const T* begin() const { return v; }
+         /// STL end
+      T* end() { return v + N; }
+         /// STL const end
+      const T* end() const { return v + N; }
+
+         /// Return the data as a Vector<T>.
+      Vector<T> toVector() const
+      {
+         Vector<T> x(N);
+         for (size_t i = 0; i < N; i++)
+            x[i] = v[i];
+         return x;
+      }
+         /// Return the data as a Triple, for FixedVector<double,3> only.
+      Triple toTriple() const
+      {
+         FixedSizeCheck<N == 3>::ok();
+         return Triple(v[0], v[1], v[2]);
+      }
+
+      FixedVector& operator+=(const FixedVector& x)
+      { for (size_t i = 0; i < N; i++) v[i] += x.v[i]; return *this; }
+      FixedVector& operator-=(const FixedVector& x)
+      { for (size_t i = 0; i < N; i++) v[i] -= x.v[i]; return *this; }
+      FixedVector& operator*=(const T x)
+      { for (size_t i = 0; i < N; i++) v[i] *= x; return *this; }
+      FixedVector& operator/=(const T x)
+      { for (size_t i = 0; i < N; i++) v[i] /= x; return *this; }
+
+         /// The dot product with x
+      T dot(const FixedVector& x) const
+      {
+         T sum(v[0] * x.v[0]);
+         for (size_t i = 1; i < N; i++)
+            sum += v[i] * x.v[i];
+         return sum;
+      }
+         /// The magnitude (2-norm)
+      T mag() const
+      { return std::sqrt(dot(*this)); }
+         /** The unit vector in the direction of this one.
+          * @throw GeometryException for a zero vector, as
+          *   Triple::unitVector() does */
+      FixedVector unitVector() const
+         throw(GeometryException)
+      {
+         const T m(mag());
+         if (m <= 1e-14)
+            GPSTK_THROW(GeometryException("Divide by Zero Error"));
+         FixedVector u(*this);
+         return u /= m;
+      }
+
+   private:
+      T v[N];
+   };
+
+
+      /**
+       * An R by C matrix held in the object itself, stored by rows,
+       * for the rotations and small transforms of geometry. It
+       * converts to and from Matrix<T>; the constructor from a T*
+       * reads the array in row major order, as Matrix<T>::operator=
+       * does.
+       */
+   template <class T, size_t R, size_t C>
+   class FixedMatrix
+   {
+   public:
+         /// Default constructor; the elements are not initialized.
+      FixedMatrix()
+      {}
+         /// Constructor setting every element to value.
+      explicit FixedMatrix(const T value)
+      {
+         for (size_t i = 0; i < R; i++)
+            for (size_t j = 0; j < C; j++)
+               a[i][j] = value;
+      }
+         /// Constructor copying R*C elements from array, in row major order.
+      explicit FixedMatrix(const T* array)
+      {
+         for (size_t i = 0; i < R; i++)
+            for (size_t j = 0; j < C; j++)
+               a[i][j] = array[i*C + j];
+      }
+         /** Constructor from any other matrix type.
+          * @throw MatrixException if the dimensions are not R by C */
+      template <class BaseClass>
+      explicit FixedMatrix(const ConstMatrixBase<T, BaseClass>& m)
+         throw(MatrixException)
+      {
+         if (m.rows() != R || m.cols() != C)
+         {
+            MatrixException e("Incompatible dimensions for FixedMatrix");
+            GPSTK_THROW(e);
+         }
+         for (size_t i = 0; i < R; i++)
+            for (size_t j = 0; j < C; j++)
+               a[i][j] = m(i,j);
+      }
+
+         /// The identity matrix, for square matrices only.
+      static FixedMatrix identity()
+      {
+         FixedSizeCheck<R == C>::ok();
+         FixedMatrix m(T(0));
+         for (size_t i = 0; i < R; i++)
+            m.a[i][i] = T(1);
+         return m;
+      }
+
+         /// The number of rows
+      static size_t rows()
+      { return R; }
+         /// The number of columns
+      static size_t cols()
+      { return C; }
+         /// The number of elements
+      static size_t size()
+      { return R * C; }
+
+         /// Element (i,j)
+      T& operator() (size_t i, size_t j)
+      { return a[i][j]; }
+         /// Element (i,j)
+      T operator() (size_t i, size_t j) const
+      { return a[i][j]; }
+
+         /// Return the data as a Matrix<T>.
+      Matrix<T> toMatrix() const
+      {
+         Matrix<T> m(R, C);
+         for (size_t i = 0; i < R; i++)
+            for (size_t j = 0; j < C; j++)
+               m(i,j) = a[i][j];
+         return m;
+      }
+
+      FixedMatrix& operator+=(const FixedMatrix& m)
+      {
+         for (size_t i = 0; i < R; i++)
+            for (size_t j = 0; j < C; j++)
+               a[i][j] += m.a[i][j];
+         return *this;
+      }
+      FixedMatrix& operator-=(const FixedMatrix& m)
+      {
+         for (size_t i = 0; i < R; i++)
+            for (size_t j = 0; j < C; j++)
+               a[i][j] -= m.a[i][j];
+         return *this;
+      }
+      FixedMatrix& operator*=(const T x)
+      {
+         for (size_t i = 0; i < R; i++)
+            for (size_t j = 0; j < C; j++)
+               a[i][j] *= x;
+         return *this;
+      }
+
+   private:
+      T a[R][C];
+   };
+
+
+      /// Transpose of a FixedMatrix
+   template <class T, size_t R, size_t C>
+   inline FixedMatrix<T, C, R> transpose(const FixedMatrix<T, R, C>& m)
+   {
+      FixedMatrix<T, C, R> t;
+      for (size_t i = 0; i < R; i++)
+         for (size_t j = 0; j < C; j++)
+            t(j,i) = m(i,j);
+      return t;
+   }
+
+      /// FixedMatrix * FixedMatrix
+   template <class T, size_t R, size_t K, size_t C>
+   inline FixedMatrix<T, R, C> operator*(const FixedMatrix<T, R, K>& l,
+                                         const FixedMatrix<T, K, C>& r)
+   {
+      FixedMatrix<T, R, C> p;
+      for (size_t i = 0; i < R; i++)
+         for (size_t j = 0; j < C; j++)
+         {
+            T sum(l(i,0) * r(0,j));
+            for (size_t k = 1; k < K; k++)
+               sum += l(i,k) * r(k,j);
+            p(i,j) = sum;
+         }
+      return p;
+   }
+
+      /// FixedMatrix * FixedVector
+   template <class T, size_t R, size_t C>
+   inline FixedVector<T, R> operator*(const FixedMatrix<T, R, C>& m,
+                                      const FixedVector<T, C>& v)
+   {
+      FixedVector<T, R> p;
+      for (size_t i = 0; i < R; i++)
+      {
+         T sum(m(i,0) * v[0]);
+         for (size_t j = 1; j < C; j++)
+            sum += m(i,j) * v[j];
+         p[i] = sum;
+      }
+      return p;
+   }
+
+      /// FixedVector * FixedMatrix, i.e. transpose(m) * v
+   template <class T, size_t R, size_t C>
+   inline FixedVector<T, C> operator*(const FixedVector<T, R>& v,
+                                      const FixedMatrix<T, R, C>& m)
+   {
+      FixedVector<T, C> p;
+      for (size_t j = 0; j < C; j++)
+      {
+         T sum(v[0] * m(0,j));
+         for (size_t i = 1; i < R; i++)
+            sum += v[i] * m(i,j);
+         p[j] = sum;
+      }
+      return p;
+   }
+
+      /// 3 by 3 FixedMatrix * Triple
+   inline Triple operator*(const FixedMatrix<double, 3, 3>& m, const Triple& t)
+   {
+      return Triple(m(0,0)*t[0] + m(0,1)*t[1] + m(0,2)*t[2],
+                    m(1,0)*t[0] + m(1,1)*t[1] + m(1,2)*t[2],
+                    m(2,0)*t[0] + m(2,1)*t[1] + m(2,2)*t[2]);
+   }
+
+   template <class T, size_t R, size_t C>
+   inline FixedMatrix<T, R, C> operator+(FixedMatrix<T, R, C> l,
+                                         const FixedMatrix<T, R, C>& r)
+   { return l += r; }
+
+   template <class T, size_t R, size_t C>
+   inline FixedMatrix<T, R, C> operator-(FixedMatrix<T, R, C> l,
+                                         const FixedMatrix<T, R, C>& r)
+   { return l -= r; }
+
+   template <class T, size_t R, size_t C>
+   inline FixedMatrix<T, R, C> operator*(FixedMatrix<T, R, C> m, const T x)
+   { return m *= x; }
+
+   template <class T, size_t R, size_t C>
+   inline FixedMatrix<T, R, C> operator*(const T x, FixedMatrix<T, R, C> m)
+   { return m *= x; }
+
+   template <class T, size_t N>
+   inline FixedVector<T, N> operator+(FixedVector<T, N> l,
+                                      const FixedVector<T, N>& r)
+   { return l += r; }
+
+   template <class T, size_t N>
+   inline FixedVector<T, N> operator-(FixedVector<T, N> l,
+                                      const FixedVector<T, N>& r)
+   { return l -= r; }
+
+   template <class T, size_t N>
+   inline FixedVector<T, N> operator*(FixedVector<T, N> v, const T x)
+   { return v *= x; }
+
+   template <class T, size_t N>
+   inline FixedVector<T, N> operator*(const T x, FixedVector<T, N> v)
+   { return v *= x; }
+
+      /// The cross product of two 3-vectors
+   template <class T>
+   inline FixedVector<T, 3> cross(const FixedVector<T, 3>& l,
+                                  const FixedVector<T, 3>& r)
+   {
+      FixedVector<T, 3> c;
+      c[0] = l[1] * r[2] - l[2] * r[1];
+      c[1] = l[2] * r[0] - l[0] * r[2];
+      c[2] = l[0] * r[1] - l[1] * r[0];
+      return c;
+   }
+
+      /** Rotation matrix for a rotation of the coordinate axes by
+       * angle about axis 1, 2 or 3, the same matrix as the dynamic
+       * rotation() of MatrixOperators.hpp.
+       * @param angle rotation angle in radians
+       * @param axis 1, 2 or 3 for X, Y or Z
+       * @throw MatrixException for any other axis */
+   template <class T>
+   inline FixedMatrix<T, 3, 3> fixedRotation(T angle, int axis)
+      throw(MatrixException)
+   {
+      if (axis < 1 || axis > 3)
+      {
+         MatrixException e("Invalid axis (must be 1,2, or 3)");
+         GPSTK_THROW(e);
+      }
+      const int i1 = axis - 1;
+      const int i2 = (i1 + 1) % 3, i3 = (i1 + 2) % 3;
+      const T c(std::cos(angle)), s(std::sin(angle));
+      FixedMatrix<T, 3, 3> r(T(0));
+      r(i1,i1) = T(1);
+      r(i2,i2) = r(i3,i3) = c;
+      r(i2,i3) = s;
+      r(i3,i2) = -s;
+      return r;
+   }
+
+      //@}
+
+}  // namespace
+
+#endif
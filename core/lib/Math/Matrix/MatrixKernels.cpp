@@ -0,0 +1,386 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+/// @file MatrixKernels.cpp
+/// Cache-blocked, vectorized multiplication kernels for double.
+
+#include "MatrixKernels.hpp"
+
+#include <algorithm>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define GPSTK_MATRIXKERNELS_AVX
+#elif defined(__SSE2__) || defined(_M_X64) || \
+      (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define GPSTK_MATRIXKERNELS_SSE2
+#endif
+
+using namespace std;
+
+namespace
+{
+      // The product is accumulated over MC rows by KC inner indices of
+      // A at a time, a block that stays in the level 2 cache, in tiles
+      // of MR rows by NR columns of C held in registers.
+#if defined(GPSTK_MATRIXKERNELS_AVX)
+   const size_t MR = 8;
+#else
+   const size_t MR = 4;
+#endif
+   const size_t NR = 4;
+   const size_t MC = 128;
+   const size_t KC = 128;
+
+      // C(MR by NR) += A(MR by kc)*B(kc by NR) where A(i,p) is
+      // A[i+p*lda], B(p,j) is B[p*bsp+j*bsj] and C(i,j) is C[i+j*ldc].
+   inline void tile(size_t kc, const double *A, size_t lda,
+                    const double *B, size_t bsp, size_t bsj,
+                    double *C, size_t ldc)
+   {
+      double *C0 = C, *C1 = C + ldc, *C2 = C + 2*ldc, *C3 = C + 3*ldc;
+#if defined(GPSTK_MATRIXKERNELS_AVX)
+      __m256d c00(_mm256_loadu_pd(C0)), c01(_mm256_loadu_pd(C0+4));
+      __m256d c10(_mm256_loadu_pd(C1)), c11(_mm256_loadu_pd(C1+4));
+      __m256d c20(_mm256_loadu_pd(C2)), c21(_mm256_loadu_pd(C2+4));
+      __m256d c30(_mm256_loadu_pd(C3)), c31(_mm256_loadu_pd(C3+4));
+      for (size_t p = 0; p < kc; p++)
+      {
+         const double *a = A + p*lda, *b = B + p*bsp;
+         __m256d a0(_mm256_loadu_pd(a)), a1(_mm256_loadu_pd(a+4)), bb;
+         bb = _mm256_set1_pd(b[0]);
+         c00 = _mm256_add_pd(c00, _mm256_mul_pd(a0, bb));
+         c01 = _mm256_add_pd(c01, _mm256_mul_pd(a1, bb));
+         bb = _mm256_set1_pd(b[bsj]);
+         c10 = _mm256_add_pd(c10, _mm256_mul_pd(a0, bb));
+         c11 = _mm256_add_pd(c11, _mm256_mul_pd(a1, bb));
+         bb = _mm256_set1_pd(b[2*bsj]);
+         c20 = _mm256_add_pd(c20, _mm256_mul_pd(a0, bb));
+         c21 = _mm256_add_pd(c21, _mm256_mul_pd(a1, bb));
+         bb = _mm256_set1_pd(b[3*bsj]);
+         c30 = _mm256_add_pd(c30, _mm256_mul_pd(a0, bb));
+         c31 = _mm256_add_pd(c31, _mm256_mul_pd(a1, bb));
+      }
+      _mm256_storeu_pd(C0, c00); _mm256_storeu_pd(C0+4, c01);
+      _mm256_storeu_pd(C1, c10); _mm256_storeu_pd(C1+4, c11);
+      _mm256_storeu_pd(C2, c20); _mm256_storeu_pd(C2+4, c21);
+      _mm256_storeu_pd(C3, c30); _mm256_storeu_pd(C3+4, c31);
+#elif defined(GPSTK_MATRIXKERNELS_SSE2)
+      __m128d c00(_mm_loadu_pd(C0)), c01(_mm_loadu_pd(C0+2));
+      __m128d c10(_mm_loadu_pd(C1)), c11(_mm_loadu_pd(C1+2));
+      __m128d c20(_mm_loadu_pd(C2)), c21(_mm_loadu_pd(C2+2));
+      __m128d c30(_mm_loadu_pd(C3)), c31(_mm_loadu_pd(C3+2));
+      for (size_t p = 0; p < kc; p++)
+      {
+         const double *a = A + p*lda, *b = B + p*bsp;
+         __m128d a0(_mm_loadu_pd(a)), a1(_mm_loadu_pd(a+2)), bb;
+         bb = _mm_set1_pd(b[0]);
+         c00 = _mm_add_pd(c00, _mm_mul_pd(a0, bb));
+         c01 = _mm_add_pd(c01, _mm_mul_pd(a1, bb));
+         bb = _mm_set1_pd(b[bsj]);
+         c10 = _mm_add_pd(c10, _mm_mul_pd(a0, bb));
+         c11 = _mm_add_pd(c11, _mm_mul_pd(a1, bb));
+         bb = _mm_set1_pd(b[2*bsj]);
+         c20 = _mm_add_pd(c20, _mm_mul_pd(a0, bb));
+         c21 = _mm_add_pd(c21, _mm_mul_pd(a1, bb));
+         bb = _mm_set1_pd(b[3*bsj]);
+         c30 = _mm_add_pd(c30, _mm_mul_pd(a0, bb));
+         c31 = _mm_add_pd(c31, _mm_mul_pd(a1, bb));
+      }
+      _mm_storeu_pd(C0, c00); _mm_storeu_pd(C0+2, c01);
+      _mm_storeu_pd(C1, c10); _mm_storeu_pd(C1+2, c11);
+      _mm_storeu_pd(C2, c20); _mm_storeu_pd(C2+2, c21);
+      _mm_storeu_pd(C3, c30); _mm_storeu_pd(C3+2, c31);
+#else
+      double c[4][4];
+      size_t i, j;
+      for (j = 0; j < 4; j++)
+         for (i = 0; i < 4; i++)
+            c[j][i] = C[i + j*ldc];
+      for (size_t p = 0; p < kc; p++)
+      {
+         const double *a = A + p*lda, *b = B + p*bsp;
+         for (j = 0; j < 4; j++)
+         {
+            const double bb(b[j*bsj]);
+            for (i = 0; i < 4; i++)
+               c[j][i] += a[i] * bb;
+         }
+      }
+      for (j = 0; j < 4; j++)
+         for (i = 0; i < 4; i++)
+            C[i + j*ldc] = c[j][i];
+#endif
+   }
+
+      // The same product over rows i0 to i1 and columns j0 to j1 of C
+      // that do not fill a tile.
+   void edge(size_t i0, size_t i1, size_t j0, size_t j1, size_t kc,
+             const double *A, size_t lda,
+             const double *B, size_t bsp, size_t bsj,
+             double *C, size_t ldc)
+   {
+      for (size_t j = j0; j < j1; j++)
+      {
+         double *c = C + j*ldc;
+         for (size_t p = 0; p < kc; p++)
+         {
+            const double b(B[p*bsp + j*bsj]);
+            const double *a = A + p*lda;
+            for (size_t i = i0; i < i1; i++)
+               c[i] += a[i] * b;
+         }
+      }
+   }
+
+      // C += A*B, with A m by k and C m by n column-major (leading
+      // dimension m), B(p,j) at B[p*bsp+j*bsj].
+   void gemmBlocked(size_t m, size_t n, size_t k, const double *A,
+                    const double *B, size_t bsp, size_t bsj, double *C)
+   {
+      for (size_t pb = 0; pb < k; pb += KC)
+      {
+         const size_t kc(std::min(KC, k - pb));
+         for (size_t ib = 0; ib < m; ib += MC)
+         {
+            const size_t mc(std::min(MC, m - ib));
+            const size_t mfull(mc - mc % MR);
+            const double *a = A + ib + pb*m, *b = B + pb*bsp;
+            double *c = C + ib;
+            size_t i, j;
+            for (j = 0; j + NR <= n; j += NR)
+            {
+               for (i = 0; i < mfull; i += MR)
+                  tile(kc, a + i, m, b + j*bsj, bsp, bsj, c + i + j*m, m);
+               if (mfull < mc)
+                  edge(mfull, mc, j, j + NR, kc, a, m, b, bsp, bsj, c, m);
+            }
+            if (j < n)
+               edge(0, mc, j, n, kc, a, m, b, bsp, bsj, c, m);
+         }
+      }
+   }
+
+      // SUM x[i]*y[i], i=0,n-1
+   inline double dot(size_t n, const double *x, const double *y)
+   {
+      size_t i(0);
+      double sum(0.0);
+#if defined(GPSTK_MATRIXKERNELS_AVX)
+      __m256d s0(_mm256_setzero_pd()), s1(_mm256_setzero_pd());
+      for (; i + 8 <= n; i += 8)
+      {
+         s0 = _mm256_add_pd(s0, _mm256_mul_pd(_mm256_loadu_pd(x+i),
+                                              _mm256_loadu_pd(y+i)));
+         s1 = _mm256_add_pd(s1, _mm256_mul_pd(_mm256_loadu_pd(x+i+4),
+                                              _mm256_loadu_pd(y+i+4)));
+      }
+      double s[4];
+      _mm256_storeu_pd(s, _mm256_add_pd(s0, s1));
+      sum = (s[0] + s[1]) + (s[2] + s[3]);
+#elif defined(GPSTK_MATRIXKERNELS_SSE2)
+      __m128d s0(_mm_setzero_pd()), s1(_mm_setzero_pd());
+      for (; i + 4 <= n; i += 4)
+      {
+         s0 = _mm_add_pd(s0, _mm_mul_pd(_mm_loadu_pd(x+i),
+                                        _mm_loadu_pd(y+i)));
+         s1 = _mm_add_pd(s1, _mm_mul_pd(_mm_loadu_pd(x+i+2),
+                                        _mm_loadu_pd(y+i+2)));
+      }
+      double s[2];
+      _mm_storeu_pd(s, _mm_add_pd(s0, s1));
+      sum = s[0] + s[1];
+#endif
+      for (; i < n; i++)
+         sum += x[i] * y[i];
+      return sum;
+   }
+
+      // SUM x[i]*w[i]*y[i], i=0,n-1
+   inline double dot(size_t n, const double *x, const double *w,
+                     const double *y)
+   {
+      size_t i(0);
+      double sum(0.0);
+#if defined(GPSTK_MATRIXKERNELS_AVX)
+      __m256d s0(_mm256_setzero_pd());
+      for (; i + 4 <= n; i += 4)
+         s0 = _mm256_add_pd(s0, _mm256_mul_pd(
+                               _mm256_mul_pd(_mm256_loadu_pd(x+i),
+                                             _mm256_loadu_pd(w+i)),
+                               _mm256_loadu_pd(y+i)));
+      double s[4];
+      _mm256_storeu_pd(s, s0);
+      sum = (s[0] + s[1]) + (s[2] + s[3]);
+#elif defined(GPSTK_MATRIXKERNELS_SSE2)
+      __m128d s0(_mm_setzero_pd());
+      for (; i + 2 <= n; i += 2)
+         s0 = _mm_add_pd(s0, _mm_mul_pd(_mm_mul_pd(_mm_loadu_pd(x+i),
+                                                   _mm_loadu_pd(w+i)),
+                                        _mm_loadu_pd(y+i)));
+      double s[2];
+      _mm_storeu_pd(s, s0);
+      sum = s[0] + s[1];
+#endif
+      for (; i < n; i++)
+         sum += x[i] * w[i] * y[i];
+      return sum;
+   }
+
+      // y[i] += a0[i]*x0 + a1[i]*x1 + a2[i]*x2 + a3[i]*x3, i=0,n-1
+   inline void axpy4(size_t n, const double *a0, const double *a1,
+                     const double *a2, const double *a3,
+                     const double *x, double *y)
+   {
+      size_t i(0);
+#if defined(GPSTK_MATRIXKERNELS_AVX)
+      __m256d x0(_mm256_set1_pd(x[0])), x1(_mm256_set1_pd(x[1]));
+      __m256d x2(_mm256_set1_pd(x[2])), x3(_mm256_set1_pd(x[3]));
+      for (; i + 4 <= n; i += 4)
+      {
+         __m256d s(_mm256_loadu_pd(y+i));
+         s = _mm256_add_pd(s, _mm256_mul_pd(_mm256_loadu_pd(a0+i), x0));
+         s = _mm256_add_pd(s, _mm256_mul_pd(_mm256_loadu_pd(a1+i), x1));
+         s = _mm256_add_pd(s, _mm256_mul_pd(_mm256_loadu_pd(a2+i), x2));
+         s = _mm256_add_pd(s, _mm256_mul_pd(_mm256_loadu_pd(a3+i), x3));
+         _mm256_storeu_pd(y+i, s);
+      }
+#elif defined(GPSTK_MATRIXKERNELS_SSE2)
+      __m128d x0(_mm_set1_pd(x[0])), x1(_mm_set1_pd(x[1]));
+      __m128d x2(_mm_set1_pd(x[2])), x3(_mm_set1_pd(x[3]));
+      for (; i + 2 <= n; i += 2)
+      {
+         __m128d s(_mm_loadu_pd(y+i));
+         s = _mm_add_pd(s, _mm_mul_pd(_mm_loadu_pd(a0+i), x0));
+         s = _mm_add_pd(s, _mm_mul_pd(_mm_loadu_pd(a1+i), x1));
+         s = _mm_add_pd(s, _mm_mul_pd(_mm_loadu_pd(a2+i), x2));
+         s = _mm_add_pd(s, _mm_mul_pd(_mm_loadu_pd(a3+i), x3));
+         _mm_storeu_pd(y+i, s);
+      }
+#endif
+      for (; i < n; i++)
+         y[i] += a0[i]*x[0] + a1[i]*x[1] + a2[i]*x[2] + a3[i]*x[3];
+   }
+
+      // Elements of A (whole columns) taken together by gemtmKernel and
+      // syrkKernel, so that they stay in cache while the other operand
+      // is swept.
+   const size_t DotBlock = 32768;
+}
+
+namespace gpstk
+{
+   void gemmKernel(size_t m, size_t n, size_t k,
+                   const double *A, const double *B, double *C,
+                   bool accumulate)
+      throw()
+   {
+      if (!accumulate)
+         std::fill(C, C + m*n, 0.0);
+      gemmBlocked(m, n, k, A, B, 1, k, C);
+   }
+
+   void gemmtKernel(size_t m, size_t n, size_t k,
+                    const double *A, const double *B, double *C,
+                    bool accumulate)
+      throw()
+   {
+      if (!accumulate)
+         std::fill(C, C + m*n, 0.0);
+      gemmBlocked(m, n, k, A, B, n, 1, C);
+   }
+
+   void gemtmKernel(size_t m, size_t n, size_t k,
+                    const double *A, const double *B, double *C)
+      throw()
+   {
+      const size_t nb(std::max(size_t(1), DotBlock / (k ? k : 1)));
+      for (size_t ib = 0; ib < m; ib += nb)
+      {
+         const size_t ie(std::min(m, ib + nb));
+         for (size_t j = 0; j < n; j++)
+            for (size_t i = ib; i < ie; i++)
+               C[i + j*m] = dot(k, A + i*k, B + j*k);
+      }
+   }
+
+   void gemvKernel(size_t m, size_t n,
+                   const double *A, const double *x, double *y)
+      throw()
+   {
+      std::fill(y, y + m, 0.0);
+      size_t j(0);
+      for (; j + 4 <= n; j += 4)
+         axpy4(m, A + j*m, A + (j+1)*m, A + (j+2)*m, A + (j+3)*m, x + j, y);
+      for (; j < n; j++)
+      {
+         const double *a = A + j*m;
+         for (size_t i = 0; i < m; i++)
+            y[i] += a[i] * x[j];
+      }
+   }
+
+   void gemtvKernel(size_t m, size_t n,
+                    const double *A, const double *x, double *y)
+      throw()
+   {
+      for (size_t j = 0; j < n; j++)
+         y[j] = dot(m, A + j*m, x);
+   }
+
+   void syrkKernel(size_t m, size_t n,
+                   const double *A, const double *w, double *C)
+      throw()
+   {
+      const size_t nb(std::max(size_t(1), DotBlock / (m ? m : 1)));
+      for (size_t ib = 0; ib < n; ib += nb)
+      {
+         const size_t ie(std::min(n, ib + nb));
+         for (size_t j = ib; j < n; j++)
+         {
+            const double *aj = A + j*m;
+            for (size_t i = ib; i < ie && i <= j; i++)
+            {
+               const double *ai = A + i*m;
+               C[i + j*n] = C[j + i*n] =
+                  (w ? dot(m, ai, w, aj) : dot(m, ai, aj));
+            }
+         }
+      }
+   }
+
+}  // namespace
@@ -0,0 +1,228 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+/// @file MatrixKernels.hpp
+/// Multiplication kernels on the column-major storage of Matrix<T>
+/// and Vector<T>.
+
+#ifndef GPSTK_MATRIX_KERNELS_HPP
+#define GPSTK_MATRIX_KERNELS_HPP
+
+#include <cstddef>
+
+namespace gpstk
+{
+      /// @ingroup MathGroup
+      //@{
+
+      /** @defgroup MatrixKernels Matrix multiplication kernels
+       * These work on raw column-major arrays, as stored by Matrix<T>,
+       * with the leading dimension of each array equal to its number
+       * of rows. The templates are plain loops ordered for unit stride;
+       * the overloads for double are cache-blocked and use SSE2 or AVX
+       * when the compiler targets them. None of them allocate memory,
+       * and the output must not overlap the inputs. The operators in
+       * MatrixOperators.hpp, and multiplyInto() and its relatives,
+       * call these. */
+      //@{
+
+      /** C = A*B, or C += A*B if accumulate is true.
+       * @param[in] m rows of A and C
+       * @param[in] n columns of B and C
+       * @param[in] k columns of A and rows of B */
+   template <class T>
+   void gemmKernel(std::size_t m, std::size_t n, std::size_t k,
+                   const T *A, const T *B, T *C, bool accumulate = false)
+      throw()
+   {
+      std::size_t i, j, p;
+      for (j = 0; j < n; j++)
+      {
+         T *c = C + j*m;
+         if (!accumulate)
+            for (i = 0; i < m; i++)
+               c[i] = T(0);
+         for (p = 0; p < k; p++)
+         {
+            const T b(B[p + j*k]);
+            const T *a = A + p*m;
+            for (i = 0; i < m; i++)
+               c[i] += a[i] * b;
+         }
+      }
+   }
+
+      /** C = A*transpose(B), or C += A*transpose(B) if accumulate is
+       * true. A is m by k, B is n by k. */
+   template <class T>
+   void gemmtKernel(std::size_t m, std::size_t n, std::size_t k,
+                    const T *A, const T *B, T *C, bool accumulate = false)
+      throw()
+   {
+      std::size_t i, j, p;
+      if (!accumulate)
+         for (i = 0; i < m*n; i++)
+            C[i] = T(0);
+      for (p = 0; p < k; p++)
+      {
+         const T *a = A + p*m;
+         for (j = 0; j < n; j++)
+         {
+            const T b(B[j + p*n]);
+            T *c = C + j*m;
+            for (i = 0; i < m; i++)
+               c[i] += a[i] * b;
+         }
+      }
+   }
+
+      /** C = transpose(A)*B. A is k by m, B is k by n, C is m by n. */
+   template <class T>
+   void gemtmKernel(std::size_t m, std::size_t n, std::size_t k,
+                    const T *A, const T *B, T *C)
+      throw()
+   {
+      std::size_t i, j, p;
+      for (j = 0; j < n; j++)
+         for (i = 0; i < m; i++)
+         {
+            T sum(0);
+            for (p = 0; p < k; p++)
+               sum += A[p + i*k] * B[p + j*k];
+            C[i + j*m] = sum;
+         }
+   }
+
+      /** y = A*x, A is m by n. */
+   template <class T>
+   void gemvKernel(std::size_t m, std::size_t n,
+                   const T *A, const T *x, T *y)
+      throw()
+   {
+      std::size_t i, j;
+      for (i = 0; i < m; i++)
+         y[i] = T(0);
+      for (j = 0; j < n; j++)
+      {
+         const T *a = A + j*m;
+         for (i = 0; i < m; i++)
+            y[i] += a[i] * x[j];
+      }
+   }
+
+      /** y = transpose(A)*x, A is m by n. */
+   template <class T>
+   void gemtvKernel(std::size_t m, std::size_t n,
+                    const T *A, const T *x, T *y)
+      throw()
+   {
+      std::size_t i, j;
+      for (j = 0; j < n; j++)
+      {
+         const T *a = A + j*m;
+         T sum(0);
+         for (i = 0; i < m; i++)
+            sum += a[i] * x[i];
+         y[j] = sum;
+      }
+   }
+
+      /** C = transpose(A)*diag(w)*A, the normal matrix of the m by n
+       * matrix A with weights w, or transpose(A)*A if w is NULL. C is
+       * n by n and exactly symmetric. */
+   template <class T>
+   void syrkKernel(std::size_t m, std::size_t n,
+                   const T *A, const T *w, T *C)
+      throw()
+   {
+      std::size_t i, j, p;
+      for (j = 0; j < n; j++)
+      {
+         const T *aj = A + j*m;
+         for (i = 0; i <= j; i++)
+         {
+            const T *ai = A + i*m;
+            T sum(0);
+            if (w)
+               for (p = 0; p < m; p++)
+                  sum += ai[p] * w[p] * aj[p];
+            else
+               for (p = 0; p < m; p++)
+                  sum += ai[p] * aj[p];
+            C[i + j*n] = C[j + i*n] = sum;
+         }
+      }
+   }
+
+      /// @copydoc gemmKernel
+   void gemmKernel(std::size_t m, std::size_t n, std::size_t k,
+                   const double *A, const double *B, double *C,
+                   bool accumulate = false)
+      throw();
+
+      /// @copydoc gemmtKernel
+   void gemmtKernel(std::size_t m, std::size_t n, std::size_t k,
+                    const double *A, const double *B, double *C,
+                    bool accumulate = false)
+      throw();
+
+      /// @copydoc gemtmKernel
+   void gemtmKernel(std::size_t m, std::size_t n, std::size_t k,
+                    const double *A, const double *B, double *C)
+      throw();
+
+      /// @copydoc gemvKernel
+   void gemvKernel(std::size_t m, std::size_t n,
+                   const double *A, const double *x, double *y)
+      throw();
+
+      /// @copydoc gemtvKernel
+   void gemtvKernel(std::size_t m, std::size_t n,
+                    const double *A, const double *x, double *y)
+      throw();
+
+      /// @copydoc syrkKernel
+   void syrkKernel(std::size_t m, std::size_t n,
+                   const double *A, const double *w, double *C)
+      throw();
+
+      //@}
+
+      //@}
+
+}  // namespace
+
+#endif
@@ -45,6 +45,7 @@
 #include <limits>
 #include "MiscMath.hpp"
 #include "MatrixFunctors.hpp"
+#include "MatrixKernels.hpp"
 
 namespace gpstk
 {
@@ -797,8 +798,297 @@ namespace gpstk
    }  // end inverseChol
 
 
+      /**
+       * Computes C = A * B, for any matrix types. C is resized, which
+       * reuses its storage when it is already large enough, so that
+       * products computed repeatedly into the same C do not allocate.
+       * C must not be a slice of A or B.
+       */
+   template <class T, class BaseClass1, class BaseClass2>
+   inline Matrix<T>& multiplyInto(Matrix<T>& C,
+                                  const ConstMatrixBase<T, BaseClass1>& A,
+                                  const ConstMatrixBase<T, BaseClass2>& B)
+      throw (MatrixException)
+   {
+      if (A.cols() != B.rows())
+      {
+         MatrixException e("Incompatible dimensions for Matrix * Matrix");
+         GPSTK_THROW(e);
+      }
+
+      C.resize(A.rows(), B.cols(), T(0));
+      size_t i, j, k;
+      for (j = 0; j < C.cols(); j++)
+         for (k = 0; k < A.cols(); k++)
+            for (i = 0; i < C.rows(); i++)
+               C(i,j) += A(i,k) * B(k,j);
+
+      return C;
+   }
+
+      /**
+       * Computes C = A * B using gemmKernel() on the storage of A, B
+       * and C. C may be A or B.
+       */
+   template <class T>
+   inline Matrix<T>& multiplyInto(Matrix<T>& C,
+                                  const Matrix<T>& A, const Matrix<T>& B)
+      throw (MatrixException)
+   {
+      if (A.cols() != B.rows())
+      {
+         MatrixException e("Incompatible dimensions for Matrix * Matrix");
+         GPSTK_THROW(e);
+      }
+
+      if (&C == &A || &C == &B)
+      {
+         Matrix<T> product;
+         multiplyInto(product, A, B);
+         return C = product;
+      }
+
+      C.resize(A.rows(), B.cols());
+      gemmKernel(A.rows(), B.cols(), A.cols(), A.begin(), B.begin(),
+                 C.begin());
+      return C;
+   }
+
+      /**
+       * Computes y = A * x, for any matrix and vector types, reusing
+       * the storage of y. y must not be a slice of x.
+       */
+   template <class T, class BaseClass1, class BaseClass2>
+   inline Vector<T>& multiplyInto(Vector<T>& y,
+                                  const ConstMatrixBase<T, BaseClass1>& A,
+                                  const ConstVectorBase<T, BaseClass2>& x)
+      throw (MatrixException)
+   {
+      if (x.size() != A.cols())
+      {
+         gpstk::MatrixException e("Incompatible dimensions for Vector * Matrix");
+         GPSTK_THROW(e);
+      }
+
+      y.resize(A.rows(), T(0));
+      size_t i, j;
+      for (j = 0; j < A.cols(); j++)
+         for (i = 0; i < A.rows(); i++)
+            y[i] += A(i, j) * x[j];
+      return y;
+   }
+
+      /**
+       * Computes y = A * x using gemvKernel(). y may be x.
+       */
+   template <class T>
+   inline Vector<T>& multiplyInto(Vector<T>& y,
+                                  const Matrix<T>& A, const Vector<T>& x)
+      throw (MatrixException)
+   {
+      if (x.size() != A.cols())
+      {
+         gpstk::MatrixException e("Incompatible dimensions for Vector * Matrix");
+         GPSTK_THROW(e);
+      }
+
+      if (&y == &x)
+      {
+         Vector<T> product;
+         multiplyInto(product, A, x);
+         return y = product;
+      }
+
+      y.resize(A.rows());
+      gemvKernel(A.rows(), A.cols(), A.begin(), x.begin(), y.begin());
+      return y;
+   }
+
+      /**
+       * Computes y = transpose(A) * x, which is also x * A, for any
+       * matrix and vector types, reusing the storage of y. y must not
+       * be a slice of x.
+       */
+   template <class T, class BaseClass1, class BaseClass2>
+   inline Vector<T>& transposeMultiplyInto(Vector<T>& y,
+                                  const ConstMatrixBase<T, BaseClass1>& A,
+                                  const ConstVectorBase<T, BaseClass2>& x)
+      throw (MatrixException)
+   {
+      if (x.size() != A.rows())
+      {
+         gpstk::MatrixException e("Incompatible dimensions for Vector * Matrix");
+         GPSTK_THROW(e);
+      }
+
+      y.resize(A.cols());
+      size_t i, j;
+      for (j = 0; j < A.cols(); j++)
+      {
+         T sum(0);
+         for (i = 0; i < A.rows(); i++)
+            sum += A(i, j) * x[i];
+         y[j] = sum;
+      }
+      return y;
+   }
+
+      /**
+       * Computes y = transpose(A) * x using gemtvKernel(). y may be x.
+       */
+   template <class T>
+   inline Vector<T>& transposeMultiplyInto(Vector<T>& y,
+                                           const Matrix<T>& A,
+                                           const Vector<T>& x)
+      throw (MatrixException)
+   {
+      if (x.size() != A.rows())
+      {
+         gpstk::MatrixException e("Incompatible dimensions for Vector * Matrix");
+         GPSTK_THROW(e);
+      }
+
+      if (&y == &x)
+      {
+         Vector<T> product;
+         transposeMultiplyInto(product, A, x);
+         return y = product;
+      }
+
+      y.resize(A.cols());
+      gemtvKernel(A.rows(), A.cols(), A.begin(), x.begin(), y.begin());
+      return y;
+   }
+
+      /**
+       * Computes C = transpose(A) * B without forming transpose(A).
+       * C may be A or B.
+       */
+   template <class T>
+   inline Matrix<T>& transposeMultiplyInto(Matrix<T>& C,
+                                           const Matrix<T>& A,
+                                           const Matrix<T>& B)
+      throw (MatrixException)
+   {
+      if (A.rows() != B.rows())
+      {
+         MatrixException e("Incompatible dimensions for transpose(Matrix) * Matrix");
+         GPSTK_THROW(e);
+      }
+
+      if (&C == &A || &C == &B)
+      {
+         Matrix<T> product;
+         transposeMultiplyInto(product, A, B);
+         return C = product;
+      }
+
+      C.resize(A.cols(), B.cols());
+      gemtmKernel(A.cols(), B.cols(), A.rows(), A.begin(), B.begin(),
+                  C.begin());
+      return C;
+   }
+
+      /**
+       * Computes C = A * transpose(B) without forming transpose(B),
+       * e.g. the second product of phi*P*transpose(phi). C may be A
+       * or B.
+       */
+   template <class T>
+   inline Matrix<T>& multiplyTransposeInto(Matrix<T>& C,
+                                           const Matrix<T>& A,
+                                           const Matrix<T>& B)
+      throw (MatrixException)
+   {
+      if (A.cols() != B.cols())
+      {
+         MatrixException e("Incompatible dimensions for Matrix * transpose(Matrix)");
+         GPSTK_THROW(e);
+      }
+
+      if (&C == &A || &C == &B)
+      {
+         Matrix<T> product;
+         multiplyTransposeInto(product, A, B);
+         return C = product;
+      }
+
+      C.resize(A.rows(), B.rows());
+      gemmtKernel(A.rows(), B.rows(), A.cols(), A.begin(), B.begin(),
+                  C.begin());
+      return C;
+   }
+
+      /**
+       * Computes the normal matrix C = transpose(A) * A, exactly
+       * symmetric, using syrkKernel(). C must not be A.
+       */
+   template <class T>
+   inline Matrix<T>& normalInto(Matrix<T>& C, const Matrix<T>& A)
+      throw (MatrixException)
+   {
+      if (&C == &A)
+      {
+         MatrixException e("normalInto() output must not be its input");
+         GPSTK_THROW(e);
+      }
+
+      C.resize(A.cols(), A.cols());
+      syrkKernel(A.rows(), A.cols(), A.begin(), (const T*)0, C.begin());
+      return C;
+   }
+
+      /**
+       * Computes the weighted normal matrix C = transpose(A) * W * A
+       * for the diagonal weight matrix W = diag(w), exactly symmetric,
+       * using syrkKernel(). C must not be A.
+       */
+   template <class T>
+   inline Matrix<T>& normalInto(Matrix<T>& C, const Matrix<T>& A,
+                                const Vector<T>& w)
+      throw (MatrixException)
+   {
+      if (w.size() != A.rows())
+      {
+         MatrixException e("Incompatible dimensions for transpose(Matrix) * diag(Vector) * Matrix");
+         GPSTK_THROW(e);
+      }
+      if (&C == &A)
+      {
+         MatrixException e("normalInto() output must not be its input");
+         GPSTK_THROW(e);
+      }
+
+      C.resize(A.cols(), A.cols());
+      syrkKernel(A.rows(), A.cols(), A.begin(), w.begin(), C.begin());
+      return C;
+   }
+
+      /**
+       * Computes the weighted normal matrix C = transpose(A) * W * A
+       * for a full weight matrix W, as transpose(A) * (W * A) with
+       * W * A formed in work, so that repeated calls with the same
+       * work and C do not allocate. C and work must be distinct from
+       * each other and from A and W.
+       */
+   template <class T>
+   inline Matrix<T>& normalInto(Matrix<T>& C, const Matrix<T>& A,
+                                const Matrix<T>& W, Matrix<T>& work)
+      throw (MatrixException)
+   {
+      if (W.rows() != A.rows())
+      {
+         MatrixException e("Incompatible dimensions for transpose(Matrix) * Matrix * Matrix");
+         GPSTK_THROW(e);
+      }
+
+      multiplyInto(work, W, A);
+      return transposeMultiplyInto(C, A, work);
+   }
+
       /**
        *  Matrix * Matrix : row by column multiplication of two matricies.
+       *  Products of two Matrix objects use gemmKernel().
        */
    template <class T, class BaseClass1, class BaseClass2>
    inline Matrix<T> operator* (const ConstMatrixBase<T, BaseClass1>& l, 
@@ -811,13 +1101,9 @@ namespace gpstk
          GPSTK_THROW(e);
       }
    
-      Matrix<T> toReturn(l.rows(), r.cols(), T(0));
-      size_t i, j, k;
-      for (i = 0; i < toReturn.rows(); i++)
-         for (j = 0; j < toReturn.cols(); j++)
-            for (k = 0; k < l.cols(); k++)
-               toReturn(i,j) += l(i,k) * r(k,j);
-
+      Matrix<T> toReturn;
+      multiplyInto(toReturn, static_cast<const BaseClass1&>(l),
+                   static_cast<const BaseClass2&>(r));
       return toReturn;
    }
 
@@ -835,14 +1121,9 @@ namespace gpstk
          GPSTK_THROW(e);
       }
    
-      Vector<T> toReturn(m.rows());
-      size_t i, j;
-      for (i = 0; i < m.rows(); i++) 
-      {
-         toReturn[i] = 0;
-         for (j = 0; j < m.cols(); j++)
-            toReturn[i] += m(i, j) * v[j];
-      }
+      Vector<T> toReturn;
+      multiplyInto(toReturn, static_cast<const BaseClass1&>(m),
+                   static_cast<const BaseClass2&>(v));
       return toReturn;
    }
       /**
@@ -859,14 +1140,9 @@ namespace gpstk
          GPSTK_THROW(e);
       }
    
-      Vector<T> toReturn(m.cols());
-      size_t i, j;
-      for (i = 0; i < m.cols(); i++) 
-      {
-         toReturn[i] = 0;
-         for (j = 0; j < m.rows(); j++)
-            toReturn[i] += m(j,i) * v[j];
-      }
+      Vector<T> toReturn;
+      transposeMultiplyInto(toReturn, static_cast<const BaseClass2&>(m),
+                            static_cast<const BaseClass1&>(v));
       return toReturn;
    }
 
@@ -78,10 +78,11 @@ void RACRotation::compute( const gpstk::Triple& SVPositionVector,
                            const gpstk::Triple& SVVelocityVector)
 {
 
-   gpstk::Triple unitR = SVPositionVector.unitVector();
-   gpstk::Triple C = unitR.cross(SVVelocityVector);
-   gpstk::Triple unitC = C.unitVector();
-   gpstk::Triple unitA = unitC.cross(unitR);
+   typedef FixedVector<double,3> Vec3;
+   Vec3 unitR = Vec3(SVPositionVector).unitVector();
+   Vec3 C = cross(unitR, Vec3(SVVelocityVector));
+   Vec3 unitC = C.unitVector();
+   Vec3 unitA = cross(unitC, unitR);
 
    (*this) (0,0) = unitR[0];
    (*this) (0,1) = unitR[1];
@@ -126,14 +127,7 @@ gpstk::Vector<double> RACRotation::convertToRAC( const gpstk::Vector<double>& in
 
 gpstk::Triple RACRotation::convertToRAC( const gpstk::Triple& inVec )
 {
-   gpstk::Vector<double> v(3);
-   v[0] = inVec[0];
-   v[1] = inVec[1];
-   v[2] = inVec[2];
-
-   gpstk::Vector<double> vOut = convertToRAC( v );
-   gpstk::Triple outVec( vOut[0], vOut[1], vOut[2] );
-   return(outVec);
+   return( FixedMatrix<double,3,3>(*this) * inVec );
 }
 
 gpstk::Xvt RACRotation::convertToRAC( const gpstk::Xvt& in )
@@ -42,6 +42,7 @@
 // gpstk
 #include "Triple.hpp"
 #include "Matrix.hpp"
+#include "FixedMatrix.hpp"
 #include "Vector.hpp"
 #include "Xvt.hpp"
 
@@ -1,6 +1,5 @@
 #include "LNavParityFilter.hpp"
 #include "LNavFilterData.hpp"
-#include "EngNav.hpp"
 
 namespace gpstk
 {
@@ -19,10 +18,53 @@ namespace gpstk
       for (i = msgBitsIn.begin(); i != msgBitsIn.end(); i++)
       {
          LNavFilterData *fd = dynamic_cast<LNavFilterData*>(*i);
-         if (EngNav::checkParity(fd->sf))
+         if (checkParity(fd->sf))
             accept(*i, msgBitsOut);
          else
             reject(*i);
       }
    }
+
+
+   bool LNavParityFilter ::
+   checkParity(const uint32_t sf[10])
+   {
+         /* One mask per parity bit, D25 to D30 (table 20-XIV of
+            IS-GPS-200), applied to a word holding D29* and D30* of
+            the previous word in bits 31 and 30, followed by the 30
+            bits of the current word.  Each mask selects the data
+            bits of EngNav::computeParity(), the previous parity bit
+            that equation uses, and the received parity bit, so the
+            masked word has an even number of bits set when the
+            received parity bit is right.  The masks are paired in
+            64-bit words to check two parity bits at a time. */
+      static const uint64_t hmask[3] =
+         { 0xBB1F34A05D8F9A50ULL, 0xAEC7CD085763E684ULL,
+           0x6BB1F3428B7A89C1ULL };
+
+      uint64_t prev = 0;
+      for (unsigned word = 0; word < 10; word++)
+      {
+         uint64_t packed = (prev << 30) | (sf[word] & 0x3fffffff);
+         packed |= (packed << 32);
+
+            // Fold each 32-bit half onto its lowest bit, which ends
+            // up holding the parity of that half's popcount.
+         uint64_t fail = 0;
+         for (unsigned pair = 0; pair < 3; pair++)
+         {
+            uint64_t v = hmask[pair] & packed;
+            v ^= v >> 16;
+            v ^= v >> 8;
+            v ^= v >> 4;
+            v ^= v >> 2;
+            v ^= v >> 1;
+            fail |= v;
+         }
+         if (fail & 0x0000000100000001ULL)
+            return false;
+         prev = sf[word] & 0x03;
+      }
+      return true;
+   }
 }
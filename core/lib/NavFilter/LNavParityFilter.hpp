@@ -25,6 +25,16 @@ namespace gpstk
           *   the filter. */
       virtual void validate(NavMsgList& msgBitsIn, NavMsgList& msgBitsOut);
 
+         /** Check the parity of an upright subframe (per IS-GPS-200).
+          * Gives the same result as EngNav::checkParity(sf), but
+          * packs D29* and D30* of the previous word above the 30
+          * bits of each word, so that each parity equation is the
+          * parity of the popcount of one masked 32-bit word.  Two
+          * equations are checked at a time in a 64-bit word.
+          * @param[in] sf The ten subframe words, right-justified.
+          * @return true if all the words pass the parity check. */
+      static bool checkParity(const uint32_t sf[10]);
+
          /// Filter stores no data, therefore this does nothing.
       virtual void finalize(NavMsgList& msgBitsOut)
       {}
@@ -74,7 +74,6 @@ namespace gpstk
       int j,noeph(0),N,NSVS;
       size_t i;
       CommonTime tx;
-      Xvt PVT;
 
       // if necessary, define the SystemIDs vector (but NOT the member data one)
       if(Syss.size() == 0) {
@@ -103,7 +102,12 @@ namespace gpstk
       if(N <= 0) return 0;                            // nothing to do
       NSVS = 0;                                       // count good sats w/ ephem
 
-      // loop over all satellites
+      // first estimate of transmit time, for all unmarked satellites
+      vector<size_t> index;                           // index in Sats
+      vector<SatID> sats;
+      vector<CommonTime> times;
+      vector<Xvt> PVTs;
+      vector<bool> valid;
       for(i=0; i<Sats.size(); i++) {
 
          // skip marked satellites
@@ -114,45 +118,52 @@ namespace gpstk
          }
          LOG(DEBUG) << " Process sat " << RinexSatID(Sats[i]);
 
-         // first estimate of transmit time
-         tx = Tr;
-
          // must align time systems.
          // know system of Tr, and must assume system of pEph(sat) is system(sat).
          // pEph must do calc in its sys, so must transform Tr to system(sat).
          // convert time system of tx to that of Sats[i]
 
+         tx = Tr;
          tx -= Pseudorange[i]/C_MPS;
+         index.push_back(i);
+         sats.push_back(Sats[i]);
+         times.push_back(tx);
+      }
+
+      // get ephemeris range, etc, for all satellites at once, then
+      // update transmit times and get ephemeris range again
+      for(int pass=0; pass<2; pass++) {
+         LOG(DEBUG) << " go to getXvts, pass " << pass+1;
          try {
-            LOG(DEBUG) << " go to getXvt with time " << printTime(tx,timfmt);
-            PVT = pEph->getXvt(Sats[i], tx);          // get ephemeris range, etc
-            LOG(DEBUG) << " returned from getXvt";
-         }
-         catch(InvalidRequest& e) {
-            LOG(DEBUG) << "Warning - PRSolution ignores satellite (no ephemeris) "
-               << RinexSatID(Sats[i]) << " at time " << printTime(tx,timfmt)
-               << " [" << e.getText() << "]";
-            Sats[i].id = -::abs(Sats[i].id);
-            ++noeph;
-            continue;
+            pEph->getXvts(sats, times, PVTs, valid);
          }
          catch(Exception& e) {
             LOG(DEBUG) << "Oops - Exception " << e.getText();
+            PVTs.resize(sats.size());
+            valid.assign(sats.size(), false);
          }
-
-         // update transmit time and get ephemeris range again
-         tx -= PVT.clkbias + PVT.relcorr;
-         try {
-            PVT = pEph->getXvt(Sats[i], tx);
-         }
-         catch(InvalidRequest& e) {                   // unnecessary....you'd think!
-            LOG(DEBUG) << "Warning - PRSolution ignores satellite (no ephemeris 2) "
-               << RinexSatID(Sats[i]) << " at time " << printTime(tx,timfmt)
-               << " [" << e.getText() << "]";
-            Sats[i].id = -::abs(Sats[i].id);
-            ++noeph;
-            continue;
+         LOG(DEBUG) << " returned from getXvts";
+
+         for(size_t k=0; k<sats.size(); k++) {
+            i = index[k];
+            if(Sats[i].id <= 0) continue;             // failed first pass
+            if(!valid[k]) {
+               LOG(DEBUG) << "Warning - PRSolution ignores satellite (no ephemeris"
+                  << (pass ? " 2) " : ") ")
+                  << RinexSatID(Sats[i]) << " at time " << printTime(times[k],timfmt);
+               Sats[i].id = -::abs(Sats[i].id);
+               ++noeph;
+               continue;
+            }
+            if(pass == 0)
+               times[k] -= PVTs[k].clkbias + PVTs[k].relcorr;
          }
+      }
+
+      for(size_t k=0; k<sats.size(); k++) {
+         i = index[k];
+         if(Sats[i].id <= 0) continue;
+         const Xvt& PVT(PVTs[k]);
 
          // SVP = {SV position at transmit time}, raw range + clk + rel
          for(j=0; j<3; j++) SVP(i,j) = PVT.x[j];
@@ -174,6 +185,117 @@ namespace gpstk
    } // end PreparePRPRSolution
 
 
+   // -------------------------------------------------------------------------
+   // Compute the partials matrix and the residuals (corrected pseudorange minus
+   // geometric range minus clock) of the unmarked satellites, at the solution Sol.
+   int PRSolution::LinearizeSolution(const CommonTime& T,
+                                     const vector<SatID>& Sats,
+                                     const Matrix<double>& SVP,
+                                     TropModel *pTropModel,
+                                     const vector<SatID::SatelliteSystem>& Syss,
+                                     const Vector<double>& Sol,
+                                     const bool iterated,
+                                     Matrix<double>& P,
+                                     Vector<double>& Resids,
+                                     bool& tropFlag)
+      throw(Exception)
+   {
+      int n;
+      size_t i, j;
+      double rho,wt,svxyz[3],CRange;
+      GPSEllipsoid ellip;
+      Triple dirCos;
+      Xvt SV,RX;
+
+      tropFlag = false;       // true means the trop corr was NOT applied
+
+      // position of the solution
+      RX.x = Triple(Sol(0),Sol(1),Sol(2));
+
+      // loop over satellites, computing partials matrix
+      for(n=0,i=0; i<Sats.size(); i++) {
+         // ignore marked satellites
+         if(Sats[i].id <= 0) continue;
+
+         // ------------ ephemeris
+         // rho is time of flight (sec)
+         if(!iterated)
+            rho = 0.070;             // initial guess: 70ms
+         else
+            rho = RSS(SVP(i,0)-Sol(0),
+                     SVP(i,1)-Sol(1), SVP(i,2)-Sol(2))/ellip.c();
+
+         // correct for earth rotation
+         wt = ellip.angVelocity()*rho;             // radians
+         svxyz[0] =  ::cos(wt)*SVP(i,0) + ::sin(wt)*SVP(i,1);
+         svxyz[1] = -::sin(wt)*SVP(i,0) + ::cos(wt)*SVP(i,1);
+         svxyz[2] = SVP(i,2);
+
+         // rho is now geometric range
+         rho = RSS(svxyz[0]-Sol(0),
+                   svxyz[1]-Sol(1),
+                   svxyz[2]-Sol(2));
+
+         // direction cosines
+         dirCos[0] = (Sol(0)-svxyz[0])/rho;
+         dirCos[1] = (Sol(1)-svxyz[1])/rho;
+         dirCos[2] = (Sol(2)-svxyz[2])/rho;
+
+         // ------------ data
+         // corrected pseudorange (m) minus geometric range
+         CRange = SVP(i,3) - rho;
+
+         // correct for troposphere and PCOs (but not on the first iteration)
+         if(iterated) {
+            SV.x = Triple(svxyz[0],svxyz[1],svxyz[2]);
+            Position R,S;
+            R.setECEF(RX.x[0],RX.x[1],RX.x[2]);
+            S.setECEF(SV.x[0],SV.x[1],SV.x[2]);
+
+            // trop
+            double tc(R.getHeight());  // tc is a dummy here
+            // must test R for reasonableness to avoid corrupting TropModel
+            if(R.elevation(S) < 0.0 || tc > 100000.0 || tc < -1000.0) {
+               tc = 0.0;
+               tropFlag = true;        // true means failed to apply trop corr
+            }
+            else
+               tc = pTropModel->correction(R,S,T);    // pTropModel not const
+
+            CRange -= tc;
+            LOG(DEBUG) << "Trop " << i << " " << Sats[i] << " "
+               << fixed << setprecision(3) << tc;
+
+         }  // end if iterated
+
+         // get the index, for this clock, in the solution vector
+         j = 3 + vectorindex(Syss, Sats[i].system); // Solution ~ X,Y,Z,clks
+
+         // find the clock for the sat's system
+         const double clk(Sol(j));
+         LOG(DEBUG) << "Clock is (" << j << ") " << clk;
+
+         // data vector: corrected range residual
+         Resids(n) = CRange - clk;
+
+         // ------------ least squares
+         // partials matrix
+         P(n,0) = dirCos[0];           // x direction cosine
+         P(n,1) = dirCos[1];           // y direction cosine
+         P(n,2) = dirCos[2];           // z direction cosine
+         P(n,j) = 1.0;                 // clock
+
+         // ------------ increment index
+         // n is index and number of good satellites - also used for Slope
+         n++;
+
+      }  // end loop over satellites
+
+      return n;
+
+   } // end PRSolution::LinearizeSolution
+
+
    // -------------------------------------------------------------------------
    // Compute a straightforward solution using all the unmarked data.
    // Call PreparePRSolution first.
@@ -208,8 +330,6 @@ namespace gpstk
 
       int iret(0),k,n;
       size_t i, j;
-      double rho,wt,svxyz[3];
-      GPSEllipsoid ellip;
 
       Valid = Mixed = false;
 
@@ -266,10 +386,8 @@ namespace gpstk
 
          // -----------------------------------------------------------
          // define for computation
-         Vector<double> CRange(Nsvs),dX(dim);
-         Matrix<double> P(Nsvs,dim,0.0),PT,G(dim,Nsvs),PG(Nsvs,Nsvs),Rotation;
-         Triple dirCos;
-         Xvt SV,RX;
+         Vector<double> dX(dim);
+         Matrix<double> P(Nsvs,dim,0.0),G(dim,Nsvs),PG(Nsvs,Nsvs),work,Rotation;
 
          Solution.resize(dim);
          Covariance.resize(dim,dim);
@@ -297,89 +415,9 @@ namespace gpstk
          // -----------------------------------------------------------
          // iteration loop
          do {
-            TropFlag = false;       // true means the trop corr was NOT applied
-
-            // current estimate of position solution
-            RX.x = Triple(Solution(0),Solution(1),Solution(2));
-
-            // loop over satellites, computing partials matrix
-            for(n=0,i=0; i<Sats.size(); i++) {
-               // ignore marked satellites
-               if(Sats[i].id <= 0) continue;
-
-               // ------------ ephemeris
-               // rho is time of flight (sec)
-               if(n_iterate == 0)
-                  rho = 0.070;             // initial guess: 70ms
-               else
-                  rho = RSS(SVP(i,0)-Solution(0),
-                           SVP(i,1)-Solution(1), SVP(i,2)-Solution(2))/ellip.c();
-
-               // correct for earth rotation
-               wt = ellip.angVelocity()*rho;             // radians
-               svxyz[0] =  ::cos(wt)*SVP(i,0) + ::sin(wt)*SVP(i,1);
-               svxyz[1] = -::sin(wt)*SVP(i,0) + ::cos(wt)*SVP(i,1);
-               svxyz[2] = SVP(i,2);
-
-               // rho is now geometric range
-               rho = RSS(svxyz[0]-Solution(0),
-                         svxyz[1]-Solution(1),
-                         svxyz[2]-Solution(2));
-
-               // direction cosines
-               dirCos[0] = (Solution(0)-svxyz[0])/rho;
-               dirCos[1] = (Solution(1)-svxyz[1])/rho;
-               dirCos[2] = (Solution(2)-svxyz[2])/rho;
-
-               // ------------ data
-               // corrected pseudorange (m) minus geometric range
-               CRange(n) = SVP(i,3) - rho;
-
-               // correct for troposphere and PCOs (but not on the first iteration)
-               if(n_iterate > 0) {
-                  SV.x = Triple(svxyz[0],svxyz[1],svxyz[2]);
-                  Position R,S;
-                  R.setECEF(RX.x[0],RX.x[1],RX.x[2]);
-                  S.setECEF(SV.x[0],SV.x[1],SV.x[2]);
-
-                  // trop
-                  double tc(R.getHeight());  // tc is a dummy here
-                  // must test R for reasonableness to avoid corrupting TropModel
-                  if(R.elevation(S) < 0.0 || tc > 100000.0 || tc < -1000.0) {
-                     tc = 0.0;
-                     TropFlag = true;        // true means failed to apply trop corr
-                  }
-                  else
-                     tc = pTropModel->correction(R,S,T);    // pTropModel not const
-
-                  CRange(n) -= tc;
-                  LOG(DEBUG) << "Trop " << i << " " << Sats[i] << " "
-                     << fixed << setprecision(3) << tc;
-
-               }  // end if n_iterate > 0
-
-               // get the index, for this clock, in the solution vector
-               j = 3 + vectorindex(mySyss, Sats[i].system); // Solution ~ X,Y,Z,clks
-
-               // find the clock for the sat's system
-               const double clk(Solution(j));
-               LOG(DEBUG) << "Clock is (" << j << ") " << clk;
-
-               // data vector: corrected range residual
-               Resids(n) = CRange(n) - clk;
-
-               // ------------ least squares
-               // partials matrix
-               P(n,0) = dirCos[0];           // x direction cosine
-               P(n,1) = dirCos[1];           // y direction cosine
-               P(n,2) = dirCos[2];           // z direction cosine
-               P(n,j) = 1.0;                 // clock
-
-               // ------------ increment index
-               // n is index and number of good satellites - also used for Slope
-               n++;
-
-            }  // end loop over satellites
+            // linearize at the current estimate of the solution
+            n = LinearizeSolution(T, Sats, SVP, pTropModel, mySyss, Solution,
+                                  n_iterate > 0, P, Resids, TropFlag);
 
             if(n != Nsvs) {
                Exception e("Counting error after satellite loop");
@@ -393,11 +431,10 @@ namespace gpstk
 
             // ------------------------------------------------------
             // compute information matrix (inverse covariance) and generalized inverse
-            PT = transpose(P);
-
+            // products are formed in place, without transpose(P) or temporaries
             // weight matrix = measurement covariance inverse
-            if(invMC.rows() > 0) Covariance = PT * iMC * P;
-            else                 Covariance = PT * P;
+            if(invMC.rows() > 0) normalInto(Covariance, P, iMC, work);
+            else                 normalInto(Covariance, P);
 
             // invert using SVD
             try {
@@ -408,11 +445,14 @@ namespace gpstk
                << ")\n" << fixed << setprecision(4) << Covariance;
 
             // generalized inverse
-            if(invMC.rows() > 0) G = Covariance * PT * iMC;
-            else                 G = Covariance * PT;
+            if(invMC.rows() > 0) {
+               multiplyTransposeInto(work, Covariance, P);
+               multiplyInto(G, work, iMC);
+            }
+            else multiplyTransposeInto(G, Covariance, P);
 
             // PG is used for Slope computation
-            PG = P * G;
+            multiplyInto(PG, P, G);
             LOG(DEBUG) << "PG (" << PG.rows() << "x" << PG.cols()
                << ")\n" << fixed << setprecision(4) << PG;
 
@@ -420,7 +460,7 @@ namespace gpstk
 
             // ------------------------------------------------------
             // compute solution
-            dX = G * Resids;
+            multiplyInto(dX, G, Resids);
             LOG(DEBUG) << "Computed dX(" << dX.size() << ")";
             Solution += dX;
 
@@ -488,6 +528,286 @@ namespace gpstk
    } // end PRSolution::SimplePRSolution
 
 
+   // -------------------------------------------------------------------------
+   // Screening of RAIM combinations: the measurements of all the good satellites
+   // are linearized once, and the normal equations of a combination are those of
+   // the full set less the rows of its rejected satellites (a rank-k downdate).
+   namespace {
+      class RAIMScreen
+      {
+      public:
+         // A is the (n x dim) partials, r the residuals, W the (n x n) weight
+         // matrix or empty for unit weights, and col the clock column of each
+         // satellite.
+         RAIMScreen(const Matrix<double>& A, const Vector<double>& r,
+                    const Matrix<double>& W, const vector<int>& col);
+
+         // Compute the RMS residual and the solution correction dx (dim, zero
+         // for the clocks of systems with no satellites left) of the linearized
+         // problem without the satellites excl. Return false if it is singular.
+         bool solve(const vector<int>& excl, double& rms, vector<double>& dx)
+            const;
+
+      private:
+         int n,dim;
+         vector<double> A,r,W,WA,Wr;   // row major; WA = W*A, Wr = W*r
+         vector<double> N,b;           // normal equations A'WA, A'Wr
+         vector<double> M,c;           // A'A, A'r and r'r, for the
+         double s;                     //  (unweighted) RMS residual
+         vector<int> col,count;        // clock column and sats per column
+      };
+
+      RAIMScreen::RAIMScreen(const Matrix<double>& AA, const Vector<double>& rr,
+                             const Matrix<double>& WW, const vector<int>& cc)
+         : n(AA.rows()), dim(AA.cols()), A(n*dim), r(n), WA(n*dim), Wr(n),
+           N(dim*dim,0.0), b(dim,0.0), M(dim*dim,0.0), c(dim,0.0), s(0.0),
+           col(cc), count(dim,0)
+      {
+         int i,j,k,l;
+         for(i=0; i<n; i++) {
+            r[i] = rr(i);
+            count[col[i]]++;
+            for(k=0; k<dim; k++) A[i*dim+k] = AA(i,k);
+         }
+
+         if(WW.rows() > 0) {
+            W.resize(n*n);
+            for(i=0; i<n; i++) {
+               for(j=0; j<n; j++) W[i*n+j] = WW(i,j);
+               for(k=0; k<dim; k++) {
+                  double sum(0.0);
+                  for(j=0; j<n; j++) sum += W[i*n+j]*A[j*dim+k];
+                  WA[i*dim+k] = sum;
+               }
+               double sum(0.0);
+               for(j=0; j<n; j++) sum += W[i*n+j]*r[j];
+               Wr[i] = sum;
+            }
+         }
+         else {
+            WA = A;
+            Wr = r;
+         }
+
+         for(i=0; i<n; i++) {
+            const double *Ai(&A[i*dim]), *WAi(&WA[i*dim]);
+            for(k=0; k<dim; k++) {
+               b[k] += Ai[k]*Wr[i];
+               c[k] += Ai[k]*r[i];
+               for(l=0; l<dim; l++) {
+                  N[k*dim+l] += Ai[k]*WAi[l];
+                  M[k*dim+l] += Ai[k]*Ai[l];
+               }
+            }
+            s += r[i]*r[i];
+         }
+      }
+
+      bool RAIMScreen::solve(const vector<int>& excl, double& rms,
+                             vector<double>& dx) const
+      {
+         const int nx(excl.size());
+         int i,j,k,l,m;
+         vector<double> NS(N),bS(b),MS(M),cS(c);
+         double sS(s);
+         vector<int> cnt(count);
+
+         // remove the rows of the excluded satellites:
+         // A_S'W_SS A_S = A'WA - A_E'(WA)_E - (WA)_E'A_E + A_E'W_EE A_E
+         for(i=0; i<nx; i++) {
+            const int e(excl[i]);
+            const double *Ae(&A[e*dim]), *WAe(&WA[e*dim]);
+            cnt[col[e]]--;
+            sS -= r[e]*r[e];
+            for(k=0; k<dim; k++) {
+               bS[k] -= Ae[k]*Wr[e] + WAe[k]*r[e];
+               cS[k] -= Ae[k]*r[e];
+               for(l=0; l<dim; l++) {
+                  NS[k*dim+l] -= Ae[k]*WAe[l] + WAe[k]*Ae[l];
+                  MS[k*dim+l] -= Ae[k]*Ae[l];
+               }
+            }
+            for(j=0; j<nx; j++) {
+               const int f(excl[j]);
+               const double w(W.empty() ? (e == f ? 1.0 : 0.0) : W[e*n+f]);
+               if(w == 0.0) continue;
+               const double *Af(&A[f*dim]);
+               for(k=0; k<dim; k++) {
+                  bS[k] += w*Ae[k]*r[f];
+                  for(l=0; l<dim; l++) NS[k*dim+l] += w*Ae[k]*Af[l];
+               }
+            }
+         }
+
+         // the unknowns: position, and the clocks of systems with satellites left
+         vector<int> act;
+         for(k=0; k<dim; k++)
+            if(k < 3 || cnt[k] > 0) act.push_back(k);
+         m = act.size();
+
+         // solve by Cholesky decomposition, in place in L
+         vector<double> L(m*m),y(m);
+         for(k=0; k<m; k++) {
+            y[k] = bS[act[k]];
+            for(l=0; l<m; l++) L[k*m+l] = NS[act[k]*dim+act[l]];
+         }
+         for(k=0; k<m; k++) {
+            double d(L[k*m+k]);
+            for(j=0; j<k; j++) d -= L[k*m+j]*L[k*m+j];
+            if(d <= 1.e-10*NS[act[k]*dim+act[k]]) return false;
+            d = ::sqrt(d);
+            L[k*m+k] = d;
+            for(i=k+1; i<m; i++) {
+               double sum(L[i*m+k]);
+               for(j=0; j<k; j++) sum -= L[i*m+j]*L[k*m+j];
+               L[i*m+k] = sum/d;
+            }
+         }
+         for(k=0; k<m; k++) {
+            for(j=0; j<k; j++) y[k] -= L[k*m+j]*y[j];
+            y[k] /= L[k*m+k];
+         }
+         for(k=m-1; k>=0; k--) {
+            for(j=k+1; j<m; j++) y[k] -= L[j*m+k]*y[j];
+            y[k] /= L[k*m+k];
+         }
+
+         dx.assign(dim,0.0);
+         for(k=0; k<m; k++) dx[act[k]] = y[k];
+
+         // sum of squared residuals r_S - A_S dx
+         double ss(sS);
+         for(k=0; k<dim; k++) {
+            ss -= 2.0*dx[k]*cS[k];
+            for(l=0; l<dim; l++) ss += dx[k]*MS[k*dim+l]*dx[l];
+         }
+         rms = ::sqrt((ss > 0.0 ? ss : 0.0)/double(n-nx));
+
+         return true;
+      }
+   }  // end anonymous namespace
+
+
+   // -------------------------------------------------------------------------
+   // With FastRAIM, find the combinations of a RAIM stage that need a full
+   // solution: those that screening finds may have the smallest RMS residual,
+   // those it cannot screen, and the last one, which sets the return value.
+   void PRSolution::RAIMScreenStage(const CommonTime& T,
+                                    const vector<SatID>& Sats,
+                                    const vector<int>& GoodIndexes,
+                                    const Matrix<double>& SVP,
+                                    const Matrix<double>& invMC,
+                                    TropModel *pTropModel,
+                                    const vector<SatID::SatelliteSystem>& Syss,
+                                    const Vector<double>& Sol,
+                                    const int stage,
+                                    vector<bool>& Solve,
+                                    vector<double>& Bound)
+      throw(Exception)
+   {
+      const int N(GoodIndexes.size()), dim(3+Syss.size());
+      int i,j,k;
+
+      // clock column of each good satellite, and number of satellites per column
+      vector<int> col(N), count(dim,0);
+      for(i=0; i<N; i++) {
+         col[i] = 3 + vectorindex(Syss, Sats[GoodIndexes[i]].system);
+         count[col[i]]++;
+      }
+
+      Matrix<double> W;
+      if(invMC.rows() > 0) {
+         W = Matrix<double>(N,N);
+         for(i=0; i<N; i++)
+            for(j=0; j<N; j++)
+               W(i,j) = invMC(GoodIndexes[i],GoodIndexes[j]);
+      }
+
+      // list the combinations, through the first one that has too few satellites
+      // for a solution; there SimplePRSolution() returns -3 and the loop ends.
+      vector< vector<int> > Excl;
+      bool tooFew(false);
+      Combinations Combo(N,stage);
+      do {
+         vector<int> excl, cnt(count);
+         for(i=0; i<N; i++) {
+            if(Combo.isSelected(i)) {
+               excl.push_back(i);
+               cnt[col[i]]--;
+            }
+         }
+         Excl.push_back(excl);
+
+         int nsys(0);
+         for(k=3; k<dim; k++) if(cnt[k] > 0) nsys++;
+         if(N-stage < 3+nsys) { tooFew = true; break; }
+
+      } while(Combo.Next() != -1);
+
+      const int ncombo(Excl.size()), nscreen(tooFew ? ncombo-1 : ncombo);
+      Solve = vector<bool>(ncombo,false);
+      Solve[ncombo-1] = true;
+      Bound = vector<double>(ncombo,-1.0);
+
+      // screen about the all-satellite solution, then about the best screened
+      // solution until that moves less than a meter; there the linearization is
+      // good for the likely winners
+      Vector<double> X(Sol);
+      vector<double> rms(nscreen),step(nscreen),dx,bestdx;
+      vector<bool> ok(nscreen,false);
+      int best(-1);
+      for(int pass=0; pass<5; pass++) {
+         Matrix<double> P(N,dim,0.0);
+         Vector<double> R(N);
+         bool tflag;
+         if(LinearizeSolution(T, Sats, SVP, pTropModel, Syss, X, true, P, R, tflag)
+               != N) {
+            Exception e("Counting error in RAIM screening");
+            GPSTK_THROW(e);
+         }
+
+         RAIMScreen screen(P,R,W,col);
+         best = -1;
+         for(j=0; j<nscreen; j++) {
+            ok[j] = screen.solve(Excl[j], rms[j], dx);
+            if(!ok[j]) continue;
+            step[j] = RSS(dx[0],dx[1],dx[2]);
+            if(best == -1 || rms[j] < rms[best]) {
+               best = j;
+               bestdx = dx;
+            }
+         }
+         if(best == -1 || step[best] < 1.0) break;
+
+         for(k=0; k<dim; k++) X(k) += bestdx[k];
+      }
+
+      // the error of a screened RMS grows with the distance from X, through the
+      // curvature of the ranges and the trop (bounded here by 1cm per meter)
+      double minRMS(-1.0);
+      for(j=0; j<nscreen; j++) {
+         if(!ok[j]) continue;
+         double err(0.01*step[j] + step[j]*step[j]/1.e7);
+         if(minRMS < 0.0 || rms[j]+err < minRMS) minRMS = rms[j]+err;
+      }
+
+      int nsolve(1);
+      for(j=0; j<nscreen; j++) {
+         double err(ok[j] ? 0.01*step[j] + step[j]*step[j]/1.e7 : 0.0);
+         if(!ok[j] || rms[j]-err <= 1.01*minRMS + 0.05) {
+            Solve[j] = true;
+            if(j < ncombo-1) nsolve++;
+         }
+         else
+            Bound[j] = rms[j]-err;
+      }
+
+      LOG(DEBUG) << " RAIM: screening stage " << stage << " solves " << nsolve
+                 << " of " << ncombo << " combinations";
+
+   }  // end PRSolution::RAIMScreenStage
+
+
    // -------------------------------------------------------------------------
    // Compute a solution using RAIM.
    int PRSolution::RAIMCompute(const CommonTime& Tr,
@@ -514,6 +834,9 @@ namespace gpstk
          vector<SatID> BestSats,SaveSats;
          Matrix<double> SVP,BestCov,BestInvMCov,BestPartials;
          vector<SatID::SatelliteSystem> BestSyss;
+         // the all-satellite solution, about which FastRAIM screens later stages
+         Vector<double> BaseSol;
+         vector<SatID::SatelliteSystem> BaseSyss;
 
          // initialize
          Valid = false;
@@ -578,13 +901,43 @@ namespace gpstk
 
          // stage is the number of satellites to reject.
          int stage(0);
+         // with FastRAIM, false while a stage is done again without screening
+         bool screen(true);
 
          do {
+            // with FastRAIM, solve only the combinations chosen by screening
+            vector<bool> Solve;
+            vector<double> Bound;
+            if(screen && stage > 0 && BaseSol.size() > 0)
+               RAIMScreenStage(Tr, SaveSats, GoodIndexes, SVP, invMC, pTropModel,
+                               BaseSyss, BaseSol, stage, Solve, Bound);
+            screen = true;
+
+            // save the 'best' solution of the earlier stages, in case screening
+            // does not hold and this stage must be done again without it
+            bool SaveTropFlag(BestTropFlag);
+            int SaveNIter(BestNIter),SaveIret(BestIret);
+            double SaveRMS(BestRMS),SaveSL(BestSL),SaveConv(BestConv);
+            Vector<double> SaveSol,SavePFR;
+            vector<SatID> SaveBestSats;
+            Matrix<double> SaveCov,SaveInvMCov,SavePartials;
+            vector<SatID::SatelliteSystem> SaveSyss;
+            if(Solve.size() > 0) {
+               SaveSol = BestSol; SavePFR = BestPFR; SaveBestSats = BestSats;
+               SaveCov = BestCov; SaveInvMCov = BestInvMCov;
+               SavePartials = BestPartials; SaveSyss = BestSyss;
+            }
+
             // compute all the combinations of N satellites taken stage at a time
             Combinations Combo(N,stage);
+            size_t ncombo(0);
 
             // compute a solution for each combination of marked satellites
             do {
+               // skip the combinations that screening leaves out
+               if(ncombo < Solve.size() && !Solve[ncombo++])
+                  continue;
+
                // Mark the satellites for this combination
                Sats = SaveSats;
                for(i=0; i<GoodIndexes.size(); i++)
@@ -669,6 +1022,34 @@ namespace gpstk
 
             } while(Combo.Next() != -1);  // get the next combinations and repeat
 
+            // screening holds if the best solution is below the lower bound of
+            // every combination it skipped; if not, e.g. when the screened winner
+            // failed to converge, restore the earlier best and do the stage again
+            for(j=0; j<Solve.size(); j++) {
+               if(!Solve[j] && !(BestRMS >= 0.0 && BestRMS < Bound[j])) {
+                  screen = false;
+                  break;
+               }
+            }
+            if(!screen) {
+               LOG(DEBUG) << " RAIM: screening fails at stage " << stage
+                          << "; solve every combination";
+               BestTropFlag = SaveTropFlag;
+               BestNIter = SaveNIter;
+               BestIret = SaveIret;
+               BestRMS = SaveRMS;
+               BestSL = SaveSL;
+               BestConv = SaveConv;
+               BestSol = SaveSol;
+               BestPFR = SavePFR;
+               BestSats = SaveBestSats;
+               BestCov = SaveCov;
+               BestInvMCov = SaveInvMCov;
+               BestPartials = SavePartials;
+               BestSyss = SaveSyss;
+               continue;
+            }
+
             // end of the stage
             if(BestRMS > 0.0 && BestRMS < RMSLimit) {          // success
                LOG(DEBUG) << " RAIM: Success in the RAIM loop";
@@ -676,6 +1057,12 @@ namespace gpstk
                break;
             }
 
+            // keep the all-satellite solution for screening
+            if(FastRAIM && stage == 0 && iret == 0) {
+               BaseSol = Solution;
+               BaseSyss = SystemIDs;
+            }
+
             // go to next stage
             stage++;
 
@@ -788,7 +1175,8 @@ namespace gpstk
    int PRSolution::DOPCompute(void) throw(Exception)
    {
       try {
-         Matrix<double> PTP(transpose(Partials)*Partials);
+         Matrix<double> PTP;
+         normalInto(PTP, Partials);
          Matrix<double> Cov(inverseLUD(PTP));
          PDOP = SQRT(Cov(0,0)+Cov(1,1)+Cov(2,2));
          TDOP = 0.0;
@@ -950,6 +1338,7 @@ namespace gpstk
          << "\n   RMS residual limit " << fixed << RMSLimit
          << "\n   RAIM slope limit " << fixed << SlopeLimit << " meters"
          << "\n   Maximum number of satellites to reject is " << NSatsReject
+         << "\n   Fast RAIM screening IS " << (FastRAIM ? "":"NOT ") << "used"
          << "\n   Memory information IS " << (hasMemory ? "":"NOT ") << "stored"
          ;
 
@@ -361,6 +361,7 @@ namespace gpstk
                              NSatsReject(-1),
                              MaxNIterations(10),
                              ConvergenceLimit(3.e-7),
+                             FastRAIM(false),
                              hasMemory(true),
                              Valid(false)
          {}
@@ -389,6 +390,25 @@ namespace gpstk
       /// solution exceeds this.
       double ConvergenceLimit;
 
+      /// If true, RAIMCompute() screens the combinations of each stage after the
+      /// first, instead of computing a full solution for every one of them. The
+      /// measurements of all the good satellites are linearized once, about the
+      /// all-satellite solution, and the normal equations of each combination are
+      /// formed from the full ones by removing the rows of the rejected satellites.
+      /// Only the combinations whose approximate RMS residual is within 1% + 5cm
+      /// of the smallest, those that cannot be screened, and the last one are then
+      /// solved in full, in the usual order.
+      /// The approximate RMS is given a margin for the linearization error of
+      /// 1cm per meter of step plus step^2/1e7 m; this margin is empirical, set
+      /// by comparison with the exhaustive search over random geometries and
+      /// blunders, not derived. If the best full solution of a stage is not below
+      /// the lower bound (RMS - margin) of every combination that was skipped,
+      /// e.g. because the screened winner fails to converge, the stage is redone
+      /// without screening. So the selected solution and the return value are
+      /// those of the exhaustive search whenever the margin holds, but that is
+      /// not guaranteed; hence the default is false, the exhaustive search.
+      bool FastRAIM;
+
       /// vector<SatID> containing the satellite systems included in the solution. 
       /// It should be defined before the first solution call; if it is empty at that
       /// time it will be determined by the input SatelliteIDs. It is used to
@@ -623,6 +643,40 @@ namespace gpstk
 
    private:
 
+      /// Compute the partials matrix P (dimensioned by the caller, and zero in
+      /// the clock columns) and the residuals Resids (corrected pseudorange minus
+      /// geometric range minus clock) of the unmarked satellites in Sats, at the
+      /// solution Sol ~ X,Y,Z,(clks ~ Syss). The trop correction is applied only if
+      /// iterated is true; tropFlag is set if it could not be applied.
+      /// @return the number of satellites used.
+      int LinearizeSolution(const CommonTime& Tr,
+                            const std::vector<SatID>& Sats,
+                            const Matrix<double>& SVP,
+                            TropModel *pTropModel,
+                            const std::vector<SatID::SatelliteSystem>& Syss,
+                            const Vector<double>& Sol,
+                            const bool iterated,
+                            Matrix<double>& P,
+                            Vector<double>& Resids,
+                            bool& tropFlag) throw(Exception);
+
+      /// Screen the combinations of one RAIM stage (see FastRAIM), given the
+      /// all-satellite solution Sol ~ X,Y,Z,(clks ~ Syss). On output Solve has one
+      /// element per combination, through the last one the RAIM loop will reach,
+      /// and is true for those that need a full solution; Bound has the lower
+      /// bound on the RMS residual of each skipped combination.
+      void RAIMScreenStage(const CommonTime& Tr,
+                           const std::vector<SatID>& Sats,
+                           const std::vector<int>& GoodIndexes,
+                           const Matrix<double>& SVP,
+                           const Matrix<double>& invMC,
+                           TropModel *pTropModel,
+                           const std::vector<SatID::SatelliteSystem>& Syss,
+                           const Vector<double>& Sol,
+                           const int stage,
+                           std::vector<bool>& Solve,
+                           std::vector<double>& Bound) throw(Exception);
+
       /// flag: output content is valid.
       bool Valid;
 
@@ -0,0 +1,75 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+#include "TickTime.hpp"
+
+namespace gpstk
+{
+   const int64_t TickTime::TICKS_PER_SEC;
+   const int64_t TickTime::TICKS_PER_MS;
+   const int64_t TickTime::TICKS_PER_DAY;
+   const long TickTime::EPOCH_JDAY;
+   const long TickTime::MAX_DAYS;
+   const int64_t TickTime::MIN_TICKS;
+   const int64_t TickTime::MAX_TICKS;
+
+   CommonTime TickTime::toCommonTime(const TimeSystem& ts) const
+   {
+      CommonTime ct;
+      if(ticks == MIN_TICKS)
+         ct = CommonTime::BEGINNING_OF_TIME;
+      else if(ticks == MAX_TICKS)
+         ct = CommonTime::END_OF_TIME;
+      else {
+            // floor division, so the tick of day is not negative
+         int64_t dday(ticks / TICKS_PER_DAY);
+         int64_t tod(ticks % TICKS_PER_DAY);
+         if(tod < 0) { tod += TICKS_PER_DAY; --dday; }
+         ct.setInternal(EPOCH_JDAY + static_cast<long>(dday),
+                        static_cast<long>(tod / TICKS_PER_MS),
+                        static_cast<double>(tod % TICKS_PER_MS) * 1.e-9);
+      }
+      ct.setTimeSystem(ts);
+      return ct;
+   }
+
+   std::ostream& operator<<(std::ostream& s, const TickTime& t)
+   {
+      s << t.getTicks();
+      return s;
+   }
+
+}  // namespace gpstk
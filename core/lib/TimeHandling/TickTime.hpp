@@ -0,0 +1,211 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+#ifndef GPSTK_TICKTIME_HPP
+#define GPSTK_TICKTIME_HPP
+
+#include <cstddef>
+#include <cmath>
+#include <iostream>
+#include <stdint.h>
+#include "CommonTime.hpp"
+
+namespace gpstk
+{
+      /// @ingroup TimeHandling
+      //@{
+
+      /**
+       * A CommonTime as a single signed 64-bit count of nanoseconds
+       * from 2000-01-01 00:00 (CommonTime day 2451545). Comparisons,
+       * differences and hashing are single integer operations, which
+       * makes TickTime a cheap key for the sorted tables and maps of
+       * stores that hold many epochs.
+       *
+       * The conversion from CommonTime rounds to the nearest
+       * nanosecond and does not keep the time system; callers must
+       * keep times of different systems apart. The rounding preserves
+       * order: if TickTime(a) < TickTime(b) then a < b, while equal
+       * TickTimes may come from CommonTimes that differ by less than a
+       * nanosecond, so code that needs the exact CommonTime order
+       * must resolve ties with CommonTime.
+       *
+       * The range is about 292 years either side of J2000. Times
+       * outside it, such as CommonTime::BEGINNING_OF_TIME and
+       * END_OF_TIME, saturate to TickTime::MIN_TICKS and MAX_TICKS,
+       * which convert back to BEGINNING_OF_TIME and END_OF_TIME.
+       *
+       * OrbitEphStore keys its frozen index on TickTime. The
+       * Procframe containers still key on CommonTime: gnssDataMap
+       * derives publicly from std::multimap<CommonTime, sourceDataMap>
+       * and epochSatTypeValueMap is a public typedef, so callers insert
+       * and iterate them directly and a TickTime index could not be
+       * kept in step with them.
+       *
+       * All members except toCommonTime() are inline. (They are not
+       * constexpr because the library is built as C++03.)
+       */
+   class TickTime
+   {
+   public:
+         /// Ticks per second
+      static const int64_t TICKS_PER_SEC = 1000000000LL;
+
+         /// Ticks per millisecond
+      static const int64_t TICKS_PER_MS = 1000000LL;
+
+         /// Ticks per day
+      static const int64_t TICKS_PER_DAY = 86400000000000LL;
+
+         /// CommonTime day of tick zero
+      static const long EPOCH_JDAY = 2451545L;
+
+         /// Largest number of days either side of EPOCH_JDAY
+      static const long MAX_DAYS = 106750L;
+
+         /// Tick count of times at or before the range
+      static const int64_t MIN_TICKS = -0x7fffffffffffffffLL - 1;
+
+         /// Tick count of times at or after the range
+      static const int64_t MAX_TICKS = 0x7fffffffffffffffLL;
+
+         /// Default constructor, tick zero.
+      TickTime() throw()
+            : ticks(0)
+      {}
+
+         /// Convert from CommonTime, rounding to the nearest tick.
+      explicit TickTime(const CommonTime& t) throw()
+            : ticks(toTicks(t))
+      {}
+
+         /// Construct from a tick count.
+      static TickTime fromTicks(int64_t count) throw()
+      { TickTime tt; tt.ticks = count; return tt; }
+
+         /// Return the tick count.
+      int64_t getTicks() const throw()
+      { return ticks; }
+
+         /// True if this time is outside the range of TickTime.
+      bool isSaturated() const throw()
+      { return ticks == MIN_TICKS || ticks == MAX_TICKS; }
+
+         /** Convert to CommonTime in the given time system. Saturated
+          * times give BEGINNING_OF_TIME or END_OF_TIME. */
+      CommonTime toCommonTime(const TimeSystem& ts = TimeSystem::Unknown)
+         const;
+
+         /** Return the tick count of t, rounded to the nearest
+          * nanosecond, or MIN_TICKS or MAX_TICKS if t is outside the
+          * range. */
+      static int64_t toTicks(const CommonTime& t) throw()
+      {
+         long day, msod;
+         double fsod;
+         t.getInternal(day, msod, fsod);
+         long dday(day - EPOCH_JDAY);
+         if(dday < -MAX_DAYS) return MIN_TICKS;
+         if(dday > MAX_DAYS) return MAX_TICKS;
+         return static_cast<int64_t>(dday) * TICKS_PER_DAY
+              + static_cast<int64_t>(msod) * TICKS_PER_MS
+              + static_cast<int64_t>(std::floor(fsod * 1.e9 + 0.5));
+      }
+
+         /** Difference in seconds. Exact for differences under about
+          * 104 days, when the tick count fits a double. */
+      double operator-(const TickTime& right) const throw()
+      { return static_cast<double>(ticks - right.ticks) * 1.e-9; }
+
+         /// Add seconds, rounded to the nearest tick.
+      TickTime& operator+=(double seconds) throw()
+      { return addTicks(static_cast<int64_t>(std::floor(seconds*1.e9 + 0.5))); }
+
+         /// Subtract seconds, rounded to the nearest tick.
+      TickTime& operator-=(double seconds) throw()
+      { return operator+=(-seconds); }
+
+      TickTime operator+(double seconds) const throw()
+      { return TickTime(*this) += seconds; }
+
+      TickTime operator-(double seconds) const throw()
+      { return TickTime(*this) -= seconds; }
+
+         /// Add a number of ticks. Saturated times are not changed.
+      TickTime& addTicks(int64_t count) throw()
+      { if(!isSaturated()) ticks += count; return *this; }
+
+      bool operator==(const TickTime& right) const throw()
+      { return ticks == right.ticks; }
+      bool operator!=(const TickTime& right) const throw()
+      { return ticks != right.ticks; }
+      bool operator<(const TickTime& right) const throw()
+      { return ticks < right.ticks; }
+      bool operator>(const TickTime& right) const throw()
+      { return ticks > right.ticks; }
+      bool operator<=(const TickTime& right) const throw()
+      { return ticks <= right.ticks; }
+      bool operator>=(const TickTime& right) const throw()
+      { return ticks >= right.ticks; }
+
+         /// Hash of the tick count, for unordered containers.
+      std::size_t hash() const throw()
+      {
+         uint64_t h(static_cast<uint64_t>(ticks));
+         h ^= h >> 33;
+         h *= 0xff51afd7ed558ccdULL;
+         h ^= h >> 33;
+         return static_cast<std::size_t>(h);
+      }
+
+   private:
+      int64_t ticks;    ///< nanoseconds since the start of day EPOCH_JDAY
+   };
+
+      /// Hash function object for TickTime, for unordered containers.
+   struct TickTimeHash
+   {
+      std::size_t operator()(const TickTime& t) const throw()
+      { return t.hash(); }
+   };
+
+   std::ostream& operator<<(std::ostream& s, const TickTime& t);
+
+      //@}
+
+}  // namespace gpstk
+
+#endif // GPSTK_TICKTIME_HPP
@@ -68,5 +68,214 @@ namespace gpstk
 
       // CRC-32: 32 26 23 22 16 12 11 10 8 7 5 4 2 +1
       // 0000 0100 1100 0001 0001 1101 1011 0101 : 04c11db5
+
+
+         // Tables for the predefined parameters.  They are built after
+         // the parameters above, and before that their zero order
+         // matches no parameters, so computeCRC() is safe to call
+         // during static initialization.
+      static const CRCTable crcTableCRC32(CRC32);
+      static const CRCTable crcTableCRC16(CRC16);
+      static const CRCTable crcTableCCITT(CRCCCITT);
+      static const CRCTable crcTableCRC24Q(CRC24Q);
+
+
+         // Mask of the lower 'order' bits
+      static uint32_t orderMask(int order)
+      {
+         return ((((uint32_t)1 << (order - 1)) - 1) << 1) | 1;
+      }
+
+
+      CRCTable :: CRCTable(const CRCParam& params)
+            : order(params.order), refin(params.refin)
+      {
+         if ((order < 1) || (order > 32))
+         {
+            CRCException exc("CRC order must be from 1 to 32");
+            GPSTK_THROW(exc);
+         }
+
+         polynom = params.polynom & orderMask(order);
+
+            // Reflected registers shift right, others shift left with
+            // the CRC in the high bits.
+         uint32_t rpoly = reflect(polynom, order);
+         uint32_t lpoly = polynom << (32 - order);
+         for (unsigned i = 0; i < 256; i++)
+         {
+            uint32_t reg;
+            if (refin)
+            {
+               reg = i;
+               for (int j = 0; j < 8; j++)
+               {
+                  reg = (reg & 1) ? ((reg >> 1) ^ rpoly) : (reg >> 1);
+               }
+            }
+            else
+            {
+               reg = (uint32_t)i << 24;
+               for (int j = 0; j < 8; j++)
+               {
+                  reg = (reg & 0x80000000) ? ((reg << 1) ^ lpoly) : (reg << 1);
+               }
+            }
+            table[0][i] = reg;
+         }
+
+         for (int k = 1; k < 8; k++)
+         {
+            for (unsigned i = 0; i < 256; i++)
+            {
+               uint32_t reg = table[k-1][i];
+               if (refin)
+               {
+                  table[k][i] = (reg >> 8) ^ table[0][reg & 0xff];
+               }
+               else
+               {
+                  table[k][i] = (reg << 8) ^ table[0][reg >> 24];
+               }
+            }
+         }
+      }
+
+
+      bool CRCTable :: matches(const CRCParam& params) const
+      {
+         return ((params.order == order) &&
+                 (params.refin == refin) &&
+                 (order > 0) &&
+                 ((params.polynom & orderMask(order)) == polynom));
+      }
+
+
+      uint32_t CRCTable :: update(uint32_t reg,
+                                  const unsigned char *data,
+                                  unsigned long len) const
+      {
+         const unsigned char *end8 = data + (len & ~7UL);
+         if (refin)
+         {
+            while (data != end8)
+            {
+               uint32_t lo = reg ^ ((uint32_t)data[0] |
+                                    ((uint32_t)data[1] << 8) |
+                                    ((uint32_t)data[2] << 16) |
+                                    ((uint32_t)data[3] << 24));
+               reg = table[7][lo & 0xff] ^ table[6][(lo >> 8) & 0xff] ^
+                  table[5][(lo >> 16) & 0xff] ^ table[4][lo >> 24] ^
+                  table[3][data[4]] ^ table[2][data[5]] ^
+                  table[1][data[6]] ^ table[0][data[7]];
+               data += 8;
+            }
+            for (len &= 7; len > 0; len--)
+            {
+               reg = (reg >> 8) ^ table[0][(reg ^ *data++) & 0xff];
+            }
+         }
+         else
+         {
+            while (data != end8)
+            {
+               uint32_t hi = reg ^ (((uint32_t)data[0] << 24) |
+                                    ((uint32_t)data[1] << 16) |
+                                    ((uint32_t)data[2] << 8) |
+                                    (uint32_t)data[3]);
+               reg = table[7][hi >> 24] ^ table[6][(hi >> 16) & 0xff] ^
+                  table[5][(hi >> 8) & 0xff] ^ table[4][hi & 0xff] ^
+                  table[3][data[4]] ^ table[2][data[5]] ^
+                  table[1][data[6]] ^ table[0][data[7]];
+               data += 8;
+            }
+            for (len &= 7; len > 0; len--)
+            {
+               reg = (reg << 8) ^ table[0][(reg >> 24) ^ *data++];
+            }
+         }
+         return reg;
+      }
+
+
+      uint32_t CRCTable :: compute(const unsigned char *data,
+                                   unsigned long len,
+                                   const CRCParam& params) const
+      {
+         uint32_t crcmask = orderMask(order);
+
+            // computeCRCBitwise() converts a direct initial value to a
+            // non-direct one bit by bit, shifting in any bits above the
+            // order, which is only undone by the final zero bits for
+            // odd polynomials.  Leave the other cases to it.
+         if (!matches(params) ||
+             ((params.initial & ~(unsigned long)crcmask) != 0) ||
+             (params.direct && (params.initial != 0) && !(polynom & 1)))
+         {
+            return computeCRCBitwise(data, len, params);
+         }
+
+            // The tables implement the direct algorithm; a non-direct
+            // initial value is first pushed through 'order' zero bits.
+         uint32_t crc = params.initial;
+         if (!params.direct)
+         {
+            uint32_t crchighbit = (uint32_t)1 << (order - 1);
+            for (int i = 0; i < order; i++)
+            {
+               uint32_t bit = crc & crchighbit;
+               crc = (crc << 1) & crcmask;
+               if (bit)
+               {
+                  crc ^= polynom;
+               }
+            }
+         }
+
+         if (refin)
+         {
+            crc = update(reflect(crc, order), data, len);
+            if (!params.refout)
+            {
+               crc = reflect(crc, order);
+            }
+         }
+         else
+         {
+            crc = update(crc << (32 - order), data, len) >> (32 - order);
+            if (params.refout)
+            {
+               crc = reflect(crc, order);
+            }
+         }
+         crc ^= params.final;
+         crc &= crcmask;
+
+         return crc;
+      }
+
+
+      uint32_t computeCRC(const unsigned char *data,
+                          unsigned long len,
+                          const CRCParam& params)
+      {
+         if (crcTableCRC32.matches(params))
+         {
+            return crcTableCRC32.compute(data, len, params);
+         }
+         if (crcTableCRC16.matches(params))
+         {
+            return crcTableCRC16.compute(data, len, params);
+         }
+         if (crcTableCCITT.matches(params))
+         {
+            return crcTableCCITT.compute(data, len, params);
+         }
+         if (crcTableCRC24Q.matches(params))
+         {
+            return crcTableCRC24Q.compute(data, len, params);
+         }
+         return computeCRCBitwise(data, len, params);
+      }
    }
 }
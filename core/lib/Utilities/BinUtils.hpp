@@ -309,18 +309,82 @@ namespace gpstk
          /// CRC-24Q parameters
       extern const CRCParam CRC24Q;
 
+         /**
+          * Look-up tables for computing CRCs of a given polynomial
+          * order, polynomial and input bit order, eight bytes at a
+          * time ("slicing-by-8").  Any initial value, final XOR value,
+          * direct or non-direct algorithm and output reflection may
+          * be used with the tables.
+          *
+          * Tables for the predefined parameters (CRCCCITT, CRC16,
+          * CRC32 and CRC24Q) are used by computeCRC(); build one of
+          * these for other parameters used repeatedly.
+          */
+      class CRCTable
+      {
+      public:
+            /** Build the tables for the order, polynomial and
+             * input reflection of \a params.
+             * @param[in] params CRC parameters, order 1 to 32. */
+         CRCTable(const CRCParam& params);
+
+            /// Whether these tables can compute CRCs with \a params.
+         bool matches(const CRCParam& params) const;
+
+            /**
+             * Compute CRC with the tables.  The result is the same
+             * as that of computeCRCBitwise() for any parameters.
+             * @param[in] data data to process CRC on.
+             * @param[in] len length of data to process (in bytes).
+             * @param[in] params see documentation of CRCParam
+             * @return the CRC value
+             */
+         uint32_t compute(const unsigned char *data,
+                          unsigned long len,
+                          const CRCParam& params) const;
+
+      private:
+            /** Process \a data into a CRC register.  Reflected
+             * registers hold the CRC in the low bits, others in the
+             * high bits. */
+         uint32_t update(uint32_t reg,
+                         const unsigned char *data,
+                         unsigned long len) const;
+
+         int order;              ///< CRC polynomial order.
+         uint32_t polynom;       ///< CRC polynomial w/o the leading '1' bit.
+         bool refin;             ///< reflect the data bytes before processing.
+            /// table[k][b] is the register after byte b followed by k
+            /// zero bytes.
+         uint32_t table[8][256];
+      };
+
+         /**
+          * Compute CRC (suitable for polynomial orders from 1 to 32).
+          * Uses the precomputed CRCTable of the predefined
+          * parameters with the same order, polynomial and input
+          * reflection, if any, and computeCRCBitwise() otherwise.
+          * @param[in] data data to process CRC on.
+          * @param[in] len length of data to process (in bytes).
+          * @param[in] params see documentation of CRCParam
+          * @return the CRC value
+          */
+      uint32_t computeCRC(const unsigned char *data,
+                          unsigned long len,
+                          const CRCParam& params);
+
          /**
           * Compute CRC (suitable for polynomial orders from 1 to 32).
           * Does bit-by-bit computation (brute-force, no look-up
           * tables).
           * @param[in] data data to process CRC on.
           * @param[in] len length of data to process (in bytes).
-          * @param[in] params see documentation of CRCParam:w
+          * @param[in] params see documentation of CRCParam
           * @return the CRC value
           */
-      inline uint32_t computeCRC(const unsigned char *data,
-                                 unsigned long len,
-                                 const CRCParam& params);
+      inline uint32_t computeCRCBitwise(const unsigned char *data,
+                                        unsigned long len,
+                                        const CRCParam& params);
 
          /**
           * Calculate an Exclusive-OR Checksum on the string \a str.
@@ -472,9 +536,9 @@ namespace gpstk
          // This code "stolen" from Sven Reifegerste (zorci@gmx.de).
          // Found at http://rcswww.urz.tu-dresden.de/~sr21/crctester.c
          // from link at http://rcswww.urz.tu-dresden.de/~sr21/crc.html
-      inline uint32_t computeCRC(const unsigned char *data,
-                                 unsigned long len,
-                                 const CRCParam& params)
+      inline uint32_t computeCRCBitwise(const unsigned char *data,
+                                        unsigned long len,
+                                        const CRCParam& params)
       {
          uint32_t i, j, c, bit;
          uint32_t crc = params.initial;
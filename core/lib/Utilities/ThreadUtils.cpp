@@ -0,0 +1,147 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+
+/**
+ * @file ThreadUtils.cpp
+ * Minimal mutex, condition and worker thread wrappers.
+ */
+
+#include "ThreadUtils.hpp"
+
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+namespace gpstk
+{
+   unsigned numProcessors()
+   {
+#if !defined(_WIN32) && defined(_SC_NPROCESSORS_ONLN)
+      long n = sysconf(_SC_NPROCESSORS_ONLN);
+      if (n > 0)
+         return (unsigned)n;
+#endif
+      return 1;
+   }
+
+#ifndef _WIN32
+
+   Mutex::Mutex()
+   { pthread_mutex_init(&mutex, NULL); }
+
+   Mutex::~Mutex()
+   { pthread_mutex_destroy(&mutex); }
+
+   void Mutex::lock()
+   { pthread_mutex_lock(&mutex); }
+
+   void Mutex::unlock()
+   { pthread_mutex_unlock(&mutex); }
+
+   Condition::Condition()
+   { pthread_cond_init(&cond, NULL); }
+
+   Condition::~Condition()
+   { pthread_cond_destroy(&cond); }
+
+   void Condition::wait(Mutex& m)
+   { pthread_cond_wait(&cond, &m.mutex); }
+
+   void Condition::signal()
+   { pthread_cond_signal(&cond); }
+
+   void Condition::broadcast()
+   { pthread_cond_broadcast(&cond); }
+
+      // pthread_create() wants a function returning void*
+   struct ThreadStart
+   {
+      ThreadGroup::Function func;
+      void *arg;
+   };
+
+   static void *threadMain(void *p)
+   {
+      ThreadStart ts = *static_cast<ThreadStart*>(p);
+      delete static_cast<ThreadStart*>(p);
+      ts.func(ts.arg);
+      return NULL;
+   }
+
+   bool ThreadGroup::start(Function func, void *arg)
+   {
+      ThreadStart *ts = new ThreadStart;
+      ts->func = func;
+      ts->arg = arg;
+      pthread_t thread;
+      if (pthread_create(&thread, NULL, threadMain, ts) != 0)
+      {
+         delete ts;
+         return false;
+      }
+      threads.push_back(thread);
+      return true;
+   }
+
+   void ThreadGroup::join()
+   {
+      for (unsigned i = 0; i < threads.size(); i++)
+         pthread_join(threads[i], NULL);
+      threads.clear();
+   }
+
+#else // _WIN32: no threads, see the threadgroup documentation
+
+   Mutex::Mutex() {}
+   Mutex::~Mutex() {}
+   void Mutex::lock() {}
+   void Mutex::unlock() {}
+
+   Condition::Condition() {}
+   Condition::~Condition() {}
+   void Condition::wait(Mutex& m) {}
+   void Condition::signal() {}
+   void Condition::broadcast() {}
+
+   bool ThreadGroup::start(Function func, void *arg)
+   { return false; }
+
+   void ThreadGroup::join() {}
+
+#endif
+
+} // namespace gpstk
@@ -0,0 +1,159 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+
+/**
+ * @file ThreadUtils.hpp
+ * Minimal mutex, condition and worker thread wrappers.
+ */
+
+#ifndef GPSTK_THREADUTILS_HPP
+#define GPSTK_THREADUTILS_HPP
+
+#include <vector>
+
+#ifndef _WIN32
+#include <pthread.h>
+#endif
+
+namespace gpstk
+{
+      /** @defgroup threadgroup Thread Support
+       *
+       * Thin wrappers around POSIX threads used by the library's
+       * parallel readers and processors.  When POSIX threads are not
+       * available the mutex and condition classes do nothing and
+       * ThreadGroup::start() fails, so that callers fall back to
+       * doing the work on the calling thread. */
+      //@{
+
+      /// Return the number of processors available, at least 1.
+   unsigned numProcessors();
+
+      /// Non-recursive mutual exclusion lock.
+   class Mutex
+   {
+   public:
+      Mutex();
+      ~Mutex();
+      void lock();
+      void unlock();
+   private:
+      friend class Condition;
+#ifndef _WIN32
+      pthread_mutex_t mutex;
+#endif
+         // not copyable
+      Mutex(const Mutex&);
+      Mutex& operator=(const Mutex&);
+   };
+
+      /// Hold a Mutex for the lifetime of this object.
+   class MutexLock
+   {
+   public:
+      explicit MutexLock(Mutex& m) : mutex(m)
+      { mutex.lock(); }
+      ~MutexLock()
+      { mutex.unlock(); }
+   private:
+      Mutex& mutex;
+      MutexLock(const MutexLock&);
+      MutexLock& operator=(const MutexLock&);
+   };
+
+      /// Condition variable used with a Mutex.
+   class Condition
+   {
+   public:
+      Condition();
+      ~Condition();
+         /** Atomically release \a m and wait to be signalled, then
+          * reacquire \a m.  Spurious wake-ups are possible, so the
+          * caller must re-test its predicate. */
+      void wait(Mutex& m);
+         /// Wake one waiting thread.
+      void signal();
+         /// Wake all waiting threads.
+      void broadcast();
+   private:
+#ifndef _WIN32
+      pthread_cond_t cond;
+#endif
+      Condition(const Condition&);
+      Condition& operator=(const Condition&);
+   };
+
+      /** A set of threads all running the same function, each with
+       * its own argument.  The destructor joins any threads that
+       * are still running. */
+   class ThreadGroup
+   {
+   public:
+         /// Function run by each thread.
+      typedef void (*Function)(void *arg);
+
+      ThreadGroup() {}
+      ~ThreadGroup()
+      { join(); }
+
+         /** Start one thread running \a func(\a arg).
+          * @return false if the thread could not be created, in
+          *   which case the caller must do the work itself. */
+      bool start(Function func, void *arg);
+
+         /// Wait for all started threads to finish.
+      void join();
+
+         /// Number of threads started and not yet joined.
+      unsigned size() const
+      { return threads.size(); }
+
+   private:
+#ifndef _WIN32
+      std::vector<pthread_t> threads;
+#else
+      std::vector<int> threads;
+#endif
+      ThreadGroup(const ThreadGroup&);
+      ThreadGroup& operator=(const ThreadGroup&);
+   };
+
+      //@}
+
+} // namespace gpstk
+
+#endif
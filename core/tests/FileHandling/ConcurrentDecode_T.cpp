@@ -0,0 +1,339 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+
+   /* Decode many files at once on several threads and check that
+    * each result is identical to decoding the file alone, i.e. that
+    * the record readers keep no state outside their stream. */
+
+#include "Rinex3ObsStream.hpp"
+#include "Rinex3ObsHeader.hpp"
+#include "Rinex3ObsData.hpp"
+#include "RinexObsStream.hpp"
+#include "RinexObsHeader.hpp"
+#include "RinexObsData.hpp"
+#include "RinexNavStream.hpp"
+#include "RinexNavHeader.hpp"
+#include "RinexNavData.hpp"
+#include "SP3Stream.hpp"
+#include "SP3Header.hpp"
+#include "SP3Data.hpp"
+#include "RinexClockStream.hpp"
+#include "RinexClockHeader.hpp"
+#include "RinexClockData.hpp"
+#include "ThreadUtils.hpp"
+
+#include "build_config.h"
+
+#include "TestUtil.hpp"
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace gpstk;
+
+   // Text describing a record, compared between serial and parallel runs
+static void describe(ostream& s, const Rinex3ObsData& rod)
+{
+   s << rod.time.asString() << " " << rod.epochFlag << endl;
+   rod.dump(s);
+}
+
+static void describe(ostream& s, const RinexObsData& rod)
+{
+   s << rod.time.asString() << " " << rod.epochFlag << endl;
+   rod.dump(s);
+}
+
+template <class Data>
+static void describe(ostream& s, const Data& data)
+{
+   data.dump(s);
+}
+
+
+   /// Decode every record of a file and return their description.
+template <class Stream, class Header, class Data>
+static string decodeFile(const string& fileName)
+{
+   Stream strm(fileName.c_str());
+   Header header;
+   Data data;
+   ostringstream oss;
+   unsigned long records = 0;
+
+   strm >> header;
+   while (strm >> data)
+   {
+      describe(oss, data);
+      records++;
+   }
+   oss << records << " records" << endl;
+
+   return oss.str();
+}
+
+
+typedef string (*Decoder)(const string&);
+
+   /// One file and the reader to decode it with.
+struct DecodeJob
+{
+   string fileName;
+   Decoder decoder;
+};
+
+   /// Work shared by the decoding threads.
+struct DecodeWork
+{
+   vector<DecodeJob> jobs;
+   vector<string> results;
+   size_t next;
+   Mutex mutex;
+};
+
+static void decodeThread(void *arg)
+{
+   DecodeWork& work = *static_cast<DecodeWork*>(arg);
+
+   while (true)
+   {
+      size_t job;
+      {
+         MutexLock lock(work.mutex);
+         if (work.next == work.jobs.size())
+            return;
+         job = work.next++;
+      }
+
+      string result(work.jobs[job].decoder(work.jobs[job].fileName));
+
+      MutexLock lock(work.mutex);
+      work.results[job] = result;
+   }
+}
+
+
+//============================================================
+// Class decalarations
+//============================================================
+
+class ConcurrentDecode_T
+{
+public:
+
+   ConcurrentDecode_T();
+
+      // return values indicate number of failures, i.e., 0=PASS, !0=FAIL
+   int interleaveTest( void );
+   int stressTest( void );
+
+private:
+
+   void addJob(const string& name, Decoder decoder);
+
+   string dataFilePath;
+
+   vector<DecodeJob> jobs;
+};
+
+
+ConcurrentDecode_T :: ConcurrentDecode_T()
+{
+   dataFilePath = gpstk::getPathData() + getFileSep();
+
+      // RinexContData has an event record without a time, which
+      // takes the time of the previous epoch of its own file.
+   const char *obs2[] =
+   {
+      "test_input_rinex2_obs_RinexContData.06o",
+      "test_input_rinex2_obs_RinexObsFile.06o",
+      "test_input_rinex2_obs_FilterTest1.06o",
+      "arlm200a.15o",
+      0
+   };
+
+   for (int i = 0; obs2[i] != 0; i++)
+   {
+      addJob(obs2[i], decodeFile<Rinex3ObsStream, Rinex3ObsHeader,
+                                 Rinex3ObsData>);
+      addJob(obs2[i], decodeFile<RinexObsStream, RinexObsHeader,
+                                 RinexObsData>);
+   }
+
+   addJob("test_input_rinex3_76193040.14o",
+          decodeFile<Rinex3ObsStream, Rinex3ObsHeader, Rinex3ObsData>);
+   addJob("test_input_rinex2_nav_RinexNavExample.99n",
+          decodeFile<RinexNavStream, RinexNavHeader, RinexNavData>);
+   addJob("arlm200a.15n",
+          decodeFile<RinexNavStream, RinexNavHeader, RinexNavData>);
+   addJob("test_input_SP3a.sp3",
+          decodeFile<SP3Stream, SP3Header, SP3Data>);
+   addJob("test_input_SP3c.sp3",
+          decodeFile<SP3Stream, SP3Header, SP3Data>);
+   addJob("test_input_rinex2_clock_RinexClockExample.96c",
+          decodeFile<RinexClockStream, RinexClockHeader, RinexClockData>);
+}
+
+
+void ConcurrentDecode_T :: addJob(const string& name, Decoder decoder)
+{
+   DecodeJob job;
+   job.fileName = dataFilePath + name;
+   job.decoder = decoder;
+   jobs.push_back(job);
+}
+
+
+   /* Read an epoch of another RINEX 2 file between each epoch of
+    * RinexContData, so that any time kept outside the stream for the
+    * time-less event record would come from the wrong file. */
+int ConcurrentDecode_T :: interleaveTest( void )
+{
+   TUDEF("Rinex3ObsData", "reallyGetRecord");
+
+   string contFile = dataFilePath + "test_input_rinex2_obs_RinexContData.06o";
+   string otherFile = dataFilePath + "arlm200a.15o";
+
+   {
+      vector<CommonTime> expected;
+      Rinex3ObsStream strm(contFile.c_str());
+      Rinex3ObsData rod;
+      while (strm >> rod)
+         expected.push_back(rod.time);
+
+      Rinex3ObsStream cont(contFile.c_str()), other(otherFile.c_str());
+      Rinex3ObsData contData, otherData;
+      size_t i = 0;
+      while (cont >> contData)
+      {
+         TUASSERT(i < expected.size());
+         if (i < expected.size())
+            TUASSERTE(CommonTime, expected[i], contData.time);
+         i++;
+         other >> otherData;
+      }
+      TUASSERTE(size_t, expected.size(), i);
+   }
+
+   TUCSM("RinexObsData::reallyGetRecord");
+
+   {
+      vector<CommonTime> expected;
+      RinexObsStream strm(contFile.c_str());
+      RinexObsData rod;
+      while (strm >> rod)
+         expected.push_back(rod.time);
+
+      RinexObsStream cont(contFile.c_str()), other(otherFile.c_str());
+      RinexObsData contData, otherData;
+      size_t i = 0;
+      while (cont >> contData)
+      {
+         TUASSERT(i < expected.size());
+         if (i < expected.size())
+            TUASSERTE(CommonTime, expected[i], contData.time);
+         i++;
+         other >> otherData;
+      }
+      TUASSERTE(size_t, expected.size(), i);
+   }
+
+   TURETURN();
+}
+
+
+   /* Decode every file several times over on several threads, each
+    * thread taking the next file as it finishes one, and compare
+    * with decoding each file alone. */
+int ConcurrentDecode_T :: stressTest( void )
+{
+   TUDEF("FFStream", "operator>>");
+
+   const unsigned numThreads = 8;
+   const unsigned repeat = 8;
+
+   vector<string> expected;
+   for (size_t j = 0; j < jobs.size(); j++)
+      expected.push_back(jobs[j].decoder(jobs[j].fileName));
+
+      // every expected result should hold some records
+   for (size_t j = 0; j < jobs.size(); j++)
+      TUASSERT(expected[j].find("\n0 records") == string::npos);
+
+   DecodeWork work;
+   for (unsigned r = 0; r < repeat; r++)
+      work.jobs.insert(work.jobs.end(), jobs.begin(), jobs.end());
+   work.results.resize(work.jobs.size());
+   work.next = 0;
+
+   ThreadGroup threads;
+   for (unsigned t = 0; t < numThreads; t++)
+      threads.start(decodeThread, &work);
+      // without threads, do the work here
+   decodeThread(&work);
+   threads.join();
+
+   unsigned long mismatches = 0;
+   for (size_t j = 0; j < work.jobs.size(); j++)
+   {
+      if (work.results[j] != expected[j % jobs.size()])
+      {
+         mismatches++;
+         TUFAIL("Parallel decoding of " + work.jobs[j].fileName +
+                " differs from serial decoding");
+      }
+   }
+   TUASSERTE(unsigned long, 0, mismatches);
+
+   TURETURN();
+}
+
+
+int main()
+{
+   int errorTotal = 0;
+   ConcurrentDecode_T testClass;
+
+   errorTotal += testClass.interleaveTest();
+   errorTotal += testClass.stressTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return( errorTotal );
+}
@@ -0,0 +1,380 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+#include "Rinex3ObsData.hpp"
+#include "Rinex3ObsColumnData.hpp"
+#include "Rinex3ObsStream.hpp"
+#include "Rinex3ObsHeader.hpp"
+
+#include "build_config.h"
+
+#include "TestUtil.hpp"
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <new>
+
+using namespace std;
+using namespace gpstk;
+
+   // Count heap allocations so steady-state reading can be checked.
+static unsigned long allocCount = 0;
+
+void* operator new(size_t size) throw(std::bad_alloc)
+{
+   allocCount++;
+   void *p = malloc(size ? size : 1);
+   if (p == 0)
+      throw std::bad_alloc();
+   return p;
+}
+
+void operator delete(void *p) throw()
+{
+   free(p);
+}
+
+//============================================================
+// Class decalarations
+//============================================================
+
+class Rinex3ObsColumnData_T
+{
+public:
+
+   Rinex3ObsColumnData_T();
+
+      // return values indicate number of failures, i.e., 0=PASS, !0=FAIL
+   int readTest( void );
+   int accessTest( void );
+   int adapterTest( void );
+   int writeTest( void );
+   int allocationTest( void );
+
+private:
+
+   string dataFilePath;
+   string tempFilePath;
+   string file_sep;
+
+   vector<string> inputFiles;
+};
+
+
+Rinex3ObsColumnData_T :: Rinex3ObsColumnData_T()
+{
+   dataFilePath = gpstk::getPathData();
+   tempFilePath = gpstk::getPathTestTemp();
+   file_sep = getFileSep();
+
+   const char *names[] =
+   {
+      "test_input_rinex2_obs_RinexObsFile.06o",
+      "test_input_rinex2_obs_RinexContData.06o",
+      "test_input_rinex2_obs_BadEpochFlag.06o",
+      "arlm200a.15o",
+      "test_input_rinex3_obs_RinexObsFile.15o",
+      "test_input_rinex3_obs_SystemMixed.15o",
+      "test_input_rinex3_obs_BadEpochFlag.15o",
+      "test_input_rinex3_obs_BadLineSize.15o",
+      "test_input_rinex3_obs_InvalidTimeFormat.15o",
+      "test_input_rinex3_obs_FilterTest3.15o",
+      "test_input_rinex3_76193040.14o",
+      0
+   };
+   for (int i = 0; names[i] != 0; i++)
+      inputFiles.push_back(dataFilePath + file_sep + names[i]);
+}
+
+
+   // Describe one epoch completely, including the stream state.
+static string describe( const Rinex3ObsData& rod, Rinex3ObsStream& strm )
+{
+   ostringstream oss;
+   oss << setprecision(17) << rod.time << " " << rod.epochFlag << " "
+       << rod.numSVs << " " << rod.clockOffset << " line "
+       << strm.lineNumber << " pos " << strm.tellg() << endl;
+   Rinex3ObsData::DataMap::const_iterator it;
+   for (it = rod.obs.begin(); it != rod.obs.end(); it++)
+   {
+      oss << it->first;
+      for (size_t i = 0; i < it->second.size(); i++)
+      {
+         const RinexDatum& rd = it->second[i];
+         oss << " " << rd.data << "/" << rd.dataBlank
+             << "/" << rd.lli << "/" << rd.lliBlank
+             << "/" << rd.ssi << "/" << rd.ssiBlank;
+      }
+      oss << endl;
+   }
+   oss << "aux " << rod.auxHeader.valid << " "
+       << rod.auxHeader.commentList.size() << endl;
+   return oss.str();
+}
+
+
+   // Read a whole file with Rinex3ObsData (mode 0) or with
+   // Rinex3ObsColumnData from the stream (mode 1) or memory map (mode 2).
+static string readAll( const string& fileName, int mode )
+{
+   string rv;
+   Rinex3ObsStream strm( fileName.c_str() );
+   if (mode == 2)
+      strm.setMappedRead();
+   Rinex3ObsData rod;
+   Rinex3ObsColumnData roc;
+   while (true)
+   {
+      if (mode == 0)
+      {
+         if (!(strm >> rod))
+            break;
+      }
+      else
+      {
+         if (!(strm >> roc))
+            break;
+         roc.toObsData(rod);
+      }
+      rv += describe(rod, strm);
+   }
+   ostringstream oss;
+   oss << "end line " << strm.lineNumber << " eof " << strm.eof() << endl;
+   return rv + oss.str();
+}
+
+
+int Rinex3ObsColumnData_T :: readTest( void )
+{
+   TUDEF("Rinex3ObsColumnData", "reallyGetRecord");
+
+   for (size_t i = 0; i < inputFiles.size(); i++)
+   {
+      string expected = readAll(inputFiles[i], 0);
+      testFramework.assert( expected == readAll(inputFiles[i], 1),
+                            "stream read differs for " + inputFiles[i],
+                            __LINE__ );
+      testFramework.assert( expected == readAll(inputFiles[i], 2),
+                            "mapped read differs for " + inputFiles[i],
+                            __LINE__ );
+   }
+
+   TURETURN();
+}
+
+
+int Rinex3ObsColumnData_T :: accessTest( void )
+{
+   TUDEF("Rinex3ObsColumnData", "findSat");
+
+   Rinex3ObsStream strm( (dataFilePath + file_sep +
+                          "test_input_rinex3_76193040.14o").c_str() );
+   Rinex3ObsHeader roh;
+   Rinex3ObsData rod;
+   Rinex3ObsColumnData roc;
+   strm >> roh;
+   strm >> roc;
+   roc.toObsData(rod);
+
+   TUASSERTE(size_t, rod.obs.size(), roc.numSats());
+   TUASSERTE(size_t, roc.numSats() + 1, roc.rowStart.size());
+   TUASSERTE(size_t, roc.data.size(), roc.lliSsi.size());
+   for (size_t i = 1; i < roc.numSats(); i++)
+      TUASSERT(roc.sats[i-1] < roc.sats[i]);
+
+   Rinex3ObsData::DataMap::const_iterator it;
+   for (it = rod.obs.begin(); it != rod.obs.end(); it++)
+   {
+      size_t i;
+      TUASSERT(roc.findSat(it->first, i));
+      TUASSERTE(RinexSatID, it->first, roc.sats[i]);
+      TUASSERTE(size_t, it->second.size(), roc.numObs(i));
+      for (size_t j = 0; j < it->second.size(); j++)
+      {
+         const RinexDatum& rd = it->second[j];
+         if (rd.dataBlank)
+            TUASSERT(roc.getValue(i,j) != roc.getValue(i,j));
+         else
+            TUASSERTE(double, rd.data, roc.getValue(i,j));
+         TUASSERTE(short, rd.lli, roc.getLLI(i,j));
+         TUASSERTE(short, rd.ssi, roc.getSSI(i,j));
+      }
+   }
+
+   size_t index;
+   TUASSERT(!roc.findSat(RinexSatID(99, SatID::systemGalileo), index));
+
+   TURETURN();
+}
+
+
+int Rinex3ObsColumnData_T :: adapterTest( void )
+{
+   TUDEF("Rinex3ObsColumnData", "fromObsData");
+
+   Rinex3ObsData rod, rod2;
+   Rinex3ObsColumnData roc;
+   rod.time = CommonTime::BEGINNING_OF_TIME;
+   rod.epochFlag = 0;
+   rod.numSVs = 3;
+   rod.clockOffset = 1.5e-9;
+
+   RinexDatum rd;
+   rd.data = 123456.789;
+   rd.lli = 1;
+   rd.ssi = 7;
+   rod.obs[RinexSatID(5, SatID::systemGPS)].push_back(rd);
+   rd.dataBlank = true;
+   rd.data = 0;
+   rd.lli = 0;
+   rd.lliBlank = true;
+   rod.obs[RinexSatID(5, SatID::systemGPS)].push_back(rd);
+   rod.obs[RinexSatID(2, SatID::systemGlonass)].push_back(RinexDatum());
+   rod.obs[RinexSatID(1, SatID::systemGPS)];
+
+   roc.fromObsData(rod);
+   TUASSERTE(size_t, 3, roc.numSats());
+   TUASSERTE(size_t, 3, roc.data.size());
+   TUASSERTE(size_t, 0, roc.numObs(0));
+   TUASSERTE(unsigned, Rinex3ObsColumnData::blankFlag, roc.lliSsi[1] & 0x0F);
+
+   roc.toObsData(rod2);
+   Rinex3ObsStream dummy;
+   TUASSERTE(string, describe(rod, dummy), describe(rod2, dummy));
+
+   roc.clear();
+   TUASSERTE(size_t, 0, roc.numSats());
+   TUASSERTE(size_t, 1, roc.rowStart.size());
+   size_t i = roc.addSat(RinexSatID(3, SatID::systemGPS), 2);
+   TUASSERTE(size_t, 0, i);
+   TUASSERT(roc.getDatum(0,1).dataBlank);
+   roc.setDatum(0, 1, rod.obs[RinexSatID(5, SatID::systemGPS)][0]);
+   TUASSERTE(double, 123456.789, roc.getValue(0,1));
+   TUASSERTE(short, 7, roc.getSSI(0,1));
+
+   TURETURN();
+}
+
+
+int Rinex3ObsColumnData_T :: writeTest( void )
+{
+   TUDEF("Rinex3ObsColumnData", "reallyPutRecord");
+
+   string inFile = dataFilePath + file_sep +
+      "test_input_rinex3_obs_RinexObsFile.15o";
+   string outFile = tempFilePath + file_sep +
+      "test_output_rinex3_obs_ColumnData.15o";
+   try
+   {
+      Rinex3ObsStream infile(inFile.c_str());
+      Rinex3ObsStream outfile(outFile.c_str(), ios::out);
+      Rinex3ObsHeader roh;
+      Rinex3ObsColumnData roc;
+      infile >> roh;
+      roh.preserveDate = true;
+      roh.preserveVerType = true;
+      outfile << roh;
+      while (infile >> roc)
+         outfile << roc;
+      infile.close();
+      outfile.close();
+      testFramework.assert_files_equal(
+         __LINE__, inFile, outFile,
+         "input and output do not match", 0, false, true );
+   }
+   catch (...)
+   {
+      TUFAIL("exception thrown during processing");
+   }
+
+   TURETURN();
+}
+
+
+int Rinex3ObsColumnData_T :: allocationTest( void )
+{
+   TUDEF("Rinex3ObsColumnData", "reallyGetRecord");
+
+   string inFile = dataFilePath + file_sep + "test_input_rinex3_76193040.14o";
+   Rinex3ObsColumnData roc;
+
+      // first pass grows the arrays to the largest epoch
+   for (int mapped = 0; mapped < 2; mapped++)
+   {
+      for (int pass = 0; pass < 2; pass++)
+      {
+         Rinex3ObsStream strm(inFile.c_str());
+         if (mapped)
+            strm.setMappedRead();
+         Rinex3ObsHeader roh;
+         strm >> roh;
+         unsigned long allocs = 0, epochs = 0;
+         while (true)
+         {
+            unsigned long before = allocCount;
+            if (!(strm >> roc))
+               break;
+            allocs += allocCount - before;
+            epochs++;
+         }
+         TUASSERTE(unsigned long, 570, epochs);
+         if (pass == 1)
+            TUASSERTE(unsigned long, 0, allocs);
+      }
+   }
+
+   TURETURN();
+}
+
+
+int main()
+{
+   int errorTotal = 0;
+   Rinex3ObsColumnData_T testClass;
+
+   errorTotal += testClass.readTest();
+   errorTotal += testClass.accessTest();
+   errorTotal += testClass.adapterTest();
+   errorTotal += testClass.writeTest();
+   errorTotal += testClass.allocationTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return( errorTotal );
+}
@@ -0,0 +1,145 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+/** @file Rinex3ObsReadBench.cpp
+ * Throughput of the stream and memory-mapped RINEX 3 observation
+ * readers, into Rinex3ObsData and into Rinex3ObsColumnData.
+ * Not run by ctest.
+ *
+ * Usage: Rinex3ObsReadBench [-n repeat] [file ...]
+ * With no files, the RINEX 3 observation files in the test data
+ * directory are used.
+ */
+
+#include "Rinex3ObsStream.hpp"
+#include "Rinex3ObsData.hpp"
+#include "Rinex3ObsColumnData.hpp"
+#include "StringUtils.hpp"
+
+#include "build_config.h"
+
+#include <ctime>
+#include <cstring>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace gpstk;
+
+   /// Read every record of a file, returning the number of epochs.
+template <class ObsData>
+static unsigned long readFile(const string& fn, bool mapped)
+{
+   Rinex3ObsStream strm(fn.c_str());
+   ObsData rod;
+   unsigned long epochs = 0;
+   if (mapped)
+      strm.setMappedRead();
+   while (strm >> rod)
+      epochs++;
+   return epochs;
+}
+
+
+   /// Size of a file in bytes.
+static double fileSize(const string& fn)
+{
+   ifstream ifs(fn.c_str(), ios::in | ios::binary);
+   ifs.seekg(0, ios::end);
+   return static_cast<double>(ifs.tellg());
+}
+
+
+int main(int argc, char *argv[])
+{
+   int repeat = 20;
+   vector<string> files;
+
+   for (int i = 1; i < argc; i++)
+   {
+      if (strcmp(argv[i], "-n") == 0 && i+1 < argc)
+         repeat = atoi(argv[++i]);
+      else
+         files.push_back(argv[i]);
+   }
+
+   if (files.empty())
+   {
+      string dir = getPathData() + getFileSep();
+      files.push_back(dir + "test_input_rinex3_76193040.14o");
+      files.push_back(dir + "test_input_rinex3_obs_RinexObsFile.15o");
+      files.push_back(dir + "test_input_rinex3_obs_FilterTest1.15o");
+      files.push_back(dir + "test_input_rinex3_obs_FilterTest2.15o");
+      files.push_back(dir + "test_input_rinex3_obs_SystemMixed.15o");
+   }
+
+   cout << setw(40) << left << "file" << right
+        << setw(10) << "epochs" << setw(14) << "stream MB/s"
+        << setw(14) << "mapped MB/s" << setw(14) << "column MB/s"
+        << setw(10) << "speedup" << endl;
+
+   for (size_t f = 0; f < files.size(); f++)
+   {
+      double mb = fileSize(files[f]) * repeat / 1.0e6;
+      unsigned long epochs = 0;
+      double secs[3];
+      for (int mode = 0; mode < 3; mode++)
+      {
+         clock_t start = clock();
+         for (int r = 0; r < repeat; r++)
+         {
+            if (mode < 2)
+               epochs = readFile<Rinex3ObsData>(files[f], mode == 1);
+            else
+               epochs = readFile<Rinex3ObsColumnData>(files[f], true);
+         }
+         secs[mode] = double(clock() - start) / CLOCKS_PER_SEC;
+      }
+      string name(files[f].substr(files[f].find_last_of(getFileSep()) + 1));
+      cout << setw(40) << left << name << right
+           << setw(10) << epochs << fixed << setprecision(2)
+           << setw(14) << mb / secs[0]
+           << setw(14) << mb / secs[1]
+           << setw(14) << mb / secs[2]
+           << setw(10) << secs[0] / secs[2] << endl;
+   }
+
+   return 0;
+}
@@ -45,7 +45,10 @@
 
 #include "TestUtil.hpp"
 #include <iostream>
+#include <sstream>
+#include <iomanip>
 #include <string>
+#include <vector>
 
 using namespace std;
 using namespace gpstk;
@@ -75,6 +78,8 @@ public:
    int dataExceptionsTest( void );
       /// round-trip test for RINEX 3, read, write, compare.
    int roundTripTest( void );
+      /// memory-mapped reading must give the same records as streaming
+   int mappedReadTest( void );
 
    void toConversionTest( void );
    int version2ToVersion3Test( void );
@@ -777,6 +782,80 @@ int Rinex3Obs_T::roundTripTest( void )
    return testFramework.countFails();
 }
 
+//------------------------------------------------------------
+// Read every record of a file, with or without the memory-mapped
+// reader, and describe all of the decoded content as text.
+//------------------------------------------------------------
+static string readAllRecords( const string& fileName, bool mapped )
+{
+   ostringstream oss;
+   gpstk::Rinex3ObsStream strm( fileName.c_str() );
+   gpstk::Rinex3ObsData rod;
+   if (mapped)
+      strm.setMappedRead();
+   oss << setprecision(17);
+   while (strm >> rod)
+   {
+      oss << rod.time << " " << rod.epochFlag << " " << rod.numSVs
+          << " " << rod.clockOffset << " line " << strm.lineNumber
+          << " pos " << strm.tellg() << endl;
+      gpstk::Rinex3ObsData::DataMap::const_iterator it;
+      for (it = rod.obs.begin(); it != rod.obs.end(); it++)
+      {
+         oss << it->first;
+         for (size_t i = 0; i < it->second.size(); i++)
+         {
+            const gpstk::RinexDatum& rd = it->second[i];
+            oss << " " << rd.data << "/" << rd.dataBlank
+                << "/" << rd.lli << "/" << rd.lliBlank
+                << "/" << rd.ssi << "/" << rd.ssiBlank;
+         }
+         oss << endl;
+      }
+      oss << "aux " << rod.auxHeader.valid << " "
+          << rod.auxHeader.commentList.size() << endl;
+   }
+   oss << "end line " << strm.lineNumber << " eof " << strm.eof() << endl;
+   return oss.str();
+}
+
+int Rinex3Obs_T :: mappedReadTest( void )
+{
+   TUDEF("Rinex3ObsStream", "setMappedRead");
+
+   vector<string> files;
+   files.push_back(dataRinexObsFile);
+   files.push_back(dataSystemGeosync);
+   files.push_back(dataSystemGlonass);
+   files.push_back(dataSystemMixed);
+   files.push_back(dataSystemTransit);
+   files.push_back(dataBadEpochLine);
+   files.push_back(dataBadEpochFlag);
+   files.push_back(dataBadLineSize);
+   files.push_back(dataInvalidTimeFormat);
+   files.push_back(dataFilterTest1);
+   files.push_back(dataFilterTest2);
+   files.push_back(dataFilterTest3);
+   files.push_back(dataFilterTest4);
+   files.push_back(dataFilePath + file_sep + "test_input_rinex3_76193040.14o");
+
+   gpstk::Rinex3ObsStream strm( dataRinexObsFile.c_str() );
+   TUASSERT( strm.setMappedRead() );
+   TUASSERT( strm.isMappedRead() );
+   TUASSERT( !strm.setMappedRead(false) );
+   TUASSERT( !strm.isMappedRead() );
+
+   for (size_t i = 0; i < files.size(); i++)
+   {
+      testFramework.assert( readAllRecords(files[i], false) ==
+                            readAllRecords(files[i], true),
+                            "mapped read differs for " + files[i],
+                            __LINE__ );
+   }
+
+   TURETURN();
+}
+
 int main()
 {
    int errorTotal = 0;
@@ -787,6 +866,7 @@ int main()
    errorTotal += testClass.dataExceptionsTest();
    errorTotal += testClass.filterOperatorsTest();
    errorTotal += testClass.roundTripTest();
+   errorTotal += testClass.mappedReadTest();
 
       //Change to test v.3
    testClass.toRinex3();
@@ -796,6 +876,8 @@ int main()
    errorTotal += testClass.dataExceptionsTest();
    errorTotal += testClass.filterOperatorsTest();
 
+   errorTotal += testClass.mappedReadTest();
+
    testClass.toConversionTest();
    errorTotal += testClass.roundTripTest();
 
@@ -0,0 +1,136 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+/**
+ * Rate and accuracy of GloEphemeris::svXvt() integrating the orbit on
+ * every call, against interpolating the tables of buildTable() for
+ * several node spacings. The time to build each table is included in
+ * the interpolated rate. Not run by ctest.
+ *
+ * Usage: GloEphemerisBench [-n repeat] [-s step]
+ * A synthetic GLONASS ephemeris is queried every step seconds
+ * (default 1) over its fit interval.
+ */
+
+#include "GloEphemeris.hpp"
+#include "CivilTime.hpp"
+
+#include <cmath>
+#include <ctime>
+#include <cstring>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+
+using namespace std;
+using namespace gpstk;
+
+
+int main(int argc, char *argv[])
+{
+   int repeat = 5;
+   double step = 1.0;
+
+   for (int i = 1; i < argc; i++)
+   {
+      if (strcmp(argv[i], "-n") == 0 && i+1 < argc)
+         repeat = atoi(argv[++i]);
+      else if (strcmp(argv[i], "-s") == 0 && i+1 < argc)
+         step = atof(argv[++i]);
+   }
+
+   CommonTime t0(CivilTime(2015, 7, 19, 0, 15, 0.0, TimeSystem::GLO));
+   GloEphemeris eph;
+   eph.setRecord("R", 1, t0,
+                 Triple(-13950.0, -3490.0, 21070.0),
+                 Triple(2.0, -2.6, 0.8933),
+                 Triple(1.86e-9, -2.79e-9, -1.86e-9),
+                 -1.2e-5, 9.1e-13, 86400, 0, 1, 0.0);
+
+   vector<CommonTime> times;
+   for (CommonTime t(t0 - 900.0); t < t0 + 900.0; t += step)
+      times.push_back(t);
+
+   vector<Xvt> exp(times.size());
+   clock_t start = clock();
+   for (int r = 0; r < repeat; r++)
+      for (size_t i = 0; i < times.size(); i++)
+         exp[i] = eph.svXvt(times[i]);
+   double base = double(clock() - start) / CLOCKS_PER_SEC;
+   double evals = double(repeat) * times.size();
+
+   cout << times.size() << " epochs x " << repeat << " repeats" << endl;
+   cout << setw(12) << "spacing s" << setw(14) << "ns per call"
+        << setw(10) << "speedup" << setw(12) << "bound m"
+        << setw(12) << "max diff m" << endl;
+   cout << setw(12) << "integrate" << fixed << setprecision(1)
+        << setw(14) << base * 1.0e9 / evals << endl;
+
+   const double spacing[] = { 30.0, 60.0, 120.0, 300.0 };
+   for (int k = 0; k < 4; k++)
+   {
+      double sum = 0.0;
+      start = clock();
+      for (int r = 0; r < repeat; r++)
+      {
+         GloEphemeris tab(eph);
+         tab.buildTable(spacing[k]);
+         for (size_t i = 0; i < times.size(); i++)
+            sum += tab.svXvt(times[i]).x[0];
+      }
+      double secs = double(clock() - start) / CLOCKS_PER_SEC;
+
+      GloEphemeris tab(eph);
+      tab.buildTable(spacing[k]);
+      double maxDiff = 0.0;
+      for (size_t i = 0; i < times.size(); i++)
+      {
+         Xvt got(tab.svXvt(times[i]));
+         for (int j = 0; j < 3; j++)
+            maxDiff = max(maxDiff, fabs(exp[i].x[j] - got.x[j]));
+      }
+
+      cout << fixed << setprecision(0) << setw(12) << spacing[k]
+           << setprecision(1) << setw(14) << secs * 1.0e9 / evals
+           << setprecision(0) << setw(9) << base / secs << "x"
+           << scientific << setprecision(1)
+           << setw(12) << tab.getTableErrorBound()
+           << setw(12) << maxDiff << (sum == sum ? "" : "  NaN") << endl;
+   }
+
+   return 0;
+}
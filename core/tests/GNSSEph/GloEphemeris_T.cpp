@@ -0,0 +1,309 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+   /* Check the interpolation tables of GloEphemeris::buildTable() and
+    * GloEphemerisStore::setInterpolation() against the Runge-Kutta
+    * integrator. */
+
+#include "GloEphemeris.hpp"
+#include "GloEphemerisStore.hpp"
+#include "Rinex3NavData.hpp"
+#include "CivilTime.hpp"
+#include "TestUtil.hpp"
+
+#include <cmath>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+using namespace std;
+using namespace gpstk;
+
+
+class GloEphemeris_T
+{
+public:
+
+   GloEphemeris_T();
+
+      // return values indicate number of failures, i.e., 0=PASS, !0=FAIL
+   int tableTest( void );
+   int spacingTest( void );
+   int clearTableTest( void );
+   int stepTest( void );
+   int storeTest( void );
+   int exceptionTest( void );
+
+private:
+
+      /** Compare svXvt() of got and exp every dt seconds over the fit
+       * interval, returning the largest position difference. */
+   double compare(TestUtil& testFramework,
+                  const GloEphemeris& exp,
+                  const GloEphemeris& got,
+                  double dt);
+
+      /// A plausible GLONASS ephemeris, the epoch shifted by dt seconds
+   GloEphemeris makeEph(double dt) const;
+
+   CommonTime t0;
+
+      /// Tolerances: 1 mm and 1 um/s
+   static const double posTol, velTol;
+};
+
+const double GloEphemeris_T::posTol = 1.0e-3;
+const double GloEphemeris_T::velTol = 1.0e-6;
+
+
+GloEphemeris_T :: GloEphemeris_T()
+      : t0(CivilTime(2015, 7, 19, 0, 15, 0.0, TimeSystem::GLO))
+{
+}
+
+
+GloEphemeris GloEphemeris_T ::
+makeEph(double dt) const
+{
+   GloEphemeris eph;
+   eph.setRecord("R", 1, t0 + dt,
+                 Triple(-13950.0, -3490.0, 21070.0),
+                 Triple(2.0, -2.6, 0.8933),
+                 Triple(1.86e-9, -2.79e-9, -1.86e-9),
+                 -1.2e-5, 9.1e-13, 86400, 0, 1, 0.0);
+   return eph;
+}
+
+
+double GloEphemeris_T ::
+compare(TestUtil& testFramework,
+        const GloEphemeris& exp,
+        const GloEphemeris& got,
+        double dt)
+{
+   double maxPos = 0.0, maxVel = 0.0, maxClk = 0.0;
+   CommonTime ephTime(exp.getEphemerisEpoch());
+   for (CommonTime t(ephTime - 900.0); t < ephTime + 900.0; t += dt)
+   {
+      Xvt e(exp.svXvt(t)), g(got.svXvt(t));
+      for (int j = 0; j < 3; j++)
+      {
+         maxPos = max(maxPos, fabs(e.x[j] - g.x[j]));
+         maxVel = max(maxVel, fabs(e.v[j] - g.v[j]));
+      }
+      maxClk = max(maxClk, fabs(e.clkbias - g.clkbias));
+   }
+
+   ostringstream oss;
+   oss << "position diff " << maxPos << " m, velocity diff " << maxVel
+       << " m/s, clock diff " << maxClk << " s";
+   testFramework.assert(maxPos < posTol && maxVel < velTol &&
+                        maxClk < 1.0e-15, oss.str(), __LINE__);
+   return maxPos;
+}
+
+
+   /* Default table against the integrator, at odd times and at the
+    * nodes, where the two agree to rounding. */
+int GloEphemeris_T :: tableTest( void )
+{
+   TUDEF("GloEphemeris", "buildTable");
+
+   GloEphemeris eph(makeEph(0.0)), tab(makeEph(0.0));
+   TUASSERT(!tab.hasTable());
+   TUASSERTFE(0.0, tab.getTableErrorBound());
+
+   tab.buildTable();
+   TUASSERT(tab.hasTable());
+   TUASSERTFE(60.0, tab.getTableSpacing());
+   TUASSERT(tab.getTableErrorBound() < posTol);
+
+   compare(testFramework, eph, tab, 7.3);
+   double nodeDiff = compare(testFramework, eph, tab, 60.0);
+   TUASSERT(nodeDiff < 1.0e-6);
+
+   TURETURN();
+}
+
+
+   /* Coarser tables are less accurate, and the bound tracks the
+    * actual error. */
+int GloEphemeris_T :: spacingTest( void )
+{
+   TUDEF("GloEphemeris", "getTableErrorBound");
+
+   GloEphemeris eph(makeEph(0.0));
+   const double spacing[] = { 30.0, 60.0, 120.0, 300.0 };
+   double prevBound = 0.0;
+   for (int k = 0; k < 4; k++)
+   {
+      GloEphemeris tab(makeEph(0.0));
+      tab.buildTable(spacing[k]);
+      double bound = tab.getTableErrorBound();
+      double diff = compare(testFramework, eph, tab, 1.0);
+      TUASSERT(diff <= bound + 1.0e-6);
+      TUASSERT(bound >= prevBound);
+      prevBound = bound;
+   }
+
+   TURETURN();
+}
+
+
+int GloEphemeris_T :: clearTableTest( void )
+{
+   TUDEF("GloEphemeris", "clearTable");
+
+   GloEphemeris eph(makeEph(0.0)), tab(makeEph(0.0));
+   tab.buildTable(120.0).clearTable();
+   TUASSERT(!tab.hasTable());
+   TUASSERTFE(0.0, tab.getTableSpacing());
+   TUASSERTFE(0.0, tab.getTableErrorBound());
+
+   CommonTime t(t0 + 123.4);
+   Xvt e(eph.svXvt(t)), g(tab.svXvt(t));
+   TUASSERTE(Triple, e.x, g.x);
+   TUASSERTE(Triple, e.v, g.v);
+
+   TURETURN();
+}
+
+
+   /* Changing the integration step rebuilds the table with it. */
+int GloEphemeris_T :: stepTest( void )
+{
+   TUDEF("GloEphemeris", "setIntegrationStep");
+
+   GloEphemeris fresh(makeEph(0.0)), tab(makeEph(0.0));
+   fresh.setIntegrationStep(10.0).buildTable(60.0);
+   tab.buildTable(60.0).setIntegrationStep(10.0);
+   TUASSERT(tab.hasTable());
+   TUASSERTFE(60.0, tab.getTableSpacing());
+   TUASSERTFE(fresh.getTableErrorBound(), tab.getTableErrorBound());
+
+   CommonTime t(t0 + 123.4);
+   Xvt e(fresh.svXvt(t)), g(tab.svXvt(t));
+   TUASSERTE(Triple, e.x, g.x);
+   TUASSERTE(Triple, e.v, g.v);
+
+   TURETURN();
+}
+
+
+   /* Turning interpolation on applies to stored ephemerides and to
+    * those added afterwards; turning it off drops the tables. */
+int GloEphemeris_T :: storeTest( void )
+{
+   TUDEF("GloEphemerisStore", "setInterpolation");
+
+   GloEphemerisStore plain, store;
+   SatID sat(1, SatID::systemGlonass);
+   plain.addEphemeris(Rinex3NavData(makeEph(0.0)));
+   plain.addEphemeris(Rinex3NavData(makeEph(1800.0)));
+   store.addEphemeris(Rinex3NavData(makeEph(0.0)));
+   TUASSERTFE(0.0, store.getInterpolation());
+   TUASSERTFE(0.0, store.getInterpolationErrorBound());
+
+   store.setInterpolation(60.0);
+   store.addEphemeris(Rinex3NavData(makeEph(1800.0)));
+   TUASSERTFE(60.0, store.getInterpolation());
+   TUASSERT(store.findEphemeris(sat, t0).hasTable());
+   TUASSERT(store.findEphemeris(sat, t0 + 1800.0).hasTable());
+   TUASSERT(store.getInterpolationErrorBound() > 0.0);
+   TUASSERT(store.getInterpolationErrorBound() < posTol);
+
+   double maxPos = 0.0;
+   for (CommonTime t(t0 - 600.0); t < t0 + 2400.0; t += 11.0)
+   {
+      Xvt e(plain.getXvt(sat, t)), g(store.getXvt(sat, t));
+      for (int j = 0; j < 3; j++)
+         maxPos = max(maxPos, fabs(e.x[j] - g.x[j]));
+   }
+   TUASSERT(maxPos < posTol);
+
+   store.setInterpolation(0.0);
+   TUASSERT(!store.findEphemeris(sat, t0).hasTable());
+   TUASSERTFE(0.0, store.getInterpolationErrorBound());
+
+   TURETURN();
+}
+
+
+int GloEphemeris_T :: exceptionTest( void )
+{
+   TUDEF("GloEphemeris", "buildTable");
+
+   GloEphemeris empty, eph(makeEph(0.0));
+   try
+   {
+      empty.buildTable();
+      TUFAIL("Expected InvalidRequest for an empty ephemeris");
+   }
+   catch (InvalidRequest& e)
+   {
+      TUPASS("InvalidRequest");
+   }
+
+   try
+   {
+      eph.buildTable(0.0);
+      TUFAIL("Expected InvalidRequest for a zero node spacing");
+   }
+   catch (InvalidRequest& e)
+   {
+      TUPASS("InvalidRequest");
+   }
+
+   TURETURN();
+}
+
+
+int main()
+{
+   int errorTotal = 0;
+   GloEphemeris_T testClass;
+
+   errorTotal += testClass.tableTest();
+   errorTotal += testClass.spacingTest();
+   errorTotal += testClass.clearTableTest();
+   errorTotal += testClass.stepTest();
+   errorTotal += testClass.storeTest();
+   errorTotal += testClass.exceptionTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return( errorTotal );
+}
@@ -0,0 +1,253 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+   /* Check that the orbit kernel used by OrbitEph::svXvts() and
+    * orbitEphXvt() matches OrbitEph::svXvt() to sub-millimeter. */
+
+#include "OrbitEphKernel.hpp"
+#include "GPSEphemeris.hpp"
+#include "Rinex3NavStream.hpp"
+#include "Rinex3NavHeader.hpp"
+#include "Rinex3NavData.hpp"
+#include "TestUtil.hpp"
+
+#include "build_config.h"
+
+#include <cmath>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace gpstk;
+
+
+class OrbitEphKernel_T
+{
+public:
+
+   OrbitEphKernel_T();
+
+      // return values indicate number of failures, i.e., 0=PASS, !0=FAIL
+   int svXvtsTest( void );
+   int eccentricTest( void );
+   int mixedTest( void );
+   int notLoadedTest( void );
+
+private:
+
+      /** Compare each of got with svXvt() of the matching ephemeris,
+       * counting differences beyond the tolerances. */
+   void compare(TestUtil& testFramework,
+                const vector<const OrbitEph*>& ephs,
+                const vector<CommonTime>& times,
+                const vector<Xvt>& got);
+
+   vector<GPSEphemeris> ephList;
+
+      /// Tolerances: 0.1 mm, 0.1 um/s, and 1e-16 s (30 nm)
+   static const double posTol, velTol, clkTol;
+};
+
+const double OrbitEphKernel_T::posTol = 1.0e-4;
+const double OrbitEphKernel_T::velTol = 1.0e-7;
+const double OrbitEphKernel_T::clkTol = 1.0e-16;
+
+
+OrbitEphKernel_T :: OrbitEphKernel_T()
+{
+   string fn(gpstk::getPathData() + getFileSep() + "arlm2000.15n");
+   Rinex3NavStream strm(fn.c_str());
+   Rinex3NavHeader hdr;
+   Rinex3NavData rnd;
+   strm >> hdr;
+   while (strm >> rnd)
+   {
+      if (rnd.sat.system == SatID::systemGPS)
+         ephList.push_back(GPSEphemeris(rnd));
+   }
+}
+
+
+void OrbitEphKernel_T ::
+compare(TestUtil& testFramework,
+        const vector<const OrbitEph*>& ephs,
+        const vector<CommonTime>& times,
+        const vector<Xvt>& got)
+{
+   TUASSERTE(size_t, times.size(), got.size());
+   if (got.size() != times.size())
+      return;
+
+   double maxPos = 0.0, maxVel = 0.0, maxClk = 0.0;
+   for (size_t i = 0; i < times.size(); i++)
+   {
+      Xvt exp(ephs[i]->svXvt(times[i]));
+      for (int j = 0; j < 3; j++)
+      {
+         maxPos = max(maxPos, fabs(exp.x[j] - got[i].x[j]));
+         maxVel = max(maxVel, fabs(exp.v[j] - got[i].v[j]));
+      }
+      maxClk = max(maxClk, fabs(exp.clkbias - got[i].clkbias));
+      maxClk = max(maxClk, fabs(exp.clkdrift - got[i].clkdrift));
+      maxClk = max(maxClk, fabs(exp.relcorr - got[i].relcorr));
+   }
+
+   ostringstream oss;
+   oss << "position diff " << maxPos << " m, velocity diff " << maxVel
+       << " m/s, clock diff " << maxClk << " s";
+   testFramework.assert(maxPos < posTol && maxVel < velTol &&
+                        maxClk < clkTol, oss.str(), __LINE__);
+}
+
+
+   /* Each ephemeris, every 30 s over its fit interval and an hour
+    * either side. */
+int OrbitEphKernel_T :: svXvtsTest( void )
+{
+   TUDEF("OrbitEph", "svXvts");
+
+   TUASSERT(ephList.size() > 0);
+   for (size_t e = 0; e < ephList.size(); e++)
+   {
+      const GPSEphemeris& eph(ephList[e]);
+      vector<CommonTime> times;
+      for (CommonTime t(eph.beginValid - 3600.0);
+           t <= eph.endValid + 3600.0; t += 30.0)
+         times.push_back(t);
+
+      vector<Xvt> got;
+      eph.svXvts(times, got);
+      compare(testFramework, vector<const OrbitEph*>(times.size(), &eph),
+              times, got);
+   }
+
+   TURETURN();
+}
+
+
+   /* The Galileo E14/E18 (0.16) and QZSS (0.075) eccentricities, the
+    * largest evaluated on the lanes, and one beyond it that is passed
+    * to svXvt(). */
+int OrbitEphKernel_T :: eccentricTest( void )
+{
+   TUDEF("OrbitEph", "svXvts");
+
+   const double eccs[] = { 0.0, 0.075, 0.16, 0.299, 0.5 };
+   for (int k = 0; k < 5; k++)
+   {
+      GPSEphemeris eph(ephList[0]);
+      eph.ecc = eccs[k];
+
+      vector<CommonTime> times;
+      for (CommonTime t(eph.beginValid); t <= eph.endValid; t += 7.0)
+         times.push_back(t);
+
+      vector<Xvt> got;
+      eph.svXvts(times, got);
+      compare(testFramework, vector<const OrbitEph*>(times.size(), &eph),
+              times, got);
+   }
+
+   TURETURN();
+}
+
+
+   /* Different satellites on adjacent lanes, in groups of every size
+    * up to a few more than the number of lanes. */
+int OrbitEphKernel_T :: mixedTest( void )
+{
+   TUDEF("OrbitEphKernel", "orbitEphXvt");
+
+   TUASSERT(orbitEphKernelLanes() >= 1);
+
+   const size_t maxN = 2 * orbitEphKernelLanes() + 3;
+   for (size_t n = 1; n <= maxN && n <= ephList.size(); n++)
+   {
+      vector<const OrbitEph*> ephs;
+      vector<CommonTime> times;
+      for (size_t i = 0; i < n; i++)
+      {
+         const GPSEphemeris& eph(ephList[(i * 7) % ephList.size()]);
+         ephs.push_back(&eph);
+         times.push_back(eph.ctToe + 450.0 * i - 3600.0);
+      }
+
+      vector<Xvt> got(n);
+      orbitEphXvt(&ephs[0], &times[0], &got[0], n);
+      compare(testFramework, ephs, times, got);
+   }
+
+   TURETURN();
+}
+
+
+int OrbitEphKernel_T :: notLoadedTest( void )
+{
+   TUDEF("OrbitEph", "svXvts");
+
+   GPSEphemeris eph;
+   vector<CommonTime> times(3, CommonTime::BEGINNING_OF_TIME);
+   vector<Xvt> got;
+   try
+   {
+      eph.svXvts(times, got);
+      TUFAIL("Expected InvalidRequest for an empty ephemeris");
+   }
+   catch (InvalidRequest& e)
+   {
+      TUPASS("InvalidRequest");
+   }
+
+   TURETURN();
+}
+
+
+int main()
+{
+   int errorTotal = 0;
+   OrbitEphKernel_T testClass;
+
+   errorTotal += testClass.svXvtsTest();
+   errorTotal += testClass.eccentricTest();
+   errorTotal += testClass.mixedTest();
+   errorTotal += testClass.notLoadedTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return( errorTotal );
+}
@@ -0,0 +1,261 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+/**
+ * Lookup rate of OrbitEphStore with and without the index built by
+ * freezeIndex(), for time-ordered and scattered queries, and of
+ * getXvt() for each satellite against getXvts() for each epoch, with
+ * and without setFastXvtsFlag(), and of OrbitEph::svXvt() against the
+ * multi-lane OrbitEph::svXvts().
+ * Not run by ctest.
+ *
+ * Usage: OrbitEphStoreBench [-n repeat] [-s step] [file ...]
+ * With no files, two days of GPS broadcast ephemerides from the test
+ * data directory are used. Queries are made every step seconds
+ * (default 1) over the span of the store, for each GPS satellite.
+ */
+
+#include "GPSEphemerisStore.hpp"
+#include "OrbitEphKernel.hpp"
+#include "StringUtils.hpp"
+#include "GPSEphemeris.hpp"
+#include "Rinex3NavStream.hpp"
+#include "Rinex3NavHeader.hpp"
+#include "Rinex3NavData.hpp"
+#include "TestSupport.hpp"
+
+#include "build_config.h"
+
+#include <cmath>
+#include <ctime>
+#include <cstring>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace gpstk;
+
+   /** Query every satellite at every time, returning a checksum.
+    * mode 0 finds the OrbitEph, 1 calls getXvt for each satellite and
+    * 2 calls getXvts once per epoch. */
+static double run(const GPSEphemerisStore& store, const vector<SatID>& sats,
+                  const vector<CommonTime>& times, int mode)
+{
+   double sum = 0.0;
+   vector<CommonTime> epoch(sats.size());
+   vector<Xvt> xvts;
+   vector<bool> valid;
+   for (size_t i = 0; i < times.size(); i++)
+   {
+      if (mode == 2)
+      {
+         epoch.assign(sats.size(), times[i]);
+         store.getXvts(sats, epoch, xvts, valid);
+         for (size_t s = 0; s < sats.size(); s++)
+         {
+            if (valid[s])
+               sum += xvts[s].clkbias;
+         }
+         continue;
+      }
+      for (size_t s = 0; s < sats.size(); s++)
+      {
+         if (mode == 1)
+         {
+            try
+            {
+               sum += store.getXvt(sats[s], times[i]).clkbias;
+            }
+            catch (InvalidRequest&)
+            {
+            }
+         }
+         else if (store.findOrbitEph(sats[s], times[i]) != NULL)
+            sum += 1.0;
+      }
+   }
+   return sum;
+}
+
+
+int main(int argc, char *argv[])
+{
+   int repeat = 5;
+   double step = 1.0;
+   vector<string> files;
+
+   for (int i = 1; i < argc; i++)
+   {
+      if (strcmp(argv[i], "-n") == 0 && i+1 < argc)
+         repeat = atoi(argv[++i]);
+      else if (strcmp(argv[i], "-s") == 0 && i+1 < argc)
+         step = atof(argv[++i]);
+      else
+         files.push_back(argv[i]);
+   }
+
+   if (files.empty())
+   {
+      string dir = getPathData() + getFileSep();
+      files.push_back(dir + "arlm2000.15n");
+      files.push_back(dir + "arlm2001.15n");
+   }
+
+   GPSEphemerisStore store;
+   for (size_t f = 0; f < files.size(); f++)
+   {
+      Rinex3NavStream strm(files[f].c_str());
+      Rinex3NavHeader hdr;
+      Rinex3NavData rnd;
+      strm >> hdr;
+      while (strm >> rnd)
+      {
+         if (rnd.sat.system == SatID::systemGPS)
+            store.addEphemeris(GPSEphemeris(rnd));
+      }
+   }
+   store.rationalize();
+
+   vector<SatID> sats;
+   for (int prn = 1; prn <= 32; prn++)
+      sats.push_back(SatID(prn, SatID::systemGPS));
+
+   vector<CommonTime> ordered;
+   CommonTime t(store.getInitialTime());
+   for (; t <= store.getFinalTime(); t += step)
+      ordered.push_back(t);
+
+   vector<CommonTime> scattered(ordered);
+   unsigned seed = 12345;
+   shuffle(scattered, seed);
+
+   double lookups = double(repeat) * ordered.size() * sats.size();
+   cout << store.size() << " ephemerides, " << ordered.size()
+        << " epochs x " << sats.size() << " satellites x " << repeat
+        << " repeats" << endl;
+   cout << setw(24) << left << "query" << right
+        << setw(12) << "map ns" << setw(12) << "index ns"
+        << setw(10) << "speedup" << endl;
+
+   const char *names[] = { "findOrbitEph ordered", "findOrbitEph scattered",
+                           "getXvt ordered", "getXvt scattered",
+                           "getXvts ordered", "getXvts scattered",
+                           "getXvts fast ordered", "getXvts fast scattered" };
+   for (int q = 0; q < 8; q++)
+   {
+      const vector<CommonTime>& times(q % 2 ? scattered : ordered);
+      int mode = q < 6 ? q / 2 : 2;
+      store.setFastXvtsFlag(q >= 6);
+      double secs[2], sums[2];
+      for (int frozen = 0; frozen < 2; frozen++)
+      {
+         if (frozen)
+            store.freezeIndex();
+         else
+            store.thawIndex();
+         sums[frozen] = 0.0;
+         clock_t start = clock();
+         for (int r = 0; r < repeat; r++)
+            sums[frozen] += run(store, sats, times, mode);
+         secs[frozen] = double(clock() - start) / CLOCKS_PER_SEC;
+      }
+      cout << setw(24) << left << names[q] << right << fixed
+           << setprecision(1)
+           << setw(12) << secs[0] * 1.0e9 / lookups
+           << setw(12) << secs[1] * 1.0e9 / lookups
+           << setprecision(2) << setw(10) << secs[0] / secs[1]
+           << (sums[0] == sums[1] ? "" : "  MISMATCH") << endl;
+   }
+
+      // The orbit alone: svXvt at each time against svXvts, for every
+      // ephemeris over its fit interval.
+   vector<const OrbitEph*> ephs;
+   for (size_t s = 0; s < sats.size(); s++)
+   {
+      if (!store.isPresent(sats[s]))
+         continue;
+      const OrbitEphStore::TimeOrbitEphTable& table =
+         store.getTimeOrbitEphMap(sats[s]);
+      OrbitEphStore::TimeOrbitEphTable::const_iterator it;
+      for (it = table.begin(); it != table.end(); ++it)
+         ephs.push_back(it->second);
+   }
+
+   double secs[2], evals = 0.0, maxDiff = 0.0;
+   secs[0] = secs[1] = 0.0;
+   vector<Xvt> xvts;
+   for (size_t e = 0; e < ephs.size(); e++)
+   {
+      vector<CommonTime> times;
+      for (t = ephs[e]->beginValid; t <= ephs[e]->endValid; t += step)
+         times.push_back(t);
+      evals += double(repeat) * times.size();
+
+      clock_t start = clock();
+      for (int r = 0; r < repeat; r++)
+         for (size_t i = 0; i < times.size(); i++)
+            ephs[e]->svXvt(times[i]);
+      secs[0] += double(clock() - start) / CLOCKS_PER_SEC;
+
+      start = clock();
+      for (int r = 0; r < repeat; r++)
+         ephs[e]->svXvts(times, xvts);
+      secs[1] += double(clock() - start) / CLOCKS_PER_SEC;
+
+      for (size_t i = 0; i < times.size(); i++)
+      {
+         Xvt exp(ephs[e]->svXvt(times[i]));
+         for (int j = 0; j < 3; j++)
+            maxDiff = max(maxDiff, fabs(exp.x[j] - xvts[i].x[j]));
+      }
+   }
+
+   cout << endl << setw(22) << left << "orbit" << right
+        << setw(12) << "svXvt ns" << setw(12) << "svXvts ns"
+        << setw(10) << "speedup" << endl;
+   cout << setw(22) << left << "lanes " + StringUtils::asString(
+              orbitEphKernelLanes()) << right << fixed << setprecision(1)
+        << setw(12) << secs[0] * 1.0e9 / evals
+        << setw(12) << secs[1] * 1.0e9 / evals
+        << setprecision(2) << setw(10) << secs[0] / secs[1]
+        << "  max diff " << scientific << setprecision(1) << maxDiff
+        << " m" << endl;
+
+   return 0;
+}
@@ -0,0 +1,389 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+   /* Check that the lookup index built by OrbitEphStore::freezeIndex()
+    * selects exactly the same ephemerides as the map searches, for
+    * both the user (strict) and near search methods, and that getXvts
+    * agrees with getXvt. */
+
+#include "GPSEphemerisStore.hpp"
+#include "GPSEphemeris.hpp"
+#include "Rinex3NavStream.hpp"
+#include "Rinex3NavHeader.hpp"
+#include "Rinex3NavData.hpp"
+#include "TestUtil.hpp"
+#include "TestSupport.hpp"
+
+#include "build_config.h"
+
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace gpstk;
+
+
+class OrbitEphStore_T
+{
+public:
+
+   OrbitEphStore_T();
+
+      // return values indicate number of failures, i.e., 0=PASS, !0=FAIL
+   int indexTest( void );
+   int thawTest( void );
+   int timeSystemTest( void );
+   int getXvtsTest( void );
+
+private:
+
+   void loadStore(GPSEphemerisStore& store);
+
+      /** Find the ephemeris for each query time, for each satellite
+       * in sats, using the store's current search method. */
+   vector<const OrbitEph*> lookup(const GPSEphemerisStore& store,
+                                  const vector<SatID>& sats,
+                                  const vector<CommonTime>& times);
+
+   string dataFilePath;
+   vector<string> navFiles;
+};
+
+
+OrbitEphStore_T :: OrbitEphStore_T()
+{
+   dataFilePath = gpstk::getPathData() + getFileSep();
+   navFiles.push_back("arlm2000.15n");
+   navFiles.push_back("arlm2001.15n");
+}
+
+
+void OrbitEphStore_T :: loadStore(GPSEphemerisStore& store)
+{
+   for (size_t i = 0; i < navFiles.size(); i++)
+   {
+      string fn(dataFilePath + navFiles[i]);
+      Rinex3NavStream strm(fn.c_str());
+      Rinex3NavHeader hdr;
+      Rinex3NavData rnd;
+      strm >> hdr;
+      while (strm >> rnd)
+      {
+         if (rnd.sat.system == SatID::systemGPS)
+            store.addEphemeris(GPSEphemeris(rnd));
+      }
+   }
+   store.rationalize();
+}
+
+
+vector<const OrbitEph*> OrbitEphStore_T ::
+lookup(const GPSEphemerisStore& store,
+       const vector<SatID>& sats,
+       const vector<CommonTime>& times)
+{
+   vector<const OrbitEph*> rv;
+   rv.reserve(sats.size() * times.size());
+   for (size_t s = 0; s < sats.size(); s++)
+      for (size_t i = 0; i < times.size(); i++)
+         rv.push_back(store.findOrbitEph(sats[s], times[i]));
+   return rv;
+}
+
+
+int OrbitEphStore_T :: indexTest( void )
+{
+   TUDEF("OrbitEphStore", "freezeIndex");
+
+   GPSEphemerisStore store;
+   loadStore(store);
+   TUASSERT(store.size() > 0);
+
+      // Every 30 s beyond both ends of the store, plus each key and
+      // fit interval limit, and times a fraction of a millisecond
+      // and a second either side of them.
+   vector<CommonTime> times;
+   CommonTime t(store.getInitialTime() - 7200.0);
+   CommonTime tEnd(store.getFinalTime() + 7200.0);
+   for (; t <= tEnd; t += 30.0)
+      times.push_back(t);
+
+   vector<SatID> sats;
+   const double offsets[] = { 0.0, -0.0004, 0.0004, -1.0, 1.0 };
+   for (int prn = 1; prn <= 32; prn++)
+   {
+      SatID sat(prn, SatID::systemGPS);
+      sats.push_back(sat);
+      if (!store.isPresent(sat))
+         continue;
+      const OrbitEphStore::TimeOrbitEphTable& table =
+         store.getTimeOrbitEphMap(sat);
+      OrbitEphStore::TimeOrbitEphTable::const_iterator it;
+      for (it = table.begin(); it != table.end(); ++it)
+      {
+         for (int j = 0; j < 5; j++)
+         {
+            times.push_back(it->first + offsets[j]);
+            times.push_back(it->second->endValid + offsets[j]);
+         }
+      }
+   }
+
+      // The same times in a scrambled order, to defeat the last-hit cache.
+   vector<CommonTime> scrambled(times);
+   unsigned seed = 12345;
+   shuffle(scrambled, seed);
+
+   for (int method = 0; method < 2; method++)
+   {
+      if (method == 0)
+      {
+         TUCSM("findUserOrbitEph");
+         store.SearchUser();
+      }
+      else
+      {
+         TUCSM("findNearOrbitEph");
+         store.SearchNear();
+      }
+
+      store.thawIndex();
+      vector<const OrbitEph*> expOrdered(lookup(store, sats, times));
+      vector<const OrbitEph*> expScrambled(lookup(store, sats, scrambled));
+
+      store.freezeIndex();
+      TUASSERT(store.isIndexFrozen());
+      vector<const OrbitEph*> gotOrdered(lookup(store, sats, times));
+      vector<const OrbitEph*> gotScrambled(lookup(store, sats, scrambled));
+
+      unsigned long found = 0, mismatches = 0;
+      for (size_t i = 0; i < expOrdered.size(); i++)
+      {
+         if (expOrdered[i] != NULL)
+            found++;
+         if (gotOrdered[i] != expOrdered[i])
+            mismatches++;
+         if (gotScrambled[i] != expScrambled[i])
+            mismatches++;
+      }
+      TUASSERT(found > 0);
+      TUASSERT(found < expOrdered.size());
+      TUASSERTE(unsigned long, 0, mismatches);
+   }
+
+   TURETURN();
+}
+
+
+int OrbitEphStore_T :: thawTest( void )
+{
+   TUDEF("OrbitEphStore", "thawIndex");
+
+   GPSEphemerisStore store;
+   loadStore(store);
+   SatID sat(1, SatID::systemGPS);
+      // the user search finds nothing at the first key of a table
+   const OrbitEph *eph = store.findNearOrbitEph(sat,
+                                                store.getInitialTime(sat));
+
+   store.freezeIndex();
+   TUASSERT(store.isIndexFrozen());
+   store.thawIndex();
+   TUASSERT(!store.isIndexFrozen());
+
+      // anything that changes the store discards the index
+   store.freezeIndex();
+   store.rationalize();
+   TUASSERT(!store.isIndexFrozen());
+
+   store.freezeIndex();
+   TUASSERT(eph != NULL);
+   if (eph != NULL)
+      store.addEphemeris(*dynamic_cast<const GPSEphemeris*>(eph));
+   TUASSERT(!store.isIndexFrozen());
+
+   store.freezeIndex();
+   store.edit(store.getInitialTime() + 3600.0, store.getFinalTime());
+   TUASSERT(!store.isIndexFrozen());
+
+   store.freezeIndex();
+   store.clear();
+   TUASSERT(!store.isIndexFrozen());
+   TUASSERT(store.findOrbitEph(sat, CommonTime::BEGINNING_OF_TIME) == NULL);
+
+   TURETURN();
+}
+
+
+int OrbitEphStore_T :: timeSystemTest( void )
+{
+   TUDEF("OrbitEphStore", "findUserOrbitEph");
+
+      // A time in a different system can't be compared with the
+      // store, with or without the index.
+   GPSEphemerisStore store;
+   loadStore(store);
+   SatID sat(1, SatID::systemGPS);
+   CommonTime t(store.getInitialTime(sat) + 3600.0);
+   t.setTimeSystem(TimeSystem::UTC);
+
+   for (int frozen = 0; frozen < 2; frozen++)
+   {
+      if (frozen)
+         store.freezeIndex();
+      try
+      {
+         store.findUserOrbitEph(sat, t);
+         TUFAIL("Expected InvalidRequest for a UTC time");
+      }
+      catch (InvalidRequest& e)
+      {
+         TUPASS("InvalidRequest");
+      }
+   }
+
+   TURETURN();
+}
+
+
+int OrbitEphStore_T :: getXvtsTest( void )
+{
+   TUDEF("OrbitEphStore", "getXvts");
+
+   GPSEphemerisStore store;
+   loadStore(store);
+
+      // Every satellite every 10 minutes, beyond both ends of the store,
+      // with the time system of the last time of each satellite changed.
+   vector<SatID> sats;
+   vector<CommonTime> times;
+   for (int prn = 1; prn <= 32; prn++)
+   {
+      CommonTime t(store.getInitialTime() - 7200.0);
+      for (; t <= store.getFinalTime() + 7200.0; t += 600.0)
+      {
+         sats.push_back(SatID(prn, SatID::systemGPS));
+         times.push_back(t);
+      }
+      times.back().setTimeSystem(TimeSystem::UTC);
+   }
+
+   for (int test = 0; test < 4; test++)
+   {
+      if (test == 0)
+      {
+         store.SearchUser();
+         store.setOnlyHealthyFlag(false);
+      }
+      else if (test == 1)
+         store.setOnlyHealthyFlag(true);
+      else if (test == 2)
+      {
+         store.SearchNear();
+         store.freezeIndex();
+      }
+      else
+         store.setFastXvtsFlag(true);
+
+      vector<Xvt> xvts;
+      vector<bool> valid;
+      unsigned n = store.getXvts(sats, times, xvts, valid);
+      TUASSERTE(size_t, sats.size(), xvts.size());
+      TUASSERTE(size_t, sats.size(), valid.size());
+
+      unsigned expN = 0;
+      unsigned long mismatches = 0;
+      for (size_t i = 0; i < sats.size(); i++)
+      {
+         Xvt exp;
+         bool expValid = true;
+         try
+         {
+            exp = store.getXvt(sats[i], times[i]);
+            expN++;
+         }
+         catch (InvalidRequest&)
+         {
+            expValid = false;
+         }
+         if (valid[i] != expValid)
+            mismatches++;
+         else if (expValid)
+         {
+               // getXvts() matches getXvt() exactly, unless it goes
+               // through the multi-lane kernel, which agrees with
+               // svXvt() to well below 0.1 mm
+            const double tolX(test == 3 ? 1e-4 : 0.0);
+            const double tolV(test == 3 ? 1e-7 : 0.0);
+            const double tolT(test == 3 ? 1e-16 : 0.0);
+            for (int j = 0; j < 3; j++)
+            {
+               if (std::abs(xvts[i].x[j] - exp.x[j]) > tolX ||
+                   std::abs(xvts[i].v[j] - exp.v[j]) > tolV)
+                  mismatches++;
+            }
+            if (std::abs(xvts[i].clkbias - exp.clkbias) > tolT ||
+                std::abs(xvts[i].clkdrift - exp.clkdrift) > tolT ||
+                std::abs(xvts[i].relcorr - exp.relcorr) > tolT)
+               mismatches++;
+         }
+      }
+      TUASSERT(expN > 0);
+      TUASSERT(expN < sats.size());
+      TUASSERTE(unsigned, expN, n);
+      TUASSERTE(unsigned long, 0, mismatches);
+   }
+
+   TURETURN();
+}
+
+
+int main()
+{
+   int errorTotal = 0;
+   OrbitEphStore_T testClass;
+
+   errorTotal += testClass.indexTest();
+   errorTotal += testClass.thawTest();
+   errorTotal += testClass.timeSystemTest();
+   errorTotal += testClass.getXvtsTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return( errorTotal );
+}
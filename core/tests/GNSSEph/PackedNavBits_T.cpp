@@ -45,9 +45,12 @@
 #include "PackedNavBits.hpp"
 #include "SatID.hpp"
 #include "TestUtil.hpp"
+#include "TestSupport.hpp"
 #include "TimeString.hpp"
 #include "TimeSystem.hpp"
 
+#include <vector>
+
 using namespace std;
 using namespace gpstk;
 
@@ -61,6 +64,7 @@ public:
    unsigned abstractTest();
    unsigned realDataTest();
    unsigned equalityTest();
+   unsigned wordTest();
 
    double eps; 
 };
@@ -693,6 +697,160 @@ equalityTest()
    TURETURN();
 }
 
+   /* Check the packed storage against a bit-by-bit reference, for
+      fields that start and end anywhere within and across the 64-bit
+      storage words. */
+unsigned PackedNavBits_T ::
+wordTest()
+{
+   TUDEF("PackedNavBits", "asUnsignedLong");
+
+      // Pack 300 pseudo-random bits in fields of 1 to 32 bits, and
+      // keep a copy of each bit.
+   PackedNavBits pnb;
+   vector<bool> ref;
+   unsigned seed = 12345;
+   int length = 1;
+   while (ref.size() < 300)
+   {
+      int numBits = min<int>(length, 300 - ref.size());
+      unsigned long value = nextRandom(seed) & ((1UL << numBits) - 1);
+      pnb.addUnsignedLong(value, numBits, 1);
+      for (int b = numBits - 1; b >= 0; b--)
+         ref.push_back(((value >> b) & 1) != 0);
+      length = (length % 32) + 1;
+   }
+   pnb.trimsize();
+   TUASSERTE(size_t, 300, pnb.getNumBits());
+
+   const int lengths[] = { 1, 7, 30, 32, 33, 63, 64 };
+   unsigned long mismatch = 0;
+   for (unsigned l = 0; l < sizeof(lengths)/sizeof(lengths[0]); l++)
+   {
+      int numBits = lengths[l];
+      for (int start = 0; start + numBits <= 300; start++)
+      {
+         uint64_t expected = 0;
+         for (int b = start; b < start + numBits; b++)
+            expected = (expected << 1) | (ref[b] ? 1 : 0);
+
+         if (pnb.asUnsignedLong(start, numBits, 1) != (unsigned long)expected)
+            mismatch++;
+
+            // sign extension
+         int64_t sexp = (int64_t)expected;
+         if (numBits < 64 && ref[start])
+            sexp -= (int64_t)1 << numBits;
+         if (pnb.asLong(start, numBits, 1) != (long)sexp)
+            mismatch++;
+      }
+   }
+   TUASSERTE(unsigned long, 0, mismatch);
+
+   TUCSM("asScaledDoubles");
+   vector<PackedNavBits::ScaledField> fields;
+   for (int start = 0; start + 40 <= 300; start += 13)
+   {
+      PackedNavBits::ScaledField f;
+      f.startBit = start;
+      f.numBits = 1 + (start % 40);
+      f.power2 = (start % 7) - 30;
+      f.isSigned = ((start % 3) != 0);
+      f.semiCircles = ((start % 3) == 2);
+      fields.push_back(f);
+   }
+   vector<double> out;
+   pnb.asScaledDoubles(fields, out);
+   TUASSERTE(size_t, fields.size(), out.size());
+   mismatch = 0;
+   for (size_t i = 0; i < fields.size(); i++)
+   {
+      const PackedNavBits::ScaledField& f = fields[i];
+      double expected;
+      if (f.semiCircles)
+         expected = pnb.asDoubleSemiCircles(f.startBit, f.numBits, f.power2);
+      else if (f.isSigned)
+         expected = pnb.asSignedDouble(f.startBit, f.numBits, f.power2);
+      else
+         expected = pnb.asUnsignedDouble(f.startBit, f.numBits, f.power2);
+      if (expected != out[i])
+         mismatch++;
+   }
+   TUASSERTE(unsigned long, 0, mismatch);
+   try
+   {
+      PackedNavBits::ScaledField past = { 290, 11, 0, false, false };
+      pnb.asScaledDoubles(&past, 1, &out[0]);
+      TUFAIL("Field past the end was unpacked");
+   }
+   catch (InvalidParameter& e)
+   {
+      TUPASS("Field past the end rejected");
+   }
+
+   TUCSM("addPackedNavBits");
+      // Append at an offset that is not a multiple of the word size
+   PackedNavBits joined;
+   joined.addUnsignedLong(0x5a, 7, 1);
+   joined.addPackedNavBits(pnb);
+   TUASSERTE(size_t, 307, joined.getNumBits());
+   TUASSERTE(unsigned long, 0x5a, joined.asUnsignedLong(0, 7, 1));
+   mismatch = 0;
+   for (int start = 0; start + 32 <= 300; start++)
+   {
+      if (joined.asUnsignedLong(start + 7, 32, 1) !=
+          pnb.asUnsignedLong(start, 32, 1))
+         mismatch++;
+   }
+   TUASSERTE(unsigned long, 0, mismatch);
+
+   TUCSM("PackedNavBits");
+   PackedNavBits copy(pnb);
+   TUASSERTE(bool, true, copy.matchBits(pnb));
+   TUASSERTE(size_t, 300, copy.getNumBits());
+
+   TUCSM("matchBits");
+      // Differ in one bit in the second storage word
+   PackedNavBits left, right;
+   left.addUnsignedLong(0, 32, 1);
+   left.addUnsignedLong(0, 32, 1);
+   left.addUnsignedLong(0, 32, 1);
+   right.addUnsignedLong(0, 32, 1);
+   right.addUnsignedLong(0, 32, 1);
+   right.addUnsignedLong(0x40000000, 32, 1);
+   left.trimsize();
+   right.trimsize();
+   TUASSERTE(bool, false, left.matchBits(right));
+   TUASSERTE(bool, true, left.matchBits(right, 0, 64));
+   TUASSERTE(bool, false, left.matchBits(right, 60, 65));
+   TUASSERTE(bool, true, left.matchBits(right, 66, 95));
+
+   TUCSM("operator<");
+   TUASSERTE(bool, true, left < right);
+   TUASSERTE(bool, false, right < left);
+
+   TUCSM("addUnsignedLong");
+      // Grow past the initial 900 bits
+   PackedNavBits large;
+   for (unsigned long i = 0; i < 30; i++)
+      large.addUnsignedLong(i, 32, 1);
+   TUASSERTE(size_t, 960, large.getNumBits());
+   TUASSERTE(unsigned long, 29, large.asUnsignedLong(928, 32, 1));
+   TUASSERTE(unsigned long, 14, large.asUnsignedLong(448, 32, 1));
+   try
+   {
+      large.asUnsignedLong(950, 11, 1);
+      TUFAIL("Bits past the end were unpacked");
+   }
+   catch (InvalidParameter& e)
+   {
+      TUPASS("Bits past the end rejected");
+   }
+
+   TURETURN();
+}
+
+
 int main()
 {
    unsigned errorTotal = 0;
@@ -702,10 +860,9 @@ int main()
    errorTotal += testClass.abstractTest();
    errorTotal += testClass.realDataTest();
    errorTotal += testClass.equalityTest();
+   errorTotal += testClass.wordTest();
 
    cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
 
    return errorTotal; // Return the total number of errors
 }
-
-
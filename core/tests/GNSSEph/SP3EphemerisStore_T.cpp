@@ -270,6 +270,156 @@ public:
    }
 
 
+//=============================================================================
+// Test for getXvts.
+// Tests the getXvts method in SP3EphemerisStore by comparing its output
+// with getXvt for every satellite at times across an SP3 file, including
+// satellites and times that getXvt rejects
+//=============================================================================
+   int getXvtsTest (void)
+   {
+      TUDEF( "SP3EphemerisStore", "getXvts" );
+
+      try
+      {
+         SP3EphemerisStore store;
+         store.loadFile(inputSP3Data);
+
+         vector<SatID> sats;
+         vector<CommonTime> times;
+         CommonTime t(store.getInitialTime() - 900.0);
+         for (int prn = 0; prn <= 32; prn++)
+         {
+            for (int i = 0; i < 100; i++)
+            {
+               sats.push_back(SatID(prn,SatID::systemGPS));
+               times.push_back(t + 1000.0*i);
+            }
+         }
+
+         vector<Xvt> xvts;
+         vector<bool> valid;
+         unsigned n = store.getXvts(sats, times, xvts, valid);
+         TUASSERTE(size_t, sats.size(), xvts.size());
+         TUASSERTE(size_t, sats.size(), valid.size());
+
+         unsigned expN = 0;
+         unsigned long mismatches = 0;
+         for (size_t i = 0; i < sats.size(); i++)
+         {
+            bool expValid = true;
+            Xvt exp;
+            try
+            {
+               exp = store.getXvt(sats[i], times[i]);
+               expN++;
+            }
+            catch (InvalidRequest& e)
+            {
+               expValid = false;
+            }
+            if (expValid != valid[i])
+               mismatches++;
+            else if (expValid)
+            {
+               for (int j = 0; j < 3; j++)
+               {
+                  if (exp.x[j] != xvts[i].x[j] || exp.v[j] != xvts[i].v[j])
+                     mismatches++;
+               }
+               if (exp.clkbias != xvts[i].clkbias ||
+                   exp.clkdrift != xvts[i].clkdrift ||
+                   exp.relcorr != xvts[i].relcorr)
+                  mismatches++;
+            }
+         }
+         TUASSERT(expN > 0);
+         TUASSERT(expN < sats.size());
+         TUASSERTE(unsigned, expN, n);
+         TUASSERTE(unsigned long, 0, mismatches);
+
+            // Mismatched request vectors are rejected
+         times.pop_back();
+         try
+         {
+            store.getXvts(sats, times, xvts, valid);
+            TUFAIL("No exception thrown for mismatched request vectors");
+         }
+         catch (InvalidRequest& e)
+         {
+            TUPASS("Expected exception thrown for mismatched request vectors");
+         }
+      }
+      catch (...)
+      {
+         TUFAIL("Unexpected exception");
+      }
+
+      return testFramework.countFails();
+   }
+
+
+//=============================================================================
+// Test for interpolation orders above LagrangeWeights::MaxPoints
+// Tests that getXvt and getXvts work with a 36 point interpolation, and
+// agree with the usual 10 point one in the middle of the file
+//=============================================================================
+   int highOrderTest (void)
+   {
+      TUDEF( "SP3EphemerisStore", "setPositionInterpOrder" );
+
+      try
+      {
+         SP3EphemerisStore store, store10;
+         store.loadFile(inputSP3Data);
+         store10.loadFile(inputSP3Data);
+         store.setPositionInterpOrder(36);
+         store.setClockInterpOrder(36);
+         TUASSERTE(unsigned, 36, store.getPositionInterpOrder());
+
+         CommonTime t(store.getInitialTime());
+         t += 0.5 * (store.getFinalTime() - store.getInitialTime()) + 100.0;
+         vector<SatID> sats;
+         vector<CommonTime> times;
+         for (int prn = 1; prn <= 32; prn++)
+         {
+            sats.push_back(SatID(prn,SatID::systemGPS));
+            times.push_back(t);
+         }
+
+         vector<Xvt> xvts;
+         vector<bool> valid;
+         store.getXvts(sats, times, xvts, valid);
+         unsigned long tested = 0, mismatches = 0;
+         for (size_t i = 0; i < sats.size(); i++)
+         {
+            Xvt exp10, exp;
+            try
+            {
+               exp10 = store10.getXvt(sats[i], t);
+               exp = store.getXvt(sats[i], t);
+            }
+            catch (InvalidRequest& e)
+            {
+               continue;
+            }
+            tested++;
+            if (!valid[i] || (exp.x - xvts[i].x).mag() != 0.0 ||
+                (exp.x - exp10.x).mag() > 0.01)
+               mismatches++;
+         }
+         TUASSERT(tested > 0);
+         TUASSERTE(unsigned long, 0, mismatches);
+      }
+      catch (...)
+      {
+         TUFAIL("Unexpected exception");
+      }
+
+      return testFramework.countFails();
+   }
+
+
 //=============================================================================
 // Test for getInitialTime
 // Tests getInitialTime method in SP3EphemerisStore by ensuring that
@@ -535,6 +685,8 @@ int main() // Main function to initialize and run all tests above
 
    errorTotal += testClass.SP3ESTest();
    errorTotal += testClass.getXvtTest();
+   errorTotal += testClass.getXvtsTest();
+   errorTotal += testClass.highOrderTest();
    errorTotal += testClass.getInitialTimeTest();
    errorTotal += testClass.getFinalTimeTest();
    errorTotal += testClass.getPositionTest();
@@ -0,0 +1,160 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+
+/**
+ * Per-satellite geometry with dynamic and with fixed size types: the
+ * line of sight from a receiver is rotated into the local up/east/north
+ * frame (as ENUUtil does) and its elevation, azimuth and unit vector
+ * are formed. Reports time per satellite and heap allocations per
+ * satellite, counted by replacing the global operator new. Not run
+ * by ctest.
+ *
+ * Usage: FixedMatrixBench [satellites]
+ */
+
+#include "FixedMatrix.hpp"
+
+#include <cstdlib>
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+#include <new>
+
+using namespace std;
+using namespace gpstk;
+
+static unsigned long allocations = 0;
+
+void* operator new(size_t n) throw(std::bad_alloc)
+{
+   allocations++;
+   void *p = malloc(n ? n : 1);
+   if (!p)
+      throw std::bad_alloc();
+   return p;
+}
+
+void operator delete(void* p) throw()
+{
+   free(p);
+}
+
+   /// Rotation from ECEF to up, east, north at lat, lon (radians)
+static Matrix<double> dynamicRotation(double lat, double lon)
+{
+   Matrix<double> rot(3,3);
+   rot(0,0) =  cos(lat)*cos(lon);
+   rot(0,1) =  cos(lat)*sin(lon);
+   rot(0,2) =  sin(lat);
+   rot(1,0) = -sin(lon);
+   rot(1,1) =  cos(lon);
+   rot(1,2) =  0.0;
+   rot(2,0) = -sin(lat)*cos(lon);
+   rot(2,1) = -sin(lat)*sin(lon);
+   rot(2,2) =  cos(lat);
+   return rot;
+}
+
+   /// As dynamicRotation()
+static FixedMatrix<double,3,3> fixedRotationUEN(double lat, double lon)
+{
+   FixedMatrix<double,3,3> rot;
+   rot(0,0) =  cos(lat)*cos(lon);
+   rot(0,1) =  cos(lat)*sin(lon);
+   rot(0,2) =  sin(lat);
+   rot(1,0) = -sin(lon);
+   rot(1,1) =  cos(lon);
+   rot(1,2) =  0.0;
+   rot(2,0) = -sin(lat)*cos(lon);
+   rot(2,1) = -sin(lat)*sin(lon);
+   rot(2,2) =  cos(lat);
+   return rot;
+}
+
+int main(int argc, char *argv[])
+{
+   const int nsat = (argc > 1 ? atoi(argv[1]) : 2000000);
+   const double lat = 0.52, lon = -1.70;
+   const Triple rx(-740289.9, -5457071.7, 3207245.6);
+
+   double sumD = 0.0, sumF = 0.0;
+   unsigned long allocD, allocF;
+   clock_t t0, t1, t2;
+
+   allocations = 0;
+   t0 = clock();
+   for (int s = 0; s < nsat; s++)
+   {
+      Triple sv(15e6 + s % 997, -12e6 + s % 991, 18e6);
+      Triple u((sv - rx).unitVector());
+      Vector<double> los(3);
+      for (int i = 0; i < 3; i++) los[i] = u[i];
+      Vector<double> uen(dynamicRotation(lat, lon) * los);
+      double el = asin(uen[0]), az = atan2(uen[1], uen[2]);
+      sumD += el + az;
+   }
+   t1 = clock();
+   allocD = allocations;
+
+   allocations = 0;
+   FixedVector<double,3> frx(rx);
+   for (int s = 0; s < nsat; s++)
+   {
+      FixedVector<double,3> sv;
+      sv[0] = 15e6 + s % 997; sv[1] = -12e6 + s % 991; sv[2] = 18e6;
+      FixedVector<double,3> los((sv - frx).unitVector());
+      FixedVector<double,3> uen(fixedRotationUEN(lat, lon) * los);
+      double el = asin(uen[0]), az = atan2(uen[1], uen[2]);
+      sumF += el + az;
+   }
+   t2 = clock();
+   allocF = allocations;
+
+   const double ns = 1e9 / CLOCKS_PER_SEC / nsat;
+   cout << setw(10) << "types" << setw(14) << "ns/satellite "
+        << setw(16) << "allocs/satellite" << endl;
+   cout << fixed << setprecision(1);
+   cout << setw(10) << "dynamic" << setw(14) << (t1 - t0) * ns
+        << setw(16) << double(allocD) / nsat << endl;
+   cout << setw(10) << "fixed" << setw(14) << (t2 - t1) * ns
+        << setw(16) << double(allocF) / nsat << endl;
+   cout << "speedup " << setprecision(2) << double(t1 - t0) / (t2 - t1)
+        << ", checksum difference " << setprecision(3) << scientific
+        << sumD - sumF << endl;
+
+   return 0;
+}
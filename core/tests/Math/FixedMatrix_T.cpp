@@ -0,0 +1,298 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+
+   /* Check FixedMatrix and FixedVector against the dynamic Matrix,
+    * Vector and Triple they stand in for. */
+
+#include "FixedMatrix.hpp"
+#include "TestUtil.hpp"
+
+#include <cmath>
+#include <iostream>
+
+using namespace std;
+using namespace gpstk;
+
+
+class FixedMatrix_T
+{
+public:
+
+      // return values indicate number of failures, i.e., 0=PASS, !0=FAIL
+   int conversionTest( void );
+   int productTest( void );
+   int rotationTest( void );
+   int vectorTest( void );
+   int exceptionTest( void );
+
+private:
+
+      /// A 3x4 matrix of distinct values, as row major array
+   static const double rowMajor[12];
+
+   static const double eps;
+};
+
+const double FixedMatrix_T::rowMajor[12] =
+{  1.5, -2.0,  0.25,  4.0,
+   0.5,  3.0, -1.75,  2.0,
+  -6.0,  1.0,  2.5,  -0.5 };
+
+const double FixedMatrix_T::eps = 1e-14;
+
+
+int FixedMatrix_T::conversionTest( void )
+{
+   TUDEF("FixedMatrix", "conversion");
+
+   FixedMatrix<double,3,4> F(rowMajor);
+   Matrix<double> M(3,4);
+   M = rowMajor;
+
+   TUASSERTE(size_t, 3, F.rows());
+   TUASSERTE(size_t, 4, F.cols());
+   TUASSERTE(size_t, 12, F.size());
+
+      // the array constructor reads row major, as Matrix::operator= does
+   for (size_t i = 0; i < 3; i++)
+      for (size_t j = 0; j < 4; j++)
+         TUASSERTE(double, M(i,j), F(i,j));
+
+   Matrix<double> back(F.toMatrix());
+   TUASSERTE(size_t, 3, back.rows());
+   TUASSERTE(size_t, 4, back.cols());
+   for (size_t i = 0; i < 3; i++)
+      for (size_t j = 0; j < 4; j++)
+         TUASSERTE(double, M(i,j), back(i,j));
+
+   FixedMatrix<double,3,4> G(M);
+   for (size_t i = 0; i < 3; i++)
+      for (size_t j = 0; j < 4; j++)
+         TUASSERTE(double, M(i,j), G(i,j));
+
+   FixedMatrix<double,4,4> I(FixedMatrix<double,4,4>::identity());
+   for (size_t i = 0; i < 4; i++)
+      for (size_t j = 0; j < 4; j++)
+         TUASSERTE(double, (i == j ? 1.0 : 0.0), I(i,j));
+
+   FixedMatrix<double,4,3> T(transpose(F));
+   for (size_t i = 0; i < 3; i++)
+      for (size_t j = 0; j < 4; j++)
+         TUASSERTE(double, F(i,j), T(j,i));
+
+   Triple t(1.0, -2.0, 3.0);
+   FixedVector<double,3> v(t);
+   TUASSERTE(size_t, 3, v.size());
+   TUASSERTE(double, -2.0, v[1]);
+   TUASSERTE(double, -2.0, v(1));
+   TUASSERTE(Triple, t, v.toTriple());
+
+   Vector<double> x(v.toVector());
+   TUASSERTE(size_t, 3, x.size());
+   TUASSERTE(double, 3.0, x[2]);
+   FixedVector<double,3> w(x);
+   TUASSERTE(double, 1.0, w[0]);
+
+   TURETURN();
+}
+
+
+int FixedMatrix_T::productTest( void )
+{
+   TUDEF("FixedMatrix", "operator*");
+
+   FixedMatrix<double,3,4> F(rowMajor);
+   Matrix<double> M(F.toMatrix());
+
+   FixedMatrix<double,3,3> FFt(F * transpose(F));
+   Matrix<double> MMt(M * transpose(M));
+   for (size_t i = 0; i < 3; i++)
+      for (size_t j = 0; j < 3; j++)
+         TUASSERTFEPS(FFt(i,j), MMt(i,j), eps);
+
+   FixedMatrix<double,4,4> FtF(transpose(F) * F);
+   Matrix<double> MtM(transpose(M) * M);
+   for (size_t i = 0; i < 4; i++)
+      for (size_t j = 0; j < 4; j++)
+         TUASSERTFEPS(FtF(i,j), MtM(i,j), eps);
+
+   const double xa[4] = { 0.5, -1.0, 2.0, 0.125 };
+   FixedVector<double,4> fx(xa);
+   Vector<double> vx(fx.toVector());
+   FixedVector<double,3> fy(F * fx);
+   Vector<double> vy(M * vx);
+   for (size_t i = 0; i < 3; i++)
+      TUASSERTFEPS(fy[i], vy[i], eps);
+
+      // v * F is transpose(F) * v
+   FixedVector<double,4> fz(fy * F);
+   Vector<double> vz(transpose(M) * vy);
+   for (size_t i = 0; i < 4; i++)
+      TUASSERTFEPS(fz[i], vz[i], eps);
+
+   FixedMatrix<double,3,4> S(F + F * 2.0 - 0.5 * F);
+   for (size_t i = 0; i < 3; i++)
+      for (size_t j = 0; j < 4; j++)
+         TUASSERTFEPS(S(i,j), 2.5 * M(i,j), eps);
+
+   FixedMatrix<double,3,3> R(FFt);
+   Triple t(1.0, 2.0, -3.0);
+   Triple rt(R * t);
+   FixedVector<double,3> rv(R * FixedVector<double,3>(t));
+   for (size_t i = 0; i < 3; i++)
+      TUASSERTFEPS(rt[i], rv[i], eps);
+
+   TURETURN();
+}
+
+
+int FixedMatrix_T::rotationTest( void )
+{
+   TUDEF("FixedMatrix", "fixedRotation");
+
+   const double angles[3] = { 0.3, -1.2, 2.9 };
+   for (int axis = 1; axis <= 3; axis++)
+   {
+      FixedMatrix<double,3,3> F(fixedRotation(angles[axis-1], axis));
+      Matrix<double> M(rotation(angles[axis-1], axis));
+      for (size_t i = 0; i < 3; i++)
+         for (size_t j = 0; j < 3; j++)
+            TUASSERTE(double, M(i,j), F(i,j));
+
+         // orthonormal
+      FixedMatrix<double,3,3> I(F * transpose(F));
+      for (size_t i = 0; i < 3; i++)
+         for (size_t j = 0; j < 3; j++)
+            TUASSERTFEPS(I(i,j), (i == j ? 1.0 : 0.0), eps);
+   }
+
+   TURETURN();
+}
+
+
+int FixedMatrix_T::vectorTest( void )
+{
+   TUDEF("FixedVector", "dot");
+
+   Triple a(1.0, 2.0, 3.0), b(-4.0, 0.5, 2.0);
+   FixedVector<double,3> fa(a), fb(b);
+
+   TUASSERTFEPS(fa.dot(fb), a.dot(b), eps);
+   TUCSM("mag");
+   TUASSERTFEPS(fa.mag(), a.mag(), eps);
+   TUCSM("cross");
+   TUASSERTE(Triple, a.cross(b), cross(fa, fb).toTriple());
+   TUCSM("unitVector");
+   Triple ua(a.unitVector());
+   FixedVector<double,3> fua(fa.unitVector());
+   for (size_t i = 0; i < 3; i++)
+      TUASSERTFEPS(fua[i], ua[i], eps);
+
+   TUCSM("operator+");
+   FixedVector<double,3> s(fa + fb * 2.0 - 0.5 * fa);
+   for (size_t i = 0; i < 3; i++)
+      TUASSERTFEPS(s[i], 0.5 * a[i] + 2.0 * b[i], eps);
+
+   TURETURN();
+}
+
+
+int FixedMatrix_T::exceptionTest( void )
+{
+   TUDEF("FixedMatrix", "exceptions");
+
+   Matrix<double> M(3,4,1.0);
+   try
+   {
+      FixedMatrix<double,3,3> F(M);
+      TUFAIL("Expected MatrixException for a 3x4 Matrix");
+   }
+   catch (MatrixException& e)
+   {
+      TUPASS("MatrixException");
+   }
+
+   Vector<double> x(4,1.0);
+   try
+   {
+      FixedVector<double,3> v(x);
+      TUFAIL("Expected VectorException for a 4-Vector");
+   }
+   catch (VectorException& e)
+   {
+      TUPASS("VectorException");
+   }
+
+   try
+   {
+      fixedRotation(0.5, 4);
+      TUFAIL("Expected MatrixException for axis 4");
+   }
+   catch (MatrixException& e)
+   {
+      TUPASS("MatrixException");
+   }
+
+   try
+   {
+      FixedVector<double,3>(0.0).unitVector();
+      TUFAIL("Expected GeometryException for a zero vector");
+   }
+   catch (GeometryException& e)
+   {
+      TUPASS("GeometryException");
+   }
+
+   TURETURN();
+}
+
+
+int main()
+{
+   int errorTotal = 0;
+   FixedMatrix_T testClass;
+
+   errorTotal += testClass.conversionTest();
+   errorTotal += testClass.productTest();
+   errorTotal += testClass.rotationTest();
+   errorTotal += testClass.vectorTest();
+   errorTotal += testClass.exceptionTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return( errorTotal );
+}
@@ -0,0 +1,262 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+   /* Check LagrangeWeights against LagrangeInterpolation() of
+    * MiscMath.hpp, and its reuse of the weights. */
+
+#include "LagrangeWeights.hpp"
+#include "MiscMath.hpp"
+#include "TestUtil.hpp"
+
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+using namespace std;
+using namespace gpstk;
+
+
+class LagrangeWeights_T
+{
+public:
+
+   LagrangeWeights_T();
+
+      // return values indicate number of failures, i.e., 0=PASS, !0=FAIL
+   int valueTest( void );
+   int value4Test( void );
+   int reuseTest( void );
+   int exceptionTest( void );
+   int largeTest( void );
+
+private:
+
+      /// Nodes every 900 s, as an SP3 table, and the series on them
+   vector<double> X, Y[4];
+   vector<double> Y4;
+};
+
+
+LagrangeWeights_T :: LagrangeWeights_T()
+{
+   for (int i = 0; i < 10; i++)
+   {
+      double t = 900.0 * i;
+      X.push_back(t);
+      Y[0].push_back(26560.0 * cos(1.4544e-4 * t));
+      Y[1].push_back(26560.0 * sin(1.4544e-4 * t + 0.3));
+      Y[2].push_back(1.0e-4 * t * t - 3.0 * t + 17.0);
+      Y[3].push_back(exp(-t / 8000.0));
+      for (int c = 0; c < 4; c++)
+         Y4.push_back(Y[c][i]);
+   }
+}
+
+
+   /* Values and derivatives within the center interval, and at the
+    * nodes, where the value must be exact. */
+int LagrangeWeights_T :: valueTest( void )
+{
+   TUDEF("LagrangeWeights", "value");
+
+   LagrangeWeights lw;
+   const double xs[] = { 4050.0, 4000.0, 4400.0, 3600.0, 4500.0 };
+   for (int k = 0; k < 5; k++)
+   {
+      lw.compute(&X[0], X.size(), xs[k]);
+      TUASSERTE(size_t, X.size(), lw.size());
+      for (int c = 0; c < 4; c++)
+      {
+         double err, y, dydx;
+         double exp = LagrangeInterpolation(X, Y[c], xs[k], err);
+         LagrangeInterpolation(X, Y[c], xs[k], y, dydx);
+         double scale = fabs(exp) + 1.0;
+         TUASSERTFEPS(exp, lw.value(&Y[c][0]), 1.0e-13 * scale);
+         TUASSERTFEPS(dydx, lw.derivative(&Y[c][0]),
+                      1.0e-13 * (fabs(dydx) + 1.0e-3 * scale));
+      }
+   }
+
+   for (size_t i = 0; i < X.size(); i++)
+   {
+      lw.compute(&X[0], X.size(), X[i]);
+      for (int c = 0; c < 4; c++)
+         TUASSERTFE(Y[c][i], lw.value(&Y[c][0]));
+   }
+
+   TURETURN();
+}
+
+
+   /* The four interleaved series at once, on whichever SIMD path the
+    * library was built with, match the series one at a time. */
+int LagrangeWeights_T :: value4Test( void )
+{
+   TUDEF("LagrangeWeights", "value4");
+
+   LagrangeWeights lw;
+   for (double x = 3600.0; x <= 4500.0; x += 37.0)
+   {
+      lw.compute(&X[0], X.size(), x);
+      double val[4], der[4];
+      lw.value4(&Y4[0], val);
+      lw.derivative4(&Y4[0], der);
+      for (int c = 0; c < 4; c++)
+      {
+         TUASSERTFE(lw.value(&Y[c][0]), val[c]);
+         TUASSERTFE(lw.derivative(&Y[c][0]), der[c]);
+      }
+   }
+
+   TURETURN();
+}
+
+
+int LagrangeWeights_T :: reuseTest( void )
+{
+   TUDEF("LagrangeWeights", "compute");
+
+   LagrangeWeights lw;
+   TUASSERTE(unsigned long, 0, lw.getComputeCount());
+   lw.compute(&X[0], X.size(), 4123.0);
+   lw.compute(&X[0], X.size(), 4123.0);
+   TUASSERTE(unsigned long, 1, lw.getComputeCount());
+
+      // same offsets, from a copy of the nodes
+   vector<double> X2(X);
+   lw.compute(&X2[0], X2.size(), 4123.0);
+   TUASSERTE(unsigned long, 1, lw.getComputeCount());
+
+   lw.compute(&X[0], X.size(), 4124.0);
+   TUASSERTE(unsigned long, 2, lw.getComputeCount());
+   X2[9] += 1.0;
+   lw.compute(&X2[0], X2.size(), 4124.0);
+   TUASSERTE(unsigned long, 3, lw.getComputeCount());
+   lw.compute(&X2[0], 8, 4124.0);
+   TUASSERTE(unsigned long, 4, lw.getComputeCount());
+   TUASSERTE(size_t, 8, lw.size());
+
+   TURETURN();
+}
+
+
+int LagrangeWeights_T :: exceptionTest( void )
+{
+   TUDEF("LagrangeWeights", "compute");
+
+   LagrangeWeights lw;
+   vector<double> big(LagrangeWeights::MaxPoints);
+   for (size_t i = 0; i < big.size(); i++)
+      big[i] = double(i);
+
+   try
+   {
+      lw.compute(&big[0], 1, 0.5);
+      TUFAIL("Expected InvalidRequest for one node");
+   }
+   catch (InvalidRequest& e)
+   {
+      TUPASS("InvalidRequest");
+   }
+
+   lw.compute(&big[0], LagrangeWeights::MaxPoints, 10.5);
+   TUASSERTE(size_t, LagrangeWeights::MaxPoints, lw.size());
+
+   TURETURN();
+}
+
+
+   /* More nodes than MaxPoints are kept on the heap, and give the
+    * same results as LagrangeInterpolation(). */
+int LagrangeWeights_T :: largeTest( void )
+{
+   TUDEF("LagrangeWeights", "compute");
+
+   const size_t n = 40;
+   vector<double> big, Yb, Y4b;
+   for (size_t i = 0; i < n; i++)
+   {
+      double t = double(i);
+      big.push_back(t);
+      Yb.push_back(0.5 * t * t * t - 20.0 * t * t + t + 3.0);
+      for (int c = 0; c < 4; c++)
+         Y4b.push_back((c + 1) * Yb[i]);
+   }
+
+   LagrangeWeights lw;
+   lw.compute(&big[0], n, 19.25);
+   TUASSERTE(size_t, n, lw.size());
+   double err, y, dydx;
+   double exp = LagrangeInterpolation(big, Yb, 19.25, err);
+   LagrangeInterpolation(big, Yb, 19.25, y, dydx);
+   double scale = fabs(exp) + 1.0;
+   TUASSERTFEPS(exp, lw.value(&Yb[0]), 1.0e-6 * scale);
+   TUASSERTFEPS(dydx, lw.derivative(&Yb[0]), 1.0e-6 * scale);
+
+   double out[4];
+   lw.value4(&Y4b[0], out);
+   for (int c = 0; c < 4; c++)
+      TUASSERTFEPS(out[c], (c + 1) * lw.value(&Yb[0]), 1.0e-13 * scale);
+
+      // the weights on the heap are reused like the fixed ones
+   lw.compute(&big[0], n, 19.25);
+   TUASSERTE(unsigned long, 1, lw.getComputeCount());
+
+      // and back to the fixed storage
+   lw.compute(&X[0], X.size(), 4050.0);
+   TUASSERTE(size_t, X.size(), lw.size());
+   TUASSERTFEPS(LagrangeInterpolation(X, Y[0], 4050.0, err),
+                lw.value(&Y[0][0]), 1.0e-13 * 26560.0);
+
+   TURETURN();
+}
+
+
+int main()
+{
+   int errorTotal = 0;
+   LagrangeWeights_T testClass;
+
+   errorTotal += testClass.valueTest();
+   errorTotal += testClass.value4Test();
+   errorTotal += testClass.reuseTest();
+   errorTotal += testClass.exceptionTest();
+   errorTotal += testClass.largeTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return( errorTotal );
+}
@@ -0,0 +1,188 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+/**
+ * Rate of square Matrix<double> products from 4x4 to 500x500: the
+ * element-by-element triple loop that operator* used to be, operator*
+ * itself, multiplyInto() into reused storage, the product chain
+ * phi*P*transpose(phi) with and without temporaries, normal matrices
+ * transpose(A)*A, and matrix times vector. Not run by ctest.
+ *
+ * Usage: MatrixBench [size ...]
+ */
+
+#include "Matrix.hpp"
+#include "TestSupport.hpp"
+
+#include <cstdlib>
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+using namespace std;
+using namespace gpstk;
+
+   /// The product as computed before the kernels, through operator()
+static void naiveMultiply(Matrix<double>& C, const Matrix<double>& A,
+                          const Matrix<double>& B)
+{
+   C.resize(A.rows(), B.cols(), 0.0);
+   for (size_t i = 0; i < C.rows(); i++)
+      for (size_t j = 0; j < C.cols(); j++)
+         for (size_t k = 0; k < A.cols(); k++)
+            C(i,j) += A(i,k) * B(k,j);
+}
+
+static Matrix<double> fill(size_t n, unsigned seed)
+{
+   Matrix<double> m(n, n);
+   for (size_t j = 0; j < n; j++)
+      for (size_t i = 0; i < n; i++)
+         m(i,j) = uniform(seed);
+   return m;
+}
+
+   /// microseconds per call since start, for reps calls
+static double usec(clock_t start, int reps)
+{
+   return double(clock() - start) / CLOCKS_PER_SEC * 1.0e6 / reps;
+}
+
+
+int main(int argc, char *argv[])
+{
+   vector<size_t> sizes;
+   for (int i = 1; i < argc; i++)
+      sizes.push_back(atol(argv[i]));
+   if (sizes.empty())
+   {
+      const size_t def[] = { 4, 8, 16, 32, 64, 128, 256, 500 };
+      sizes.assign(def, def + sizeof(def)/sizeof(def[0]));
+   }
+
+   cout << "microseconds per call; GFLOP/s is that of multiplyInto"
+        << endl
+        << setw(5) << "n" << setw(12) << "naive" << setw(12) << "operator*"
+        << setw(12) << "multInto" << setw(9) << "GFLOP/s"
+        << setw(12) << "PhiPPhiT" << setw(12) << "inPlace"
+        << setw(12) << "ATA" << setw(12) << "normal"
+        << setw(10) << "A*x" << setw(10) << "naiveAx" << endl;
+
+   double check = 0.0;
+   for (size_t s = 0; s < sizes.size(); s++)
+   {
+      const size_t n(sizes[s]);
+      const double flops(2.0 * n * n * n);
+      const int reps(max(1, int(2.0e7 / flops)));
+      Matrix<double> A(fill(n, 1)), B(fill(n, 2)), C, W;
+      Vector<double> x(n, 0.5), y;
+      clock_t start;
+
+      start = clock();
+      for (int r = 0; r < reps; r++)
+         naiveMultiply(C, A, B);
+      double tNaive = usec(start, reps);
+      check += C(0,0);
+
+      start = clock();
+      for (int r = 0; r < reps; r++)
+         check += (A * B)(0,0);
+      double tOp = usec(start, reps);
+
+      start = clock();
+      for (int r = 0; r < reps; r++)
+         multiplyInto(C, A, B);
+      double tInto = usec(start, reps);
+      check += C(0,0);
+
+      start = clock();
+      for (int r = 0; r < reps; r++)
+         C = A * B * transpose(A);
+      double tChain = usec(start, reps);
+
+      start = clock();
+      for (int r = 0; r < reps; r++)
+      {
+         multiplyInto(W, A, B);
+         multiplyTransposeInto(C, W, A);
+      }
+      double tChainInto = usec(start, reps);
+      check += C(0,0);
+
+      start = clock();
+      for (int r = 0; r < reps; r++)
+         C = transpose(A) * A;
+      double tATA = usec(start, reps);
+
+      start = clock();
+      for (int r = 0; r < reps; r++)
+         normalInto(C, A);
+      double tNormal = usec(start, reps);
+      check += C(0,0);
+
+      const int vreps(reps * int(n));
+      start = clock();
+      for (int r = 0; r < vreps; r++)
+         multiplyInto(y, A, x);
+      double tAx = usec(start, vreps);
+
+      start = clock();
+      for (int r = 0; r < vreps; r++)
+      {
+         y.resize(n, 0.0);
+         for (size_t i = 0; i < n; i++)
+            for (size_t j = 0; j < n; j++)
+               y[i] += A(i,j) * x[j];
+      }
+      double tNaiveAx = usec(start, vreps);
+      check += y[0];
+
+      cout << setw(5) << n << fixed << setprecision(3)
+           << setw(12) << tNaive << setw(12) << tOp << setw(12) << tInto
+           << setprecision(2) << setw(9) << flops / tInto * 1.0e-3
+           << setprecision(3)
+           << setw(12) << tChain << setw(12) << tChainInto
+           << setw(12) << tATA << setw(12) << tNormal
+           << setw(10) << tAx << setw(10) << tNaiveAx << endl;
+   }
+
+      // keep the results live
+   if (check == 1.0e300)
+      cout << "checksum" << endl;
+
+   return 0;
+}
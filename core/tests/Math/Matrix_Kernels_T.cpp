@@ -0,0 +1,349 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+   /* Check the multiplication kernels of MatrixKernels.hpp, through
+    * the operators and multiplyInto() and its relatives, against
+    * plain triple loops, on shapes that do and do not fill the
+    * register tiles and cache blocks. */
+
+#include "Matrix.hpp"
+#include "TestUtil.hpp"
+#include "TestSupport.hpp"
+
+#include <cmath>
+#include <iostream>
+
+using namespace std;
+using namespace gpstk;
+
+
+class Matrix_Kernels_T
+{
+public:
+
+      // return values indicate number of failures, i.e., 0=PASS, !0=FAIL
+   int gemmTest( void );
+   int transposeTest( void );
+   int vectorTest( void );
+   int normalTest( void );
+   int aliasTest( void );
+   int floatTest( void );
+   int exceptionTest( void );
+
+private:
+
+      /// A matrix of reproducible values in [-1,1)
+   template <class T>
+   static Matrix<T> fill(size_t r, size_t c, unsigned seed)
+   {
+      Matrix<T> m(r, c);
+      for (size_t j = 0; j < c; j++)
+         for (size_t i = 0; i < r; i++)
+            m(i,j) = T(uniform(seed));
+      return m;
+   }
+
+      /// A * B by the definition
+   static Matrix<double> ref(const Matrix<double>& A, const Matrix<double>& B)
+   {
+      Matrix<double> C(A.rows(), B.cols(), 0.0);
+      for (size_t i = 0; i < A.rows(); i++)
+         for (size_t j = 0; j < B.cols(); j++)
+         {
+            double sum = 0.0;
+            for (size_t k = 0; k < A.cols(); k++)
+               sum += A(i,k) * B(k,j);
+            C(i,j) = sum;
+         }
+      return C;
+   }
+
+      /// largest difference between a and b, relative to the inner size
+   static double diff(const Matrix<double>& a, const Matrix<double>& b)
+   {
+      double d = (a.rows() == b.rows() && a.cols() == b.cols()) ? 0.0 : 1.0;
+      for (size_t i = 0; d < 1.0 && i < a.rows(); i++)
+         for (size_t j = 0; j < a.cols(); j++)
+            d = std::max(d, std::abs(a(i,j) - b(i,j)));
+      return d;
+   }
+};
+
+   /// shapes m, n, k covering tile and block edges
+static const size_t shapes[][3] = {
+   { 1, 1, 1 }, { 4, 4, 4 }, { 8, 4, 4 }, { 3, 5, 7 }, { 9, 7, 4 },
+   { 17, 13, 11 }, { 32, 4, 1 }, { 1, 33, 9 }, { 130, 131, 129 },
+   { 259, 37, 300 }, { 6, 6, 0 }
+};
+static const size_t nShapes = sizeof(shapes) / sizeof(shapes[0]);
+
+
+int Matrix_Kernels_T :: gemmTest( void )
+{
+   TUDEF("Matrix", "operator*");
+
+   for (size_t s = 0; s < nShapes; s++)
+   {
+      Matrix<double> A(fill<double>(shapes[s][0], shapes[s][2], 1+s));
+      Matrix<double> B(fill<double>(shapes[s][2], shapes[s][1], 99+s));
+      Matrix<double> R(ref(A, B)), C;
+      double eps = 1.0e-14 * (shapes[s][2] + 1);
+
+      TUASSERTFEPS(0.0, diff(R, A * B), eps);
+      TUASSERTFEPS(0.0, diff(R, multiplyInto(C, A, B)), eps);
+
+         // the generic path, through slices
+      MatrixSlice<double> As(A), Bs(B);
+      TUASSERTFEPS(0.0, diff(R, As * Bs), eps);
+
+         // kernel accumulation
+      if (C.size())
+      {
+         gemmKernel(A.rows(), B.cols(), A.cols(), A.begin(), B.begin(),
+                    C.begin(), true);
+         TUASSERTFEPS(0.0, diff(R * 2.0, C), 2.0 * eps);
+      }
+   }
+
+   TURETURN();
+}
+
+
+int Matrix_Kernels_T :: transposeTest( void )
+{
+   TUDEF("Matrix", "transposeMultiplyInto");
+
+   for (size_t s = 0; s < nShapes; s++)
+   {
+      Matrix<double> A(fill<double>(shapes[s][0], shapes[s][2], 3+s));
+      Matrix<double> B(fill<double>(shapes[s][2], shapes[s][1], 7+s));
+      Matrix<double> R(ref(A, B)), C;
+      Matrix<double> AT(transpose(A)), BT(transpose(B));
+      double eps = 1.0e-14 * (shapes[s][2] + 1);
+
+      TUASSERTFEPS(0.0, diff(R, transposeMultiplyInto(C, AT, B)), eps);
+      TUASSERTFEPS(0.0, diff(R, multiplyTransposeInto(C, A, BT)), eps);
+   }
+
+   TURETURN();
+}
+
+
+int Matrix_Kernels_T :: vectorTest( void )
+{
+   TUDEF("Matrix", "operator*(Vector)");
+
+   for (size_t s = 0; s < nShapes; s++)
+   {
+      Matrix<double> A(fill<double>(shapes[s][0], shapes[s][1], 5+s));
+      Matrix<double> X(fill<double>(shapes[s][1], 1, 11+s));
+      Matrix<double> Y(fill<double>(1, shapes[s][0], 13+s));
+      Vector<double> x(X.size()), y(Y.size()), z;
+      for (size_t i = 0; i < x.size(); i++)
+         x[i] = X(i,0);
+      for (size_t i = 0; i < y.size(); i++)
+         y[i] = Y(0,i);
+      Matrix<double> Ax(ref(A, X)), yA(ref(Y, A));
+      double eps = 1.0e-14 * (A.rows() + A.cols() + 1);
+
+      Vector<double> v(A * x);
+      TUASSERTFEPS(0.0, diff(Ax, Matrix<double>(v.size(), 1, v)), eps);
+      multiplyInto(z, A, x);
+      TUASSERTFEPS(0.0, diff(Ax, Matrix<double>(z.size(), 1, z)), eps);
+
+      v = y * A;
+      TUASSERTFEPS(0.0, diff(yA, Matrix<double>(1, v.size(), v)), eps);
+      transposeMultiplyInto(z, A, y);
+      TUASSERTFEPS(0.0, diff(yA, Matrix<double>(1, z.size(), z)), eps);
+   }
+
+   TURETURN();
+}
+
+
+int Matrix_Kernels_T :: normalTest( void )
+{
+   TUDEF("Matrix", "normalInto");
+
+   for (size_t s = 0; s < nShapes; s++)
+   {
+      Matrix<double> A(fill<double>(shapes[s][0], shapes[s][1], 17+s));
+      Matrix<double> W(A.rows(), A.rows(), 0.0), C, work;
+      Vector<double> w(A.rows());
+      for (size_t i = 0; i < w.size(); i++)
+         W(i,i) = w[i] = 0.5 + double(i % 5);
+      double eps = 1.0e-13 * (A.rows() + 1);
+
+      Matrix<double> AT(transpose(A));
+      Matrix<double> R(ref(AT, A)), RW(ref(ref(AT, W), A));
+
+      normalInto(C, A);
+      TUASSERTFEPS(0.0, diff(R, C), eps);
+      TUASSERTE(double, 0.0, diff(C, transpose(C)));
+      normalInto(C, A, w);
+      TUASSERTFEPS(0.0, diff(RW, C), 5.0 * eps);
+      TUASSERTE(double, 0.0, diff(C, transpose(C)));
+      normalInto(C, A, W, work);
+      TUASSERTFEPS(0.0, diff(RW, C), 5.0 * eps);
+   }
+
+   TURETURN();
+}
+
+
+   /* Outputs that are also inputs, and reuse of the output storage. */
+int Matrix_Kernels_T :: aliasTest( void )
+{
+   TUDEF("Matrix", "multiplyInto");
+
+   Matrix<double> A(fill<double>(6, 6, 23)), B(fill<double>(6, 6, 29));
+   Matrix<double> R(ref(A, B)), C(A);
+   multiplyInto(C, C, B);
+   TUASSERTFEPS(0.0, diff(R, C), 1.0e-14);
+   C = B;
+   multiplyInto(C, A, C);
+   TUASSERTFEPS(0.0, diff(R, C), 1.0e-14);
+   C = A;
+   multiplyTransposeInto(C, C, C);
+   TUASSERTFEPS(0.0, diff(ref(A, transpose(A)), C), 1.0e-14);
+
+   Vector<double> x(6);
+   for (size_t i = 0; i < 6; i++)
+      x[i] = double(i) - 2.5;
+   Vector<double> y(A * x);
+   multiplyInto(x, A, x);
+   for (size_t i = 0; i < 6; i++)
+      TUASSERTFEPS(y[i], x[i], 1.0e-14);
+
+      // a smaller product into the same storage
+   const double *storage = C.begin();
+   multiplyInto(C, Matrix<double>(A, 0, 0, 3, 6), B);
+   TUASSERTE(size_t, 3, C.rows());
+   TUASSERTE(size_t, 6, C.cols());
+   TUASSERT(storage == C.begin());
+   TUASSERTFEPS(0.0, diff(Matrix<double>(R, 0, 0, 3, 6), C), 1.0e-14);
+
+   TURETURN();
+}
+
+
+   /* Types other than double use the template kernels. */
+int Matrix_Kernels_T :: floatTest( void )
+{
+   TUDEF("Matrix", "operator*");
+
+   Matrix<float> A(fill<float>(9, 5, 31)), B(fill<float>(5, 7, 37));
+   Matrix<float> C(A * B);
+   Matrix<float> D(transpose(A)), E;
+   transposeMultiplyInto(E, D, B);
+   for (size_t i = 0; i < 9; i++)
+      for (size_t j = 0; j < 7; j++)
+      {
+         float sum = 0.0f;
+         for (size_t k = 0; k < 5; k++)
+            sum += A(i,k) * B(k,j);
+         TUASSERTFEPS(double(sum), double(C(i,j)), 1.0e-5);
+         TUASSERTFEPS(double(sum), double(E(i,j)), 1.0e-5);
+      }
+
+   TURETURN();
+}
+
+
+int Matrix_Kernels_T :: exceptionTest( void )
+{
+   TUDEF("Matrix", "multiplyInto");
+
+   Matrix<double> A(3, 4, 1.0), B(3, 4, 1.0), C;
+   Vector<double> w(4, 1.0);
+   try
+   {
+      multiplyInto(C, A, B);
+      TUFAIL("Expected MatrixException for 3x4 * 3x4");
+   }
+   catch (MatrixException& e)
+   {
+      TUPASS("MatrixException");
+   }
+   try
+   {
+      multiplyTransposeInto(C, A, Matrix<double>(4, 3));
+      TUFAIL("Expected MatrixException for 3x4 * transpose(4x3)");
+   }
+   catch (MatrixException& e)
+   {
+      TUPASS("MatrixException");
+   }
+   try
+   {
+      normalInto(C, A, w);
+      TUFAIL("Expected MatrixException for 4 weights on 3 rows");
+   }
+   catch (MatrixException& e)
+   {
+      TUPASS("MatrixException");
+   }
+   try
+   {
+      normalInto(A, A);
+      TUFAIL("Expected MatrixException for output aliasing input");
+   }
+   catch (MatrixException& e)
+   {
+      TUPASS("MatrixException");
+   }
+
+   TURETURN();
+}
+
+
+int main()
+{
+   int errorTotal = 0;
+   Matrix_Kernels_T testClass;
+
+   errorTotal += testClass.gemmTest();
+   errorTotal += testClass.transposeTest();
+   errorTotal += testClass.vectorTest();
+   errorTotal += testClass.normalTest();
+   errorTotal += testClass.aliasTest();
+   errorTotal += testClass.floatTest();
+   errorTotal += testClass.exceptionTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return( errorTotal );
+}
@@ -42,6 +42,7 @@
 #include "LNavEmptyFilter.hpp"
 #include "LNavTLMHOWFilter.hpp"
 #include "LNavEphMaker.hpp"
+#include "EngNav.hpp"
 #include "CommonTime.hpp"
 #include "TimeString.hpp"
 
@@ -132,6 +133,8 @@ public:
    unsigned testLNavCook();
       /// Test the LNAV parity filter
    unsigned testLNavParity();
+      /// Compare the LNAV parity check with EngNav's
+   unsigned testLNavParityCheck();
       /// Test the LNAV empty subframe filter
    unsigned testLNavEmpty();
       /// Test the TLM and HOW filter
@@ -397,6 +400,53 @@ testLNavParity()
 }
 
 
+unsigned NavFilterMgr_T ::
+testLNavParityCheck()
+{
+   TUDEF("LNavParityFilter", "checkParity");
+
+   unsigned long mismatch = 0, passed = 0;
+   for (unsigned i = 0; i < dataIdxLNAV; i++)
+   {
+      bool expected = EngNav::checkParity(dataLNAV[i].sf);
+      if (LNavParityFilter::checkParity(dataLNAV[i].sf) != expected)
+         mismatch++;
+      if (expected)
+         passed++;
+   }
+   TUASSERTE(unsigned long, 0, mismatch);
+      // make sure both outcomes were exercised
+   TUASSERT(passed > 0);
+   TUASSERT(passed < dataIdxLNAV);
+
+      // Flip each bit, including the unused upper bits of each word,
+      // of a few subframes that pass
+   uint32_t sf[10];
+   unsigned tested = 0;
+   mismatch = 0;
+   for (unsigned i = 0; i < dataIdxLNAV && tested < 50; i++)
+   {
+      if (!EngNav::checkParity(dataLNAV[i].sf))
+         continue;
+      tested++;
+      for (unsigned word = 0; word < 10; word++)
+      {
+         for (unsigned bit = 0; bit < 32; bit++)
+         {
+            std::copy(dataLNAV[i].sf, dataLNAV[i].sf + 10, sf);
+            sf[word] ^= (uint32_t(1) << bit);
+            if (LNavParityFilter::checkParity(sf) != EngNav::checkParity(sf))
+               mismatch++;
+         }
+      }
+   }
+   TUASSERTE(unsigned, 50, tested);
+   TUASSERTE(unsigned long, 0, mismatch);
+
+   return testFramework.countFails();
+}
+
+
 unsigned NavFilterMgr_T ::
 testLNavEmpty()
 {
@@ -658,6 +708,7 @@ int main()
    errorTotal += testClass.noFilterTest();
    errorTotal += testClass.testLNavCook();
    errorTotal += testClass.testLNavParity();
+   errorTotal += testClass.testLNavParityCheck();
    errorTotal += testClass.testLNavEmpty();
    errorTotal += testClass.testLNavTLMHOW();
    errorTotal += testClass.testLNavEphMaker();
@@ -0,0 +1,230 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+/**
+ * Throughput of the navigation message bit handling: packing GPS
+ * LNAV subframes into PackedNavBits, unpacking scaled fields one call
+ * at a time and with PackedNavBits::asScaledDoubles(), and checking
+ * subframe parity with EngNav::checkParity() and
+ * LNavParityFilter::checkParity(), after LNavCookFilter has set the
+ * subframes upright.
+ * Not run by ctest.
+ *
+ * Usage: PackedNavBitsBench [-n repeat] [file]
+ * The file has the format of test_input_NavFilterMgr.txt, which is
+ * used by default: one subframe per line, the ten words in hex from
+ * the sixth comma-separated field on.
+ */
+
+#include "PackedNavBits.hpp"
+#include "EngNav.hpp"
+#include "LNavParityFilter.hpp"
+#include "LNavCookFilter.hpp"
+#include "LNavFilterData.hpp"
+#include "StringUtils.hpp"
+
+#include "build_config.h"
+
+#include <ctime>
+#include <cstring>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace gpstk;
+
+   /// Fields of an LNAV subframe 2, with their bit positions in the
+   /// 300-bit subframe.  Split fields use their least significant part.
+static const PackedNavBits::ScaledField fields[] =
+{
+   //  start  bits  power2  signed  semicircles
+   {    68,   16,    -5,   true,   false },     // Crs
+   {    90,   16,   -43,   true,   true  },     // delta n
+   {   120,   24,   -31,   true,   true  },     // M0 (LSBs)
+   {   150,   16,   -29,   true,   false },     // Cuc
+   {   180,   24,   -33,   false,  false },     // e (LSBs)
+   {   210,   16,   -29,   true,   false },     // Cus
+   {   240,   24,   -19,   false,  false },     // sqrt(A) (LSBs)
+   {   270,   16,     4,   false,  false },     // toe
+};
+static const unsigned numFields = sizeof(fields) / sizeof(fields[0]);
+
+
+int main(int argc, char *argv[])
+{
+   unsigned repeat = 20;
+   string fileName = getPathData() + getFileSep() + "test_input_NavFilterMgr.txt";
+
+   for (int i = 1; i < argc; i++)
+   {
+      if (strcmp(argv[i], "-n") == 0 && i+1 < argc)
+         repeat = atoi(argv[++i]);
+      else
+         fileName = argv[i];
+   }
+
+   ifstream inf(fileName.c_str());
+   if (!inf)
+   {
+      cerr << "Could not open " << fileName << endl;
+      return 1;
+   }
+
+   vector<uint32_t> words;
+   string line;
+   while (getline(inf, line))
+   {
+      if (line.empty() || line[0] == '#')
+         continue;
+      for (unsigned w = 6; w <= 15; w++)
+         words.push_back(StringUtils::x2uint(StringUtils::word(line, w, ',')));
+   }
+   size_t numSF = words.size() / 10;
+   if (numSF == 0)
+   {
+      cerr << "No subframes in " << fileName << endl;
+      return 1;
+   }
+   cout << numSF << " subframes, repeated " << repeat << " times" << endl
+        << setw(26) << left << "operation" << right
+        << setw(12) << "ns/item" << setw(14) << "items/s" << endl;
+
+   double sum = 0.0;
+   vector<PackedNavBits> msgs(numSF);
+   vector<double> out(numFields);
+   double secs;
+   clock_t start;
+
+      // Packing
+   start = clock();
+   for (unsigned r = 0; r < repeat; r++)
+   {
+      for (size_t s = 0; s < numSF; s++)
+      {
+         msgs[s].clearBits();
+         for (unsigned w = 0; w < 10; w++)
+            msgs[s].addUnsignedLong(words[10*s + w], 30, 1);
+      }
+   }
+   secs = double(clock() - start) / CLOCKS_PER_SEC;
+   double items = double(numSF) * repeat;
+   cout << setw(26) << left << "pack subframe" << right << fixed
+        << setprecision(1) << setw(12) << secs * 1.0e9 / items
+        << setprecision(0) << setw(14) << items / secs << endl;
+
+      // Unpacking, one call per field
+   start = clock();
+   for (unsigned r = 0; r < repeat; r++)
+   {
+      for (size_t s = 0; s < numSF; s++)
+      {
+         for (unsigned f = 0; f < numFields; f++)
+         {
+            const PackedNavBits::ScaledField& fld = fields[f];
+            if (fld.semiCircles)
+               sum += msgs[s].asDoubleSemiCircles(fld.startBit, fld.numBits,
+                                                  fld.power2);
+            else if (fld.isSigned)
+               sum += msgs[s].asSignedDouble(fld.startBit, fld.numBits,
+                                             fld.power2);
+            else
+               sum += msgs[s].asUnsignedDouble(fld.startBit, fld.numBits,
+                                               fld.power2);
+         }
+      }
+   }
+   secs = double(clock() - start) / CLOCKS_PER_SEC;
+   items = double(numSF) * repeat * numFields;
+   cout << setw(26) << left << "unpack field" << right << fixed
+        << setprecision(1) << setw(12) << secs * 1.0e9 / items
+        << setprecision(0) << setw(14) << items / secs << endl;
+
+      // Unpacking, all the fields at once
+   start = clock();
+   for (unsigned r = 0; r < repeat; r++)
+   {
+      for (size_t s = 0; s < numSF; s++)
+      {
+         msgs[s].asScaledDoubles(fields, numFields, &out[0]);
+         for (unsigned f = 0; f < numFields; f++)
+            sum -= out[f];
+      }
+   }
+   secs = double(clock() - start) / CLOCKS_PER_SEC;
+   cout << setw(26) << left << "unpack field (batch)" << right << fixed
+        << setprecision(1) << setw(12) << secs * 1.0e9 / items
+        << setprecision(0) << setw(14) << items / secs << endl;
+
+      // Parity, on upright subframes as the NavFilter chain sees them
+   vector<uint32_t> cooked(words);
+   for (size_t s = 0; s < numSF; s++)
+   {
+      LNavFilterData fd;
+      fd.sf = &cooked[10*s];
+      LNavCookFilter::cookSubframe(&fd);
+   }
+   unsigned long good[2] = { 0, 0 };
+   for (int method = 0; method < 2; method++)
+   {
+      start = clock();
+      for (unsigned r = 0; r < repeat; r++)
+      {
+         for (size_t s = 0; s < numSF; s++)
+         {
+            if (method == 0 ? EngNav::checkParity(&cooked[10*s])
+                            : LNavParityFilter::checkParity(&cooked[10*s]))
+               good[method]++;
+         }
+      }
+      secs = double(clock() - start) / CLOCKS_PER_SEC;
+      items = double(numSF) * repeat;
+      cout << setw(26) << left
+           << (method == 0 ? "parity (EngNav)" : "parity (LNavParityFilter)")
+           << right << fixed
+           << setprecision(1) << setw(12) << secs * 1.0e9 / items
+           << setprecision(0) << setw(14) << items / secs << endl;
+   }
+
+   cout << "checksum " << setprecision(6) << sum
+        << ", subframes passing parity " << good[0] / repeat
+        << " / " << good[1] / repeat << endl;
+
+   return (good[0] == good[1] ? 0 : 1);
+}
@@ -0,0 +1,76 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+/**
+ * @file TestSupport.hpp
+ * Helpers shared by the tests and timing programs under core/tests:
+ * a reproducible random number generator, so that synthetic data are
+ * the same on every platform and every run.
+ */
+
+#ifndef GPSTK_CORE_TESTSUPPORT_HPP
+#define GPSTK_CORE_TESTSUPPORT_HPP
+
+#include <algorithm>
+#include <vector>
+
+namespace gpstk
+{
+      /// Advance the linear congruential generator of the tests and
+      /// return its new state.
+   inline unsigned nextRandom(unsigned& seed)
+   {
+      seed = seed * 1103515245u + 12345u;
+      return seed;
+   }
+
+      /// A reproducible value in [-1,1)
+   inline double uniform(unsigned& seed)
+   {
+      return double((nextRandom(seed) >> 8) % 20000) / 10000.0 - 1.0;
+   }
+
+      /// Put the elements of v in a reproducible random order
+   template <class T>
+   void shuffle(std::vector<T>& v, unsigned& seed)
+   {
+      for (std::size_t i = v.size(); i > 1; i--)
+         std::swap(v[i-1], v[(nextRandom(seed) >> 8) % i]);
+   }
+
+}  // namespace gpstk
+
+#endif // GPSTK_CORE_TESTSUPPORT_HPP
@@ -0,0 +1,245 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+/**
+ * Rate of the hot CommonTime operations (comparison, sorting, map
+ * lookup, adding seconds and differencing) against the same
+ * operations on TickTime, and of the conversion between them.
+ * Not run by ctest.
+ *
+ * Usage: TickTimeBench [-n count] [-r repeat]
+ * count times (default 100000) spread over a week, in random order.
+ */
+
+#include "TickTime.hpp"
+#include "GPSWeekSecond.hpp"
+#include "TestSupport.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <cstdlib>
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace gpstk;
+
+   /// Seconds of CPU time for op(times, r) repeated, op returns a checksum
+template <class T, class Op>
+static double timeIt(const vector<T>& times, int repeat, Op op, double& sum)
+{
+   clock_t start = clock();
+   for (int r = 0; r < repeat; r++)
+      sum += op(times, r);
+   return double(clock() - start) / CLOCKS_PER_SEC;
+}
+
+template <class T>
+struct Compare
+{
+   double operator()(const vector<T>& t, int r) const
+   {
+      double n = 0.0;
+      for (size_t i = 1; i < t.size(); i++)
+         n += (t[i-1] < t[i]);
+      return n + r;
+   }
+};
+
+template <class T>
+struct Sort
+{
+   double operator()(const vector<T>& t, int r) const
+   {
+      vector<T> s(t);
+      sort(s.begin(), s.end());
+      return double(s.size() + r);
+   }
+};
+
+template <class T>
+struct MapFind
+{
+   MapFind(const vector<T>& t)
+   {
+      for (size_t i = 0; i < t.size(); i++)
+         m[t[i]] = int(i);
+   }
+   double operator()(const vector<T>& t, int r) const
+   {
+      double n = 0.0;
+      for (size_t i = 0; i < t.size(); i++)
+         n += m.find(t[(i * 7 + r) % t.size()])->second;
+      return n;
+   }
+   map<T,int> m;
+};
+
+template <class T>
+struct Add
+{
+   double operator()(const vector<T>& t, int r) const
+   {
+      double n = 0.0;
+      for (size_t i = 0; i < t.size(); i++)
+      {
+         T x(t[i]);
+         x += 30.0;
+         n += (t[i] < x);
+      }
+      return n + r;
+   }
+};
+
+template <class T>
+struct Diff
+{
+   double operator()(const vector<T>& t, int r) const
+   {
+      double n = 0.0;
+      for (size_t i = 1; i < t.size(); i++)
+         n += t[i] - t[i-1];
+      return n + r;
+   }
+};
+
+struct Convert
+{
+   double operator()(const vector<CommonTime>& t, int r) const
+   {
+      double n = 0.0;
+      for (size_t i = 0; i < t.size(); i++)
+         n += double(TickTime(t[i]).getTicks() & 1);
+      return n + r;
+   }
+};
+
+struct ConvertBack
+{
+   double operator()(const vector<TickTime>& t, int r) const
+   {
+      double n = 0.0;
+      for (size_t i = 0; i < t.size(); i++)
+         n += t[i].toCommonTime(TimeSystem::GPS).getSecondOfDay();
+      return n + r;
+   }
+};
+
+
+int main(int argc, char *argv[])
+{
+   size_t count = 100000;
+   int repeat = 10;
+
+   for (int i = 1; i < argc; i++)
+   {
+      if (strcmp(argv[i], "-n") == 0 && i+1 < argc)
+         count = atol(argv[++i]);
+      else if (strcmp(argv[i], "-r") == 0 && i+1 < argc)
+         repeat = atoi(argv[++i]);
+   }
+
+      // distinct epochs on a 0.1 s grid over a week, shuffled
+   vector<CommonTime> ct;
+   unsigned seed = 12345;
+   GPSWeekSecond t0(1854, 0.0, TimeSystem::GPS);
+   for (size_t i = 0; i < count; i++)
+   {
+      double sow = double((nextRandom(seed) >> 8) % 6048000) * 0.1;
+      ct.push_back(CommonTime(t0) + sow);
+   }
+   vector<TickTime> tt;
+   for (size_t i = 0; i < ct.size(); i++)
+      tt.push_back(TickTime(ct[i]));
+
+   double ops = double(repeat) * count;
+   cout << count << " times x " << repeat << " repeats" << endl;
+   cout << setw(14) << left << "operation" << right
+        << setw(14) << "CommonTime ns" << setw(14) << "TickTime ns"
+        << setw(10) << "speedup" << endl;
+
+   double sums[2] = { 0.0, 0.0 };
+   double secs[2];
+   const char *names[] = { "compare", "sort", "map find", "add seconds",
+                           "difference" };
+   for (int q = 0; q < 5; q++)
+   {
+      switch (q)
+      {
+         case 0:
+            secs[0] = timeIt(ct, repeat, Compare<CommonTime>(), sums[0]);
+            secs[1] = timeIt(tt, repeat, Compare<TickTime>(), sums[1]);
+            break;
+         case 1:
+            secs[0] = timeIt(ct, repeat, Sort<CommonTime>(), sums[0]);
+            secs[1] = timeIt(tt, repeat, Sort<TickTime>(), sums[1]);
+            break;
+         case 2:
+            secs[0] = timeIt(ct, repeat, MapFind<CommonTime>(ct), sums[0]);
+            secs[1] = timeIt(tt, repeat, MapFind<TickTime>(tt), sums[1]);
+            break;
+         case 3:
+            secs[0] = timeIt(ct, repeat, Add<CommonTime>(), sums[0]);
+            secs[1] = timeIt(tt, repeat, Add<TickTime>(), sums[1]);
+            break;
+         case 4:
+            secs[0] = timeIt(ct, repeat, Diff<CommonTime>(), sums[0]);
+            secs[1] = timeIt(tt, repeat, Diff<TickTime>(), sums[1]);
+            break;
+      }
+      cout << setw(14) << left << names[q] << right << fixed
+           << setprecision(1)
+           << setw(14) << secs[0] * 1.0e9 / ops
+           << setw(14) << secs[1] * 1.0e9 / ops
+           << setprecision(2) << setw(10) << secs[0] / secs[1] << endl;
+   }
+
+   secs[0] = timeIt(ct, repeat, Convert(), sums[0]);
+   secs[1] = timeIt(tt, repeat, ConvertBack(), sums[1]);
+   cout << endl << "conversion ns: to TickTime " << fixed << setprecision(1)
+        << secs[0] * 1.0e9 / ops << ", to CommonTime "
+        << secs[1] * 1.0e9 / ops << endl;
+
+      // keep the checksums live
+   if (sums[0] + sums[1] == -1.0)
+      cout << "checksum" << endl;
+
+   return 0;
+}
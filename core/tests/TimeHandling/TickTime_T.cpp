@@ -0,0 +1,244 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+#include "TickTime.hpp"
+#include "CivilTime.hpp"
+#include "GPSWeekSecond.hpp"
+#include "TestUtil.hpp"
+
+#include <cmath>
+#include <iostream>
+#include <set>
+#include <vector>
+
+using namespace std;
+using namespace gpstk;
+
+
+class TickTime_T
+{
+public:
+
+   TickTime_T();
+
+      // return values indicate number of failures, i.e., 0=PASS, !0=FAIL
+   int conversionTest( void );
+   int orderTest( void );
+   int saturationTest( void );
+   int arithmeticTest( void );
+   int hashTest( void );
+
+private:
+
+      /// Times either side of the TickTime epoch, some fractional
+   vector<CommonTime> times;
+};
+
+
+TickTime_T :: TickTime_T()
+{
+   times.push_back(CivilTime(2000, 1, 1, 0, 0, 0.0, TimeSystem::GPS));
+   times.push_back(CivilTime(2000, 1, 1, 11, 59, 59.999, TimeSystem::GPS));
+   times.push_back(CivilTime(1980, 1, 6, 0, 0, 0.0, TimeSystem::GPS));
+   times.push_back(CivilTime(1999, 12, 31, 23, 59, 59.9999999,
+                             TimeSystem::GPS));
+   times.push_back(CivilTime(2015, 7, 19, 2, 0, 30.1234567, TimeSystem::GPS));
+   times.push_back(CivilTime(2016, 2, 29, 23, 59, 59.0005, TimeSystem::GPS));
+   times.push_back(GPSWeekSecond(1854, 345600.000000001, TimeSystem::GPS));
+   times.push_back(CivilTime(1776, 7, 4, 12, 0, 0.25, TimeSystem::UTC));
+   times.push_back(CivilTime(2200, 1, 1, 0, 0, 0.000999, TimeSystem::UTC));
+}
+
+
+   /* CommonTime -> TickTime -> CommonTime is exact for times on the
+    * nanosecond and within half a nanosecond otherwise. */
+int TickTime_T :: conversionTest( void )
+{
+   TUDEF("TickTime", "toCommonTime");
+
+   for (size_t i = 0; i < times.size(); i++)
+   {
+      TickTime tt(times[i]);
+      TUASSERT(!tt.isSaturated());
+      CommonTime back(tt.toCommonTime(times[i].getTimeSystem()));
+      TUASSERTE(TimeSystem, times[i].getTimeSystem(), back.getTimeSystem());
+      TUASSERT(fabs(back - times[i]) <= 0.5e-9);
+      TUASSERTE(TickTime, tt, TickTime(back));
+   }
+
+      // whole seconds are exact
+   TUASSERTE(CommonTime, times[0],
+             TickTime(times[0]).toCommonTime(TimeSystem::GPS));
+   TUASSERTE(CommonTime, times[2],
+             TickTime(times[2]).toCommonTime(TimeSystem::GPS));
+
+      // the zero tick is the start of 2000-01-01
+   TUASSERTE(int64_t, 0, TickTime(times[0]).getTicks());
+   TUASSERTE(int64_t, -1, TickTime::toTicks(times[0] - 1.e-9));
+
+   TURETURN();
+}
+
+
+   /* Tick order agrees with CommonTime order, and times more than
+    * a nanosecond apart never share a tick. */
+int TickTime_T :: orderTest( void )
+{
+   TUDEF("TickTime", "operator<");
+
+   CommonTime t0(times[4]);
+   const double offs[] = { -86400.5, -1.0, -1.e-3, -2.e-9, -1.e-10, 0.0,
+                           1.e-10, 2.e-9, 1.e-6, 1.e-3, 0.5, 86399.9999 };
+   const int n = sizeof(offs) / sizeof(offs[0]);
+   for (int i = 0; i < n; i++)
+   {
+      for (int j = 0; j < n; j++)
+      {
+         CommonTime a(t0 + offs[i]), b(t0 + offs[j]);
+         TickTime ta(a), tb(b);
+         if (ta < tb)
+            TUASSERT(a < b);
+         if (b - a > 1.e-9)
+            TUASSERT(ta < tb);
+         TUASSERTE(bool, ta < tb, tb > ta);
+         TUASSERTE(bool, ta <= tb, !(ta > tb));
+         TUASSERTE(bool, ta == tb, !(ta != tb));
+      }
+   }
+
+   TURETURN();
+}
+
+
+int TickTime_T :: saturationTest( void )
+{
+   TUDEF("TickTime", "isSaturated");
+
+   TickTime begin(CommonTime::BEGINNING_OF_TIME);
+   TickTime end(CommonTime::END_OF_TIME);
+   TUASSERT(begin.isSaturated());
+   TUASSERT(end.isSaturated());
+   TUASSERTE(int64_t, TickTime::MIN_TICKS, begin.getTicks());
+   TUASSERTE(int64_t, TickTime::MAX_TICKS, end.getTicks());
+   TUASSERTE(CommonTime, CommonTime::BEGINNING_OF_TIME,
+             begin.toCommonTime(TimeSystem::Any));
+   TUASSERTE(CommonTime, CommonTime::END_OF_TIME,
+             end.toCommonTime(TimeSystem::Any));
+
+   for (size_t i = 0; i < times.size(); i++)
+   {
+      TUASSERT(begin < TickTime(times[i]));
+      TUASSERT(TickTime(times[i]) < end);
+   }
+
+   end += 10.0;
+   TUASSERTE(int64_t, TickTime::MAX_TICKS, end.getTicks());
+   begin -= 10.0;
+   TUASSERTE(int64_t, TickTime::MIN_TICKS, begin.getTicks());
+
+   TURETURN();
+}
+
+
+   /* Adding seconds matches CommonTime, across day boundaries and
+    * the tick epoch. */
+int TickTime_T :: arithmeticTest( void )
+{
+   TUDEF("TickTime", "operator+=");
+
+   const double steps[] = { 30.0, -30.0, 0.1, 86400.0, -43200.000001,
+                            1.e-9, 123456.789 };
+   for (size_t i = 0; i < times.size(); i++)
+   {
+      for (int k = 0; k < 7; k++)
+      {
+         TickTime tt(times[i]);
+         tt += steps[k];
+         CommonTime exp(times[i] + steps[k]);
+         TUASSERT(fabs(tt.toCommonTime(exp.getTimeSystem()) - exp) <= 1.e-9);
+         TUASSERT(fabs((tt - TickTime(times[i])) - steps[k]) <= 1.e-9);
+         TUASSERTE(TickTime, tt - steps[k], TickTime(times[i]) +
+                   (steps[k] - steps[k]));
+      }
+   }
+
+   TickTime a(times[0]);
+   a.addTicks(-1);
+   TUASSERTE(int64_t, TickTime(times[0]).getTicks() - 1, a.getTicks());
+   CommonTime ca(a.toCommonTime(TimeSystem::GPS));
+   TUASSERT(ca < times[0]);
+   TUASSERTFEPS(-1.e-9, ca - times[0], 1.e-11);
+
+   TURETURN();
+}
+
+
+int TickTime_T :: hashTest( void )
+{
+   TUDEF("TickTime", "hash");
+
+   TickTimeHash hasher;
+   TickTime t0(times[4]);
+   TUASSERTE(size_t, t0.hash(), hasher(TickTime(times[4])));
+
+      // every second of a day, and every nanosecond of a microsecond
+   set<size_t> seen;
+   for (int i = 0; i < 86400; i++)
+      seen.insert(TickTime(t0 + double(i)).hash());
+   for (int i = 0; i < 1000; i++)
+      seen.insert(TickTime::fromTicks(t0.getTicks() + 86400000000000LL
+                                      + i).hash());
+   TUASSERTE(size_t, 87400, seen.size());
+
+   TURETURN();
+}
+
+
+int main()
+{
+   int errorTotal = 0;
+   TickTime_T testClass;
+
+   errorTotal += testClass.conversionTest();
+   errorTotal += testClass.orderTest();
+   errorTotal += testClass.saturationTest();
+   errorTotal += testClass.arithmeticTest();
+   errorTotal += testClass.hashTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return( errorTotal );
+}
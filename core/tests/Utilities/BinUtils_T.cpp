@@ -36,8 +36,10 @@
 #include "TestUtil.hpp"
 #include "BinUtils.hpp"
 #include "Exception.hpp"
+#include "TestSupport.hpp"
 #include <iostream>
 #include <cmath>
+#include <vector>
 
 using namespace std;
 
@@ -496,6 +498,101 @@ public:
       crc = computeCRC(data2, len2, gpstk::BinUtils::CRCCCITT);
       TUASSERTE(unsigned long, 0xbf25, crc);
 
+      return testFramework.countFails();
+   }
+
+      //====================================================================
+      //        Test Suite: computeCRCTableTest()
+      //====================================================================
+      //
+      //        Tests that the table-driven CRC computation gives the
+      //        same results as the bit-by-bit one for all kinds of
+      //        CRC parameters, data lengths and alignments.
+      //
+      //=====================================================================
+   int computeCRCTableTest(void)
+   {
+      using gpstk::BinUtils::computeCRC;
+      using gpstk::BinUtils::computeCRCBitwise;
+      using gpstk::BinUtils::CRCParam;
+      using gpstk::BinUtils::CRCTable;
+      TUDEF("BinUtils", "CRCTable");
+
+      unsigned char data[300];
+      unsigned seed = 12345;
+      for (unsigned i = 0; i < sizeof(data); i++)
+         data[i] = (unsigned char)(gpstk::nextRandom(seed) >> 16);
+
+      std::vector<CRCParam> params;
+      params.push_back(gpstk::BinUtils::CRC32);
+      params.push_back(gpstk::BinUtils::CRC16);
+      params.push_back(gpstk::BinUtils::CRCCCITT);
+      params.push_back(gpstk::BinUtils::CRC24Q);
+         // non-direct, reflections in and out differing, odd orders,
+         // even polynomials, and initial values beyond the order
+      params.push_back(CRCParam(24, 0x823ba9, 0xffffff, 0xffffff,
+                                false, false, false));
+      params.push_back(CRCParam(32, 0x4c11db7, 0x12345678, 0, false, true,
+                                true));
+      params.push_back(CRCParam(16, 0x8005, 0xbeef, 0x1234, true, true,
+                                false));
+      params.push_back(CRCParam(16, 0x1021, 0xbeef, 0, true, false, true));
+      params.push_back(CRCParam(1, 1, 0, 0, true, false, false));
+      params.push_back(CRCParam(5, 0x15, 0x1f, 0, true, true, true));
+      params.push_back(CRCParam(7, 0x09, 0x55, 0x7f, false, false, true));
+      params.push_back(CRCParam(12, 0x80f, 0xabc, 0, true, false, false));
+      params.push_back(CRCParam(12, 0x80e, 0xabc, 0, true, true, false));
+      params.push_back(CRCParam(8, 0x07, 0x1ff, 0, true, false, false));
+
+      for (unsigned p = 0; p < params.size(); p++)
+      {
+         CRCTable table(params[p]);
+         TUASSERT(table.matches(params[p]));
+         for (unsigned len = 0; len <= 40; len++)
+         {
+            for (unsigned off = 0; off < 8; off++)
+            {
+               uint32_t expected = computeCRCBitwise(data + off, len,
+                                                     params[p]);
+               TUASSERTE(unsigned long, expected,
+                         table.compute(data + off, len, params[p]));
+               TUASSERTE(unsigned long, expected,
+                         computeCRC(data + off, len, params[p]));
+            }
+         }
+         TUASSERTE(unsigned long,
+                   computeCRCBitwise(data, sizeof(data), params[p]),
+                   computeCRC(data, sizeof(data), params[p]));
+      }
+
+         // CRCs chained as in BinexData::getCRC()
+      CRCParam chain(gpstk::BinUtils::CRC16);
+      CRCParam chainBits(gpstk::BinUtils::CRC16);
+      for (unsigned i = 0; i < 30; i++)
+      {
+         chain.initial = computeCRC(data + i, 10, chain);
+         chainBits.initial = computeCRCBitwise(data + i, 10, chainBits);
+         TUASSERTE(unsigned long, chainBits.initial, chain.initial);
+      }
+
+      CRCTable table16(gpstk::BinUtils::CRC16);
+      TUASSERT(!table16.matches(gpstk::BinUtils::CRC32));
+      TUASSERT(!table16.matches(gpstk::BinUtils::CRCCCITT));
+         // tables for other parameters fall back to bit-by-bit
+      TUASSERTE(unsigned long,
+                computeCRCBitwise(data, 20, gpstk::BinUtils::CRC32),
+                table16.compute(data, 20, gpstk::BinUtils::CRC32));
+
+      try
+      {
+         CRCTable bad(CRCParam(33, 1, 0, 0, true, false, false));
+         TUFAIL("CRCTable should have failed on order 33");
+      }
+      catch (gpstk::BinUtils::CRCException& e)
+      {
+         TUPASS("CRCTable");
+      }
+
       return testFramework.countFails();
    }
 
@@ -603,6 +700,7 @@ int main (void)
    errorTotal += testClass.encodeVarTest();
    errorTotal += testClass.encodeVarLETest();
    errorTotal += testClass.computeCRCTest();
+   errorTotal += testClass.computeCRCTableTest();
    errorTotal += testClass.xorChecksumTest();
    errorTotal += testClass.countBitsTest();
 
@@ -0,0 +1,145 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S.
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software.
+//
+//Pursuant to DoD Directive 523024
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+/**
+ * Throughput, in MB/s, of the bit-by-bit and table-driven CRC
+ * computations for the predefined CRC parameters, over blocks of the
+ * sizes of short and long BINEX records.
+ * Not run by ctest.
+ *
+ * Usage: CRCBench [-m megabytes]
+ * Each computation processes the given amount of data (16 MB by
+ * default) for the table and 1/16 of it for the bit-by-bit one.
+ */
+
+#include "BinUtils.hpp"
+#include "TestSupport.hpp"
+
+#include <ctime>
+#include <cstring>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace gpstk;
+
+
+   // MB/s of computing CRCs of blocks of 'blockSize' bytes of 'data'
+   // until 'total' bytes are processed.  'crc' accumulates the results.
+static double throughput(const vector<unsigned char>& data,
+                         size_t blockSize, double total, bool table,
+                         const BinUtils::CRCParam& params, uint32_t& crc)
+{
+   size_t numBlocks = data.size() / blockSize;
+   unsigned long count = (unsigned long)(total / blockSize);
+   if (count == 0)
+      count = 1;
+
+   clock_t start = clock();
+   for (unsigned long i = 0; i < count; i++)
+   {
+      const unsigned char *block = &data[(i % numBlocks) * blockSize];
+      if (table)
+         crc ^= BinUtils::computeCRC(block, blockSize, params);
+      else
+         crc ^= BinUtils::computeCRCBitwise(block, blockSize, params);
+   }
+   double secs = double(clock() - start) / CLOCKS_PER_SEC;
+   if (secs <= 0.0)
+      secs = 1.0 / CLOCKS_PER_SEC;
+
+   return double(count) * blockSize / secs / 1.0e6;
+}
+
+
+int main(int argc, char *argv[])
+{
+   double megabytes = 16.0;
+
+   for (int i = 1; i < argc; i++)
+   {
+      if (strcmp(argv[i], "-m") == 0 && i+1 < argc)
+         megabytes = atof(argv[++i]);
+   }
+
+   vector<unsigned char> data(1 << 20);
+   unsigned seed = 12345;
+   for (size_t i = 0; i < data.size(); i++)
+      data[i] = (unsigned char)(nextRandom(seed) >> 16);
+
+   const BinUtils::CRCParam* params[] =
+      { &BinUtils::CRC16, &BinUtils::CRC32, &BinUtils::CRCCCITT,
+        &BinUtils::CRC24Q };
+   const char* names[] = { "CRC16", "CRC32", "CRC-CCITT", "CRC-24Q" };
+   const size_t sizes[] = { 16, 127, 4095, 1 << 20 };
+
+   cout << setw(10) << left << "CRC" << right << setw(10) << "bytes"
+        << setw(14) << "bitwise MB/s" << setw(14) << "table MB/s"
+        << setw(10) << "speedup" << endl;
+
+   int mismatches = 0;
+   for (unsigned p = 0; p < 4; p++)
+   {
+      for (unsigned s = 0; s < 4; s++)
+      {
+         uint32_t crcBits = 0, crcTable = 0;
+         double total = megabytes * 1.0e6;
+            // same number of blocks, so the results can be compared
+         double bits = throughput(data, sizes[s], total / 16, false,
+                                  *params[p], crcBits);
+         double table = throughput(data, sizes[s], total / 16, true,
+                                   *params[p], crcTable);
+         if (crcBits != crcTable)
+         {
+            cerr << names[p] << " mismatch on " << sizes[s]
+                 << " byte blocks" << endl;
+            mismatches++;
+         }
+         table = throughput(data, sizes[s], total, true, *params[p],
+                            crcTable);
+
+         cout << setw(10) << left << names[p] << right
+              << setw(10) << sizes[s] << fixed << setprecision(1)
+              << setw(14) << bits << setw(14) << table
+              << setw(10) << table / bits << endl;
+      }
+   }
+
+   return mismatches;
+}
@@ -0,0 +1,103 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+
+/**
+ * RAIM solutions of synthetic multi-GNSS epochs, with and without
+ * FastRAIM screening: each epoch has two blunders, so that RAIM goes
+ * through the stages rejecting one and then two satellites. Reports time
+ * per epoch in each mode, and the number of epochs whose results differ
+ * (which must be zero). Not run by ctest.
+ *
+ * Usage: PRSolutionBench [satellites] [epochs]
+ */
+
+#include "PRSolution_T.hpp"
+
+#include <cstdlib>
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+
+using namespace std;
+using namespace gpstk;
+
+int main(int argc, char *argv[])
+{
+   const int nsats(argc > 1 ? atoi(argv[1]) : 40);
+   const int nepochs(argc > 2 ? atoi(argv[2]) : 10);
+
+   double seconds[2] = { 0.0, 0.0 };
+   int diffs(0), rejected(0);
+   for (int e = 0; e < nepochs; e++)
+   {
+      SimpleTropModel trop;
+      PRScenario sc;
+      makePRScenario(sc, 1000 + e, nsats, 4, 1.0, 2, 50.0, trop, 1);
+
+      PRSolution prs[2];
+      vector<SatID> sats[2];
+      int iret[2];
+      for (int n = 0; n < 2; n++)
+      {
+         vector<SatID::SatelliteSystem> systems(sc.systems);
+         sats[n] = sc.sats;
+         prs[n].FastRAIM = (n == 1);
+         prs[n].NSatsReject = 2;
+
+         clock_t start(clock());
+         iret[n] = prs[n].RAIMCompute(sc.time, sats[n], systems, sc.ranges,
+                                      sc.invMC, &sc.eph, &trop);
+         seconds[n] += double(clock() - start) / CLOCKS_PER_SEC;
+      }
+
+      if (iret[0] != iret[1] || sats[0] != sats[1] ||
+          prs[0].RMSResidual != prs[1].RMSResidual)
+         diffs++;
+      rejected += nsats - prs[1].Nsvs;
+   }
+
+   cout << nsats << " satellites, " << nepochs << " epochs, "
+        << rejected << " satellites rejected" << endl;
+   cout << fixed << setprecision(3)
+        << "exhaustive RAIM " << setw(10) << 1000.0*seconds[0]/nepochs
+        << " ms/epoch" << endl
+        << "fast RAIM       " << setw(10) << 1000.0*seconds[1]/nepochs
+        << " ms/epoch" << endl
+        << "epochs with different results: " << diffs << endl;
+
+   return (diffs != 0);
+}
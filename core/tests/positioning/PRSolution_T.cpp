@@ -0,0 +1,319 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+#include "PRSolution_T.hpp"
+
+#include "TestUtil.hpp"
+#include "StringUtils.hpp"
+#include <cmath>
+#include <iostream>
+#include <string>
+
+using namespace std;
+using namespace gpstk;
+
+//============================================================
+// Class decalarations
+//============================================================
+
+   /// The simple trop model, made erratic within 5 m of a point, so that
+   /// solutions that get near that point do not converge.
+class ErraticTropModel : public SimpleTropModel
+{
+public:
+   ErraticTropModel( const Position& p ) : center(p) {}
+
+   double correction( const Position& RX, const Position& SV,
+                      const CommonTime& tt )
+      throw(InvalidTropModel)
+   {
+      double tc = TropModel::correction(RX, SV, tt);
+      if (range(RX, center) < 5.0)
+         tc += 50.0 * std::sin(1.e4 * RX.X());
+      return tc;
+   }
+
+private:
+   Position center;
+};
+
+class PRSolution_T
+{
+public:
+
+      // return values indicate number of failures, i.e., 0=PASS, !0=FAIL
+   int rejectTest( void );
+   int fastRAIMTest( void );
+   int nearTieTest( void );
+   int tooFewTest( void );
+   int failTest( void );
+
+private:
+
+      /// Solve a scenario with and without FastRAIM; count the differences
+      /// in the results, which must be identical.
+   int compareRAIM( const PRScenario& sc, int maxReject, double rmsLimit,
+                    TropModel& trop, int& iret );
+};
+
+
+int PRSolution_T :: compareRAIM( const PRScenario& sc, int maxReject,
+                                 double rmsLimit, TropModel& trop, int& iret )
+{
+   PRSolution prs[2];
+   vector<SatID> sats[2];
+   int ret[2];
+   for (int n = 0; n < 2; n++)
+   {
+      vector<SatID::SatelliteSystem> systems(sc.systems);
+      sats[n] = sc.sats;
+      prs[n].FastRAIM = (n == 1);
+      prs[n].NSatsReject = maxReject;
+      prs[n].RMSLimit = rmsLimit;
+      ret[n] = prs[n].RAIMCompute(sc.time, sats[n], systems, sc.ranges,
+                                  sc.invMC, &sc.eph, &trop);
+   }
+   iret = ret[0];
+
+   int diffs = 0;
+   if (ret[0] != ret[1] || prs[0].isValid() != prs[1].isValid() ||
+       prs[0].Nsvs != prs[1].Nsvs ||
+       prs[0].RMSResidual != prs[1].RMSResidual ||
+       prs[0].Solution.size() != prs[1].Solution.size() ||
+       prs[0].SystemIDs != prs[1].SystemIDs)
+      diffs++;
+   for (size_t i = 0; i < sats[0].size(); i++)
+      if (sats[0][i] != sats[1][i])
+         diffs++;
+   for (size_t i = 0; diffs == 0 && i < prs[0].Solution.size(); i++)
+      if (prs[0].Solution(i) != prs[1].Solution(i))
+         diffs++;
+
+   return diffs;
+}
+
+
+   // Large blunders must be rejected, and the other satellites kept.
+int PRSolution_T :: rejectTest( void )
+{
+   TUDEF("PRSolution", "RAIMCompute");
+
+   for (int nbad = 1; nbad <= 2; nbad++)
+   {
+      SimpleTropModel trop;
+      PRScenario sc;
+      makePRScenario(sc, 11 + nbad, 16, 2, 0.5, nbad, 2000.0, trop);
+
+      PRSolution prs;
+      vector<SatID> sats(sc.sats);
+      vector<SatID::SatelliteSystem> systems(sc.systems);
+      int iret = prs.RAIMCompute(sc.time, sats, systems, sc.ranges,
+                                 sc.invMC, &sc.eph, &trop);
+
+      int wrong = 0;
+      for (size_t i = 0; i < sats.size(); i++)
+      {
+         bool isBad = (vectorindex(sc.bad, int(i)) != -1);
+         if ((sats[i].id < 0) != isBad)
+            wrong++;
+      }
+      string msg = StringUtils::asString(nbad) + " blunders";
+      testFramework.assert(iret == 0 && prs.isValid(), msg + " solution ok",
+                           __LINE__);
+      testFramework.assert(wrong == 0, msg + " rejected", __LINE__);
+      testFramework.assert(prs.RMSResidual < 1.0, msg + " RMS residual",
+                           __LINE__);
+   }
+
+   TURETURN();
+}
+
+
+   // Screening must select the same solutions as the exhaustive search,
+   // over numbers of satellites, systems, blunders and weightings.
+int PRSolution_T :: fastRAIMTest( void )
+{
+   TUDEF("PRSolution", "FastRAIM");
+
+      // Screening is opt-in; by default the search is exhaustive
+   TUASSERT(!PRSolution().FastRAIM);
+
+   const int nsats[] = { 8, 12, 20, 32 };
+   const double blunders[] = { 40.0, 400.0, 20000.0 };
+   unsigned long seed = 1;
+   for (int s = 0; s < 4; s++)
+   {
+      for (int nsys = 1; nsys <= 3; nsys++)
+      {
+         for (int nbad = 0; nbad <= 2; nbad++)
+         {
+            for (int b = 0; b < 3; b++)
+            {
+               if (nbad == 0 && b > 0)
+                  continue;
+               SimpleTropModel trop;
+               PRScenario sc;
+               makePRScenario(sc, seed++, nsats[s], nsys, 1.0, nbad,
+                              blunders[b], trop, (seed % 3));
+
+               int iret;
+               string msg = StringUtils::asString(nsats[s]) + " sats, "
+                  + StringUtils::asString(nsys) + " systems, "
+                  + StringUtils::asString(nbad) + " blunders of "
+                  + StringUtils::asString(blunders[b], 0) + " m";
+               testFramework.assert(compareRAIM(sc, 2, 6.5, trop, iret) == 0,
+                                    msg, __LINE__);
+            }
+         }
+      }
+   }
+
+   TURETURN();
+}
+
+
+   // With noisy data the RMS residuals of many combinations are nearly the
+   // same, and RAIM goes through several stages.
+int PRSolution_T :: nearTieTest( void )
+{
+   TUDEF("PRSolution", "FastRAIM");
+
+   int stages = 0;
+   for (unsigned long seed = 100; seed < 112; seed++)
+   {
+      SimpleTropModel trop;
+      PRScenario sc;
+      makePRScenario(sc, seed, 11, 1 + seed % 2, 6.0, 1, 15.0, trop,
+                     (seed % 3));
+
+      int iret;
+      testFramework.assert(compareRAIM(sc, 3, 6.5, trop, iret) == 0,
+                           "seed " + StringUtils::asString(seed), __LINE__);
+
+      PRSolution prs;
+      vector<SatID> sats(sc.sats);
+      vector<SatID::SatelliteSystem> systems(sc.systems);
+      prs.RAIMCompute(sc.time, sats, systems, sc.ranges, sc.invMC, &sc.eph,
+                      &trop);
+      if (prs.Nsvs < 10)
+         stages++;
+   }
+   testFramework.assert(stages > 0, "some satellites rejected", __LINE__);
+
+   TURETURN();
+}
+
+
+   // RAIM that runs out of satellites ends at the first combination with
+   // too few of them, and returns what that one returns. Even the fits with
+   // no redundancy fail the RMS limit here, so every combination of the
+   // last stages is a near tie.
+int PRSolution_T :: tooFewTest( void )
+{
+   TUDEF("PRSolution", "FastRAIM");
+
+   for (unsigned long seed = 200; seed < 206; seed++)
+   {
+      SimpleTropModel trop;
+      PRScenario sc;
+      makePRScenario(sc, seed, 7 + seed % 2, 2, 1.0, 1, 300.0, trop);
+
+      int iret;
+      string msg = "seed " + StringUtils::asString(seed);
+      testFramework.assert(compareRAIM(sc, -1, 1.e-12, trop, iret) == 0, msg,
+                           __LINE__);
+      testFramework.assert(iret == -3, msg + " runs out of satellites",
+                           __LINE__);
+   }
+
+   TURETURN();
+}
+
+
+   // When the combination that screening picks fails to converge, the
+   // result must still be the one the exhaustive search finds among the
+   // others.
+int PRSolution_T :: failTest( void )
+{
+   TUDEF("PRSolution", "FastRAIM");
+
+   for (unsigned long seed = 300; seed < 307; seed++)
+   {
+      SimpleTropModel simple;
+      PRScenario sc;
+      makePRScenario(sc, seed, 10 + seed % 3, 1 + seed % 2, 1.0, 1, 300.0,
+                     simple, (seed % 3));
+
+      ErraticTropModel trop(sc.rx);
+      string msg = "seed " + StringUtils::asString(seed);
+
+         // the solution without the blunder, which screening picks, fails
+      PRSolution prs;
+      vector<SatID> sats(sc.sats);
+      vector<SatID::SatelliteSystem> systems(sc.systems);
+      Matrix<double> SVP;
+      prs.PreparePRSolution(sc.time, sats, systems, sc.ranges, &sc.eph, SVP);
+      sats[sc.bad[0]].id = -sats[sc.bad[0]].id;
+      Vector<double> resids, slopes;
+      int ret = prs.SimplePRSolution(sc.time, sats, SVP, sc.invMC, &trop,
+                                     prs.MaxNIterations, prs.ConvergenceLimit,
+                                     systems, resids, slopes);
+      testFramework.assert(ret == -1, msg + " winner fails", __LINE__);
+
+      int iret;
+      testFramework.assert(compareRAIM(sc, 2, 6.5, trop, iret) == 0, msg,
+                           __LINE__);
+   }
+
+   TURETURN();
+}
+
+
+int main()
+{
+   int errorTotal = 0;
+   PRSolution_T testClass;
+
+   errorTotal += testClass.rejectTest();
+   errorTotal += testClass.fastRAIMTest();
+   errorTotal += testClass.nearTieTest();
+   errorTotal += testClass.tooFewTest();
+   errorTotal += testClass.failTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return( errorTotal );
+}
@@ -0,0 +1,245 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+/**
+ * Synthetic pseudorange data for the PRSolution tests and timing
+ * program: satellites of several systems, fixed in ECEF space, seen from
+ * a receiver in Texas, with noise and blunders on some of the ranges.
+ */
+
+#ifndef GPSTK_PRSOLUTION_T_HPP
+#define GPSTK_PRSOLUTION_T_HPP
+
+#include "PRSolution.hpp"
+#include "GPSEllipsoid.hpp"
+#include "GPSWeekSecond.hpp"
+#include "MathBase.hpp"
+#include "Position.hpp"
+#include "TropModel.hpp"
+#include "stl_helpers.hpp"
+#include "TestSupport.hpp"
+
+#include <cmath>
+#include <map>
+#include <ostream>
+#include <vector>
+
+   /// Ephemeris of satellites that do not move; clocks are zero.
+class FixedXvtStore : public gpstk::XvtStore<gpstk::SatID>
+{
+public:
+   gpstk::Xvt getXvt(const gpstk::SatID& id, const gpstk::CommonTime& t) const
+   {
+      std::map<gpstk::SatID, gpstk::Triple>::const_iterator it(pos.find(id));
+      if (it == pos.end())
+      {
+         gpstk::InvalidRequest e("No position for satellite");
+         GPSTK_THROW(e);
+      }
+      gpstk::Xvt xvt;
+      xvt.x = it->second;
+      return xvt;
+   }
+
+   void dump(std::ostream& s = std::cout, short detail = 0) const
+   { s << "FixedXvtStore of " << pos.size() << " satellites" << std::endl; }
+
+   void edit(const gpstk::CommonTime& tmin,
+             const gpstk::CommonTime& tmax = gpstk::CommonTime::END_OF_TIME)
+   {}
+
+   void clear(void)
+   { pos.clear(); }
+
+   gpstk::TimeSystem getTimeSystem(void) const
+   { return gpstk::TimeSystem::Any; }
+
+   gpstk::CommonTime getInitialTime(void) const
+   { return gpstk::CommonTime::BEGINNING_OF_TIME; }
+
+   gpstk::CommonTime getFinalTime(void) const
+   { return gpstk::CommonTime::END_OF_TIME; }
+
+   bool hasVelocity(void) const
+   { return false; }
+
+   bool isPresent(const gpstk::SatID& id) const
+   { return pos.find(id) != pos.end(); }
+
+   std::map<gpstk::SatID, gpstk::Triple> pos;
+};
+
+
+   /// Reproducible uniform and normal random numbers.
+class PRRandom
+{
+public:
+   PRRandom(unsigned long seed) : state(seed) {}
+
+   double uniform(void)
+   {
+      return ((gpstk::nextRandom(state) & 0x7fffffffu) + 0.5) / 2147483648.0;
+   }
+
+   double normal(void)
+   {
+      double u(uniform()), v(uniform());
+      return std::sqrt(-2.0 * std::log(u)) * std::cos(2.0 * gpstk::PI * v);
+   }
+
+private:
+   unsigned state;
+};
+
+
+   /// One epoch of data, with the inputs to PRSolution::RAIMCompute().
+struct PRScenario
+{
+   gpstk::CommonTime time;
+   gpstk::Position rx;                 ///< true receiver position
+   FixedXvtStore eph;
+   std::vector<gpstk::SatID> sats;
+   std::vector<double> ranges;
+   std::vector<gpstk::SatID::SatelliteSystem> systems;
+   gpstk::Matrix<double> invMC;
+   std::vector<int> bad;               ///< indexes of the blunders
+};
+
+
+   /** Make a scenario of nsats satellites above 10 degrees, taken in turn
+    * from nsys (1 to 4) systems, with ranges of noise sigma (m) and
+    * blunders, of about the given size (m), on nbad of them.
+    * The ranges include the trop delay of trop. If weights is 1, invMC
+    * is diagonal, from elevation; if 2, the ranges are also correlated.
+    */
+inline void makePRScenario(PRScenario& sc, unsigned long seed, int nsats,
+                           int nsys, double sigma, int nbad, double blunder,
+                           gpstk::TropModel& trop, int weights = 0)
+{
+   using namespace gpstk;
+
+   static const SatID::SatelliteSystem allsys[4] =
+      { SatID::systemGPS, SatID::systemGlonass,
+        SatID::systemGalileo, SatID::systemBeiDou };
+   static const double radius[4] = { 26560.e3, 25510.e3, 29600.e3, 27900.e3 };
+
+   PRRandom rand(seed);
+   GPSEllipsoid ellip;
+   Position rx;
+   rx.setGeodetic(30.39, -97.73, 200.0);
+   const Triple R(rx.X(), rx.Y(), rx.Z());
+
+   sc = PRScenario();
+   sc.time = GPSWeekSecond(1850, 345600.0);
+   sc.rx = rx;
+   sc.systems.assign(allsys, allsys + nsys);
+
+   std::vector<double> elev;
+   int ids[4] = { 0, 0, 0, 0 };
+   while (int(sc.sats.size()) < nsats)
+   {
+      const int s(sc.sats.size() % nsys);
+      double u[3], norm(0.0);
+      for (int k = 0; k < 3; k++)
+      {
+         u[k] = 2.0 * rand.uniform() - 1.0;
+         norm += u[k] * u[k];
+      }
+      norm = std::sqrt(norm);
+      if (norm < 0.1 || norm > 1.0)
+         continue;
+
+      Position sv;
+      sv.setECEF(radius[s]*u[0]/norm, radius[s]*u[1]/norm, radius[s]*u[2]/norm);
+      const double el(rx.elevation(sv));
+      if (el < 10.0)
+         continue;
+
+      SatID sat(++ids[s], allsys[s]);
+      sc.sats.push_back(sat);
+      sc.eph.pos[sat] = Triple(sv.X(), sv.Y(), sv.Z());
+      elev.push_back(el);
+   }
+
+   for (int i = 0; i < nbad; i++)
+      sc.bad.push_back((7 * i + int(seed % 5)) % nsats);
+
+   for (int i = 0; i < nsats; i++)
+   {
+      const Triple& S(sc.eph.pos[sc.sats[i]]);
+
+         // range to the satellite rotated with the earth during the flight
+      double rho(0.0), tau(0.070), sv[3];
+      for (int iter = 0; iter < 5; iter++)
+      {
+         const double wt(ellip.angVelocity() * tau);
+         sv[0] =  std::cos(wt)*S[0] + std::sin(wt)*S[1];
+         sv[1] = -std::sin(wt)*S[0] + std::cos(wt)*S[1];
+         sv[2] = S[2];
+         rho = RSS(sv[0]-R[0], sv[1]-R[1], sv[2]-R[2]);
+         tau = rho / ellip.c();
+      }
+      Position svpos;
+      svpos.setECEF(sv[0], sv[1], sv[2]);
+
+      const int s(vectorindex(sc.systems, sc.sats[i].system));
+      double pr(rho + trop.correction(rx, svpos, sc.time)
+                + 1000.0 + 30.0 * s + sigma * rand.normal());
+      for (size_t b = 0; b < sc.bad.size(); b++)
+         if (sc.bad[b] == i)
+            pr += (b % 2 ? -1.0 : 1.0) * blunder * (1.0 + 0.3 * b);
+      sc.ranges.push_back(pr);
+   }
+
+   if (weights > 0)
+   {
+      sc.invMC = Matrix<double>(nsats, nsats, 0.0);
+      for (int i = 0; i < nsats; i++)
+      {
+         for (int j = 0; j < nsats; j++)
+         {
+            const double wi(std::sin(elev[i] * DEG_TO_RAD));
+            const double wj(std::sin(elev[j] * DEG_TO_RAD));
+            if (i == j)
+               sc.invMC(i,j) = wi * wi;
+            else if (weights > 1)
+               sc.invMC(i,j) = 0.2 * wi * wj;
+         }
+      }
+   }
+}
+
+#endif
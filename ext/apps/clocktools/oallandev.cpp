@@ -41,24 +41,33 @@
 #include <string.h>
 #include <math.h>
 
+#include "ClockDeviation.hpp"
+
 using namespace std;
 
 int main(int argv, char **argc)
 {
-    if(argc[1])
+    gpstk::ClockDeviation::TauSet tauSet = gpstk::ClockDeviation::AllTaus;
+    for(int a = 1; a < argv; a++)
     {
-        string str = argc[1];
+        string str = argc[a];
         if((str == "-h") || (str == "--help"))
         {
-          cout << "oallandev: Computes the overlapping Allan deviation from the standard input." << endl;
+          cout << "oallandev: Computes the overlapping Allan deviation from the standard input." << endl
+               << "  -o, --octave  Only averaging times of 1, 2, 4, 8, ... times Tau0" << endl
+               << "  -d, --decade  Only averaging times of 1, 2, 5, 10, 20, 50, ... times Tau0" << endl;
           return 1;
         }
+        else if((str == "-o") || (str == "--octave"))
+            tauSet = gpstk::ClockDeviation::OctaveTaus;
+        else if((str == "-d") || (str == "--decade"))
+            tauSet = gpstk::ClockDeviation::DecadeTaus;
     }
     // Structures used to store time and clock phase information
     vector <double> timeArray;
     vector <double> phaseArray;
     long double time, phase;
-    long unsigned int numPoints, i, numGaps, N, m;
+    long unsigned int numPoints, i, N;
 
     // All of the time and clock phase data is read in from the standard input
     i = 0;
@@ -73,10 +82,10 @@ int main(int argv, char **argc)
         i++;
     }
 
-    numPoints = i-1;
+    numPoints = (i > 0 ? i-1 : 0);
 
-    // Variables used in Overlapping Allan Deviation calculations
-    double Tau, Tau0, sum, sigma;
+    // Variables used in the deviation calculations
+    double Tau0 = 0;
 
     // Ensures there are at least the minimum number of points required to do calculations
     N = numPoints;
@@ -85,36 +94,22 @@ int main(int argv, char **argc)
     {
         cout << "Not Enough Points to Calculate Tau0" << endl;
     }
+    phaseArray.resize(N);
 
-    // Actual Overlapping Allan Deviation Calculation is done here
     // The Overlapping Allan Deviation is calculated as follows
     //  Sigma^2(Tau) = 1 / (2*(N-2*m)*Tau^2) * Sum(X[i+2*m]-2*X[i+m]+X[i], i=1, i=N-2*m)
     //  Where Tau is the averaging time, N is the total number of points, and Tau = m*Tau0
     //  Where Tau0 is the basic measurement interval
+    // Phase values of zero are taken as gaps.
+    gpstk::ClockDeviation deviation(Tau0);
+    deviation.setZeroGaps(true);
+    vector <double> Tau, sigma;
+    deviation.compute(phaseArray, gpstk::ClockDeviation::ADEV, tauSet, Tau, sigma);
 
-        for(m = 1; m <= (N-1)/2; m++)
+    for(i = 0; i < Tau.size(); i++)
     {
-            numGaps=0;
-                Tau = m*Tau0;
-        sigma = 0;
-
-        for(i = 0; i < (N-2*m); i++)
-        {
-            sum = 0;
-            if((phaseArray[i+2*m]==0 ||  phaseArray[i+m]==0 || phaseArray[i]==0)
-               && i!=0 && i!=(N-2*m-1))
-                numGaps++;
-                        else
-                            sum = phaseArray[i+2*m] - 2*phaseArray[i+m] + phaseArray[i];
-            sigma += sum * sum;
-        }
-
-        sigma = sigma / (2.0*((double)N-(double)numGaps-0-2.0*(double)m)*Tau*Tau);
-        sigma = sqrt(sigma);
-        fprintf(stdout, "%.1f %.4e \n", Tau, sigma); // outputs results to the standard output
-        }
-    /*************
-    *************/
+        fprintf(stdout, "%.1f %.4e \n", Tau[i], sigma[i]); // outputs results to the standard output
+    }
 
     return(0);
 }
@@ -41,24 +41,33 @@
 #include <string.h>
 #include <math.h>
 
+#include "ClockDeviation.hpp"
+
 using namespace std;
 
 int main(int argv, char **argc)
 {
-    if(argc[1])
+    gpstk::ClockDeviation::TauSet tauSet = gpstk::ClockDeviation::AllTaus;
+    for(int a = 1; a < argv; a++)
     {
-        string str = argc[1];
+        string str = argc[a];
         if((str == "-h") || (str == "--help"))
         {
-          cout << "ohadamarddev: Computes the overlapping Hadamard deviation from the standard input." << endl;
+          cout << "ohadamarddev: Computes the overlapping Hadamard deviation from the standard input." << endl
+               << "  -o, --octave  Only averaging times of 1, 2, 4, 8, ... times Tau0" << endl
+               << "  -d, --decade  Only averaging times of 1, 2, 5, 10, 20, 50, ... times Tau0" << endl;
           return 1;
         }
+        else if((str == "-o") || (str == "--octave"))
+            tauSet = gpstk::ClockDeviation::OctaveTaus;
+        else if((str == "-d") || (str == "--decade"))
+            tauSet = gpstk::ClockDeviation::DecadeTaus;
     }
     // Structures used to store time and clock phase information
     vector <double> timeArray;
     vector <double> phaseArray;
     long double time, phase;
-    long unsigned int numPoints, i, numGaps, N, m;
+    long unsigned int numPoints, i, N;
 
     // All of the time and clock phase data is read in from the standard input
     i = 0;
@@ -73,12 +82,10 @@ int main(int argv, char **argc)
         i++;
     }
 
-    numPoints = i-1;
-
+    numPoints = (i > 0 ? i-1 : 0);
 
-
-    // Variables used in Overlapping Hadamard Deviation calculations
-    double Tau, Tau0, sum, sigma;
+    // Variables used in the deviation calculations
+    double Tau0 = 0;
 
     // Ensures there are at least the minimum number of points required to do calculations
     N = numPoints;
@@ -87,36 +94,23 @@ int main(int argv, char **argc)
     {
         cout << "Not Enough Points to Calculate Tau0" << endl;
     }
+    phaseArray.resize(N);
 
     // Overlapping Hadamard Calculation
     //  Done As Follows
     //  HSigma^2(Tau) = Sum((x[i+3m]-3x[i+2m]+3x[i+m]-x[i])^2, from i=1 to N-3m)/[6(N-3m)Tau^2]
     //  Where Tau = m*Tau0, Tau0 being the basic time interval
     //   m being the spacing, and N the total number of data points
-    for(m = 1; m <= (N-1)/3; m++)
-    {
-        Tau = m*Tau0;
-        sigma = 0;
-        numGaps=0;
-        for(i = 0; i < (N-3*m); i++)
-        {
-            sum = 0;
-            if((phaseArray[i+3*m]==0 ||  phaseArray[i+2*m]==0
-                || phaseArray[i+m]==0 || phaseArray[i]==0)
-               && i!=0 && i!=(N-3*m-1))
-                numGaps++;
-            else
-                sum = phaseArray[i+3*m] - 3*phaseArray[i+2*m] + 3*phaseArray[i+m] - phaseArray[i];
-            sigma += sum * sum;
-        }
+    // Phase values of zero are taken as gaps.
+    gpstk::ClockDeviation deviation(Tau0);
+    deviation.setZeroGaps(true);
+    vector <double> Tau, sigma;
+    deviation.compute(phaseArray, gpstk::ClockDeviation::HDEV, tauSet, Tau, sigma);
 
-        sigma = sigma / (6.0*((double)N-numGaps-3.0*(double)m)*Tau*Tau);
-        sigma = sqrt(sigma);
-        fprintf(stdout, "%.1f %.4e \n", Tau, sigma); // outputs results to the standard output
+    for(i = 0; i < Tau.size(); i++)
+    {
+        fprintf(stdout, "%.1f %.4e \n", Tau[i], sigma[i]); // outputs results to the standard output
     }
 
-    /*************
-    *************/
-
     return(0);
 }
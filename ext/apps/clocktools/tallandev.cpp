@@ -41,24 +41,33 @@
 #include <string.h>
 #include <math.h>
 
+#include "ClockDeviation.hpp"
+
 using namespace std;
 
 int main(int argv, char **argc)
 {
-    if(argc[1])
+    gpstk::ClockDeviation::TauSet tauSet = gpstk::ClockDeviation::AllTaus;
+    for(int a = 1; a < argv; a++)
     {
-        string str = argc[1];
+        string str = argc[a];
         if((str == "-h") || (str == "--help"))
         {
-          cout << "tallandev: Computes the total Allan deviation from the standard input." << endl;
+          cout << "tallandev: Computes the total Allan deviation from the standard input." << endl
+               << "  -o, --octave  Only averaging times of 1, 2, 4, 8, ... times Tau0" << endl
+               << "  -d, --decade  Only averaging times of 1, 2, 5, 10, 20, 50, ... times Tau0" << endl;
           return 1;
         }
+        else if((str == "-o") || (str == "--octave"))
+            tauSet = gpstk::ClockDeviation::OctaveTaus;
+        else if((str == "-d") || (str == "--decade"))
+            tauSet = gpstk::ClockDeviation::DecadeTaus;
     }
     // Structures used to store time and clock phase information
     vector <double> timeArray;
     vector <double> phaseArray;
     long double time, phase;
-    long unsigned int numPoints, i, N, m;
+    long unsigned int numPoints, i, N;
 
     // All of the time and clock phase data is read in from the standard input
     i = 0;
@@ -73,13 +82,10 @@ int main(int argv, char **argc)
         i++;
     }
 
-    numPoints = i-1;
-
-    /*************
-    *************/
+    numPoints = (i > 0 ? i-1 : 0);
 
-    // Variables used in Overlapping Allan Deviation calculations
-    double Tau, Tau0, sum, sigma;
+    // Variables used in the deviation calculations
+    double Tau0 = 0;
 
     // Ensures there are at least the minimum number of points required to do calculations
     N = numPoints;
@@ -88,50 +94,20 @@ int main(int argv, char **argc)
     {
         cout << "Not Enough Points to Calculate Tau0" << endl;
     }
+    phaseArray.resize(N);
 
-        //Vector to store the transformed data
-    vector <double> phaseTemp(3*N-4,0);
-
-        //Transforms and stores data
-    for(i=0; i<N; i++)
-    {
-        phaseTemp[N-2+i] = phaseArray[i];
-    }
-
-    for(int x=N-5, y=3*N-5, j=3; x>=0; j++)
-        {
-        phaseTemp[x] = 2*phaseArray[0]-phaseArray[j];
-        phaseTemp[y] = 2*phaseArray[N-1]-phaseArray[j];
-        x--; y--;
-    }
-
-        phaseTemp[N-3] = 2*phaseArray[0]-phaseArray[1];
-    phaseTemp[N-4] = 2*phaseArray[0]-phaseArray[2];
-    phaseTemp[2*N-2] = 2*phaseArray[N-1]-phaseArray[N-2];
-       phaseTemp[2*N-1] = 2*phaseArray[N-1]-phaseArray[N-3];
-
-    // Actual Total Variance Calculation is done here
     // The Total Variance is calculated as follows
-    //  Sigma2(Tau) = 1 / (2*(N-2)*Tau2) * Sum(X[i-m]-2*X[i+m]+X[i+m], i=2, i=N-1)
-    //  Where Tau is the averaging time, N is the total number of points, and Tau = m*Tau0
+    //  Sigma2(Tau) = 1 / (2*(N-2)*Tau2) * Sum(X*[i-m]-2*X*[i]+X*[i+m], i=2, i=N-1)
+    //  Where X* is the data extended by reflection about both ends,
+    //  Tau is the averaging time, N is the total number of points, and Tau = m*Tau0
     //  Where Tau0 is the basic measurement interval
+    gpstk::ClockDeviation deviation(Tau0);
+    vector <double> Tau, sigma;
+    deviation.compute(phaseArray, gpstk::ClockDeviation::TOTDEV, tauSet, Tau, sigma);
 
-    for(m = 1; m<N; m++)
+    for(i = 0; i < Tau.size(); i++)
     {
-        Tau = m*Tau0;
-        sigma = 0;
-
-        for(i = N-1; i<(2*N-3); i++)
-        {
-            sum = 0;
-                    sum = phaseTemp[i-m] - 2*phaseTemp[i] + phaseTemp[i+m];
-            sigma += sum*sum;
-        }
-
-        sigma = sigma / (2.0*(double(N)-2.0)*Tau*Tau);
-        sigma = sqrt(sigma);
-        fprintf(stdout, "%.1f %.4e \n", Tau, sigma); // outputs results to the standard output
-
+        fprintf(stdout, "%.1f %.4e \n", Tau[i], sigma[i]); // outputs results to the standard output
     }
 
     return(0);
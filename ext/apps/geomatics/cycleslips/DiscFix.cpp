@@ -119,6 +119,7 @@ typedef struct configuration {
    int NrecOut;
    Epoch FirstEpoch,LastEpoch;
    bool smoothPR,smoothPH,smooth;
+   int nThreads;           // number of threads used by the GDC
    int debug;
    bool verbose,DChelp;
    vector<string> DCcmds;        // all the --DC... on the cmd line
@@ -175,7 +176,9 @@ int main(int argc, char **argv)
       int i,nread,npass,iret;
       Epoch ttag;
       string msg;
-      vector<string> EditCmds;
+      vector< vector<string> > EditCmds;
+      vector<string> GDCmsgs,GDClogs;
+      vector<int> GDCrets;
 
       // Title and description
       cfg.Title = PrgmName+", part of the GPS ToolKit, Ver "+DiscFixVersion+", Run ";
@@ -309,14 +312,31 @@ int main(int argc, char **argv)
          cfg.GDConfig.DisplayParameterUsage(LOGstrm,(cfg.DChelp && cfg.verbose));
          LOG(INFO) << "";
 
-         // -------------------------------- call the GDC, output results and smooth
+         // -------------------------------- call the GDC on all passes at once
+         // summarize the passes before they are corrected
+         vector<string> ProcSums;
+         for(npass=0; npass<cfg.SPList.size(); npass++) {
+            ostringstream oss;
+            oss << cfg.SPList[npass];
+            ProcSums.push_back(oss.str());
+         }
+
+         DiscontinuityCorrector(cfg.SPList, cfg.GDConfig, EditCmds, GDCmsgs,
+                                GDCrets, vector<int>(), cfg.nThreads, &GDClogs);
+
+         // -------------------------------- output results and smooth
          for(npass=0; npass<cfg.SPList.size(); npass++) {
 
-            LOG(INFO) << "Proc " << setw(2) << npass+1 << " " << cfg.SPList[npass];
+            LOG(INFO) << "Proc " << setw(2) << npass+1 << " " << ProcSums[npass];
             //cfg.SPList[npass].dump(*pLOGstrm,"RAW");      // temp
+            cfg.oflog << GDClogs[npass];
 
-            msg = "";
-            iret=DiscontinuityCorrector(cfg.SPList[npass],cfg.GDConfig,EditCmds,msg);
+            // output editing commands; a failed pass may still delete data
+            for(i=0; i<EditCmds[npass].size(); i++)
+               cfg.ofout << EditCmds[npass][i] << " # pass " << npass+1 << endl;
+
+            msg = GDCmsgs[npass];
+            iret = GDCrets[npass];
             if(iret != 0) {
                cfg.SPList[npass].status() = -1;         // failed
                LOG(ERROR) << "GDC failed (" << iret << " "
@@ -335,11 +355,6 @@ int main(int argc, char **argv)
             ttag = cfg.SPList[npass].getLastTime();
             if(ttag > cfg.LastEpoch) cfg.LastEpoch = ttag;
 
-            // output editing commands
-            for(i=0; i<EditCmds.size(); i++)
-               cfg.ofout << EditCmds[i] << " # pass " << npass+1 << endl;
-            EditCmds.clear();
-
             // smooth pseudorange and debias phase
             if(cfg.smooth) {
                cfg.SPList[npass].smooth(cfg.smoothPR, cfg.smoothPH, msg);
@@ -827,6 +842,8 @@ try {
    cfg.smoothPH = false;
    cfg.smooth = false;
 
+   cfg.nThreads = numProcessors();
+
    for(i=0; i<9; i++) cfg.ndt[i]=-1;
 
    cfg.inputPath = string(".");
@@ -914,6 +931,9 @@ try {
             "Set DC parameter <param> to <value>");
    opts.Add(0, "DChelp", "", false, false, &cfg.DChelp, "",
             "Print list of DC parameters (all if -v) and their defaults, then quit");
+   opts.Add(0, "threads", "n", false, false, &cfg.nThreads, "",
+            "Number of threads used to correct the passes ("
+            + asString(cfg.nThreads) + ")");
 
    opts.Add(0, "log", "file", false, false, &cfg.LogFile, "# Output:",
             "Output log file name (" + cfg.LogFile + ")");
@@ -90,13 +90,11 @@ gpstk::Vector<double> NEDUtil::convertToNED( const gpstk::Vector<double>& inV )
    
 gpstk::Triple NEDUtil::convertToNED( const gpstk::Triple& inVec ) const
 {
-   gpstk::Vector<double> v(3); 
-   v[0] = inVec[0];
-   v[1] = inVec[1];
-   v[2] = inVec[2];
-   
-   gpstk::Vector<double> vOut = convertToNED( v );
-   gpstk::Triple outVec( vOut[0], vOut[1], vOut[2] );
+      // element by element, to avoid the temporaries of Matrix * Vector
+   gpstk::Triple outVec;
+   for (size_t i = 0; i < 3; i++)
+      outVec[i] = rotMat(i,0) * inVec[0] + rotMat(i,1) * inVec[1]
+                + rotMat(i,2) * inVec[2];
    return(outVec);
 }
    
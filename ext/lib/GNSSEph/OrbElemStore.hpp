@@ -151,6 +151,11 @@ namespace gpstk
       /// Return true if the given SatID is present in the store
       virtual bool isPresent(const SatID& id) const throw();
 
+      /// The tables are only read by the const methods, so the store
+      /// may be read by several threads at once.
+      virtual bool beginConcurrentReads(void)
+         { return true; }
+
       /// Classes to set/access the store TimeSystem information.
       TimeSystem getTimeSystem() const { return timeSysForStore; }
       void setTimeSystem(const TimeSystem ts) { timeSysForStore = ts; }
@@ -255,6 +255,23 @@ namespace gpstk
                                          Matrix<double>& Theta, 
                                          Matrix<double>& NP)
       throw(Exception)
+   {
+      FixedMatrix<double,3,3> pom, theta, np;
+      J2kToECEFMatrix(UTC, pom, theta, np);
+
+      POM = pom.toMatrix();
+      Theta = theta.toMatrix();
+      NP = np.toMatrix();
+
+   }  // End of method 'ReferenceFrames::J2kToECEFMatrix()'
+
+
+      // ECEF = W * S * NP * J2k
+   void ReferenceFrames::J2kToECEFMatrix(UTCTime                  UTC,
+                                         FixedMatrix<double,3,3>& POM,
+                                         FixedMatrix<double,3,3>& Theta, 
+                                         FixedMatrix<double,3,3>& NP)
+      throw(Exception)
    {
       // Earth orientation data
       double xp = UTC.xPole() * DAS2R;
@@ -265,7 +282,7 @@ namespace gpstk
       
 
       // IAU 1976 precession matrix       
-      Matrix<double> P = iauPmat76(TT);
+      FixedMatrix<double,3,3> P = iauPmat76(TT);
 
       // Nutation correction wrt IAU 1976/1980 (mas->radians)
       const double DDP80 = 0.0; //-55.0655 * DAS2R/1000.0;
@@ -283,7 +300,7 @@ namespace gpstk
       double EPSA = meanObliquity(TT); 
       
       // IAU 1980 Nutation matrix
-      Matrix<double> N = iauNmat(EPSA, DPSI , DEPS);
+      FixedMatrix<double,3,3> N = iauNmat(EPSA, DPSI , DEPS);
 
       // NP
       NP = N * P;
@@ -294,10 +311,10 @@ namespace gpstk
       // Greenwich apparent sidereal time(IAU 1982/1994)
       double GST = normalizeAngle(iauGmst82(UT1) + EE);
       
-      Theta =  Rz(GST);
+      Theta = fixedRotation(GST, 3);
      
       // Polar motion matrix
-      POM = Ry(-xp) * Rx(-yp);
+      POM = fixedRotation(-xp, 2) * fixedRotation(-yp, 1);
       
       // All Matrix are ready now
 
@@ -309,49 +326,46 @@ namespace gpstk
       // return POM * Theta * NP 
    Matrix<double> ReferenceFrames::J2kToECEFMatrix(UTCTime UTC)
    {
-      Matrix<double> POM, Theta, NP;
+      FixedMatrix<double,3,3> POM, Theta, NP;
       J2kToECEFMatrix(UTC,POM,Theta,NP);
 
-      return (POM * Theta * NP);
+      return (POM * Theta * NP).toMatrix();
    }
    
    /// NP TOD - TrueOfDate
    Matrix<double> ReferenceFrames::J2kToTODMatrix(UTCTime UTC)
    {
-      Matrix<double> POM, Theta, NP;
+      FixedMatrix<double,3,3> POM, Theta, NP;
       J2kToECEFMatrix(UTC,POM,Theta,NP);
 
-      return NP;
+      return NP.toMatrix();
    }
 
 
    Vector<double> ReferenceFrames::J2kPosVelToECEF(UTCTime UTC, Vector<double> j2kPosVel)
       throw(Exception)
    {
-      
-      Matrix<double> POM, Theta, NP;
+      typedef FixedMatrix<double,3,3> Mat3;
+      typedef FixedVector<double,3> Vec3;
+
+      Mat3 POM, Theta, NP;
       J2kToECEFMatrix(UTC,POM,Theta,NP);
 
       const double dera = earthRotationAngleRate1(UTC.mjdTT());
       
          // Derivative of Earth rotation 
-      Matrix<double> S(3,3,0.0);
+      Mat3 S(0.0);
       S(0,1) = 1.0; S(1,0) = -1.0;      
       
-      Matrix<double> dTheta = dera * S * Theta;
+      Mat3 dTheta = dera * S * Theta;
       
-      Matrix<double> c2t = POM * Theta * NP;
-      Matrix<double> dc2t = POM * dTheta * NP;
+      Mat3 c2t = POM * Theta * NP;
+      Mat3 dc2t = POM * dTheta * NP;
 
-      Vector<double> j2kPos(3, 0.0), j2kVel(3, 0.0);
-      for(int i=0; i<3; i++)
-      {
-         j2kPos(i) = j2kPosVel(i);
-         j2kVel(i) = j2kPosVel(i+3);
-      }
+      Vec3 j2kPos(j2kPosVel.begin()), j2kVel(j2kPosVel.begin() + 3);
 
-      Vector<double> ecefPos = c2t * j2kPos;
-      Vector<double> ecefVel = c2t * j2kVel + dc2t * j2kPos;
+      Vec3 ecefPos = c2t * j2kPos;
+      Vec3 ecefVel = c2t * j2kVel + dc2t * j2kPos;
       
       Vector<double> ecefPosVel(6,0.0);
       for(int i=0; i<3; i++)
@@ -368,30 +382,28 @@ namespace gpstk
    Vector<double> ReferenceFrames::ECEFPosVelToJ2k(UTCTime UTC, Vector<double> ecefPosVel)
       throw(Exception)
    {
-      Matrix<double> POM, Theta, NP;
+      typedef FixedMatrix<double,3,3> Mat3;
+      typedef FixedVector<double,3> Vec3;
+
+      Mat3 POM, Theta, NP;
       J2kToECEFMatrix(UTC,POM,Theta,NP);
 
       const double dera = earthRotationAngleRate1(UTC.mjdTT());
 
       // Derivative of Earth rotation 
-      Matrix<double> S(3,3,0.0);
+      Mat3 S(0.0);
       S(0,1) = 1.0; S(1,0) = -1.0;      
 
-      Matrix<double> dTheta = dera * S * Theta;
+      Mat3 dTheta = dera * S * Theta;
 
-      Matrix<double> c2t = POM * Theta * NP;
-      Matrix<double> dc2t = POM * dTheta * NP;
+      Mat3 c2t = POM * Theta * NP;
+      Mat3 dc2t = POM * dTheta * NP;
       
-      Vector<double> ecefPos(3, 0.0), ecefVel(3, 0.0);
-      for(int i=0; i<3; i++)
-      {
-         ecefPos(i) = ecefPosVel(i);
-         ecefVel(i) = ecefPosVel(i+3);
-      }
+      Vec3 ecefPos(ecefPosVel.begin()), ecefVel(ecefPosVel.begin() + 3);
 
-      Vector<double> j2kPos = transpose(c2t) * ecefPos;
-      Vector<double> j2kVel = transpose(c2t) * ecefVel 
-                             +transpose(dc2t)* ecefPos;
+      Vec3 j2kPos = transpose(c2t) * ecefPos;
+      Vec3 j2kVel = transpose(c2t) * ecefVel 
+                   +transpose(dc2t)* ecefPos;
 
       Vector<double> j2kPosVel(6,0.0);
       for(int i=0; i<3; i++)
@@ -408,8 +420,10 @@ namespace gpstk
    Vector<double> ReferenceFrames::J2kStateToECEF(UTCTime UTC, Vector<double> j2kState)
       throw(Exception)
    {
-      
-      Matrix<double> POM, Theta, NP;
+      typedef FixedMatrix<double,3,3> Mat3;
+      typedef FixedVector<double,3> Vec3;
+
+      Mat3 POM, Theta, NP;
       J2kToECEFMatrix(UTC,POM,Theta,NP);
 
       // get Theta rates
@@ -421,59 +435,48 @@ namespace gpstk
       double cs2[3][3]={{-1,0,0},{0,-1,0},{0,0,0}};
       double cs3[3][3]={{0,-1,0},{1,0,0},{0,0,0}};
 
-      Matrix<double> s1(3,3,0.0),s2(3,3,0.0),s3(3,3,0.0);
-      s1 = &cs1[0][0];
-      s2 = &cs2[0][0];
-      s3 = &cs3[0][0];
+      Mat3 s1(&cs1[0][0]), s2(&cs2[0][0]), s3(&cs3[0][0]);
 
       // dTheta1 dTheta2 dTheta3
-      Matrix<double> dTheta1 = s1 * Theta * dera1;
+      Mat3 dTheta1 = s1 * Theta * dera1;
 
-      Matrix<double> dTheta2 = s2 * Theta * ( dera1 * dera1) 
-                             + dTheta1*dera2;
+      Mat3 dTheta2 = s2 * Theta * ( dera1 * dera1) 
+                   + dTheta1*dera2;
 
-      Matrix<double> dTheta3 = s3 * Theta * ( dera1 * dera1 * dera1)
-                             + s2 * Theta * (2.0 * dera1 * dera2) 
-                             + dTheta2 * dera2
-                             + dTheta1 * dera3;
+      Mat3 dTheta3 = s3 * Theta * ( dera1 * dera1 * dera1)
+                   + s2 * Theta * (2.0 * dera1 * dera2) 
+                   + dTheta2 * dera2
+                   + dTheta1 * dera3;
 
-      Vector<double> r(3,0.0),v(3,0.0),a(3,0.0),d(3,0.0);
-      for(int i=0; i<3; i++)
-      {
-         r(i) =  j2kState(i+0);
-         v(i) =  j2kState(i+3);
-         a(i) =  j2kState(i+6);
-         d(i) =  j2kState(i+9);
-      }
+      Vec3 r(j2kState.begin()), v(j2kState.begin() + 3),
+           a(j2kState.begin() + 6), d(j2kState.begin() + 9);
 
       // tm1 = POM*Theta*NP
-      Matrix<double> tm1 = POM * Theta * NP;
+      Mat3 tm1 = POM * Theta * NP;
       // tm2 = POM*dTheta1*NP
-      Matrix<double> tm2 = POM * dTheta1 * NP;
+      Mat3 tm2 = POM * dTheta1 * NP;
       // tm3 = POM*dTheta3*NP
-      Matrix<double> tm3 = POM * dTheta2 * NP;
+      Mat3 tm3 = POM * dTheta2 * NP;
       // tm4 = POM*dTheta4*NP
-      Matrix<double> tm4 = POM * dTheta3 * NP;
+      Mat3 tm4 = POM * dTheta3 * NP;
      
-      Vector<double> r2, v2, a2, d2;
-
       // r = tm1*r
-      r2 = tm1 * r;
+      Vec3 r2 = tm1 * r;
       
       // v = tm1*v+tm2*r
-      v2 = tm1 * v 
-         + tm2 * r;
+      Vec3 v2 = tm1 * v 
+              + tm2 * r;
 
       // a = tm1*a+2.0*tm2*v+tm3*r
-      a2 = tm1 * a
-         + tm2 * v * 2.0
-         + tm3 * r;
+      Vec3 a2 = tm1 * a
+              + tm2 * v * 2.0
+              + tm3 * r;
 
       // da = tm1*da+3.0*tm2*a+3.0*tm3*v+tm4*r
-      d2 = tm1 * d
-         + tm2 * a * 3.0
-         + tm3 * v * 3.0 
-         + tm4 * r;
+      Vec3 d2 = tm1 * d
+              + tm2 * a * 3.0
+              + tm3 * v * 3.0 
+              + tm4 * r;
 
       Vector<double> state(12,0.0);
       for(int i=0; i<3; i++)
@@ -493,8 +496,10 @@ namespace gpstk
    Vector<double> ReferenceFrames::ECEFStateToJ2k(UTCTime UTC, Vector<double> ecefState)
       throw(Exception)
    {
+      typedef FixedMatrix<double,3,3> Mat3;
+      typedef FixedVector<double,3> Vec3;
 
-      Matrix<double> POM, Theta, NP;
+      Mat3 POM, Theta, NP;
       J2kToECEFMatrix(UTC,POM,Theta,NP);
 
       // get Theta rates
@@ -506,59 +511,48 @@ namespace gpstk
       double cs2[3][3]={{-1,0,0},{0,-1,0},{0,0,0}};
       double cs3[3][3]={{0,-1,0},{1,0,0},{0,0,0}};
 
-      Matrix<double> s1(3,3,0.0),s2(3,3,0.0),s3(3,3,0.0);
-      s1 = &cs1[0][0];
-      s2 = &cs2[0][0];
-      s3 = &cs3[0][0];
+      Mat3 s1(&cs1[0][0]), s2(&cs2[0][0]), s3(&cs3[0][0]);
 
       // dTheta1 dTheta2 dTheta3
-      Matrix<double> dTheta1 = s1 * Theta * dera1;
+      Mat3 dTheta1 = s1 * Theta * dera1;
 
-      Matrix<double> dTheta2 = s2 * Theta * ( dera1 * dera1) 
+      Mat3 dTheta2 = s2 * Theta * ( dera1 * dera1) 
          + dTheta1*dera2;
 
-      Matrix<double> dTheta3 = s3 * Theta * ( dera1 * dera1 * dera1)
+      Mat3 dTheta3 = s3 * Theta * ( dera1 * dera1 * dera1)
          + s2 * Theta * (2.0 * dera1 * dera2) 
          + dTheta2 * dera2
          + dTheta1 * dera3;
 
-      Vector<double> r(3,0.0),v(3,0.0),a(3,0.0),d(3,0.0);
-      for(int i=0; i<3; i++)
-      {
-         r(i) =  ecefState(i+0);
-         v(i) =  ecefState(i+3);
-         a(i) =  ecefState(i+6);
-         d(i) =  ecefState(i+9);
-      }
+      Vec3 r(ecefState.begin()), v(ecefState.begin() + 3),
+           a(ecefState.begin() + 6), d(ecefState.begin() + 9);
 
       // tm1 = POM*Theta*NP
-      Matrix<double> tm1 = transpose( POM * Theta * NP );
+      Mat3 tm1 = transpose( POM * Theta * NP );
       // tm2 = POM*dTheta1*NP
-      Matrix<double> tm2 = transpose( POM * dTheta1 * NP );
+      Mat3 tm2 = transpose( POM * dTheta1 * NP );
       // tm3 = POM*dTheta3*NP
-      Matrix<double> tm3 = transpose( POM * dTheta2 * NP );
+      Mat3 tm3 = transpose( POM * dTheta2 * NP );
       // tm4 = POM*dTheta4*NP
-      Matrix<double> tm4 = transpose( POM * dTheta3 * NP );
-
-      Vector<double> r2, v2, a2, d2;
+      Mat3 tm4 = transpose( POM * dTheta3 * NP );
 
       // r = tm1*r
-      r2 = tm1 * r;
+      Vec3 r2 = tm1 * r;
 
       // v = tm1*v+tm2*r
-      v2 = tm1 * v 
-         + tm2 * r;
+      Vec3 v2 = tm1 * v 
+              + tm2 * r;
 
       // a = tm1*a+2.0*tm2*v+tm3*r
-      a2 = tm1 * a
-         + tm2 * v * 2.0
-         + tm3 * r;
+      Vec3 a2 = tm1 * a
+              + tm2 * v * 2.0
+              + tm3 * r;
 
       // da = tm1*da+3.0*tm2*a+3.0*tm3*v+tm4*r
-      d2 = tm1 * d
-         + tm2 * a * 3.0
-         + tm3 * v * 3.0 
-         + tm4 * r;
+      Vec3 d2 = tm1 * d
+              + tm2 * a * 3.0
+              + tm3 * v * 3.0 
+              + tm4 * r;
 
       Vector<double> state(12,0.0);
       for(int i=0; i<3; i++)
@@ -803,46 +797,22 @@ namespace gpstk
       // Rotate an r-matrix about the x-axis.
    Matrix<double> ReferenceFrames::Rx(const double& angle)
    {
-      const double s = std::sin(angle);
-      const double c = std::cos(angle);
-
-      const double a[9] = { 1, 0, 0, 0, c, s, 0,-s, c };
-
-      Matrix<double> r(3,3,0.0);
-      r = a;
-
-      return r;
+      return fixedRotation(angle, 1).toMatrix();
    }
 
       // Rotate an r-matrix about the y-axis.
    Matrix<double> ReferenceFrames::Ry(const double& angle)
    {
-      const double s = std::sin(angle);
-      const double c = std::cos(angle);
-
-      const double a[9] = { c, 0,-s, 0, 1, 0, s, 0, c };
-
-      Matrix<double> r(3,3,0.0);
-      r = a;
-
-      return r;
+      return fixedRotation(angle, 2).toMatrix();
    }
 
       // Rotate an r-matrix about the z-axis.
    Matrix<double> ReferenceFrames::Rz(const double& angle)
    {
-      const double s = std::sin(angle);
-      const double c = std::cos(angle);
-
-      const double a[9] = { c, s, 0,-s, c, 0, 0, 0, 1 };
-
-      Matrix<double> r(3,3,0.0);
-      r = a;
-
-      return r;
+      return fixedRotation(angle, 3).toMatrix();
    }
 
-   Matrix<double> ReferenceFrames::iauPmat76(CommonTime TT)
+   FixedMatrix<double,3,3> ReferenceFrames::iauPmat76(CommonTime TT)
    {
       
       // Interval between fundamental epoch J2000.0 and start epoch (JC). 
@@ -862,7 +832,8 @@ namespace gpstk
       double theta = ((2004.3109 + (-0.85330 - 0.000217 * t0) * t0)
          + ((-0.42665 - 0.000217 * t0) - 0.041833 * t) * t) * tas2r;
 
-      return ( Rz(-z) * Ry(theta) * Rz(-zeta) );
+      return ( fixedRotation(-z, 3) * fixedRotation(theta, 2)
+               * fixedRotation(-zeta, 3) );
 
    }  // End of method 'ReferenceFrames::iauPmat76()'
    
@@ -1171,11 +1142,12 @@ namespace gpstk
    }  // End of method 'ReferenceFrames::iauGmst00()'
 
       // Nutation matrix from nutation angles
-   Matrix<double> ReferenceFrames::iauNmat(const double& epsa,
-                                           const double& dpsi, 
-                                           const double& deps)
+   FixedMatrix<double,3,3> ReferenceFrames::iauNmat(const double& epsa,
+                                                    const double& dpsi, 
+                                                    const double& deps)
    {
-      return ( Rx(-(epsa+deps)) * Rz(-dpsi) * Rx(epsa) );
+      return ( fixedRotation(-(epsa+deps), 1) * fixedRotation(-dpsi, 3)
+               * fixedRotation(epsa, 1) );
    }
 
 
@@ -46,6 +46,7 @@
 
 #include "Vector.hpp"
 #include "Matrix.hpp"
+#include "FixedMatrix.hpp"
 #include "SolarSystem.hpp"
 #include "UTCTime.hpp"
 
@@ -155,6 +156,14 @@ namespace gpstk
          throw(Exception);
 
 
+         /// ECEF = POM * Theta * NP * J2k, without heap allocation
+      static void J2kToECEFMatrix(UTCTime                  UTC, 
+                                  FixedMatrix<double,3,3>& POM,
+                                  FixedMatrix<double,3,3>& Theta, 
+                                  FixedMatrix<double,3,3>& NP)
+         throw(Exception);
+
+
          /// Get ECI to ECF transform matrix, POM * Theta * NP 
       static Matrix<double> J2kToECEFMatrix(UTCTime UTC);
          
@@ -240,7 +249,7 @@ namespace gpstk
 
          
          /// Precession matrix by IAU 1976 model
-      static Matrix<double> iauPmat76(CommonTime TT);
+      static FixedMatrix<double,3,3> iauPmat76(CommonTime TT);
          
          /// Nutation angles by IAU 1980 model
       static void nutationAngles(CommonTime TT, double& dpsi, double& deps);
@@ -256,9 +265,9 @@ namespace gpstk
 
            
          /// Nutation matrix from nutation angles
-      static Matrix<double> iauNmat(const double& epsa, 
-                                    const double& dpsi, 
-                                    const double& deps);
+      static FixedMatrix<double,3,3> iauNmat(const double& epsa, 
+                                             const double& dpsi, 
+                                             const double& deps);
 
          /// earth rotation angle
       static double earthRotationAngle(CommonTime UT1);
@@ -55,8 +55,10 @@
 #include "PolyFit.hpp"
 #include "GNSSconstants.hpp"    // PI,C_MPS,OSC_FREQ_GPS,L1_MULT_GPS,L2_MULT_GPS
 #include "RobustStats.hpp"
+#include "ThreadUtils.hpp"
 // geomatics
 #include "DiscCorr.hpp"
+#include "SatPassKernels.hpp"
 
 using namespace std;
 using namespace gpstk;
@@ -313,6 +315,10 @@ public:
 
    //~GDCPass(void) { };
 
+   /// define wavelengths and the coefficients of the linear combinations,
+   /// given the satellite system and (GLONASS only) the frequency channel GLOn
+   void defineWavelengths(void) throw();
+
    /// edit obvious outliers, divide into segments using MaxGap
    int preprocess(void) throw(Exception);
 
@@ -459,6 +465,21 @@ public:
    void deleteSegment(list<Segment>::iterator& it, string msg=string())
       throw(Exception);
 
+   /// these are used only to associate a unique number in the log file with
+   /// each pass (one per call) and with each (WL,GF) fix
+   int GDCUnique;
+   int GDCUniqueFix;
+
+   /// obs types, indexes into both data and this vector are L1,L2,etc...
+   vector<string> DCobstypes;
+
+   /// wavelength and other frequency-dependent quantities, determined early in
+   /// DC() and used in linear combinations
+   int GLOn;
+   double wl1,wl2,wlwl,wlgf;        // wavelengths: L1,L2,widelane,narrowlane
+   double wl1r,wl2r,wl1p,wl2p;      // coefficients in widelane linear combinations
+   double gf1r,gf2r,gf1p,gf2p;      // coefficients in geometry-free linear combinations
+
 private:
 
    /// define this function so that invalid labels will throw, because
@@ -506,7 +527,6 @@ static const int P1 = 2;
 static const int P2 = 3;
 static const int A1 = 4;
 static const int A2 = 5;
-vector<string> DCobstypes; // indexes into both data and this vector are L1,L2,etc...
 
 //------------------------------------------------------------------------------------
 // Return values (used by all routines within this module):
@@ -519,18 +539,12 @@ static const int Singular=-1;
 static const int ReturnOK=0;
 
 //------------------------------------------------------------------------------------
-// these are used only to associate a unique number in the log file with each pass
-static int GDCUnique=0;     // unique number for each call
-static int GDCUniqueFix;    // unique for each (WL,GF) fix
-static string GDCtag="GDC"; // begin each line of return message
-
-//------------------------------------------------------------------------------------
-// wavelength and other frequency-dependent quantities, determined early in DC()
-// constants used in linear combinations
-int GLOn;
-double wl1,wl2,wlwl,wlgf;        // wavelengths: L1,L2,widelane,narrowlane
-double wl1r,wl2r,wl1p,wl2p;      // coefficients in widelane linear combinations
-double gf1r,gf2r,gf1p,gf2p;      // coefficients in geometry-free linear combinations
+// unique number of the last call; GDCPass::GDCUnique is taken from this,
+// under the lock, so that passes corrected concurrently are numbered as if the
+// calls had been made one after another
+static int GDCUniqueCount=0;
+static Mutex GDCUniqueLock;
+static const string GDCtag("GDC"); // begin each line of return message
 
 //------------------------------------------------------------------------------------
 // Flags - constants used to mark slips, etc. using the SatPass flag:
@@ -564,30 +578,27 @@ const unsigned short GDCPass::FIX      =  24;  // = WLFIX | GFFIX
 // either !(flag & OK) or (flag ^ OK) for bad data, and (flag & OK) for good data
 
 //------------------------------------------------------------------------------------
-// The discontinuity corrector function
-//------------------------------------------------------------------------------------
-// yes you need the gpstk::
-int gpstk::DiscontinuityCorrector(SatPass& svp,
-                                  GDCconfiguration& gdc,
-                                  vector<string>& editCmds,
-                                  string& retMessage,
-                                  int GLOn_in)
+// The discontinuity corrector, for one pass with unique number GDCUnique.
+// This uses no state other than its arguments, so it may be called concurrently
+// for different passes.
+static int CorrectPass(SatPass& svp,
+                       const GDCconfiguration& gdc,
+                       int GDCUnique,
+                       vector<string>& editCmds,
+                       string& retMessage,
+                       int GLOn)
    throw(Exception)
 {
 try {
    unsigned int i,j;
    int iret;
 
-   if(gdc.getParameter("ResetUnique") != 0)
-      { GDCUnique=0; gdc.setParameter("ResetUnique=0"); }
-   GDCUnique++;
-
    //if(!retMessage.empty()) { GDCtag = retMessage; }
    retMessage = "";
 
    // --------------------------------------------------------------------------------
    // require obstypes L1,L2,C1/P1,C2/P2, and add two auxiliary arrays
-   DCobstypes.clear();
+   vector<string> DCobstypes;
    DCobstypes.push_back("L1");
    DCobstypes.push_back("L2");
    DCobstypes.push_back((int(gdc.getParameter("useCA1"))) == 0 ? "P1" : "C1");
@@ -635,11 +646,12 @@ try {
    // --------------------------------------------------------------------------------
    // create a GDCPass from the input SatPass (modified) and GDC configuration
    GDCPass gp(nsvp,gdc);
+   gp.GDCUnique = GDCUnique;
+   gp.DCobstypes = DCobstypes;
 
    // --------------------------------------------------------------------------------
    // if the satellite is Glonass, compute the frequency channel, if necessary,
    // and define wavelengths and other constants for this satellite
-   GLOn = GLOn_in;
    if(sat.system == SatID::systemGlonass) {
 
       // only compute it if it is out of range
@@ -661,7 +673,201 @@ try {
             return GLOfailed;
          }
       }
+   }
+   gp.GLOn = GLOn;
+   gp.defineWavelengths();
+
+   // --------------------------------------------------------------------------------
+   // implement the DC algorithm using the GDCPass
+   // NB search for 'change the arrays' for places where arrays are re-defined
+   // NB search for 'change the data' for places where the data is modified (! biases)
+   // NB search for 'change the bias' for places where the bias is changed
+   for(;;) {      // a convenience...
+      // preparation
+      if( (iret = gp.preprocess() )) break;
+      if( (iret = gp.linearCombinations() )) break;
+
+      // WL
+      if( (iret = gp.detectWLslips() )) break;
+      if( (iret = gp.fixAllSlips("WL") )) break;
+
+      // GF
+      if( (iret = gp.prepareGFdata() )) break;
+      if( (iret = gp.detectGFslips() )) break;
+      if( (iret = gp.WLconsistencyCheck() )) break;
+      if( (iret = gp.fixAllSlips("GF") )) break;
+
+      break;      // mandatory
+   }
+
+   // --------------------------------------------------------------------------------
+   // generate editing commands for deleted (flagged) data and slips,
+   // use editing command (slips and deletes) to modify the original SatPass data
+   // and print ending summary
+   retMessage = gp.finish(iret, svp, editCmds);
+
+   return iret;
+}
+catch(Exception& e) { GPSTK_RETHROW(e); }
+catch(std::exception& e) {
+   Exception E("std except: "+string(e.what())); GPSTK_THROW(E);
+}
+catch(...) { Exception e("Unknown exception"); GPSTK_THROW(e); }
+}
+
+//------------------------------------------------------------------------------------
+// The discontinuity corrector function
+//------------------------------------------------------------------------------------
+// yes you need the gpstk::
+int gpstk::DiscontinuityCorrector(SatPass& svp,
+                                  GDCconfiguration& gdc,
+                                  vector<string>& editCmds,
+                                  string& retMessage,
+                                  int GLOn_in)
+   throw(Exception)
+{
+try {
+   int unique;
+   {
+      MutexLock lock(GDCUniqueLock);
+      if(gdc.getParameter("ResetUnique") != 0)
+         { GDCUniqueCount=0; gdc.setParameter("ResetUnique=0"); }
+      unique = ++GDCUniqueCount;
+   }
+
+   return CorrectPass(svp, gdc, unique, editCmds, retMessage, GLOn_in);
+}
+catch(Exception& e) { GPSTK_RETHROW(e); }
+catch(std::exception& e) {
+   Exception E("std except: "+string(e.what())); GPSTK_THROW(E);
+}
+catch(...) { Exception e("Unknown exception"); GPSTK_THROW(e); }
+}
+
+//------------------------------------------------------------------------------------
+// Data shared by the threads of the parallel discontinuity corrector.
+struct GDCTask {
+   vector<SatPass> *SPList;
+   const GDCconfiguration *config;
+   int firstUnique;                 // unique number of SPList[0]
+   const vector<int> *GLOn;
+   vector< vector<string> > *editCmds;
+   vector<string> *retMessages;
+   vector<int> *retCodes;
+   vector<string> logs;             // debug output of each pass
+   vector<Exception> errors;        // exception thrown by each pass, if any
+   vector<bool> failed;
+   size_t next;                     // next pass to correct
+   Mutex lock;
+};
+
+// Correct passes, taken in order from the task, until there are none left.
+static void RunGDCTask(void *arg)
+{
+   GDCTask& task(*static_cast<GDCTask *>(arg));
+   for(;;) {
+      size_t n;
+      {
+         MutexLock lock(task.lock);
+         if(task.next >= task.SPList->size()) break;
+         n = task.next++;
+      }
 
+      // each pass writes its debug output to its own buffer
+      ostringstream oss;
+      GDCconfiguration config(*task.config);
+      config.setDebugStream(oss);
+      try {
+         (*task.retCodes)[n] = CorrectPass((*task.SPList)[n], config,
+                                           task.firstUnique + int(n),
+                                           (*task.editCmds)[n],
+                                           (*task.retMessages)[n],
+                                           (n < task.GLOn->size() ?
+                                                         (*task.GLOn)[n] : -99));
+      }
+      catch(Exception& e) {
+         task.errors[n] = e;
+         task.failed[n] = true;
+      }
+      task.logs[n] = oss.str();
+   }
+}
+
+//------------------------------------------------------------------------------------
+// The discontinuity corrector, for a vector of passes
+void gpstk::DiscontinuityCorrector(vector<SatPass>& SPList,
+                                   GDCconfiguration& gdc,
+                                   vector< vector<string> >& editCmds,
+                                   vector<string>& retMessages,
+                                   vector<int>& retCodes,
+                                   const vector<int>& GLOn_in,
+                                   unsigned int numThreads,
+                                   vector<string> *debugLogs)
+   throw(Exception)
+{
+try {
+   const size_t N(SPList.size());
+   editCmds.assign(N, vector<string>());
+   retMessages.assign(N, string());
+   retCodes.assign(N, 0);
+
+   GDCTask task;
+   task.SPList = &SPList;
+   task.config = &gdc;
+   task.GLOn = &GLOn_in;
+   task.editCmds = &editCmds;
+   task.retMessages = &retMessages;
+   task.retCodes = &retCodes;
+   task.logs.resize(N);
+   task.errors.resize(N);
+   task.failed.resize(N, false);
+   task.next = 0;
+
+   // reserve one unique number for each pass, in order
+   {
+      MutexLock lock(GDCUniqueLock);
+      if(gdc.getParameter("ResetUnique") != 0)
+         { GDCUniqueCount=0; gdc.setParameter("ResetUnique=0"); }
+      task.firstUnique = GDCUniqueCount + 1;
+      GDCUniqueCount += int(N);
+   }
+
+   // this thread works too; passes left by threads that fail to start are
+   // simply taken by the others
+   ThreadGroup group;
+   const size_t threads(std::min<size_t>(numThreads, N));
+   for(size_t t=1; t<threads; t++)
+      if(!group.start(RunGDCTask, &task)) break;
+   RunGDCTask(&task);
+   group.join();
+
+   // debug output, in the order of the passes
+   if(debugLogs)
+      *debugLogs = task.logs;
+   else {
+      ostream& os(gdc.getDebugStream());
+      for(size_t n=0; n<N; n++) os << task.logs[n];
+   }
+
+   // pass on the exception of the first pass that threw
+   for(size_t n=0; n<N; n++)
+      if(task.failed[n]) GPSTK_RETHROW(task.errors[n]);
+}
+catch(Exception& e) { GPSTK_RETHROW(e); }
+catch(std::exception& e) {
+   Exception E("std except: "+string(e.what())); GPSTK_THROW(E);
+}
+catch(...) { Exception e("Unknown exception"); GPSTK_THROW(e); }
+}
+
+//------------------------------------------------------------------------------------
+//------------------------------------------------------------------------------------
+// class GDCPass member functions
+//------------------------------------------------------------------------------------
+//------------------------------------------------------------------------------------
+void GDCPass::defineWavelengths(void) throw()
+{
+   if(sat.system == SatID::systemGlonass) {
       // GLO Frequency(Hz) L1 is 1602.0e6 + n*562.5e3 Hz = 9 * (178 + n*0.0625) MHz
       //                   L2    1246.0e6 + n*437.5e3 Hz = 7 * (178 + n*0.0625) MHz
       // Note that L1/L2 is always 9/7 for freq, 7/9 for wavelength
@@ -711,48 +917,8 @@ try {
       gf1p = wl1;
       gf2p = -wl2;
    }
-
-   // --------------------------------------------------------------------------------
-   // implement the DC algorithm using the GDCPass
-   // NB search for 'change the arrays' for places where arrays are re-defined
-   // NB search for 'change the data' for places where the data is modified (! biases)
-   // NB search for 'change the bias' for places where the bias is changed
-   for(;;) {      // a convenience...
-      // preparation
-      if( (iret = gp.preprocess() )) break;
-      if( (iret = gp.linearCombinations() )) break;
-
-      // WL
-      if( (iret = gp.detectWLslips() )) break;
-      if( (iret = gp.fixAllSlips("WL") )) break;
-
-      // GF
-      if( (iret = gp.prepareGFdata() )) break;
-      if( (iret = gp.detectGFslips() )) break;
-      if( (iret = gp.WLconsistencyCheck() )) break;
-      if( (iret = gp.fixAllSlips("GF") )) break;
-
-      break;      // mandatory
-   }
-
-   // --------------------------------------------------------------------------------
-   // generate editing commands for deleted (flagged) data and slips,
-   // use editing command (slips and deletes) to modify the original SatPass data
-   // and print ending summary
-   retMessage = gp.finish(iret, svp, editCmds);
-
-   return iret;
-}
-catch(Exception& e) { GPSTK_RETHROW(e); }
-catch(std::exception& e) {
-   Exception E("std except: "+string(e.what())); GPSTK_THROW(E);
-}
-catch(...) { Exception e("Unknown exception"); GPSTK_THROW(e); }
 }
 
-//------------------------------------------------------------------------------------
-//------------------------------------------------------------------------------------
-// class GDCPass member functions
 //------------------------------------------------------------------------------------
 GDCPass::GDCPass(SatPass& sp, const GDCconfiguration& gdc)
       : SatPass(sp.getSat(), sp.getDT(), sp.getObsTypes())
@@ -783,6 +949,9 @@ GDCPass::GDCPass(SatPass& sp, const GDCconfiguration& gdc)
 
    *((GDCconfiguration*)this) = gdc;
 
+   GDCUnique = GDCUniqueFix = 0;
+   GLOn = -99;
+
    learn.clear();
 }
 
@@ -925,42 +1094,44 @@ catch(...) { Exception e("Unknown exception"); GPSTK_THROW(e); }
 int GDCPass::linearCombinations(void) throw(Exception)
 {
 try {
-   unsigned int i;
-   double wlr,wlp,wlbias,gfr,gfp;
+   unsigned int i,j;
    list<Segment>::iterator it;
 
+   DualFrequencyCoefficients coef;
+   coef.wl1r = wl1r; coef.wl2r = wl2r;
+   coef.wl1p = wl1p; coef.wl2p = wl2p;
+   coef.gf1r = gf1r; coef.gf2r = gf2r;      // gfr here is P2-P1
+   coef.gf1p = gf1p; coef.gf2p = gf2p;
+   coef.wlwl = wlwl;
+
+   const unsigned short *flag = spdvector.flags();
+   double *l1 = spdvector.column(L1), *l2 = spdvector.column(L2);
+   double *p1 = spdvector.column(P1), *p2 = spdvector.column(P2);
+
    // iterate over segments
    for(it=SegList.begin(); it != SegList.end(); it++) {
       it->npts = 0;                       // re-compute npts here
 
-      // loop over points in this segment
-      for(i=it->nbeg; i<=it->nend; i++) {
-         if(!(spdvector[i].flag & OK)) continue;
+      // loop over runs of consecutive good points in this segment
+      for(i=it->nbeg; i<=it->nend; i=j) {
+         if(!(flag[i] & OK)) { j = i+1; continue; }
+         for(j=i+1; j<=it->nend && (flag[j] & OK); j++);
 
-         // narrow lane range (m)
-         wlr = wl1r * spdvector[i].data[P1] + wl2r * spdvector[i].data[P2];
-         // wide lane phase (m)
-         wlp = wl1p * spdvector[i].data[L1] + wl2p * spdvector[i].data[L2];
-         // geometry-free range (m)
-         gfr =        spdvector[i].data[P1] -        spdvector[i].data[P2];
-         // geometry-free phase (m)
-         gfp = gf1p * spdvector[i].data[L1] + gf2p * spdvector[i].data[L2];
-         // wide lane bias (cycles)
-         wlbias = (wlp-wlr)/wlwl;
+         // change the arrays, in place:
+         // P1 = wide lane bias (cycles) = (WL phase - NL range)/wlwl
+         // L2 = geometry-free phase (m)
+         // P2 = geometry-free range P2-P1 (m)
+         // L1 = GFP - (P2-P1), only used in GF
+         dualFrequencyKernel(j-i, l1+i, l2+i, p1+i, p2+i, coef,
+                             p1+i, l2+i, p2+i, l1+i);
 
          // change the bias
          if(it->npts == 0) {                             // first good point
-            it->bias1 = wlbias;                          // WL bias (NWL)
-            it->bias2 = gfp;                             // GFP bias
+            it->bias1 = p1[i];                           // WL bias (NWL)
+            it->bias2 = l2[i];                           // GFP bias
          }
 
-         // change the arrays
-         spdvector[i].data[L1] = gfp + gfr;              // only used in GF
-         spdvector[i].data[L2] = gfp;
-         spdvector[i].data[P1] = wlbias;
-         spdvector[i].data[P2] = - gfr;
-
-         it->npts++;
+         it->npts += j-i;
       }
    }
 
@@ -1169,38 +1340,45 @@ int GDCPass::firstDifferences(string which) throw(Exception)
 try {
    //if(A1.size() != size()) return FatalProblem;
 
-   int i,iprev=-1;
+   const bool WL(which == string("WL")), GF(which == string("GF"));
+   const int n(size());
+   int i,j,iprev=-1;
 
-   for(i=0; i<static_cast<int>(size()); i++) {
+   const unsigned short *flag = spdvector.flags();
+   double *a1 = spdvector.column(A1), *a2 = spdvector.column(A2);
+   // WL differences the WLbias (P1); GF differences L1 = raw residual GFP-GFR
+   // into A1 and L2 = GFP into A2
+   const double *x1 = spdvector.column(WL ? P1 : L1);
+   const double *x2 = spdvector.column(L2);
+
+   // loop over runs of consecutive good points
+   for(i=0; i<n; i=j) {
       // ignore bad data
-      if(!(spdvector[i].flag & OK)) {
-         spdvector[i].data[A1] = spdvector[i].data[A2] = 0.0;
+      if(!(flag[i] & OK)) {
+         a1[i] = a2[i] = 0.0;
+         j = i+1;
          continue;
       }
+      for(j=i+1; j<n && (flag[j] & OK); j++);
 
       // compute first differences - 'change the arrays' A1 and A2
-      if(which == string("WL")) {
-         if(iprev == -1)
-            spdvector[i].data[A1] = 0.0;
-         else
-            spdvector[i].data[A1] =
-               (spdvector[i].data[P1] - spdvector[iprev].data[P1]);
+      if(WL) {
+         a1[i] = (iprev == -1 ? 0.0 : x1[i] - x1[iprev]);
+         differenceKernel(j-i, x1+i, a1+i+1);
       }
-      else if(which == string("GF")) {
+      else if(GF) {
          if(iprev == -1)            // first difference not defined at first point
-            spdvector[i].data[A1] = spdvector[i].data[A2] = 0.0;
+            a1[i] = a2[i] = 0.0;
          else {
-            // compute first difference of L1 = raw residual GFP-GFR
-            spdvector[i].data[A1] =
-               (spdvector[i].data[L1] - spdvector[iprev].data[L1]);
-            // compute first difference of L2 = GFP
-            spdvector[i].data[A2] =
-               (spdvector[i].data[L2] - spdvector[iprev].data[L2]);
+            a1[i] = x1[i] - x1[iprev];
+            a2[i] = x2[i] - x2[iprev];
          }
+         differenceKernel(j-i, x1+i, a1+i+1);
+         differenceKernel(j-i, x2+i, a2+i+1);
       }
 
-      // go to next point
-      iprev = i;
+      // go to next run
+      iprev = j-1;
    }
 
    return ReturnOK;
@@ -49,6 +49,7 @@
 #include "RinexObsHeader.hpp"
 #include "SatPass.hpp"
 #include "Exception.hpp"
+#include "ThreadUtils.hpp"
 
 #include <iostream>
 #include <fstream>
@@ -81,10 +82,11 @@ namespace gpstk {
       void setParameter(std::string label, double value) throw(gpstk::Exception);
 
          /// Get the parameter in the configuration corresponding to label
-      double getParameter(std::string label) throw()
+      double getParameter(std::string label) const throw()
       {
-         if(CFG.find(label) == CFG.end()) return 0.0;    // TD throw?
-         return CFG[label];
+         std::map<std::string,double>::const_iterator it(CFG.find(label));
+         if(it == CFG.end()) return 0.0;    // TD throw?
+         return it->second;
       }
 
          /// Get the description of a parameter
@@ -98,6 +100,9 @@ namespace gpstk {
          /// Tell GDCconfiguration to which stream to send debugging output.
       void setDebugStream(std::ostream& os) { p_oflog = &os; }
 
+         /// Get the stream to which debugging output is sent.
+      std::ostream& getDebugStream(void) const { return *p_oflog; }
+
          /// Print help page, including descriptions and current values of all
          /// the parameters, to the ostream. If 'advanced' is true, also print
          /// advanced parameters.
@@ -265,6 +270,35 @@ namespace gpstk {
                               int GLOn=-99)
       throw(Exception);
 
+   /// GPSTK Discontinuity Corrector for a set of satellite passes, which are
+   /// corrected concurrently. The results are identical to those of calling
+   /// DiscontinuityCorrector() for each pass in order: each pass gets the
+   /// unique number it would get from that serial call, and its debug output is
+   /// written to the config debug stream in the order of the passes, after all
+   /// passes are done.
+   ///
+   /// @param SPList   vector of SatPass objects containing the input data;
+   ///                 corrected on output.
+   /// @param config   GDCconfiguration object.
+   /// @param EditCmds (output) RinexEditor commands for each pass.
+   /// @param retMsg   (output) string summary of results for each pass.
+   /// @param retCodes (output) return code for each pass; see above.
+   /// @param GLOn     GLONASS frequency channel for each pass; if empty or too
+   ///                 short, -99 (UNKNOWN) is used.
+   /// @param numThreads maximum number of threads to use.
+   /// @param debugLogs if not null, debug output of each pass is returned here
+   ///                 instead of being written to the config debug stream.
+   /// @throw Exception thrown by the first pass (in order) that failed.
+   void DiscontinuityCorrector(std::vector<SatPass>& SPList,
+                               GDCconfiguration& config,
+                               std::vector< std::vector<std::string> >& EditCmds,
+                               std::vector<std::string>& retMsg,
+                               std::vector<int>& retCodes,
+                               const std::vector<int>& GLOn = std::vector<int>(),
+                               unsigned int numThreads = numProcessors(),
+                               std::vector<std::string> *debugLogs = 0)
+      throw(Exception);
+
    //@}
 
 }  // end namespace gpstk
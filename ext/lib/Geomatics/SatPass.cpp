@@ -115,9 +115,8 @@ SatPass& SatPass::operator=(const SatPass& right) throw()
       firstTime = right.firstTime;
       lastTime = right.lastTime;
       ngood = right.ngood;
-      spdvector.resize(right.spdvector.size());
-      for(int i=0; i<right.spdvector.size(); i++)
-         spdvector[i] = right.spdvector[i];
+      // copy and swap, so that the storage of the old data is released
+      SatPassColumns(right.spdvector).swap(spdvector);
    }
 
    return *this;
@@ -751,6 +750,13 @@ bool SatPass::includesTime(const Epoch& tt) const throw()
    return true;
 }
 
+bool SatPass::endsBefore(const Epoch& tt) const throw()
+{
+   if(spdvector.size() == 0 || tt - lastTime < 1.e-8) return false;
+   // as in push_back()
+   return ((countForTime(tt) - int(spdvector[spdvector.size()-1].ndt)) * dt > maxGap);
+}
+
 // create a new SatPass from the given one, starting at count N.
 // modify this SatPass to end just before N.
 // return true if successful.
@@ -781,7 +787,7 @@ try {
          j = newSP.countForTime(tt);
          spdvector[i].ndt = j;
          spdvector[i].toffset = tt - newSP.firstTime - j*dt;
-         newSP.spdvector.push_back(spdvector[i]);
+         newSP.spdvector.push_back(spdvector,i);
       }
    }
 
@@ -823,7 +829,7 @@ try {
          spdvector[i].ndt = int(0.5+(tt-newfirstTime)/(N*dt));
          spdvector[i].toffset = tt - newfirstTime - spdvector[i].ndt * N * dt;
       }
-      spdvector[j] = spdvector[i];
+      spdvector.copy(i,j);
       if(spdvector[j].flag != BAD) ngood++;
       j++;
    }
@@ -924,7 +930,100 @@ struct SatPass::SatPassData SatPass::getData(unsigned int i) const
       Exception e("invalid in getData() " + asString(i));
       GPSTK_THROW(e);
    }
-   return spdvector[i];
+   return spdvector.get(i);
+}
+
+// ---------------------------- private SatPassColumns functions -----------------
+// add an epoch at the end
+void SatPass::SatPassColumns::push_back(const SatPassData& spd) throw()
+{
+   if(flag.empty() && data.size() != spd.data.size()) {
+      data.resize(spd.data.size());
+      lli.resize(spd.data.size());
+      ssi.resize(spd.data.size());
+   }
+
+   flag.push_back(spd.flag);
+   ndt.push_back(spd.ndt);
+   toffset.push_back(spd.toffset);
+   for(unsigned int k=0; k<data.size(); k++) {
+      data[k].push_back(spd.data[k]);
+      lli[k].push_back(spd.lli[k]);
+      ssi[k].push_back(spd.ssi[k]);
+   }
+}
+
+// add epoch i of another store at the end
+void SatPass::SatPassColumns::push_back(const SatPassColumns& right, unsigned int i)
+   throw()
+{
+   if(flag.empty() && data.size() != right.data.size()) {
+      data.resize(right.data.size());
+      lli.resize(right.data.size());
+      ssi.resize(right.data.size());
+   }
+
+   flag.push_back(right.flag[i]);
+   ndt.push_back(right.ndt[i]);
+   toffset.push_back(right.toffset[i]);
+   for(unsigned int k=0; k<data.size(); k++) {
+      data[k].push_back(right.data[k][i]);
+      lli[k].push_back(right.lli[k][i]);
+      ssi[k].push_back(right.ssi[k][i]);
+   }
+}
+
+// copy of epoch i
+struct SatPass::SatPassData SatPass::SatPassColumns::get(unsigned int i) const
+   throw()
+{
+   SatPassData spd(data.size());
+   spd.flag = flag[i];
+   spd.ndt = ndt[i];
+   spd.toffset = toffset[i];
+   for(unsigned int k=0; k<data.size(); k++) {
+      spd.data[k] = data[k][i];
+      spd.lli[k] = lli[k][i];
+      spd.ssi[k] = ssi[k][i];
+   }
+   return spd;
+}
+
+// copy epoch 'from' onto epoch 'to'
+void SatPass::SatPassColumns::copy(unsigned int from, unsigned int to) throw()
+{
+   flag[to] = flag[from];
+   ndt[to] = ndt[from];
+   toffset[to] = toffset[from];
+   for(unsigned int k=0; k<data.size(); k++) {
+      data[k][to] = data[k][from];
+      lli[k][to] = lli[k][from];
+      ssi[k][to] = ssi[k][from];
+   }
+}
+
+// keep the first n epochs, or add epochs with flag OK and zero data
+void SatPass::SatPassColumns::resize(unsigned int n) throw()
+{
+   flag.resize(n, SatPass::OK);
+   ndt.resize(n, 0);
+   toffset.resize(n, 0.0);
+   for(unsigned int k=0; k<data.size(); k++) {
+      data[k].resize(n, 0.0);
+      lli[k].resize(n, 0);
+      ssi[k].resize(n, 0);
+   }
+}
+
+// exchange the contents with another store, without copying
+void SatPass::SatPassColumns::swap(SatPassColumns& right) throw()
+{
+   flag.swap(right.flag);
+   ndt.swap(right.ndt);
+   toffset.swap(right.toffset);
+   data.swap(right.data);
+   lli.swap(right.lli);
+   ssi.swap(right.ssi);
 }
 
 }  // end namespace gpstk
@@ -113,6 +113,101 @@ protected:
       }
    }; // end struct SatPassData
 
+   // --------------- SatPassColumns data structure for internal use only -------
+   //
+   /// All the SatPassData of a pass, stored by column: one contiguous array
+   /// each for flag, ndt and toffset, and one for each obs type of data, lli
+   /// and ssi. This avoids three allocations per epoch, and lets the linear
+   /// combinations and differences run down contiguous arrays.
+   /// operator[] returns a view of one epoch with the members of SatPassData,
+   /// so spdvector[i].data[k] reads and writes the columns in place.
+   class SatPassColumns {
+   public:
+      typedef std::vector< std::vector<double> > DataColumns;
+      typedef std::vector< std::vector<unsigned short> > IndicatorColumns;
+
+      /// one element of each column, at epoch i: view[k] is (*cols)[k][i]
+      template <class T, class Cols> struct ColumnView {
+         Cols *cols;
+         unsigned int i;
+         T& operator[](unsigned int k) const { return (*cols)[k][i]; }
+         unsigned int size(void) const { return cols->size(); }
+      };
+
+      /// view of the data at one epoch, with the members of SatPassData
+      template <class D, class U, class N, class DCols, class UCols>
+      struct RowView {
+         U& flag;
+         N& ndt;
+         D& toffset;
+         ColumnView<D,DCols> data;
+         ColumnView<U,UCols> lli,ssi;
+
+         RowView(U& f, N& n, D& t, DCols *d, UCols *l, UCols *s, unsigned int i)
+            : flag(f), ndt(n), toffset(t)
+         {
+            data.cols = d; data.i = i;
+            lli.cols = l; lli.i = i;
+            ssi.cols = s; ssi.i = i;
+         }
+      };
+
+      typedef RowView<double, unsigned short, unsigned int,
+                      DataColumns, IndicatorColumns> Row;
+      typedef RowView<const double, const unsigned short, const unsigned int,
+                      const DataColumns, const IndicatorColumns> ConstRow;
+
+      /// number of epochs
+      unsigned int size(void) const throw() { return flag.size(); }
+
+      /// number of obs types, fixed by the first push_back() into an empty store
+      unsigned int numTypes(void) const throw() { return data.size(); }
+
+      /// view of epoch i
+      Row operator[](unsigned int i) throw()
+         { return Row(flag[i], ndt[i], toffset[i], &data, &lli, &ssi, i); }
+      ConstRow operator[](unsigned int i) const throw()
+         { return ConstRow(flag[i], ndt[i], toffset[i], &data, &lli, &ssi, i); }
+
+      /// contiguous array of data for obs type k, and of flags
+      double *column(unsigned int k) throw()
+         { return flag.empty() ? 0 : &data[k][0]; }
+      const double *column(unsigned int k) const throw()
+         { return flag.empty() ? 0 : &data[k][0]; }
+      unsigned short *flags(void) throw()
+         { return flag.empty() ? 0 : &flag[0]; }
+      const unsigned short *flags(void) const throw()
+         { return flag.empty() ? 0 : &flag[0]; }
+
+      /// add an epoch at the end
+      void push_back(const SatPassData& spd) throw();
+
+      /// add epoch i of another store at the end
+      void push_back(const SatPassColumns& right, unsigned int i) throw();
+
+      /// copy of epoch i
+      SatPassData get(unsigned int i) const throw();
+
+      /// copy epoch 'from' onto epoch 'to'
+      void copy(unsigned int from, unsigned int to) throw();
+
+      /// keep the first n epochs, or add epochs with flag OK and zero data
+      void resize(unsigned int n) throw();
+
+      /// remove all epochs
+      void clear(void) throw() { resize(0); }
+
+      /// exchange the contents with another store, without copying
+      void swap(SatPassColumns& right) throw();
+
+   private:
+      std::vector<unsigned short> flag;
+      std::vector<unsigned int> ndt;
+      std::vector<double> toffset;
+      DataColumns data;
+      IndicatorColumns lli,ssi;
+   }; // end class SatPassColumns
+
    // --------------- private member data -----------------------------
    /// Status flag for use exclusively by the caller. It is set to 0
    /// by the constructors, but otherwise ignored by class SatPass and
@@ -138,8 +233,8 @@ protected:
    /// number of timetags with good data in the data arrays.
    unsigned int ngood;
 
-   /// ALL data in the pass, stored in SatPassData objects, in time order
-   std::vector<SatPassData> spdvector;
+   /// ALL data in the pass, stored by column, in time order
+   SatPassColumns spdvector;
 
    // --------------- private member functions ------------------------
 
@@ -497,6 +592,13 @@ public:
    /// by this object.
    bool includesTime(const Epoch& tt) const throw();
 
+   /// return true if the pass must end before the given timetag, that is if the
+   /// gap from the last data to tt is larger than the maximum gap, so that
+   /// addData() at tt would return -1. When data arrive in time order, the pass
+   /// is then complete.
+   /// @param tt        the time tag of interest
+   bool endsBefore(const Epoch& tt) const throw();
+
    /// Truncate all data at and after the given time.
    /// return -1 if ttag is at or before the start of this pass,
    /// return +1 if ttag is at or after the end of this pass,
@@ -0,0 +1,138 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+/// @file SatPassKernels.cpp
+/// Kernels on the columns of SatPass data, vectorized for double.
+
+#include "SatPassKernels.hpp"
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define GPSTK_SATPASSKERNELS_AVX
+#elif defined(__SSE2__) || defined(_M_X64) || \
+      (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define GPSTK_SATPASSKERNELS_SSE2
+#endif
+
+namespace gpstk {
+
+// Each vector loop below mirrors the scalar loop that finishes the arrays, one
+// operation for one; FMA contraction would change the results, so none is used.
+
+//------------------------------------------------------------------------------------
+void dualFrequencyKernel(std::size_t n,
+                         const double *L1, const double *L2,
+                         const double *P1, const double *P2,
+                         const DualFrequencyCoefficients& c,
+                         double *mw, double *gfp, double *gfr, double *gfpr)
+   throw()
+{
+   std::size_t i(0);
+
+#if defined(GPSTK_SATPASSKERNELS_AVX)
+   const __m256d wl1r(_mm256_set1_pd(c.wl1r)), wl2r(_mm256_set1_pd(c.wl2r));
+   const __m256d wl1p(_mm256_set1_pd(c.wl1p)), wl2p(_mm256_set1_pd(c.wl2p));
+   const __m256d gf1r(_mm256_set1_pd(c.gf1r)), gf2r(_mm256_set1_pd(c.gf2r));
+   const __m256d gf1p(_mm256_set1_pd(c.gf1p)), gf2p(_mm256_set1_pd(c.gf2p));
+   const __m256d wlwl(_mm256_set1_pd(c.wlwl));
+   for( ; i+4 <= n; i += 4) {
+      __m256d l1(_mm256_loadu_pd(L1+i)), l2(_mm256_loadu_pd(L2+i));
+      __m256d p1(_mm256_loadu_pd(P1+i)), p2(_mm256_loadu_pd(P2+i));
+      __m256d wlr(_mm256_add_pd(_mm256_mul_pd(wl1r,p1),_mm256_mul_pd(wl2r,p2)));
+      __m256d wlp(_mm256_add_pd(_mm256_mul_pd(wl1p,l1),_mm256_mul_pd(wl2p,l2)));
+      __m256d r(_mm256_add_pd(_mm256_mul_pd(gf1r,p1),_mm256_mul_pd(gf2r,p2)));
+      __m256d p(_mm256_add_pd(_mm256_mul_pd(gf1p,l1),_mm256_mul_pd(gf2p,l2)));
+      _mm256_storeu_pd(mw+i, _mm256_div_pd(_mm256_sub_pd(wlp,wlr),wlwl));
+      _mm256_storeu_pd(gfp+i, p);
+      _mm256_storeu_pd(gfr+i, r);
+      _mm256_storeu_pd(gfpr+i, _mm256_sub_pd(p,r));
+   }
+#elif defined(GPSTK_SATPASSKERNELS_SSE2)
+   const __m128d wl1r(_mm_set1_pd(c.wl1r)), wl2r(_mm_set1_pd(c.wl2r));
+   const __m128d wl1p(_mm_set1_pd(c.wl1p)), wl2p(_mm_set1_pd(c.wl2p));
+   const __m128d gf1r(_mm_set1_pd(c.gf1r)), gf2r(_mm_set1_pd(c.gf2r));
+   const __m128d gf1p(_mm_set1_pd(c.gf1p)), gf2p(_mm_set1_pd(c.gf2p));
+   const __m128d wlwl(_mm_set1_pd(c.wlwl));
+   for( ; i+2 <= n; i += 2) {
+      __m128d l1(_mm_loadu_pd(L1+i)), l2(_mm_loadu_pd(L2+i));
+      __m128d p1(_mm_loadu_pd(P1+i)), p2(_mm_loadu_pd(P2+i));
+      __m128d wlr(_mm_add_pd(_mm_mul_pd(wl1r,p1),_mm_mul_pd(wl2r,p2)));
+      __m128d wlp(_mm_add_pd(_mm_mul_pd(wl1p,l1),_mm_mul_pd(wl2p,l2)));
+      __m128d r(_mm_add_pd(_mm_mul_pd(gf1r,p1),_mm_mul_pd(gf2r,p2)));
+      __m128d p(_mm_add_pd(_mm_mul_pd(gf1p,l1),_mm_mul_pd(gf2p,l2)));
+      _mm_storeu_pd(mw+i, _mm_div_pd(_mm_sub_pd(wlp,wlr),wlwl));
+      _mm_storeu_pd(gfp+i, p);
+      _mm_storeu_pd(gfr+i, r);
+      _mm_storeu_pd(gfpr+i, _mm_sub_pd(p,r));
+   }
+#endif
+
+   for( ; i < n; i++) {
+      const double l1(L1[i]), l2(L2[i]), p1(P1[i]), p2(P2[i]);
+      const double wlr(c.wl1r*p1 + c.wl2r*p2);
+      const double wlp(c.wl1p*l1 + c.wl2p*l2);
+      const double r(c.gf1r*p1 + c.gf2r*p2);
+      const double p(c.gf1p*l1 + c.gf2p*l2);
+      mw[i] = (wlp-wlr)/c.wlwl;
+      gfp[i] = p;
+      gfr[i] = r;
+      gfpr[i] = p - r;
+   }
+}
+
+//------------------------------------------------------------------------------------
+void differenceKernel(std::size_t n, const double *x, double *dx) throw()
+{
+   if(n < 2) return;
+
+   std::size_t i(0);
+   const std::size_t m(n-1);
+
+#if defined(GPSTK_SATPASSKERNELS_AVX)
+   for( ; i+4 <= m; i += 4)
+      _mm256_storeu_pd(dx+i,
+                  _mm256_sub_pd(_mm256_loadu_pd(x+i+1),_mm256_loadu_pd(x+i)));
+#elif defined(GPSTK_SATPASSKERNELS_SSE2)
+   for( ; i+2 <= m; i += 2)
+      _mm_storeu_pd(dx+i, _mm_sub_pd(_mm_loadu_pd(x+i+1),_mm_loadu_pd(x+i)));
+#endif
+
+   for( ; i < m; i++)
+      dx[i] = x[i+1] - x[i];
+}
+
+}  // end namespace
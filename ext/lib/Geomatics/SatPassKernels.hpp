@@ -0,0 +1,83 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+/// @file SatPassKernels.hpp
+/// Kernels on the columns of SatPass data: dual frequency linear combinations
+/// and first differences, vectorized with SSE2 or AVX when the compiler
+/// targets them.
+
+#ifndef GPSTK_SATPASS_KERNELS_INCLUDE
+#define GPSTK_SATPASS_KERNELS_INCLUDE
+
+#include <cstddef>
+
+namespace gpstk {
+
+/// Coefficients of the linear combinations computed by dualFrequencyKernel().
+/// Phases are in cycles and ranges in meters.
+struct DualFrequencyCoefficients {
+   double wl1r,wl2r;    ///< narrow lane range (m):    wl1r*P1 + wl2r*P2
+   double wl1p,wl2p;    ///< wide lane phase (m):      wl1p*L1 + wl2p*L2
+   double gf1r,gf2r;    ///< geometry-free range (m):  gf1r*P1 + gf2r*P2
+   double gf1p,gf2p;    ///< geometry-free phase (m):  gf1p*L1 + gf2p*L2
+   double wlwl;         ///< wide lane wavelength (m)
+};
+
+/// Compute, for each of the n epochs in the arrays L1, L2, P1 and P2,
+///   mw[i]   = (wide lane phase - narrow lane range)/wlwl, the Melbourne-Wubbena
+///             wide lane bias (cycles),
+///   gfp[i]  = geometry-free phase (m),
+///   gfr[i]  = geometry-free range (m),
+///   gfpr[i] = gfp[i] - gfr[i] (m).
+/// Each output may be the same array as any input, since element i of every
+/// output is written only after element i of every input is read; otherwise
+/// outputs must not overlap the inputs or each other. The arithmetic is that of
+/// the scalar expressions above, in that order, so that the results do not
+/// depend on the instruction set.
+void dualFrequencyKernel(std::size_t n,
+                         const double *L1, const double *L2,
+                         const double *P1, const double *P2,
+                         const DualFrequencyCoefficients& coef,
+                         double *mw, double *gfp, double *gfr, double *gfpr)
+   throw();
+
+/// Compute dx[i] = x[i+1] - x[i] for 0 <= i < n-1. dx may be x, but must not
+/// otherwise overlap x.
+void differenceKernel(std::size_t n, const double *x, double *dx) throw();
+
+}  // end namespace
+
+#endif
@@ -214,14 +214,26 @@ catch(Exception& e) { GPSTK_RETHROW(e); }
 }  // end RemoveMilliseconds()
 
 // -------------------------------------------------------------------------------
-// prototype is in SatPass.hpp as a friend
-int SatPassFromRinexFiles(vector<string>& filenames,
-                          vector<string>& obstypes,
-                          double dtin,
-                          vector<SatPass>& SPList,
-                          vector<RinexSatID> exSats,
-                          bool lenient,
-                          Epoch beginTime, Epoch endTime)
+// order indexes into a vector<SatPass> as the passes, cf. SatPass::operator<()
+struct SatPassIndexOrder {
+   const vector<SatPass>& SPList;
+   SatPassIndexOrder(const vector<SatPass>& spl) : SPList(spl) {}
+   bool operator()(int i, int j) const { return SPList[i] < SPList[j]; }
+};
+
+// -------------------------------------------------------------------------------
+// Read the RINEX files into the SatPass objects of SPList, as documented for
+// SatPassFromRinexFiles(). If handler is not null, SPList holds one pass for each
+// satellite seen so far; each pass is handed to the handler once it is complete,
+// and replaced with an empty one.
+static int ReadRinexObsFiles(vector<string>& filenames,
+                             vector<string>& obstypes,
+                             double dtin,
+                             vector<SatPass>& SPList,
+                             SatPassHandler *handler,
+                             vector<RinexSatID>& exSats,
+                             bool lenient,
+                             Epoch& beginTime, Epoch& endTime)
    throw(Exception)
 {
 try {
@@ -255,6 +267,8 @@ try {
    bool onOrder(false),onShort(false);
    vector<int> nOrder,nShort;
    vector<Epoch> timeOrder,timeShort;
+   // set when the handler asks to stop reading
+   bool stop(false);
 
    // sort existing list on begin time
    sort(SPList);
@@ -383,6 +397,17 @@ try {
          onOrder = onShort = false;
          prevtime = obsdata.time;
 
+         // hand over the passes that can take no more data
+         if(handler) {
+            for(satit=indexForSat.begin(); satit != indexForSat.end(); ++satit) {
+               SatPass& sp(SPList[satit->second]);
+               if(sp.size() == 0 || !sp.endsBefore(obsdata.time)) continue;
+               if(handler->handle(sp)) { stop = true; break; }
+               sp = SatPass(sp.getSat(),dtin,obstypes);
+            }
+            if(stop) break;
+         }
+
          // loop over satellites
          for(it=obsdata.obs.begin(); it != obsdata.obs.end(); ++it) {
             RinexSatID sat = it->first;
@@ -426,7 +451,13 @@ try {
             do {
                i = SPList[satit->second].addData(obsdata.time,obstypes,
                                                  data,lli,ssi,flag);
-               if(i == -1) {        // gap
+               if(i == -1 && handler) {      // gap - hand over and start again
+                  SatPass& sp(SPList[satit->second]);
+                  if(handler->handle(sp)) { stop = true; break; }
+                  sp = SatPass(sat,dtin,obstypes);
+                  // repeat
+               }
+               else if(i == -1) {   // gap
                   SatPass newSP(sat,dtin,obstypes);
                   SPList.push_back(newSP);
                   indexForSat[sat] = SPList.size()-1;
@@ -446,8 +477,10 @@ try {
                //}
 
             } while(i == -1);
+            if(stop) break;
 
          } // end loop over satellites
+         if(stop) break;
          nepochs++;
 
          if(timeShort.size() > 50 && timeShort.size() > nepochs/2) {
@@ -463,9 +496,23 @@ try {
       } // end loop over obs data in file
 
       RinFile.close();
+      if(stop) break;
 
    }  // end loop over RINEX files
 
+   // hand over the passes still open, in time order
+   if(handler && !stop) {
+      vector<int> order;
+      for(i=0; i<SPList.size(); i++)
+         if(SPList[i].size() > 0) order.push_back(i);
+      std::sort(order.begin(), order.end(), SatPassIndexOrder(SPList));
+      for(i=0; i<order.size(); i++) {
+         SatPass& sp(SPList[order[i]]);
+         if(handler->handle(sp)) break;
+         sp = SatPass(sp.getSat(),dtin,obstypes);
+      }
+   }
+
    // find the most common timestep
    for(j=0,i=1; i<estN; i++) if(estn[i] > estn[j]) j=i;
    dt = estdt[j];
@@ -499,6 +546,42 @@ try {
 catch(Exception& e) { GPSTK_RETHROW(e); }
 }
 
+// -------------------------------------------------------------------------------
+// prototype is in SatPass.hpp as a friend
+int SatPassFromRinexFiles(vector<string>& filenames,
+                          vector<string>& obstypes,
+                          double dtin,
+                          vector<SatPass>& SPList,
+                          vector<RinexSatID> exSats,
+                          bool lenient,
+                          Epoch beginTime, Epoch endTime)
+   throw(Exception)
+{
+   try {
+      return ReadRinexObsFiles(filenames, obstypes, dtin, SPList, 0,
+                               exSats, lenient, beginTime, endTime);
+   }
+   catch(Exception& e) { GPSTK_RETHROW(e); }
+}
+
+// -------------------------------------------------------------------------------
+int SatPassFromRinexFiles(vector<string>& filenames,
+                          vector<string>& obstypes,
+                          double dtin,
+                          SatPassHandler& handler,
+                          vector<RinexSatID> exSats,
+                          bool lenient,
+                          Epoch beginTime, Epoch endTime)
+   throw(Exception)
+{
+   try {
+      vector<SatPass> SPList;          // the open passes, one per satellite
+      return ReadRinexObsFiles(filenames, obstypes, dtin, SPList, &handler,
+                               exSats, lenient, beginTime, endTime);
+   }
+   catch(Exception& e) { GPSTK_RETHROW(e); }
+}
+
 // -------------------------------------------------------------------------------
 // TD no this only works if the passes all have the same OTs in the same order....
 int SatPassToRinexFile(string filename,
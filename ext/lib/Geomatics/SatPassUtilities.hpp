@@ -87,6 +87,58 @@ int SatPassFromRinexFiles(
             gpstk::Epoch beginTime=gpstk::CommonTime::BEGINNING_OF_TIME,
             gpstk::Epoch endTime=gpstk::CommonTime::END_OF_TIME) throw(Exception);
 
+// -------------------------------------------------------------------------------
+/// Interface for the receiver of the SatPass objects built by the streaming form
+/// of SatPassFromRinexFiles(). Derive from it and implement handle(), e.g. to
+/// run the discontinuity corrector on each pass and write the results.
+class SatPassHandler {
+public:
+   /// Process one complete SatPass. The pass is released after this returns,
+   /// so copy it to keep it.
+   /// @param sp        the complete pass; it may be modified.
+   /// @return 0 to continue reading, non-zero to stop reading and return.
+   virtual int handle(SatPass& sp) throw(Exception) = 0;
+
+   /// destructor
+   virtual ~SatPassHandler() {}
+};
+
+// -------------------------------------------------------------------------------
+/// Read a set of RINEX observation files, building SatPass objects as in the
+/// form above, but handing each pass to the handler as soon as it is complete
+/// and then releasing it, so that memory is bounded by the passes open at one
+/// time, rather than by the size of the files. A pass is complete when the
+/// data reach a time at which it could take no more data, because the gap would
+/// exceed the maximum (cf. SatPass::setMaxGap() and SatPass::endsBefore()), or
+/// at the end of the data. Passes completed at the same epoch are handled in
+/// satellite order, those left open at the end in time order. The passes are
+/// identical to those of the vector form with an empty list.
+/// NB. The time step is checked against dt at the end, after all the passes
+/// have been handled.
+/// @param filenames vector of input RINEX observation file names
+/// @param obstypes  vector of observation types to include in SatPass (may
+///                   be empty: include all)
+/// @param dt        data interval of the input files
+/// @param handler   SatPassHandler that receives each complete pass
+/// @param exSats    vector of satellites to exclude
+/// @param lenient   if true (default), be lenient in reading the RINEX format
+/// @param beginTime reject data before this time (BEGINNING_OF_TIME)
+/// @param endTime   reject data after this time (END_OF TIME)
+/// @return -1 if the filenames list is empty, otherwise return the number of
+///                files successfully read (may be less than the number input);
+///                reading stops early if the handler returns non-zero.
+/// @throw gpstk Exceptions if there are exceptions while reading, if the data
+///              in the file is out of time order, or thrown by the handler.
+int SatPassFromRinexFiles(
+            std::vector<std::string>& filenames,
+            std::vector<std::string>& obstypes,
+            double dt,
+            SatPassHandler& handler,
+            std::vector<RinexSatID> exSats=std::vector<RinexSatID>(),
+            bool lenient=true,
+            gpstk::Epoch beginTime=gpstk::CommonTime::BEGINNING_OF_TIME,
+            gpstk::Epoch endTime=gpstk::CommonTime::END_OF_TIME) throw(Exception);
+
 // -------------------------------------------------------------------------------
 /// Iterate over the input vector of SatPass objects (sorted to be in time
 /// order) and write them, with the given header, to a RINEX observation file
@@ -0,0 +1,635 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S.
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software.
+//
+//Pursuant to DoD Directive 523024
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+/**
+ * @file ClockDeviation.cpp
+ * Allan, modified Allan, time, Hadamard and total deviations of clock
+ * phase data, for selectable sets of averaging times.
+ */
+
+#include "ClockDeviation.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+
+namespace gpstk
+{
+
+      // Data shared by the threads computing deviations
+   struct ClockDeviationTask
+   {
+      const double* x;        // Phase data (for TOTDEV, extended both ways)
+      size_t N;               // Number of phase data
+      ClockDeviation::Deviation dev;
+      bool gaps;              // Whether zero phase values are missing data
+      double tau0;
+      const std::vector<unsigned long>* m;
+      std::vector<double>* sigma;
+      size_t first;           // First factor computed, and step to the next
+      size_t step;
+   };
+
+
+      // Overlapping Allan deviation
+   static double adev( const double* x, size_t N, unsigned long m,
+                       bool gaps, double tau )
+   {
+      const size_t terms( N - 2*m );
+      double sigma(0.0);
+      unsigned long numGaps(0);
+
+      if( gaps )
+      {
+         for( size_t i = 0; i < terms; i++ )
+         {
+            if( (x[i+2*m] == 0 || x[i+m] == 0 || x[i] == 0) &&
+                i != 0 && i != terms-1 )
+            {
+               numGaps++;
+               continue;
+            }
+            double sum( x[i+2*m] - 2*x[i+m] + x[i] );
+            sigma += sum * sum;
+         }
+      }
+      else
+      {
+         for( size_t i = 0; i < terms; i++ )
+         {
+            double sum( x[i+2*m] - 2*x[i+m] + x[i] );
+            sigma += sum * sum;
+         }
+      }
+
+      return std::sqrt( sigma / ( 2.0*(double(N) - double(numGaps)
+                                       - 2.0*double(m))*tau*tau ) );
+   }
+
+
+      // Overlapping Hadamard deviation
+   static double hdev( const double* x, size_t N, unsigned long m,
+                       bool gaps, double tau )
+   {
+      const size_t terms( N - 3*m );
+      double sigma(0.0);
+      unsigned long numGaps(0);
+
+      if( gaps )
+      {
+         for( size_t i = 0; i < terms; i++ )
+         {
+            if( (x[i+3*m] == 0 || x[i+2*m] == 0 ||
+                 x[i+m] == 0 || x[i] == 0) &&
+                i != 0 && i != terms-1 )
+            {
+               numGaps++;
+               continue;
+            }
+            double sum( x[i+3*m] - 3*x[i+2*m] + 3*x[i+m] - x[i] );
+            sigma += sum * sum;
+         }
+      }
+      else
+      {
+         for( size_t i = 0; i < terms; i++ )
+         {
+            double sum( x[i+3*m] - 3*x[i+2*m] + 3*x[i+m] - x[i] );
+            sigma += sum * sum;
+         }
+      }
+
+      return std::sqrt( sigma / ( 6.0*(double(N) - double(numGaps)
+                                       - 3.0*double(m))*tau*tau ) );
+   }
+
+
+      // Modified Allan deviation
+   static double mdev( const double* x, size_t N, unsigned long m,
+                       bool gaps, double tau )
+   {
+      const size_t blocks( N - 3*m + 1 );
+      double sigma(0.0);
+      unsigned long numGaps(0);
+
+         // Zero phase values in the window, other than at either end
+      unsigned long zeros(0);
+      if( gaps )
+      {
+         for( size_t i = 1; i < 3*m && i+1 < N; i++ )
+         {
+            zeros += ( x[i] == 0 );
+         }
+      }
+
+         // Running window sum, recomputed every m windows
+      double window(0.0);
+      unsigned long k(0);
+      for( size_t j = 0; j < blocks; j++, k++ )
+      {
+         if( k == m )
+         {
+            k = 0;
+         }
+
+         if( k == 0 )
+         {
+            window = 0.0;
+            for( size_t i = j; i < j+m; i++ )
+            {
+               window += x[i+2*m] - 2*x[i+m] + x[i];
+            }
+         }
+         else
+         {
+            const size_t i( j+m-1 );
+            double newTerm( x[i+2*m] - 2*x[i+m] + x[i] );
+            double oldTerm( x[j-1+2*m] - 2*x[j-1+m] + x[j-1] );
+            window += newTerm - oldTerm;
+         }
+
+         if( gaps )
+         {
+            if( j > 0 )
+            {
+               const size_t in( j+3*m-1 );
+               zeros -= ( x[j-1] == 0 && j-1 != 0 );
+               zeros += ( x[in] == 0 && in != N-1 );
+            }
+            if( zeros > 0 )
+            {
+               numGaps++;
+               continue;
+            }
+         }
+
+         sigma += window * window;
+      }
+
+      return std::sqrt( sigma / ( 2.0*tau*tau*double(m)*double(m)
+                                  *(double(N) - double(numGaps)
+                                    - 3.0*double(m) + 1) ) );
+   }
+
+
+      // Total deviation. 'x' holds the data extended by reflection,
+      // from index -(N-2) to 2N-3.
+   static double totdev( const double* x, size_t N, unsigned long m,
+                         double tau )
+   {
+      const long M( m );
+      double sigma(0.0);
+      for( long i = 1; i < long(N)-1; i++ )
+      {
+         double sum( x[i-M] - 2*x[i] + x[i+M] );
+         sigma += sum * sum;
+      }
+
+      return std::sqrt( sigma / ( 2.0*(double(N) - 2.0)*tau*tau ) );
+   }
+
+
+      // Compute the deviations of the factors assigned to a task
+   static void runTask( void* arg )
+   {
+      ClockDeviationTask& task( *static_cast<ClockDeviationTask*>(arg) );
+      const std::vector<unsigned long>& m( *task.m );
+
+      for( size_t k = task.first; k < m.size(); k += task.step )
+      {
+         const double tau( m[k] * task.tau0 );
+         double sigma(0.0);
+         switch( task.dev )
+         {
+            case ClockDeviation::ADEV:
+               sigma = adev( task.x, task.N, m[k], task.gaps, tau );
+               break;
+            case ClockDeviation::MDEV:
+               sigma = mdev( task.x, task.N, m[k], task.gaps, tau );
+               break;
+            case ClockDeviation::TDEV:
+               sigma = tau / std::sqrt(3.0)
+                       * mdev( task.x, task.N, m[k], task.gaps, tau );
+               break;
+            case ClockDeviation::HDEV:
+               sigma = hdev( task.x, task.N, m[k], task.gaps, tau );
+               break;
+            case ClockDeviation::TOTDEV:
+               sigma = totdev( task.x, task.N, m[k], tau );
+               break;
+         }
+         (*task.sigma)[k] = sigma;
+      }
+   }
+
+
+      /* Common constructor.
+       *
+       * @param tau0       Interval between phase data, in seconds.
+       * @param numThreads Number of threads computing averaging
+       *                   factors, counting the calling thread.
+       */
+   ClockDeviation::ClockDeviation( double tau, unsigned threads )
+      : tau0(tau), zeroGaps(false), numThreads(threads)
+   {
+   }
+
+
+      /* Largest averaging factor of a deviation for a number of
+       * phase data, or zero if there are too few of them.
+       */
+   unsigned long ClockDeviation::maxFactor( Deviation dev, size_t numPoints )
+   {
+      switch( dev )
+      {
+         case ADEV:
+            return ( numPoints < 1 ? 0 : (numPoints - 1) / 2 );
+         case MDEV:
+         case TDEV:
+            return numPoints / 3;
+         case HDEV:
+            return ( numPoints < 1 ? 0 : (numPoints - 1) / 3 );
+         case TOTDEV:
+            return ( numPoints < 3 ? 0 : numPoints - 1 );
+      }
+
+      return 0;
+   }
+
+
+      // Averaging factors of a set, up to 'maxM'.
+   std::vector<unsigned long> ClockDeviation::factors( TauSet set,
+                                                       unsigned long maxM )
+   {
+      std::vector<unsigned long> m;
+
+      if( set == AllTaus )
+      {
+         m.reserve(maxM);
+         for( unsigned long i = 1; i <= maxM; i++ )
+         {
+            m.push_back(i);
+         }
+      }
+      else if( set == OctaveTaus )
+      {
+         for( unsigned long i = 1; i <= maxM && i != 0; i *= 2 )
+         {
+            m.push_back(i);
+         }
+      }
+      else
+      {
+         const unsigned long steps[] = { 1, 2, 5 };
+         for( unsigned long p = 1; p <= maxM; p *= 10 )
+         {
+            for( int s = 0; s < 3; s++ )
+            {
+               if( steps[s] * p <= maxM )
+               {
+                  m.push_back( steps[s] * p );
+               }
+            }
+            if( p > maxM / 10 )
+            {
+               break;
+            }
+         }
+      }
+
+      return m;
+   }
+
+
+      /* Compute a deviation for a list of averaging factors.
+       *
+       * @param phase      Phase data, in seconds, tau0 apart.
+       * @param dev        Deviation to compute.
+       * @param m          Averaging factors, from 1 to maxFactor().
+       *
+       * @return The deviation for each averaging factor.
+       */
+   std::vector<double> ClockDeviation::compute(
+                                       const std::vector<double>& phase,
+                                       Deviation dev,
+                                       const std::vector<unsigned long>& m )
+      const throw(InvalidParameter)
+   {
+      const size_t N( phase.size() );
+      const unsigned long maxM( maxFactor(dev, N) );
+      for( size_t k = 0; k < m.size(); k++ )
+      {
+         if( m[k] < 1 || m[k] > maxM )
+         {
+            InvalidParameter e("Averaging factor out of range for the "
+                               "number of phase data.");
+            GPSTK_THROW(e);
+         }
+      }
+
+      std::vector<double> sigma( m.size(), 0.0 );
+      if( m.empty() )
+      {
+         return sigma;
+      }
+
+      ClockDeviationTask task;
+      task.x = &phase[0];
+      task.N = N;
+      task.dev = dev;
+      task.gaps = false;
+      task.tau0 = tau0;
+      task.m = &m;
+      task.sigma = &sigma;
+      task.first = 0;
+      task.step = 1;
+
+      if( zeroGaps && dev != TOTDEV )
+      {
+            // Zeros at either end never make a gap
+         for( size_t i = 1; i+1 < N; i++ )
+         {
+            if( phase[i] == 0 )
+            {
+               task.gaps = true;
+               break;
+            }
+         }
+      }
+
+         // Reflect the data about both ends
+      std::vector<double> extended;
+      if( dev == TOTDEV )
+      {
+         extended.resize( 3*N - 4 );
+         for( size_t i = 0; i < N; i++ )
+         {
+            extended[N-2+i] = phase[i];
+         }
+         for( size_t j = 1; j+1 < N; j++ )
+         {
+            extended[N-2-j] = 2*phase[0] - phase[j];
+            extended[2*N-3+j] = 2*phase[N-1] - phase[N-1-j];
+         }
+         task.x = &extended[N-2];
+      }
+
+      const size_t threads( std::min<size_t>( numThreads, m.size() ) );
+      if( threads <= 1 )
+      {
+         runTask(&task);
+         return sigma;
+      }
+
+         // Factor k goes to thread k modulo the number of threads
+      std::vector<ClockDeviationTask> tasks( threads, task );
+      ThreadGroup group;
+      for( size_t t = 0; t < threads; t++ )
+      {
+         tasks[t].first = t;
+         tasks[t].step = threads;
+      }
+      std::vector<bool> started( threads, false );
+      for( size_t t = 1; t < threads; t++ )
+      {
+         started[t] = group.start( runTask, &tasks[t] );
+      }
+
+      runTask(&tasks[0]);
+      for( size_t t = 1; t < threads; t++ )
+      {
+         if( !started[t] )
+         {
+            runTask(&tasks[t]);
+         }
+      }
+      group.join();
+
+      return sigma;
+   }
+
+
+      /* Compute a deviation for a set of averaging factors.
+       *
+       * @param phase      Phase data, in seconds, tau0 apart.
+       * @param dev        Deviation to compute.
+       * @param set        Set of averaging factors.
+       * @param tau        Averaging times, in seconds.
+       * @param sigma      Deviation for each averaging time.
+       */
+   void ClockDeviation::compute( const std::vector<double>& phase,
+                                 Deviation dev,
+                                 TauSet set,
+                                 std::vector<double>& tau,
+                                 std::vector<double>& sigma ) const
+      throw(InvalidParameter)
+   {
+      std::vector<unsigned long> m( factors(dev, set, phase.size()) );
+      sigma = compute(phase, dev, m);
+
+      tau.resize( m.size() );
+      for( size_t k = 0; k < m.size(); k++ )
+      {
+         tau[k] = m[k] * tau0;
+      }
+   }
+
+
+      /* Common constructor.
+       *
+       * @param m          Averaging factors, at least 1 each.
+       * @param tau0       Interval between phase data, in seconds.
+       */
+   ClockDeviationAccumulator::ClockDeviationAccumulator(
+                                       const std::vector<unsigned long>& m,
+                                       double tau )
+      throw(InvalidParameter)
+      : factors(m), tau0(tau), count(0)
+   {
+      unsigned long maxM(0);
+      for( size_t k = 0; k < factors.size(); k++ )
+      {
+         if( factors[k] < 1 )
+         {
+            InvalidParameter e("Averaging factors must be at least 1.");
+            GPSTK_THROW(e);
+         }
+         maxM = std::max( maxM, factors[k] );
+      }
+
+      history.resize( 3*maxM + 1 );
+      sums.resize( factors.size() );
+      clear();
+   }
+
+
+      // Forget all the phase data added.
+   void ClockDeviationAccumulator::clear(void)
+   {
+      count = 0;
+      for( size_t k = 0; k < sums.size(); k++ )
+      {
+         sums[k].adev = 0.0;
+         sums[k].mdev = 0.0;
+         sums[k].hdev = 0.0;
+         sums[k].window = 0.0;
+         sums[k].terms.assign( factors[k], 0.0 );
+      }
+   }
+
+
+      // Add the next phase value, in seconds.
+   void ClockDeviationAccumulator::add( double x )
+   {
+      const size_t size( history.size() );
+      const size_t n( count );
+      history[n % size] = x;
+      ++count;
+
+      for( size_t k = 0; k < factors.size(); k++ )
+      {
+         const unsigned long m( factors[k] );
+         if( n < 2*m )
+         {
+            continue;
+         }
+
+         Sums& s( sums[k] );
+         const double x1( history[(n - m) % size] );
+         const double x2( history[(n - 2*m) % size] );
+
+            // Second difference starting at i, as in ClockDeviation
+         const double sum( x - 2*x1 + x2 );
+         s.adev += sum * sum;
+
+         const size_t i( n - 2*m );
+         double& slot( s.terms[i % m] );
+         if( i < m )
+         {
+            s.window += sum;
+            slot = sum;
+         }
+         else if( (i+1) % m == 0 )
+         {
+               // Recompute the window from scratch, in the same order
+            slot = sum;
+            s.window = 0.0;
+            for( unsigned long t = 0; t < m; t++ )
+            {
+               s.window += s.terms[t];
+            }
+         }
+         else
+         {
+            s.window += sum - slot;
+            slot = sum;
+         }
+
+         if( i+1 >= m )
+         {
+            s.mdev += s.window * s.window;
+         }
+
+         if( n >= 3*m )
+         {
+            const double x3( history[(n - 3*m) % size] );
+            const double hsum( x - 3*x1 + 3*x2 - x3 );
+            s.hdev += hsum * hsum;
+         }
+      }
+   }
+
+
+      // Whether there are enough data for a deviation at the k-th
+      // averaging factor.
+   bool ClockDeviationAccumulator::ready( ClockDeviation::Deviation dev,
+                                          size_t k ) const
+   {
+      if( k >= factors.size() )
+      {
+         return false;
+      }
+
+      const unsigned long m( factors[k] );
+      switch( dev )
+      {
+         case ClockDeviation::ADEV:
+            return ( count >= 2*m + 1 );
+         case ClockDeviation::MDEV:
+         case ClockDeviation::TDEV:
+            return ( count >= 3*m );
+         case ClockDeviation::HDEV:
+            return ( count >= 3*m + 1 );
+         default:
+            return false;
+      }
+   }
+
+
+      /* Deviation at the k-th averaging factor, from the data added
+       * so far.
+       */
+   double ClockDeviationAccumulator::deviation( ClockDeviation::Deviation dev,
+                                                size_t k ) const
+      throw(InvalidRequest)
+   {
+      if( !ready(dev, k) )
+      {
+         InvalidRequest e("Not enough phase data for this deviation.");
+         GPSTK_THROW(e);
+      }
+
+      const Sums& s( sums[k] );
+      const double m( factors[k] );
+      const double tau( m * tau0 );
+      const double N( count );
+      switch( dev )
+      {
+         case ClockDeviation::ADEV:
+            return std::sqrt( s.adev / ( 2.0*(N - 2.0*m)*tau*tau ) );
+         case ClockDeviation::MDEV:
+            return std::sqrt( s.mdev / ( 2.0*tau*tau*m*m
+                                         *(N - 3.0*m + 1) ) );
+         case ClockDeviation::TDEV:
+            return tau / std::sqrt(3.0)
+                   * std::sqrt( s.mdev / ( 2.0*tau*tau*m*m
+                                           *(N - 3.0*m + 1) ) );
+         default:
+            return std::sqrt( s.hdev / ( 6.0*(N - 3.0*m)*tau*tau ) );
+      }
+   }
+
+}  // End of namespace gpstk
@@ -0,0 +1,363 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S.
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software.
+//
+//Pursuant to DoD Directive 523024
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+/**
+ * @file ClockDeviation.hpp
+ * Allan, modified Allan, time, Hadamard and total deviations of clock
+ * phase data, for selectable sets of averaging times.
+ */
+
+#ifndef GPSTK_CLOCKDEVIATION_HPP
+#define GPSTK_CLOCKDEVIATION_HPP
+
+#include <vector>
+
+#include "Exception.hpp"
+#include "ThreadUtils.hpp"
+
+
+namespace gpstk
+{
+
+      /// @ingroup math
+      //@{
+
+
+      /** This class computes frequency stability statistics of evenly
+       *  spaced clock phase data, for a set of averaging factors m
+       *  (averaging times tau = m * tau0):
+       *
+       * - ADEV: overlapping Allan deviation,
+       *   sigma^2 = Sum(x[i+2m]-2x[i+m]+x[i])^2 / (2 (N-2m) tau^2).
+       * - MDEV: modified Allan deviation,
+       *   sigma^2 = Sum_j( Sum_{i=j}^{j+m-1} (x[i+2m]-2x[i+m]+x[i]) )^2
+       *             / (2 m^2 (N-3m+1) tau^2).
+       * - TDEV: time deviation, tau * MDEV / sqrt(3).
+       * - HDEV: overlapping Hadamard deviation,
+       *   sigma^2 = Sum(x[i+3m]-3x[i+2m]+3x[i+m]-x[i])^2 / (6 (N-3m) tau^2).
+       * - TOTDEV: total deviation, the ADEV sum over the N-2 inner
+       *   points of the data extended by reflection about both ends,
+       *   divided by 2 (N-2) tau^2.
+       *
+       * Each deviation costs O(N) per averaging factor. The inner sums
+       * of MDEV are kept as running window sums, recomputed from
+       * scratch every m windows so that rounding errors do not build
+       * up along long data sets. Octave and decade sets of averaging
+       * factors hold O(log N) of them, instead of the O(N) of all
+       * factors. Different factors are computed by different threads.
+       *
+       * When setZeroGaps() is set, phase values of zero are taken as
+       * missing data, as the clocktools programs always did. ADEV and
+       * HDEV leave out of the sums, and of the number of terms, the
+       * terms using them, except for the first and last terms. MDEV
+       * and TDEV leave out the windows holding them, except at either
+       * end of the data. TOTDEV has no gaps.
+       *
+       * @code
+       *   ClockDeviation cd(1.0);
+       *   std::vector<double> tau, sigma;
+       *   cd.compute(phase, ClockDeviation::ADEV, ClockDeviation::OctaveTaus,
+       *              tau, sigma);
+       * @endcode
+       *
+       * @sa ClockDeviationAccumulator to compute them as the phase
+       *     data arrive.
+       */
+   class ClockDeviation
+   {
+   public:
+
+         /// Statistics computed
+      enum Deviation
+      {
+         ADEV,       ///< Overlapping Allan deviation
+         MDEV,       ///< Modified Allan deviation
+         TDEV,       ///< Time deviation
+         HDEV,       ///< Overlapping Hadamard deviation
+         TOTDEV      ///< Total deviation
+      };
+
+
+         /// Sets of averaging factors
+      enum TauSet
+      {
+         AllTaus,    ///< 1, 2, 3, 4, ...
+         OctaveTaus, ///< 1, 2, 4, 8, ...
+         DecadeTaus  ///< 1, 2, 5, 10, 20, 50, ...
+      };
+
+
+         /** Common constructor.
+          *
+          * @param tau0       Interval between phase data, in seconds.
+          * @param numThreads Number of threads computing averaging
+          *                   factors, counting the calling thread.
+          */
+      ClockDeviation( double tau0 = 1.0,
+                      unsigned numThreads = numProcessors() );
+
+
+         /// Set the interval between phase data, in seconds.
+      virtual ClockDeviation& setTau0( double tau )
+      { tau0 = tau; return (*this); };
+
+
+         /// Get the interval between phase data, in seconds.
+      virtual double getTau0(void) const
+      { return tau0; };
+
+
+         /// Set whether phase values of zero are taken as missing data.
+      virtual ClockDeviation& setZeroGaps( bool gaps )
+      { zeroGaps = gaps; return (*this); };
+
+
+         /// Get whether phase values of zero are taken as missing data.
+      virtual bool getZeroGaps(void) const
+      { return zeroGaps; };
+
+
+         /// Set the number of threads, counting the calling thread.
+      virtual ClockDeviation& setNumThreads( unsigned threads )
+      { numThreads = threads; return (*this); };
+
+
+         /// Get the number of threads, counting the calling thread.
+      virtual unsigned getNumThreads(void) const
+      { return numThreads; };
+
+
+         /** Largest averaging factor of a deviation for a number of
+          *  phase data, or zero if there are too few of them.
+          */
+      static unsigned long maxFactor( Deviation dev, size_t numPoints );
+
+
+         /// Averaging factors of a set, up to 'maxM'.
+      static std::vector<unsigned long> factors( TauSet set,
+                                                 unsigned long maxM );
+
+
+         /// Averaging factors of a set usable for a deviation of
+         /// 'numPoints' phase data.
+      static std::vector<unsigned long> factors( Deviation dev,
+                                                 TauSet set,
+                                                 size_t numPoints )
+      { return factors( set, maxFactor(dev, numPoints) ); };
+
+
+         /** Compute a deviation for a list of averaging factors.
+          *
+          * @param phase      Phase data, in seconds, tau0 apart.
+          * @param dev        Deviation to compute.
+          * @param m          Averaging factors, from 1 to maxFactor().
+          *
+          * @return The deviation for each averaging factor.
+          */
+      virtual std::vector<double> compute( const std::vector<double>& phase,
+                                           Deviation dev,
+                                           const std::vector<unsigned long>& m )
+         const throw(InvalidParameter);
+
+
+         /** Compute a deviation for a set of averaging factors.
+          *
+          * @param phase      Phase data, in seconds, tau0 apart.
+          * @param dev        Deviation to compute.
+          * @param set        Set of averaging factors.
+          * @param tau        Averaging times, in seconds.
+          * @param sigma      Deviation for each averaging time.
+          */
+      virtual void compute( const std::vector<double>& phase,
+                            Deviation dev,
+                            TauSet set,
+                            std::vector<double>& tau,
+                            std::vector<double>& sigma ) const
+         throw(InvalidParameter);
+
+
+         /// Destructor.
+      virtual ~ClockDeviation() {};
+
+
+   private:
+
+
+         /// Interval between phase data.
+      double tau0;
+
+
+         /// Whether phase values of zero are missing data.
+      bool zeroGaps;
+
+
+         /// Number of threads, counting the calling thread.
+      unsigned numThreads;
+
+
+   }; // End of class 'ClockDeviation'
+
+
+
+      /** This class accumulates the sums of the ADEV, MDEV, TDEV and
+       *  HDEV of ClockDeviation as phase data arrive, for a fixed list
+       *  of averaging factors. The deviations may be read at any time,
+       *  and are the same that ClockDeviation computes from all the
+       *  data added so far (without the zero gaps convention).
+       *
+       * It keeps the last 3*m+1 phase data and the last m second
+       * differences for the largest and each averaging factor m, so
+       * octave factors up to m use about 5*m doubles.
+       *
+       * @code
+       *   ClockDeviationAccumulator acc(
+       *      ClockDeviation::factors(ClockDeviation::OctaveTaus, 65536) );
+       *
+       *   while( in >> t >> x )
+       *   {
+       *      acc.add(x);
+       *   }
+       *
+       *   for( size_t k = 0; k < acc.getFactors().size(); k++ )
+       *   {
+       *      if( acc.ready(ClockDeviation::ADEV, k) )
+       *         cout << acc.getTau(k) << " "
+       *              << acc.deviation(ClockDeviation::ADEV, k) << endl;
+       *   }
+       * @endcode
+       */
+   class ClockDeviationAccumulator
+   {
+   public:
+
+         /** Common constructor.
+          *
+          * @param m          Averaging factors, at least 1 each.
+          * @param tau0       Interval between phase data, in seconds.
+          */
+      ClockDeviationAccumulator( const std::vector<unsigned long>& m,
+                                 double tau0 = 1.0 )
+         throw(InvalidParameter);
+
+
+         /// Add the next phase value, in seconds.
+      virtual void add( double x );
+
+
+         /// Add the next phase values, in seconds.
+      virtual void add( const std::vector<double>& x )
+      { for( size_t i = 0; i < x.size(); i++ ) add(x[i]); };
+
+
+         /// Forget all the phase data added.
+      virtual void clear(void);
+
+
+         /// Number of phase data added.
+      virtual size_t size(void) const
+      { return count; };
+
+
+         /// Averaging factors.
+      virtual const std::vector<unsigned long>& getFactors(void) const
+      { return factors; };
+
+
+         /// Averaging time of the k-th averaging factor, in seconds.
+      virtual double getTau( size_t k ) const
+      { return factors[k] * tau0; };
+
+
+         /// Whether there are enough data for a deviation at the k-th
+         /// averaging factor. TOTDEV is never ready.
+      virtual bool ready( ClockDeviation::Deviation dev, size_t k ) const;
+
+
+         /** Deviation at the k-th averaging factor, from the data added
+          *  so far.
+          *
+          * @throw InvalidRequest if not ready().
+          */
+      virtual double deviation( ClockDeviation::Deviation dev,
+                                size_t k ) const
+         throw(InvalidRequest);
+
+
+         /// Destructor.
+      virtual ~ClockDeviationAccumulator() {};
+
+
+   private:
+
+
+         /// Sums kept for each averaging factor.
+      struct Sums
+      {
+         double adev;                  ///< Sum of squared 2nd differences
+         double mdev;                  ///< Sum of squared window sums
+         double hdev;                  ///< Sum of squared 3rd differences
+         double window;                ///< Sum of the last m 2nd differences
+         std::vector<double> terms;    ///< Last m 2nd differences
+      };
+
+
+         /// Averaging factors.
+      std::vector<unsigned long> factors;
+
+
+         /// Interval between phase data.
+      double tau0;
+
+
+         /// Last phase data, indexed by their number modulo the size.
+      std::vector<double> history;
+
+
+         /// Number of phase data added.
+      size_t count;
+
+
+         /// Sums for each averaging factor.
+      std::vector<Sums> sums;
+
+
+   }; // End of class 'ClockDeviationAccumulator'
+
+      //@}
+
+}  // End of namespace gpstk
+
+#endif   // GPSTK_CLOCKDEVIATION_HPP
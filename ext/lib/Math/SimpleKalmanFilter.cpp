@@ -400,6 +400,117 @@ namespace gpstk
 
 
 
+      // Compute the a posteriori estimate of the system state, as well as
+      // the a posteriori estimate error covariance matrix, for uncorrelated
+      // measurements given by their weights.
+      //
+      // @param phiMatrix         State transition matrix.
+      // @param processNoiseCovariance    Process noise covariance matrix.
+      // @param measurements      Measurements vector.
+      // @param measurementsMatrix    Measurements matrix. Called geometry
+      //                              matrix in GNSS.
+      // @param measurementsWeights   Vector of measurements weights.
+      //
+      // @return
+      //  0 if OK
+      //  -1 if problems arose
+      //
+   int SimpleKalmanFilter::ComputeWeighted( const Matrix<double>& phiMatrix,
+                                 const Matrix<double>& processNoiseCovariance,
+                                          const Vector<double>& measurements,
+                                    const Matrix<double>& measurementsMatrix,
+                                    const Vector<double>& measurementsWeights )
+      throw(InvalidSolver)
+   {
+
+      try
+      {
+         Predict( phiMatrix,
+                  xhat,
+                  processNoiseCovariance );
+
+         CorrectWeighted( measurements,
+                          measurementsMatrix,
+                          measurementsWeights );
+      }
+      catch(InvalidSolver e)
+      {
+         GPSTK_THROW(e);
+         return -1;
+      }
+
+      return 0;
+
+   }  // End of method 'SimpleKalmanFilter::ComputeWeighted()'
+
+
+
+      // Compute the a posteriori estimate of the system state, as well
+      // as the a posteriori estimate error covariance matrix, for
+      // measurements given by their matrix of weights.
+      //
+      // @param phiMatrix         State transition matrix.
+      // @param processNoiseCovariance    Process noise covariance matrix.
+      // @param measurements      Measurements vector.
+      // @param measurementsMatrix    Measurements matrix. Called geometry
+      //                              matrix in GNSS.
+      // @param measurementsWeights   Matrix of measurements weights.
+      //
+      // @return
+      //  0 if OK
+      //  -1 if problems arose
+      //
+   int SimpleKalmanFilter::ComputeWeighted( const Matrix<double>& phiMatrix,
+                                 const Matrix<double>& processNoiseCovariance,
+                                          const Vector<double>& measurements,
+                                    const Matrix<double>& measurementsMatrix,
+                                    const Matrix<double>& measurementsWeights )
+      throw(InvalidSolver)
+   {
+
+         // Uncorrelated measurements give a diagonal matrix of weights, and
+         // the normal equations may then be built directly from them
+      if (measurementsWeights.isDiagonal())
+      {
+         const size_t wRow(measurementsWeights.rows());
+         Vector<double> weightVector(wRow);
+         for (size_t i=0; i<wRow; i++)
+         {
+            weightVector(i) = measurementsWeights(i,i);
+         }
+
+         return ComputeWeighted( phiMatrix,
+                                 processNoiseCovariance,
+                                 measurements,
+                                 measurementsMatrix,
+                                 weightVector );
+      }
+
+         // Otherwise, let's invert the matrix of weights in order to get
+         // the measurements noise covariance matrix
+      Matrix<double> measNoiseMatrix;
+
+      try
+      {
+         measNoiseMatrix = inverseChol(measurementsWeights);
+      }
+      catch(...)
+      {
+         InvalidSolver e("Correct(): Unable to compute measurements noise \
+covariance matrix.");
+         GPSTK_THROW(e);
+      }
+
+      return Compute( phiMatrix,
+                      processNoiseCovariance,
+                      measurements,
+                      measurementsMatrix,
+                      measNoiseMatrix );
+
+   }  // End of method 'SimpleKalmanFilter::ComputeWeighted()'
+
+
+
       // Predicts (or "time updates") the a priori estimate of the system
       // state, as well as the a priori estimate error covariance matrix.
       //
@@ -474,10 +585,11 @@ process noise covariance matrix do not match.");
             // Compute the a priori state vector
          xhatminus = phiMatrix*xhat + controlMatrix * controlInput;
 
-         Matrix<double> phiT(transpose(phiMatrix));
-
-            // Compute the a priori estimate error covariance matrix
-         Pminus = phiMatrix*P*phiT + processNoiseCovariance;
+            // Compute the a priori estimate error covariance matrix,
+            // phi*P*transpose(phi) + Q, without temporaries
+         multiplyInto(work, phiMatrix, P);
+         multiplyTransposeInto(Pminus, work, phiMatrix);
+         Pminus += processNoiseCovariance;
       }
       catch(...)
       {
@@ -557,7 +669,6 @@ matrix and a priori state estimation vector do not match.");
          // After checking sizes, let's do the real correction work
       Matrix<double> invR;
       Matrix<double> invPMinus;
-      Matrix<double> measMatrixT( transpose(measurementsMatrix) );
 
       try
       {
@@ -588,8 +699,9 @@ matrix and a priori state estimation vector do not match.");
       try
       {
 
-         Matrix<double> invTemp( measMatrixT*invR*measurementsMatrix +
-                                 invPMinus );
+         Matrix<double> invTemp;
+         normalInto(invTemp, measurementsMatrix, invR, work);
+         invTemp += invPMinus;
 
             // Compute the a posteriori error covariance matrix
          P = inverseChol( invTemp );
@@ -606,8 +718,13 @@ matrix and a priori state estimation vector do not match.");
       {
 
             // Compute the a posteriori state estimation
-         xhat = P * ( (measMatrixT * invR * measurements) + 
-                      (invPMinus * xhatminus) );
+            // as P * ( transpose(H)*invR*z + invPMinus*xhatminus )
+         Vector<double> v, w;
+         multiplyInto(v, invR, measurements);
+         transposeMultiplyInto(w, measurementsMatrix, v);
+         multiplyInto(v, invPMinus, xhatminus);
+         w += v;
+         multiplyInto(xhat, P, w);
 
       }
       catch(Exception e)
@@ -626,6 +743,140 @@ matrix and a priori state estimation vector do not match.");
 
 
 
+      // Corrects (or "measurement updates") the a posteriori estimate of
+      // the system state vector, as well as the a posteriori estimate error
+      // covariance matrix, for uncorrelated measurements given by their
+      // weights.
+      //
+      // @param measurements      Measurements vector.
+      // @param measurementsMatrix    Measurements matrix. Called geometry
+      //                              matrix in GNSS.
+      // @param measurementsWeights   Vector of measurements weights.
+      //
+      // @return
+      //  0 if OK
+      //  -1 if problems arose
+      //
+   int SimpleKalmanFilter::CorrectWeighted( const Vector<double>& measurements,
+                                    const Matrix<double>& measurementsMatrix,
+                                    const Vector<double>& measurementsWeights )
+      throw(InvalidSolver)
+   {
+         // Let's check sizes before start
+      size_t measRow(measurements.size());
+      size_t aprioriStateRow(xhatminus.size());
+
+      size_t mMRow(measurementsMatrix.rows());
+      size_t weightsRow(measurementsWeights.size());
+
+      size_t pMCol(Pminus.cols());
+      size_t pMRow(Pminus.rows());
+
+      if ( pMCol != pMRow )
+      {
+         InvalidSolver e("Correct(): Pminus matrix is not square, and \
+therefore not invertible.");
+         GPSTK_THROW(e);
+      }
+
+      if ( mMRow != weightsRow )
+      {
+         InvalidSolver e("Correct(): Sizes of measurements matrix and \
+measurements weights vector do not match.");
+         GPSTK_THROW(e);
+      }
+
+      if ( weightsRow != measRow )
+      {
+         InvalidSolver e("Correct(): Sizes of measurements weights vector \
+and measurements vector do not match.");
+         GPSTK_THROW(e);
+      }
+
+      if ( pMCol != aprioriStateRow )
+      {
+         InvalidSolver e("Correct(): Sizes of a priori error covariance \
+matrix and a priori state estimation vector do not match.");
+         GPSTK_THROW(e);
+      }
+
+         // A diagonal covariance matrix is positive definite if, and only
+         // if, all its elements are positive
+      for (size_t i = 0; i < weightsRow; i++)
+      {
+         if ( !(measurementsWeights(i) > 0.0) )
+         {
+            InvalidSolver e("Correct(): Measurements weights must be \
+positive.");
+            GPSTK_THROW(e);
+         }
+      }
+
+         // After checking sizes, let's do the real correction work
+      Matrix<double> invPMinus;
+
+      try
+      {
+
+         invPMinus = inverseChol(Pminus);
+
+      }
+      catch(...)
+      {
+         InvalidSolver e("Correct(): Unable to compute invPMinus matrix.");
+         GPSTK_THROW(e);
+         return -1;
+      }
+
+      try
+      {
+
+            // transpose(H)*W*H + invPMinus, with W diagonal
+         Matrix<double> invTemp;
+         normalInto(invTemp, measurementsMatrix, measurementsWeights);
+         invTemp += invPMinus;
+
+            // Compute the a posteriori error covariance matrix
+         P = inverseChol( invTemp );
+
+      }
+      catch(...)
+      {
+         InvalidSolver e("Correct(): Unable to compute P matrix.");
+         GPSTK_THROW(e);
+         return -1;
+      }
+
+      try
+      {
+
+            // Compute the a posteriori state estimation
+            // as P * ( transpose(H)*W*z + invPMinus*xhatminus )
+         Vector<double> v(measRow), w;
+         for (size_t i = 0; i < measRow; i++)
+            v(i) = measurementsWeights(i) * measurements(i);
+         transposeMultiplyInto(w, measurementsMatrix, v);
+         multiplyInto(v, invPMinus, xhatminus);
+         w += v;
+         multiplyInto(xhat, P, w);
+
+      }
+      catch(Exception e)
+      {
+         InvalidSolver eis("Correct(): Unable to compute xhat.");
+         GPSTK_THROW(eis);
+         return -1;
+      }
+
+      xhatminus = xhat;
+      Pminus = P;
+
+      return 0;
+
+   }  // End of method 'SimpleKalmanFilter::CorrectWeighted()'
+
+
+
       /* Corrects (or "measurement updates") the a posteriori estimate
        * of the system state value, as well as the a posteriori estimate
        * error variance, using as input the predicted a priori state and
@@ -285,6 +285,61 @@ namespace gpstk
          throw(InvalidSolver);
 
 
+         /** Compute the a posteriori estimate of the system state, as well
+          *  as the a posteriori estimate error covariance matrix, for
+          *  uncorrelated measurements given by their weights (the inverse
+          *  of their noise variances). This avoids the inversions of the
+          *  full measurements noise covariance matrix, and is the same as
+          *  calling Compute() with a diagonal covariance matrix whose
+          *  elements are 1/measurementsWeights(i).
+          *
+          * @param phiMatrix         State transition matrix.
+          * @param processNoiseCovariance    Process noise covariance matrix.
+          * @param measurements      Measurements vector.
+          * @param measurementsMatrix    Measurements matrix. Called geometry
+          *                              matrix in GNSS.
+          * @param measurementsWeights   Vector of measurements weights.
+          *
+          * @return
+          *  0 if OK
+          *  -1 if problems arose
+          */
+      virtual int ComputeWeighted( const Matrix<double>& phiMatrix,
+                                const Matrix<double>& processNoiseCovariance,
+                                   const Vector<double>& measurements,
+                                   const Matrix<double>& measurementsMatrix,
+                                   const Vector<double>& measurementsWeights )
+         throw(InvalidSolver);
+
+
+         /** Compute the a posteriori estimate of the system state, as well
+          *  as the a posteriori estimate error covariance matrix, for
+          *  measurements given by their matrix of weights (the inverse of
+          *  their noise covariance matrix). Uncorrelated measurements, the
+          *  usual case with weights from ComputeIURAWeights or
+          *  ComputeMOPSWeights, give a diagonal matrix, which is handled
+          *  as the vector of its diagonal without inverting any matrix;
+          *  otherwise the matrix is inverted and Compute() is called.
+          *
+          * @param phiMatrix         State transition matrix.
+          * @param processNoiseCovariance    Process noise covariance matrix.
+          * @param measurements      Measurements vector.
+          * @param measurementsMatrix    Measurements matrix. Called geometry
+          *                              matrix in GNSS.
+          * @param measurementsWeights   Matrix of measurements weights.
+          *
+          * @return
+          *  0 if OK
+          *  -1 if problems arose
+          */
+      virtual int ComputeWeighted( const Matrix<double>& phiMatrix,
+                                const Matrix<double>& processNoiseCovariance,
+                                   const Vector<double>& measurements,
+                                   const Matrix<double>& measurementsMatrix,
+                                   const Matrix<double>& measurementsWeights )
+         throw(InvalidSolver);
+
+
          /** Predicts (or "time updates") the a priori estimate of the
           *  system state, as well as the a priori estimate error
           *  covariance matrix.
@@ -518,6 +573,34 @@ namespace gpstk
          throw(InvalidSolver);
 
 
+         /** Corrects (or "measurement updates") the a posteriori estimate
+          *  of the system state vector, as well as the a posteriori estimate
+          *  error covariance matrix, for uncorrelated measurements given by
+          *  their weights. The normal equations are built directly from the
+          *  weights, in O(n*m^2) for n measurements and m states, instead
+          *  of inverting an n by n covariance matrix.
+          *
+          * @param measurements      Measurements vector.
+          * @param measurementsMatrix    Measurements matrix. Called geometry
+          *                              matrix in GNSS.
+          * @param measurementsWeights   Vector of measurements weights,
+          *                              all of which must be positive.
+          *
+          * @return
+          *  0 if OK
+          *  -1 if problems arose
+          */
+      virtual int CorrectWeighted( const Vector<double>& measurements,
+                                   const Matrix<double>& measurementsMatrix,
+                                   const Vector<double>& measurementsWeights )
+         throw(InvalidSolver);
+
+
+         /// Scratch matrix for the products in Predict() and Correct(),
+         /// kept so that its storage is reused from epoch to epoch.
+      Matrix<double> work;
+
+
    }; // End of class 'SimpleKalmanFilter'
 
       //@}
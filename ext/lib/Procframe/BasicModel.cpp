@@ -271,6 +271,144 @@ namespace gpstk
 
 
 
+      /* Returns a satTypeValueTable object, adding the new data generated
+       * when calling a modeling object.
+       *
+       * @param time      Epoch.
+       * @param gData     Data object holding the data.
+       */
+   satTypeValueTable& BasicModel::Process( const CommonTime& time,
+                                           satTypeValueTable& gData )
+      throw(ProcessingException)
+   {
+
+      try
+      {
+
+         SatIDSet satRejectedSet;
+
+            // Types added to every satellite, in the order of 'values'
+         static const TypeID::ValueType newTypes[] =
+            { TypeID::dtSat, TypeID::dx, TypeID::dy, TypeID::dz,
+              TypeID::dSatX, TypeID::dSatY, TypeID::dSatZ, TypeID::cdt,
+              TypeID::rho, TypeID::rel, TypeID::elevation, TypeID::azimuth,
+              TypeID::satX, TypeID::satY, TypeID::satZ,
+              TypeID::satVX, TypeID::satVY, TypeID::satVZ,
+              TypeID::recX, TypeID::recY, TypeID::recZ,
+              TypeID::recVX, TypeID::recVY, TypeID::recVZ,
+              TypeID::instC1 };
+         const size_t numNew( sizeof(newTypes) / sizeof(newTypes[0]) );
+
+         const int obsCol( gData.typeIndex(defaultObservable) );
+         const int c1Col( gData.typeIndex(TypeID::C1) );
+
+         size_t newCols[numNew];
+         for( size_t i = 0; i < numNew; ++i )
+         {
+            newCols[i] = gData.insertType( newTypes[i] );
+         }
+
+            // Loop through all the satellites
+         for( size_t row = 0; row < gData.numSats(); ++row )
+         {
+
+            const SatID& sat( gData.getSat(row) );
+
+               // The observable is required, as with satTypeValueMap
+            if( obsCol < 0 || !gData.hasValue(row, obsCol) )
+            {
+               GPSTK_THROW(TypeIDNotFound("TypeID not found in table"));
+            }
+
+               // A lot of the work is done by a CorrectedEphemerisRange object
+            CorrectedEphemerisRange cerange;
+
+            try
+            {
+                  // Compute most of the parameters
+               cerange.ComputeAtTransmitTime( time,
+                                              gData.get(row, obsCol),
+                                              rxPos,
+                                              sat,
+                                              *(getDefaultEphemeris()) );
+            }
+            catch(InvalidRequest& e)
+            {
+
+                  // If some problem appears, then schedule this satellite
+                  // for removal
+               satRejectedSet.insert( sat );
+
+               continue;    // Skip this SV if problems arise
+
+            }
+
+               // Let's test if satellite has enough elevation over horizon
+            if ( rxPos.elevationGeodetic(cerange.svPosVel) < minElev )
+            {
+
+                  // Mark this satellite if it doesn't have enough elevation
+               satRejectedSet.insert( sat );
+
+               continue;
+
+            }
+
+               // Computing Total Group Delay (TGD - meters), if possible
+            double tempTGD(getTGDCorrections( time,
+                                              (*pDefaultEphemeris),
+                                              sat ) );
+
+            const double values[numNew] =
+               { cerange.svclkbias,
+                 cerange.cosines[0], cerange.cosines[1], cerange.cosines[2],
+                 -cerange.cosines[0], -cerange.cosines[1],
+                 -cerange.cosines[2],
+                 1.0,
+                 cerange.rawrange, -cerange.relativity,
+                 cerange.elevationGeodetic, cerange.azimuthGeodetic,
+                 cerange.svPosVel.x[0], cerange.svPosVel.x[1],
+                 cerange.svPosVel.x[2],
+                 cerange.svPosVel.v[0], cerange.svPosVel.v[1],
+                 cerange.svPosVel.v[2],
+                 rxPos.X(), rxPos.Y(), rxPos.Z(),
+                 0.0, 0.0, 0.0,
+                 tempTGD };
+
+               // Now we have to add the new values to the data structure
+            for( size_t i = 0; i < numNew; ++i )
+            {
+               gData.set( row, newCols[i], values[i] );
+            }
+
+               // Apply correction to C1 observable, if appropriate
+            if( useTGD && c1Col >= 0 && gData.hasValue(row, c1Col) )
+            {
+               gData.set( row, c1Col, gData.get(row, c1Col) - tempTGD );
+            }
+
+         } // End of loop for(row = 0; ...
+
+            // Remove satellites with missing data
+         gData.removeSatID(satRejectedSet);
+
+         return gData;
+
+      }   // End of try...
+      catch(Exception& u)
+      {
+            // Throw an exception if something unexpected happens
+         ProcessingException e( getClassName() + ":"
+                                + u.what() );
+
+         GPSTK_THROW(e);
+
+      }
+
+   }  // End of method 'BasicModel::Process()'
+
+
+
       /* Method to set the initial (a priori) position of receiver.
        * @return
        *  0 if OK
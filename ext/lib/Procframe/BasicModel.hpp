@@ -201,6 +201,32 @@ namespace gpstk
       { Process(gData.header.epoch, gData.body); return gData; };
 
 
+         /** Returns a satTypeValueTable object, adding the new data
+          *  generated when calling a modeling object.
+          *
+          * @param time      Epoch.
+          * @param gData     Data object holding the data.
+          */
+      virtual satTypeValueTable& Process( const CommonTime& time,
+                                          satTypeValueTable& gData )
+         throw(ProcessingException);
+
+
+         /** Returns a gnnsRinexTable object, adding the new data generated
+          *  when calling a modeling object.
+          *
+          * @param gData    Data object holding the data.
+          */
+      virtual gnssRinexTable& Process(gnssRinexTable& gData)
+         throw(ProcessingException)
+      { Process(gData.header.epoch, gData.body); return gData; };
+
+
+         /// This class works on tables directly.
+      virtual bool isTableNative() const
+      { return true; };
+
+
          /// Method to get satellite elevation cut-off angle. By default, it
          /// is set to 10 degrees.
       virtual double getMinElev() const
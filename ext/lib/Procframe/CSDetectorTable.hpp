@@ -0,0 +1,188 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S.
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software.
+//
+//Pursuant to DoD Directive 523024
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+
+/**
+ * @file CSDetectorTable.hpp
+ * Table loop shared by the two-frequency cycle slip detectors.
+ */
+
+#ifndef GPSTK_CSDETECTORTABLE_HPP
+#define GPSTK_CSDETECTORTABLE_HPP
+
+#include "SatTypeValueTable.hpp"
+
+
+namespace gpstk
+{
+
+      /// @ingroup GPSsolutions
+      //@{
+
+
+      /** Run a cycle slip detector over a satTypeValueTable.
+       *
+       * This is the body of 'Process(const CommonTime&, satTypeValueTable&,
+       * const short&)' of LICSDetector, LICSDetector2 and MWCSDetector.
+       * For each satellite it reads the observable and the LLI indexes,
+       * calls the detector's 'getDetection()', and adds its result to the
+       * cycle slip flags, which are capped at 1. Satellites without the
+       * observable are removed.
+       *
+       * 'getDetection()' gets a typeValueMap holding only the LLI indexes
+       * of the satellite; it is reused from one satellite to the next.
+       *
+       * @param detector      Cycle slip detector.
+       * @param getDetection  Its detection method.
+       * @param epoch         Time of observations.
+       * @param gData         Data object holding the data.
+       * @param epochflag     Epoch flag.
+       * @param obsType       Observable used for detection.
+       * @param lliType1      LLI index of the first frequency.
+       * @param lliType2      LLI index of the second frequency.
+       * @param resultType1   Cycle slip flag of the first frequency.
+       * @param resultType2   Cycle slip flag of the second frequency.
+       * @param useLLI        Whether LLI indexes are used.
+       */
+   template <class Detector>
+   satTypeValueTable& detectCSTable( Detector& detector,
+                                     double (Detector::*getDetection)(
+                                                      const CommonTime&,
+                                                      const SatID&,
+                                                      typeValueMap&,
+                                                      const short&,
+                                                      const double&,
+                                                      const double&,
+                                                      const double& ),
+                                     const CommonTime& epoch,
+                                     satTypeValueTable& gData,
+                                     const short& epochflag,
+                                     const TypeID& obsType,
+                                     const TypeID& lliType1,
+                                     const TypeID& lliType2,
+                                     const TypeID& resultType1,
+                                     const TypeID& resultType2,
+                                     bool useLLI )
+   {
+
+      double lli1(0.0);
+      double lli2(0.0);
+
+      SatIDSet satRejectedSet;
+
+      const int obsCol( gData.typeIndex(obsType) );
+      const int lliCol1( gData.typeIndex(lliType1) );
+      const int lliCol2( gData.typeIndex(lliType2) );
+      const size_t resultCol1( gData.insertType(resultType1) );
+      const size_t resultCol2( gData.insertType(resultType2) );
+
+      typeValueMap tvMap;
+
+         // Loop through all the satellites
+      for( size_t row = 0; row < gData.numSats(); ++row )
+      {
+
+         if( obsCol < 0 || !gData.hasValue(row, obsCol) )
+         {
+               // If some value is missing, then schedule this satellite
+               // for removal
+            satRejectedSet.insert( gData.getSat(row) );
+            continue;
+         }
+
+         const bool hasLLI1( lliCol1 >= 0 && gData.hasValue(row, lliCol1) );
+         const bool hasLLI2( lliCol2 >= 0 && gData.hasValue(row, lliCol2) );
+
+         if (useLLI)
+         {
+               // If a LLI index is not found, set it to zero
+               // You REALLY want to have BOTH LLI indexes properly set
+            lli1 = hasLLI1 ? gData.get(row, lliCol1) : 0.0;
+            lli2 = hasLLI2 ? gData.get(row, lliCol2) : 0.0;
+         }
+
+         if (hasLLI1)
+         {
+            tvMap[lliType1] = gData.get(row, lliCol1);
+         }
+         else
+         {
+            tvMap.erase(lliType1);
+         }
+
+         if (hasLLI2)
+         {
+            tvMap[lliType2] = gData.get(row, lliCol2);
+         }
+         else
+         {
+            tvMap.erase(lliType2);
+         }
+
+            // This way of computing the flag allows concatenation of
+            // several different cycle slip detectors
+         double flag( gData.get(row, resultCol1)
+                      + (detector.*getDetection)( epoch,
+                                                  gData.getSat(row),
+                                                  tvMap,
+                                                  epochflag,
+                                                  gData.get(row, obsCol),
+                                                  lli1,
+                                                  lli2 ) );
+
+         if ( flag > 1.0 )
+         {
+            flag = 1.0;
+         }
+
+            // We will mark both cycle slip flags
+         gData.set(row, resultCol1, flag);
+         gData.set(row, resultCol2, flag);
+
+      }
+
+         // Remove satellites with missing data
+      gData.removeSatID(satRejectedSet);
+
+      return gData;
+
+   }  // End of function 'detectCSTable()'
+
+      //@}
+
+}  // End of namespace gpstk
+
+#endif   // GPSTK_CSDETECTORTABLE_HPP
@@ -263,31 +263,14 @@ of qMatrix");
          GPSTK_THROW(e);
       }
 
-         // After checking sizes, let's invert the matrix of weights in order
-         // to get the measurements noise covariance matrix, which is what we
-         // use in the "SimpleKalmanFilter" class
-      Matrix<double> measNoiseMatrix;
-
-      try
-      {
-         measNoiseMatrix = inverseChol(weightMatrix);
-      }
-      catch(...)
-      {
-         InvalidSolver e("Correct(): Unable to compute measurements noise \
-covariance matrix.");
-
-         GPSTK_THROW(e);
-      }
-
+         // Call the Kalman filter object.
       try
       {
-            // Call the Kalman filter object.
-         kFilter.Compute( phiMatrix,
-                          qMatrix,
-                          prefitResiduals,
-                          designMatrix,
-                          measNoiseMatrix );
+         kFilter.ComputeWeighted( phiMatrix,
+                                  qMatrix,
+                                  prefitResiduals,
+                                  designMatrix,
+                                  weightMatrix );
       }
       catch(InvalidSolver& e)
       {
@@ -113,4 +113,63 @@ namespace gpstk
    }  // End of method 'ComputeCombination::Process()'
 
 
+
+      /* Returns a satTypeValueTable object, adding the new data generated
+       * when calling this object.
+       *
+       * @param gData     Data object holding the data.
+       */
+   satTypeValueTable& ComputeCombination::Process(satTypeValueTable& gData)
+      throw(ProcessingException)
+   {
+
+      try
+      {
+
+         SatIDSet satRejectedSet;
+
+         const int col1( gData.typeIndex(type1) );
+         const int col2( gData.typeIndex(type2) );
+         const size_t resultCol( gData.insertType(resultType) );
+
+            // Loop through all the satellites
+         for( size_t row = 0; row < gData.numSats(); ++row )
+         {
+
+               // If some value is missing, schedule this satellite
+               // for removal
+            if( col1 < 0 || !gData.hasValue(row, col1) ||
+                col2 < 0 || !gData.hasValue(row, col2) )
+            {
+               satRejectedSet.insert( gData.getSat(row) );
+               continue;
+            }
+
+               // If everything is OK, then get the new value inside
+               // the structure
+            gData.set( row, resultCol,
+                       getCombination( gData.get(row, col1),
+                                       gData.get(row, col2) ) );
+
+         }
+
+            // Remove satellites with missing data
+         gData.removeSatID(satRejectedSet);
+
+         return gData;
+
+      }
+      catch(Exception& u)
+      {
+            // Throw an exception if something unexpected happens
+         ProcessingException e( getClassName() + ":"
+                                + u.what() );
+
+         GPSTK_THROW(e);
+
+      }
+
+   }  // End of method 'ComputeCombination::Process()'
+
+
 } // End of namespace gpstk
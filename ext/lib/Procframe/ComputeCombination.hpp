@@ -98,6 +98,30 @@ namespace gpstk
       { Process(gData.body); return gData; };
 
 
+         /** Returns a satTypeValueTable object, adding the new data
+          *  generated when calling this object.
+          *
+          * @param gData     Data object holding the data.
+          */
+      virtual satTypeValueTable& Process(satTypeValueTable& gData)
+         throw(ProcessingException);
+
+
+         /** Returns a gnnsRinexTable object, adding the new data generated
+          *  when calling this object.
+          *
+          * @param gData    Data object holding the data.
+          */
+      virtual gnssRinexTable& Process(gnssRinexTable& gData)
+         throw(ProcessingException)
+      { Process(gData.body); return gData; };
+
+
+         /// This class works on tables directly.
+      virtual bool isTableNative() const
+      { return true; };
+
+
          /// Returns a string identifying this object.
       virtual std::string getClassName(void) const;
 
@@ -121,4 +121,78 @@ namespace gpstk
    }  // End of method 'ComputeLinear::Process()'
 
 
+
+      /* Returns a satTypeValueTable object, adding the new data
+       * generated when calling this object.
+       *
+       * @param time      Epoch corresponding to the data.
+       * @param gData     Data object holding the data.
+       */
+   satTypeValueTable& ComputeLinear::Process( const CommonTime& time,
+                                              satTypeValueTable& gData )
+      throw(ProcessingException)
+   {
+
+      try
+      {
+
+         std::vector<int> columns;
+         std::vector<double> coefficients;
+
+            // Loop through all the defined linear combinations. Each one
+            // is computed for all the satellites at once, so that later
+            // combinations may use the results of previous ones
+         LinearCombList::const_iterator pos;
+         for( pos = linearList.begin(); pos != linearList.end(); ++pos )
+         {
+
+               // Columns of the types in this linear combination. Missing
+               // types are taken as zero
+            columns.clear();
+            coefficients.clear();
+            typeValueMap::const_iterator iter;
+            for(iter = pos->body.begin(); iter != pos->body.end(); ++iter)
+            {
+               const int col( gData.typeIndex(iter->first) );
+               if( col >= 0 )
+               {
+                  columns.push_back(col);
+                  coefficients.push_back(iter->second);
+               }
+            }
+
+            const size_t resultCol( gData.insertType(pos->header) );
+
+            for( size_t row = 0; row < gData.numSats(); ++row )
+            {
+               double result(0.0);
+
+               for( size_t i = 0; i < columns.size(); ++i )
+               {
+                  result = result + coefficients[i]
+                                    * gData.get(row, columns[i]);
+               }
+
+                  // Store the result in the proper place
+               gData.set(row, resultCol, result);
+            }
+
+         }
+
+         return gData;
+
+      }
+      catch(Exception& u)
+      {
+            // Throw an exception if something unexpected happens
+         ProcessingException e( getClassName() + ":"
+                                + u.what() );
+
+         GPSTK_THROW(e);
+
+      }
+
+   }  // End of method 'ComputeLinear::Process()'
+
+
 } // End of namespace gpstk
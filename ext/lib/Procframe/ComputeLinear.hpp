@@ -176,6 +176,17 @@ namespace gpstk
          throw(ProcessingException);
 
 
+         /** Returns a satTypeValueTable object, adding the new data
+          *  generated when calling this object.
+          *
+          * @param time      Epoch corresponding to the data.
+          * @param gData     Data object holding the data.
+          */
+      virtual satTypeValueTable& Process( const CommonTime& time,
+                                          satTypeValueTable& gData )
+         throw(ProcessingException);
+
+
          /** Returns a gnnsSatTypeValue object, adding the new data 
           *  generated when calling this object.
           *
@@ -196,6 +207,21 @@ namespace gpstk
       { Process(gData.header.epoch, gData.body); return gData; };
 
 
+         /** Returns a gnnsRinexTable object, adding the new data generated
+          *  when calling this object.
+          *
+          * @param gData    Data object holding the data.
+          */
+      virtual gnssRinexTable& Process(gnssRinexTable& gData)
+         throw(ProcessingException)
+      { Process(gData.header.epoch, gData.body); return gData; };
+
+
+         /// This class works on tables directly.
+      virtual bool isTableNative() const
+      { return true; };
+
+
          /// Returns the list of linear combinations to be computed.
       virtual LinearCombList getLinearCombinations(void) const
       { return linearList; };
@@ -155,4 +155,107 @@ namespace gpstk
    } // End ComputeTropModel::Process()
 
 
+
+      /* Returns a satTypeValueTable object, adding the new data generated
+       * when calling a modeling object.
+       *
+       * @param time      Epoch.
+       * @param gData     Data object holding the data.
+       */
+   satTypeValueTable& ComputeTropModel::Process( const CommonTime& time,
+                                                 satTypeValueTable& gData )
+      throw(ProcessingException)
+   {
+
+      try
+      {
+
+            // If TropModel is missing, then remove all satellites
+         if(pTropModel==NULL)
+         {
+            gData.removeSatID( gData.getSatID() );
+            return gData;
+         }
+
+         SatIDSet satRejectedSet;
+
+         const int elevCol( gData.typeIndex(TypeID::elevation) );
+         const size_t slantCol( gData.insertType(TypeID::tropoSlant) );
+         const size_t dryCol( gData.insertType(TypeID::dryTropo) );
+         const size_t wetCol( gData.insertType(TypeID::wetTropo) );
+         const size_t dryMapCol( gData.insertType(TypeID::dryMap) );
+         const size_t wetMapCol( gData.insertType(TypeID::wetMap) );
+
+            // Loop through all the satellites
+         for( size_t row = 0; row < gData.numSats(); ++row )
+         {
+
+               // If satellite elevation is missing, remove satellite
+            if( elevCol < 0 || !gData.hasValue(row, elevCol) )
+            {
+               satRejectedSet.insert( gData.getSat(row) );
+               continue;
+            }
+
+               // Scalar to hold satellite elevation
+            double elevation( gData.get(row, elevCol) );
+            double tropoCorr(0.0), dryZDelay(0.0), wetZDelay(0.0);
+            double dryMap(0.0), wetMap(0.0);
+
+            try
+            {
+                  // Compute tropospheric slant correction
+               tropoCorr = pTropModel->correction(elevation);
+               dryZDelay = pTropModel->dry_zenith_delay();
+               wetZDelay = pTropModel->wet_zenith_delay();
+               dryMap = pTropModel->dry_mapping_function(elevation);
+               wetMap = pTropModel->wet_mapping_function(elevation);
+
+                  // Check validity
+               if( !(pTropModel->isValid()) )
+               {
+                  tropoCorr = 0.0;
+                  dryZDelay = 0.0;
+                  wetZDelay = 0.0;
+                  dryMap    = 0.0;
+                  wetMap    = 0.0;
+               }
+
+            }
+            catch(InvalidTropModel& e)
+            {
+                  // If some problem appears, then schedule this
+                  // satellite for removal
+               satRejectedSet.insert( gData.getSat(row) );
+               continue;    // Skip this SV if problems arise
+            };
+
+               // Now we have to add the new values to the data structure
+            gData.set(row, slantCol, tropoCorr);
+            gData.set(row, dryCol, dryZDelay);
+            gData.set(row, wetCol, wetZDelay);
+            gData.set(row, dryMapCol, dryMap);
+            gData.set(row, wetMapCol, wetMap);
+
+         }  // End of loop 'for(row = 0; ...'
+
+            // Remove satellites with missing data
+         gData.removeSatID(satRejectedSet);
+
+         return gData;
+
+      }   // End of try...
+      catch(Exception& u)
+      {
+            // Throw an exception if something unexpected happens
+         ProcessingException e( getClassName() + ":"
+                                + u.what() );
+
+         GPSTK_THROW(e);
+
+      }
+
+   } // End ComputeTropModel::Process()
+
+
 } // End of namespace gpstk
@@ -133,8 +133,30 @@ namespace gpstk
    typeValueMap& typeValueMap::keepOnlyTypeID(const TypeIDSet& typeSet)
    {
 
-      typeValueMap tvMap( (*this).extractTypeID(typeSet) );
-      (*this) = tvMap;
+      return keepOnlyTypeID( TypeIDBitSet(typeSet) );
+
+   }  // End of method 'typeValueMap::keepOnlyTypeID()'
+
+
+
+      // Modifies this object, keeping only these types of data.
+      // @param typeBits Set (TypeIDBitSet) containing the types of
+      //                 data to be kept.
+   typeValueMap& typeValueMap::keepOnlyTypeID(const TypeIDBitSet& typeBits)
+   {
+
+      typeValueMap::iterator it( (*this).begin() );
+      while( it != (*this).end() )
+      {
+         if( typeBits.contains( (*it).first ) )
+         {
+            ++it;
+         }
+         else
+         {
+            (*this).erase(it++);
+         }
+      }
 
       return (*this);
 
@@ -161,6 +183,31 @@ namespace gpstk
 
 
 
+      // Modifies this object, removing these types of data.
+      // @param typeBits Set (TypeIDBitSet) containing the types of
+      //                 data to be removed.
+   typeValueMap& typeValueMap::removeTypeID(const TypeIDBitSet& typeBits)
+   {
+
+      typeValueMap::iterator it( (*this).begin() );
+      while( it != (*this).end() )
+      {
+         if( typeBits.contains( (*it).first ) )
+         {
+            (*this).erase(it++);
+         }
+         else
+         {
+            ++it;
+         }
+      }
+
+      return (*this);
+
+   }  // End of method 'typeValueMap::removeTypeID()'
+
+
+
       /* Returns the data value (double) corresponding to provided type.
        *
        * @param type       Type of value to be looked for.
@@ -664,8 +711,33 @@ namespace gpstk
    satTypeValueMap& satTypeValueMap::keepOnlyTypeID(const TypeIDSet& typeSet)
    {
 
-      satTypeValueMap stvMap( extractTypeID(typeSet) );
-      (*this) = stvMap;
+      return keepOnlyTypeID( TypeIDBitSet(typeSet) );
+
+   }  // End of method 'satTypeValueMap::keepOnlyTypeID()'
+
+
+
+      // Modifies this object, keeping only these types of data.
+      // Satellites left without data are removed.
+      // @param typeBits Set (TypeIDBitSet) containing the types of
+      //                 data to be kept.
+   satTypeValueMap& satTypeValueMap::keepOnlyTypeID(
+                                                const TypeIDBitSet& typeBits )
+   {
+
+      satTypeValueMap::iterator it( (*this).begin() );
+      while( it != (*this).end() )
+      {
+         (*it).second.keepOnlyTypeID(typeBits);
+         if( (*it).second.empty() )
+         {
+            (*this).erase(it++);
+         }
+         else
+         {
+            ++it;
+         }
+      }
 
       return (*this);
 
@@ -716,11 +788,23 @@ namespace gpstk
    satTypeValueMap& satTypeValueMap::removeTypeID(const TypeIDSet& typeSet)
    {
 
-      for( TypeIDSet::const_iterator pos = typeSet.begin();
-           pos != typeSet.end();
-           ++pos )
+      return removeTypeID( TypeIDBitSet(typeSet) );
+
+   }  // End of method 'satTypeValueMap::removeTypeID()'
+
+
+
+      // Modifies this object, removing these types of data.
+      // @param typeBits Set (TypeIDBitSet) containing the types of
+      //                 data to be removed.
+   satTypeValueMap& satTypeValueMap::removeTypeID(const TypeIDBitSet& typeBits)
+   {
+
+      for( satTypeValueMap::iterator it = (*this).begin();
+           it != (*this).end();
+           ++it )
       {
-         removeTypeID(*pos);
+         (*it).second.removeTypeID(typeBits);
       }
 
       return (*this);
@@ -221,6 +221,12 @@ namespace gpstk
       typeValueMap& keepOnlyTypeID(const TypeIDSet& typeSet);
 
 
+         /// Modifies this object, keeping only these types of data.
+         /// @param typeBits Set (TypeIDBitSet) containing the types of
+         ///                 data to be kept.
+      typeValueMap& keepOnlyTypeID(const TypeIDBitSet& typeBits);
+
+
          /// Modifies this object, removing this type of data.
          /// @param type Type of value to be removed.
       typeValueMap& removeTypeID(const TypeID& type)
@@ -233,6 +239,12 @@ namespace gpstk
       typeValueMap& removeTypeID(const TypeIDSet& typeSet);
 
 
+         /// Modifies this object, removing these types of data.
+         /// @param typeBits Set (TypeIDBitSet) containing the types of
+         ///                 data to be removed.
+      typeValueMap& removeTypeID(const TypeIDBitSet& typeBits);
+
+
          /** Returns the data value (double) corresponding to provided type.
           *
           * @param type       Type of value to be looked for.
@@ -430,6 +442,13 @@ namespace gpstk
       satTypeValueMap& keepOnlyTypeID(const TypeIDSet& typeSet);
 
 
+         /// Modifies this object, keeping only these types of data.
+         /// Satellites left without data are removed.
+         /// @param typeBits Set (TypeIDBitSet) containing the types of
+         ///                 data to be kept.
+      satTypeValueMap& keepOnlyTypeID(const TypeIDBitSet& typeBits);
+
+
          /// Modifies this object, removing this satellite.
          /// @param satellite Satellite to be removed.
       satTypeValueMap& removeSatID(const SatID& satellite)
@@ -453,6 +472,12 @@ namespace gpstk
       satTypeValueMap& removeTypeID(const TypeIDSet& typeSet);
 
 
+         /// Modifies this object, removing these types of data.
+         /// @param typeBits Set (TypeIDBitSet) containing the types of
+         ///                 data to be removed.
+      satTypeValueMap& removeTypeID(const TypeIDBitSet& typeBits);
+
+
          /// Returns a GPSTk::Vector containing the data values with this type.
          /// @param type Type of value to be returned.
          /// This method returns zero if a given satellite does not have
@@ -41,6 +41,7 @@
  */
 
 #include "EquationSystem.hpp"
+#include <ctime>
 #include <iterator>
 
 namespace gpstk
@@ -52,6 +53,72 @@ namespace gpstk
    WhiteNoiseModel EquationSystem::whiteNoiseModel;
 
 
+      // Data of the first element of 'gds' holding 'source', or null. The
+      // map caches the answer of each source.
+   static const satTypeValueMap* findSourceData(
+                     const gnssDataMap& gds,
+                     const SourceID& source,
+                     std::map<SourceID, const satTypeValueMap*>& sources )
+   {
+      std::map<SourceID, const satTypeValueMap*>::const_iterator itSource(
+                                                   sources.find(source) );
+      if( itSource != sources.end() )
+      {
+         return (*itSource).second;
+      }
+
+      const satTypeValueMap* data(0);
+      for( gnssDataMap::const_iterator itGDS = gds.begin();
+           itGDS != gds.end() && data == 0;
+           ++itGDS )
+      {
+         sourceDataMap::const_iterator itSDM = (*itGDS).second.find(source);
+         if( itSDM != (*itGDS).second.end() )
+         {
+            data = &(*itSDM).second;
+         }
+      }
+
+      sources[source] = data;
+      return data;
+   }
+
+
+      // Value of 'type' for 'sat' in 'data', falling back to the (much
+      // slower) search of 'gnssDataMap::getValue()' when it is not there
+   static double findValue( const gnssDataMap& gds,
+                            const satTypeValueMap* data,
+                            const SourceID& source,
+                            const SatID& sat,
+                            const TypeID& type )
+   {
+      if( data != 0 )
+      {
+         satTypeValueMap::const_iterator itSat( data->find(sat) );
+         if( itSat != data->end() )
+         {
+            typeValueMap::const_iterator itType( (*itSat).second.find(type) );
+            if( itType != (*itSat).second.end() )
+            {
+               return (*itType).second;
+            }
+         }
+      }
+
+      return gds.getValue(source, sat, type);
+   }
+
+
+      // Processor seconds since 'start', and reset 'start' to now
+   static double lapSeconds( std::clock_t& start )
+   {
+      std::clock_t now( std::clock() );
+      double secs( double(now - start) / CLOCKS_PER_SEC );
+      start = now;
+      return secs;
+   }
+
+
 
       /* Add a new equation to be managed.
        *
@@ -167,6 +234,8 @@ namespace gpstk
    EquationSystem& EquationSystem::Prepare( gnssDataMap& gdsMap )
    {
 
+      std::clock_t lap( std::clock() );
+
          // Let's start storing 'current' unknowns set from 'previous' epoch
       oldUnknowns = currentUnknowns;
 
@@ -203,17 +272,56 @@ namespace gpstk
          // Now, let's update the global set of unknowns with current unknowns
       varUnknowns.insert( currentUnknowns.begin(), currentUnknowns.end() );
 
+      prepareTimes.unknowns = lapSeconds(lap);
+
+         // Index the columns once, instead of searching 'varUnknowns' for
+         // each element of the matrices. The index of the previous epoch is
+         // updated in place: unknowns that disappeared are erased, new ones
+         // are inserted, and the columns of the rest follow the order of
+         // 'varUnknowns'
+      int col(0);
+      std::map<Variable, int>::iterator itIndex( unknownIndex.begin() );
+      for( VariableSet::const_iterator itVar = varUnknowns.begin();
+           itVar != varUnknowns.end();
+           ++itVar, ++col )
+      {
+
+         while( itIndex != unknownIndex.end() &&
+                (*itIndex).first < (*itVar) )
+         {
+            unknownIndex.erase( itIndex++ );
+         }
+
+         if( itIndex == unknownIndex.end() || (*itVar) < (*itIndex).first )
+         {
+            unknownIndex.insert( itIndex, std::make_pair( (*itVar), col ) );
+         }
+         else
+         {
+            (*itIndex).second = col;
+            ++itIndex;
+         }
+      }
+
+      unknownIndex.erase( itIndex, unknownIndex.end() );
+
+      prepareTimes.index = lapSeconds(lap);
+
          // Compute phiMatrix and qMatrix
       getPhiQ(gdsMap);
+      prepareTimes.phiQ = lapSeconds(lap);
 
          // Build prefit residuals vector
       getPrefit(gdsMap);
+      prepareTimes.prefit = lapSeconds(lap);
 
          // Get geometry and weights matrices
       getGeometryWeights(gdsMap);
+      prepareTimes.geometry = lapSeconds(lap);
 
          // Handling the ConstraintSystem
       imposeConstraints();
+      prepareTimes.constraints = lapSeconds(lap);
 
       /*
       ofstream debugstrm("unknows.debug");
@@ -541,6 +649,10 @@ namespace gpstk
          // Set a counter
       int i(0);
 
+         // The 'gnssRinex' of each source, extracted only once per epoch
+         // rather than once per variable
+      std::map<SourceID, gnssRinex> sourceData;
+
          // Visit each "Variable" inside "varUnknowns"
       for( VariableSet::const_iterator itVar  = varUnknowns.begin();
            itVar != varUnknowns.end();
@@ -552,7 +664,15 @@ namespace gpstk
          {
 
                // Get a 'gnssRinex' data structure
-            gnssRinex gRin( gdsMap.getGnssRinex( (*itVar).getSource() ) );
+            const SourceID source( (*itVar).getSource() );
+            std::map<SourceID, gnssRinex>::iterator itData(
+                                                   sourceData.find(source) );
+            if( itData == sourceData.end() )
+            {
+               itData = sourceData.insert( std::make_pair( source,
+                                    gdsMap.getGnssRinex(source) ) ).first;
+            }
+            gnssRinex& gRin( (*itData).second );
 
                // Prepare variable's stochastic model
             (*itVar).getModel()->Prepare( (*itVar).getSatellite(),
@@ -600,6 +720,11 @@ namespace gpstk
          // Declare temporal storage for values
       std::vector<double> tempPrefit;
 
+         // Work with the first element of the data structure, looking up
+         // the data of each source only once
+      gnssDataMap gds2( gdsMap.frontEpoch() );
+      std::map<SourceID, const satTypeValueMap*> sources;
+
          // Visit each Equation in "currentEquationsList"
       for( std::list<Equation>::const_iterator itEq =
                                                    currentEquationsList.begin();
@@ -608,7 +733,10 @@ namespace gpstk
       {
 
             // Store SourceID, SatID and TypeID of current equation
-         tempPrefit.push_back( gdsMap.getValue( (*itEq).header.equationSource,
+         const SourceID& source( (*itEq).header.equationSource );
+         tempPrefit.push_back( findValue( gdsMap,
+                                          findSourceData(gds2, source, sources),
+                                          source,
                                           (*itEq).header.equationSat,
                                           (*itEq).header.indTerm.getType() ) );
 
@@ -635,6 +763,11 @@ namespace gpstk
          // Let's work with the first element of the data structure
       gnssDataMap gds2( gdsMap.frontEpoch() );
 
+         // The data and data types present for each source, shared by its
+         // equations
+      std::map<SourceID, const satTypeValueMap*> sources;
+      std::map<SourceID, TypeIDSet> sourceTypes;
+
          // Let's fill weights and geometry matrices
       int row(0);                      // Declare a counter for row number
       for( std::list<Equation>::const_iterator itRow =
@@ -647,27 +780,21 @@ namespace gpstk
          SourceID source( (*itRow).header.equationSource );
          SatID sat( (*itRow).header.equationSat );
 
-            // Get a TypeIDSet with all the data types present in current GDS
-            // Declare an appropriate object
-         TypeIDSet typeSet;
-
-            // We need a flag
-         bool found( false );
-
-            // Iterate through data structure
-         for( gnssDataMap::const_iterator itGDS = gds2.begin();
-              itGDS != gds2.end() && !found;
-              ++itGDS )
+            // Get the data of this source and a TypeIDSet with all the
+            // data types present in it
+         const satTypeValueMap* data( findSourceData(gds2, source, sources) );
+         std::map<SourceID, TypeIDSet>::iterator itTypes(
+                                                   sourceTypes.find(source) );
+         if( itTypes == sourceTypes.end() )
          {
-               // Look for source
-            sourceDataMap::const_iterator itSDM = (*itGDS).second.find(source);
-            if( itSDM != (*itGDS).second.end() )
+            itTypes = sourceTypes.insert(
+                           std::make_pair( source, TypeIDSet() ) ).first;
+            if( data != 0 )
             {
-                  // Get the types
-               typeSet = (*itSDM).second.getTypeID();
-               found = true;
+               (*itTypes).second = data->getTypeID();
             }
          }
+         const TypeIDSet& typeSet( (*itTypes).second );
 
 
             // First, fill weights matrix
@@ -677,7 +804,7 @@ namespace gpstk
          {
                // Weights matrix = Equation weight * observation weight
             rMatrix(row,row) = (*itRow).header.constWeight
-                               * gds2.getValue(source, sat, TypeID::weight);
+                        * findValue(gds2, data, source, sat, TypeID::weight);
          }
          else
          {
@@ -685,54 +812,56 @@ namespace gpstk
             rMatrix(row,row) = (*itRow).header.constWeight;
          }
 
-            // Second, fill geometry matrix: Look for equation coefficients
+            // Second, fill geometry matrix: Look for equation coefficients.
+            // Only the few variables of this equation are visited, and their
+            // columns come from 'unknownIndex'
          int col(0);                   // Declare a counter for column number
-         for( VariableSet::const_iterator itCol = varUnknowns.begin();
-              itCol != varUnknowns.end();
-              ++itCol )
+         for( VariableSet::const_iterator itVar = (*itRow).body.begin();
+              itVar != (*itRow).body.end();
+              ++itVar )
          {
 
-               // Check if unknown is in current equation and also is marked
-               // as a current unknown
-            if( (*itRow).body.find( (*itCol) ) != (*itRow).body.end() &&
-                currentUnknowns.find( (*itCol) ) != currentUnknowns.end() )
+               // Check if variable is marked as a current unknown
+            if( currentUnknowns.find( (*itVar) ) != currentUnknowns.end() )
             {
 
+                  // Column and 'varUnknowns' element for this variable
+               std::map<Variable, int>::const_iterator itCol(
+                                             unknownIndex.find( (*itVar) ) );
+               col = (*itCol).second;
+
                   // Check if '(*itCol)' unknown variable enforces a specific
                   // coefficient
-               if( (*itCol).isDefaultForced() )
+               if( (*itCol).first.isDefaultForced() )
                {
                      // Use default coefficient
-                  hMatrix(row,col) = (*itCol).getDefaultCoefficient();
+                  hMatrix(row,col) = (*itCol).first.getDefaultCoefficient();
                }
                else
                {
                      // Look the coefficient in provided data
 
                      // Get type of current varUnknown
-                  TypeID type( (*itCol).getType() );
+                  TypeID type( (*itCol).first.getType() );
 
                      // Check if this type has an entry in current GDS type set
                   if( typeSet.find(type) != typeSet.end() )
                   {
                         // If type was found, insert value into hMatrix
-                     hMatrix(row,col) = gds2.getValue(source, sat, type);
+                     hMatrix(row,col) = findValue(gds2, data, source, sat, type);
                   }
                   else
                   {
                         // If value for current type is not in gdsMap, then
                         // insert default coefficient for this variable
-                     hMatrix(row,col) = (*itCol).getDefaultCoefficient();
+                     hMatrix(row,col) = (*itCol).first.getDefaultCoefficient();
                   }
 
-               }  // End of 'if( (*itCol).isDefaultForced() ) ...'
-
-            }  // End of 'if( (*itRow).body.find( (*itCol) ) != ...'
+               }  // End of 'if( (*itCol).first.isDefaultForced() ) ...'
 
-               // Increment column counter
-            ++col;
+            }  // End of 'if( currentUnknowns.find( (*itVar) ) != ...'
 
-         }  // End of 'for( VariableSet::const_iterator itCol = ...'
+         }  // End of 'for( VariableSet::const_iterator itVar = ...'
 
             // Handle type index variable
          for( VariableSet::const_iterator itCol = (*itRow).body.begin();
@@ -781,7 +910,7 @@ namespace gpstk
                 if( typeSet.find(type) != typeSet.end() )
                 {
                        // If type was found, insert value into hMatrix
-                    hMatrix(row,col) = gds2.getValue(source, sat, type);
+                    hMatrix(row,col) = findValue(gds2, data, source, sat, type);
                 }
                 else
                 {
@@ -44,6 +44,7 @@
 #define GPSTK_EQUATIONSYSTEM_HPP
 
 #include <algorithm>
+#include <map>
 
 #include "DataStructures.hpp"
 #include "StochasticModel.hpp"
@@ -173,6 +174,53 @@ namespace gpstk
    {
    public:
 
+         /** Processor time, in seconds, spent by the steps of Prepare().
+          *
+          * The sets of unknowns and the list of current equations are
+          * rebuilt from scratch every epoch, and 'unknowns' is the cost of
+          * that rebuild. The column index is kept between epochs and only
+          * the unknowns that appear or disappear are inserted or erased;
+          * 'index' is the cost of that update.
+          */
+      struct PrepareTimes
+      {
+            /// Sets of unknowns and list of current equations
+         double unknowns;
+            /// Column index of the unknowns
+         double index;
+            /// State transition and process noise matrices
+         double phiQ;
+            /// Prefit residuals vector
+         double prefit;
+            /// Geometry and weights matrices
+         double geometry;
+            /// Constraints appended to the system
+         double constraints;
+
+         PrepareTimes()
+            : unknowns(0.0), index(0.0), phiQ(0.0), prefit(0.0),
+              geometry(0.0), constraints(0.0)
+         {};
+
+            /// Sum of all steps
+         double total() const
+         {
+            return unknowns + index + phiQ + prefit + geometry
+                   + constraints;
+         };
+
+            /// Accumulate the times of another call
+         PrepareTimes& operator+=(const PrepareTimes& right)
+         {
+            unknowns += right.unknowns; index += right.index;
+            phiQ += right.phiQ;
+            prefit += right.prefit; geometry += right.geometry;
+            constraints += right.constraints;
+            return (*this);
+         };
+      };
+
+
          /// Default constructor
       EquationSystem()
          : isPrepared(false)
@@ -353,6 +401,21 @@ namespace gpstk
          throw(InvalidEquationSystem);
 
 
+         /// Get the time spent by the steps of the last call to Prepare().
+      virtual PrepareTimes getPrepareTimes() const
+      { return prepareTimes; };
+
+
+         /** Return the column of a variable in the matrices of the last
+          *  call to Prepare(), or -1 if it is not one of the unknowns.
+          */
+      virtual int getUnknownIndex( const Variable& var ) const
+      {
+         std::map<Variable, int>::const_iterator it( unknownIndex.find(var) );
+         return ( it == unknownIndex.end() ? -1 : (*it).second );
+      };
+
+
          /// Get the number of equation descriptions being currently processed.
       virtual int getEquationDefinitionNumber() const
       { return equationDescriptionList.size(); };
@@ -412,6 +475,13 @@ namespace gpstk
          /// Set of reject unknowns
       VariableSet rejectUnknowns;
 
+         /// Column of each variable of 'varUnknowns' in the matrices. It is
+         /// kept between epochs and updated in place by Prepare()
+      std::map<Variable, int> unknownIndex;
+
+         /// Time spent by the steps of the last call to Prepare()
+      PrepareTimes prepareTimes;
+
          /// Whether or not this EquationSystem is ready to be used
       bool isPrepared;
 
@@ -0,0 +1,335 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S.
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software.
+//
+//Pursuant to DoD Directive 523024
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+/**
+ * @file GnssRinexStore.cpp
+ * Sequence of gnssRinex epochs kept in compact binary form.
+ */
+
+#include "GnssRinexStore.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+
+namespace gpstk
+{
+
+      // Append the bytes of 'value' to 'buffer'
+   template <class T>
+   static void put( std::vector<char>& buffer, const T& value )
+   {
+      const char* p( reinterpret_cast<const char*>(&value) );
+      buffer.insert( buffer.end(), p, p + sizeof(T) );
+   }
+
+
+      // Append a string to 'buffer'
+   static void putString( std::vector<char>& buffer, const std::string& s )
+   {
+      put( buffer, int(s.size()) );
+      buffer.insert( buffer.end(), s.begin(), s.end() );
+   }
+
+
+      // Read 'value' from 'p', and advance 'p'
+   template <class T>
+   static void take( const char*& p, T& value )
+   {
+      std::memcpy( &value, p, sizeof(T) );
+      p += sizeof(T);
+   }
+
+
+      // Read a string from 'p', and advance 'p'
+   static void takeString( const char*& p, std::string& s )
+   {
+      int size;
+      take(p, size);
+      s.assign(p, size);
+      p += size;
+   }
+
+
+      /* Default constructor.
+       *
+       * @param types   Types to be stored. If empty, all types are
+       *                stored.
+       */
+   GnssRinexStore::GnssRinexStore( const TypeIDSet& types )
+      : first(0)
+   {
+      setTypeSet(types);
+   }
+
+
+      /* Set the types to be stored from now on. Epochs already in
+       * the store keep their data.
+       *
+       * @param types   Types to be stored. If empty, all types are
+       *                stored.
+       */
+   GnssRinexStore& GnssRinexStore::setTypeSet( const TypeIDSet& types )
+   {
+      keepTypes = types;
+
+         // Types are only ever appended to the table, so that the bit
+         // masks of epochs already stored keep their meaning
+      for( TypeIDSet::const_iterator it = types.begin();
+           it != types.end();
+           ++it )
+      {
+         if( typeIndex.find(*it) == typeIndex.end() )
+         {
+            typeIndex[*it] = typeTable.size();
+            typeTable.push_back(*it);
+         }
+      }
+
+      return (*this);
+   }
+
+
+      // Serialize 'gData' into 'buffer'.
+   void GnssRinexStore::encode( const gnssRinex& gData )
+   {
+         // When every type is stored, add the new ones to the table
+      if( keepTypes.empty() )
+      {
+         for( satTypeValueMap::const_iterator itSat = gData.body.begin();
+              itSat != gData.body.end();
+              ++itSat )
+         {
+            for( typeValueMap::const_iterator itType = (*itSat).second.begin();
+                 itType != (*itSat).second.end();
+                 ++itType )
+            {
+               if( typeIndex.find( (*itType).first ) == typeIndex.end() )
+               {
+                  typeIndex[ (*itType).first ] = typeTable.size();
+                  typeTable.push_back( (*itType).first );
+               }
+            }
+         }
+      }
+
+      buffer.clear();
+
+         // Header
+      const sourceEpochRinexHeader& header( gData.header );
+      put( buffer, int(header.source.type) );
+      putString( buffer, header.source.sourceName );
+
+      long day, msod;
+      double fsod;
+      TimeSystem timeSystem;
+      header.epoch.getInternal(day, msod, fsod, timeSystem);
+      put( buffer, day );
+      put( buffer, msod );
+      put( buffer, fsod );
+      put( buffer, int(timeSystem.getTimeSystem()) );
+
+      putString( buffer, header.antennaType );
+      for( int i = 0; i < 3; i++ )
+      {
+         put( buffer, header.antennaPosition[i] );
+      }
+      put( buffer, header.epochFlag );
+
+         // Body: bit mask of the types present in each satellite, followed
+         // by their values in the order of 'typeTable'
+      const int numTypes( typeTable.size() );
+      const int maskSize( (numTypes + 7) / 8 );
+      put( buffer, numTypes );
+      put( buffer, int(gData.body.size()) );
+
+      std::vector<unsigned char> mask(maskSize);
+      std::vector<double> values;
+      for( satTypeValueMap::const_iterator itSat = gData.body.begin();
+           itSat != gData.body.end();
+           ++itSat )
+      {
+         put( buffer, int((*itSat).first.system) );
+         put( buffer, (*itSat).first.id );
+
+         std::fill( mask.begin(), mask.end(), 0 );
+         values.clear();
+         const typeValueMap& tvMap( (*itSat).second );
+         for( int t = 0; t < numTypes; t++ )
+         {
+            const TypeID& type( typeTable[t] );
+            if( !keepTypes.empty() && keepTypes.find(type) == keepTypes.end() )
+            {
+               continue;
+            }
+
+            typeValueMap::const_iterator itType( tvMap.find(type) );
+            if( itType != tvMap.end() )
+            {
+               mask[t / 8] |= (unsigned char)(1 << (t % 8));
+               values.push_back( (*itType).second );
+            }
+         }
+
+         buffer.insert( buffer.end(), mask.begin(), mask.end() );
+         for( size_t v = 0; v < values.size(); v++ )
+         {
+            put( buffer, values[v] );
+         }
+      }
+   }
+
+
+      // Append an epoch.
+   void GnssRinexStore::push_back( const gnssRinex& gData )
+      throw(InvalidRequest)
+   {
+      encode(gData);
+      records.push_back(buffer);
+   }
+
+
+      /* Read an epoch.
+       *
+       * @param index   Index of the epoch, counted from the front.
+       * @param gData   Object that will hold the epoch.
+       */
+   void GnssRinexStore::get( size_t index, gnssRinex& gData ) const
+      throw(InvalidRequest)
+   {
+      if( index >= size() )
+      {
+         InvalidRequest e("Epoch not found in GnssRinexStore.");
+         GPSTK_THROW(e);
+      }
+
+      std::vector<char> record;
+      records.get( first + index, record );
+      const char* p( record.empty() ? 0 : &record[0] );
+
+         // Header
+      sourceEpochRinexHeader& header( gData.header );
+      int sourceType;
+      take( p, sourceType );
+      header.source.type = SourceID::SourceType(sourceType);
+      takeString( p, header.source.sourceName );
+
+      long day, msod;
+      double fsod;
+      int timeSystem;
+      take( p, day );
+      take( p, msod );
+      take( p, fsod );
+      take( p, timeSystem );
+      header.epoch.setInternal( day, msod, fsod, TimeSystem(timeSystem) );
+
+      takeString( p, header.antennaType );
+      for( int i = 0; i < 3; i++ )
+      {
+         take( p, header.antennaPosition[i] );
+      }
+      take( p, header.epochFlag );
+
+         // Body
+      int numTypes, numSats;
+      take( p, numTypes );
+      take( p, numSats );
+      const int maskSize( (numTypes + 7) / 8 );
+
+      gData.body.clear();
+      for( int s = 0; s < numSats; s++ )
+      {
+         int system, id;
+         take( p, system );
+         take( p, id );
+
+         const unsigned char* mask( reinterpret_cast<const unsigned char*>(p) );
+         p += maskSize;
+
+         typeValueMap& tvMap( gData.body[ SatID(id,
+                                          SatID::SatelliteSystem(system)) ] );
+         for( int t = 0; t < numTypes; t++ )
+         {
+            if( mask[t / 8] & (1 << (t % 8)) )
+            {
+               double value;
+               take( p, value );
+               tvMap[ typeTable[t] ] = value;
+            }
+         }
+      }
+   }
+
+
+      /* Rewrite an epoch.
+       *
+       * @param index   Index of the epoch, counted from the front.
+       * @param gData   New contents of the epoch.
+       */
+   void GnssRinexStore::set( size_t index, const gnssRinex& gData )
+      throw(InvalidRequest)
+   {
+      if( index >= size() )
+      {
+         InvalidRequest e("Epoch not found in GnssRinexStore.");
+         GPSTK_THROW(e);
+      }
+
+      encode(gData);
+      records.set( first + index, buffer );
+   }
+
+
+      // Remove the first epoch, freeing its memory when possible.
+   void GnssRinexStore::pop_front(void)
+      throw(InvalidRequest)
+   {
+      if( empty() )
+      {
+         InvalidRequest e("GnssRinexStore is empty.");
+         GPSTK_THROW(e);
+      }
+
+      records.release(first);
+      ++first;
+
+      if( empty() )
+      {
+         clear();
+      }
+   }
+
+}  // End of namespace gpstk
@@ -0,0 +1,242 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S.
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software.
+//
+//Pursuant to DoD Directive 523024
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+/**
+ * @file GnssRinexStore.hpp
+ * Sequence of gnssRinex epochs kept in compact binary form.
+ */
+
+#ifndef GPSTK_GNSSRINEXSTORE_HPP
+#define GPSTK_GNSSRINEXSTORE_HPP
+
+#include <map>
+#include <vector>
+
+#include "DataStructures.hpp"
+#include "RecordStore.hpp"
+
+
+namespace gpstk
+{
+
+      /// @ingroup DataStructures
+      //@{
+
+
+      /** This class stores a sequence of gnssRinex epochs, keeping only
+       *  the data of a given set of types.
+       *
+       * Each epoch is serialized into a compact binary record: the
+       * header, and for each satellite its SatID, a bit mask of the types
+       * present and their values. The records are kept in a RecordStore,
+       * so they are packed into large memory chunks and may be spilled to
+       * a temporary file beyond a given memory threshold.
+       *
+       * Compared with a std::list<gnssRinex>, this avoids one allocation
+       * per satellite and per value, which dominate the memory used by a
+       * long list of epochs.
+       *
+       * @code
+       *   TypeIDSet types;
+       *   types.insert(TypeID::prefitC);
+       *   types.insert(TypeID::prefitL);
+       *
+       *   GnssRinexStore store(types);
+       *   store.setSpillThreshold(512 * 1024 * 1024);
+       *
+       *   while(rin >> gRin)
+       *   {
+       *      store.push_back(gRin);
+       *   }
+       *
+       *   for (size_t i = store.size(); i > 0; --i)
+       *   {
+       *      gnssRinex g( store.get(i-1) );
+       *      ...
+       *   }
+       * @endcode
+       */
+   class GnssRinexStore
+   {
+   public:
+
+         /** Default constructor.
+          *
+          * @param types   Types to be stored. If empty, all types are
+          *                stored.
+          */
+      GnssRinexStore( const TypeIDSet& types = TypeIDSet() );
+
+
+         /** Set the types to be stored from now on. Epochs already in
+          *  the store keep their data.
+          *
+          * @param types   Types to be stored. If empty, all types are
+          *                stored.
+          */
+      virtual GnssRinexStore& setTypeSet( const TypeIDSet& types );
+
+
+         /// Get the types being stored. If empty, all types are stored.
+      virtual TypeIDSet getTypeSet(void) const
+      { return keepTypes; };
+
+
+         /** Set the number of bytes of epochs kept in memory, beyond
+          *  which new epochs are written to a temporary file.
+          *
+          * @param bytes    Memory threshold. Zero spills every epoch.
+          * @param dir      Directory of the temporary file. If empty, the
+          *                 system default is used.
+          */
+      virtual GnssRinexStore& setSpillThreshold( size_t bytes,
+                                                 const std::string& dir = "" )
+      { records.setSpillThreshold(bytes, dir); return (*this); };
+
+
+         /// Read spilled epochs through a memory mapping of the temporary
+         /// file, until the next write to it.
+      virtual void mapSpill(void)
+      { records.mapSpill(); };
+
+
+         /// Append an epoch.
+      virtual void push_back( const gnssRinex& gData )
+         throw(InvalidRequest);
+
+
+         /** Read an epoch.
+          *
+          * @param index   Index of the epoch, counted from the front.
+          * @param gData   Object that will hold the epoch.
+          */
+      virtual void get( size_t index, gnssRinex& gData ) const
+         throw(InvalidRequest);
+
+
+         /// Read an epoch.
+      virtual gnssRinex get( size_t index ) const
+         throw(InvalidRequest)
+      { gnssRinex gData; get(index, gData); return gData; };
+
+
+         /// Read the first epoch.
+      virtual gnssRinex front(void) const
+         throw(InvalidRequest)
+      { return get(0); };
+
+
+         /** Rewrite an epoch.
+          *
+          * @param index   Index of the epoch, counted from the front.
+          * @param gData   New contents of the epoch.
+          */
+      virtual void set( size_t index, const gnssRinex& gData )
+         throw(InvalidRequest);
+
+
+         /// Remove the first epoch, freeing its memory when possible.
+      virtual void pop_front(void)
+         throw(InvalidRequest);
+
+
+         /// Remove all epochs.
+      virtual void clear(void)
+      { records.clear(); first = 0; };
+
+
+         /// Number of epochs in the store.
+      virtual size_t size(void) const
+      { return records.size() - first; };
+
+
+         /// Whether the store is empty.
+      virtual bool empty(void) const
+      { return size() == 0; };
+
+
+         /// Bytes currently allocated in memory.
+      virtual size_t memoryBytes(void) const
+      { return records.memoryBytes(); };
+
+
+         /// Bytes written to the temporary file.
+      virtual size_t spilledBytes(void) const
+      { return records.spilledBytes(); };
+
+
+         /// Destructor.
+      virtual ~GnssRinexStore() {};
+
+
+   private:
+
+
+         /// Serialize 'gData' into 'buffer'.
+      void encode( const gnssRinex& gData );
+
+
+         /// Types to be stored; empty for all types.
+      TypeIDSet keepTypes;
+
+
+         /// Every type ever stored, in the order of the bit masks.
+      std::vector<TypeID> typeTable;
+
+
+         /// Position of each type in 'typeTable'.
+      std::map<TypeID, int> typeIndex;
+
+
+         /// The serialized epochs.
+      RecordStore records;
+
+
+         /// Index in 'records' of the first epoch.
+      size_t first;
+
+
+         /// Scratch buffer.
+      std::vector<char> buffer;
+
+
+   }; // End of class 'GnssRinexStore'
+
+      //@}
+
+}  // End of namespace gpstk
+
+#endif   // GPSTK_GNSSRINEXSTORE_HPP
@@ -44,6 +44,7 @@
 #define GPSTK_LICSDETECTOR_HPP
 
 #include "ProcessingClass.hpp"
+#include "CSDetectorTable.hpp"
 
 
 
@@ -226,6 +227,37 @@ namespace gpstk
          throw(ProcessingException);
 
 
+         /** Returns a satTypeValueTable object, adding the new data
+          *  generated when calling this object.
+          *
+          * @param epoch     Time of observations.
+          * @param gData     Data object holding the data.
+          * @param epochflag Epoch flag.
+          */
+      virtual satTypeValueTable& Process( const CommonTime& epoch,
+                                          satTypeValueTable& gData,
+                                          const short& epochflag = 0 )
+         throw(ProcessingException);
+
+
+         /** Returns a gnnsRinexTable object, adding the new data generated
+          *  when calling this object.
+          *
+          * @param gData    Data object holding the data.
+          */
+      virtual gnssRinexTable& Process(gnssRinexTable& gData)
+         throw(ProcessingException)
+      {
+         Process(gData.header.epoch, gData.body, gData.header.epochFlag);
+         return gData;
+      };
+
+
+         /// This class works on tables directly.
+      virtual bool isTableNative() const
+      { return true; };
+
+
          /// Returns a string identifying this object.
       virtual std::string getClassName(void) const;
 
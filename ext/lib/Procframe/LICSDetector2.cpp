@@ -184,6 +184,42 @@ namespace gpstk
 
 
 
+      /* Returns a satTypeValueTable object, adding the new data generated
+       *  when calling this object.
+       *
+       * @param epoch     Time of observations.
+       * @param gData     Data object holding the data.
+       * @param epochflag Epoch flag.
+       */
+   satTypeValueTable& LICSDetector2::Process( const CommonTime& epoch,
+                                              satTypeValueTable& gData,
+                                              const short& epochflag )
+      throw(ProcessingException)
+   {
+
+      try
+      {
+
+         return detectCSTable( (*this), &LICSDetector2::getDetection,
+                               epoch, gData, epochflag,
+                               obsType, lliType1, lliType2,
+                               resultType1, resultType2, useLLI );
+
+      }
+      catch(Exception& u)
+      {
+            // Throw an exception if something unexpected happens
+         ProcessingException e( getClassName() + ":"
+                                + u.what() );
+
+         GPSTK_THROW(e);
+
+      }
+
+   }  // End of method 'LICSDetector2::Process()'
+
+
+
       /* Method to set the maximum interval of time allowed between two
        *  successive epochs.
        *
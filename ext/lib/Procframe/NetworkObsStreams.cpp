@@ -42,6 +42,7 @@
 
 #include "NetworkObsStreams.hpp"
 #include "RinexObsHeader.hpp"
+#include <cmath>
 
 
 namespace gpstk
@@ -50,58 +51,19 @@ namespace gpstk
       // @obsFile Rinex observation file name
    bool NetworkObsStreams::addRinexObsFile(const std::string& obsFile)
    {
-         // object to hold the data
-      ObsData oData;
-      oData.obsFile = obsFile;
-
-      try
-      {
-            // allocate memory
-         oData.pObsStream = new RinexObsStream();
-         oData.pSynchro = new Synchronize();
-         if(!oData.pObsStream || !oData.pSynchro)
-         {
-            if(oData.pObsStream) delete oData.pObsStream;
-            if(oData.pSynchro) delete oData.pSynchro;
-
-            return false;
-         }
-            // Open the file
-         oData.pObsStream->exceptions(std::ios::failbit);
-         oData.pObsStream->open(oData.obsFile, std::ios::in);
-
-            // We reader the header of the obs file
-         RinexObsHeader obsHeader;
-         (*oData.pObsStream) >> obsHeader;
-
-
-         oData.obsSource.type = SatIDsystem2SourceIDtype(obsHeader.system);
-         oData.obsSource.sourceName = obsHeader.markerName;
-
-         oData.pSynchro->setReferenceSource(*oData.pObsStream);
-
-            // Now, we should store the data for the receiver
-         allStreamData.push_back(oData);
-
-         mapSourceStream[oData.obsSource] = oData.pObsStream;
-         mapSourceSynchro[oData.obsSource] = oData.pSynchro;
-
-         referenceSource = oData.obsSource;
-
-         return true;
-      }
-      catch(...)
+      if( !streams.addRinexObsFile(obsFile) )
       {
          // Problem opening the file
          // Maybe it doesn't exist or you don't have proper read permissions
-
-         // We have to deallocate the memory here
-         delete oData.pObsStream;
-         oData.pObsStream = (RinexObsStream*)0;
-
          return false;
       }
 
+      pendingEpochs.push_back(PendingEpoch());
+
+      referenceSource = streams.getSource(streams.size()-1);
+
+      return true;
+
    }  // End of method 'NetworkObsStreams::addRinexObsFile()'
 
       // Get epoch data of the network
@@ -113,30 +75,25 @@ namespace gpstk
       // First, We clear the data map
       gdsMap.clear();
 
+      size_t refIndex = streams.indexOfSource(referenceSource);
 
-      RinexObsStream* pRefObsStream = mapSourceStream[referenceSource];
+      if(refIndex == streams.size()) return false;
 
       gnssRinex gRef;
   
-      if( (*pRefObsStream) >> gRef )
+      if( streams.readSourceEpoch(refIndex, gRef) )
       {
          gdsMap.addGnssRinex(gRef);
 
-         std::map<SourceID, RinexObsStream*>::iterator it;
-         for( it = mapSourceStream.begin();
-              it != mapSourceStream.end();
-            ++it)
+         for(size_t i = 0; i < streams.size(); i++)
          {
-            if( it->first == referenceSource) continue;
-
-            Synchronize* synchro = mapSourceSynchro[it->first];
-            synchro->setRoverData(gRef);
+            if(i == refIndex) continue;
 
             gnssRinex gRin;
 
             try
             {
-               gRin >> (*synchro);
+               synchronize(i, gRef.header.epoch, gRin);
                gdsMap.addGnssRinex(gRin);
             }
             catch(...)
@@ -153,62 +110,149 @@ namespace gpstk
                }
             }
 
-         }  // End of 'for(std::map<SourceID, RinexObsStream*>::iterator it;
+         }  // End of 'for(size_t i = 0; i < streams.size(); i++)'
          
          return true;
 
-      }  // End of 'if( (*pRefObsStream) >> gRef )'
+      }  // End of 'if( streams.readSourceEpoch(refIndex, gRef) )'
 
 
       return false;
 
    }  // End of method 'NetworkObsStreams::readEpochData()'
 
+      // Get the epoch of file 'index' synchronized with 'time'
+   void NetworkObsStreams::synchronize( size_t index,
+                                        const CommonTime& time,
+                                        gnssRinex& gRin )
+      throw(SynchronizeException)
+   {
+      PendingEpoch& next = pendingEpochs[index];
+
+      if( !keepLaterEpochs )
+      {
+            // As Synchronize does: the first epoch of the file is kept, and
+            // the file is read on until an epoch is not older than 'time'
+         if( !next.valid )
+         {
+            if( !streams.readSourceEpoch(index, next.gRin) )
+            {
+               SynchronizeException e( "No more data to synchronize at epoch "
+                                       + time.asString() );
+               GPSTK_THROW(e);
+            }
+
+            next.valid = true;
+         }
+
+         gRin = next.gRin;
+
+         if( (gRin.header.epoch > time) &&
+             (std::abs( gRin.header.epoch - time ) > tolerance) )
+         {
+            SynchronizeException e( "Unable to synchronize data at epoch "
+                                    + time.asString() );
+            GPSTK_THROW(e);
+         }
+
+         while( (gRin.header.epoch < time) &&
+                (std::abs( gRin.header.epoch - time ) > tolerance) )
+         {
+            if( !streams.readSourceEpoch(index, gRin) )
+            {
+               SynchronizeException e( "No more data to synchronize at epoch "
+                                       + time.asString() );
+               GPSTK_THROW(e);
+            }
+         }
+
+         if( std::abs( gRin.header.epoch - time ) > tolerance )
+         {
+            SynchronizeException e( "Unable to synchronize data at epoch "
+                                    + time.asString() );
+            GPSTK_THROW(e);
+         }
+
+         return;
+      }
+
+      while(true)
+      {
+         if( !next.valid )
+         {
+            if( !streams.readSourceEpoch(index, next.gRin) )
+            {
+               SynchronizeException e( "No more data to synchronize at epoch "
+                                       + time.asString() );
+               GPSTK_THROW(e);
+            }
+
+            next.valid = true;
+         }
+
+         double dt( next.gRin.header.epoch - time );
+
+            // Skip data older than the reference data
+         if( dt < -tolerance )
+         {
+            next.valid = false;
+            continue;
+         }
+
+            // Keep data newer than the reference data for later
+         if( dt > tolerance )
+         {
+            SynchronizeException e( "Unable to synchronize data at epoch "
+                                    + time.asString() );
+            GPSTK_THROW(e);
+         }
+
+         gRin = next.gRin;
+         next.valid = false;
+
+         return;
+      }
+
+   }  // End of method 'NetworkObsStreams::synchronize()'
+
       // do some clean operation 
    void NetworkObsStreams::cleanUp()
    {
-      mapSourceStream.clear();
+      streams.stop();
 
-      std::list<ObsData>::iterator it;
-      for( it = allStreamData.begin();
-           it != allStreamData.end();
+      pendingEpochs.clear();
+
+      std::map<SourceID, RinexObsStream*>::iterator it;
+      for( it = mapSourceStream.begin();
+           it != mapSourceStream.end();
          ++it)
       {
-         if(it->pObsStream)
-         {
-            it->pObsStream->close();
-            delete it->pObsStream;
-            it->pObsStream = (RinexObsStream*)0;
-         }
-         
-         if(it->pSynchro)
+         if(it->second)
          {
-            delete it->pSynchro;
-            it->pSynchro = (Synchronize*)0;
+            it->second->close();
+            delete it->second;
          }
       }
 
-      allStreamData.clear();
+      mapSourceStream.clear();
 
    }  // End of method 'NetworkObsStreams::cleanUp()'
 
       // Get the SourceID of the rinex observation file
    SourceID NetworkObsStreams::sourceIDOfRinexObsFile(std::string obsFile)
    {
-      try
+      for(size_t i = 0; i < streams.size(); i++)
       {
-         RinexObsStream rin;
-         rin.exceptions(std::ios::failbit);
-         rin.open(obsFile, std::ios::in);
- 
-         gnssRinex gRin;
-         rin >> gRin;
-
-         rin.close();
-         
-         return gRin.header.source;
+         if(streams.getFileName(i) == obsFile) return streams.getSource(i);
       }
-      catch(...)
+
+      ParallelObsStreams file(0);
+
+      if( file.addRinexObsFile(obsFile) )
+      {
+         return file.getSource(0);
+      }
+      else
       {
          // Problem opening the file
          // Maybe it doesn't exist or you don't have proper read permissions
@@ -222,4 +266,40 @@ namespace gpstk
 
    }  // End of method 'NetworkObsStreams::sourceIDOfRinexObsFile'
 
+      // Get a RinexObsStream of the file of 'source', with its header read
+   RinexObsStream* NetworkObsStreams::getRinexObsStream(const SourceID& source)
+   {
+      std::map<SourceID, RinexObsStream*>::iterator it =
+         mapSourceStream.find(source);
+
+      if(it != mapSourceStream.end()) return it->second;
+
+      size_t index = streams.indexOfSource(source);
+
+      if(index == streams.size()) return (RinexObsStream*)0;
+
+      RinexObsStream* pObsStream = new RinexObsStream();
+
+      try
+      {
+         pObsStream->open(streams.getFileName(index), std::ios::in);
+         pObsStream->exceptions(std::ios::failbit);
+
+            // We read the header of the obs file
+         RinexObsHeader obsHeader;
+         (*pObsStream) >> obsHeader;
+      }
+      catch(...)
+      {
+         // Problem opening the file or reading its header
+         delete pObsStream;
+         pObsStream = (RinexObsStream*)0;
+      }
+
+      mapSourceStream[source] = pObsStream;
+
+      return pObsStream;
+
+   }  // End of method 'NetworkObsStreams::getRinexObsStream()'
+
 }  // End of namespace gpstk
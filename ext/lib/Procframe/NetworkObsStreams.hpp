@@ -45,11 +45,12 @@
 
 #include <iostream>
 #include <string>
-#include <list>
+#include <vector>
 #include <map>
 #include "RinexObsStream.hpp"
 #include "DataStructures.hpp"
 #include "Synchronize.hpp"
+#include "ParallelObsStreams.hpp"
 
 namespace gpstk
 {
@@ -86,10 +87,19 @@ namespace gpstk
        *
        * @endcode
        *
-       * Each NetworkObsStreams object will handle a RinexObsStream object
-       * for every rinex observation file of the network. It can synchronize
-       * reference observation file with all other files, and get a gnssDataMap
-       * object holding the network observation data epoch by epoch.
+       * Each NetworkObsStreams object will handle a RinexObsStream (or
+       * Rinex3ObsStream) object for every rinex observation file of the
+       * network. It can synchronize reference observation file with all other
+       * files, and get a gnssDataMap object holding the network observation
+       * data epoch by epoch.
+       *
+       * The files are decoded ahead of use by a ParallelObsStreams object on
+       * up to setNumThreads() threads. Other files are synchronized with the
+       * reference epoch as the Synchronize class does, with a tolerance of
+       * 1 s by default. After 'NetworkObsStreams::setKeepLaterEpochs(true)',
+       * epochs older than the reference epoch are skipped, and an epoch
+       * later than it is kept for the next reference epoch instead of being
+       * dropped, so that a file with gaps stays synchronized.
        *
        * By default, NetworkObsStreams object will skip the observation file failed
        * to be synchronized. When 'NetworkObsStreams::setSynchronizeException(true)'
@@ -100,7 +110,9 @@ namespace gpstk
    {
    public:
          /// Default constructor
-      NetworkObsStreams() : synchronizeException(false)
+      NetworkObsStreams()
+         : synchronizeException(false), tolerance(1.0),
+           keepLaterEpochs(false)
       {}
 
          /// Default destructor
@@ -122,6 +134,21 @@ namespace gpstk
       void setSynchronizeException(const bool& synException = true)
       { synchronizeException = synException; }
 
+         /// Set the synchronization tolerance, in seconds.
+      void setTolerance(const double tol)
+      { if(tol >= 0.0) tolerance = tol; }
+
+         /// Keep an epoch later than the reference epoch for the next
+         /// reference epoch, instead of dropping it as Synchronize does.
+      void setKeepLaterEpochs(const bool& keep = true)
+      { keepLaterEpochs = keep; }
+
+         /// Set the number of threads decoding the files, before the
+         /// first call to readEpochData(). Zero decodes on the calling
+         /// thread.
+      void setNumThreads(unsigned numThreads)
+      { streams.setNumThreads(numThreads); }
+
          /// Get epoch data of the network
          /// @gdsMap  Object hold epoch observation data of the network
          /// @return  Is there more epoch data for the network 
@@ -131,30 +158,46 @@ namespace gpstk
          /// Get the SourceID of the rinex observation file
       SourceID sourceIDOfRinexObsFile(std::string obsFile);
 
-      RinexObsStream* getRinexObsStream(const SourceID& source)
-      { return mapSourceStream[source]; }
+         /** Get a RinexObsStream of the file of 'source', with its header
+          *  already read, or NULL if there is no such file.
+          *
+          * The stream is opened apart from the decoder threads, so reading
+          * from it does not affect readEpochData().
+          */
+      RinexObsStream* getRinexObsStream(const SourceID& source);
 
    protected:
 
-         /// Struct to hold all the data for a observation file
-      struct ObsData
+         /// Epoch of a non-reference file waiting to be synchronized. As
+         /// with Synchronize, it is the first epoch of the file unless
+         /// 'keepLaterEpochs' is set.
+      struct PendingEpoch
       {
-         std::string obsFile;
-         
-         SourceID obsSource;
+         PendingEpoch() : valid(false) {}
 
-         Synchronize* pSynchro;
-         RinexObsStream* pObsStream;
+         gnssRinex gRin;
+         bool valid;
       };
 
-         /// Object to hold all the data of the network
-      std::list<ObsData> allStreamData;
+         /** Get the epoch of file 'index' synchronized with 'time'.
+          *
+          * @param index   Index of the file in 'streams'.
+          * @param time    Epoch of the reference data.
+          * @param gRin    Object to hold the synchronized data.
+          */
+      void synchronize( size_t index,
+                        const CommonTime& time,
+                        gnssRinex& gRin )
+         throw(SynchronizeException);
+
+         /// Decoder of all the files of the network
+      ParallelObsStreams streams;
+
+         /// Next epoch of every file, indexed as 'streams'
+      std::vector<PendingEpoch> pendingEpochs;
 
          /// Map to easy access the streams by 'SourceID'
       std::map<SourceID, RinexObsStream*> mapSourceStream;
-
-         /// Map to easy access the synchronize object
-      std::map<SourceID, Synchronize*> mapSourceSynchro;
      
          /// Reference Sourcee
       SourceID referenceSource;
@@ -162,6 +205,12 @@ namespace gpstk
          /// Flag indicate will throw 'SynchronizeException'
       bool synchronizeException;
 
+         /// Synchronization tolerance, in seconds
+      double tolerance;
+
+         /// Flag indicate later epochs are kept for the next reference epoch
+      bool keepLaterEpochs;
+
    private:
          // Do some clean operation 
       virtual void cleanUp();
@@ -0,0 +1,525 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+
+/**
+ * @file ParallelObsStreams.cpp
+ * Decode several RINEX observation files concurrently and merge their
+ * epochs in time order.
+ */
+
+#include <algorithm>
+#include "ParallelObsStreams.hpp"
+#include "RinexObsStream.hpp"
+#include "RinexObsHeader.hpp"
+#include "Rinex3ObsStream.hpp"
+#include "Rinex3ObsHeader.hpp"
+
+namespace gpstk
+{
+
+   ParallelObsStreams::ParallelObsStreams( unsigned threads,
+                                           unsigned qSize )
+      : numThreads(threads), queueSize(qSize>0 ? qSize : 1),
+        mappedRead(false), started(false), stopping(false),
+        held(0), wanted(0), nextPick(0)
+   {}
+
+
+   ParallelObsStreams::~ParallelObsStreams()
+   {
+      stop();
+
+      for(size_t i = 0; i < sources.size(); i++)
+      {
+         delete sources[i]->strm;
+         delete sources[i];
+      }
+
+   }  // End of destructor 'ParallelObsStreams::~ParallelObsStreams()'
+
+
+      // Add a RINEX observation file and read its header.
+   bool ParallelObsStreams::addRinexObsFile(const std::string& obsFile)
+   {
+      if(started)
+      {
+         return false;
+      }
+
+      Source* src = new Source;
+      src->fileName = obsFile;
+      src->strm = NULL;
+      src->head = 0;
+      src->count = 0;
+      src->busy = false;
+      src->finished = false;
+
+      try
+      {
+         Rinex3ObsStream* r3strm = new Rinex3ObsStream;
+         src->strm = r3strm;
+         r3strm->open(obsFile.c_str(), std::ios::in);
+         r3strm->exceptions(std::ios::failbit);
+         (*r3strm) >> r3strm->header;
+
+         src->version = r3strm->header.version;
+         src->source.type = SatIDsystem2SourceIDtype(r3strm->header.fileSysSat);
+         src->source.sourceName = r3strm->header.markerName;
+      }
+      catch(...)
+      {
+            // Some RINEX 2 headers are only readable by RinexObsStream
+         src->version = 0.0;
+      }
+
+      try
+      {
+         if(src->version < 3.0)
+         {
+               // RINEX 2 files are read as operator>>() reads them
+            delete src->strm;
+            src->strm = NULL;
+
+            RinexObsStream* r2strm = new RinexObsStream;
+            src->strm = r2strm;
+            r2strm->open(obsFile.c_str(), std::ios::in);
+            r2strm->exceptions(std::ios::failbit);
+            (*r2strm) >> r2strm->header;
+
+            src->version = r2strm->header.version;
+            src->source.type = SatIDsystem2SourceIDtype(r2strm->header.system);
+            src->source.sourceName = r2strm->header.markerName;
+         }
+
+            // Decoding errors end the file rather than throwing
+         src->strm->exceptions(std::ios::goodbit);
+      }
+      catch(...)
+      {
+            // Problem opening the file or reading its header
+            // Maybe it doesn't exist or you don't have proper read permissions
+         delete src->strm;
+         delete src;
+         return false;
+      }
+
+      sources.push_back(src);
+
+      return true;
+
+   }  // End of method 'ParallelObsStreams::addRinexObsFile()'
+
+
+   ParallelObsStreams& ParallelObsStreams::setNumThreads(unsigned threads)
+   {
+      if(!started)
+      {
+         numThreads = threads;
+      }
+
+      return (*this);
+   }
+
+
+   ParallelObsStreams& ParallelObsStreams::setQueueSize(unsigned qSize)
+   {
+      if(!started && qSize > 0)
+      {
+         queueSize = qSize;
+      }
+
+      return (*this);
+   }
+
+
+   ParallelObsStreams& ParallelObsStreams::setMappedRead(bool mapped)
+   {
+      if(!started)
+      {
+         mappedRead = mapped;
+      }
+
+      return (*this);
+   }
+
+
+   size_t ParallelObsStreams::indexOfSource(const SourceID& source) const
+   {
+      for(size_t i = 0; i < sources.size(); i++)
+      {
+         if(sources[i]->source == source)
+         {
+            return i;
+         }
+      }
+
+      return sources.size();
+   }
+
+
+   std::string ParallelObsStreams::getErrorText(size_t index) const
+   {
+      MutexLock lock(const_cast<Mutex&>(mutex));
+      return sources[index]->errorText;
+   }
+
+
+      // Get the next epoch of all files, in time order.
+   const gnssRinex* ParallelObsStreams::readEpoch(size_t& index)
+   {
+      MutexLock lock(mutex);
+
+      if(!started)
+      {
+         start();
+      }
+
+      release();
+
+      if(stopping)
+      {
+         return NULL;
+      }
+
+         // Files whose head record was taken need their next record
+         // on the heap before the earliest one can be chosen.
+      for(size_t i = 0; i < pending.size(); i++)
+      {
+         Source& src = *sources[pending[i]];
+
+         if( waitFor(pending[i]) )
+         {
+            HeapEntry entry;
+            src.queue[src.head].header.epoch.get(entry.day, entry.sod);
+            entry.index = pending[i];
+            heap.push_back(entry);
+            std::push_heap(heap.begin(), heap.end(), later);
+         }
+      }
+
+      pending.clear();
+
+      if(heap.empty())
+      {
+         return NULL;
+      }
+
+      std::pop_heap(heap.begin(), heap.end(), later);
+      index = heap.back().index;
+      heap.pop_back();
+
+      pending.push_back(index);
+      held = index;
+
+      return &sources[index]->queue[sources[index]->head];
+
+   }  // End of method 'ParallelObsStreams::readEpoch()'
+
+
+   bool ParallelObsStreams::readEpoch(gnssRinex& gRin)
+   {
+      size_t index;
+      const gnssRinex* epoch = readEpoch(index);
+
+      if(epoch == NULL)
+      {
+         return false;
+      }
+
+      gRin = *epoch;
+
+      return true;
+
+   }  // End of method 'ParallelObsStreams::readEpoch()'
+
+
+      // Get the next epoch of file 'index'.
+   const gnssRinex* ParallelObsStreams::readSourceEpoch(size_t index)
+   {
+      MutexLock lock(mutex);
+
+      if(!started)
+      {
+         start();
+      }
+
+      release();
+
+      if( stopping || !waitFor(index) )
+      {
+         return NULL;
+      }
+
+      held = index;
+
+      return &sources[index]->queue[sources[index]->head];
+
+   }  // End of method 'ParallelObsStreams::readSourceEpoch()'
+
+
+   bool ParallelObsStreams::readSourceEpoch(size_t index, gnssRinex& gRin)
+   {
+      const gnssRinex* epoch = readSourceEpoch(index);
+
+      if(epoch == NULL)
+      {
+         return false;
+      }
+
+      gRin = *epoch;
+
+      return true;
+
+   }  // End of method 'ParallelObsStreams::readSourceEpoch()'
+
+
+   void ParallelObsStreams::stop()
+   {
+      {
+         MutexLock lock(mutex);
+         stopping = true;
+         spaceReady.broadcast();
+      }
+
+      threads.join();
+
+   }  // End of method 'ParallelObsStreams::stop()'
+
+
+   bool ParallelObsStreams::later(const HeapEntry& l, const HeapEntry& r)
+   {
+      if(l.day != r.day)
+      {
+         return l.day > r.day;
+      }
+
+      if(l.sod != r.sod)
+      {
+         return l.sod > r.sod;
+      }
+
+      return l.index > r.index;
+   }
+
+
+   void ParallelObsStreams::start()
+   {
+      started = true;
+      held = sources.size();
+      wanted = sources.size();
+
+      for(size_t i = 0; i < sources.size(); i++)
+      {
+         sources[i]->queue.resize(queueSize);
+
+         if(mappedRead && sources[i]->version >= 3.0)
+         {
+            static_cast<Rinex3ObsStream*>(sources[i]->strm)->setMappedRead();
+         }
+
+         pending.push_back(i);
+      }
+
+      heap.reserve(sources.size());
+
+      size_t n = std::min<size_t>(numThreads, sources.size());
+
+         // If no thread can be started, waitFor() decodes instead
+      for(size_t i = 0; i < n; i++)
+      {
+         if( !threads.start(workerMain, this) )
+         {
+            break;
+         }
+      }
+
+   }  // End of method 'ParallelObsStreams::start()'
+
+
+   void ParallelObsStreams::release()
+   {
+      if(held == sources.size())
+      {
+         return;
+      }
+
+      Source& src = *sources[held];
+      src.head = (src.head + 1) % src.queue.size();
+      src.count--;
+      held = sources.size();
+
+      spaceReady.signal();
+
+   }  // End of method 'ParallelObsStreams::release()'
+
+
+   bool ParallelObsStreams::waitFor(size_t index)
+   {
+      Source& src = *sources[index];
+
+      while( src.count == 0 && !src.finished )
+      {
+         if(threads.size() == 0)
+         {
+            if( decode(src, src.queue[src.head], src.errorText) )
+            {
+               src.count++;
+            }
+            else
+            {
+               src.finished = true;
+            }
+         }
+         else
+         {
+            wanted = index;
+            spaceReady.broadcast();
+            dataReady.wait(mutex);
+         }
+      }
+
+      wanted = sources.size();
+
+      return (src.count > 0);
+
+   }  // End of method 'ParallelObsStreams::waitFor()'
+
+
+   bool ParallelObsStreams::decode( Source& src,
+                                    gnssRinex& gRin,
+                                    std::string& error )
+   {
+      (*src.strm) >> gRin;
+
+      if(*src.strm)
+      {
+         return true;
+      }
+
+      if(!src.strm->eof())
+      {
+         error = src.strm->mostRecentException.getText();
+      }
+
+      return false;
+
+   }  // End of method 'ParallelObsStreams::decode()'
+
+
+   void ParallelObsStreams::workerMain(void *arg)
+   {
+      static_cast<ParallelObsStreams*>(arg)->work();
+   }
+
+
+   void ParallelObsStreams::work()
+   {
+      mutex.lock();
+
+      while(!stopping)
+      {
+         size_t index = pickSource();
+
+         if(index == sources.size())
+         {
+            spaceReady.wait(mutex);
+            continue;
+         }
+
+         Source& src = *sources[index];
+         src.busy = true;
+
+            // Fill this file's queue.  The slot at the tail is not
+            // visible to the reader until count is incremented.
+         while( !stopping && !src.finished && src.count < src.queue.size() )
+         {
+            gnssRinex& gRin =
+               src.queue[(src.head + src.count) % src.queue.size()];
+            std::string error;
+
+            mutex.unlock();
+            bool ok = decode(src, gRin, error);
+            mutex.lock();
+
+            if(ok)
+            {
+               src.count++;
+            }
+            else
+            {
+               src.finished = true;
+               src.errorText = error;
+            }
+
+            if(wanted == index)
+            {
+               dataReady.signal();
+            }
+         }
+
+         src.busy = false;
+      }
+
+      mutex.unlock();
+
+   }  // End of method 'ParallelObsStreams::work()'
+
+
+   size_t ParallelObsStreams::pickSource()
+   {
+      const size_t n = sources.size();
+
+      for(size_t k = 0; k <= n; k++)
+      {
+            // The file the reader is waiting on comes first
+         size_t i = (k == 0) ? wanted : (nextPick + k - 1) % n;
+
+         if( i < n &&
+             !sources[i]->busy &&
+             !sources[i]->finished &&
+             sources[i]->count < sources[i]->queue.size() )
+         {
+            nextPick = (i + 1) % n;
+            return i;
+         }
+      }
+
+      return n;
+
+   }  // End of method 'ParallelObsStreams::pickSource()'
+
+}  // End of namespace gpstk
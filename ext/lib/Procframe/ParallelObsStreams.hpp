@@ -0,0 +1,293 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+
+/**
+ * @file ParallelObsStreams.hpp
+ * Decode several RINEX observation files concurrently and merge their
+ * epochs in time order.
+ */
+
+#ifndef GPSTK_PARALLEL_OBS_STREAMS_HPP
+#define GPSTK_PARALLEL_OBS_STREAMS_HPP
+
+#include <string>
+#include <vector>
+#include "FFStream.hpp"
+#include "DataStructures.hpp"
+#include "ThreadUtils.hpp"
+
+namespace gpstk
+{
+
+      /// @ingroup DataStructures
+      //@{
+
+      /** This class decodes a set of RINEX observation files on a pool
+       * of threads and delivers their epochs as one stream of gnssRinex
+       * objects, ordered by time and tagged with the SourceID of the
+       * file each came from.
+       *
+       * Every file is read by its own stream: a Rinex3ObsStream for
+       * RINEX 3 files and a RinexObsStream for RINEX 2 files, so each
+       * epoch holds exactly what operator>>(std::istream&, gnssRinex&)
+       * would give for that file.  Decoded epochs are held in a bounded
+       * queue per file; decoder threads stop reading a file when its
+       * queue is full, so memory use does not depend on the length of
+       * the files.  Epochs with equal time stamps are delivered in the
+       * order the files were added.
+       *
+       * A typical way to use this class follows:
+       *
+       * @code
+       *    ParallelObsStreams streams;
+       *
+       *    streams.addRinexObsFile("acor1480.08o");
+       *    streams.addRinexObsFile("madr1480.08o");
+       *
+       *    gnssRinex gRin;
+       *    while( streams.readEpoch(gRin) )
+       *    {
+       *       // gRin.header.source identifies the station
+       *    }
+       * @endcode
+       *
+       * The epochs of a single file may also be read one at a time
+       * with readSourceEpoch(); the two ways of reading must not be
+       * mixed on one object.
+       *
+       * Files are added, and options set, before the first epoch is
+       * read.  Records are decoded by numThreads threads which are
+       * started by the first read and stopped by stop() or the
+       * destructor.  With zero threads, or where threads are not
+       * available, records are decoded on the reading thread.  The
+       * reading methods must all be called from one thread.
+       *
+       * A file that cannot be decoded past some record is treated as
+       * ending at that record; getErrorText() reports why.
+       *
+       * @sa NetworkObsStreams, which uses this class to synchronize
+       * the files of a network.
+       */
+   class ParallelObsStreams
+   {
+   public:
+         /** Common constructor.
+          *
+          * @param numThreads Number of decoder threads; zero decodes
+          *                   on the reading thread.
+          * @param queueSize  Number of decoded records buffered for
+          *                   each file.
+          */
+      ParallelObsStreams( unsigned numThreads = numProcessors(),
+                          unsigned queueSize = 16 );
+
+         /// Destructor, stops the decoder threads.
+      virtual ~ParallelObsStreams();
+
+         /** Add a RINEX observation file and read its header.
+          *
+          * @param obsFile    RINEX observation file name.
+          * @return false if the file could not be opened or its
+          *         header could not be read.
+          */
+      bool addRinexObsFile(const std::string& obsFile);
+
+         /// Set the number of decoder threads, before the first read.
+      ParallelObsStreams& setNumThreads(unsigned numThreads);
+
+         /// Set the number of records buffered per file, before the
+         /// first read.
+      ParallelObsStreams& setQueueSize(unsigned queueSize);
+
+         /// Read RINEX 3 files through Rinex3ObsStream::setMappedRead().
+      ParallelObsStreams& setMappedRead(bool mapped = true);
+
+         /// Number of files added.
+      size_t size() const
+      { return sources.size(); }
+
+         /// Name of file \a index.
+      const std::string& getFileName(size_t index) const
+      { return sources[index]->fileName; }
+
+         /// SourceID of file \a index.
+      const SourceID& getSource(size_t index) const
+      { return sources[index]->source; }
+
+         /// RINEX version of file \a index.
+      double getVersion(size_t index) const
+      { return sources[index]->version; }
+
+         /// Index of the file with SourceID \a source, or size() if
+         /// there is none.
+      size_t indexOfSource(const SourceID& source) const;
+
+         /// Text of the error that ended file \a index, or an empty
+         /// string if it was read to its end.
+      std::string getErrorText(size_t index) const;
+
+         /** Get the next epoch of all files, in time order.
+          *
+          * @param index      Set to the index of the file the epoch
+          *                   was read from.
+          * @return the epoch, or NULL when all files are exhausted.
+          *         The epoch remains valid until the next read.
+          */
+      const gnssRinex* readEpoch(size_t& index);
+
+         /** Copy the next epoch of all files, in time order.
+          *
+          * @return false when all files are exhausted.
+          */
+      bool readEpoch(gnssRinex& gRin);
+
+         /** Get the next epoch of file \a index.
+          *
+          * @return the epoch, or NULL at the end of the file.  The
+          *         epoch remains valid until the next read.
+          */
+      const gnssRinex* readSourceEpoch(size_t index);
+
+         /** Copy the next epoch of file \a index.
+          *
+          * @return false at the end of the file.
+          */
+      bool readSourceEpoch(size_t index, gnssRinex& gRin);
+
+         /// Stop the decoder threads.  No more epochs can be read.
+      void stop();
+
+   private:
+
+         /// Decoding state of one file.
+      struct Source
+      {
+         std::string fileName;
+         SourceID source;
+         double version;
+            /// RinexObsStream or Rinex3ObsStream, header already read
+         FFStream* strm;
+
+            /// Ring buffer of decoded epochs.  The epoch at head is
+            /// the oldest; count epochs are valid.
+         std::vector<gnssRinex> queue;
+         size_t head;
+         size_t count;
+
+            /// A decoder thread is reading this file.
+         bool busy;
+            /// No more records will be decoded.
+         bool finished;
+         std::string errorText;
+      };
+
+         /// Entry of the heap used for the time-ordered merge.
+      struct HeapEntry
+      {
+         long day;
+         double sod;
+         size_t index;
+      };
+
+         /// Heap order: earliest time, then lowest index, on top.
+      static bool later(const HeapEntry& l, const HeapEntry& r);
+
+         /// Allocate the queues and start the decoder threads.
+      void start();
+
+         /// Give back the record returned by the last read.
+      void release();
+
+         /** Wait until file \a index has a record or is finished.
+          * Must be called with mutex held.
+          * @return true if a record is available. */
+      bool waitFor(size_t index);
+
+         /// Decode the next epoch of \a src into the free slot at
+         /// the tail of its queue.  Called without mutex held.
+      bool decode(Source& src, gnssRinex& gRin, std::string& error);
+
+         /// Thread entry point, calls work().
+      static void workerMain(void *arg);
+
+         /// Decoder thread loop.
+      void work();
+
+         /// Choose an idle file with room in its queue, or return
+         /// sources.size().  Must be called with mutex held.
+      size_t pickSource();
+
+      std::vector<Source*> sources;
+
+         /// Merge heap of files with a record at the head of their
+         /// queue, and the file whose head record is still to be
+         /// pushed onto it.
+      std::vector<HeapEntry> heap;
+      std::vector<size_t> pending;
+
+      unsigned numThreads;
+      unsigned queueSize;
+      bool mappedRead;
+
+      bool started;
+      bool stopping;
+         /// File whose record was returned by the last read, or
+         /// sources.size() if none is held.
+      size_t held;
+         /// File the reader is waiting on, or sources.size().
+      size_t wanted;
+         /// Where pickSource() starts looking.
+      size_t nextPick;
+
+      Mutex mutex;
+         /// Signalled when a record is decoded or a file finishes.
+      Condition dataReady;
+         /// Signalled when queue space is freed or on stop().
+      Condition spaceReady;
+      ThreadGroup threads;
+
+         // not copyable
+      ParallelObsStreams(const ParallelObsStreams&);
+      ParallelObsStreams& operator=(const ParallelObsStreams&);
+
+   }; // End of class 'ParallelObsStreams'
+
+      //@}
+
+}  // End of namespace gpstk
+
+#endif   // GPSTK_PARALLEL_OBS_STREAMS_HPP
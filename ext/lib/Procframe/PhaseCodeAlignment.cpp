@@ -252,6 +252,125 @@ namespace gpstk
 
 
 
+      /* Returns a satTypeValueTable object, adding the new data generated
+       *  when calling this object.
+       *
+       * @param epoch     Time of observations.
+       * @param gData     Data object holding the data.
+       */
+   satTypeValueTable& PhaseCodeAlignment::Process( const CommonTime& epoch,
+                                                   satTypeValueTable& gData )
+      throw(ProcessingException)
+   {
+
+      try
+      {
+
+         SatIDSet satRejectedSet;
+
+            // Satellite arcs or cycle slip flags, as configured
+         const int watchCol( gData.typeIndex( useSatArcs ? TypeID::satArc
+                                                         : watchCSFlag ) );
+         const int codeCol( gData.typeIndex(codeType) );
+         const size_t phaseCol( gData.insertType(phaseType) );
+
+            // Loop through all the satellites
+         for( size_t row = 0; row < gData.numSats(); ++row )
+         {
+
+            const SatID& sat( gData.getSat(row) );
+
+               // If satellite arc or flag is missing, then schedule this
+               // satellite for removal
+            if( watchCol < 0 || !gData.hasValue(row, watchCol) )
+            {
+               satRejectedSet.insert( sat );
+               continue;
+            }
+
+               // Check if satellite currently has entries. If it doesn't
+               // have one, insert it
+            alignData& aData( svData[sat] );
+
+               // Place to store if there was a cycle slip. False by default
+            bool csflag(false);
+
+            if(useSatArcs)
+            {
+
+               const double arcN( gData.get(row, watchCol) );
+
+                  // Check if satellite arc has changed
+               if( aData.arcNumber != arcN )
+               {
+                     // Set flag
+                  csflag = true;
+
+                     // Update satellite arc information
+                  aData.arcNumber = arcN;
+               }
+
+            }
+            else if( gData.get(row, watchCol) > 0.0 )
+            {
+                  // There was a cycle slip
+               csflag = true;
+            }
+
+               // If there was an arc change or cycle slip, let's
+               // compute the new offset
+            if(csflag)
+            {
+
+                  // Both measurements are required, as with satTypeValueMap
+               if( codeCol < 0 || !gData.hasValue(row, codeCol) ||
+                   !gData.hasValue(row, phaseCol) )
+               {
+                  GPSTK_THROW(TypeIDNotFound("TypeID not found in table"));
+               }
+
+                  // Compute difference between code and phase measurements
+               double diff( gData.get(row, codeCol)
+                            - gData.get(row, phaseCol) );
+
+                  // Convert 'diff' to cycles
+               diff = diff/phaseWavelength;
+
+                  // Convert 'diff' to an INTEGER number of cycles
+               diff = std::floor(diff);
+
+                  // The new offset is the INTEGER number of cycles, in meters
+               aData.offset = diff * phaseWavelength;
+
+            }
+
+               // Let's align the phase measurement using the
+               // corresponding offset
+            gData.set( row, phaseCol,
+                       gData.get(row, phaseCol) + aData.offset );
+
+         }
+
+            // Remove satellites with missing data
+         gData.removeSatID(satRejectedSet);
+
+         return gData;
+
+      }
+      catch(Exception& u)
+      {
+            // Throw an exception if something unexpected happens
+         ProcessingException e( getClassName() + ":"
+                                + u.what() );
+
+         GPSTK_THROW(e);
+
+      }
+
+   }  // End of 'PhaseCodeAlignment::Process()'
+
+
+
       /* Returns a gnnsSatTypeValue object, adding the new data generated
        *  when calling this object.
        *
@@ -45,6 +45,7 @@
 
 #include "StringUtils.hpp"
 #include "DataStructures.hpp"
+#include "SatTypeValueTable.hpp"
 
 
 namespace gpstk
@@ -108,6 +109,29 @@ namespace gpstk
       virtual gnssRinex& Process(gnssRinex& gData) = 0;
 
 
+         /** Method to process a gnssRinexTable object. By default, the
+          *  data go through a gnssRinex copy; classes that work on the
+          *  table directly override it.
+          *
+          * @param gData    Data object holding the data.
+          */
+      virtual gnssRinexTable& Process(gnssRinexTable& gData)
+      {
+         gnssRinex gRin;
+         Process( gData.exportTo(gRin) );
+         gData.assign(gRin);
+         return gData;
+      }
+
+
+         /** Returns whether Process(gnssRinexTable&) works on the table
+          *  directly. Classes overriding it must override this method too,
+          *  so that ProcessingList does not copy the data for them.
+          */
+      virtual bool isTableNative() const
+      { return false; };
+
+
          /// Abstract method. It returns a string identifying the class the
          /// object belongs to.
       virtual std::string getClassName(void) const = 0;
@@ -133,6 +157,12 @@ namespace gpstk
    { procClass.Process(gData); return gData; }
 
 
+      /// Input operator from gnssRinexTable to ProcessingClass.
+   inline gnssRinexTable& operator>>( gnssRinexTable& gData,
+                                      ProcessingClass& procClass )
+   { procClass.Process(gData); return gData; }
+
+
    //@}
 
 }  // End of namespace gpstk
@@ -115,4 +115,56 @@ namespace gpstk
    }  // End of method 'ProcessingList::Process()'
 
 
+
+      /* Processing method. It returns a gnnsRinexTable object. Each
+       * element works on the table directly if it is able to. Runs of
+       * consecutive elements that are not able to share a single
+       * gnssRinex copy of the data.
+       *
+       * @param gData    Data object holding the data.
+       */
+   gnssRinexTable& ProcessingList::Process(gnssRinexTable& gData)
+   {
+
+      try
+      {
+
+         std::list<ProcessingClass*>::const_iterator pos( proclist.begin() );
+         while (pos != proclist.end())
+         {
+
+            if ( (*pos)->isTableNative() )
+            {
+               (*pos)->Process(gData);
+               ++pos;
+               continue;
+            }
+
+               // Copy the data once for all the following elements that
+               // need a gnssRinex, and bring the results back afterwards
+            gData.exportTo(tableCopy);
+            while ( pos != proclist.end() && !(*pos)->isTableNative() )
+            {
+               (*pos)->Process(tableCopy);
+               ++pos;
+            }
+            gData.assign(tableCopy);
+
+         }
+
+         return gData;
+
+      }
+      catch(...)
+      {
+
+            // This method must throw the same exceptions it may get from
+            // the 'ProcessingList' elements, without altering them.
+         throw;
+
+      }
+
+   }  // End of method 'ProcessingList::Process()'
+
+
 }  // End of namespace gpstk
@@ -114,6 +114,21 @@ namespace gpstk
       virtual gnssRinex& Process(gnssRinex& gData);
 
 
+         /** Processing method. It returns a gnnsRinexTable object. Each
+          *  element works on the table directly if it is able to. Runs of
+          *  consecutive elements that are not able to share a single
+          *  gnssRinex copy of the data.
+          *
+          * @param gData    Data object holding the data.
+          */
+      virtual gnssRinexTable& Process(gnssRinexTable& gData);
+
+
+         /// ProcessingList works on tables directly.
+      virtual bool isTableNative() const
+      { return true; };
+
+
          /// Returns a pointer to the first element.
       virtual ProcessingClass* front(void)
       { return (proclist.front()); };
@@ -180,6 +195,11 @@ namespace gpstk
       std::list<ProcessingClass*> proclist;
 
 
+         /// gnssRinex copy used by Process(gnssRinexTable&), kept between
+         /// epochs so that exporting the table reuses its map nodes.
+      gnssRinex tableCopy;
+
+
    }; // End of class 'ProcessingList'
 
       //@}
@@ -0,0 +1,435 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S.
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software.
+//
+//Pursuant to DoD Directive 523024
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+/**
+ * @file RecordStore.cpp
+ * Byte records kept in large memory chunks, optionally spilled to a
+ * temporary file.
+ */
+
+   // 64-bit off_t for fseeko() on 32-bit POSIX systems
+#ifndef _FILE_OFFSET_BITS
+#define _FILE_OFFSET_BITS 64
+#endif
+
+#include "RecordStore.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+
+namespace gpstk
+{
+
+   RecordStore::RecordStore( size_t size )
+      : chunkSize(size), spillThreshold(std::numeric_limits<size_t>::max()),
+        recordBytes(0), spill(0), spillEnd(0)
+   {
+      if( chunkSize == 0 )
+      {
+         chunkSize = 1;
+      }
+   }
+
+
+   RecordStore::RecordStore( const RecordStore& right )
+      : chunkSize(right.chunkSize), spillThreshold(right.spillThreshold),
+        spillDir(right.spillDir), recordBytes(0), spill(0), spillEnd(0)
+   {
+      copyRecords(right);
+   }
+
+
+   RecordStore& RecordStore::operator=( const RecordStore& right )
+   {
+      if( this != &right )
+      {
+         clear();
+         chunkSize = right.chunkSize;
+         spillThreshold = right.spillThreshold;
+         spillDir = right.spillDir;
+         copyRecords(right);
+      }
+
+      return (*this);
+   }
+
+
+   RecordStore::~RecordStore()
+   {
+      clear();
+   }
+
+
+      // Copy the records of 'right' into this (empty) object.
+   void RecordStore::copyRecords( const RecordStore& right )
+   {
+      std::vector<char> record;
+      for( size_t i = 0; i < right.records.size(); ++i )
+      {
+         if( right.records[i].chunk == -2 )
+         {
+            records.push_back( right.records[i] );
+         }
+         else
+         {
+            right.get(i, record);
+            push_back(record);
+         }
+      }
+   }
+
+
+      // Open the temporary file.
+   void RecordStore::openSpill(void)
+      throw(InvalidRequest)
+   {
+      std::string dir(spillDir);
+      if( dir.empty() )
+      {
+         const char* env( std::getenv("TMPDIR") );
+#ifdef _WIN32
+         if( env == 0 ) env = std::getenv("TEMP");
+         dir = ( env == 0 ? "." : env );
+#else
+         dir = ( env == 0 ? "/tmp" : env );
+#endif
+      }
+
+#ifdef _WIN32
+         // GetTempFileName() creates the file with a new unique name in
+         // dir, and fails rather than reuse an existing one
+      char name[MAX_PATH];
+      if( GetTempFileNameA(dir.c_str(), "gps", 0, name) != 0 )
+      {
+         spillName = name;
+         spill = std::fopen(name, "w+b");
+         if( spill == 0 )
+            std::remove( spillName.c_str() );
+      }
+#else
+      std::vector<char> name( dir.begin(), dir.end() );
+      const char suffix[] = "/gpstkRecordStoreXXXXXX";
+      name.insert( name.end(), suffix, suffix + sizeof(suffix) );
+      int fd( mkstemp(&name[0]) );
+      if( fd >= 0 )
+      {
+         spillName = &name[0];
+         spill = fdopen(fd, "w+b");
+         if( spill == 0 )
+         {
+            ::close(fd);
+            std::remove( spillName.c_str() );
+         }
+      }
+#endif
+
+      if( spill == 0 )
+      {
+         InvalidRequest e("Unable to open a temporary file in " + dir);
+         GPSTK_THROW(e);
+      }
+   }
+
+
+      // Move to 'offset' in the temporary file. std::fseek() takes a long,
+      // which is 32 bits on Windows, so the 64-bit variants are used.
+   bool RecordStore::seekSpill( size_t offset ) const
+   {
+#ifdef _WIN32
+      return ( _fseeki64( spill, __int64(offset), SEEK_SET ) == 0 );
+#else
+      return ( fseeko( spill, off_t(offset), SEEK_SET ) == 0 );
+#endif
+   }
+
+
+      // Store 'data' in a new location.
+   RecordStore::Location RecordStore::store( const char* data, size_t length )
+      throw(InvalidRequest)
+   {
+      Location loc;
+      loc.length = length;
+
+      if( recordBytes + length > spillThreshold ||
+          recordBytes + length < recordBytes )
+      {
+         if( spill == 0 )
+         {
+            openSpill();
+         }
+
+         spillMap.close();
+         if( !seekSpill(spillEnd) ||
+             std::fwrite( data, 1, length, spill ) != length )
+         {
+            InvalidRequest e("Unable to write to temporary file "
+                             + spillName);
+            GPSTK_THROW(e);
+         }
+
+         loc.chunk = -1;
+         loc.offset = spillEnd;
+         spillEnd += length;
+
+         return loc;
+      }
+
+         // Start a new chunk if the record does not fit in the last one
+      if( chunks.empty() ||
+          chunks.back().empty() ||
+          chunkUsed.back() + length > chunks.back().size() )
+      {
+            // The last chunk is no longer filled; free it if it is unused
+         if( !chunks.empty() && chunkLive.back() == 0 )
+         {
+            recordBytes -= chunkUsed.back();
+            chunkUsed.back() = 0;
+            std::vector<char>().swap( chunks.back() );
+         }
+
+         chunks.push_back( std::vector<char>() );
+         chunks.back().resize( std::max(chunkSize, length) );
+         chunkUsed.push_back(0);
+         chunkLive.push_back(0);
+      }
+
+      loc.chunk = int(chunks.size()) - 1;
+      loc.offset = chunkUsed.back();
+
+      if( length > 0 )
+      {
+         std::memcpy( &chunks.back()[loc.offset], data, length );
+      }
+
+      chunkUsed.back() += length;
+      ++chunkLive.back();
+      recordBytes += length;
+
+      return loc;
+   }
+
+
+      /* Append a record.
+       *
+       * @param data    Record contents.
+       * @param length  Number of bytes of the record.
+       *
+       * @return Index of the new record.
+       */
+   size_t RecordStore::push_back( const char* data, size_t length )
+      throw(InvalidRequest)
+   {
+      records.push_back( store(data, length) );
+      return records.size() - 1;
+   }
+
+
+      /* Read a record.
+       *
+       * @param index   Index of the record.
+       * @param record  Vector that will hold the record contents.
+       */
+   void RecordStore::get( size_t index, std::vector<char>& record ) const
+      throw(InvalidRequest)
+   {
+      if( index >= records.size() || records[index].chunk == -2 )
+      {
+         InvalidRequest e("Record not found in RecordStore.");
+         GPSTK_THROW(e);
+      }
+
+      const Location& loc( records[index] );
+      record.resize( loc.length );
+      if( loc.length == 0 )
+      {
+         return;
+      }
+
+      if( loc.chunk >= 0 )
+      {
+         std::memcpy( &record[0], &chunks[loc.chunk][loc.offset], loc.length );
+      }
+      else if( spillMap.isOpen() && loc.offset + loc.length <= spillMap.size() )
+      {
+         std::memcpy( &record[0], spillMap.data() + loc.offset, loc.length );
+      }
+      else if( !seekSpill(loc.offset) ||
+               std::fread( &record[0], 1, loc.length, spill ) != loc.length )
+      {
+         InvalidRequest e("Unable to read from temporary file " + spillName);
+         GPSTK_THROW(e);
+      }
+   }
+
+
+      /* Rewrite a record. It is rewritten in place if it does not
+       * grow, and moved to the end of the store otherwise.
+       *
+       * @param index   Index of the record.
+       * @param data    New record contents.
+       * @param length  Number of bytes of the new record.
+       */
+   void RecordStore::set( size_t index, const char* data, size_t length )
+      throw(InvalidRequest)
+   {
+      if( index >= records.size() || records[index].chunk == -2 )
+      {
+         InvalidRequest e("Record not found in RecordStore.");
+         GPSTK_THROW(e);
+      }
+
+      Location& loc( records[index] );
+      if( length > loc.length )
+      {
+         release(index);
+         records[index] = store(data, length);
+         return;
+      }
+
+      if( loc.chunk >= 0 )
+      {
+         if( length > 0 )
+         {
+            std::memcpy( &chunks[loc.chunk][loc.offset], data, length );
+         }
+      }
+      else
+      {
+         spillMap.close();
+         if( !seekSpill(loc.offset) ||
+             std::fwrite( data, 1, length, spill ) != length )
+         {
+            InvalidRequest e("Unable to write to temporary file "
+                             + spillName);
+            GPSTK_THROW(e);
+         }
+      }
+
+      loc.length = length;
+   }
+
+
+      /* Release a record. Its index remains valid, but reading it
+       * throws. Memory chunks are freed once all their records are
+       * released.
+       */
+   void RecordStore::release( size_t index )
+      throw(InvalidRequest)
+   {
+      if( index >= records.size() )
+      {
+         InvalidRequest e("Record not found in RecordStore.");
+         GPSTK_THROW(e);
+      }
+
+      Location& loc( records[index] );
+      if( loc.chunk >= 0 )
+      {
+         if( --chunkLive[loc.chunk] == 0 &&
+             loc.chunk != int(chunks.size()) - 1 )
+         {
+               // Give the memory back
+            recordBytes -= chunkUsed[loc.chunk];
+            chunkUsed[loc.chunk] = 0;
+            std::vector<char>().swap( chunks[loc.chunk] );
+         }
+      }
+
+      loc.chunk = -2;
+      loc.length = 0;
+   }
+
+
+      // Read spilled records through a memory mapping of the temporary
+      // file, until the next write to it.
+   void RecordStore::mapSpill(void)
+   {
+      if( spill == 0 || spillMap.isOpen() )
+      {
+         return;
+      }
+
+      std::fflush(spill);
+      spillMap.open(spillName);
+   }
+
+
+      // Remove all records and the temporary file.
+   void RecordStore::clear(void)
+   {
+      records.clear();
+      chunks.clear();
+      chunkUsed.clear();
+      chunkLive.clear();
+      recordBytes = 0;
+
+      spillMap.close();
+      if( spill != 0 )
+      {
+         std::fclose(spill);
+         std::remove( spillName.c_str() );
+         spill = 0;
+         spillName.clear();
+      }
+      spillEnd = 0;
+   }
+
+
+      // Bytes currently allocated in memory chunks.
+   size_t RecordStore::memoryBytes(void) const
+   {
+      size_t bytes(0);
+      for( size_t i = 0; i < chunks.size(); ++i )
+      {
+         bytes += chunks[i].size();
+      }
+
+      return bytes;
+   }
+
+}  // End of namespace gpstk
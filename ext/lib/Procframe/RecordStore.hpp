@@ -0,0 +1,291 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S.
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software.
+//
+//Pursuant to DoD Directive 523024
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+/**
+ * @file RecordStore.hpp
+ * Byte records kept in large memory chunks, optionally spilled to a
+ * temporary file.
+ */
+
+#ifndef GPSTK_RECORDSTORE_HPP
+#define GPSTK_RECORDSTORE_HPP
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "Exception.hpp"
+#include "MemoryMappedFile.hpp"
+
+
+namespace gpstk
+{
+
+      /// @ingroup DataStructures
+      //@{
+
+
+      /** This class stores a sequence of byte records, indexed by their
+       *  insertion order.
+       *
+       * Records are packed one after another into memory chunks of a
+       * fixed size, instead of being allocated one by one. Once the
+       * records held in memory reach the spill threshold (unlimited by
+       * default), further records are written to a temporary file, which
+       * is removed when the object is destroyed or cleared.
+       *
+       * A record may be rewritten in place if it does not grow; a longer
+       * record is moved to the end of the store. Released records give
+       * back their memory chunk once all the records in it are released.
+       *
+       * Spilled records are read with stdio by default. Call mapSpill()
+       * before a long read-only pass (e.g., backwards through the store)
+       * to read them through a memory mapping of the file instead; the
+       * next write to the file drops that mapping.
+       *
+       * @code
+       *   RecordStore store;
+       *   store.setSpillThreshold(256 * 1024 * 1024);
+       *
+       *   size_t i( store.push_back(buffer) );
+       *   ...
+       *   store.get(i, buffer);
+       * @endcode
+       */
+   class RecordStore
+   {
+   public:
+
+         /// Default constructor.
+         /// @param chunkSize    Size, in bytes, of the memory chunks.
+      RecordStore( size_t chunkSize = 1048576 );
+
+
+         /// Copy constructor. Spilled records go to a new temporary file.
+      RecordStore( const RecordStore& right );
+
+
+         /// Assignment operator.
+      RecordStore& operator=( const RecordStore& right );
+
+
+         /// Destructor. Removes the temporary file, if any.
+      virtual ~RecordStore();
+
+
+         /** Set the number of bytes of records kept in memory, beyond
+          *  which new records are written to a temporary file.
+          *
+          * The threshold counts the bytes of the records, not the
+          * memory chunks that hold them; memoryBytes() may exceed it by
+          * up to one chunk.
+          *
+          * @param bytes    Memory threshold. Zero spills every record.
+          * @param dir      Directory of the temporary file. If empty, the
+          *                 TMPDIR environment variable or the system
+          *                 default is used.
+          */
+      virtual RecordStore& setSpillThreshold( size_t bytes,
+                                              const std::string& dir = "" )
+      { spillThreshold = bytes; spillDir = dir; return (*this); };
+
+
+         /// Get the number of bytes of records kept in memory before
+         /// spilling to a temporary file.
+      virtual size_t getSpillThreshold(void) const
+      { return spillThreshold; };
+
+
+         /** Append a record.
+          *
+          * @param data    Record contents.
+          * @param length  Number of bytes of the record.
+          *
+          * @return Index of the new record.
+          */
+      virtual size_t push_back( const char* data, size_t length )
+         throw(InvalidRequest);
+
+
+         /// Append a record.
+      virtual size_t push_back( const std::vector<char>& record )
+         throw(InvalidRequest)
+      { return push_back( (record.empty() ? 0 : &record[0]), record.size() ); };
+
+
+         /** Read a record.
+          *
+          * @param index   Index of the record.
+          * @param record  Vector that will hold the record contents.
+          */
+      virtual void get( size_t index, std::vector<char>& record ) const
+         throw(InvalidRequest);
+
+
+         /** Rewrite a record. It is rewritten in place if it does not
+          *  grow, and moved to the end of the store otherwise.
+          *
+          * @param index   Index of the record.
+          * @param data    New record contents.
+          * @param length  Number of bytes of the new record.
+          */
+      virtual void set( size_t index, const char* data, size_t length )
+         throw(InvalidRequest);
+
+
+         /// Rewrite a record.
+      virtual void set( size_t index, const std::vector<char>& record )
+         throw(InvalidRequest)
+      { set( index, (record.empty() ? 0 : &record[0]), record.size() ); };
+
+
+         /** Release a record. Its index remains valid, but reading it
+          *  throws. Memory chunks are freed once all their records are
+          *  released.
+          */
+      virtual void release( size_t index )
+         throw(InvalidRequest);
+
+
+         /// Read spilled records through a memory mapping of the
+         /// temporary file, until the next write to it.
+      virtual void mapSpill(void);
+
+
+         /// Remove all records and the temporary file.
+      virtual void clear(void);
+
+
+         /// Number of records, including released ones.
+      virtual size_t size(void) const
+      { return records.size(); };
+
+
+         /// Bytes currently allocated in memory chunks.
+      virtual size_t memoryBytes(void) const;
+
+
+         /// Bytes written to the temporary file.
+      virtual size_t spilledBytes(void) const
+      { return spillEnd; };
+
+
+   private:
+
+
+         /// Location of a record: chunk, or -1 if it is in the temporary
+         /// file, or -2 if it was released; offset and length in bytes.
+      struct Location
+      {
+         int chunk;
+         size_t offset;
+         size_t length;
+      };
+
+
+         /// Copy the records of 'right' into this (empty) object.
+      void copyRecords( const RecordStore& right );
+
+
+         /// Store 'data' in a new location.
+      Location store( const char* data, size_t length )
+         throw(InvalidRequest);
+
+
+         /// Open the temporary file.
+      void openSpill(void)
+         throw(InvalidRequest);
+
+
+         /// Move to 'offset' in the temporary file, with 64-bit offsets
+         /// on every platform. Returns false on failure.
+      bool seekSpill( size_t offset ) const;
+
+
+         /// Size of the memory chunks.
+      size_t chunkSize;
+
+
+         /// Bytes of records kept in memory before spilling.
+      size_t spillThreshold;
+
+
+         /// Directory of the temporary file.
+      std::string spillDir;
+
+
+         /// Location of each record.
+      std::vector<Location> records;
+
+
+         /// Memory chunks.
+      std::vector< std::vector<char> > chunks;
+
+
+         /// Bytes used in each memory chunk.
+      std::vector<size_t> chunkUsed;
+
+
+         /// Records not released in each memory chunk.
+      std::vector<size_t> chunkLive;
+
+
+         /// Bytes of the records held in memory chunks, which is what the
+         /// spill threshold is compared with. The chunks allocated for
+         /// them are reported by memoryBytes().
+      size_t recordBytes;
+
+
+         /// Temporary file, and its name.
+      std::FILE* spill;
+      std::string spillName;
+
+
+         /// End of the data in the temporary file.
+      size_t spillEnd;
+
+
+         /// Memory mapping of the temporary file, if open.
+      MemoryMappedFile spillMap;
+
+
+   }; // End of class 'RecordStore'
+
+      //@}
+
+}  // End of namespace gpstk
+
+#endif   // GPSTK_RECORDSTORE_HPP
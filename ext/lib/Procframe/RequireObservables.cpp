@@ -133,4 +133,70 @@ namespace gpstk
    }  // End of 'RequireObservables::Process()'
 
 
+
+      /* Returns a satTypeValueTable object, checking the required
+       * observables.
+       *
+       * @param gData     Data object holding the data.
+       */
+   satTypeValueTable& RequireObservables::Process(satTypeValueTable& gData)
+      throw(ProcessingException)
+   {
+
+      try
+      {
+
+         std::vector<bool> rejected( gData.numSats(), false );
+         bool anyRejected(false);
+
+            // Check all the indicated TypeID's, one column at a time
+         for ( TypeIDSet::const_iterator typeIt = requiredTypeSet.begin();
+               typeIt != requiredTypeSet.end();
+               ++typeIt )
+         {
+
+            const int col( gData.typeIndex(*typeIt) );
+
+            for ( size_t row = 0; row < gData.numSats(); ++row )
+            {
+               if ( col < 0 || !gData.hasValue(row, col) )
+               {
+                  rejected[row] = true;
+                  anyRejected = true;
+               }
+            }
+
+         }
+
+            // Let's remove satellites without all TypeID's
+         if ( anyRejected )
+         {
+            SatIDSet satRejectedSet;
+            for ( size_t row = 0; row < gData.numSats(); ++row )
+            {
+               if ( rejected[row] )
+               {
+                  satRejectedSet.insert( gData.getSat(row) );
+               }
+            }
+
+            gData.removeSatID(satRejectedSet);
+         }
+
+         return gData;
+
+      }
+      catch(Exception& u)
+      {
+            // Throw an exception if something unexpected happens
+         ProcessingException e( getClassName() + ":"
+                                + u.what() );
+
+         GPSTK_THROW(e);
+
+      }
+
+   }  // End of 'RequireObservables::Process()'
+
+
 } // End of namespace gpstk
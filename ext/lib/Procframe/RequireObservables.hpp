@@ -123,6 +123,15 @@ namespace gpstk
          throw(ProcessingException);
 
 
+         /** Returns a satTypeValueTable object, checking the required
+          *  observables.
+          *
+          * @param gData     Data object holding the data.
+          */
+      virtual satTypeValueTable& Process(satTypeValueTable& gData)
+         throw(ProcessingException);
+
+
          /** Method to add a TypeID to be required.
           *
           * @param type      Extra TypeID to be required.
@@ -181,6 +190,21 @@ namespace gpstk
       { Process(gData.body); return gData; };
 
 
+         /** Returns a gnnsRinexTable object, checking the required
+          *  observables.
+          *
+          * @param gData    Data object holding the data.
+          */
+      virtual gnssRinexTable& Process(gnssRinexTable& gData)
+         throw(ProcessingException)
+      { Process(gData.body); return gData; };
+
+
+         /// This class works on tables directly.
+      virtual bool isTableNative() const
+      { return true; };
+
+
          /// Returns a string identifying this object.
       virtual std::string getClassName(void) const;
 
@@ -234,6 +234,117 @@ namespace gpstk
 
 
 
+      /* Returns a satTypeValueTable object, adding the new data generated
+       *  when calling this object.
+       *
+       * @param epoch     Time of observations.
+       * @param gData     Data object holding the data.
+       */
+   satTypeValueTable& SatArcMarker::Process( const CommonTime& epoch,
+                                             satTypeValueTable& gData )
+      throw(ProcessingException)
+   {
+
+      try
+      {
+
+         SatIDSet satRejectedSet;
+
+         const int flagCol( gData.typeIndex(watchCSFlag) );
+         const size_t arcCol( gData.insertType(TypeID::satArc) );
+
+            // Loop through all the satellites
+         for( size_t row = 0; row < gData.numSats(); ++row )
+         {
+
+            const SatID& sat( gData.getSat(row) );
+
+               // If flag is missing, then schedule this satellite
+               // for removal
+            if( flagCol < 0 || !gData.hasValue(row, flagCol) )
+            {
+               satRejectedSet.insert( sat );
+               continue;
+            }
+
+            const double flag( gData.get(row, flagCol) );
+
+               // Check if satellite currently has entries
+            std::map<SatID, double>::iterator itArc( satArcMap.find(sat) );
+            if( itArc == satArcMap.end() )
+            {
+                  // If it doesn't have an entry, insert one
+               itArc = satArcMap.insert( std::make_pair(sat, 0.0) ).first;
+               satArcChangeMap[sat] = CommonTime::BEGINNING_OF_TIME;
+
+                  // This is a new satellite
+               satIsNewMap[sat] = true;
+            }
+
+            CommonTime& arcChange( satArcChangeMap[sat] );
+            bool& isNew( satIsNewMap[sat] );
+
+               // Check if we are inside unstable period
+            bool insideUnstable( std::abs(epoch - arcChange) <=
+                                                            unstablePeriod );
+
+               // Satellites can be new only once, and having at least once a
+               // flag > 0.0 outside 'unstablePeriod' will make them old.
+            if( isNew && !insideUnstable && flag <= 0.0 )
+            {
+               isNew = false;
+            }
+
+               // Check if there was a cycle slip
+            if ( flag > 0.0 )
+            {
+                  // Increment the value of "TypeID::satArc"
+               (*itArc).second = (*itArc).second + 1.0;
+
+                  // Update arc change epoch
+               arcChange = epoch;
+
+                  // If we want to delete unstable satellites, we must do it
+                  // also when arc changes, but only if this SV is not new
+               if ( deleteUnstableSats && !isNew )
+               {
+                  satRejectedSet.insert( sat );
+               }
+
+            }
+
+               // Test if we want to delete unstable satellites. Only do it
+               // if satellite is NOT new and we are inside unstable period
+            if ( insideUnstable && deleteUnstableSats && !isNew )
+            {
+               satRejectedSet.insert( sat );
+            }
+
+               // We will insert satellite arc number
+            gData.set( row, arcCol, (*itArc).second );
+
+         }
+
+            // Remove satellites with missing data
+         gData.removeSatID(satRejectedSet);
+
+         return gData;
+
+      }
+      catch(Exception& u)
+      {
+            // Throw an exception if something unexpected happens
+         ProcessingException e( getClassName() + ":"
+                                + u.what() );
+
+         GPSTK_THROW(e);
+
+      }
+
+   }  // End of method 'SatArcMarker::Process()'
+
+
+
       /* Returns a gnnsSatTypeValue object, adding the new data generated
        *  when calling this object.
        *
@@ -0,0 +1,798 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S.
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software.
+//
+//Pursuant to DoD Directive 523024
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+
+/**
+ * @file SatTypeValueTable.cpp
+ * Flat alternative to satTypeValueMap and gnssRinex.
+ */
+
+#include "SatTypeValueTable.hpp"
+
+#include <algorithm>
+
+
+namespace gpstk
+{
+
+
+      // Replaces the contents of this object with a satTypeValueMap.
+   satTypeValueTable& satTypeValueTable::assign(const satTypeValueMap& stvMap)
+   {
+
+      clear();
+      reserveRows( stvMap.size() );
+
+         // The map is sorted, so satellites are appended in order
+      for( satTypeValueMap::const_iterator it = stvMap.begin();
+           it != stvMap.end();
+           ++it )
+      {
+         const size_t row( sats.size() );
+         sats.push_back( (*it).first );
+
+         for( typeValueMap::const_iterator itType = (*it).second.begin();
+              itType != (*it).second.end();
+              ++itType )
+         {
+            set( row, insertType( (*itType).first ), (*itType).second );
+         }
+      }
+
+      return (*this);
+
+   }  // End of method 'satTypeValueTable::assign()'
+
+
+
+      // Replaces the contents of 'stvMap' with this object. Entries
+      // already in 'stvMap' are overwritten in place, so a map exported
+      // to epoch after epoch keeps its nodes instead of reallocating them.
+   satTypeValueMap& satTypeValueTable::exportTo(satTypeValueMap& stvMap) const
+   {
+
+         // Drop the satellites that are not in the table
+      if( !stvMap.empty() )
+      {
+         satTypeValueMap::iterator it( stvMap.begin() );
+         while( it != stvMap.end() )
+         {
+            if( satIndex( (*it).first ) < 0 )
+            {
+               stvMap.erase( it++ );
+            }
+            else
+            {
+               ++it;
+            }
+         }
+      }
+
+      satTypeValueMap::iterator pos;
+      for( size_t row = 0; row < sats.size(); ++row )
+      {
+         pos = stvMap.lower_bound( sats[row] );
+         if( pos == stvMap.end() || (*pos).first != sats[row] )
+         {
+            pos = stvMap.insert( pos,
+                                 std::make_pair( sats[row], typeValueMap() ) );
+         }
+         typeValueMap& tvMap( (*pos).second );
+
+         size_t present(0);
+         for( size_t col = 0; col < types.size(); ++col )
+         {
+            if( hasValue(row, col) )
+            {
+               tvMap[ types[col] ] = get(row, col);
+               ++present;
+            }
+            else
+            {
+               tvMap.erase( types[col] );
+            }
+         }
+
+            // Types that are not columns of the table are left over from
+            // an earlier export; they are rare, so only look for them when
+            // the sizes disagree
+         if( tvMap.size() != present )
+         {
+            typeValueMap::iterator itType( tvMap.begin() );
+            while( itType != tvMap.end() )
+            {
+               if( typeIndex( (*itType).first ) < 0 )
+               {
+                  tvMap.erase( itType++ );
+               }
+               else
+               {
+                  ++itType;
+               }
+            }
+         }
+      }
+
+      return stvMap;
+
+   }  // End of method 'satTypeValueTable::exportTo()'
+
+
+
+      // Returns the total number of data elements in the table.
+   size_t satTypeValueTable::numElements() const
+   {
+
+      size_t numEle(0);
+
+      for( size_t col = 0; col < types.size(); ++col )
+      {
+         for( size_t row = 0; row < sats.size(); ++row )
+         {
+            numEle += present[col * rowCapacity + row];
+         }
+      }
+
+      return numEle;
+
+   }  // End of method 'satTypeValueTable::numElements()'
+
+
+
+      // Removes all satellites and types. The memory of the table is
+      // kept for the next epoch.
+   void satTypeValueTable::clear()
+   {
+
+      for( size_t col = 0; col < types.size(); ++col )
+      {
+         columnOf[ types[col].index() ] = -1;
+      }
+
+      sats.clear();
+      types.clear();
+      values.clear();
+      present.clear();
+
+   }  // End of method 'satTypeValueTable::clear()'
+
+
+
+      // Returns the row of a satellite, or -1 if it is not present.
+   int satTypeValueTable::satIndex(const SatID& satellite) const
+   {
+
+      std::vector<SatID>::const_iterator it(
+         std::lower_bound( sats.begin(), sats.end(), satellite ) );
+
+      if( it != sats.end() && (*it) == satellite )
+      {
+         return int( it - sats.begin() );
+      }
+
+      return -1;
+
+   }  // End of method 'satTypeValueTable::satIndex()'
+
+
+
+      // Returns the row of a satellite, adding it without values if it
+      // is not present.
+   size_t satTypeValueTable::insertSat(const SatID& satellite)
+   {
+
+      std::vector<SatID>::iterator it(
+         std::lower_bound( sats.begin(), sats.end(), satellite ) );
+
+      const size_t row( it - sats.begin() );
+      if( it != sats.end() && (*it) == satellite )
+      {
+         return row;
+      }
+
+      const size_t numRows( sats.size() );
+      reserveRows( numRows + 1 );
+      sats.insert( sats.begin() + row, satellite );
+
+         // Open an empty row in every column
+      for( size_t col = 0; col < types.size(); ++col )
+      {
+         const size_t start( col * rowCapacity );
+         std::copy_backward( values.begin() + start + row,
+                             values.begin() + start + numRows,
+                             values.begin() + start + numRows + 1 );
+         std::copy_backward( present.begin() + start + row,
+                             present.begin() + start + numRows,
+                             present.begin() + start + numRows + 1 );
+         values[start + row] = 0.0;
+         present[start + row] = 0;
+      }
+
+      return row;
+
+   }  // End of method 'satTypeValueTable::insertSat()'
+
+
+
+      // Returns the column of a type, adding it without values if it is
+      // not present.
+   size_t satTypeValueTable::insertType(const TypeID& type)
+   {
+
+      const int found( typeIndex(type) );
+      if( found >= 0 )
+      {
+         return found;
+      }
+
+      if( size_t(type.index()) >= columnOf.size() )
+      {
+         columnOf.resize( type.index() + 1, -1 );
+      }
+
+      const size_t col( types.size() );
+      columnOf[type.index()] = int(col);
+      types.push_back(type);
+
+         // The memory released by 'clear()' is reused here
+      values.resize( (col + 1) * rowCapacity, 0.0 );
+      present.resize( (col + 1) * rowCapacity, 0 );
+
+      return col;
+
+   }  // End of method 'satTypeValueTable::insertType()'
+
+
+
+      // Makes room for at least 'rows' satellites in every column.
+   void satTypeValueTable::reserveRows(size_t rows)
+   {
+
+      if( rows <= rowCapacity )
+      {
+         return;
+      }
+
+      const size_t newCapacity( std::max( rows,
+                                          std::max( 2 * rowCapacity,
+                                                    size_t(16) ) ) );
+
+      std::vector<double> newValues( types.size() * newCapacity, 0.0 );
+      std::vector<unsigned char> newPresent( types.size() * newCapacity, 0 );
+      for( size_t col = 0; col < types.size(); ++col )
+      {
+         std::copy( values.begin() + col * rowCapacity,
+                    values.begin() + col * rowCapacity + sats.size(),
+                    newValues.begin() + col * newCapacity );
+         std::copy( present.begin() + col * rowCapacity,
+                    present.begin() + col * rowCapacity + sats.size(),
+                    newPresent.begin() + col * newCapacity );
+      }
+
+      values.swap(newValues);
+      present.swap(newPresent);
+      rowCapacity = newCapacity;
+
+   }  // End of method 'satTypeValueTable::reserveRows()'
+
+
+
+      // Removes the satellites whose 'drop' flag is set.
+   void satTypeValueTable::compactRows(const std::vector<bool>& drop)
+   {
+
+      const size_t numRows( sats.size() );
+
+      for( size_t col = 0; col < types.size(); ++col )
+      {
+         const size_t start( col * rowCapacity );
+         size_t kept(0);
+         for( size_t row = 0; row < numRows; ++row )
+         {
+            if( !drop[row] )
+            {
+               values[start + kept] = values[start + row];
+               present[start + kept] = present[start + row];
+               ++kept;
+            }
+         }
+
+            // Rows past the end must stay empty
+         for( size_t row = kept; row < numRows; ++row )
+         {
+            values[start + row] = 0.0;
+            present[start + row] = 0;
+         }
+      }
+
+      size_t kept(0);
+      for( size_t row = 0; row < numRows; ++row )
+      {
+         if( !drop[row] )
+         {
+            sats[kept] = sats[row];
+            ++kept;
+         }
+      }
+      sats.resize(kept);
+
+   }  // End of method 'satTypeValueTable::compactRows()'
+
+
+
+      // Removes the types whose 'drop' flag is set.
+   void satTypeValueTable::compactColumns(const std::vector<bool>& drop)
+   {
+
+      size_t kept(0);
+      for( size_t col = 0; col < types.size(); ++col )
+      {
+         if( drop[col] )
+         {
+            columnOf[ types[col].index() ] = -1;
+            continue;
+         }
+
+         if( kept != col )
+         {
+            std::copy( values.begin() + col * rowCapacity,
+                       values.begin() + (col + 1) * rowCapacity,
+                       values.begin() + kept * rowCapacity );
+            std::copy( present.begin() + col * rowCapacity,
+                       present.begin() + (col + 1) * rowCapacity,
+                       present.begin() + kept * rowCapacity );
+            types[kept] = types[col];
+            columnOf[ types[kept].index() ] = int(kept);
+         }
+
+         ++kept;
+      }
+
+      types.resize(kept);
+      values.resize( kept * rowCapacity );
+      present.resize( kept * rowCapacity );
+
+   }  // End of method 'satTypeValueTable::compactColumns()'
+
+
+
+      // Returns a Vector with all the satellites present in this object.
+   Vector<SatID> satTypeValueTable::getVectorOfSatID() const
+   {
+
+      Vector<SatID> result;
+      result = sats;
+
+      return result;
+
+   }  // End of method 'satTypeValueTable::getVectorOfSatID()'
+
+
+
+      // Returns a TypeIDSet with all the data types present in this object.
+   TypeIDSet satTypeValueTable::getTypeID() const
+   {
+
+      TypeIDSet typeSet;
+
+      for( size_t col = 0; col < types.size(); ++col )
+      {
+         for( size_t row = 0; row < sats.size(); ++row )
+         {
+            if( hasValue(row, col) )
+            {
+               typeSet.insert( types[col] );
+               break;
+            }
+         }
+      }
+
+      return typeSet;
+
+   }  // End of method 'satTypeValueTable::getTypeID()'
+
+
+
+      // Returns a satTypeValueTable with only this satellite.
+   satTypeValueTable satTypeValueTable::extractSatID(const SatID& satellite)
+      const
+   {
+
+      satTypeValueTable stvTable(*this);
+      stvTable.keepOnlySatID(satellite);
+
+      return stvTable;
+
+   }  // End of method 'satTypeValueTable::extractSatID()'
+
+
+
+      // Returns a satTypeValueTable with only these satellites.
+   satTypeValueTable satTypeValueTable::extractSatID(const SatIDSet& satSet)
+      const
+   {
+
+      satTypeValueTable stvTable(*this);
+      stvTable.keepOnlySatID(satSet);
+
+      return stvTable;
+
+   }  // End of method 'satTypeValueTable::extractSatID()'
+
+
+
+      // Modifies this object, keeping only this satellite.
+   satTypeValueTable& satTypeValueTable::keepOnlySatID(const SatID& satellite)
+   {
+
+      SatIDSet satSet;
+      satSet.insert(satellite);
+
+      return keepOnlySatID(satSet);
+
+   }  // End of method 'satTypeValueTable::keepOnlySatID()'
+
+
+
+      // Modifies this object, keeping only these satellites.
+   satTypeValueTable& satTypeValueTable::keepOnlySatID(const SatIDSet& satSet)
+   {
+
+      std::vector<bool> drop( sats.size() );
+      for( size_t row = 0; row < sats.size(); ++row )
+      {
+         drop[row] = ( satSet.find( sats[row] ) == satSet.end() );
+      }
+
+      compactRows(drop);
+
+      return (*this);
+
+   }  // End of method 'satTypeValueTable::keepOnlySatID()'
+
+
+
+      // Returns a satTypeValueTable with only this type of value.
+   satTypeValueTable satTypeValueTable::extractTypeID(const TypeID& type)
+      const
+   {
+
+      satTypeValueTable stvTable(*this);
+      stvTable.keepOnlyTypeID(type);
+
+      return stvTable;
+
+   }  // End of method 'satTypeValueTable::extractTypeID()'
+
+
+
+      // Returns a satTypeValueTable with only these types of data.
+   satTypeValueTable satTypeValueTable::extractTypeID(const TypeIDSet& typeSet)
+      const
+   {
+
+      satTypeValueTable stvTable(*this);
+      stvTable.keepOnlyTypeID(typeSet);
+
+      return stvTable;
+
+   }  // End of method 'satTypeValueTable::extractTypeID()'
+
+
+
+      // Modifies this object, keeping only this type of data.
+   satTypeValueTable& satTypeValueTable::keepOnlyTypeID(const TypeID& type)
+   {
+
+      TypeIDSet typeSet;
+      typeSet.insert(type);
+
+      return keepOnlyTypeID(typeSet);
+
+   }  // End of method 'satTypeValueTable::keepOnlyTypeID()'
+
+
+
+      // Modifies this object, keeping only these types of data.
+   satTypeValueTable& satTypeValueTable::keepOnlyTypeID(
+                                                const TypeIDSet& typeSet )
+   {
+
+      const TypeIDBitSet typeBits(typeSet);
+      std::vector<bool> drop( types.size() );
+      for( size_t col = 0; col < types.size(); ++col )
+      {
+         drop[col] = !typeBits.contains( types[col] );
+      }
+
+      compactColumns(drop);
+
+      return (*this);
+
+   }  // End of method 'satTypeValueTable::keepOnlyTypeID()'
+
+
+
+      // Modifies this object, removing this satellite.
+   satTypeValueTable& satTypeValueTable::removeSatID(const SatID& satellite)
+   {
+
+      const int row( satIndex(satellite) );
+      if( row >= 0 )
+      {
+         std::vector<bool> drop( sats.size(), false );
+         drop[row] = true;
+         compactRows(drop);
+      }
+
+      return (*this);
+
+   }  // End of method 'satTypeValueTable::removeSatID()'
+
+
+
+      // Modifies this object, removing these satellites.
+   satTypeValueTable& satTypeValueTable::removeSatID(const SatIDSet& satSet)
+   {
+
+      if( satSet.empty() )
+      {
+         return (*this);
+      }
+
+      std::vector<bool> drop( sats.size() );
+      for( size_t row = 0; row < sats.size(); ++row )
+      {
+         drop[row] = ( satSet.find( sats[row] ) != satSet.end() );
+      }
+
+      compactRows(drop);
+
+      return (*this);
+
+   }  // End of method 'satTypeValueTable::removeSatID()'
+
+
+
+      // Modifies this object, removing this type of data.
+   satTypeValueTable& satTypeValueTable::removeTypeID(const TypeID& type)
+   {
+
+      const int col( typeIndex(type) );
+      if( col >= 0 )
+      {
+         std::vector<bool> drop( types.size(), false );
+         drop[col] = true;
+         compactColumns(drop);
+      }
+
+      return (*this);
+
+   }  // End of method 'satTypeValueTable::removeTypeID()'
+
+
+
+      // Modifies this object, removing these types of data.
+   satTypeValueTable& satTypeValueTable::removeTypeID(const TypeIDSet& typeSet)
+   {
+
+      const TypeIDBitSet typeBits(typeSet);
+      std::vector<bool> drop( types.size() );
+      for( size_t col = 0; col < types.size(); ++col )
+      {
+         drop[col] = typeBits.contains( types[col] );
+      }
+
+      compactColumns(drop);
+
+      return (*this);
+
+   }  // End of method 'satTypeValueTable::removeTypeID()'
+
+
+
+      // Returns a GPSTk::Vector containing the data values with this type.
+   Vector<double> satTypeValueTable::getVectorOfTypeID(const TypeID& type)
+      const
+   {
+
+      Vector<double> result( sats.size(), 0.0 );
+
+      const int col( typeIndex(type) );
+      if( col >= 0 )
+      {
+         for( size_t row = 0; row < sats.size(); ++row )
+         {
+            result[row] = get(row, col);
+         }
+      }
+
+      return result;
+
+   }  // End of method 'satTypeValueTable::getVectorOfTypeID()'
+
+
+
+      // Returns a GPSTk::Matrix containing the data values in this set.
+   Matrix<double> satTypeValueTable::getMatrixOfTypes(const TypeIDSet& typeSet)
+      const
+   {
+
+      Matrix<double> tempMat( sats.size(), typeSet.size(), 0.0 );
+
+      size_t numCol(0);
+      for( TypeIDSet::const_iterator pos = typeSet.begin();
+           pos != typeSet.end();
+           ++pos )
+      {
+         const int col( typeIndex(*pos) );
+         if( col >= 0 )
+         {
+            for( size_t row = 0; row < sats.size(); ++row )
+            {
+               tempMat(row, numCol) = get(row, col);
+            }
+         }
+
+         ++numCol;
+      }
+
+      return tempMat;
+
+   }  // End of method 'satTypeValueTable::getMatrixOfTypes()'
+
+
+
+      // Modifies this object, adding one vector of data with this type,
+      // one value per satellite.
+   satTypeValueTable& satTypeValueTable::insertTypeIDVector(
+                                          const TypeID& type,
+                                          const Vector<double>& dataVector )
+      throw(NumberOfSatsMismatch)
+   {
+
+      if( dataVector.size() != sats.size() )
+      {
+         GPSTK_THROW( NumberOfSatsMismatch(" Number of data values in vector \
+and number of satellites do not match") );
+      }
+
+      const size_t col( insertType(type) );
+      for( size_t row = 0; row < sats.size(); ++row )
+      {
+         set( row, col, dataVector[row] );
+      }
+
+      return (*this);
+
+   }  // End of method 'satTypeValueTable::insertTypeIDVector()'
+
+
+
+      // Modifies this object, adding a matrix of data, one vector
+      // per satellite.
+   satTypeValueTable& satTypeValueTable::insertMatrix(
+                                          const TypeIDSet& typeSet,
+                                          const Matrix<double>& dataMatrix )
+      throw(NumberOfSatsMismatch, NumberOfTypesMismatch)
+   {
+
+      if( dataMatrix.rows() != sats.size() )
+      {
+         GPSTK_THROW( NumberOfSatsMismatch("Number of rows in matrix and \
+number of satellites do not match") );
+      }
+
+      if( dataMatrix.cols() != typeSet.size() )
+      {
+         GPSTK_THROW( NumberOfTypesMismatch("Number of data types in matrix \
+and number of types do not match") );
+      }
+
+      size_t numCol(0);
+      for( TypeIDSet::const_iterator pos = typeSet.begin();
+           pos != typeSet.end();
+           ++pos )
+      {
+         const size_t col( insertType(*pos) );
+         for( size_t row = 0; row < sats.size(); ++row )
+         {
+            set( row, col, dataMatrix(row, numCol) );
+         }
+
+         ++numCol;
+      }
+
+      return (*this);
+
+   }  // End of method 'satTypeValueTable::insertMatrix()'
+
+
+
+      // Returns the data value (double) corresponding to provided SatID
+      // and TypeID.
+   double satTypeValueTable::getValue( const SatID& satellite,
+                                       const TypeID& type ) const
+      throw( SatIDNotFound, TypeIDNotFound )
+   {
+
+      const int row( satIndex(satellite) );
+      if( row < 0 )
+      {
+         GPSTK_THROW(SatIDNotFound("SatID not found in map"));
+      }
+
+      const int col( typeIndex(type) );
+      if( col < 0 || !hasValue(row, col) )
+      {
+         GPSTK_THROW(TypeIDNotFound("TypeID not found in map"));
+      }
+
+      return get(row, col);
+
+   }  // End of method 'satTypeValueTable::getValue()'
+
+
+
+      // Returns a reference to the value with corresponding SatID and
+      // TypeID, adding them if they are not present.
+   double& satTypeValueTable::value( const SatID& satellite,
+                                     const TypeID& type )
+   {
+
+      const size_t row( insertSat(satellite) );
+      const size_t col( insertType(type) );
+
+      present[col * rowCapacity + row] = 1;
+
+      return values[col * rowCapacity + row];
+
+   }  // End of method 'satTypeValueTable::value()'
+
+
+
+      // stream output for satTypeValueTable
+   std::ostream& operator<<( std::ostream& s,
+                             const satTypeValueTable& stvTable )
+   {
+
+      stvTable.dump(s);
+      return s;
+
+   }  // End of 'operator<<'
+
+
+}  // End of namespace gpstk
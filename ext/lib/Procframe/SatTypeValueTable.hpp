@@ -0,0 +1,493 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S.
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software.
+//
+//Pursuant to DoD Directive 523024
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+
+/**
+ * @file SatTypeValueTable.hpp
+ * Flat alternative to satTypeValueMap and gnssRinex.
+ */
+
+#ifndef GPSTK_SATTYPEVALUETABLE_HPP
+#define GPSTK_SATTYPEVALUETABLE_HPP
+
+#include <vector>
+
+#include "DataStructures.hpp"
+
+
+namespace gpstk
+{
+
+      /// @ingroup DataStructures
+      //@{
+
+
+      /** Table holding SatID and TypeID with corresponding numeric value.
+       *
+       * This is a flat alternative to satTypeValueMap, with the same
+       * semantics: each satellite holds a value for some of the types.
+       * Satellites are kept in a sorted vector, and each type present in
+       * the epoch is a column of a dense table. The values of all columns
+       * live in a single array, which keeps its memory when the table is
+       * cleared, so a table reused epoch after epoch stops allocating once
+       * it has seen the largest epoch. Copying a table copies a few arrays
+       * instead of a tree of maps.
+       *
+       * This is not an arena allocator: only the table itself reuses its
+       * memory. Classes without a table path, such as the solvers, still
+       * work on a gnssRinex, so a whole PPP chain runs about as fast on
+       * either container; the gain is in the classes that work on the
+       * table directly.
+       *
+       * Values may be accessed by SatID and TypeID, as with
+       * satTypeValueMap, or by row and column, which avoids the lookups
+       * in inner loops:
+       *
+       * @code
+       *   int c1( table.typeIndex(TypeID::C1) );
+       *   size_t pc( table.insertType(TypeID::PC) );
+       *   for (size_t row = 0; row < table.numSats(); ++row)
+       *   {
+       *      if( c1 >= 0 && table.hasValue(row, c1) )
+       *      {
+       *         table.set(row, pc, table.get(row, c1));
+       *      }
+       *   }
+       * @endcode
+       */
+   struct satTypeValueTable
+   {
+
+         /// Default constructor.
+      satTypeValueTable()
+         : rowCapacity(0)
+      {};
+
+
+         /// Constructor from a satTypeValueMap.
+      explicit satTypeValueTable(const satTypeValueMap& stvMap)
+         : rowCapacity(0)
+      { assign(stvMap); };
+
+
+         /// Replaces the contents of this object with a satTypeValueMap.
+      satTypeValueTable& assign(const satTypeValueMap& stvMap);
+
+
+         /** Replaces the contents of 'stvMap' with this object. Entries
+          *  already in 'stvMap' are overwritten in place, so the nodes of
+          *  a map exported to every epoch are reused.
+          */
+      satTypeValueMap& exportTo(satTypeValueMap& stvMap) const;
+
+
+         /// Returns a satTypeValueMap with the contents of this object.
+      satTypeValueMap toMap() const
+      { satTypeValueMap stvMap; return exportTo(stvMap); };
+
+
+         /// Returns the number of available satellites.
+      size_t numSats() const
+      { return sats.size(); }
+
+
+         /// Returns the number of columns (types) of the table. Some
+         /// satellites may lack a value for some of them.
+      size_t numTypes() const
+      { return types.size(); }
+
+
+         /** Returns the total number of data elements in the table.
+          * This method DOES NOT suppose that all the satellites have
+          * the same number of type values.
+          */
+      size_t numElements() const;
+
+
+         /// Returns whether the table has no satellites.
+      bool empty() const
+      { return sats.empty(); }
+
+
+         /// Removes all satellites and types. The memory of the table is
+         /// kept for the next epoch.
+      void clear();
+
+
+         /// Returns the row of a satellite, or -1 if it is not present.
+      int satIndex(const SatID& satellite) const;
+
+
+         /// Returns the column of a type, or -1 if it is not present.
+      int typeIndex(const TypeID& type) const
+      {
+         const int i( type.index() );
+         return ( i >= 0 && size_t(i) < columnOf.size() ) ? columnOf[i] : -1;
+      }
+
+
+         /// Returns the row of a satellite, adding it without values if
+         /// it is not present. Rows of the following satellites shift.
+      size_t insertSat(const SatID& satellite);
+
+
+         /// Returns the column of a type, adding it without values if it
+         /// is not present.
+      size_t insertType(const TypeID& type);
+
+
+         /// Returns the satellite in a row.
+      const SatID& getSat(size_t row) const
+      { return sats[row]; }
+
+
+         /// Returns the type in a column.
+      const TypeID& getType(size_t col) const
+      { return types[col]; }
+
+
+         /// Returns whether the satellite in 'row' has a value in 'col'.
+      bool hasValue(size_t row, size_t col) const
+      { return present[col * rowCapacity + row] != 0; }
+
+
+         /// Returns the value in 'row' and 'col', or zero if not present.
+      double get(size_t row, size_t col) const
+      { return values[col * rowCapacity + row]; }
+
+
+         /// Sets the value in 'row' and 'col'.
+      void set(size_t row, size_t col, double value)
+      {
+         values[col * rowCapacity + row] = value;
+         present[col * rowCapacity + row] = 1;
+      }
+
+
+         /// Removes the value in 'row' and 'col'.
+      void unset(size_t row, size_t col)
+      {
+         values[col * rowCapacity + row] = 0.0;
+         present[col * rowCapacity + row] = 0;
+      }
+
+
+         /// Returns a SatIDSet with all the satellites present in this object.
+      SatIDSet getSatID() const
+      { return SatIDSet(sats.begin(), sats.end()); }
+
+
+         /// Returns a Vector with all the satellites present in this object.
+      Vector<SatID> getVectorOfSatID() const;
+
+
+         /// Returns a TypeIDSet with all the data types present in
+         /// this object.  This does not imply that all satellites have
+         /// these types.
+      TypeIDSet getTypeID() const;
+
+
+         /// Returns a satTypeValueTable with only this satellite.
+         /// @param satellite Satellite to be extracted.
+      satTypeValueTable extractSatID(const SatID& satellite) const;
+
+
+         /// Returns a satTypeValueTable with only these satellites.
+         /// @param satSet Set (SatIDSet) containing the satellites to
+         ///               be extracted.
+      satTypeValueTable extractSatID(const SatIDSet& satSet) const;
+
+
+         /// Modifies this object, keeping only this satellite.
+         /// @param satellite Satellite to be kept.
+      satTypeValueTable& keepOnlySatID(const SatID& satellite);
+
+
+         /// Modifies this object, keeping only these satellites.
+         /// @param satSet Set (SatIDSet) containing the satellites to be kept.
+      satTypeValueTable& keepOnlySatID(const SatIDSet& satSet);
+
+
+         /// Returns a satTypeValueTable with only this type of value.
+         /// @param type Type of value to be extracted.
+      satTypeValueTable extractTypeID(const TypeID& type) const;
+
+
+         /// Returns a satTypeValueTable with only these types of data.
+         /// @param typeSet Set (TypeIDSet) containing the types of data
+         ///                to be extracted.
+      satTypeValueTable extractTypeID(const TypeIDSet& typeSet) const;
+
+
+         /// Modifies this object, keeping only this type of data.
+         /// @param type Type of value to be kept.
+      satTypeValueTable& keepOnlyTypeID(const TypeID& type);
+
+
+         /// Modifies this object, keeping only these types of data.
+         /// @param typeSet Set (TypeIDSet) containing the types of data
+         ///                to be kept.
+      satTypeValueTable& keepOnlyTypeID(const TypeIDSet& typeSet);
+
+
+         /// Modifies this object, removing this satellite.
+         /// @param satellite Satellite to be removed.
+      satTypeValueTable& removeSatID(const SatID& satellite);
+
+
+         /// Modifies this object, removing these satellites.
+         /// @param satSet Set (SatIDSet) containing the satellites
+         ///               to be removed.
+      satTypeValueTable& removeSatID(const SatIDSet& satSet);
+
+
+         /// Modifies this object, removing this type of data.
+         /// @param type Type of value to be removed.
+      satTypeValueTable& removeTypeID(const TypeID& type);
+
+
+         /// Modifies this object, removing these types of data.
+         /// @param typeSet Set (TypeIDSet) containing the types of data
+         ///                to be removed.
+      satTypeValueTable& removeTypeID(const TypeIDSet& typeSet);
+
+
+         /// Returns a GPSTk::Vector containing the data values with this type.
+         /// @param type Type of value to be returned.
+         /// This method returns zero if a given satellite does not have
+         /// this type.
+      Vector<double> getVectorOfTypeID(const TypeID& type) const;
+
+
+         /// Returns a GPSTk::Matrix containing the data values in this set.
+         /// @param typeSet  TypeIDSet of values to be returned.
+      Matrix<double> getMatrixOfTypes(const TypeIDSet& typeSet) const;
+
+
+         /** Modifies this object, adding one vector of data with this type,
+          *  one value per satellite, in the order of the satellites.
+          *
+          * @param type          Type of data to be added.
+          * @param dataVector    GPSTk Vector containing the data to be added.
+          */
+      satTypeValueTable& insertTypeIDVector( const TypeID& type,
+                                             const Vector<double>& dataVector )
+         throw(NumberOfSatsMismatch);
+
+
+         /** Modifies this object, adding a matrix of data, one row per
+          *  satellite and one column per type in 'typeSet'.
+          *
+          * @param typeSet       Set (TypeIDSet) containing the types of data
+          *                      to be added.
+          * @param dataMatrix    GPSTk Matrix containing the data to be added.
+          */
+      satTypeValueTable& insertMatrix( const TypeIDSet& typeSet,
+                                       const Matrix<double>& dataMatrix )
+         throw(NumberOfSatsMismatch, NumberOfTypesMismatch);
+
+
+         /** Returns the data value (double) corresponding to provided SatID
+          *  and TypeID.
+          *
+          * @param satellite     Satellite to be looked for.
+          * @param type          Type to be looked for.
+          */
+      double getValue( const SatID& satellite,
+                       const TypeID& type ) const
+         throw( SatIDNotFound, TypeIDNotFound );
+
+
+         /// Returns a reference to the value with corresponding SatID and
+         /// TypeID, adding them if they are not present, like
+         /// 'stvMap[satellite][type]'.
+      double& value( const SatID& satellite,
+                     const TypeID& type );
+
+
+         /// Convenience output method, with the format of satTypeValueMap.
+      virtual std::ostream& dump( std::ostream& s,
+                                  int mode = 0) const
+      { return toMap().dump(s, mode); };
+
+
+         /// Destructor.
+      virtual ~satTypeValueTable() {};
+
+
+   private:
+
+
+         /// Makes room for at least 'rows' satellites in every column.
+      void reserveRows(size_t rows);
+
+
+         /// Removes the satellites whose 'drop' flag is set.
+      void compactRows(const std::vector<bool>& drop);
+
+
+         /// Removes the types whose 'drop' flag is set.
+      void compactColumns(const std::vector<bool>& drop);
+
+
+         /// Satellites, sorted.
+      std::vector<SatID> sats;
+
+
+         /// Type of each column.
+      std::vector<TypeID> types;
+
+
+         /// Column of each TypeID::index(), or -1.
+      std::vector<int> columnOf;
+
+
+         /// Rows allocated in each column.
+      size_t rowCapacity;
+
+
+         /// Values, column after column.
+      std::vector<double> values;
+
+
+         /// Whether each value is present.
+      std::vector<unsigned char> present;
+
+
+   };  // End of 'satTypeValueTable'
+
+
+
+      /// stream output for satTypeValueTable
+   std::ostream& operator<<( std::ostream& s,
+                             const satTypeValueTable& stvTable);
+
+
+
+      /** GNSS data structure with source, epoch and extra Rinex data as
+       *  header and satTypeValueTable as body: the flat alternative to
+       *  gnssRinex.
+       *
+       * Every ProcessingClass can process it: classes that work on the
+       * table directly override 'Process(gnssRinexTable&)', and the
+       * others go through a gnssRinex copy.
+       *
+       * @code
+       *   gnssRinex gRin;
+       *   gnssRinexTable gTab;
+       *
+       *   while(rin >> gRin)
+       *   {
+       *      gTab.assign(gRin);
+       *      gTab >> requireObs >> linear1 >> pList;
+       *   }
+       * @endcode
+       */
+   struct gnssRinexTable
+   {
+
+         /// Header.
+      sourceEpochRinexHeader header;
+
+
+         /// Body.
+      satTypeValueTable body;
+
+
+         /// Default constructor.
+      gnssRinexTable() {};
+
+
+         /// Constructor from a gnssRinex.
+      explicit gnssRinexTable(const gnssRinex& gRin)
+         : header(gRin.header), body(gRin.body)
+      {};
+
+
+         /// Replaces the contents of this object with a gnssRinex.
+      gnssRinexTable& assign(const gnssRinex& gRin)
+      { header = gRin.header; body.assign(gRin.body); return (*this); };
+
+
+         /// Replaces the contents of 'gRin' with this object.
+      gnssRinex& exportTo(gnssRinex& gRin) const
+      { gRin.header = header; body.exportTo(gRin.body); return gRin; };
+
+
+         /// Returns the number of satellites available in the body.
+      size_t numSats() const
+      { return body.numSats(); };
+
+
+         /// Returns a SatIDSet with all the satellites present in this object.
+      SatIDSet getSatID() const
+      { return body.getSatID(); }
+
+
+         /// Returns a Vector containing the data values with this type.
+      Vector<double> getVectorOfTypeID(const TypeID& type) const
+      { return body.getVectorOfTypeID(type); }
+
+
+         /// Modifies this object, adding one vector of data with this type,
+         /// one value per satellite.
+      gnssRinexTable& insertTypeIDVector( const TypeID& type,
+                                          const Vector<double>& dataVector )
+         throw(NumberOfSatsMismatch)
+      { body.insertTypeIDVector(type, dataVector); return (*this); };
+
+
+         /// Modifies this object, removing these satellites.
+      gnssRinexTable& removeSatID(const SatIDSet& satSet)
+      { body.removeSatID(satSet); return (*this); };
+
+
+         /// Modifies this object, keeping only these types of data.
+      gnssRinexTable& keepOnlyTypeID(const TypeIDSet& typeSet)
+      { body.keepOnlyTypeID(typeSet); return (*this); };
+
+
+         /// Destructor.
+      virtual ~gnssRinexTable() {};
+
+
+   };  // End of 'gnssRinexTable'
+
+      //@}
+
+}  // End of namespace gpstk
+
+#endif   // GPSTK_SATTYPEVALUETABLE_HPP
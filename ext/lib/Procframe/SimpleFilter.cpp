@@ -117,4 +117,59 @@ namespace gpstk
    }  // End of 'SimpleFilter::Process()'
 
 
+
+      /* Returns a satTypeValueTable object, filtering the target
+       * observables.
+       *
+       * @param gData     Data object holding the data.
+       */
+   satTypeValueTable& SimpleFilter::Process(satTypeValueTable& gData)
+      throw(ProcessingException)
+   {
+
+      try
+      {
+
+         SatIDSet satRejectedSet;
+
+            // Check all the indicated TypeID's, one column at a time
+         TypeIDSet::const_iterator pos;
+         for (pos = filterTypeSet.begin(); pos != filterTypeSet.end(); ++pos)
+         {
+
+            const int col( gData.typeIndex(*pos) );
+
+            for (size_t row = 0; row < gData.numSats(); ++row)
+            {
+                  // Missing values and values out of bounds schedule
+                  // this satellite for removal
+               if ( col < 0 ||
+                    !gData.hasValue(row, col) ||
+                    !( checkValue( gData.get(row, col) ) ) )
+               {
+                  satRejectedSet.insert( gData.getSat(row) );
+               }
+            }
+
+         }
+
+            // Satellites rejected by any type are removed
+         gData.removeSatID(satRejectedSet);
+
+         return gData;
+
+      }
+      catch(Exception& u)
+      {
+            // Throw an exception if something unexpected happens
+         ProcessingException e( getClassName() + ":"
+                                + u.what() );
+
+         GPSTK_THROW(e);
+
+      }
+
+   }  // End of 'SimpleFilter::Process()'
+
+
 } // End of namespace gpstk
@@ -160,6 +160,15 @@ namespace gpstk
          throw(ProcessingException);
 
 
+         /** Returns a satTypeValueTable object, filtering the target
+          *  observables.
+          *
+          * @param gData     Data object holding the data.
+          */
+      virtual satTypeValueTable& Process(satTypeValueTable& gData)
+         throw(ProcessingException);
+
+
          /** Method to set the minimum limit.
           * @param min       Minimum limit (in meters).
           */
@@ -232,6 +241,21 @@ namespace gpstk
       { Process(gData.body); return gData; };
 
 
+         /** Returns a gnnsRinexTable object, filtering the target
+          *  observables.
+          *
+          * @param gData    Data object holding the data.
+          */
+      virtual gnssRinexTable& Process(gnssRinexTable& gData)
+         throw(ProcessingException)
+      { Process(gData.body); return gData; };
+
+
+         /// This class works on tables directly.
+      virtual bool isTableNative() const
+      { return true; };
+
+
          /// Returns a string identifying this object.
       virtual std::string getClassName(void) const;
 
@@ -42,6 +42,7 @@
 
 #include "SolverGeneral.hpp"
 #include "GeneralConstraint.hpp"
+#include <algorithm>
 
 namespace gpstk
 {
@@ -239,132 +240,192 @@ namespace gpstk
          qMatrix = equSystem.getQMatrix();
 
 
-            // Get the number of unknowns being processed
-         int numUnknowns( equSystem.getTotalNumVariables() );
-
             // Get the set with unknowns being processed
          VariableSet unkSet( equSystem.getVarUnknowns() );
 
-            // Feed the filter with the correct state and covariance matrix
+            // Feed the filter with the correct state and covariance matrix.
+            // The previous solution is kept, and only the rows and columns
+            // of the unknowns that appeared or disappeared are changed. The
+            // first time there is no previous solution.
          if(firstTime)
          {
+            stateIndex.clear();
+         }
 
-            Vector<double> initialState(numUnknowns, 0.0);
-            Matrix<double> initialErrorCovariance( numUnknowns,
-                                                   numUnknowns,
-                                                   0.0 );
-
-               // Fill the initialErrorCovariance matrix
+         updateState(unkSet);
 
-            int i(0);      // Set an index
+            // No longer first time
+         firstTime = false;
 
-            for( VariableSet::const_iterator itVar = unkSet.begin();
-                 itVar != unkSet.end();
-                 ++itVar )
-            {
+            // Reset Kalman filter to current state and covariance matrix
+         kFilter.Reset( stateVector, stateCovariance );
 
-               initialErrorCovariance(i,i) = (*itVar).getInitialVariance();
-               ++i;
-            }
 
+      }
+      catch(Exception& u)
+      {
+            // Throw an exception if something unexpected happens
+         ProcessingException e( getClassName() + ":"
+                                + StringUtils::asString( getIndex() ) + ":"
+                                + u.what() );
 
-               // Reset Kalman filter
-            kFilter.Reset( initialState, initialErrorCovariance );
+         GPSTK_THROW(e);
 
-               // No longer first time
-            firstTime = false;
+      }
 
-         }
-         else
-         {
-               // Adapt the size to the current number of unknowns
-            Vector<double> currentState(numUnknowns, 0.0);
-            Matrix<double> currentErrorCov(numUnknowns, numUnknowns, 0.0);
+      return gdsMap;
 
+   }  // End of method 'SolverGeneral::preCompute()'
 
-               // Fill the state vector
 
-            int i(0);      // Set an index
 
-            for( VariableSet::const_iterator itVar = unkSet.begin();
-                 itVar != unkSet.end();
-                 ++itVar )
-            {
+      /* Adapt the stored state and covariance matrix to a new set of
+       * unknowns, and update 'stateIndex' accordingly.
+       *
+       * Only the unknowns that appeared or disappeared are inserted into
+       * or erased from 'stateIndex', and only their rows and columns are
+       * changed in 'stateVector' and 'stateCovariance'. The storage is
+       * reused unless it is too small.
+       *
+       * New unknowns are seeded as they always were: zero state and, the
+       * first time, their initial variance on the diagonal. Afterwards a
+       * new unknown gets zero variance, and its covariance with any
+       * unknown sorted before it is its own initial variance. The
+       * equation system gives new unknowns a zero state transition, so
+       * this seeding does not reach the solution.
+       *
+       * @param unkSet     Set of unknowns being processed.
+       */
+   void SolverGeneral::updateState( const VariableSet& unkSet )
+   {
 
-               currentState(i) = stateMap[ (*itVar) ];
-               ++i;
-            }
+      const int oldSize( stateVector.size() );
+      const int numUnknowns( unkSet.size() );
 
+         // Old position of each unknown that is kept, and the place in
+         // 'kept' of each current unknown, or -1 if it is new
+      std::vector<int> kept;
+      std::vector<int> fromKept( numUnknowns, -1 );
+      std::vector<double> initialVariance( numUnknowns, 0.0 );
 
-               // Fill the covariance matrix
+      int i(0);      // Set an index
 
-               // We need a copy of 'unkSet'
-            VariableSet tempSet( unkSet );
+      std::map<Variable, int>::iterator itIndex( stateIndex.begin() );
+      for( VariableSet::const_iterator itVar = unkSet.begin();
+           itVar != unkSet.end();
+           ++itVar, ++i )
+      {
 
-            i = 0;         // Reset 'i' index
+         while( itIndex != stateIndex.end() && (*itIndex).first < (*itVar) )
+         {
+            stateIndex.erase( itIndex++ );
+         }
 
-            for( VariableSet::const_iterator itVar1 = unkSet.begin();
-                 itVar1 != unkSet.end();
-                 ++itVar1 )
-            {
+         if( itIndex == stateIndex.end() || (*itVar) < (*itIndex).first )
+         {
+            stateIndex.insert( itIndex, std::make_pair( (*itVar), i ) );
+            initialVariance[i] = (*itVar).getInitialVariance();
+         }
+         else
+         {
+            fromKept[i] = kept.size();
+            kept.push_back( (*itIndex).second );
+            (*itIndex).second = i;
+            ++itIndex;
+         }
+      }
 
-                  // Fill the diagonal element
-               currentErrorCov(i, i) = covarianceMap[ (*itVar1) ][ (*itVar1) ];
+      stateIndex.erase( itIndex, stateIndex.end() );
 
-               int j(i+1);      // Set 'j' index
+      const int numKept( kept.size() );
 
-                  // Remove current Variable from 'tempSet'
-               tempSet.erase( (*itVar1) );
+         // Nothing else to do if the unknowns did not change
+      if( numKept == oldSize && numKept == numUnknowns )
+      {
+         return;
+      }
 
-               for( VariableSet::const_iterator itVar2 = tempSet.begin();
-                    itVar2 != tempSet.end();
-                    ++itVar2 )
-               {
+         // Erase the rows and columns of the unknowns that disappeared. The
+         // elements kept move to lower positions, so a forward pass is safe
+      if( numKept < oldSize )
+      {
+         double* state( stateVector.begin() );
+         double* cov( stateCovariance.begin() );
 
-                     // Check if '(*itVar2)' belongs to 'covarianceMap'
-                  if( covarianceMap.find( (*itVar2) ) != covarianceMap.end() )
-                  {
-                        // If it belongs, get element from 'covarianceMap'
-                     currentErrorCov(i, j) =
-                        currentErrorCov(j, i) =
-                           covarianceMap[ (*itVar1) ][ (*itVar2) ];
-                  }
-                  else
-                  {
-                        // If it doesn't belong, ask for default covariance
-                     currentErrorCov(i, j) =
-                        currentErrorCov(j, i) = (*itVar2).getInitialVariance();
-                  }
+         for( int b = 0; b < numKept; ++b )
+         {
+            state[b] = state[ kept[b] ];
 
-                  ++j;
-               }
+            for( int a = 0; a < numKept; ++a )
+            {
+               cov[ a + b * numKept ] = cov[ kept[a] + kept[b] * oldSize ];
+            }
+         }
+      }
 
-               ++i;
+         // Insert the rows and columns of the new unknowns. The elements
+         // kept move to higher positions, so a backward pass is safe. If
+         // the storage is too small, the kept block is copied out first
+      if( numUnknowns > numKept )
+      {
+         Vector<double> keptState;
+         Matrix<double> keptCov;
 
-            }  // End of for( VariableSet::const_iterator itVar1 = unkSet...'
+         if( numUnknowns > oldSize )
+         {
+            keptState = stateVector;
+            keptCov = stateCovariance;
+            stateVector.resize( numUnknowns );
+            stateCovariance.resize( numUnknowns, numUnknowns );
+         }
 
+         double* state( stateVector.begin() );
+         double* cov( stateCovariance.begin() );
+         const double* fromState( numUnknowns > oldSize ? keptState.begin()
+                                                         : state );
+         const double* fromCov( numUnknowns > oldSize ? keptCov.begin()
+                                                       : cov );
 
-               // Reset Kalman filter to current state and covariance matrix
-            kFilter.Reset( currentState, currentErrorCov );
+         for( int b = numUnknowns - 1; b >= 0; --b )
+         {
 
-         }  // End of 'if(firstTime)'
+            state[b] = ( fromKept[b] < 0 ? 0.0 : fromState[ fromKept[b] ] );
 
+            for( int a = numUnknowns - 1; a >= 0; --a )
+            {
 
-      }
-      catch(Exception& u)
-      {
-            // Throw an exception if something unexpected happens
-         ProcessingException e( getClassName() + ":"
-                                + StringUtils::asString( getIndex() ) + ":"
-                                + u.what() );
+               double value(0.0);
 
-         GPSTK_THROW(e);
+               if( fromKept[a] >= 0 && fromKept[b] >= 0 )
+               {
+                  value = fromCov[ fromKept[a] + fromKept[b] * numKept ];
+               }
+               else if( firstTime )
+               {
+                  value = ( a == b ? initialVariance[a] : 0.0 );
+               }
+               else
+               {
+                     // Covariance of a new unknown with those before it
+                  const int last( std::max(a, b) );
+                  if( a != b && fromKept[last] < 0 )
+                  {
+                     value = initialVariance[last];
+                  }
+               }
 
+               cov[ a + b * numUnknowns ] = value;
+            }
+         }
       }
 
-      return gdsMap;
+         // Shrinking keeps the storage
+      stateVector.resize( numUnknowns );
+      stateCovariance.resize( numUnknowns, numUnknowns );
 
-   }  // End of method 'SolverGeneral::preCompute()'
+      return;
+
+   }  // End of method 'SolverGeneral::updateState()'
 
 
 
@@ -445,33 +506,14 @@ of qMatrix");
          GPSTK_THROW(e);
       }
 
-         // After checking sizes, let's invert the matrix of weights in order
-         // to get the measurements noise covariance matrix, which is what we
-         // use in the "SimpleKalmanFilter" class
-      Matrix<double> measNoiseMatrix;
-
+         // Call the Kalman filter object.
       try
       {
-         measNoiseMatrix = inverseChol(weightMatrix);
-      }
-      catch(...)
-      {
-         InvalidSolver e("Correct(): Unable to compute measurements noise \
-covariance matrix.");
-         GPSTK_THROW(e);
-      }
-
-
-      try
-      {
-
-            // Call the Kalman filter object.
-         kFilter.Compute( phiMatrix,
-                          qMatrix,
-                          prefitResiduals,
-                          designMatrix,
-                          measNoiseMatrix );
-
+         kFilter.ComputeWeighted( phiMatrix,
+                                  qMatrix,
+                                  prefitResiduals,
+                                  designMatrix,
+                                  weightMatrix );
       }
       catch(InvalidSolver& e)
       {
@@ -507,63 +549,13 @@ covariance matrix.");
       try
       {
 
-            // Clean up values in 'stateMap' and 'covarianceMap'
-         stateMap.clear();
-         covarianceMap.clear();
-
-
-            // Get the set with unknowns being processed
-         VariableSet unkSet( equSystem.getVarUnknowns() );
-
-
-            // Store values of current state
+            // Store values of current state and covariance matrix. They are
+            // in the order of the unknowns, already indexed by 'stateIndex'
+         stateVector = solution;
+         stateCovariance = covMatrix;
 
          int i(0);      // Set an index
 
-         for( VariableSet::const_iterator itVar = unkSet.begin();
-              itVar != unkSet.end();
-              ++itVar )
-         {
-
-            stateMap[ (*itVar) ] = solution(i);
-            ++i;
-         }
-
-
-            // Store values of covariance matrix
-
-            // We need a copy of 'unkSet'
-         VariableSet tempSet( unkSet );
-
-         i = 0;         // Reset 'i' index
-
-         for( VariableSet::const_iterator itVar1 = unkSet.begin();
-              itVar1 != unkSet.end();
-              ++itVar1 )
-         {
-
-               // Fill the diagonal element
-            covarianceMap[ (*itVar1) ][ (*itVar1) ] = covMatrix(i, i);
-
-            int j(i+1);      // Set 'j' index
-
-               // Remove current Variable from 'tempSet'
-            tempSet.erase( (*itVar1) );
-
-            for( VariableSet::const_iterator itVar2 = tempSet.begin();
-                 itVar2 != tempSet.end();
-                 ++itVar2 )
-            {
-
-               covarianceMap[ (*itVar1) ][ (*itVar2) ] = covMatrix(i, j);
-
-               ++j;
-            }
-
-            ++i;
-
-         }  // End of for( VariableSet::const_iterator itVar1 = unkSet...'
-
 
             // Store the postfit residuals in the GNSS Data Structure
 
@@ -629,19 +621,19 @@ covariance matrix.");
       throw(InvalidRequest)
    {
 
-         // Look the variable inside the state map
-      VariableDataMap::const_iterator it( stateMap.find( variable ) );
+         // Look the variable inside the state index
+      std::map<Variable, int>::const_iterator it( stateIndex.find( variable ) );
 
          // Check if the provided Variable exists in the solution. If not,
          // an InvalidSolver exception will be issued.
-      if( it == stateMap.end() )
+      if( it == stateIndex.end() )
       {
          InvalidRequest e("Variable not found in solution vector.");
          GPSTK_THROW(e);
       }
 
          // Return value
-      return (*it).second;
+      return stateVector( (*it).second );
 
    }  // End of method 'SolverGeneral::getSolution()'
 
@@ -658,25 +650,25 @@ covariance matrix.");
       throw(InvalidRequest)
    {
 
-         // Declare an iterator for 'stateMap' and go to the first element
-      VariableDataMap::const_iterator it = stateMap.begin();
+         // Declare an iterator for 'stateIndex' and go to the first element
+      std::map<Variable, int>::const_iterator it = stateIndex.begin();
 
          // Look for a variable with the same type
-      while( (*it).first.getType() != type &&
-             it != stateMap.end() )
+      while( it != stateIndex.end() &&
+             (*it).first.getType() != type )
       {
          ++it;
+      }
 
          // If the same type is not found, throw an exception
-         if( it == stateMap.end() )
-         {
-             InvalidRequest e("Type not found in solution vector.");
-             GPSTK_THROW(e);
-         }
+      if( it == stateIndex.end() )
+      {
+         InvalidRequest e("Type not found in solution vector.");
+         GPSTK_THROW(e);
       }
 
          // Else, return the corresponding value
-      return (*it).second;
+      return stateVector( (*it).second );
 
    }  // End of method 'SolverGeneral::getSolution()'
 
@@ -695,26 +687,26 @@ covariance matrix.");
       throw(InvalidRequest)
    {
 
-         // Declare an iterator for 'stateMap' and go to the first element
-      VariableDataMap::const_iterator it = stateMap.begin();
+         // Declare an iterator for 'stateIndex' and go to the first element
+      std::map<Variable, int>::const_iterator it = stateIndex.begin();
 
          // Look for a variable with the same type and source
-      while( !( (*it).first.getType()   == type &&
-                (*it).first.getSource() == source ) &&
-             it != stateMap.end() )
+      while( it != stateIndex.end() &&
+             !( (*it).first.getType()   == type &&
+                (*it).first.getSource() == source ) )
       {
          ++it;
+      }
 
          // If it is not found, throw an exception
-         if( it == stateMap.end() )
-         {
-             InvalidRequest e("Type and source not found in solution vector.");
-             GPSTK_THROW(e);
-         }
+      if( it == stateIndex.end() )
+      {
+         InvalidRequest e("Type and source not found in solution vector.");
+         GPSTK_THROW(e);
       }
 
          // Else, return the corresponding value
-      return (*it).second;
+      return stateVector( (*it).second );
 
    }  // End of method 'SolverGeneral::getSolution()'
 
@@ -733,26 +725,26 @@ covariance matrix.");
       throw(InvalidRequest)
    {
 
-      // Declare an iterator for 'stateMap' and go to the first element
-      VariableDataMap::const_iterator it = stateMap.begin();
+      // Declare an iterator for 'stateIndex' and go to the first element
+      std::map<Variable, int>::const_iterator it = stateIndex.begin();
 
       // Look for a variable with the same type and source
-      while( !( (*it).first.getType()   == type &&
-             (*it).first.getSatellite() == sat ) &&
-             it != stateMap.end() )
+      while( it != stateIndex.end() &&
+             !( (*it).first.getType()   == type &&
+                (*it).first.getSatellite() == sat ) )
       {
          ++it;
+      }
 
          // If it is not found, throw an exception
-         if( it == stateMap.end() )
-         {
-            InvalidRequest e("Type and source not found in solution vector.");
-            GPSTK_THROW(e);
-         }
+      if( it == stateIndex.end() )
+      {
+         InvalidRequest e("Type and source not found in solution vector.");
+         GPSTK_THROW(e);
       }
 
       // Else, return the corresponding value
-      return (*it).second;
+      return stateVector( (*it).second );
 
    }  // End of method 'SolverGeneral::getSolution()'
 
@@ -773,27 +765,27 @@ covariance matrix.");
       throw(InvalidRequest)
    {
 
-         // Declare an iterator for 'stateMap' and go to the first element
-      VariableDataMap::const_iterator it = stateMap.begin();
+         // Declare an iterator for 'stateIndex' and go to the first element
+      std::map<Variable, int>::const_iterator it = stateIndex.begin();
 
          // Look for a variable with the same type, source and satellite
-      while( !( (*it).first.getType()      == type    &&
+      while( it != stateIndex.end() &&
+             !( (*it).first.getType()      == type    &&
                 (*it).first.getSource()    == source  &&
-                (*it).first.getSatellite() == sat        ) &&
-             it != stateMap.end() )
+                (*it).first.getSatellite() == sat        ) )
       {
          ++it;
+      }
 
          // If it is not found, throw an exception
-         if( it == stateMap.end() )
-         {
-             InvalidRequest e("Type, source and SV not found in solution vector.");
-             GPSTK_THROW(e);
-         }
+      if( it == stateIndex.end() )
+      {
+         InvalidRequest e("Type, source and SV not found in solution vector.");
+         GPSTK_THROW(e);
       }
 
          // Else, return the corresponding value
-      return (*it).second;
+      return stateVector( (*it).second );
 
    }  // End of method 'SolverGeneral::getSolution()'
 
@@ -806,30 +798,15 @@ covariance matrix.");
                                         const Variable& var2 ) const
       throw(InvalidRequest)
    {
-      std::map<Variable, VariableDataMap >::const_iterator it1 = covarianceMap.find(var1);
-      if(it1!=covarianceMap.end())
+      std::map<Variable, int>::const_iterator it1 = stateIndex.find(var1);
+      std::map<Variable, int>::const_iterator it2 = stateIndex.find(var2);
+      if( it1 == stateIndex.end() || it2 == stateIndex.end() )
       {
-         VariableDataMap::const_iterator it2 = it1->second.find(var2);
-         if(it2!=it1->second.end())
-         {
-            return it2->second;
-         }
-         else
-         {
-            it1 = covarianceMap.find(var2);
-            if(it1!=covarianceMap.end())
-            {
-               it2 = it1->second.find(var1);
-               if(it2!=it1->second.end()) return it2->second;
-            }
-         }
+         InvalidRequest e("Failed to get the covariance value.");
+         GPSTK_THROW(e);
       }
-      
-         // Once code go here, we failed to find the value, and throw exception.
-      InvalidRequest e("Failed to get the covariance value.");
-      GPSTK_THROW(e);
 
-      return 0.0;
+      return stateCovariance( it1->second, it2->second );
    }
 
 
@@ -843,14 +820,15 @@ covariance matrix.");
 
          // Check if the provided Variable exists in the solution. If not,
          // an InvalidSolver exception will be issued.
-      if( stateMap.find( variable ) == stateMap.end() )
+      std::map<Variable, int>::const_iterator it( stateIndex.find( variable ) );
+      if( it == stateIndex.end() )
       {
          InvalidRequest e("Variable not found in covariance matrix.");
          GPSTK_THROW(e);
       }
 
          // Return value
-      return getCovariance(variable,variable);
+      return stateCovariance( (*it).second, (*it).second );
 
    }  // End of method 'SolverGeneral::getVariance()'
 
@@ -867,26 +845,25 @@ covariance matrix.");
       throw(InvalidRequest)
    {
 
-         // Declare an iterator for 'covarianceMap' and go to the first element
-      std::map<Variable, VariableDataMap >::const_iterator it
-                                                      = covarianceMap.begin();
+         // Declare an iterator for 'stateIndex' and go to the first element
+      std::map<Variable, int>::const_iterator it = stateIndex.begin();
 
          // Look for a variable with the same type
-      while( (*it).first.getType() != type &&
-             it != covarianceMap.end() )
+      while( it != stateIndex.end() &&
+             (*it).first.getType() != type )
       {
          ++it;
+      }
 
          // If the same type is not found, throw an exception
-         if( it == covarianceMap.end() )
-         {
-             InvalidRequest e("Type not found in covariance matrix.");
-             GPSTK_THROW(e);
-         }
+      if( it == stateIndex.end() )
+      {
+         InvalidRequest e("Type not found in covariance matrix.");
+         GPSTK_THROW(e);
       }
 
          // Else, return the corresponding value
-      return getCovariance(it->first,it->first); 
+      return stateCovariance( (*it).second, (*it).second ); 
 
    }  // End of method 'SolverGeneral::getVariance()'
 
@@ -903,25 +880,25 @@ covariance matrix.");
                                       const SourceID& source ) const 
       throw(InvalidRequest)
    {
-         // Declare an iterator for 'stateMap' and go to the first element
-      VariableDataMap::const_iterator it = stateMap.begin();
+         // Declare an iterator for 'stateIndex' and go to the first element
+      std::map<Variable, int>::const_iterator it = stateIndex.begin();
          // Look for a variable with the same type and source
-      while( !( (*it).first.getType()   == type &&
-         (*it).first.getSource() == source ) &&
-         it != stateMap.end() )
+      while( it != stateIndex.end() &&
+             !( (*it).first.getType()   == type &&
+                (*it).first.getSource() == source ) )
       {
          ++it;
+      }
 
          // If it is not found, throw an exception
-         if( it == stateMap.end() )
-         {
-            InvalidRequest e("Type and source not found in solution vector.");
-            GPSTK_THROW(e);
-         }
+      if( it == stateIndex.end() )
+      {
+         InvalidRequest e("Type and source not found in solution vector.");
+         GPSTK_THROW(e);
       }
 
          // Else, return the corresponding value
-      return getCovariance(it->first,it->first);
+      return stateCovariance( (*it).second, (*it).second );
 
    }  // End of method 'SolverGeneral::getVariance()'
 
@@ -939,26 +916,26 @@ covariance matrix.");
                                       const SatID& sat ) const 
       throw(InvalidRequest)
    {
-      // Declare an iterator for 'stateMap' and go to the first element
-      VariableDataMap::const_iterator it = stateMap.begin();
+      // Declare an iterator for 'stateIndex' and go to the first element
+      std::map<Variable, int>::const_iterator it = stateIndex.begin();
 
       // Look for a variable with the same type and source
-      while( !( (*it).first.getType()   == type &&
-             (*it).first.getSatellite() == sat ) &&
-             it != stateMap.end() )
+      while( it != stateIndex.end() &&
+             !( (*it).first.getType()   == type &&
+                (*it).first.getSatellite() == sat ) )
       {
          ++it;
+      }
 
          // If it is not found, throw an exception
-         if( it == stateMap.end() )
-         {
-            InvalidRequest e("Type and source not found in solution vector.");
-            GPSTK_THROW(e);
-         }
+      if( it == stateIndex.end() )
+      {
+         InvalidRequest e("Type and source not found in solution vector.");
+         GPSTK_THROW(e);
       }
 
       // Else, return the corresponding value
-      return getCovariance(it->first,it->first);
+      return stateCovariance( (*it).second, (*it).second );
 
 
    }  // End of method 'SolverGeneral::getVariance()'
@@ -978,27 +955,27 @@ covariance matrix.");
                                       const SatID& sat ) const 
       throw(InvalidRequest)
    {
-         // Declare an iterator for 'stateMap' and go to the first element
-      VariableDataMap::const_iterator it = stateMap.begin();
+         // Declare an iterator for 'stateIndex' and go to the first element
+      std::map<Variable, int>::const_iterator it = stateIndex.begin();
 
          // Look for a variable with the same type, source and satellite
-      while( !( (*it).first.getType()      == type    &&
-         (*it).first.getSource()    == source  &&
-         (*it).first.getSatellite() == sat        ) &&
-         it != stateMap.end() )
+      while( it != stateIndex.end() &&
+             !( (*it).first.getType()      == type    &&
+                (*it).first.getSource()    == source  &&
+                (*it).first.getSatellite() == sat        ) )
       {
          ++it;
+      }
 
          // If it is not found, throw an exception
-         if( it == stateMap.end() )
-         {
-            InvalidRequest e("Type, source and SV not found in solution vector.");
-            GPSTK_THROW(e);
-         }
+      if( it == stateIndex.end() )
+      {
+         InvalidRequest e("Type, source and SV not found in solution vector.");
+         GPSTK_THROW(e);
       }
 
          // Else, return the corresponding value
-      return getCovariance(it->first,it->first);
+      return stateCovariance( (*it).second, (*it).second );
 
    }  // End of method 'SolverGeneral::getVariance()'
 
@@ -1012,10 +989,10 @@ covariance matrix.");
                                               const double& val )
       throw(InvalidRequest)
    {
-      VariableDataMap::iterator it = stateMap.find(variable);
-      if(it!=stateMap.end())
+      std::map<Variable, int>::const_iterator it = stateIndex.find(variable);
+      if(it!=stateIndex.end())
       {
-         stateMap[variable] = val;
+         stateVector(it->second) = val;
       }
       else
       {
@@ -1038,33 +1015,17 @@ covariance matrix.");
                                                 const double& cov)
       throw(InvalidRequest)
    {  
-      std::map<Variable, VariableDataMap >::iterator it1 = covarianceMap.find(var1);
-      if(it1!=covarianceMap.end())
+      std::map<Variable, int>::const_iterator it1 = stateIndex.find(var1);
+      std::map<Variable, int>::const_iterator it2 = stateIndex.find(var2);
+      if( it1 == stateIndex.end() || it2 == stateIndex.end() )
       {
-         VariableDataMap::iterator it2 = it1->second.find(var2);
-         if(it2!=it1->second.end())
-         {
-            covarianceMap[var1][var2] = cov;
-            return (*this);
-         }
-         else
-         {
-            it1 = covarianceMap.find(var2);
-            if(it1!=covarianceMap.end())
-            {
-               it2 = it1->second.find(var1);
-               if(it2!=it1->second.end())
-               {
-                  covarianceMap[var2][var1] = cov;
-                  return (*this);
-               }
-            }
-         }
+         InvalidRequest e("The input variables are not exist in the solver.");
+         GPSTK_THROW(e);
       }
 
-      // One code go here, we failed to find the value, and throw exception.
-      InvalidRequest e("The input variables are not exist in the solver.");
-      GPSTK_THROW(e);
+         // Keep the matrix symmetric
+      stateCovariance(it1->second, it2->second) = cov;
+      stateCovariance(it2->second, it1->second) = cov;
       
       return (*this);
    }
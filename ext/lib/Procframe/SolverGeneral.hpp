@@ -523,18 +523,29 @@ namespace gpstk
       Vector<double> measVector;
 
 
-         /// Map holding state information
-      VariableDataMap stateMap;
+         /// Unknowns of the last solution, and their index in 'stateVector'
+         /// and 'stateCovariance'
+      std::map<Variable, int> stateIndex;
 
 
-         /// Map holding covariance information
-      std::map<Variable, VariableDataMap > covarianceMap;
+         /// Vector holding state information
+      Vector<double> stateVector;
+
+
+         /// Matrix holding covariance information
+      Matrix<double> stateCovariance;
 
 
          /// General Kalman filter object
       SimpleKalmanFilter kFilter;
 
 
+         /// Adapt 'stateIndex', 'stateVector' and 'stateCovariance' to the
+         /// unknowns being processed, changing only the rows and columns of
+         /// the unknowns that appeared or disappeared
+      void updateState( const VariableSet& unkSet );
+
+
          /// Boolean indicating if this filter was run at least once
       bool firstTime;
 
@@ -106,12 +106,11 @@ of designMatrix");
          GPSTK_THROW(e);
       }
 
-      Matrix<double> AT = transpose(designMatrix);
       covMatrix.resize(gCol, gCol);
       solution.resize(gCol);
 
          // Temporary storage for covMatrix. It will be inverted later
-      covMatrix = AT * designMatrix;
+      normalInto(covMatrix, designMatrix);
 
       // Let's try to invert AT*A   matrix
       try
@@ -125,7 +124,9 @@ of designMatrix");
       }
 
          // Now, compute the Vector holding the solution...
-      solution = covMatrix * AT * prefitResiduals;
+      Vector<double> ATy;
+      transposeMultiplyInto(ATy, designMatrix, prefitResiduals);
+      multiplyInto(solution, covMatrix, ATy);
 
          // ... and the postfit residuals Vector
       postfitResiduals = prefitResiduals - designMatrix * solution;
@@ -237,33 +237,14 @@ of qMatrix");
          GPSTK_THROW(e);
       }
 
-         // After checking sizes, let's invert the matrix of weights in order
-         // to get the measurements noise covariance matrix, which is what we
-         // use in the "SimpleKalmanFilter" class
-      Matrix<double> measNoiseMatrix;
-
+         // Call the Kalman filter object.
       try
       {
-         measNoiseMatrix = inverseChol(weightMatrix);
-      }
-      catch(...)
-      {
-         InvalidSolver e("Correct(): Unable to compute measurements noise \
-covariance matrix.");
-         GPSTK_THROW(e);
-      }
-
-
-      try
-      {
-
-            // Call the Kalman filter object.
-         kFilter.Compute( phiMatrix,
-                          qMatrix,
-                          prefitResiduals,
-                          designMatrix,
-                          measNoiseMatrix );
-
+         kFilter.ComputeWeighted( phiMatrix,
+                                  qMatrix,
+                                  prefitResiduals,
+                                  designMatrix,
+                                  weightMatrix );
       }
       catch(InvalidSolver& e)
       {
@@ -643,6 +624,9 @@ covariance matrix.");
 
          }  // End of 'if(firstTime)'
 
+            // Keep the starting point, for the predicted state
+         priorState = kFilter.xhat;
+         priorCovariance = kFilter.P;
 
 
             // Call the Compute() method with the defined equation model.
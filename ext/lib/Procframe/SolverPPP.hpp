@@ -482,6 +482,20 @@ namespace gpstk
       { qMatrix = pMatrix; return (*this); };
 
 
+         /** Get the state predicted for the last epoch processed, before
+          *  its measurements were used. Unknowns are ordered as in
+          *  'solution'.
+          */
+      virtual Vector<double> getPredictedState(void) const
+      { return phiMatrix * priorState; };
+
+
+         /// Get the covariance matrix of the state predicted for the last
+         /// epoch processed, before its measurements were used.
+      virtual Matrix<double> getPredictedCovariance(void) const
+      { return phiMatrix * priorCovariance * transpose(phiMatrix) + qMatrix; };
+
+
          /** Set the positioning mode, kinematic or static.
           */
       virtual SolverPPP& setKinematic( bool kinematicMode = true,
@@ -594,6 +608,12 @@ namespace gpstk
       SimpleKalmanFilter kFilter;
 
 
+         /// State and covariance matrix the filter started from in the
+         /// last epoch processed
+      Vector<double> priorState;
+      Matrix<double> priorCovariance;
+
+
          /// Initializing method.
       void Init(void);
 
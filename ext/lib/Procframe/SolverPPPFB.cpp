@@ -42,10 +42,108 @@
 
 #include "SolverPPPFB.hpp"
 
+#include <cmath>
+#include <cstring>
+
 
 namespace gpstk
 {
 
+      // Append the bytes of 'value' to 'buffer'
+   template <class T>
+   static void put( std::vector<char>& buffer, const T& value )
+   {
+      const char* p( reinterpret_cast<const char*>(&value) );
+      buffer.insert( buffer.end(), p, p + sizeof(T) );
+   }
+
+
+      // Read 'value' from 'p', and advance 'p'
+   template <class T>
+   static void take( const char*& p, T& value )
+   {
+      std::memcpy( &value, p, sizeof(T) );
+      p += sizeof(T);
+   }
+
+
+      // Append a set of satellites to 'buffer'
+   static void putSats( std::vector<char>& buffer, const SatIDSet& sats )
+   {
+      put( buffer, int(sats.size()) );
+      for( SatIDSet::const_iterator it = sats.begin(); it != sats.end(); ++it )
+      {
+         put( buffer, int((*it).system) );
+         put( buffer, (*it).id );
+      }
+   }
+
+
+      // Read a set of satellites from 'p', and advance 'p'
+   static void takeSats( const char*& p, std::vector<SatID>& sats )
+   {
+      int size;
+      take( p, size );
+      sats.resize(size);
+      for( int i = 0; i < size; i++ )
+      {
+         int system;
+         take( p, system );
+         take( p, sats[i].id );
+         sats[i].system = SatID::SatelliteSystem(system);
+      }
+   }
+
+
+      // Append a vector to 'buffer'
+   static void putVector( std::vector<char>& buffer, const Vector<double>& v )
+   {
+      for( size_t i = 0; i < v.size(); i++ )
+      {
+         put( buffer, v(i) );
+      }
+   }
+
+
+      // Read a vector of size 'n' from 'p', and advance 'p'
+   static void takeVector( const char*& p, size_t n, Vector<double>& v )
+   {
+      v.resize(n);
+      for( size_t i = 0; i < n; i++ )
+      {
+         take( p, v(i) );
+      }
+   }
+
+
+      // Append the upper triangle of a symmetric matrix to 'buffer'
+   static void putSymmetric( std::vector<char>& buffer, const Matrix<double>& m )
+   {
+      for( size_t i = 0; i < m.rows(); i++ )
+      {
+         for( size_t j = i; j < m.cols(); j++ )
+         {
+            put( buffer, m(i,j) );
+         }
+      }
+   }
+
+
+      // Read a symmetric 'n' x 'n' matrix from 'p', and advance 'p'
+   static void takeSymmetric( const char*& p, size_t n, Matrix<double>& m )
+   {
+      m.resize(n, n);
+      for( size_t i = 0; i < n; i++ )
+      {
+         for( size_t j = i; j < n; j++ )
+         {
+            take( p, m(i,j) );
+            m(j,i) = m(i,j);
+         }
+      }
+   }
+
+
       // Returns a string identifying this object.
    std::string SolverPPPFB::getClassName() const
    { return "SolverPPPFB"; }
@@ -57,7 +155,7 @@ namespace gpstk
        *                 if false (the default), will compute dx, dy, dz.
        */
    SolverPPPFB::SolverPPPFB(bool useNEU)
-      : firstIteration(true)
+      : firstIteration(true), smoothing(false), smoothedIndex(0)
    {
 
          // Initialize the counter of processed measurements
@@ -70,28 +168,7 @@ namespace gpstk
       SolverPPP::setNEU(useNEU);
 
          // Indicate the TypeID's that we want to keep
-      keepTypeSet.insert(TypeID::wetMap);
-
-      if (useNEU)
-      {
-         keepTypeSet.insert(TypeID::dLat);
-         keepTypeSet.insert(TypeID::dLon);
-         keepTypeSet.insert(TypeID::dH);
-      }
-      else
-      {
-         keepTypeSet.insert(TypeID::dx);
-         keepTypeSet.insert(TypeID::dy);
-         keepTypeSet.insert(TypeID::dz);
-      }
-
-      keepTypeSet.insert(TypeID::cdt);
-      keepTypeSet.insert(TypeID::prefitC);
-      keepTypeSet.insert(TypeID::prefitL);
-      keepTypeSet.insert(TypeID::weight);
-      keepTypeSet.insert(TypeID::CSL1);
-      keepTypeSet.insert(TypeID::satArc);
-
+      setKeepTypes(useNEU);
 
    }  // End of 'SolverPPPFB::SolverPPPFB()'
 
@@ -156,15 +233,45 @@ namespace gpstk
          if(firstIteration)
          {
 
-               // Create a new gnssRinex structure with just the data we need
-            gnssRinex gBak(gData.extractTypeID(keepTypeSet));
-
-               // Store observation data
-            ObsData.push_back(gBak);
+               // Store observation data. Only the types in 'keepTypeSet'
+               // are kept
+            ObsData.push_back(gData);
 
             // Update the number of processed measurements
             processedMeasurements += gData.numSats();
 
+            SatIDSet currSatSet( gData.body.getSatID() );
+
+               // Record the filter state, for 'Smooth()'
+            if(smoothing)
+            {
+
+                  // The unknowns are the satellites in view in this epoch
+                  // and in the previous one
+               SatIDSet sats( lastSatSet );
+               sats.insert( currSatSet.begin(), currSatSet.end() );
+
+               Matrix<double> phi( getPhiMatrix() );
+               Vector<double> phiDiag( phi.rows() );
+               for( size_t i = 0; i < phi.rows(); i++ )
+               {
+                  phiDiag(i) = phi(i,i);
+               }
+
+               std::vector<char> record;
+               putSats( record, sats );
+               putVector( record, solution );
+               putSymmetric( record, covMatrix );
+               putVector( record, getPredictedState() );
+               putSymmetric( record, getPredictedCovariance() );
+               putVector( record, phiDiag );
+
+               filterData.push_back(record);
+
+            }
+
+            lastSatSet = currSatSet;
+
          }
 
          return gData;
@@ -208,14 +315,16 @@ namespace gpstk
       try
       {
 
-         std::list<gnssRinex>::iterator pos;
-         std::list<gnssRinex>::reverse_iterator rpos;
+            // Results of a previous 'Smooth()' call are no longer valid
+         filterData.clear();
+         smoothedData.clear();
+         smoothedIndex = 0;
 
             // Backwards iteration. We must do this at least once
-         for (rpos = ObsData.rbegin(); rpos != ObsData.rend(); ++rpos)
+         for (size_t pos = ObsData.size(); pos > 0; --pos)
          {
 
-            SolverPPP::Process( (*rpos) );
+            reProcessEpoch( pos - 1, false, 0.0, 0.0 );
 
          }
 
@@ -224,15 +333,15 @@ namespace gpstk
          {
 
                // Forwards iteration
-            for (pos = ObsData.begin(); pos != ObsData.end(); ++pos)
+            for (size_t pos = 0; pos < ObsData.size(); ++pos)
             {
-               SolverPPP::Process( (*pos) );
+               reProcessEpoch( pos, false, 0.0, 0.0 );
             }
 
                // Backwards iteration.
-            for (rpos = ObsData.rbegin(); rpos != ObsData.rend(); ++rpos)
+            for (size_t pos = ObsData.size(); pos > 0; --pos)
             {
-               SolverPPP::Process( (*rpos) );
+               reProcessEpoch( pos - 1, false, 0.0, 0.0 );
             }
 
          }  // End of 'for (int i=0; i<(cycles-1), i++)'
@@ -279,14 +388,16 @@ namespace gpstk
       try
       {
 
-         std::list<gnssRinex>::iterator pos;
-         std::list<gnssRinex>::reverse_iterator rpos;
+            // Results of a previous 'Smooth()' call are no longer valid
+         filterData.clear();
+         smoothedData.clear();
+         smoothedIndex = 0;
 
             // Backwards iteration. We must do this at least once
-         for (rpos = ObsData.rbegin(); rpos != ObsData.rend(); ++rpos)
+         for (size_t pos = ObsData.size(); pos > 0; --pos)
          {
 
-            SolverPPP::Process( (*rpos) );
+            reProcessEpoch( pos - 1, false, 0.0, 0.0 );
 
          }
 
@@ -324,24 +435,16 @@ namespace gpstk
             }
 
 
-               // Forwards iteration
-            for (pos = ObsData.begin(); pos != ObsData.end(); ++pos)
+               // Forwards iteration, checking limits
+            for (size_t pos = 0; pos < ObsData.size(); ++pos)
             {
-                  // Let's check limits
-               checkLimits( (*pos), codeLimit, phaseLimit );
-
-                  // Process data
-               SolverPPP::Process( (*pos) );
+               reProcessEpoch( pos, true, codeLimit, phaseLimit );
             }
 
-               // Backwards iteration.
-            for (rpos = ObsData.rbegin(); rpos != ObsData.rend(); ++rpos)
+               // Backwards iteration, checking limits
+            for (size_t pos = ObsData.size(); pos > 0; --pos)
             {
-                  // Let's check limits
-               checkLimits( (*rpos), codeLimit, phaseLimit );
-
-                  // Process data
-               SolverPPP::Process( (*rpos) );
+               reProcessEpoch( pos - 1, true, codeLimit, phaseLimit );
             }
 
          }  // End of 'for (int i=0; i<(cycles-1), i++)'
@@ -426,19 +529,28 @@ namespace gpstk
          if( !(ObsData.empty()) )
          {
 
-               // Get the first data epoch in 'ObsData' and process it. The
-               // result will be stored in 'gData'
-            gData = SolverPPP::Process( ObsData.front() );
+               // Get the first data epoch in 'ObsData'
+            ObsData.get(0, gData);
 
                // Remove the first data epoch in 'ObsData', freeing some
                // memory and preparing for next epoch
             ObsData.pop_front();
 
+            if( smoothedIndex > 0 )
+            {
+                  // Take the smoothed solution of this epoch
+               lastSmoothed(gData);
+            }
+            else
+            {
+                  // Process it. The result will be stored in 'gData'
+               SolverPPP::Process(gData);
 
-               // Update some inherited fields
-            solution = SolverPPP::solution;
-            covMatrix = SolverPPP::covMatrix;
-            postfitResiduals = SolverPPP::postfitResiduals;
+                  // Update some inherited fields
+               solution = SolverPPP::solution;
+               covMatrix = SolverPPP::covMatrix;
+               postfitResiduals = SolverPPP::postfitResiduals;
+            }
 
                // If everything is fine so far, then results should be valid
             valid = true;
@@ -469,6 +581,286 @@ namespace gpstk
 
 
 
+      /* Smooth the solutions of the epochs stored during a previous
+       * 'Process()' call, with a fixed-interval Rauch-Tung-Striebel
+       * smoother. The following 'LastProcess()' calls return the
+       * smoothed solutions.
+       */
+   void SolverPPPFB::Smooth( void )
+      throw(ProcessingException)
+   {
+
+      if( filterData.size() == 0 || filterData.size() != ObsData.size() )
+      {
+         ProcessingException e( getClassName() + ": No filter states were \
+recorded. Call setSmoothing(true) before Process()." );
+
+         GPSTK_THROW(e);
+      }
+
+         // This will prevent further storage of input data when calling
+         // method 'Process()'
+      firstIteration = false;
+
+      try
+      {
+
+         const size_t numVar( defaultEqDef.body.size() );
+
+            // The records are read backwards from here on
+         filterData.mapSpill();
+         smoothedData.clear();
+
+         std::vector<char> record;
+         std::vector<char> smoothedRecord;
+         const char* p;
+
+            // The smoothed solution of the last epoch is the filtered one
+         std::vector<SatID> sats1;
+         Vector<double> xs1;
+         Matrix<double> Ps1;
+         size_t k( filterData.size() - 1 );
+         filterData.get(k, record);
+         p = &record[0];
+         takeSats( p, sats1 );
+         size_t n1( numVar + sats1.size() );
+         takeVector( p, n1, xs1 );
+         takeSymmetric( p, n1, Ps1 );
+
+         smoothedRecord.clear();
+         putSats( smoothedRecord, SatIDSet(sats1.begin(), sats1.end()) );
+         putVector( smoothedRecord, xs1 );
+         putSymmetric( smoothedRecord, Ps1 );
+         smoothedData.push_back(smoothedRecord);
+
+         while( k > 0 )
+         {
+
+               // Predicted state of epoch 'k', and its transition
+            Vector<double> xm1, phi1;
+            Matrix<double> Pm1;
+            p = &record[0];
+            takeSats( p, sats1 );
+            n1 = numVar + sats1.size();
+            p += ( n1 + n1*(n1+1)/2 ) * sizeof(double);
+            takeVector( p, n1, xm1 );
+            takeSymmetric( p, n1, Pm1 );
+            takeVector( p, n1, phi1 );
+
+            filterData.release(k);
+            --k;
+
+               // Filtered state of epoch 'k-1'
+            std::vector<SatID> sats0;
+            Vector<double> x0;
+            Matrix<double> P0;
+            filterData.get(k, record);
+            p = &record[0];
+            takeSats( p, sats0 );
+            const size_t n0( numVar + sats0.size() );
+            takeVector( p, n0, x0 );
+            takeSymmetric( p, n0, P0 );
+
+               // Transition from epoch 'k-1' to epoch 'k'. Ambiguities of
+               // satellites not processed in epoch 'k-1' do not depend on
+               // its state
+            Matrix<double> A( n1, n0, 0.0 );
+            for( size_t i = 0; i < numVar; i++ )
+            {
+               A(i,i) = phi1(i);
+            }
+
+            size_t j(0);
+            for( size_t i = 0; i < sats1.size(); i++ )
+            {
+               while( j < sats0.size() && sats0[j] < sats1[i] )
+               {
+                  ++j;
+               }
+
+               if( j < sats0.size() && sats0[j] == sats1[i] )
+               {
+                  A(numVar + i, numVar + j) = phi1(numVar + i);
+               }
+            }
+
+               // Invert the predicted covariance matrix scaled to unit
+               // diagonal, because ambiguity and coordinate variances
+               // differ by many orders of magnitude
+            Vector<double> scale(n1);
+            for( size_t i = 0; i < n1; i++ )
+            {
+               scale(i) = ( Pm1(i,i) > 0.0 ) ? 1.0 / std::sqrt(Pm1(i,i)) : 1.0;
+            }
+
+            Matrix<double> scaled(n1, n1);
+            for( size_t i = 0; i < n1; i++ )
+            {
+               for( size_t m = 0; m < n1; m++ )
+               {
+                  scaled(i,m) = Pm1(i,m) * scale(i) * scale(m);
+               }
+            }
+
+            Matrix<double> invPm1( inverseChol(scaled) );
+            for( size_t i = 0; i < n1; i++ )
+            {
+               for( size_t m = 0; m < n1; m++ )
+               {
+                  invPm1(i,m) *= scale(i) * scale(m);
+               }
+            }
+
+               // Smoother gain, state and covariance
+            Matrix<double> C( P0 * transpose(A) * invPm1 );
+            Vector<double> xs0( x0 + C * (xs1 - xm1) );
+            Matrix<double> Ps0( P0 + C * (Ps1 - Pm1) * transpose(C) );
+
+            smoothedRecord.clear();
+            putSats( smoothedRecord, SatIDSet(sats0.begin(), sats0.end()) );
+            putVector( smoothedRecord, xs0 );
+            putSymmetric( smoothedRecord, Ps0 );
+            smoothedData.push_back(smoothedRecord);
+
+            xs1 = xs0;
+            Ps1 = Ps0;
+
+         }  // End of 'while( k > 0 )'
+
+         filterData.clear();
+
+            // 'smoothedData' holds the epochs backwards
+         smoothedIndex = smoothedData.size();
+
+         return;
+
+      }
+      catch(Exception& u)
+      {
+            // Throw an exception if something unexpected happens
+         ProcessingException e( getClassName() + ":"
+                                + u.what() );
+
+         GPSTK_THROW(e);
+
+      }
+
+   }  // End of method 'SolverPPPFB::Smooth()'
+
+
+
+      // Take the smoothed solution of the epoch in 'gData', and compute its
+      // postfit residuals.
+   void SolverPPPFB::lastSmoothed( gnssRinex& gData )
+   {
+
+      --smoothedIndex;
+
+      std::vector<char> record;
+      smoothedData.get(smoothedIndex, record);
+      smoothedData.release(smoothedIndex);
+
+      const size_t numVar( defaultEqDef.body.size() );
+
+      std::vector<SatID> sats;
+      const char* p( &record[0] );
+      takeSats( p, sats );
+      const size_t numUnknowns( numVar + sats.size() );
+      takeVector( p, numUnknowns, solution );
+      takeSymmetric( p, numUnknowns, covMatrix );
+
+         // Postfit residuals, with the same layout as 'SolverPPP'
+      const size_t numCurrentSV( gData.numSats() );
+      Vector<double> prefitCode( gData.getVectorOfTypeID(TypeID::prefitC) );
+      Vector<double> prefitPhase( gData.getVectorOfTypeID(TypeID::prefitL) );
+      Matrix<double> dMatrix( gData.body.getMatrixOfTypes(defaultEqDef.body) );
+
+      Vector<double> postfitCode(numCurrentSV, 0.0);
+      Vector<double> postfitPhase(numCurrentSV, 0.0);
+      postfitResiduals.resize(2 * numCurrentSV);
+
+      size_t i(0);
+      size_t j(0);
+      for( satTypeValueMap::const_iterator it = gData.body.begin();
+           it != gData.body.end();
+           ++it )
+      {
+
+         double model(0.0);
+         for( size_t v = 0; v < numVar; v++ )
+         {
+            model += dMatrix(i,v) * solution(v);
+         }
+
+            // Find the ambiguity of this satellite
+         while( j < sats.size() && sats[j] < (*it).first )
+         {
+            ++j;
+         }
+
+         postfitCode(i)  = prefitCode(i) - model;
+         postfitPhase(i) = prefitPhase(i) - model - solution(numVar + j);
+
+         postfitResiduals(i)                = postfitCode(i);
+         postfitResiduals(i + numCurrentSV) = postfitPhase(i);
+
+         ++i;
+      }
+
+      gData.insertTypeIDVector(TypeID::postfitC, postfitCode);
+      gData.insertTypeIDVector(TypeID::postfitL, postfitPhase);
+
+   }  // End of method 'SolverPPPFB::lastSmoothed()'
+
+
+
+      // Run the filter over the stored epoch 'index', and store the
+      // epoch back.
+   void SolverPPPFB::reProcessEpoch( size_t index,
+                                     bool check,
+                                     double codeLimit,
+                                     double phaseLimit )
+   {
+
+      gnssRinex gData;
+      ObsData.get(index, gData);
+
+      if(check)
+      {
+            // Let's check limits
+         checkLimits( gData, codeLimit, phaseLimit );
+      }
+
+         // Process data, and keep the new postfit residuals
+      SolverPPP::Process(gData);
+      ObsData.set(index, gData);
+
+   }  // End of method 'SolverPPPFB::reProcessEpoch()'
+
+
+
+      /* Sets the number of bytes of stored epochs, and of recorded filter
+       * states, kept in memory. Beyond that, they are written to
+       * temporary files.
+       *
+       * @param bytes      Memory threshold of each store.
+       * @param dir        Directory of the temporary files. If empty, the
+       *                   system default is used.
+       */
+   SolverPPPFB& SolverPPPFB::setSpillThreshold( size_t bytes,
+                                                const std::string& dir )
+   {
+
+      ObsData.setSpillThreshold(bytes, dir);
+      filterData.setSpillThreshold(bytes, dir);
+      smoothedData.setSpillThreshold(bytes, dir);
+
+      return (*this);
+
+   }  // End of method 'SolverPPPFB::setSpillThreshold()'
+
+
+
       // This method checks the limits and modifies 'gData' accordingly.
    void SolverPPPFB::checkLimits( gnssRinex& gData,
                                   double codeLimit,
@@ -523,6 +915,21 @@ namespace gpstk
       SolverPPP::setNEU(useNEU);
 
 
+         // Indicate the TypeID's that we want to keep
+      setKeepTypes(useNEU);
+
+
+         // Return this object
+      return (*this);
+
+   }  // End of method 'SolverPPPFB::setNEU()'
+
+
+
+      // Update 'keepTypeSet' with the types used by the solver.
+   void SolverPPPFB::setKeepTypes( bool useNEU )
+   {
+
          // Clear current 'keepTypeSet' and indicate the TypeID's that
          // we want to keep
       keepTypeSet.clear();
@@ -550,10 +957,16 @@ namespace gpstk
       keepTypeSet.insert(TypeID::satArc);
 
 
-         // Return this object
-      return (*this);
+         // Stored epochs also keep the postfit residuals of the last
+         // iteration, for 'checkLimits()'
+      TypeIDSet storeTypes( keepTypeSet );
+      storeTypes.insert(TypeID::postfitC);
+      storeTypes.insert(TypeID::postfitL);
+      ObsData.setTypeSet(storeTypes);
 
-   }  // End of method 'SolverPPPFB::setNEU()'
+      return;
+
+   }  // End of method 'SolverPPPFB::setKeepTypes()'
 
 
 }  // End of namespace gpstk
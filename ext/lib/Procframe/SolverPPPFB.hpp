@@ -44,6 +44,8 @@
 #define GPSTK_SOLVERPPPFB_HPP
 
 #include "SolverPPP.hpp"
+#include "GnssRinexStore.hpp"
+#include "RecordStore.hpp"
 #include <list>
 #include <set>
 
@@ -286,6 +288,36 @@ namespace gpstk
        *
        * @endcode
        *
+       * Instead of the forwards-backwards cycles, the solver may work as a
+       * fixed-interval Rauch-Tung-Striebel (RTS) smoother. Call
+       * "setSmoothing(true)" before the "Process()" phase, so that the filter
+       * state of each epoch is recorded, and then "Smooth()" instead of
+       * "ReProcess()". "Smooth()" runs the backwards smoothing recursion once
+       * over the recorded states, without filtering the data again, and
+       * "LastProcess()" then returns the smoothed solution of each epoch:
+       *
+       * @code
+       *   pppSolver.setSmoothing(true);
+       *
+       *   while(rin >> gRin)
+       *   {
+       *      // Preprocessing here...
+       *      pppSolver.Process(gRin);
+       *   }
+       *
+       *   pppSolver.Smooth();
+       *
+       *   while( pppSolver.LastProcess(gRin) )
+       *   {
+       *      cout << pppSolver.getSolution(TypeID::dLat) << endl;
+       *   }
+       * @endcode
+       *
+       * Stored epochs keep only the data types the solver uses, packed into
+       * compact binary records (see GnssRinexStore). For long data sets,
+       * "setSpillThreshold()" bounds the memory used: beyond it, stored
+       * epochs and recorded states are written to temporary files.
+       *
        * \warning "SolverPPPFB" is based on a Kalman filter, and Kalman filters
        * are objets that store their internal state, so you MUST NOT use the
        * SAME object to process DIFFERENT data streams.
@@ -345,6 +377,52 @@ namespace gpstk
          throw(ProcessingException);
 
 
+         /** Smooth the solutions of the epochs stored during a previous
+          *  'Process()' call, with a fixed-interval Rauch-Tung-Striebel
+          *  smoother. The following 'LastProcess()' calls return the
+          *  smoothed solutions.
+          *
+          * \warning Smoothing must be enabled with 'setSmoothing()' before
+          * the 'Process()' phase.
+          */
+      virtual void Smooth( void )
+         throw(ProcessingException);
+
+
+         /** Sets whether the filter state of each epoch is recorded during
+          *  the 'Process()' phase, for 'Smooth()'.
+          *
+          * @param smooth     Whether the smoother mode is used.
+          */
+      virtual SolverPPPFB& setSmoothing( bool smooth )
+      { smoothing = smooth; return (*this); };
+
+
+         /// Returns whether the filter state of each epoch is recorded for
+         /// 'Smooth()'.
+      virtual bool getSmoothing( void ) const
+      { return smoothing; };
+
+
+         /** Sets the number of bytes of stored epochs, and of recorded filter
+          *  states, kept in memory. Beyond that, they are written to
+          *  temporary files.
+          *
+          * @param bytes      Memory threshold of each store.
+          * @param dir        Directory of the temporary files. If empty, the
+          *                   system default is used.
+          */
+      virtual SolverPPPFB& setSpillThreshold( size_t bytes,
+                                              const std::string& dir = "" );
+
+
+         /// Returns the bytes of memory used by stored epochs and recorded
+         /// filter states.
+      virtual size_t getStoredBytes( void ) const
+      { return ObsData.memoryBytes() + filterData.memoryBytes()
+               + smoothedData.memoryBytes(); };
+
+
          /** Process the data stored during a previous 'ReProcess()' call, one
           *  item at a time, and always in forward mode.
           *
@@ -462,8 +540,32 @@ namespace gpstk
       bool firstIteration;
 
 
-         /// List holding the information regarding every observation.
-      std::list<gnssRinex> ObsData;
+         /// Store holding the information regarding every observation.
+      GnssRinexStore ObsData;
+
+
+         /// Whether the filter state of each epoch is recorded for 'Smooth()'
+      bool smoothing;
+
+
+         /// Filter state recorded for each epoch: unknown satellites,
+         /// filtered and predicted states and covariance matrices, and
+         /// state transition matrix.
+      RecordStore filterData;
+
+
+         /// Smoothed state and covariance matrix of each epoch.
+      RecordStore smoothedData;
+
+
+         /// Number of smoothed epochs left for 'LastProcess()'. They are
+         /// stored backwards in 'smoothedData'.
+      size_t smoothedIndex;
+
+
+         /// Satellites in view in the previous epoch of the 'Process()'
+         /// phase.
+      SatIDSet lastSatSet;
 
 
          /// Set storing the TypeID's that we want to keep.
@@ -490,6 +592,21 @@ namespace gpstk
       void checkLimits( gnssRinex& gData, double codeLimit, double phaseLimit );
 
 
+         /// Take the smoothed solution of the epoch in 'gData', and compute
+         /// its postfit residuals.
+      void lastSmoothed( gnssRinex& gData );
+
+
+         /// Run the filter over the stored epoch 'index', and store the
+         /// epoch back.
+      void reProcessEpoch( size_t index, bool check,
+                           double codeLimit, double phaseLimit );
+
+
+         /// Update 'keepTypeSet' with the types used by the solver.
+      void setKeepTypes( bool useNEU );
+
+
          // Some methods that we want to hide
       virtual int Compute( const Vector<double>& prefitResiduals,
                            const Matrix<double>& designMatrix )
@@ -182,13 +182,13 @@ of designMatrix");
          GPSTK_THROW(e);
       }
 
-      Matrix<double> AT = transpose(designMatrix);
       covMatrix.resize(gCol, gCol);
       covMatrixNoWeight.resize(gCol, gCol);
       solution.resize(gCol);
 
          // Temporary storage for covMatrix. It will be inverted later
-      covMatrix = AT * weightMatrix * designMatrix;
+      Matrix<double> WA;
+      normalInto(covMatrix, designMatrix, weightMatrix, WA);
 
          // Let's try to invert AT*W*A  matrix
       try { 
@@ -201,7 +201,7 @@ of designMatrix");
       }
 
          // Temporary storage for covMatrixNoWeight. It will be inverted later
-      covMatrixNoWeight = AT * designMatrix;
+      normalInto(covMatrixNoWeight, designMatrix);
 
          // Let's try to invert AT*A  matrix
       try { 
@@ -214,7 +214,10 @@ of designMatrix");
       }
 
          // Now, compute the Vector holding the solution...
-      solution = covMatrix * AT * weightMatrix * prefitResiduals;
+      Vector<double> Wy, ATWy;
+      multiplyInto(Wy, weightMatrix, prefitResiduals);
+      transposeMultiplyInto(ATWy, designMatrix, Wy);
+      multiplyInto(solution, covMatrix, ATWy);
 
          // ... and the postfit residuals Vector
       postfitResiduals = prefitResiduals - designMatrix * solution;
@@ -0,0 +1,458 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+
+/**
+ * @file StationProcessingPool.cpp
+ * Run the processing chain of each station of a network on a pool of
+ * threads.
+ */
+
+#include <sstream>
+#include "StationProcessingPool.hpp"
+
+namespace gpstk
+{
+
+   StationProcessingPool::StationProcessingPool( unsigned threads )
+      : nextTask(0), unfinished(0), numThreads(threads),
+        started(false), stopping(false), lastConcurrent(false)
+   {}
+
+
+   StationProcessingPool::~StationProcessingPool()
+   {
+      stop();
+   }
+
+
+      // Set the processing chain of a station.
+   StationProcessingPool& StationProcessingPool::addStation(
+                                                   const SourceID& source,
+                                                   ProcessingClass& pClass )
+   {
+      chains[source] = &pClass;
+      return (*this);
+   }
+
+
+      // Register an ephemeris store read by the chains of several stations.
+   StationProcessingPool& StationProcessingPool::addSharedStore(
+                                                   XvtStore<SatID>& store )
+   {
+      stores.push_back(&store);
+      return (*this);
+   }
+
+
+      // Set the number of threads, counting the calling thread.
+   StationProcessingPool& StationProcessingPool::setNumThreads(
+                                                   unsigned threads )
+   {
+      stop();
+      numThreads = threads;
+      stopping = false;
+      return (*this);
+   }
+
+
+      // Process all the data in 'gData'.
+   gnssDataMap& StationProcessingPool::Process( gnssDataMap& gData )
+   {
+
+         // One task per station, with its epochs in time order
+      std::vector<Task> newTasks;
+      std::map<SourceID, size_t> taskOf;
+      for( gnssDataMap::iterator it = gData.begin();
+           it != gData.end();
+           ++it )
+      {
+         for( sourceDataMap::iterator itSrc = (*it).second.begin();
+              itSrc != (*it).second.end();
+              ++itSrc )
+         {
+            std::map<SourceID, ProcessingClass*>::const_iterator itChain(
+                                             chains.find( (*itSrc).first ) );
+            if( itChain == chains.end() )
+            {
+               continue;
+            }
+
+            std::map<SourceID, size_t>::iterator itTask(
+                                             taskOf.find( (*itSrc).first ) );
+            if( itTask == taskOf.end() )
+            {
+               itTask = taskOf.insert( std::make_pair( (*itSrc).first,
+                                                       newTasks.size() ) ).first;
+               newTasks.push_back( Task() );
+               newTasks.back().chain = (*itChain).second;
+               newTasks.back().source = (*itSrc).first;
+            }
+
+            Task& task( newTasks[(*itTask).second] );
+            task.epochs.push_back( (*it).first );
+            task.bodies.push_back( &(*itSrc).second );
+         }
+      }
+
+      {
+         MutexLock lock(mutex);
+         tasks.swap(newTasks);
+         nextTask = tasks.size();
+      }
+
+      runTasks();
+
+         // Remove the data dropped
+      for( size_t t = 0; t < tasks.size(); ++t )
+      {
+         const Task& task( tasks[t] );
+         for( size_t d = 0; d < task.dropped.size(); ++d )
+         {
+            const size_t k( task.dropped[d] );
+
+            std::pair<gnssDataMap::iterator, gnssDataMap::iterator>
+               range( gData.equal_range( task.epochs[k] ) );
+            for( gnssDataMap::iterator it = range.first;
+                 it != range.second;
+                 ++it )
+            {
+               sourceDataMap::iterator itSrc( (*it).second.find(task.source) );
+               if( itSrc != (*it).second.end() &&
+                   &(*itSrc).second == task.bodies[k] )
+               {
+                  (*it).second.erase(itSrc);
+                  if( (*it).second.empty() )
+                  {
+                     gData.erase(it);
+                  }
+                  break;
+               }
+            }
+         }
+      }
+
+      return gData;
+
+   }  // End of method 'StationProcessingPool::Process()'
+
+
+      // Process a set of gnssRinex objects.
+   std::vector<gnssRinex>& StationProcessingPool::Process(
+                                             std::vector<gnssRinex>& gData )
+   {
+
+         // One task per station, with its objects in order
+      std::vector<Task> newTasks;
+      std::map<SourceID, size_t> taskOf;
+      for( size_t i = 0; i < gData.size(); ++i )
+      {
+         const SourceID& source( gData[i].header.source );
+
+         std::map<SourceID, ProcessingClass*>::const_iterator itChain(
+                                                      chains.find(source) );
+         if( itChain == chains.end() )
+         {
+            continue;
+         }
+
+         std::map<SourceID, size_t>::iterator itTask( taskOf.find(source) );
+         if( itTask == taskOf.end() )
+         {
+            itTask = taskOf.insert( std::make_pair( source,
+                                                    newTasks.size() ) ).first;
+            newTasks.push_back( Task() );
+            newTasks.back().chain = (*itChain).second;
+            newTasks.back().source = source;
+         }
+
+         newTasks[(*itTask).second].rinex.push_back( &gData[i] );
+      }
+
+      {
+         MutexLock lock(mutex);
+         tasks.swap(newTasks);
+         nextTask = tasks.size();
+      }
+
+      runTasks();
+
+         // Remove the objects dropped, keeping the order of the others
+      std::vector<bool> drop( gData.size(), false );
+      bool anyDropped(false);
+      for( size_t t = 0; t < tasks.size(); ++t )
+      {
+         const Task& task( tasks[t] );
+         for( size_t d = 0; d < task.dropped.size(); ++d )
+         {
+            drop[ task.rinex[ task.dropped[d] ] - &gData[0] ] = true;
+            anyDropped = true;
+         }
+      }
+
+      if( anyDropped )
+      {
+         size_t kept(0);
+         for( size_t i = 0; i < gData.size(); ++i )
+         {
+            if( !drop[i] )
+            {
+               if( kept != i )
+               {
+                  gData[kept].header = gData[i].header;
+                  gData[kept].body.swap( gData[i].body );
+               }
+               ++kept;
+            }
+         }
+         gData.resize(kept);
+      }
+
+      return gData;
+
+   }  // End of method 'StationProcessingPool::Process()'
+
+
+      // Run every task in 'tasks', concurrently if possible.
+   void StationProcessingPool::runTasks(void)
+   {
+
+      errorTexts.clear();
+      lastConcurrent = false;
+
+      bool concurrent( numThreads > 1 && tasks.size() > 1 && !stopping );
+
+         // Every shared store must allow concurrent reads
+      size_t begun(0);
+      while( concurrent && begun < stores.size() )
+      {
+         concurrent = stores[begun]->beginConcurrentReads();
+         ++begun;
+      }
+
+      if( concurrent )
+      {
+         start();
+         concurrent = ( threads.size() > 0 );
+      }
+
+      if( concurrent )
+      {
+         MutexLock lock(mutex);
+         nextTask = 0;
+         unfinished = tasks.size();
+         workReady.broadcast();
+
+            // This thread takes tasks too
+         runAvailable();
+
+         while( unfinished > 0 )
+         {
+            workDone.wait(mutex);
+         }
+
+         lastConcurrent = true;
+      }
+      else
+      {
+         for( size_t t = 0; t < tasks.size(); ++t )
+         {
+            processTask( tasks[t] );
+         }
+      }
+
+      for( size_t i = 0; i < begun; ++i )
+      {
+         stores[i]->endConcurrentReads();
+      }
+
+      for( size_t t = 0; t < tasks.size(); ++t )
+      {
+         errorTexts.insert( errorTexts.end(),
+                            tasks[t].errors.begin(),
+                            tasks[t].errors.end() );
+      }
+
+   }  // End of method 'StationProcessingPool::runTasks()'
+
+
+      // Process the data of one station.
+   void StationProcessingPool::processTask(Task& task)
+   {
+
+      gnssRinex gRin;
+      const size_t size( task.rinex.empty() ? task.epochs.size()
+                                            : task.rinex.size() );
+
+      for( size_t k = 0; k < size; ++k )
+      {
+         gnssRinex* pData( 0 );
+         if( task.rinex.empty() )
+         {
+               // The body is moved in and out of a gnssRinex, not copied
+            gRin.header = sourceEpochRinexHeader();
+            gRin.header.source = task.source;
+            gRin.header.epoch = task.epochs[k];
+            gRin.body.swap( *task.bodies[k] );
+            pData = &gRin;
+         }
+         else
+         {
+            pData = task.rinex[k];
+         }
+
+         std::string error;
+         try
+         {
+            task.chain->Process(*pData);
+         }
+         catch(Exception& e)
+         {
+            error = e.what();
+         }
+         catch(std::exception& e)
+         {
+            error = e.what();
+         }
+         catch(...)
+         {
+            error = "unknown exception";
+         }
+
+         if( task.rinex.empty() )
+         {
+            gRin.body.swap( *task.bodies[k] );
+         }
+
+         if( !error.empty() )
+         {
+            std::ostringstream oss;
+            oss << "StationProcessingPool: " << task.source << " at "
+                << pData->header.epoch << ": " << error;
+
+            task.dropped.push_back(k);
+            task.errors.push_back( oss.str() );
+         }
+      }
+
+   }  // End of method 'StationProcessingPool::processTask()'
+
+
+      // Start the pool threads if they are not running.
+   void StationProcessingPool::start(void)
+   {
+      if( started )
+      {
+         return;
+      }
+
+      started = true;
+
+         // If no thread can be started, runTasks() works alone
+      for( unsigned i = 1; i < numThreads; ++i )
+      {
+         if( !threads.start(workerMain, this) )
+         {
+            break;
+         }
+      }
+
+   }  // End of method 'StationProcessingPool::start()'
+
+
+      // Stop the pool threads.
+   void StationProcessingPool::stop(void)
+   {
+      {
+         MutexLock lock(mutex);
+         stopping = true;
+         workReady.broadcast();
+      }
+
+      threads.join();
+      started = false;
+
+   }  // End of method 'StationProcessingPool::stop()'
+
+
+   void StationProcessingPool::workerMain(void *arg)
+   {
+      static_cast<StationProcessingPool*>(arg)->work();
+   }
+
+
+   void StationProcessingPool::work(void)
+   {
+      mutex.lock();
+
+      while( !stopping )
+      {
+         if( nextTask < tasks.size() )
+         {
+            runAvailable();
+         }
+         else
+         {
+            workReady.wait(mutex);
+         }
+      }
+
+      mutex.unlock();
+
+   }  // End of method 'StationProcessingPool::work()'
+
+
+      // Take the next task and run it, until there are none left.
+   void StationProcessingPool::runAvailable(void)
+   {
+      while( nextTask < tasks.size() )
+      {
+         Task& task( tasks[nextTask] );
+         ++nextTask;
+
+         mutex.unlock();
+         processTask(task);
+         mutex.lock();
+
+         if( --unfinished == 0 )
+         {
+            workDone.broadcast();
+         }
+      }
+
+   }  // End of method 'StationProcessingPool::runAvailable()'
+
+}  // End of namespace gpstk
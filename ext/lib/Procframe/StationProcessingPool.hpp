@@ -0,0 +1,284 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+
+/**
+ * @file StationProcessingPool.hpp
+ * Run the processing chain of each station of a network on a pool of
+ * threads.
+ */
+
+#ifndef GPSTK_STATION_PROCESSING_POOL_HPP
+#define GPSTK_STATION_PROCESSING_POOL_HPP
+
+#include <map>
+#include <string>
+#include <vector>
+#include "ProcessingClass.hpp"
+#include "XvtStore.hpp"
+#include "ThreadUtils.hpp"
+
+namespace gpstk
+{
+
+      /// @ingroup GPSsolutions
+      //@{
+
+      /** This class runs the processing chain of each station of a
+       * network, usually a ProcessingList, on a pool of threads.
+       *
+       * Every station (SourceID) is given its own chain, and the data
+       * of one station are always processed by its chain in time
+       * order, by one thread at a time; different stations are
+       * processed concurrently. The results are left in the data
+       * structure given, ready for SolverGeneral:
+       *
+       * @code
+       *    StationProcessingPool pool;
+       *
+       *    pool.addSharedStore(sp3EphList);
+       *    for( int i = 0; i < numStations; i++ )
+       *    {
+       *       pool.addStation( source[i], pList[i] );
+       *    }
+       *
+       *    gnssDataMap gds;
+       *    ...   // Add one epoch of every station
+       *
+       *    pool.Process(gds);
+       *    solverGen.Process(gds);
+       * @endcode
+       *
+       * The chains of different stations run at the same time, so they
+       * must not share any object that changes while processing. That
+       * includes the processing objects themselves (cycle slip
+       * detectors, ComputeWindUp and others keep per-satellite state),
+       * the tropospheric models given to ComputeTropModel, and readers
+       * that load their data on demand, such as AntexReader and
+       * BLQDataReader: each station needs its own. Objects that are
+       * only read may be shared.
+       *
+       * Ephemeris stores are usually shared. They are registered with
+       * addSharedStore(), and each Process() call first asks them with
+       * XvtStore::beginConcurrentReads() whether they may be read by
+       * several threads at once. SP3EphemerisStore, OrbitEphStore and
+       * its derived classes, GloEphemerisStore, Rinex3EphemerisStore
+       * and OrbElemStore may be; if any registered store may not, the
+       * stations are processed one after another on the calling
+       * thread. Stores must not be modified during Process().
+       *
+       * An exception thrown by the chain of a station drops the data
+       * of that station at that epoch; getErrorTexts() tells which.
+       * Data of stations without a chain are left as they are.
+       *
+       * Process() must be called from one thread at a time. The pool
+       * threads are started by the first call and stopped by stop()
+       * or the destructor.
+       */
+   class StationProcessingPool
+   {
+   public:
+
+         /** Common constructor.
+          *
+          * @param numThreads Number of threads processing stations,
+          *                   counting the calling thread; one or zero
+          *                   processes them on the calling thread.
+          */
+      StationProcessingPool( unsigned numThreads = numProcessors() );
+
+
+         /// Destructor, stops the pool threads.
+      virtual ~StationProcessingPool();
+
+
+         /** Set the processing chain of a station.
+          *
+          * @param source     SourceID of the station.
+          * @param pClass     Processing object of the station. It is
+          *                   not copied, and must outlive this object.
+          */
+      StationProcessingPool& addStation( const SourceID& source,
+                                         ProcessingClass& pClass );
+
+
+         /// Register an ephemeris store read by the chains of several
+         /// stations. It is not copied, and must outlive this object.
+      StationProcessingPool& addSharedStore( XvtStore<SatID>& store );
+
+
+         /// Set the number of threads, counting the calling thread.
+         /// The pool threads are restarted if needed.
+      StationProcessingPool& setNumThreads( unsigned numThreads );
+
+
+         /// Get the number of threads, counting the calling thread.
+      unsigned getNumThreads(void) const
+      { return numThreads; };
+
+
+         /// Number of stations with a processing chain.
+      size_t numStations(void) const
+      { return chains.size(); };
+
+
+         /** Process all the data in 'gData', i.e., for each station with
+          *  a chain, every epoch in time order.
+          *
+          * Each station is given a gnssRinex whose header holds its
+          * SourceID and the epoch; other header fields are empty.
+          *
+          * @param gData     Data of one or more epochs of the network.
+          */
+      gnssDataMap& Process( gnssDataMap& gData );
+
+
+         /** Process a set of gnssRinex objects, usually one epoch of
+          *  each station. Several objects of one station are processed
+          *  in the order they appear in the vector. Objects dropped by
+          *  an exception are removed from the vector.
+          *
+          * @param gData     Data to be processed.
+          */
+      std::vector<gnssRinex>& Process( std::vector<gnssRinex>& gData );
+
+
+         /// Whether the last Process() call used the pool threads.
+      bool lastRunConcurrent(void) const
+      { return lastConcurrent; };
+
+
+         /// Text of the exceptions caught during the last Process()
+         /// call, one for each station and epoch dropped.
+      const std::vector<std::string>& getErrorTexts(void) const
+      { return errorTexts; };
+
+
+         /// Stop the pool threads. Later calls process on the calling
+         /// thread until setNumThreads() is called.
+      void stop(void);
+
+
+   private:
+
+
+         /// Work of one station in one Process() call.
+      struct Task
+      {
+         ProcessingClass* chain;
+         SourceID source;
+
+            /// For a gnssDataMap: epochs and bodies, in time order.
+         std::vector<CommonTime> epochs;
+         std::vector<satTypeValueMap*> bodies;
+
+            /// For a vector of gnssRinex: the objects, in order.
+         std::vector<gnssRinex*> rinex;
+
+            /// Position, in 'epochs' or 'rinex', of the data dropped.
+         std::vector<size_t> dropped;
+         std::vector<std::string> errors;
+      };
+
+
+         /// Run every task in 'tasks', concurrently if possible.
+      void runTasks(void);
+
+
+         /// Process the data of one station.
+      static void processTask(Task& task);
+
+
+         /// Start the pool threads if they are not running.
+      void start(void);
+
+
+         /// Thread entry point, calls work().
+      static void workerMain(void *arg);
+
+
+         /// Pool thread loop.
+      void work(void);
+
+
+         /** Take the next task and run it, until there are none left.
+          * Must be called with mutex held, and returns with it held. */
+      void runAvailable(void);
+
+
+         /// Chain of each station.
+      std::map<SourceID, ProcessingClass*> chains;
+
+
+         /// Stores shared by the chains.
+      std::vector< XvtStore<SatID>* > stores;
+
+
+         /// Tasks of the current Process() call.
+      std::vector<Task> tasks;
+
+
+         /// Next task to be taken, and number of tasks not finished.
+      size_t nextTask;
+      size_t unfinished;
+
+
+      unsigned numThreads;
+      bool started;
+      bool stopping;
+      bool lastConcurrent;
+      std::vector<std::string> errorTexts;
+
+
+      Mutex mutex;
+         /// Signalled when tasks are ready, or on stop().
+      Condition workReady;
+         /// Signalled when the last task is finished.
+      Condition workDone;
+      ThreadGroup threads;
+
+
+         // not copyable
+      StationProcessingPool(const StationProcessingPool&);
+      StationProcessingPool& operator=(const StationProcessingPool&);
+
+   }; // End of class 'StationProcessingPool'
+
+      //@}
+
+}  // End of namespace gpstk
+
+#endif   // GPSTK_STATION_PROCESSING_POOL_HPP
@@ -42,12 +42,18 @@
 
 #include "TypeID.hpp"
 
+#include <algorithm>
+
 
 namespace gpstk
 {
 
    std::map< TypeID::ValueType, std::string > TypeID::tStrings;
 
+   std::map< std::string, TypeID::ValueType > TypeID::tValues;
+
+   bool TypeID::registryFrozen = false;
+
 
    TypeID::Initializer TypeIDsingleton;
 
@@ -357,6 +363,14 @@ namespace gpstk
       tStrings[dummy9]     = "dummy9";
       tStrings[Last]       = "Last";
       tStrings[Placeholder]= "Placeholder";
+
+      for( std::map< ValueType, std::string >::const_iterator it =
+              tStrings.begin();
+           it != tStrings.end();
+           ++it )
+      {
+         tValues.insert( std::make_pair( (*it).second, (*it).first ) );
+      }
    }
 
 
@@ -391,15 +405,195 @@ namespace gpstk
        */
    TypeID::ValueType TypeID::newValueType(const std::string& s)
    {
+      checkNotFrozen();
+
       ValueType newId =
          static_cast<ValueType>(TypeID::tStrings.rbegin()->first + 1);
 
       TypeID::tStrings[newId] = s;
+      TypeID::tValues.insert( std::make_pair(s, newId) );
 
       return newId;
    }
 
 
+      /* Returns the TypeID whose identifying string is 's', i.e., the
+       * inverse of asString(). Names given to regByName() are also
+       * accepted.
+       */
+   TypeID TypeID::fromString(const std::string& s)
+      throw(InvalidRequest)
+   {
+      std::map< std::string, ValueType >::const_iterator it( tValues.find(s) );
+      if( it != tValues.end() )
+      {
+         return TypeID( (*it).second );
+      }
+
+      std::map<std::string,TypeID>::const_iterator itUser(
+                                                      mapUserTypeID.find(s) );
+      if( itUser != mapUserTypeID.end() )
+      {
+         return (*itUser).second;
+      }
+
+      InvalidRequest e("There are no registered TypeID as '" + s + "'.");
+      GPSTK_THROW(e);
+   }
+
+
+      // Throw InvalidRequest if the set of types is frozen
+   void TypeID::checkNotFrozen()
+      throw(InvalidRequest)
+   {
+      if( registryFrozen )
+      {
+         InvalidRequest e("The TypeID registry is frozen.");
+         GPSTK_THROW(e);
+      }
+   }
+
+
+      // Forget the description of type 'vt'
+   void TypeID::eraseValueType(ValueType vt)
+   {
+      std::map<ValueType,std::string>::iterator it( tStrings.find(vt) );
+      if( it == tStrings.end() )
+      {
+         return;
+      }
+
+      std::map<std::string,ValueType>::iterator it2( tValues.find(it->second) );
+      if( it2 != tValues.end() && it2->second == vt )
+      {
+            // Another type may carry the same description
+         tValues.erase(it2);
+         for( std::map<ValueType,std::string>::const_iterator it3 =
+                 tStrings.begin();
+              it3 != tStrings.end();
+              ++it3 )
+         {
+            if( it3 != it && it3->second == it->second )
+            {
+               tValues.insert( std::make_pair(it3->second, it3->first) );
+               break;
+            }
+         }
+      }
+
+      tStrings.erase(it);
+   }
+
+
+      // Add a type to the set
+   TypeIDBitSet& TypeIDBitSet::insert(const TypeID& type)
+   {
+      const size_t i( type.index() );
+      if( i / wordBits >= words.size() )
+      {
+         words.resize( i / wordBits + 1, 0UL );
+      }
+
+      words[i / wordBits] |= ( 1UL << (i % wordBits) );
+
+      return (*this);
+   }
+
+
+      // Add a set of types to the set
+   TypeIDBitSet& TypeIDBitSet::insert(const std::set<TypeID>& typeSet)
+   {
+      for( std::set<TypeID>::const_iterator it = typeSet.begin();
+           it != typeSet.end();
+           ++it )
+      {
+         insert(*it);
+      }
+
+      return (*this);
+   }
+
+
+      // Remove a type from the set
+   TypeIDBitSet& TypeIDBitSet::erase(const TypeID& type)
+   {
+      const size_t i( type.index() );
+      if( i / wordBits < words.size() )
+      {
+         words[i / wordBits] &= ~( 1UL << (i % wordBits) );
+      }
+
+      return (*this);
+   }
+
+
+      // Whether every type in 'right' is also in this set
+   bool TypeIDBitSet::containsAll(const TypeIDBitSet& right) const
+   {
+      for( size_t w = 0; w < right.words.size(); ++w )
+      {
+         const unsigned long mine( (w < words.size()) ? words[w] : 0UL );
+         if( right.words[w] & ~mine )
+         {
+            return false;
+         }
+      }
+
+      return true;
+   }
+
+
+      // Whether this set and 'right' have any type in common
+   bool TypeIDBitSet::intersects(const TypeIDBitSet& right) const
+   {
+      const size_t n( std::min( words.size(), right.words.size() ) );
+      for( size_t w = 0; w < n; ++w )
+      {
+         if( words[w] & right.words[w] )
+         {
+            return true;
+         }
+      }
+
+      return false;
+   }
+
+
+      // Number of types in the set
+   size_t TypeIDBitSet::size() const
+   {
+      size_t count(0);
+      for( size_t w = 0; w < words.size(); ++w )
+      {
+         for( unsigned long bits = words[w]; bits != 0UL; bits &= bits - 1UL )
+         {
+            ++count;
+         }
+      }
+
+      return count;
+   }
+
+
+      // Returns the types in the set, as a std::set
+   std::set<TypeID> TypeIDBitSet::toSet() const
+   {
+      std::set<TypeID> typeSet;
+      for( size_t w = 0; w < words.size(); ++w )
+      {
+         for( size_t b = 0; b < wordBits; ++b )
+         {
+            if( ( words[w] >> b ) & 1UL )
+            {
+               typeSet.insert( TypeID::fromIndex( int(w * wordBits + b) ) );
+            }
+         }
+      }
+
+      return typeSet;
+   }
+
+
    namespace StringUtils
    {
 
@@ -775,17 +969,15 @@ namespace gpstk
       // unregister a TypeID by it's name string
    void TypeID::unregByName(std::string name)
    {
+      checkNotFrozen();
+
       std::map<std::string,TypeID>::iterator it = mapUserTypeID.find(name);
 
       if(it!=mapUserTypeID.end())
       {
          TypeID delID = it->second;
 
-         std::map<TypeID::ValueType,std::string>::iterator it2 = TypeID::tStrings.find(delID.type);
-         if(it2!=TypeID::tStrings.end())
-         {
-            TypeID::tStrings.erase(it2);
-         }
+         eraseValueType(delID.type);
 
          mapUserTypeID.erase(it);
       }
@@ -802,17 +994,15 @@ namespace gpstk
       // unregister all TypeIDs registered by name string
    void TypeID::unregAll()
    {
+      checkNotFrozen();
+
       std::map<std::string,TypeID>::iterator it = mapUserTypeID.begin();
 
       for(it=mapUserTypeID.begin(); it!=mapUserTypeID.end(); it++)
       {
          TypeID delID = it->second;
 
-         std::map<TypeID::ValueType,std::string>::iterator it2 = TypeID::tStrings.find(delID.type);
-         if(it2!=TypeID::tStrings.end())
-         {
-            TypeID::tStrings.erase(it2);
-         }
+         eraseValueType(delID.type);
       }
       mapUserTypeID.clear();
 
@@ -52,6 +52,8 @@
 #include <sstream>
 #include <string>
 #include <map>
+#include <set>
+#include <vector>
 #include "RinexObsHeader.hpp"
 #include "Rinex3ObsHeader.hpp"
 #include "RinexObsID.hpp"
@@ -81,6 +83,14 @@ namespace gpstk
        * From now on, you'll be able to use INS as TypeID when you need to
        * refer to inertial system data.
        *
+       * Every registered type also has a dense integer index, given by
+       * index(): the built-in types keep their enum values, and the types
+       * added at run time follow them without gaps. Per-type arrays and
+       * bit sets (see TypeIDBitSet) may be sized with numIndices(). Once
+       * all the types of an application are registered, the registry may
+       * be frozen with freezeRegistry(), so that those arrays stay valid:
+       * adding or removing types afterwards throws InvalidRequest.
+       *
        */
    class TypeID
    {
@@ -464,10 +474,53 @@ namespace gpstk
 
          /** Static method to add new TypeID's
           * @param s      Identifying string for the new TypeID
+          *
+          * @throw InvalidRequest if the registry is frozen.
           */
       static ValueType newValueType(const std::string& s);
 
 
+         /// Dense integer index of this type, from 0 to numIndices()-1.
+      int index() const
+      { return (type <= Last) ? int(type) : int(type) - (Placeholder-Last-1); };
+
+
+         /// Number of dense indices in use, i.e., one beyond the index
+         /// of the last registered type.
+      static int numIndices()
+      { return TypeID(tStrings.rbegin()->first).index() + 1; };
+
+
+         /// Returns the TypeID with dense index 'i'.
+      static TypeID fromIndex(int i)
+      { return TypeID( ValueType( (i <= Last) ? i : i + (Placeholder-Last-1) ) ); };
+
+
+         /** Returns the TypeID whose identifying string is 's', i.e., the
+          *  inverse of asString(). Names given to regByName() are also
+          *  accepted.
+          *
+          * @throw InvalidRequest if no such type is registered.
+          */
+      static TypeID fromString(const std::string& s)
+         throw(InvalidRequest);
+
+
+         /// Forbid adding or removing types from now on.
+      static void freezeRegistry()
+      { registryFrozen = true; };
+
+
+         /// Allow adding or removing types again.
+      static void thawRegistry()
+      { registryFrozen = false; };
+
+
+         /// Whether the set of types is frozen.
+      static bool isRegistryFrozen()
+      { return registryFrozen; };
+
+
          /// Type of the value
       ValueType type;
 
@@ -476,6 +529,25 @@ namespace gpstk
       static std::map< ValueType, std::string > tStrings;
 
 
+   private:
+
+         /// Map holding the type of each description, for fromString()
+      static std::map< std::string, ValueType > tValues;
+
+
+         /// Is the set of types frozen ?
+      static bool registryFrozen;
+
+
+         /// Throw InvalidRequest if the set of types is frozen
+      static void checkNotFrozen()
+         throw(InvalidRequest);
+
+
+         /// Forget the description of type 'vt'
+      static void eraseValueType(ValueType vt);
+
+
    public:
       class Initializer
       {
@@ -502,9 +574,11 @@ namespace gpstk
       static TypeID regByName(std::string name,std::string desc);
 
          /// unregister a TypeID by it's name string
+         /// @throw InvalidRequest if the registry is frozen.
       static void unregByName(std::string name);
 
          /// unregister all TypeIDs registered by name string
+         /// @throw InvalidRequest if the registry is frozen.
       static void unregAll();
 
    private:
@@ -520,6 +594,94 @@ namespace gpstk
 
 
 
+      /** Set of TypeID's kept as a bit set over TypeID::index(), so
+       *  that membership tests and set comparisons are word operations
+       *  instead of std::set lookups.
+       *
+       * @code
+       *    TypeIDBitSet required( requiredTypeSet );
+       *
+       *    if( required.contains( TypeID::L1 ) ) ...
+       * @endcode
+       */
+   class TypeIDBitSet
+   {
+   public:
+
+         /// Default constructor, creates an empty set
+      TypeIDBitSet() {};
+
+
+         /// Constructor from a set of TypeID's
+      TypeIDBitSet(const std::set<TypeID>& typeSet)
+      { insert(typeSet); };
+
+
+         /// Add a type to the set
+      TypeIDBitSet& insert(const TypeID& type);
+
+
+         /// Add a set of types to the set
+      TypeIDBitSet& insert(const std::set<TypeID>& typeSet);
+
+
+         /// Remove a type from the set
+      TypeIDBitSet& erase(const TypeID& type);
+
+
+         /// Whether the set holds 'type'
+      bool contains(const TypeID& type) const
+      {
+         const size_t i( type.index() );
+         return ( i / wordBits < words.size() ) &&
+                ( ( words[i / wordBits] >> (i % wordBits) ) & 1UL );
+      };
+
+
+         /// Whether every type in 'right' is also in this set
+      bool containsAll(const TypeIDBitSet& right) const;
+
+
+         /// Whether this set and 'right' have any type in common
+      bool intersects(const TypeIDBitSet& right) const;
+
+
+         /// Number of types in the set
+      size_t size() const;
+
+
+         /// Whether the set is empty
+      bool empty() const
+      { return size() == 0; };
+
+
+         /// Remove all types
+      void clear()
+      { words.clear(); };
+
+
+         /// Returns the types in the set, as a std::set
+      std::set<TypeID> toSet() const;
+
+
+         /// Equality operator
+      bool operator==(const TypeIDBitSet& right) const
+      { return containsAll(right) && right.containsAll(*this); };
+
+
+   private:
+
+         /// Bits per word
+      static const size_t wordBits = 8 * sizeof(unsigned long);
+
+
+         /// Bit 'i' is set if the type with index 'i' is in the set
+      std::vector<unsigned long> words;
+
+   }; // End of class 'TypeIDBitSet'
+
+
+
    namespace StringUtils
    {
          /// convert this object to a string representation
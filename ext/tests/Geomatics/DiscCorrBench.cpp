@@ -0,0 +1,139 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+
+/** @file DiscCorrBench.cpp
+ * Time taken by the discontinuity corrector to fix every pass of a set of
+ * RINEX files, serially and with the parallel DiscontinuityCorrector()
+ * against the number of threads.
+ * Not run by ctest.
+ *
+ * Usage: DiscCorrBench [-r repeats] [-t maxThreads] [file ...]
+ * The passes of the files (data/arlm200a.15o and arlm200b.15o by default)
+ * are corrected 'repeats' times (10 by default) in each run.
+ */
+
+#include "DiscCorr.hpp"
+#include "SatPassUtilities.hpp"
+#include "SystemTime.hpp"
+#include "TestSupport.hpp"
+
+#include "build_config.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+
+using namespace std;
+using namespace gpstk;
+
+
+int main(int argc, char *argv[])
+{
+   unsigned repeats = 10;
+   unsigned maxThreads = numProcessors();
+   vector<string> files;
+
+   for (int i = 1; i < argc; i++)
+   {
+      if (strcmp(argv[i], "-r") == 0 && i+1 < argc)
+         repeats = atoi(argv[++i]);
+      else if (strcmp(argv[i], "-t") == 0 && i+1 < argc)
+         maxThreads = atoi(argv[++i]);
+      else
+         files.push_back(argv[i]);
+   }
+   if (maxThreads < 1)
+      maxThreads = 1;
+   if (files.empty())
+   {
+      string dir = getPathData() + getFileSep();
+      files.push_back(dir + "arlm200a.15o");
+      files.push_back(dir + "arlm200b.15o");
+   }
+
+   vector<string> obstypes;
+   obstypes.push_back("L1");
+   obstypes.push_back("L2");
+   obstypes.push_back("P1");
+   obstypes.push_back("P2");
+
+   vector<SatPass> passes;
+   SatPassFromRinexFiles(files, obstypes, 30.0, passes, vector<RinexSatID>(),
+                         true, Epoch(CommonTime::BEGINNING_OF_TIME),
+                         Epoch(CommonTime::END_OF_TIME));
+
+      // repeat the passes, to make a long enough run
+   vector<SatPass> input;
+   for (unsigned r = 0; r < repeats; r++)
+      input.insert(input.end(), passes.begin(), passes.end());
+
+   GDCconfiguration config;
+   config.setParameter("DT:30");
+   config.setParameter("MaxGap:600");
+
+   cout << input.size() << " passes" << endl;
+   cout << "method       threads   seconds" << endl;
+
+   vector<SatPass> work(input);
+   vector<string> cmds;
+   string msg;
+   CommonTime start = SystemTime().convertToCommonTime();
+   for (size_t n = 0; n < work.size(); n++)
+   {
+      cmds.clear();
+      DiscontinuityCorrector(work[n], config, cmds, msg);
+   }
+   cout << left << setw(10) << "serial" << right << setw(10) << 1
+        << fixed << setprecision(3) << setw(10) << elapsed(start) << endl;
+
+   vector< vector<string> > allCmds;
+   vector<string> msgs;
+   vector<int> codes;
+   for (unsigned t = 1; t <= maxThreads; t *= 2)
+   {
+      work = input;
+      start = SystemTime().convertToCommonTime();
+      DiscontinuityCorrector(work, config, allCmds, msgs, codes,
+                             vector<int>(), t);
+      cout << left << setw(10) << "parallel" << right << setw(10) << t
+           << fixed << setprecision(3) << setw(10) << elapsed(start) << endl;
+   }
+
+   return 0;
+}
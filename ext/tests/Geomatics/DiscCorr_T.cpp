@@ -0,0 +1,332 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+
+#include "DiscCorr.hpp"
+#include "SatPassUtilities.hpp"
+
+#include "build_config.h"
+
+#include "TestUtil.hpp"
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace gpstk;
+
+//============================================================
+// Class decalarations
+//============================================================
+
+class DiscCorr_T
+{
+public:
+
+   DiscCorr_T();
+
+      // return values indicate number of failures, i.e., 0=PASS, !0=FAIL
+   int parallelTest( void );
+   int uniqueTest( void );
+   int debugTest( void );
+
+private:
+
+      /// Results of correcting a set of passes.
+   struct Result
+   {
+      vector<SatPass> passes;
+      vector< vector<string> > editCmds;
+      vector<string> messages;
+      vector<int> codes;
+      vector<string> logs;
+   };
+
+      /// Correct every pass, one call at a time.
+   void serial( Result& result );
+
+      /// Correct every pass with one parallel call.
+   void parallel( Result& result, unsigned int threads );
+
+      /// Count the differences between two results.
+   static int compare( Result& a, Result& b );
+
+      /// Remove from debug output the lines that differ between runs (the
+      /// run time) or that are not written by a pass (configuration changes).
+   static string normalize( const string& log );
+
+   GDCconfiguration config;
+
+      /// Passes of all the input files, before correction.
+   vector<SatPass> input;
+};
+
+
+DiscCorr_T :: DiscCorr_T()
+{
+   string dataFilePath = gpstk::getPathData() + getFileSep();
+   vector<string> files;
+   files.push_back(dataFilePath + "arlm200a.15o");
+   files.push_back(dataFilePath + "arlm200b.15o");
+
+   vector<string> obstypes;
+   obstypes.push_back("L1");
+   obstypes.push_back("L2");
+   obstypes.push_back("P1");
+   obstypes.push_back("P2");
+
+   SatPassFromRinexFiles(files, obstypes, 30.0, input, vector<RinexSatID>(),
+                         true, Epoch(CommonTime::BEGINNING_OF_TIME),
+                         Epoch(CommonTime::END_OF_TIME));
+
+   config.setParameter("DT:30");
+   config.setParameter("MaxGap:600");
+}
+
+
+void DiscCorr_T :: serial( Result& result )
+{
+   const size_t N(input.size());
+   result.passes = input;
+   result.editCmds.assign(N, vector<string>());
+   result.messages.assign(N, string());
+   result.codes.assign(N, 0);
+   result.logs.assign(N, string());
+
+   ostringstream oss;
+   config.setDebugStream(oss);
+   config.setParameter("ResetUnique:1");
+   for (size_t n = 0; n < N; n++)
+   {
+      oss.str("");
+      result.codes[n] = DiscontinuityCorrector(result.passes[n], config,
+                                               result.editCmds[n],
+                                               result.messages[n]);
+      result.logs[n] = oss.str();
+   }
+   config.setDebugStream(cout);
+}
+
+
+void DiscCorr_T :: parallel( Result& result, unsigned int threads )
+{
+   result.passes = input;
+   config.setParameter("ResetUnique:1");
+   DiscontinuityCorrector(result.passes, config, result.editCmds,
+                          result.messages, result.codes, vector<int>(),
+                          threads, &result.logs);
+}
+
+
+string DiscCorr_T :: normalize( const string& log )
+{
+   istringstream iss(log);
+   string line, result;
+   while (getline(iss, line))
+   {
+      if (line.find(" Run ") != string::npos ||
+          line.find("GDCconfiguration::setParameter") == 0)
+         continue;
+      result += line + "\n";
+   }
+   return result;
+}
+
+
+int DiscCorr_T :: compare( Result& a, Result& b )
+{
+   if (a.passes.size() != b.passes.size())
+      return 1;
+
+   int diffs = 0;
+   for (size_t n = 0; n < a.passes.size(); n++)
+   {
+      if (a.codes[n] != b.codes[n] || a.messages[n] != b.messages[n] ||
+          a.editCmds[n] != b.editCmds[n] ||
+          normalize(a.logs[n]) != normalize(b.logs[n]))
+      {
+         diffs++;
+         continue;
+      }
+
+      SatPass& pa(a.passes[n]);
+      SatPass& pb(b.passes[n]);
+      if (pa.size() != pb.size() || pa.status() != pb.status())
+      {
+         diffs++;
+         continue;
+      }
+
+      vector<string> ot(pa.getObsTypes());
+      for (unsigned int i = 0; i < pa.size(); i++)
+      {
+         bool same = (pa.getFlag(i) == pb.getFlag(i));
+         for (size_t j = 0; j < ot.size(); j++)
+         {
+            same = same && pa.data(i, ot[j]) == pb.data(i, ot[j])
+                        && pa.LLI(i, ot[j]) == pb.LLI(i, ot[j]);
+         }
+         if (!same)
+         {
+            diffs++;
+            break;
+         }
+      }
+   }
+
+   return diffs;
+}
+
+
+int DiscCorr_T :: parallelTest( void )
+{
+   TUDEF("DiscCorr", "DiscontinuityCorrector(vector)");
+
+   TUASSERT(input.size() > 10);
+
+   Result ref;
+   serial(ref);
+
+      // at least one pass is corrected, and one fails
+   int ok = 0, failed = 0, cmds = 0;
+   for (size_t n = 0; n < ref.codes.size(); n++)
+   {
+      (ref.codes[n] == 0 ? ok : failed)++;
+      cmds += ref.editCmds[n].size();
+   }
+   TUASSERT(ok > 0);
+   TUASSERT(failed > 0);
+   TUASSERT(cmds > 0);
+
+   unsigned int threads[] = { 1, 3, 8, 0 };
+   for (int t = 0; threads[t] != 0; t++)
+   {
+      Result res;
+      parallel(res, threads[t]);
+      TUASSERTE(int, 0, compare(ref, res));
+   }
+
+      // empty input
+   vector<SatPass> none;
+   vector< vector<string> > cmdsNone;
+   vector<string> msgsNone;
+   vector<int> codesNone;
+   DiscontinuityCorrector(none, config, cmdsNone, msgsNone, codesNone);
+   TUASSERTE(size_t, 0, codesNone.size());
+
+   TURETURN();
+}
+
+
+int DiscCorr_T :: uniqueTest( void )
+{
+   TUDEF("DiscCorr", "GDCUnique");
+
+      // a parallel call numbers its passes as the serial calls would, and
+      // following calls carry on from there
+   Result res;
+   parallel(res, 4);
+
+   vector<string> cmds;
+   string msg;
+   SatPass sp(input[0]);
+   DiscontinuityCorrector(sp, config, cmds, msg);
+
+   ostringstream expected;
+   expected << "GDC " << input.size() + 1 << " ";
+   TUASSERTE(string, expected.str(), msg.substr(0, expected.str().size()));
+
+   for (size_t n = 0; n < res.messages.size(); n++)
+   {
+      ostringstream tag;
+      tag << "GDC " << n + 1 << " ";
+      if (res.codes[n] == 0)
+         TUASSERTE(string, tag.str(),
+                   res.messages[n].substr(0, tag.str().size()));
+   }
+
+   TURETURN();
+}
+
+
+int DiscCorr_T :: debugTest( void )
+{
+   TUDEF("DiscCorr", "DiscontinuityCorrector(debug)");
+
+   config.setParameter("Debug:2");
+
+   Result ref;
+   serial(ref);
+   TUASSERT(!ref.logs.empty() && !ref.logs[0].empty());
+
+   Result res;
+   parallel(res, 5);
+   TUASSERTE(int, 0, compare(ref, res));
+
+      // without debugLogs, the output goes to the debug stream in order
+   string all;
+   for (size_t n = 0; n < ref.logs.size(); n++)
+      all += ref.logs[n];
+
+   ostringstream oss;
+   config.setDebugStream(oss);
+   config.setParameter("ResetUnique:1");
+   vector<SatPass> passes(input);
+   DiscontinuityCorrector(passes, config, res.editCmds, res.messages,
+                          res.codes, vector<int>(), 5);
+   TUASSERT(normalize(oss.str()) == normalize(all));
+
+   config.setDebugStream(cout);
+   config.setParameter("Debug:0");
+
+   TURETURN();
+}
+
+
+int main()
+{
+   int errorTotal = 0;
+   DiscCorr_T testClass;
+
+   errorTotal += testClass.parallelTest();
+   errorTotal += testClass.uniqueTest();
+   errorTotal += testClass.debugTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return( errorTotal );
+}
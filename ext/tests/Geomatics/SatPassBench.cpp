@@ -0,0 +1,226 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+
+/** @file SatPassBench.cpp
+ * Time taken to fill, copy and correct a synthetic day of 1 Hz dual frequency
+ * GPS data, and by the linear combination and difference kernels against the
+ * scalar loops they replace.
+ * Not run by ctest.
+ *
+ * Usage: SatPassBench [-s satellites] [-p passes]
+ * Each satellite has 'passes' (4 by default) passes that together span 24
+ * hours, each with a cycle slip half way through; 10 satellites by
+ * default.
+ */
+
+#include "DiscCorr.hpp"
+#include "SatPassKernels.hpp"
+#include "GNSSconstants.hpp"
+#include "SystemTime.hpp"
+#include "TestSupport.hpp"
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+
+using namespace std;
+using namespace gpstk;
+
+
+   // Roughly normal noise of unit sigma
+static double noise(unsigned int& seed)
+{
+   double sum = 0.0;
+   for (int i = 0; i < 12; i++)
+      sum += 0.5 * uniform(seed);
+   return sum;
+}
+
+
+   // One epoch as the data used to be stored: flag and data together
+struct Row
+{
+   unsigned short flag;
+   double data[6];
+};
+
+
+static void report(const char *what, double seconds)
+{
+   cout << left << setw(28) << what << right << fixed << setprecision(3)
+        << setw(10) << seconds << endl;
+}
+
+
+int main(int argc, char *argv[])
+{
+   int nsat = 10, npass = 4;
+
+   for (int i = 1; i < argc; i++)
+   {
+      if (strcmp(argv[i], "-s") == 0 && i+1 < argc)
+         nsat = atoi(argv[++i]);
+      else if (strcmp(argv[i], "-p") == 0 && i+1 < argc)
+         npass = atoi(argv[++i]);
+   }
+   if (nsat < 1) nsat = 1;
+   if (npass < 1) npass = 1;
+
+   const double CFF(C_MPS/OSC_FREQ_GPS);
+   const double wl1(CFF/L1_MULT_GPS), wl2(CFF/L2_MULT_GPS);
+   const double gamma((L1_MULT_GPS/L2_MULT_GPS)*(L1_MULT_GPS/L2_MULT_GPS));
+   const int length(86400/npass);
+
+   vector<string> obstypes;
+   obstypes.push_back("L1");
+   obstypes.push_back("L2");
+   obstypes.push_back("P1");
+   obstypes.push_back("P2");
+
+   Epoch t0(CivilTime(2015, 7, 19, 0, 0, 0.0, TimeSystem::GPS));
+   vector<double> values(4);
+   unsigned int seed = 1;
+
+   vector<SatPass> input;
+   CommonTime start = SystemTime().convertToCommonTime();
+   for (int s = 0; s < nsat; s++)
+   {
+      for (int p = 0; p < npass; p++)
+      {
+         SatPass sp(RinexSatID(s+1, SatID::systemGPS), 1.0, obstypes);
+         double N1 = 1000.0*s + 10.0*p, N2 = N1 - 37.0;
+         for (int i = 0; i < length; i++)
+         {
+            double t = double(p*length + i);
+            double rho = 2.2e7 + 2.5e6*sin(2.0*PI*(t/43082.0 + s/11.0));
+            double iono = 5.0 + 3.0*sin(2.0*PI*(t/86400.0 + s/7.0));
+            if (i == length/2) { N1 += 20.0; N2 += 10.0; }
+            values[0] = (rho - iono)/wl1 + N1 + 0.01*noise(seed);
+            values[1] = (rho - gamma*iono)/wl2 + N2 + 0.01*noise(seed);
+            values[2] = rho + iono + 0.3*noise(seed);
+            values[3] = rho + gamma*iono + 0.3*noise(seed);
+            sp.addData(t0 + t, obstypes, values);
+         }
+         input.push_back(sp);
+      }
+   }
+   report("fill (addData)", elapsed(start));
+   cout << input.size() << " passes of " << length << " epochs" << endl;
+
+   start = SystemTime().convertToCommonTime();
+   vector<SatPass> work(input);
+   report("copy", elapsed(start));
+
+   GDCconfiguration config;
+   config.setParameter("DT:1");
+   vector<string> cmds;
+   string msg;
+   int slips = 0;
+   start = SystemTime().convertToCommonTime();
+   for (size_t n = 0; n < work.size(); n++)
+   {
+      cmds.clear();
+      if (DiscontinuityCorrector(work[n], config, cmds, msg) == 0)
+         slips += cmds.size();
+   }
+   report("DiscontinuityCorrector", elapsed(start));
+   cout << slips << " edit commands" << endl;
+
+      // kernels on the columns of one day of one satellite, against the
+      // loops over a vector of structures they replace
+   const size_t n(86400);
+   const int reps(100);
+   DualFrequencyCoefficients c;
+   c.wlwl = CFF/(L1_MULT_GPS-L2_MULT_GPS);
+   c.wl1r = 1.0/(1.0+L2_MULT_GPS/L1_MULT_GPS);
+   c.wl2r = 1.0/(1.0+L1_MULT_GPS/L2_MULT_GPS);
+   c.wl1p = wl1/(1.0-L2_MULT_GPS/L1_MULT_GPS);
+   c.wl2p = wl2/(1.0-L1_MULT_GPS/L2_MULT_GPS);
+   c.gf1r = -1.0;
+   c.gf2r = 1.0;
+   c.gf1p = wl1;
+   c.gf2p = -wl2;
+
+   vector<Row> rows(n);
+   vector< vector<double> > cols(6, vector<double>(n));
+   for (size_t i = 0; i < n; i++)
+   {
+      rows[i].flag = 1;
+      for (int k = 0; k < 6; k++)
+         rows[i].data[k] = cols[k][i] = 2.0e7 + 1.0e3*noise(seed);
+   }
+
+   double check = 0.0;
+   start = SystemTime().convertToCommonTime();
+   for (int r = 0; r < reps; r++)
+   {
+      for (size_t i = 0; i < n; i++)
+      {
+         if (!(rows[i].flag & 1)) continue;
+         double *d = rows[i].data;
+         double wlr = c.wl1r*d[2] + c.wl2r*d[3];
+         double wlp = c.wl1p*d[0] + c.wl2p*d[1];
+         double gfr = d[2] - d[3];
+         double gfp = c.gf1p*d[0] + c.gf2p*d[1];
+         d[0] = gfp + gfr;
+         d[1] = gfp;
+         d[2] = (wlp-wlr)/c.wlwl;
+         d[3] = -gfr;
+      }
+      for (size_t i = 1; i < n; i++)
+         rows[i].data[4] = rows[i].data[2] - rows[i-1].data[2];
+      check += rows[n/2].data[4];
+   }
+   report("combinations, scalar rows", elapsed(start));
+
+   start = SystemTime().convertToCommonTime();
+   for (int r = 0; r < reps; r++)
+   {
+      dualFrequencyKernel(n, &cols[0][0], &cols[1][0], &cols[2][0],
+                          &cols[3][0], c, &cols[2][0], &cols[1][0],
+                          &cols[3][0], &cols[0][0]);
+      differenceKernel(n, &cols[2][0], &cols[4][1]);
+      check += cols[4][n/2];
+   }
+   report("combinations, kernels", elapsed(start));
+   cout << "(checksum " << setprecision(1) << check << ")" << endl;
+
+   return 0;
+}
@@ -0,0 +1,235 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+#include "SatPassUtilities.hpp"
+
+#include "build_config.h"
+
+#include "TestUtil.hpp"
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace gpstk;
+
+//============================================================
+// Class decalarations
+//============================================================
+
+class SatPassUtilities_T
+{
+public:
+
+   SatPassUtilities_T();
+
+      // return values indicate number of failures, i.e., 0=PASS, !0=FAIL
+   int streamTest( void );
+   int stopTest( void );
+
+private:
+
+      /// Keeps a copy of each pass it is handed; asks to stop after
+      /// maxPasses if that is not negative.
+   class Collector : public SatPassHandler
+   {
+   public:
+      Collector( int max = -1 ) : maxPasses(max) {}
+
+      int handle( SatPass& sp ) throw(Exception)
+      {
+         passes.push_back(sp);
+         return (maxPasses >= 0 && int(passes.size()) >= maxPasses);
+      }
+
+      vector<SatPass> passes;
+      int maxPasses;
+   };
+
+      /// Count the differences between two lists of passes, in any order.
+   int compare( vector<SatPass> a, vector<SatPass> b );
+
+   vector<string> files;
+   vector<string> obstypes;
+};
+
+
+SatPassUtilities_T :: SatPassUtilities_T()
+{
+   string dataFilePath = gpstk::getPathData() + getFileSep();
+   files.push_back(dataFilePath + "arlm200a.15o");
+   files.push_back(dataFilePath + "arlm200b.15o");
+
+   obstypes.push_back("L1");
+   obstypes.push_back("L2");
+   obstypes.push_back("P1");
+   obstypes.push_back("P2");
+}
+
+
+int SatPassUtilities_T :: compare( vector<SatPass> a, vector<SatPass> b )
+{
+   if (a.size() != b.size())
+      return 1;
+
+   sort(a);
+   sort(b);
+   int diffs = 0;
+   for (size_t n = 0; n < a.size(); n++)
+   {
+      SatPass& pa(a[n]);
+      SatPass& pb(b[n]);
+      if (pa.getSat() != pb.getSat() || pa.size() != pb.size() ||
+          pa.getNgood() != pb.getNgood() ||
+          pa.getFirstTime() != pb.getFirstTime())
+      {
+         diffs++;
+         continue;
+      }
+
+      bool same = true;
+      for (unsigned int i = 0; i < pa.size(); i++)
+      {
+         same = same && pa.getFlag(i) == pb.getFlag(i) &&
+                pa.time(i) == pb.time(i);
+         for (size_t j = 0; j < obstypes.size(); j++)
+            same = same && pa.data(i, obstypes[j]) == pb.data(i, obstypes[j])
+                        && pa.LLI(i, obstypes[j]) == pb.LLI(i, obstypes[j])
+                        && pa.SSI(i, obstypes[j]) == pb.SSI(i, obstypes[j]);
+      }
+      if (!same)
+         diffs++;
+   }
+
+   return diffs;
+}
+
+
+   // The streaming form must build the same passes as the vector form, and
+   // hand each over as soon as it is complete.
+int SatPassUtilities_T :: streamTest( void )
+{
+   TUDEF("SatPassUtilities", "SatPassFromRinexFiles");
+
+   const double defaultGap = SatPass(RinexSatID("G01"), 30.0).getMaxGap();
+   const double gaps[] = { defaultGap, 300.0, 30.0 };
+   for (int g = 0; g < 3; g++)
+   {
+      SatPass::setMaxGap(gaps[g]);
+      string msg = "max gap " + StringUtils::asString(gaps[g],0);
+
+      vector<SatPass> passes;
+      int nfiles = SatPassFromRinexFiles(files, obstypes, 30.0, passes);
+
+      Collector collector;
+      int nstream = SatPassFromRinexFiles(files, obstypes, 30.0, collector);
+
+      testFramework.assert(nfiles == 2 && nstream == 2, msg + " files read",
+                           __LINE__);
+      testFramework.assert(compare(passes, collector.passes) == 0,
+                           msg + " same passes", __LINE__);
+
+         // passes completed while reading are handed over as the data
+         // reach their end plus the gap, so in order of their end (within
+         // the time step), and before the passes still open at the end
+      const vector<SatPass>& cp(collector.passes);
+      Epoch end(CommonTime::BEGINNING_OF_TIME);
+      for (size_t n = 0; n < cp.size(); n++)
+         if (cp[n].getLastTime() > end)
+            end = cp[n].getLastTime();
+
+      int early = 0, bad = 0;
+      bool open = false;
+      Epoch prev(CommonTime::BEGINNING_OF_TIME);
+      for (size_t n = 0; n < cp.size(); n++)
+      {
+         if (!cp[n].endsBefore(end))
+         {
+            open = true;
+            continue;
+         }
+         early++;
+         if (open || cp[n].getLastTime() - prev < -30.0)
+            bad++;
+         if (cp[n].getLastTime() > prev)
+            prev = cp[n].getLastTime();
+      }
+      testFramework.assert(bad == 0, msg + " handed over in order", __LINE__);
+      if (gaps[g] < defaultGap)
+         testFramework.assert(early > 0, msg + " handed over while reading",
+                              __LINE__);
+   }
+   SatPass::setMaxGap(defaultGap);
+
+   TURETURN();
+}
+
+
+int SatPassUtilities_T :: stopTest( void )
+{
+   TUDEF("SatPassUtilities", "SatPassFromRinexFiles");
+
+   Collector all;
+   SatPassFromRinexFiles(files, obstypes, 30.0, all);
+
+   Collector some(3);
+   SatPassFromRinexFiles(files, obstypes, 30.0, some);
+   testFramework.assert(some.passes.size() == 3 && all.passes.size() > 3,
+                        "handler stops reading", __LINE__);
+
+   int diffs = 0;
+   for (size_t n = 0; n < some.passes.size(); n++)
+      if (some.passes[n].getSat() != all.passes[n].getSat() ||
+          some.passes[n].size() != all.passes[n].size())
+         diffs++;
+   testFramework.assert(diffs == 0, "same first passes", __LINE__);
+
+   TURETURN();
+}
+
+
+int main()
+{
+   int errorTotal = 0;
+   SatPassUtilities_T testClass;
+
+   errorTotal += testClass.streamTest();
+   errorTotal += testClass.stopTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return( errorTotal );
+}
@@ -0,0 +1,299 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+#include "SatPass.hpp"
+#include "SatPassKernels.hpp"
+#include "GNSSconstants.hpp"
+
+#include "TestUtil.hpp"
+#include "TestSupport.hpp"
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace gpstk;
+
+//============================================================
+// Class decalarations
+//============================================================
+
+class SatPass_T
+{
+public:
+
+   SatPass_T();
+
+      // return values indicate number of failures, i.e., 0=PASS, !0=FAIL
+   int combinationTest( void );
+   int differenceTest( void );
+   int columnTest( void );
+
+private:
+
+      /// Fill x with n values around 'base', varying by up to 'scale'.
+   static void fill( vector<double>& x, size_t n, double base, double scale,
+                     unsigned int seed );
+
+      /// Coefficients of the GPS L1/L2 combinations, as in GDCPass.
+   DualFrequencyCoefficients coef;
+
+   vector<string> obstypes;
+};
+
+
+SatPass_T :: SatPass_T()
+{
+   const double F1oF2(L1_MULT_GPS/L2_MULT_GPS), F2oF1(L2_MULT_GPS/L1_MULT_GPS);
+   const double CFF(C_MPS/OSC_FREQ_GPS);
+   coef.wlwl = CFF/(L1_MULT_GPS-L2_MULT_GPS);
+   coef.wl1r = 1.0/(1.0+F2oF1);
+   coef.wl2r = 1.0/(1.0+F1oF2);
+   coef.wl1p = (CFF/L1_MULT_GPS)/(1.0-F2oF1);
+   coef.wl2p = (CFF/L2_MULT_GPS)/(1.0-F1oF2);
+   coef.gf1r = -1.0;
+   coef.gf2r = 1.0;
+   coef.gf1p = CFF/L1_MULT_GPS;
+   coef.gf2p = -CFF/L2_MULT_GPS;
+
+   obstypes.push_back("L1");
+   obstypes.push_back("L2");
+   obstypes.push_back("P1");
+   obstypes.push_back("P2");
+   obstypes.push_back("S1");
+}
+
+
+void SatPass_T :: fill( vector<double>& x, size_t n, double base, double scale,
+                        unsigned int seed )
+{
+   x.resize(n);
+   for (size_t i = 0; i < n; i++)
+      x[i] = base + 0.5 * scale * uniform(seed);
+}
+
+
+   // dualFrequencyKernel() against the scalar expressions, for lengths that
+   // exercise the vector loops and their remainders, with unaligned arrays,
+   // and in place as GDCPass uses it.
+int SatPass_T :: combinationTest( void )
+{
+   TUDEF("SatPassKernels", "dualFrequencyKernel");
+
+   for (size_t n = 0; n <= 37; n++)
+   {
+      for (size_t off = 0; off < 2; off++)
+      {
+         vector<double> L1, L2, P1, P2;
+         fill(L1, n+off, 1.1e8, 1.0e6, 1+n);
+         fill(L2, n+off, 8.6e7, 1.0e6, 2+n);
+         fill(P1, n+off, 2.1e7, 2.0e5, 3+n);
+         fill(P2, n+off, 2.1e7, 2.0e5, 4+n);
+
+         vector<double> mw(n+off), gfp(n+off), gfr(n+off), gfpr(n+off);
+         dualFrequencyKernel(n, &L1[0]+off, &L2[0]+off, &P1[0]+off,
+                             &P2[0]+off, coef, &mw[0]+off, &gfp[0]+off,
+                             &gfr[0]+off, &gfpr[0]+off);
+
+         vector<double> l1(L1), l2(L2), p1(P1), p2(P2);
+         dualFrequencyKernel(n, &l1[0]+off, &l2[0]+off, &p1[0]+off,
+                             &p2[0]+off, coef, &p1[0]+off, &l2[0]+off,
+                             &p2[0]+off, &l1[0]+off);
+
+         int bad = 0;
+         for (size_t i = off; i < n+off; i++)
+         {
+            double wlr = coef.wl1r * P1[i] + coef.wl2r * P2[i];
+            double wlp = coef.wl1p * L1[i] + coef.wl2p * L2[i];
+            double r = P1[i] - P2[i];
+            double p = coef.gf1p * L1[i] + coef.gf2p * L2[i];
+            double w = (wlp-wlr)/coef.wlwl;
+               // results must be bit for bit those of GDCPass before the
+               // kernels, where L1 = gfp + (P1-P2) and P2 = -(P1-P2)
+            if (mw[i] != w || gfp[i] != p || gfr[i] != -r || gfpr[i] != p+r)
+               bad++;
+            if (p1[i] != w || l2[i] != p || p2[i] != -r || l1[i] != p+r)
+               bad++;
+         }
+         testFramework.assert(bad == 0, "n = " + StringUtils::asString(n) +
+                              " offset " + StringUtils::asString(off), __LINE__);
+      }
+   }
+
+   TURETURN();
+}
+
+
+int SatPass_T :: differenceTest( void )
+{
+   TUDEF("SatPassKernels", "differenceKernel");
+
+   for (size_t n = 0; n <= 37; n++)
+   {
+      vector<double> x, dx(n+1, -1.0);
+      fill(x, n, 2.1e7, 2.0e5, 5+n);
+
+      differenceKernel(n, n ? &x[0] : 0, &dx[0]);
+      vector<double> y(x);
+      if (n) differenceKernel(n, &y[0], &y[0]);
+
+      int bad = 0;
+      for (size_t i = 0; i+1 < n; i++)
+         if (dx[i] != x[i+1]-x[i] || y[i] != x[i+1]-x[i])
+            bad++;
+         // nothing is written past n-1 differences
+      if (n > 0 && (dx[n-1] != -1.0 || y[n-1] != x[n-1]))
+         bad++;
+      testFramework.assert(bad == 0, "n = " + StringUtils::asString(n),
+                           __LINE__);
+   }
+
+   TURETURN();
+}
+
+
+   // The column storage must behave as the old vector of SatPassData through
+   // the SatPass accessors, add, copy, split and decimate.
+int SatPass_T :: columnTest( void )
+{
+   TUDEF("SatPass", "columns");
+
+   const int N(120);
+   const double dt(30.0);
+   Epoch t0(CivilTime(2015, 7, 19, 0, 0, 0.0, TimeSystem::GPS));
+   SatPass sp(RinexSatID("G05"), dt, obstypes);
+
+   vector<double> values(obstypes.size());
+   vector<unsigned short> lli(obstypes.size()), ssi(obstypes.size());
+   int added = 0;
+   for (int n = 0; n < N; n++)
+   {
+      if (n % 7 == 3) continue;              // missing epochs
+      for (size_t k = 0; k < obstypes.size(); k++)
+      {
+         values[k] = 1000.0*n + k;
+         lli[k] = (n+k) % 3;
+         ssi[k] = (n+k) % 9;
+      }
+      int index = sp.addData(t0 + n*dt + 0.001*(n%4), obstypes, values, lli,
+                             ssi, (n % 11 == 5 ? SatPass::BAD : SatPass::OK));
+      testFramework.assert(index == added++, "addData index", __LINE__);
+   }
+
+   testFramework.assert(int(sp.size()) == added, "size", __LINE__);
+
+   int bad = 0;
+   for (unsigned int i = 0; i < sp.size(); i++)
+   {
+      int n = sp.getCount(i);
+      if (sp.getFlag(i) != (n % 11 == 5 ? SatPass::BAD : SatPass::OK) ||
+          sp.time(i) != t0 + n*dt + 0.001*(n%4))
+         bad++;
+      for (size_t k = 0; k < obstypes.size(); k++)
+         if (sp.data(i, obstypes[k]) != 1000.0*n + k ||
+             sp.LLI(i, obstypes[k]) != (n+k) % 3 ||
+             sp.SSI(i, obstypes[k]) != (n+k) % 9)
+            bad++;
+   }
+   testFramework.assert(bad == 0, "data read back", __LINE__);
+
+      // writes through the accessors land in the columns
+   sp.data(10, "P2") = -1.5;
+   sp.LLI(10, "L1") = 7;
+   sp.timeoffset(10) = 0.25;
+   testFramework.assert(sp.data(10, "P2") == -1.5 && sp.LLI(10, "L1") == 7 &&
+                        sp.timeoffset(10) == 0.25 &&
+                        sp.data(10, "P1") == 1000.0*sp.getCount(10) + 2,
+                        "write through accessors", __LINE__);
+
+   SatPass copy(sp);
+   bad = 0;
+   for (unsigned int i = 0; i < sp.size(); i++)
+      for (size_t k = 0; k < obstypes.size(); k++)
+         if (copy.data(i, obstypes[k]) != sp.data(i, obstypes[k]))
+            bad++;
+   copy.data(0, "L1") = 99.0;
+   testFramework.assert(bad == 0 && sp.data(0, "L1") == 0.0,
+                        "copy is deep", __LINE__);
+
+      // split at count 60
+   SatPass second(RinexSatID("G05"), dt);
+   unsigned int before = sp.size();
+   testFramework.assert(sp.split(60, second), "split", __LINE__);
+   bad = 0;
+   for (unsigned int i = 0; i < sp.size(); i++)
+      if (sp.getCount(i) >= 60) bad++;
+   for (unsigned int i = 0; i < second.size(); i++)
+   {
+      int n = second.getCount(i) + 60;
+      if (second.data(i, "S1") != 1000.0*n + 4 ||
+          second.SSI(i, "L2") != (n+1) % 9)
+         bad++;
+   }
+   testFramework.assert(bad == 0 && sp.size() + second.size() == before,
+                        "split data", __LINE__);
+
+      // decimate by 2: keep the even counts
+   copy = second;
+   second.decimate(2);
+   bad = 0;
+   for (unsigned int i = 0; i < second.size(); i++)
+   {
+      int n = int(0.5 + (second.time(i) - t0)/dt);
+      if (n % 2 != 0 || second.data(i, "P1") != 1000.0*n + 2 ||
+          second.LLI(i, "P2") != (n+3) % 3)
+         bad++;
+   }
+   testFramework.assert(bad == 0 && second.size() > 0 &&
+                        second.size() < copy.size(), "decimate", __LINE__);
+
+   TURETURN();
+}
+
+
+int main()
+{
+   int errorTotal = 0;
+   SatPass_T testClass;
+
+   errorTotal += testClass.combinationTest();
+   errorTotal += testClass.differenceTest();
+   errorTotal += testClass.columnTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return( errorTotal );
+}
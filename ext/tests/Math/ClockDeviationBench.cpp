@@ -0,0 +1,175 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+
+/** @file ClockDeviationBench.cpp
+ * Time taken by ClockDeviation to compute each deviation at octave
+ * averaging factors of a long phase data set, against the number of
+ * threads; time of one MDEV factor with direct sums and with running
+ * sums; and rate of ClockDeviationAccumulator.
+ * Not run by ctest.
+ *
+ * Usage: ClockDeviationBench [-n points] [-t maxThreads] [-m factor]
+ * The phase data (10^7 points by default) are simulated white phase
+ * and random walk frequency noise. The direct MDEV sums, which cost
+ * O(N m), are timed at factor m (1024 by default).
+ */
+
+#include "ClockDeviation.hpp"
+#include "SystemTime.hpp"
+#include "TestSupport.hpp"
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+
+using namespace std;
+using namespace gpstk;
+
+
+   // MDEV sum with direct inner sums, as mallandev used to compute it
+static double directMdev(const vector<double>& x, unsigned long m)
+{
+   double sigma = 0.0;
+   for (size_t j = 0; j < x.size() - 3*m + 1; j++)
+   {
+      double window = 0.0;
+      for (size_t i = j; i < j+m; i++)
+         window += x[i+2*m] - 2*x[i+m] + x[i];
+      sigma += window * window;
+   }
+   return sigma;
+}
+
+
+int main(int argc, char *argv[])
+{
+   size_t numPoints = 10000000;
+   unsigned maxThreads = numProcessors();
+   unsigned long directM = 1024;
+
+   for (int i = 1; i < argc; i++)
+   {
+      if (strcmp(argv[i], "-n") == 0 && i+1 < argc)
+         numPoints = strtoul(argv[++i], 0, 10);
+      else if (strcmp(argv[i], "-t") == 0 && i+1 < argc)
+         maxThreads = atoi(argv[++i]);
+      else if (strcmp(argv[i], "-m") == 0 && i+1 < argc)
+         directM = strtoul(argv[++i], 0, 10);
+   }
+   if (maxThreads < 1)
+      maxThreads = 1;
+
+   vector<double> x(numPoints);
+   unsigned seed = 1;
+   double freq = 0.0, phase = 0.0;
+   for (size_t i = 0; i < numPoints; i++)
+   {
+      freq += 1.0e-13 * uniform(seed);
+      phase += freq;
+      x[i] = phase + 1.0e-11 * uniform(seed);
+   }
+
+   const ClockDeviation::Deviation devs[] =
+      { ClockDeviation::ADEV, ClockDeviation::MDEV, ClockDeviation::HDEV,
+        ClockDeviation::TOTDEV };
+   const char* names[] = { "ADEV", "MDEV", "HDEV", "TOTDEV" };
+
+   cout << numPoints << " phase points, octave factors" << endl
+        << setw(8) << left << "dev" << right << setw(8) << "factors"
+        << setw(10) << "threads" << setw(12) << "seconds" << endl;
+
+   ClockDeviation cd(1.0);
+   double check = 0.0;
+   for (int d = 0; d < 4; d++)
+   {
+      vector<unsigned long> m(
+         ClockDeviation::factors(devs[d], ClockDeviation::OctaveTaus,
+                                 numPoints));
+      for (unsigned threads = 1; threads <= maxThreads; threads *= 2)
+      {
+         cd.setNumThreads(threads);
+         CommonTime start = SystemTime().convertToCommonTime();
+         vector<double> sigma(cd.compute(x, devs[d], m));
+         double secs = elapsed(start);
+         if (!sigma.empty())
+            check += sigma.back();
+         cout << setw(8) << left << names[d] << right
+              << setw(8) << m.size() << setw(10) << threads
+              << fixed << setprecision(3) << setw(12) << secs << endl;
+      }
+   }
+
+      // One MDEV factor: running sums against direct O(N m) sums
+   if (directM >= 1 &&
+       directM <= ClockDeviation::maxFactor(ClockDeviation::MDEV, numPoints))
+   {
+      cd.setNumThreads(1);
+      vector<unsigned long> m(1, directM);
+      CommonTime start = SystemTime().convertToCommonTime();
+      vector<double> sigma(cd.compute(x, ClockDeviation::MDEV, m));
+      double running = elapsed(start);
+
+      start = SystemTime().convertToCommonTime();
+      double sum = directMdev(x, directM);
+      double direct = elapsed(start);
+      check += sigma[0] + (sum > 0.0 ? 0.0 : 1.0);
+
+      cout << "MDEV m=" << directM << ": running sums "
+           << setprecision(3) << running << " s, direct sums "
+           << direct << " s" << endl;
+   }
+
+      // Accumulating the octave factors point by point
+   vector<unsigned long> m(
+      ClockDeviation::factors(ClockDeviation::MDEV, ClockDeviation::OctaveTaus,
+                              numPoints));
+   ClockDeviationAccumulator acc(m, 1.0);
+   CommonTime start = SystemTime().convertToCommonTime();
+   acc.add(x);
+   double secs = elapsed(start);
+   if (acc.ready(ClockDeviation::ADEV, 0))
+      check += acc.deviation(ClockDeviation::ADEV, 0);
+   cout << "accumulator, " << m.size() << " factors: "
+        << setprecision(0) << numPoints / secs << " points/s" << endl;
+
+   cout << "checksum " << scientific << setprecision(6) << check << endl;
+
+   return 0;
+}
@@ -0,0 +1,429 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S.
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software.
+//
+//Pursuant to DoD Directive 523024
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+
+   /* Check ClockDeviation against direct evaluations of the deviation
+    * formulas, with and without zero gaps, check that threads do not
+    * change the results, and that ClockDeviationAccumulator gives the
+    * same deviations as ClockDeviation. */
+
+#include "ClockDeviation.hpp"
+
+#include "TestUtil.hpp"
+#include "TestSupport.hpp"
+#include <cmath>
+#include <iostream>
+
+using namespace std;
+using namespace gpstk;
+
+//============================================================
+// Class decalarations
+//============================================================
+
+class ClockDeviation_T
+{
+public:
+
+      // return values indicate number of failures, i.e., 0=PASS, !0=FAIL
+   int factorsTest( void );
+   int computeTest( void );
+   int gapsTest( void );
+   int threadsTest( void );
+   int accumulatorTest( void );
+
+private:
+
+      /// Phase of a clock with white phase and random walk frequency
+      /// noise, in seconds
+   static vector<double> makePhase(size_t n, unsigned seed)
+   {
+      vector<double> x(n);
+      double freq(0.0), phase(1.0e-6);
+      for (size_t i = 0; i < n; i++)
+      {
+         freq += 1.0e-12 * uniform(seed);
+         phase += freq;
+         x[i] = phase + 1.0e-10 * uniform(seed);
+      }
+      return x;
+   }
+
+      /// Direct ADEV (m = 2) or HDEV (m = 3) sums, as the clocktools
+      /// programs did
+   static double directSum(const vector<double>& x, unsigned long m,
+                           int order, bool gaps, double tau)
+   {
+      const size_t N(x.size());
+      const size_t terms(N - order*m);
+      double sigma(0.0);
+      unsigned long numGaps(0);
+      for (size_t i = 0; i < terms; i++)
+      {
+         bool zero(false);
+         for (int k = 0; k <= order; k++)
+            zero = zero || (x[i+k*m] == 0);
+         if (gaps && zero && i != 0 && i != terms-1)
+         {
+            numGaps++;
+            continue;
+         }
+         double sum(order == 2 ? x[i+2*m] - 2*x[i+m] + x[i]
+                    : x[i+3*m] - 3*x[i+2*m] + 3*x[i+m] - x[i]);
+         sigma += sum * sum;
+      }
+      return sqrt(sigma / ((order == 2 ? 2.0 : 6.0)
+                           *(double(N) - double(numGaps)
+                             - order*double(m))*tau*tau));
+   }
+
+      /// Direct MDEV sums, leaving out the windows with zeros
+   static double directMdev(const vector<double>& x, unsigned long m,
+                            bool gaps, double tau)
+   {
+      const size_t N(x.size());
+      double sigma(0.0);
+      unsigned long numGaps(0);
+      for (size_t j = 0; j < N - 3*m + 1; j++)
+      {
+         double window(0.0);
+         bool gap(false);
+         for (size_t i = j; i <= j+m-1; i++)
+         {
+            for (int k = 0; k <= 2; k++)
+               gap = gap || (gaps && x[i+k*m] == 0 &&
+                             i+k*m != 0 && i+k*m != N-1);
+            window += x[i+2*m] - 2*x[i+m] + x[i];
+         }
+         if (gap)
+         {
+            numGaps++;
+            continue;
+         }
+         sigma += window * window;
+      }
+      return sqrt(sigma / (2.0*tau*tau*m*m*(double(N) - double(numGaps)
+                                            - 3.0*m + 1)));
+   }
+
+      /// Direct TOTDEV sums over the data reflected about both ends
+   static double directTotdev(const vector<double>& x, unsigned long m,
+                              double tau)
+   {
+      const long N(x.size());
+      double sigma(0.0);
+      for (long i = 1; i < N-1; i++)
+      {
+         double sum(reflected(x, i-long(m)) - 2*x[i]
+                    + reflected(x, i+long(m)));
+         sigma += sum * sum;
+      }
+      return sqrt(sigma / (2.0*(N - 2.0)*tau*tau));
+   }
+
+   static double reflected(const vector<double>& x, long i)
+   {
+      const long N(x.size());
+      if (i < 0)
+         return 2*x[0] - x[-i];
+      if (i >= N)
+         return 2*x[N-1] - x[2*(N-1)-i];
+      return x[i];
+   }
+
+      /// Direct evaluation of a deviation
+   static double direct(const vector<double>& x, ClockDeviation::Deviation dev,
+                        unsigned long m, bool gaps, double tau0)
+   {
+      const double tau(m * tau0);
+      switch (dev)
+      {
+         case ClockDeviation::ADEV:
+            return directSum(x, m, 2, gaps, tau);
+         case ClockDeviation::MDEV:
+            return directMdev(x, m, gaps, tau);
+         case ClockDeviation::TDEV:
+            return tau / sqrt(3.0) * directMdev(x, m, gaps, tau);
+         case ClockDeviation::HDEV:
+            return directSum(x, m, 3, gaps, tau);
+         default:
+            return directTotdev(x, m, tau);
+      }
+   }
+};
+
+
+int ClockDeviation_T::factorsTest( void )
+{
+   TUDEF("ClockDeviation", "factors");
+
+   TUASSERTE(unsigned long, 49, ClockDeviation::maxFactor(ClockDeviation::ADEV, 100));
+   TUASSERTE(unsigned long, 33, ClockDeviation::maxFactor(ClockDeviation::MDEV, 100));
+   TUASSERTE(unsigned long, 33, ClockDeviation::maxFactor(ClockDeviation::TDEV, 101));
+   TUASSERTE(unsigned long, 33, ClockDeviation::maxFactor(ClockDeviation::HDEV, 100));
+   TUASSERTE(unsigned long, 99, ClockDeviation::maxFactor(ClockDeviation::TOTDEV, 100));
+   TUASSERTE(unsigned long, 0, ClockDeviation::maxFactor(ClockDeviation::ADEV, 2));
+   TUASSERTE(unsigned long, 0, ClockDeviation::maxFactor(ClockDeviation::TOTDEV, 2));
+
+   vector<unsigned long> m;
+   m = ClockDeviation::factors(ClockDeviation::AllTaus, 5);
+   TUASSERTE(size_t, 5, m.size());
+   TUASSERTE(unsigned long, 5, m.back());
+
+   m = ClockDeviation::factors(ClockDeviation::OctaveTaus, 100);
+   const unsigned long octave[] = { 1, 2, 4, 8, 16, 32, 64 };
+   TUASSERTE(size_t, 7, m.size());
+   for (size_t k = 0; k < m.size() && k < 7; k++)
+      TUASSERTE(unsigned long, octave[k], m[k]);
+
+   m = ClockDeviation::factors(ClockDeviation::DecadeTaus, 1000);
+   const unsigned long decade[] = { 1, 2, 5, 10, 20, 50, 100, 200, 500, 1000 };
+   TUASSERTE(size_t, 10, m.size());
+   for (size_t k = 0; k < m.size() && k < 10; k++)
+      TUASSERTE(unsigned long, decade[k], m[k]);
+
+   m = ClockDeviation::factors(ClockDeviation::DecadeTaus, 4);
+   TUASSERTE(size_t, 2, m.size());
+
+   m = ClockDeviation::factors(ClockDeviation::OctaveTaus, 0);
+   TUASSERTE(size_t, 0, m.size());
+
+   TURETURN();
+}
+
+
+int ClockDeviation_T::computeTest( void )
+{
+   TUDEF("ClockDeviation", "compute");
+
+   const vector<double> x(makePhase(400, 7));
+   const double tau0(30.0);
+   ClockDeviation cd(tau0, 1);
+
+   for (int d = ClockDeviation::ADEV; d <= ClockDeviation::TOTDEV; d++)
+   {
+      ClockDeviation::Deviation dev( (ClockDeviation::Deviation)d );
+      vector<double> tau, sigma;
+      cd.compute(x, dev, ClockDeviation::AllTaus, tau, sigma);
+      TUASSERTE(size_t, ClockDeviation::maxFactor(dev, x.size()), sigma.size());
+      for (size_t k = 0; k < sigma.size(); k++)
+      {
+         double expected(direct(x, dev, k+1, false, tau0));
+         TUASSERTFE((k+1) * tau0, tau[k]);
+         TUASSERTFEPS(expected, sigma[k], 1.0e-9 * expected);
+      }
+   }
+
+      // Factors out of range
+   vector<unsigned long> m(1, 200);
+   try
+   {
+      cd.compute(x, ClockDeviation::ADEV, m);
+      TUFAIL("compute should have failed on m = 200 for 400 points");
+   }
+   catch (InvalidParameter& e)
+   {
+      TUPASS("compute");
+   }
+   m[0] = 0;
+   try
+   {
+      cd.compute(x, ClockDeviation::HDEV, m);
+      TUFAIL("compute should have failed on m = 0");
+   }
+   catch (InvalidParameter& e)
+   {
+      TUPASS("compute");
+   }
+
+   TURETURN();
+}
+
+
+int ClockDeviation_T::gapsTest( void )
+{
+   TUDEF("ClockDeviation", "setZeroGaps");
+
+   vector<double> x(makePhase(300, 11));
+   x[0] = 0.0;
+   x[57] = 0.0;
+   x[58] = 0.0;
+   x[200] = 0.0;
+   x[299] = 0.0;
+
+   ClockDeviation cd(1.0, 1);
+   cd.setZeroGaps(true);
+   for (int d = ClockDeviation::ADEV; d <= ClockDeviation::HDEV; d++)
+   {
+      ClockDeviation::Deviation dev( (ClockDeviation::Deviation)d );
+      vector<double> tau, sigma;
+      cd.compute(x, dev, ClockDeviation::AllTaus, tau, sigma);
+      for (size_t k = 0; k < sigma.size(); k++)
+      {
+            // Large MDEV windows all hold a gap, giving 0/0
+         double expected(direct(x, dev, k+1, true, 1.0));
+         if (expected != expected)
+            TUASSERT(sigma[k] != sigma[k]);
+         else
+            TUASSERTFEPS(expected, sigma[k], 1.0e-9 * expected);
+      }
+   }
+
+      // Zeros at either end are not gaps
+   vector<double> y(makePhase(300, 11));
+   y[0] = 0.0;
+   y[299] = 0.0;
+   vector<double> tau, sigma, sigmaNoGaps;
+   cd.compute(y, ClockDeviation::MDEV, ClockDeviation::OctaveTaus,
+              tau, sigma);
+   cd.setZeroGaps(false);
+   cd.compute(y, ClockDeviation::MDEV, ClockDeviation::OctaveTaus,
+              tau, sigmaNoGaps);
+   TUASSERTE(size_t, sigmaNoGaps.size(), sigma.size());
+   for (size_t k = 0; k < sigma.size(); k++)
+      TUASSERT(sigmaNoGaps[k] == sigma[k]);
+
+   TURETURN();
+}
+
+
+int ClockDeviation_T::threadsTest( void )
+{
+   TUDEF("ClockDeviation", "setNumThreads");
+
+   const vector<double> x(makePhase(2000, 3));
+   const vector<unsigned long> m(
+      ClockDeviation::factors(ClockDeviation::MDEV, ClockDeviation::AllTaus,
+                              x.size()));
+
+   ClockDeviation cd(1.0, 1);
+   for (int d = ClockDeviation::ADEV; d <= ClockDeviation::TOTDEV; d++)
+   {
+      ClockDeviation::Deviation dev( (ClockDeviation::Deviation)d );
+      cd.setNumThreads(1);
+      vector<double> serial(cd.compute(x, dev, m));
+      cd.setNumThreads(4);
+      vector<double> parallel(cd.compute(x, dev, m));
+      TUASSERTE(size_t, serial.size(), parallel.size());
+      bool same(serial.size() == parallel.size());
+      for (size_t k = 0; same && k < serial.size(); k++)
+         same = (serial[k] == parallel[k]);
+      TUASSERT(same);
+   }
+
+   TURETURN();
+}
+
+
+int ClockDeviation_T::accumulatorTest( void )
+{
+   TUDEF("ClockDeviationAccumulator", "deviation");
+
+   const vector<double> x(makePhase(1500, 5));
+   const double tau0(2.0);
+   const vector<unsigned long> m(
+      ClockDeviation::factors(ClockDeviation::OctaveTaus, 400));
+   const ClockDeviation::Deviation devs[] =
+      { ClockDeviation::ADEV, ClockDeviation::MDEV, ClockDeviation::TDEV,
+        ClockDeviation::HDEV };
+
+   ClockDeviationAccumulator acc(m, tau0);
+   ClockDeviation cd(tau0, 1);
+
+   TUASSERT(!acc.ready(ClockDeviation::ADEV, 0));
+   try
+   {
+      acc.deviation(ClockDeviation::ADEV, 0);
+      TUFAIL("deviation should have failed without data");
+   }
+   catch (InvalidRequest& e)
+   {
+      TUPASS("deviation");
+   }
+
+      // Compare at a few lengths along the way
+   const size_t checks[] = { 3, 10, 97, 600, 1500 };
+   size_t added(0);
+   for (int c = 0; c < 5; c++)
+   {
+      vector<double> part(x.begin(), x.begin() + checks[c]);
+      while (added < checks[c])
+         acc.add(x[added++]);
+      TUASSERTE(size_t, checks[c], acc.size());
+
+      for (int d = 0; d < 4; d++)
+      {
+         for (size_t k = 0; k < m.size(); k++)
+         {
+            bool usable(m[k] <= ClockDeviation::maxFactor(devs[d], part.size()));
+            TUASSERTE(bool, usable, acc.ready(devs[d], k));
+            if (!usable)
+               continue;
+            vector<double> sigma(cd.compute(part, devs[d],
+                                            vector<unsigned long>(1, m[k])));
+            TUASSERT(sigma[0] == acc.deviation(devs[d], k));
+            TUASSERTFE(m[k] * tau0, acc.getTau(k));
+         }
+      }
+   }
+
+   TUASSERT(!acc.ready(ClockDeviation::TOTDEV, 0));
+
+   acc.clear();
+   TUASSERTE(size_t, 0, acc.size());
+   acc.add(x);
+   vector<double> sigma(cd.compute(x, ClockDeviation::HDEV, m));
+   TUASSERT(sigma.back() == acc.deviation(ClockDeviation::HDEV, m.size()-1));
+
+   TURETURN();
+}
+
+
+int main()
+{
+   int errorTotal = 0;
+   ClockDeviation_T testClass;
+
+   errorTotal += testClass.factorsTest();
+   errorTotal += testClass.computeTest();
+   errorTotal += testClass.gapsTest();
+   errorTotal += testClass.threadsTest();
+   errorTotal += testClass.accumulatorTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return( errorTotal );
+}
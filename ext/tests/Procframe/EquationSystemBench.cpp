@@ -0,0 +1,150 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+
+
+/** @file EquationSystemBench.cpp
+ * Time per epoch of EquationSystem::Prepare(), split in the steps
+ * reported by EquationSystem::getPrepareTimes(), and of the whole
+ * SolverGeneral::Process(), for a network of stations with position,
+ * clock, troposphere and one phase ambiguity per satellite. Satellites
+ * rise and set along the run, so unknowns enter and leave the system.
+ * Not run by ctest.
+ *
+ * Usage: EquationSystemBench [epochs [stations ...]]
+ */
+
+#include "SolverGeneral.hpp"
+#include "GPSWeekSecond.hpp"
+#include "SystemTime.hpp"
+#include "TestSupport.hpp"
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+
+using namespace std;
+using namespace gpstk;
+
+int main(int argc, char *argv[])
+{
+   int epochs(100);
+   if (argc > 1)
+      epochs = std::max(1, atoi(argv[1]));
+   vector<int> sizes;
+   for (int i = 2; i < argc; i++)
+      sizes.push_back(atoi(argv[i]));
+   if (sizes.empty())
+   {
+      sizes.push_back(2);
+      sizes.push_back(5);
+      sizes.push_back(10);
+   }
+
+   const int numSats(14);
+
+   WhiteNoiseModel coordinatesModel(100.0);
+   TropoRandomWalkModel tropoModel;
+   PhaseAmbiguityModel ambiguityModel;
+
+   Variable dx( TypeID::dx, &coordinatesModel, true, false, 100.0 );
+   Variable dy( TypeID::dy, &coordinatesModel, true, false, 100.0 );
+   Variable dz( TypeID::dz, &coordinatesModel, true, false, 100.0 );
+   Variable cdt( TypeID::cdt );
+   cdt.setDefaultForced(true);
+   Variable tropo( TypeID::wetMap, &tropoModel, true, false, 10.0 );
+   Variable ambiguity( TypeID::BLC, &ambiguityModel, true, true );
+   ambiguity.setDefaultForced(true);
+
+   Equation equPC( TypeID::prefitC );
+   Equation equLC( TypeID::prefitL );
+   Variable vars[5] = { dx, dy, dz, cdt, tropo };
+   for (int i = 0; i < 5; i++)
+   {
+      equPC.addVariable(vars[i]);
+      equLC.addVariable(vars[i]);
+   }
+   equLC.addVariable(ambiguity);
+   equLC.setWeight(10000.0);
+
+   EquationSystem system;
+   system.addEquation(equPC);
+   system.addEquation(equLC);
+
+   cout << "ms per epoch over " << epochs << " epochs" << endl;
+   cout << setw(9) << "stations" << setw(10) << "max unks"
+        << setw(10) << "sets" << setw(8) << "index" << setw(8) << "phiQ" << setw(8) << "prefit"
+        << setw(10) << "geometry" << setw(9) << "prepare"
+        << setw(10) << "process" << endl;
+
+   for (size_t k = 0; k < sizes.size(); k++)
+   {
+      unsigned seed(7);
+      vector<gnssDataMap> data;
+      for (int n = 0; n < epochs; n++)
+         data.push_back(makePrefitNetwork(n, sizes[k], numSats, seed));
+
+      SolverGeneral solver(system);
+      EquationSystem::PrepareTimes prepare;
+      double process(0.0);
+      int numUnknowns(0);
+      for (int n = 0; n < epochs; n++)
+      {
+         CommonTime start = SystemTime().convertToCommonTime();
+         solver.Process(data[n]);
+         process += SystemTime().convertToCommonTime() - start;
+
+         EquationSystem eqSystem(solver.getEquationSystem());
+         prepare += eqSystem.getPrepareTimes();
+         numUnknowns = std::max(numUnknowns, eqSystem.getTotalNumVariables());
+      }
+
+      const double scale(1e3 / epochs);
+      cout << setw(9) << sizes[k] << setw(10) << numUnknowns
+           << fixed << setprecision(3)
+           << setw(10) << scale * prepare.unknowns
+           << setw(8) << scale * prepare.index
+           << setw(8) << scale * prepare.phiQ
+           << setw(8) << scale * prepare.prefit
+           << setw(10) << scale * prepare.geometry
+           << setw(9) << scale * prepare.total()
+           << setw(10) << scale * process << endl;
+   }
+
+   return 0;
+}
@@ -0,0 +1,134 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+
+/** @file ParallelObsStreamsBench.cpp
+ * Throughput of ParallelObsStreams merging a network of RINEX
+ * observation files, against the number of decoder threads.
+ * Not run by ctest.
+ *
+ * Usage: ParallelObsStreamsBench [-s stations] [-t maxThreads] [file ...]
+ * The files are cycled through until there are as many sources as
+ * stations (100 by default).  With no files, RINEX 2 and RINEX 3
+ * observation files from the test data directory are used.
+ */
+
+#include "ParallelObsStreams.hpp"
+#include "SystemTime.hpp"
+#include "ThreadUtils.hpp"
+
+#include "build_config.h"
+
+#include <cstring>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace gpstk;
+
+   /// Size of a file in bytes.
+static double fileSize(const string& fn)
+{
+   ifstream ifs(fn.c_str(), ios::in | ios::binary);
+   ifs.seekg(0, ios::end);
+   return static_cast<double>(ifs.tellg());
+}
+
+
+int main(int argc, char *argv[])
+{
+   unsigned stations = 100;
+   unsigned maxThreads = numProcessors();
+   vector<string> files;
+
+   for (int i = 1; i < argc; i++)
+   {
+      if (strcmp(argv[i], "-s") == 0 && i+1 < argc)
+         stations = atoi(argv[++i]);
+      else if (strcmp(argv[i], "-t") == 0 && i+1 < argc)
+         maxThreads = atoi(argv[++i]);
+      else
+         files.push_back(argv[i]);
+   }
+
+   if (files.empty())
+   {
+      string dir = getPathData() + getFileSep();
+      files.push_back(dir + "arlm200a.15o");
+      files.push_back(dir + "test_input_rinex3_76193040.14o");
+   }
+
+   double mb = 0;
+   for (unsigned s = 0; s < stations; s++)
+      mb += fileSize(files[s % files.size()]) / 1.0e6;
+
+   cout << stations << " stations, " << fixed << setprecision(1)
+        << mb << " MB, " << numProcessors() << " processors" << endl
+        << setw(8) << "threads" << setw(10) << "epochs"
+        << setw(10) << "seconds" << setw(10) << "MB/s"
+        << setw(10) << "speedup" << endl;
+
+   double serial = 0;
+   for (unsigned threads = 0; threads <= maxThreads;
+        threads = (threads == 0 ? 1 : threads * 2))
+   {
+      CommonTime start = SystemTime().convertToCommonTime();
+
+      ParallelObsStreams streams(threads);
+      for (unsigned s = 0; s < stations; s++)
+         streams.addRinexObsFile(files[s % files.size()]);
+
+      unsigned long epochs = 0;
+      size_t index;
+      while (streams.readEpoch(index))
+         epochs++;
+
+      double secs = SystemTime().convertToCommonTime() - start;
+      if (threads == 0)
+         serial = secs;
+
+      cout << setw(8) << threads << setw(10) << epochs
+           << setprecision(3) << setw(10) << secs
+           << setprecision(2) << setw(10) << mb / secs
+           << setw(10) << serial / secs << endl;
+   }
+
+   return 0;
+}
@@ -0,0 +1,395 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+
+#include "ParallelObsStreams.hpp"
+#include "NetworkObsStreams.hpp"
+#include "RinexObsStream.hpp"
+#include "Rinex3ObsStream.hpp"
+#include "Rinex3ObsHeader.hpp"
+
+#include "build_config.h"
+
+#include "TestUtil.hpp"
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace gpstk;
+
+//============================================================
+// Class decalarations
+//============================================================
+
+class ParallelObsStreams_T
+{
+public:
+
+   ParallelObsStreams_T();
+
+      // return values indicate number of failures, i.e., 0=PASS, !0=FAIL
+   int mergeTest( void );
+   int sourceTest( void );
+   int errorTest( void );
+   int networkTest( void );
+
+private:
+
+      /// Read every epoch of a file as operator>>() does.
+   static void readAll(const string& fileName, vector<gnssRinex>& epochs);
+
+      /// Compare two epochs, returning true if identical.
+   static bool sameEpoch(const gnssRinex& a, const gnssRinex& b);
+
+   string dataFilePath;
+
+   vector<string> inputFiles;
+      /// Epochs of each input file, read one file at a time.
+   vector< vector<gnssRinex> > expected;
+};
+
+
+ParallelObsStreams_T :: ParallelObsStreams_T()
+{
+   dataFilePath = gpstk::getPathData() + getFileSep();
+
+   const char *names[] =
+   {
+      "arlm200a.15o",
+      "arlm200b.15o",
+      "arlm200x.15o",
+      "arlm200z.15o",
+      "test_input_rinex2_obs_RinexObsFile.06o",
+      "test_input_rinex3_76193040.14o",
+      "test_input_rinex3_obs_RinexObsFile.15o",
+      "test_input_rinex3_obs_BadLineSize.15o",
+      "test_input_rinex3_obs_BadEpochFlag.15o",
+      0
+   };
+
+   for (int i = 0; names[i] != 0; i++)
+   {
+      inputFiles.push_back(dataFilePath + names[i]);
+      expected.push_back(vector<gnssRinex>());
+      readAll(inputFiles.back(), expected.back());
+   }
+}
+
+
+void ParallelObsStreams_T :: readAll( const string& fileName,
+                                      vector<gnssRinex>& epochs )
+{
+   Rinex3ObsStream r3strm(fileName.c_str());
+   Rinex3ObsHeader roh;
+   r3strm >> roh;
+   gnssRinex gRin;
+
+   if (roh.version < 3)
+   {
+      RinexObsStream r2strm(fileName.c_str());
+      while (r2strm >> gRin)
+         epochs.push_back(gRin);
+   }
+   else
+   {
+      while (r3strm >> gRin)
+         epochs.push_back(gRin);
+   }
+}
+
+
+bool ParallelObsStreams_T :: sameEpoch( const gnssRinex& a,
+                                        const gnssRinex& b )
+{
+   if (a.header.epoch != b.header.epoch ||
+       !(a.header.source == b.header.source) ||
+       a.header.epochFlag != b.header.epochFlag ||
+       a.body.size() != b.body.size())
+      return false;
+
+   satTypeValueMap::const_iterator ia = a.body.begin();
+   satTypeValueMap::const_iterator ib = b.body.begin();
+   for (; ia != a.body.end(); ++ia, ++ib)
+   {
+      if (ia->first != ib->first || ia->second.size() != ib->second.size())
+         return false;
+      typeValueMap::const_iterator ta = ia->second.begin();
+      typeValueMap::const_iterator tb = ib->second.begin();
+      for (; ta != ia->second.end(); ++ta, ++tb)
+      {
+         if (!(ta->first == tb->first) || ta->second != tb->second)
+            return false;
+      }
+   }
+   return true;
+}
+
+
+   /* Read all the files merged, with different numbers of threads
+    * and queue sizes, and check that each file's epochs arrive
+    * complete and in time order. */
+int ParallelObsStreams_T :: mergeTest( void )
+{
+   TUDEF("ParallelObsStreams", "readEpoch");
+
+   const unsigned configs[][3] =
+   {
+         // threads, queue size, mapped read
+      { 0, 1, 0 },
+      { 0, 16, 1 },
+      { 1, 1, 0 },
+      { 3, 1, 1 },
+      { 4, 3, 0 },
+      { 8, 16, 1 },
+   };
+
+   unsigned long total = 0;
+   for (size_t f = 0; f < expected.size(); f++)
+      total += expected[f].size();
+
+   for (size_t c = 0; c < sizeof(configs)/sizeof(configs[0]); c++)
+   {
+      ParallelObsStreams streams(configs[c][0], configs[c][1]);
+      streams.setMappedRead(configs[c][2] != 0);
+
+      for (size_t f = 0; f < inputFiles.size(); f++)
+         TUASSERT(streams.addRinexObsFile(inputFiles[f]));
+      TUASSERTE(size_t, inputFiles.size(), streams.size());
+
+      vector<size_t> next(inputFiles.size(), 0);
+      unsigned long count = 0, mismatches = 0, misordered = 0;
+      const gnssRinex *prev = NULL;
+      size_t prevIndex = 0;
+      CommonTime prevTime;
+      size_t index;
+
+      while (const gnssRinex *epoch = streams.readEpoch(index))
+      {
+         count++;
+         if (index >= expected.size() ||
+             next[index] >= expected[index].size() ||
+             !sameEpoch(*epoch, expected[index][next[index]]))
+            mismatches++;
+         else
+            next[index]++;
+
+            // time order, then file order for equal times
+         if (prev != NULL)
+         {
+            double dt = epoch->header.epoch - prevTime;
+            if (dt < 0 || (dt == 0 && index < prevIndex))
+               misordered++;
+         }
+         prev = epoch;
+         prevIndex = index;
+         prevTime = epoch->header.epoch;
+      }
+
+      TUASSERTE(unsigned long, total, count);
+      TUASSERTE(unsigned long, 0, mismatches);
+      TUASSERTE(unsigned long, 0, misordered);
+      for (size_t f = 0; f < expected.size(); f++)
+         TUASSERTE(size_t, expected[f].size(), next[f]);
+
+         // nothing more once exhausted
+      TUASSERT(streams.readEpoch(index) == NULL);
+   }
+
+   TURETURN();
+}
+
+
+   /* Read the files one at a time at different rates, which leaves
+    * some queues full while others are drained. */
+int ParallelObsStreams_T :: sourceTest( void )
+{
+   TUDEF("ParallelObsStreams", "readSourceEpoch");
+
+   for (unsigned threads = 0; threads <= 4; threads += 2)
+   {
+      ParallelObsStreams streams(threads, 2);
+      for (size_t f = 0; f < inputFiles.size(); f++)
+         streams.addRinexObsFile(inputFiles[f]);
+
+      vector<size_t> next(inputFiles.size(), 0);
+      unsigned long mismatches = 0;
+      bool more = true;
+      while (more)
+      {
+         more = false;
+         for (size_t f = 0; f < inputFiles.size(); f++)
+         {
+            for (size_t r = 0; r <= f % 3; r++)
+            {
+               gnssRinex gRin;
+               if (!streams.readSourceEpoch(f, gRin))
+                  break;
+               more = true;
+               if (next[f] >= expected[f].size() ||
+                   !sameEpoch(gRin, expected[f][next[f]]))
+                  mismatches++;
+               next[f]++;
+            }
+         }
+      }
+
+      TUASSERTE(unsigned long, 0, mismatches);
+      for (size_t f = 0; f < expected.size(); f++)
+         TUASSERTE(size_t, expected[f].size(), next[f]);
+   }
+
+   TURETURN();
+}
+
+
+int ParallelObsStreams_T :: errorTest( void )
+{
+   TUDEF("ParallelObsStreams", "addRinexObsFile");
+
+   ParallelObsStreams streams(2);
+
+   TUASSERT(!streams.addRinexObsFile(dataFilePath + "no_such_file.15o"));
+   TUASSERT(!streams.addRinexObsFile(dataFilePath +
+                                     "test_input_rinex3_obs_NotObs.15o"));
+   TUASSERTE(size_t, 0, streams.size());
+
+   TUASSERT(streams.addRinexObsFile(dataFilePath +
+                                    "test_input_rinex3_obs_RinexObsFile.15o"));
+   TUASSERT(streams.addRinexObsFile(dataFilePath +
+                                    "test_input_rinex3_obs_BadEpochFlag.15o"));
+   TUASSERTE(size_t, 2, streams.size());
+   TUASSERTE(size_t, 0, streams.indexOfSource(streams.getSource(0)));
+   TUASSERTE(size_t, 2, streams.indexOfSource(SourceID()));
+
+   gnssRinex gRin;
+   while (streams.readEpoch(gRin))
+      ;
+
+   TUCSM("getErrorText");
+   TUASSERTE(string, "", streams.getErrorText(0));
+   TUASSERT(streams.getErrorText(1) != "");
+
+      // no files can be added once reading has started
+   TUCSM("addRinexObsFile");
+   TUASSERT(!streams.addRinexObsFile(dataFilePath + "arlm200a.15o"));
+
+   TURETURN();
+}
+
+
+   /* Two RINEX 2 files of the same station on the same day, which
+    * differ in satellite system and so in SourceID. */
+int ParallelObsStreams_T :: networkTest( void )
+{
+   TUDEF("NetworkObsStreams", "readEpochData");
+
+   string refFile = dataFilePath + "test_input_rinex2_obs_RinexObsFile.06o";
+   string otherFile = dataFilePath + "test_input_rinex2_obs_SystemMixed.06o";
+   vector<gnssRinex> refEpochs, otherEpochs;
+   readAll(refFile, refEpochs);
+   readAll(otherFile, otherEpochs);
+
+   for (unsigned run = 0; run < 4; run++)
+   {
+         // 0 and 2 decoder threads, each with both synchronization policies
+      NetworkObsStreams network;
+      network.setNumThreads(run < 2 ? 0 : 2);
+      network.setKeepLaterEpochs(run % 2 == 1);
+      TUASSERT(network.addRinexObsFile(refFile));
+      TUASSERT(network.addRinexObsFile(otherFile));
+
+      SourceID refSource = network.sourceIDOfRinexObsFile(refFile);
+      SourceID otherSource = network.sourceIDOfRinexObsFile(otherFile);
+      TUASSERT(refSource == refEpochs[0].header.source);
+      TUASSERT(otherSource == otherEpochs[0].header.source);
+      TUASSERT(!(refSource == otherSource));
+      network.setReferenceSource(refSource);
+
+         // the streams of the stations, with their headers read
+      TUCSM("getRinexObsStream");
+      RinexObsStream* pRefStream = network.getRinexObsStream(refSource);
+      TUASSERT(pRefStream != NULL);
+      if (pRefStream != NULL)
+      {
+         TUASSERTE(string, refSource.sourceName,
+                   pRefStream->header.markerName);
+      }
+      TUASSERT(network.getRinexObsStream(otherSource) != NULL);
+      TUASSERT(network.getRinexObsStream(SourceID(SourceID::GPS, "NONE"))
+               == NULL);
+      TUCSM("readEpochData");
+
+      gnssDataMap gdsMap;
+      size_t epochs = 0;
+      unsigned long mismatches = 0;
+      while (network.readEpochData(gdsMap))
+      {
+         if (epochs >= refEpochs.size() ||
+             !sameEpoch(gdsMap.getGnssRinex(refSource), refEpochs[epochs]))
+            mismatches++;
+
+            // the other file has data at every reference epoch
+         if (epochs >= otherEpochs.size() ||
+             !sameEpoch(gdsMap.getGnssRinex(otherSource),
+                        otherEpochs[epochs]))
+            mismatches++;
+
+         epochs++;
+      }
+
+      TUASSERTE(size_t, refEpochs.size(), epochs);
+      TUASSERTE(unsigned long, 0, mismatches);
+   }
+
+   TURETURN();
+}
+
+
+int main()
+{
+   int errorTotal = 0;
+   ParallelObsStreams_T testClass;
+
+   errorTotal += testClass.mergeTest();
+   errorTotal += testClass.sourceTest();
+   errorTotal += testClass.errorTest();
+   errorTotal += testClass.networkTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return( errorTotal );
+}
@@ -0,0 +1,403 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+
+
+/** @file SatTypeValueTableBench.cpp
+ * Time per epoch of the example9/example14 PPP chain, on gnssRinex and
+ * on gnssRinexTable. With synthetic dual frequency data, the
+ * observation part of the chain is timed in three ways:
+ *
+ * - "flat": RequireObservables, SimpleFilter and ComputeLinear;
+ * - "full": the same, plus the cycle slip detectors, arc marker and
+ *   phase alignment;
+ * - "copy": one copy of the epoch, as done when epochs are stored.
+ *
+ * If the directory of the examples is given, the whole example9 chain,
+ * with the settings of station ONSA in pppconf.txt, is also timed on
+ * onsa2240.05o ("ppp"). Decimation is left out, so that every epoch goes
+ * through the chain, and the tides are computed before timing. Classes
+ * without a table path go through a gnssRinex copy. The solutions of
+ * both containers are compared.
+ *
+ * Not run by ctest.
+ *
+ * Usage: SatTypeValueTableBench [epochs [examplesDir]]
+ */
+
+#include "SatTypeValueTable.hpp"
+#include "ProcessingList.hpp"
+#include "RequireObservables.hpp"
+#include "SimpleFilter.hpp"
+#include "ComputeLinear.hpp"
+#include "LinearCombinations.hpp"
+#include "LICSDetector2.hpp"
+#include "MWCSDetector.hpp"
+#include "SatArcMarker.hpp"
+#include "PhaseCodeAlignment.hpp"
+#include "BasicModel.hpp"
+#include "EclipsedSatFilter.hpp"
+#include "GravitationalDelay.hpp"
+#include "ComputeSatPCenter.hpp"
+#include "CorrectObservables.hpp"
+#include "ComputeWindUp.hpp"
+#include "ComputeTropModel.hpp"
+#include "XYZ2NEU.hpp"
+#include "ComputeDOP.hpp"
+#include "SolverPPP.hpp"
+#include "SP3EphemerisStore.hpp"
+#include "SolidTides.hpp"
+#include "OceanLoading.hpp"
+#include "PoleTides.hpp"
+#include "RinexObsStream.hpp"
+#include "GPSWeekSecond.hpp"
+#include "SystemTime.hpp"
+#include "TestSupport.hpp"
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+
+using namespace std;
+using namespace gpstk;
+
+   // The example9 chain, with the settings of station ONSA
+class PPPChain
+{
+public:
+
+   PPPChain(const Position& nominalPos, SP3EphemerisStore& sp3,
+            const string& satDataFile)
+      : basic(nominalPos, sp3), grDelay(nominalPos),
+        svPcenter(nominalPos), corr(sp3),
+        windup(sp3, nominalPos, satDataFile),
+        neillTM(nominalPos.getAltitude(), nominalPos.getGeodeticLatitude(),
+                224),
+        computeTropo(neillTM), linear3(comb.pcPrefit),
+        baseChange(nominalPos), solver(true), wnM(100.0)
+   {
+      requireObs.addRequiredType(TypeID::P2);
+      requireObs.addRequiredType(TypeID::L1);
+      requireObs.addRequiredType(TypeID::L2);
+      requireObs.addRequiredType(TypeID::P1);
+
+      linear1.addLinear(comb.pdeltaCombination);
+      linear1.addLinear(comb.mwubbenaCombination);
+      linear1.addLinear(comb.ldeltaCombination);
+      linear1.addLinear(comb.liCombination);
+
+      markArc.setDeleteUnstableSats(true);
+      markArc.setUnstablePeriod(151.0);
+
+      basic.setMinElev(10.0);
+      basic.setDefaultObservable(TypeID::P1);
+
+      corr.setNominalPosition(nominalPos);
+      corr.setMonument(Triple(0.995, 0.0, 0.0));
+      corr.setL1pc(Triple(0.078, 0.0, 0.0));
+      corr.setL2pc(Triple(0.096, 0.0, 0.0));
+
+      linear2.addLinear(comb.pcCombination);
+      linear2.addLinear(comb.lcCombination);
+      pcFilter.setFilteredType(TypeID::PC);
+      linear3.addLinear(comb.lcPrefit);
+      solver.setCoordinatesModel(&wnM);
+
+      pList.push_back(requireObs);
+      pList.push_back(linear1);
+      pList.push_back(markCSLI2);
+      pList.push_back(markCSMW);
+      pList.push_back(markArc);
+      pList.push_back(basic);
+      pList.push_back(eclipsedSV);
+      pList.push_back(grDelay);
+      pList.push_back(svPcenter);
+      pList.push_back(corr);
+      pList.push_back(windup);
+      pList.push_back(computeTropo);
+      pList.push_back(linear2);
+      pList.push_back(pcFilter);
+      pList.push_back(phaseAlign);
+      pList.push_back(linear3);
+      pList.push_back(baseChange);
+      pList.push_back(cDOP);
+      pList.push_back(solver);
+   }
+
+   LinearCombinations comb;
+   RequireObservables requireObs;
+   ComputeLinear linear1;
+   LICSDetector2 markCSLI2;
+   MWCSDetector markCSMW;
+   SatArcMarker markArc;
+   BasicModel basic;
+   EclipsedSatFilter eclipsedSV;
+   GravitationalDelay grDelay;
+   ComputeSatPCenter svPcenter;
+   CorrectObservables corr;
+   ComputeWindUp windup;
+   NeillTropModel neillTM;
+   ComputeTropModel computeTropo;
+   ComputeLinear linear2;
+   SimpleFilter pcFilter;
+   PhaseCodeAlignment phaseAlign;
+   ComputeLinear linear3;
+   XYZ2NEU baseChange;
+   ComputeDOP cDOP;
+   SolverPPP solver;
+   WhiteNoiseModel wnM;
+   ProcessingList pList;
+
+private:
+
+   PPPChain(const PPPChain&);
+   PPPChain& operator=(const PPPChain&);
+};
+
+
+   // Times the example9 chain for station ONSA on both containers
+void timePPP(const string& dir)
+{
+   SP3EphemerisStore sp3;
+   sp3.rejectBadPositions(true);
+   sp3.rejectBadClocks(true);
+   sp3.loadFile(dir + "/igs13354.sp3");
+   sp3.loadFile(dir + "/igs13355.sp3");
+   sp3.loadFile(dir + "/igs13356.sp3");
+
+   Position nominalPos(3370658.5419, 711877.1496, 5349786.9542);
+
+   RinexObsStream rin((dir + "/onsa2240.05o").c_str());
+   vector<gnssRinex> data;
+   gnssRinex gRin;
+   while (rin >> gRin)
+      data.push_back(gRin);
+
+      // Tides do not depend on the container
+   SolidTides solid;
+   OceanLoading ocean;
+   ocean.setFilename(dir + "/OCEAN-GOT00.dat");
+   PoleTides pole;
+   pole.setXY(0.02094, 0.42728);
+   vector<Triple> tides;
+   for (size_t n = 0; n < data.size(); n++)
+   {
+      const CommonTime& time(data[n].header.epoch);
+      tides.push_back( solid.getSolidTide(time, nominalPos) +
+                       ocean.getOceanLoading("ONSA", time) +
+                       pole.getPoleTide(time, nominalPos) );
+   }
+
+   PPPChain mapChain(nominalPos, sp3, dir + "/PRN_GPS");
+   PPPChain tableChain(nominalPos, sp3, dir + "/PRN_GPS");
+
+   vector<gnssRinexTable> input(data.size());
+   for (size_t n = 0; n < data.size(); n++)
+      input[n].assign(data[n]);
+
+      // The solutions of the map chain, to compare with
+   vector< Vector<double> > solutions(data.size());
+
+   double times[2] = { 0.0, 0.0 };
+   int errors[2] = { 0, 0 };
+   CommonTime start;
+
+   start = SystemTime().convertToCommonTime();
+   for (size_t n = 0; n < data.size(); n++)
+   {
+      mapChain.corr.setExtraBiases(tides[n]);
+      gRin = data[n];
+      try
+      {
+         gRin >> mapChain.pList;
+         solutions[n] = mapChain.solver.solution;
+      }
+      catch(Exception& e)
+      {
+         errors[0]++;
+      }
+   }
+   times[0] = elapsed(start);
+
+   double maxDiff(0.0);
+   gnssRinexTable gTab;
+   start = SystemTime().convertToCommonTime();
+   for (size_t n = 0; n < data.size(); n++)
+   {
+      tableChain.corr.setExtraBiases(tides[n]);
+      gTab = input[n];
+      try
+      {
+         gTab >> tableChain.pList;
+         const Vector<double>& sol(tableChain.solver.solution);
+         if (sol.size() != solutions[n].size())
+            maxDiff = 1.0e9;
+         for (size_t i = 0; i < sol.size() && i < solutions[n].size(); i++)
+            maxDiff = std::max(maxDiff, std::abs(sol[i] - solutions[n][i]));
+      }
+      catch(Exception& e)
+      {
+         errors[1]++;
+      }
+   }
+   times[1] = elapsed(start);
+
+   const size_t epochs(data.size());
+   cout << setw(8) << "ppp" << fixed << setprecision(2)
+        << setw(12) << 1e6 * times[0] / epochs
+        << setw(12) << 1e6 * times[1] / epochs << endl;
+   cout << epochs << " ONSA epochs, rejected " << errors[0] << " vs "
+        << errors[1] << ", largest solution difference "
+        << scientific << setprecision(1) << maxDiff << endl;
+}
+
+int main(int argc, char *argv[])
+{
+   int epochs(2880);
+   if (argc > 1)
+      epochs = std::max(1, atoi(argv[1]));
+
+   unsigned seed(7);
+   vector<gnssRinex> data;
+   for (int n = 0; n < epochs; n++)
+      data.push_back(makeObsEpoch(n, seed));
+
+   LinearCombinations comb;
+
+   RequireObservables requireObs;
+   requireObs.addRequiredType(TypeID::P2);
+   requireObs.addRequiredType(TypeID::L1);
+   requireObs.addRequiredType(TypeID::L2);
+   requireObs.addRequiredType(TypeID::P1);
+
+   SimpleFilter pObsFilter;
+   pObsFilter.setFilteredType(TypeID::P2);
+   pObsFilter.addFilteredType(TypeID::P1);
+
+   ComputeLinear linear1;
+   linear1.addLinear(comb.pdeltaCombination);
+   linear1.addLinear(comb.mwubbenaCombination);
+   linear1.addLinear(comb.ldeltaCombination);
+   linear1.addLinear(comb.liCombination);
+
+   ComputeLinear linear2;
+   linear2.addLinear(comb.pcCombination);
+   linear2.addLinear(comb.lcCombination);
+
+   SimpleFilter pcFilter;
+   pcFilter.setFilteredType(TypeID::PC);
+
+   ComputeLinear linear3(comb.pcPrefit);
+   linear3.addLinear(comb.lcPrefit);
+
+   cout << "microseconds per epoch over " << epochs << " epochs" << endl;
+   cout << setw(8) << "chain" << setw(12) << "gnssRinex"
+        << setw(12) << "table" << endl;
+
+   for (int chain = 0; chain < 3; chain++)
+   {
+         // Detectors keep per-satellite state, so each container gets
+         // its own
+      LICSDetector2 markCSLI2[2];
+      MWCSDetector markCSMW[2];
+      SatArcMarker markArc[2];
+      PhaseCodeAlignment phaseAlign[2];
+
+      ProcessingList pList[2];
+      for (int k = 0; k < 2; k++)
+      {
+         markArc[k].setDeleteUnstableSats(true);
+         markArc[k].setUnstablePeriod(151.0);
+         phaseAlign[k].setCodeType(TypeID::PC);
+         phaseAlign[k].setPhaseType(TypeID::LC);
+         phaseAlign[k].setPhaseWavelength(0.107);
+
+         pList[k].push_back(requireObs);
+         pList[k].push_back(pObsFilter);
+         pList[k].push_back(linear1);
+         if (chain == 1)
+         {
+            pList[k].push_back(markCSLI2[k]);
+            pList[k].push_back(markCSMW[k]);
+            pList[k].push_back(markArc[k]);
+         }
+         pList[k].push_back(linear2);
+         pList[k].push_back(pcFilter);
+         if (chain == 1)
+            pList[k].push_back(phaseAlign[k]);
+         pList[k].push_back(linear3);
+      }
+
+      double times[2] = { 0.0, 0.0 };
+      CommonTime start;
+
+      gnssRinex gRin;
+      start = SystemTime().convertToCommonTime();
+      for (int n = 0; n < epochs; n++)
+      {
+         gRin = data[n];
+         if (chain < 2)
+            gRin >> pList[0];
+      }
+      times[0] = elapsed(start);
+
+      gnssRinexTable gTab;
+      vector<gnssRinexTable> input(epochs);
+      for (int n = 0; n < epochs; n++)
+         input[n].assign(data[n]);
+
+      start = SystemTime().convertToCommonTime();
+      for (int n = 0; n < epochs; n++)
+      {
+         gTab = input[n];
+         if (chain < 2)
+            gTab >> pList[1];
+      }
+      times[1] = elapsed(start);
+
+      const char* names[3] = { "flat", "full", "copy" };
+      cout << setw(8) << names[chain] << fixed << setprecision(2)
+           << setw(12) << 1e6 * times[0] / epochs
+           << setw(12) << 1e6 * times[1] / epochs << endl;
+   }
+
+   if (argc > 2)
+      timePPP(argv[2]);
+
+   return 0;
+}
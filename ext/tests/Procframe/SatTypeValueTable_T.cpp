@@ -0,0 +1,444 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S.
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software.
+//
+//Pursuant to DoD Directive 523024
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+
+   /* Check that satTypeValueTable holds the same data as satTypeValueMap
+    * through the same operations, and that ProcessingClass objects give
+    * the same results on gnssRinexTable as on gnssRinex, both the ones
+    * working on the table directly and the ones going through a copy.
+    * The modeling classes are checked on real data. */
+
+#include "SatTypeValueTable.hpp"
+#include "ProcessingList.hpp"
+#include "RequireObservables.hpp"
+#include "SimpleFilter.hpp"
+#include "ComputeLinear.hpp"
+#include "LinearCombinations.hpp"
+#include "LICSDetector.hpp"
+#include "LICSDetector2.hpp"
+#include "MWCSDetector.hpp"
+#include "SatArcMarker.hpp"
+#include "ComputeLC.hpp"
+#include "BasicModel.hpp"
+#include "ComputeTropModel.hpp"
+#include "XYZ2NEU.hpp"
+#include "GPSEphemerisStore.hpp"
+#include "Rinex3NavStream.hpp"
+#include "Rinex3NavHeader.hpp"
+#include "Rinex3NavData.hpp"
+#include "RinexObsStream.hpp"
+#include "RinexObsHeader.hpp"
+#include "GPSWeekSecond.hpp"
+#include "build_config.h"
+
+#include "TestUtil.hpp"
+#include "TestSupport.hpp"
+#include <cmath>
+#include <iostream>
+
+using namespace std;
+using namespace gpstk;
+
+//============================================================
+// Class decalarations
+//============================================================
+
+class SatTypeValueTable_T
+{
+public:
+
+      // return values indicate number of failures, i.e., 0=PASS, !0=FAIL
+   int conversionTest( void );
+   int operationsTest( void );
+   int processTest( void );
+   int modelTest( void );
+
+private:
+
+      /// Whether a table holds exactly the data of a map
+   static bool same(const satTypeValueTable& table, const satTypeValueMap& map)
+   {
+      satTypeValueMap other;
+      table.exportTo(other);
+      if (other.size() != map.size() || table.numSats() != map.size())
+         return false;
+      for (satTypeValueMap::const_iterator it = map.begin();
+           it != map.end(); ++it)
+      {
+         satTypeValueMap::const_iterator it2(other.find((*it).first));
+         if (it2 == other.end() || (*it2).second != (*it).second)
+            return false;
+      }
+      return true;
+   }
+};
+
+
+int SatTypeValueTable_T::conversionTest( void )
+{
+   TUDEF("satTypeValueTable", "assign");
+
+   unsigned seed(3);
+   satTypeValueTable table;
+   for (int n = 0; n < 5; n++)
+   {
+         // The same table is reused for every epoch
+      gnssRinex gRin(makeObsEpoch(n, seed, true));
+      table.assign(gRin.body);
+      TUASSERT(same(table, gRin.body));
+      TUASSERTE(size_t, gRin.body.numElements(), table.numElements());
+      TUASSERT(table.getSatID() == gRin.body.getSatID());
+      TUASSERT(table.getTypeID() == gRin.body.getTypeID());
+
+      gnssRinexTable gTab(gRin);
+      gnssRinex back;
+      gTab.exportTo(back);
+      TUASSERTE(CommonTime, gRin.header.epoch, back.header.epoch);
+      TUASSERT(same(gTab.body, back.body));
+   }
+
+   testFramework.changeSourceMethod("value");
+
+      // Satellites and types inserted out of order
+   satTypeValueMap map;
+   table.clear();
+   TUASSERTE(size_t, 0, table.numSats());
+   for (int i = 0; i < 40; i++)
+   {
+      SatID sat((17 * i) % 23 + 1, SatID::systemGPS);
+      TypeID type( (i % 3 == 0) ? TypeID::C1 :
+                   ((i % 3 == 1) ? TypeID::L2 : TypeID::elevation) );
+      const double v(uniform(seed));
+      map[sat][type] = v;
+      table.value(sat, type) = v;
+   }
+   TUASSERT(same(table, map));
+
+   testFramework.changeSourceMethod("getValue");
+
+   SatID sat(map.begin()->first);
+   TUASSERTE(double, map.getValue(sat, TypeID::C1),
+             table.getValue(sat, TypeID::C1));
+   try
+   {
+      table.getValue(SatID(30, SatID::systemGPS), TypeID::C1);
+      TUFAIL("Missing satellite should throw");
+   }
+   catch (SatIDNotFound& e)
+   {
+      TUPASS("Missing satellite");
+   }
+   try
+   {
+      table.getValue(sat, TypeID::P2);
+      TUFAIL("Missing type should throw");
+   }
+   catch (TypeIDNotFound& e)
+   {
+      TUPASS("Missing type");
+   }
+
+   TURETURN();
+}
+
+
+int SatTypeValueTable_T::operationsTest( void )
+{
+   TUDEF("satTypeValueTable", "removeSatID");
+
+   unsigned seed(5);
+   gnssRinex gRin(makeObsEpoch(1, seed, true));
+   satTypeValueMap map(gRin.body);
+   satTypeValueTable table(map);
+
+   SatIDSet some;
+   some.insert(map.begin()->first);
+   some.insert((++map.begin())->first);
+   some.insert(SatID(32, SatID::systemGPS));
+   map.removeSatID(some);
+   table.removeSatID(some);
+   TUASSERT(same(table, map));
+
+   testFramework.changeSourceMethod("removeTypeID");
+   map.removeTypeID(TypeID::L1);
+   table.removeTypeID(TypeID::L1);
+   TUASSERT(same(table, map));
+
+   testFramework.changeSourceMethod("keepOnlyTypeID");
+   TypeIDSet types;
+   types.insert(TypeID::C1);
+   types.insert(TypeID::P2);
+   types.insert(TypeID::L2);
+   TUASSERT(same(table.extractTypeID(types), map.extractTypeID(types)));
+   map.keepOnlyTypeID(types);
+   table.keepOnlyTypeID(types);
+   TUASSERT(same(table, map));
+
+   testFramework.changeSourceMethod("getMatrixOfTypes");
+   types.insert(TypeID::L1);
+   Matrix<double> m1(map.getMatrixOfTypes(types));
+   Matrix<double> m2(table.getMatrixOfTypes(types));
+   bool equal(m1.rows() == m2.rows() && m1.cols() == m2.cols());
+   for (size_t i = 0; equal && i < m1.rows(); i++)
+      for (size_t j = 0; equal && j < m1.cols(); j++)
+         equal = (m1(i,j) == m2(i,j));
+   TUASSERT(equal);
+
+   testFramework.changeSourceMethod("insertTypeIDVector");
+   Vector<double> v(map.numSats());
+   for (size_t i = 0; i < v.size(); i++)
+      v(i) = uniform(seed);
+   map.insertTypeIDVector(TypeID::prefitC, v);
+   table.insertTypeIDVector(TypeID::prefitC, v);
+   TUASSERT(same(table, map));
+   try
+   {
+      table.insertTypeIDVector(TypeID::prefitL, Vector<double>(1, 0.0));
+      TUFAIL("Wrong vector size should throw");
+   }
+   catch (NumberOfSatsMismatch& e)
+   {
+      TUPASS("Wrong vector size");
+   }
+
+   testFramework.changeSourceMethod("insertMatrix");
+   TypeIDSet newTypes;
+   newTypes.insert(TypeID::rho);
+   newTypes.insert(TypeID::elevation);
+   Matrix<double> data(map.numSats(), 2);
+   for (size_t i = 0; i < data.rows(); i++)
+   {
+      data(i,0) = uniform(seed);
+      data(i,1) = uniform(seed);
+   }
+   map.insertMatrix(newTypes, data);
+   table.insertMatrix(newTypes, data);
+   TUASSERT(same(table, map));
+
+   testFramework.changeSourceMethod("keepOnlySatID");
+   SatIDSet kept;
+   kept.insert(map.begin()->first);
+   kept.insert(map.rbegin()->first);
+   TUASSERT(same(table.extractSatID(kept), map.extractSatID(kept)));
+   map.keepOnlySatID(kept);
+   table.keepOnlySatID(kept);
+   TUASSERT(same(table, map));
+
+   testFramework.changeSourceMethod("insertSat");
+      // A satellite added between the others, then given values
+   SatID middle(map.begin()->first.id + 1, SatID::systemGPS);
+   map[middle][TypeID::C1] = 1.5;
+   table.value(middle, TypeID::C1) = 1.5;
+   TUASSERT(same(table, map));
+   TUASSERTE(int, 1, table.satIndex(middle));
+   TUASSERTE(int, -1, table.typeIndex(TypeID::L1));
+
+   TURETURN();
+}
+
+
+int SatTypeValueTable_T::processTest( void )
+{
+   TUDEF("ProcessingList", "Process");
+
+   LinearCombinations comb;
+
+   RequireObservables requireObs;
+   requireObs.addRequiredType(TypeID::P2);
+   requireObs.addRequiredType(TypeID::L1);
+   requireObs.addRequiredType(TypeID::L2);
+
+   SimpleFilter pObsFilter;
+   pObsFilter.setFilteredType(TypeID::P2);
+   pObsFilter.addFilteredType(TypeID::P1);
+
+   ComputeLinear linear1;
+   linear1.addLinear(comb.pdeltaCombination);
+   linear1.addLinear(comb.mwubbenaCombination);
+   linear1.addLinear(comb.ldeltaCombination);
+   linear1.addLinear(comb.liCombination);
+
+   ComputeLinear linear2;
+   linear2.addLinear(comb.pcCombination);
+   linear2.addLinear(comb.lcCombination);
+
+      // Detectors keep per-satellite state, so each chain has its own
+   LICSDetector2 markCSLI2[2];
+   SatArcMarker markArc[2];
+   for (int k = 0; k < 2; k++)
+   {
+      markArc[k].setDeleteUnstableSats(false);
+   }
+
+   ProcessingList pList[2];
+   for (int k = 0; k < 2; k++)
+   {
+      pList[k].push_back(requireObs);
+      pList[k].push_back(pObsFilter);
+      pList[k].push_back(linear1);
+      pList[k].push_back(markCSLI2[k]);
+      pList[k].push_back(markArc[k]);
+      pList[k].push_back(linear2);
+   }
+
+   unsigned seed(11);
+   gnssRinexTable gTab;
+   bool allSame(true);
+   size_t minSats(100);
+   for (int n = 0; n < 20; n++)
+   {
+      gnssRinex gRin(makeObsEpoch(n, seed, true));
+      gTab.assign(gRin);
+
+      gRin >> pList[0];
+      gTab >> pList[1];
+
+      allSame = allSame && same(gTab.body, gRin.body);
+      minSats = std::min(minSats, gRin.numSats());
+   }
+   TUASSERT(allSame);
+      // Filters did remove satellites, but not all of them
+   TUASSERT(minSats > 0 && minSats < 11);
+
+   TURETURN();
+}
+
+
+   /* The modeling part of a PPP chain on real data, with the classes
+    * working on the table directly mixed with runs of classes going
+    * through a copy. */
+int SatTypeValueTable_T::modelTest( void )
+{
+   TUDEF("ProcessingList", "Process");
+
+   string dataFilePath( gpstk::getPathData() + getFileSep() );
+
+   GPSEphemerisStore store;
+   Rinex3NavStream nstrm( (dataFilePath + "arlm2000.15n").c_str() );
+   Rinex3NavHeader nhdr;
+   Rinex3NavData nrec;
+   nstrm >> nhdr;
+   while (nstrm >> nrec)
+   {
+      if (nrec.sat.system == SatID::systemGPS)
+         store.addEphemeris(GPSEphemeris(nrec));
+   }
+
+   RinexObsStream ostrm( (dataFilePath + "arlm200a.15o").c_str() );
+   RinexObsHeader ohdr;
+   ostrm >> ohdr;
+   Position nominalPos(ohdr.antennaPosition);
+
+   LinearCombinations comb;
+
+   RequireObservables requireObs;
+   requireObs.addRequiredType(TypeID::P2);
+   requireObs.addRequiredType(TypeID::L1);
+   requireObs.addRequiredType(TypeID::L2);
+
+   ComputeLinear linear;
+   linear.addLinear(comb.liCombination);
+   linear.addLinear(comb.mwubbenaCombination);
+
+   ComputeLC getLC;
+   SimpleTropModel tropModel(20.0, 1013.0, 50.0);
+   ComputeTropModel computeTropo(tropModel);
+   XYZ2NEU baseChange(nominalPos);
+
+      // Classes keeping state, one for each chain
+   BasicModel model[2];
+   LICSDetector markCSLI[2];
+   LICSDetector2 markCSLI2[2];
+   MWCSDetector markCSMW[2];
+   SatArcMarker markArc[2];
+
+   ProcessingList pList[2];
+   for (int k = 0; k < 2; k++)
+   {
+      model[k] = BasicModel(nominalPos, store, TypeID::C1, true);
+      markArc[k].setDeleteUnstableSats(false);
+
+      pList[k].push_back(requireObs);
+      pList[k].push_back(linear);
+      pList[k].push_back(getLC);
+      pList[k].push_back(markCSLI[k]);
+      pList[k].push_back(markCSLI2[k]);
+      pList[k].push_back(markCSMW[k]);
+      pList[k].push_back(model[k]);
+      pList[k].push_back(markArc[k]);
+      pList[k].push_back(baseChange);
+      pList[k].push_back(computeTropo);
+   }
+
+   gnssRinex gRin;
+   gnssRinexTable gTab;
+   bool allSame(true);
+   int epochs(0);
+   size_t sats(0);
+   while (ostrm >> gRin)
+   {
+      gTab.assign(gRin);
+
+      gRin >> pList[0];
+      gTab >> pList[1];
+
+      allSame = allSame && same(gTab.body, gRin.body);
+      sats += gRin.numSats();
+      epochs++;
+   }
+   TUASSERT(allSame);
+   TUASSERT(epochs > 10);
+      // Most satellites go through the whole chain
+   TUASSERT(sats > 3 * epochs);
+
+   TURETURN();
+}
+
+
+int main()
+{
+   int errorTotal = 0;
+   SatTypeValueTable_T testClass;
+
+   errorTotal += testClass.conversionTest();
+   errorTotal += testClass.operationsTest();
+   errorTotal += testClass.processTest();
+   errorTotal += testClass.modelTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return( errorTotal );
+}
@@ -0,0 +1,206 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+
+
+/** @file SolverGeneralBench.cpp
+ * Time of the SolverGeneral measurement update against the number of
+ * stations, for a network set up as in example14: per-station
+ * position, clock and troposphere, satellite clocks common to all
+ * stations, code and (heavier weighted) phase equations. The update
+ * through the inverted weight matrix, as SolverGeneral did before,
+ * is compared with the update built from the diagonal weights.
+ * Not run by ctest.
+ *
+ * Usage: SolverGeneralBench [stations ...]
+ */
+
+#include "SolverGeneral.hpp"
+#include "SimpleKalmanFilter.hpp"
+#include "GPSWeekSecond.hpp"
+#include "SystemTime.hpp"
+#include "TestSupport.hpp"
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+
+using namespace std;
+using namespace gpstk;
+
+   /// The name of station s; station 0 is the master
+static SourceID stationSource(int s)
+{
+   return SourceID(SourceID::GPS, "S" + StringUtils::asString(s));
+}
+
+static SourceID masterSource()
+{
+   return stationSource(0);
+}
+
+int main(int argc, char *argv[])
+{
+   vector<int> sizes;
+   for (int i = 1; i < argc; i++)
+      sizes.push_back(atoi(argv[i]));
+   if (sizes.empty())
+   {
+      sizes.push_back(5);
+      sizes.push_back(10);
+      sizes.push_back(20);
+      sizes.push_back(40);
+   }
+
+   const int numSats(10);
+
+   WhiteNoiseModel coordinatesModel(100.0);
+   TropoRandomWalkModel tropoModel;
+
+   Variable dx( TypeID::dx, &coordinatesModel, true, false, 100.0 );
+   Variable dy( TypeID::dy, &coordinatesModel, true, false, 100.0 );
+   Variable dz( TypeID::dz, &coordinatesModel, true, false, 100.0 );
+   Variable cdt( TypeID::cdt );
+   cdt.setDefaultForced(true);
+   Variable tropo( TypeID::wetMap, &tropoModel, true, false, 10.0 );
+   Variable satClock( TypeID::dtSat );
+   satClock.setSourceIndexed(false);
+   satClock.setSatIndexed(true);
+   satClock.setDefaultForced(true);
+
+      // As in example14, the master station has no receiver clock, to
+      // separate receiver and satellite clocks
+   Equation equPCRef( TypeID::prefitC );
+   Equation equLCRef( TypeID::prefitL );
+   Equation equPCMaster( TypeID::prefitC );
+   Equation equLCMaster( TypeID::prefitL );
+   Variable vars[6] = { dx, dy, dz, tropo, satClock, cdt };
+   for (int i = 0; i < 6; i++)
+   {
+      equPCRef.addVariable(vars[i]);
+      equLCRef.addVariable(vars[i]);
+      if (i < 5)
+      {
+         equPCMaster.addVariable(vars[i]);
+         equLCMaster.addVariable(vars[i]);
+      }
+   }
+   equLCRef.setWeight(10000.0);
+   equLCMaster.setWeight(10000.0);
+   equPCMaster.header.equationSource = masterSource();
+   equLCMaster.header.equationSource = masterSource();
+
+   EquationSystem system;
+   system.addEquation(equPCMaster);
+   system.addEquation(equLCMaster);
+
+   cout << setw(9) << "stations" << setw(8) << "meas" << setw(10) << "unknowns"
+        << setw(12) << "inverse ms" << setw(13) << "weighted ms"
+        << setw(9) << "speedup" << setw(12) << "solver ms" << endl;
+
+   for (size_t k = 0; k < sizes.size(); k++)
+   {
+      unsigned seed(7);
+      gnssDataMap gdsMap(makePrefitNetwork(0, sizes[k], numSats, seed, false));
+
+      Equation pc(equPCRef), lc(equLCRef);
+      pc.header.equationSource = Variable::someSources;
+      lc.header.equationSource = Variable::someSources;
+      for (int s = 1; s < sizes[k]; s++)
+      {
+         pc.addSource2Set(stationSource(s));
+         lc.addSource2Set(stationSource(s));
+      }
+      EquationSystem network(system);
+      network.addEquation(pc);
+      network.addEquation(lc);
+
+      EquationSystem eqSystem(network);
+      eqSystem.Prepare(gdsMap);
+      const Matrix<double> phi(eqSystem.getPhiMatrix());
+      const Matrix<double> Q(eqSystem.getQMatrix());
+      const Vector<double> z(eqSystem.getPrefitsVector());
+      const Matrix<double> H(eqSystem.getGeometryMatrix());
+      const Matrix<double> W(eqSystem.getWeightsMatrix());
+      const int m(eqSystem.getTotalNumVariables());
+
+      Vector<double> x0(m, 0.0);
+      Matrix<double> P0(m, m, 0.0);
+      for (int i = 0; i < m; i++)
+         P0(i,i) = 100.0;
+
+      Vector<double> w(W.rows());
+      for (size_t i = 0; i < W.rows(); i++)
+         w(i) = W(i,i);
+
+      const int reps(std::max(1, 200 / sizes[k]));
+
+      CommonTime start = SystemTime().convertToCommonTime();
+      for (int r = 0; r < reps; r++)
+      {
+         SimpleKalmanFilter kalman(x0, P0);
+         kalman.Compute(phi, Q, z, H, inverseChol(W));
+      }
+      double tInverse = elapsed(start) / reps;
+
+      start = SystemTime().convertToCommonTime();
+      for (int r = 0; r < reps; r++)
+      {
+         SimpleKalmanFilter kalman(x0, P0);
+         kalman.ComputeWeighted(phi, Q, z, H, w);
+      }
+      double tWeighted = elapsed(start) / reps;
+
+      start = SystemTime().convertToCommonTime();
+      for (int r = 0; r < reps; r++)
+      {
+         SolverGeneral solver(network);
+         gnssDataMap data(gdsMap);
+         solver.Process(data);
+      }
+      double tSolver = elapsed(start) / reps;
+
+      cout << setw(9) << sizes[k] << setw(8) << z.size() << setw(10) << m
+           << fixed << setprecision(2)
+           << setw(12) << 1e3 * tInverse << setw(13) << 1e3 * tWeighted
+           << setw(9) << tInverse / tWeighted
+           << setw(12) << 1e3 * tSolver << endl;
+   }
+
+   return 0;
+}
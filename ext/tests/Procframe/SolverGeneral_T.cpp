@@ -0,0 +1,501 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+
+   /* Check that the measurement update built directly from a diagonal
+    * matrix of weights (SimpleKalmanFilter::ComputeWeighted(), used by
+    * SolverGeneral, SolverPPP and CodeKalmanSolver) gives the results
+    * of the update through the inverted weight matrix, and that the state
+    * SolverGeneral carries between epochs follows unknowns as they enter
+    * and leave the equation system. */
+
+#include "SolverGeneral.hpp"
+#include "SimpleKalmanFilter.hpp"
+#include "GPSWeekSecond.hpp"
+
+#include "TestUtil.hpp"
+#include "TestSupport.hpp"
+#include <cmath>
+#include <iostream>
+#include <map>
+
+using namespace std;
+using namespace gpstk;
+
+//============================================================
+// Class decalarations
+//============================================================
+
+class SolverGeneral_T
+{
+public:
+
+      // return values indicate number of failures, i.e., 0=PASS, !0=FAIL
+   int kalmanTest( void );
+   int weightsErrorTest( void );
+   int networkTest( void );
+   int trackingTest( void );
+
+private:
+
+      /// Largest element of |a-b| relative to the largest element of |b|
+   static double relDiff(const Matrix<double>& a, const Matrix<double>& b)
+   {
+      double d(0.0), m(0.0);
+      for (size_t i = 0; i < a.rows(); i++)
+         for (size_t j = 0; j < a.cols(); j++)
+         {
+            d = std::max(d, std::fabs(a(i,j) - b(i,j)));
+            m = std::max(m, std::fabs(b(i,j)));
+         }
+      return d / m;
+   }
+
+   static double relDiff(const Vector<double>& a, const Vector<double>& b)
+   {
+      double d(0.0), m(0.0);
+      for (size_t i = 0; i < a.size(); i++)
+      {
+         d = std::max(d, std::fabs(a(i) - b(i)));
+         m = std::max(m, std::fabs(b(i)));
+      }
+      return d / m;
+   }
+};
+
+
+int SolverGeneral_T::kalmanTest( void )
+{
+   TUDEF("SimpleKalmanFilter", "ComputeWeighted");
+
+   const size_t numStates(7), numMeas(45);
+   unsigned seed(17);
+
+   Vector<double> x0(numStates, 0.0);
+   Matrix<double> P0(numStates, numStates, 0.0);
+   Matrix<double> phi(numStates, numStates, 0.0);
+   Matrix<double> Q(numStates, numStates, 0.0);
+   for (size_t i = 0; i < numStates; i++)
+   {
+      P0(i,i) = 1.0e4;
+      phi(i,i) = 1.0;
+      Q(i,i) = (i < 3 ? 1.0e-2 : 0.0);
+   }
+
+   SimpleKalmanFilter dense(x0, P0), weighted(x0, P0), byMatrix(x0, P0);
+   SimpleKalmanFilter denseCorr(x0, P0), byMatrixCorr(x0, P0);
+
+   for (int epoch = 0; epoch < 5; epoch++)
+   {
+      Matrix<double> H(numMeas, numStates);
+      Vector<double> z(numMeas), w(numMeas);
+      Matrix<double> R(numMeas, numMeas, 0.0), W(numMeas, numMeas, 0.0);
+      for (size_t i = 0; i < numMeas; i++)
+      {
+         for (size_t j = 0; j < numStates; j++)
+            H(i,j) = uniform(seed);
+         z(i) = 10.0 * uniform(seed);
+            // Mix code-like and phase-like weights
+         w(i) = (i % 2 ? 1.0e4 : 1.0) * (1.5 + uniform(seed));
+         R(i,i) = 1.0 / w(i);
+         W(i,i) = w(i);
+      }
+
+      dense.Compute(phi, Q, z, H, R);
+      weighted.ComputeWeighted(phi, Q, z, H, w);
+      byMatrix.ComputeWeighted(phi, Q, z, H, W);
+
+      TUASSERT(relDiff(weighted.xhat, dense.xhat) < 1.0e-9);
+      TUASSERT(relDiff(weighted.P, dense.P) < 1.0e-9);
+
+         // A diagonal matrix of weights goes the way of the vector
+      TUASSERT(relDiff(byMatrix.xhat, weighted.xhat) == 0.0);
+      TUASSERT(relDiff(byMatrix.P, weighted.P) == 0.0);
+
+         // Correlated pairs of measurements are inverted
+      for (size_t i = 0; i + 1 < numMeas; i += 2)
+         W(i,i+1) = W(i+1,i) = 0.5 * std::min(W(i,i), W(i+1,i+1));
+      denseCorr.Compute(phi, Q, z, H, inverseChol(W));
+      byMatrixCorr.ComputeWeighted(phi, Q, z, H, W);
+
+      TUASSERT(relDiff(byMatrixCorr.xhat, denseCorr.xhat) == 0.0);
+      TUASSERT(relDiff(byMatrixCorr.P, denseCorr.P) == 0.0);
+   }
+
+   TURETURN();
+}
+
+
+int SolverGeneral_T::weightsErrorTest( void )
+{
+   TUDEF("SimpleKalmanFilter", "ComputeWeighted");
+
+   Vector<double> x0(2, 0.0);
+   Matrix<double> P0(2, 2, 0.0);
+   P0(0,0) = P0(1,1) = 100.0;
+   SimpleKalmanFilter kalman(x0, P0);
+   Matrix<double> phi(ident<double>(2)), Q(2, 2, 0.0);
+
+   Matrix<double> H(3, 2, 1.0);
+   Vector<double> z(3, 1.0), w(3, 1.0);
+
+   w(1) = 0.0;
+   try
+   {
+      kalman.ComputeWeighted(phi, Q, z, H, w);
+      TUFAIL("Expected InvalidSolver for a zero weight");
+   }
+   catch (InvalidSolver& e)
+   {
+      TUPASS("InvalidSolver");
+   }
+
+   Vector<double> w2(2, 1.0);
+   try
+   {
+      kalman.ComputeWeighted(phi, Q, z, H, w2);
+      TUFAIL("Expected InvalidSolver for mismatched weights");
+   }
+   catch (InvalidSolver& e)
+   {
+      TUPASS("InvalidSolver");
+   }
+
+   TURETURN();
+}
+
+
+   /* A network of stations with per-station position and clock, and
+    * per-satellite weights, solved by SolverGeneral and by a filter
+    * fed the inverted weight matrix of the same equation system. */
+int SolverGeneral_T::networkTest( void )
+{
+   TUDEF("SolverGeneral", "Process");
+
+   const int numStations(4), numSats(9);
+   const double truth[3] = { 1.25, -0.5, 2.0 };
+   unsigned seed(99);
+
+      // Loose enough for the data to determine the positions
+   WhiteNoiseModel coordinatesModel(1.0e5);
+   Variable dx( TypeID::dx, &coordinatesModel );
+   Variable dy( TypeID::dy, &coordinatesModel );
+   Variable dz( TypeID::dz, &coordinatesModel );
+   Variable cdt( TypeID::cdt );
+   cdt.setDefaultForced(true);
+
+   Equation equPC( TypeID::prefitC );
+   equPC.addVariable(dx);
+   equPC.addVariable(dy);
+   equPC.addVariable(dz);
+   equPC.addVariable(cdt);
+
+   EquationSystem system;
+   system.addEquation(equPC);
+
+   SolverGeneral solver(system);
+
+   CommonTime epoch( GPSWeekSecond(1800, 3600.0) );
+   gnssDataMap gdsMap;
+   for (int s = 0; s < numStations; s++)
+   {
+      gnssRinex gRin;
+      gRin.header.source = SourceID(SourceID::GPS,
+                                    "ST0" + StringUtils::asString(s));
+      gRin.header.epoch = epoch;
+      const double clock(100.0 * uniform(seed));
+      for (int prn = 1; prn <= numSats; prn++)
+      {
+         SatID sat(prn, SatID::systemGPS);
+         double e[3] = { uniform(seed), uniform(seed), uniform(seed) + 1.5 };
+         double norm(std::sqrt(e[0]*e[0] + e[1]*e[1] + e[2]*e[2]));
+         double prefit(clock);
+         gRin.body[sat][TypeID::dx] = -e[0] / norm;
+         gRin.body[sat][TypeID::dy] = -e[1] / norm;
+         gRin.body[sat][TypeID::dz] = -e[2] / norm;
+         for (int i = 0; i < 3; i++)
+            prefit -= truth[i] * e[i] / norm;
+         gRin.body[sat][TypeID::prefitC] = prefit;
+         gRin.body[sat][TypeID::weight] = 0.5 + 0.05 * prn;
+      }
+      gdsMap.addGnssRinex(gRin);
+   }
+
+      // Reference: the first epoch through the inverted weight matrix
+   EquationSystem refSystem(system);
+   refSystem.Prepare(gdsMap);
+   Matrix<double> W(refSystem.getWeightsMatrix());
+   int numUnknowns(refSystem.getTotalNumVariables());
+   Vector<double> x0(numUnknowns, 0.0);
+   Matrix<double> P0(numUnknowns, numUnknowns, 0.0);
+   VariableSet unkSet(refSystem.getVarUnknowns());
+   int i(0);
+   for (VariableSet::const_iterator it = unkSet.begin();
+        it != unkSet.end();
+        ++it, ++i)
+      P0(i,i) = (*it).getInitialVariance();
+   SimpleKalmanFilter reference(x0, P0);
+   reference.Compute( refSystem.getPhiMatrix(),
+                      refSystem.getQMatrix(),
+                      refSystem.getPrefitsVector(),
+                      refSystem.getGeometryMatrix(),
+                      inverseChol(W) );
+
+   TUASSERT(W.isDiagonal());
+   TUASSERTE(size_t, size_t(numStations * numSats), W.rows());
+
+   solver.Process(gdsMap);
+
+   TUASSERTE(size_t, reference.xhat.size(), solver.solution.size());
+   TUASSERT(relDiff(solver.solution, reference.xhat) < 1.0e-9);
+   TUASSERT(relDiff(solver.covMatrix, reference.P) < 1.0e-9);
+
+      // Noise-free data, so every station recovers the position offset
+   for (int s = 0; s < numStations; s++)
+   {
+      SourceID source(SourceID::GPS, "ST0" + StringUtils::asString(s));
+      TUASSERTFEPS(solver.getSolution(TypeID::dx, source), truth[0], 1.0e-3);
+      TUASSERTFEPS(solver.getSolution(TypeID::dy, source), truth[1], 1.0e-3);
+      TUASSERTFEPS(solver.getSolution(TypeID::dz, source), truth[2], 1.0e-3);
+   }
+
+   TURETURN();
+}
+
+
+   /* All satellites in view for the first epochs, so that the unknowns
+    * do not change, then setting and rising, so that unknowns enter and
+    * leave the equation system, and then all in view again, so that the
+    * number of unknowns grows. The state and covariance carried
+    * by SolverGeneral between epochs are checked against a filter whose
+    * state is kept per Variable, and the column indexes and timing
+    * counters of the equation system are checked too. */
+int SolverGeneral_T::trackingTest( void )
+{
+   TUDEF("SolverGeneral", "Process");
+
+   const int numStations(2), numSats(8), numEpochs(14);
+   const double truth[3] = { -0.75, 1.5, 0.25 };
+   unsigned seed(7);
+
+   WhiteNoiseModel coordinatesModel(1.0e5);
+   StochasticModel biasModel;
+   Variable dx( TypeID::dx, &coordinatesModel );
+   Variable dy( TypeID::dy, &coordinatesModel );
+   Variable dz( TypeID::dz, &coordinatesModel );
+   Variable cdt( TypeID::cdt );
+   cdt.setDefaultForced(true);
+   Variable bias( TypeID::BLC, &biasModel, true, true, 1.0e4 );
+   bias.setDefaultForced(true);
+
+   Equation equPC( TypeID::prefitC );
+   equPC.addVariable(dx);
+   equPC.addVariable(dy);
+   equPC.addVariable(dz);
+   equPC.addVariable(cdt);
+
+   Equation equLC( TypeID::prefitL );
+   equLC.addVariable(dx);
+   equLC.addVariable(dy);
+   equLC.addVariable(dz);
+   equLC.addVariable(cdt);
+   equLC.addVariable(bias);
+   equLC.setWeight(100.0);
+
+   EquationSystem system;
+   system.addEquation(equPC);
+   system.addEquation(equLC);
+
+   SolverGeneral solver(system);
+   EquationSystem refSystem(system);
+
+      // Reference state, kept per Variable
+   std::map<Variable, double> refState;
+   std::map<Variable, std::map<Variable, double> > refCov;
+
+   double biases[numStations][numSats];
+   for (int s = 0; s < numStations; s++)
+      for (int k = 0; k < numSats; k++)
+         biases[s][k] = 10.0 * uniform(seed);
+
+   for (int n = 0; n < numEpochs; n++)
+   {
+      CommonTime epoch( GPSWeekSecond(1800, 3600.0 + 30.0 * n) );
+      gnssDataMap gdsMap;
+      for (int s = 0; s < numStations; s++)
+      {
+         gnssRinex gRin;
+         gRin.header.source = SourceID(SourceID::GPS,
+                                       "ST0" + StringUtils::asString(s));
+         gRin.header.epoch = epoch;
+         const double clock(100.0 * uniform(seed));
+         for (int prn = 1; prn <= numSats; prn++)
+         {
+               // After the first epochs, each satellite is out of view
+               // one epoch in four, and then all are back in view
+            if (n >= 4 && n < 10 && (prn + n + s) % 4 == 0)
+               continue;
+            SatID sat(prn, SatID::systemGPS);
+            double e[3] = { uniform(seed), uniform(seed), uniform(seed) + 1.5 };
+            double norm(std::sqrt(e[0]*e[0] + e[1]*e[1] + e[2]*e[2]));
+            double prefit(clock);
+            gRin.body[sat][TypeID::dx] = -e[0] / norm;
+            gRin.body[sat][TypeID::dy] = -e[1] / norm;
+            gRin.body[sat][TypeID::dz] = -e[2] / norm;
+            for (int i = 0; i < 3; i++)
+               prefit -= truth[i] * e[i] / norm;
+            gRin.body[sat][TypeID::prefitC] = prefit;
+            gRin.body[sat][TypeID::prefitL] = prefit + biases[s][prn-1];
+         }
+         gdsMap.addGnssRinex(gRin);
+      }
+
+         // Reference: previous state and covariance looked up per Variable,
+         // new unknowns seeded as SolverGeneral always did
+      refSystem.Prepare(gdsMap);
+      VariableSet unkSet(refSystem.getVarUnknowns());
+      const int numUnknowns(unkSet.size());
+      Vector<double> x0(numUnknowns, 0.0);
+      Matrix<double> P0(numUnknowns, numUnknowns, 0.0);
+      int i(0);
+      for (VariableSet::const_iterator it1 = unkSet.begin();
+           it1 != unkSet.end();
+           ++it1, ++i)
+      {
+         TUASSERTE(int, i, refSystem.getUnknownIndex(*it1));
+         const bool isNew(refState.find(*it1) == refState.end());
+         if (isNew)
+         {
+               // The seeding below does not reach the solution
+            TUASSERTE(double, 0.0, refSystem.getPhiMatrix()(i,i));
+         }
+         if (n == 0)
+         {
+            P0(i,i) = (*it1).getInitialVariance();
+            continue;
+         }
+         x0(i) = refState[*it1];
+         P0(i,i) = refCov[*it1][*it1];
+         int j(i+1);
+         VariableSet::const_iterator it2(it1);
+         for (++it2; it2 != unkSet.end(); ++it2, ++j)
+         {
+            if (refState.find(*it2) != refState.end())
+               P0(i,j) = P0(j,i) = refCov[*it1][*it2];
+            else
+               P0(i,j) = P0(j,i) = (*it2).getInitialVariance();
+         }
+      }
+      SimpleKalmanFilter reference(x0, P0);
+      reference.Compute( refSystem.getPhiMatrix(),
+                         refSystem.getQMatrix(),
+                         refSystem.getPrefitsVector(),
+                         refSystem.getGeometryMatrix(),
+                         inverseChol(refSystem.getWeightsMatrix()) );
+      refState.clear();
+      refCov.clear();
+      i = 0;
+      for (VariableSet::const_iterator it1 = unkSet.begin();
+           it1 != unkSet.end();
+           ++it1, ++i)
+      {
+         refState[*it1] = reference.xhat(i);
+         int j(0);
+         for (VariableSet::const_iterator it2 = unkSet.begin();
+              it2 != unkSet.end();
+              ++it2, ++j)
+            refCov[*it1][*it2] = reference.P(i,j);
+      }
+
+      solver.Process(gdsMap);
+
+      TUASSERTE(size_t, reference.xhat.size(), solver.solution.size());
+      TUASSERT(relDiff(solver.solution, reference.xhat) < 1.0e-9);
+      TUASSERT(relDiff(solver.covMatrix, reference.P) < 1.0e-9);
+
+      EquationSystem::PrepareTimes times(
+                              solver.getEquationSystem().getPrepareTimes() );
+      TUASSERT(times.unknowns >= 0.0);
+      TUASSERT(times.index >= 0.0);
+      TUASSERT(times.phiQ >= 0.0);
+      TUASSERT(times.prefit >= 0.0);
+      TUASSERT(times.geometry >= 0.0);
+      TUASSERT(times.constraints >= 0.0);
+   }
+
+      // Accessors of the stored state
+   SourceID source(SourceID::GPS, "ST00");
+   Variable vdx(dx);
+   vdx.setSource(source);
+   TUASSERTFEPS(solver.getSolution(vdx), truth[0], 1.0e-3);
+   TUASSERTFEPS(solver.getSolution(TypeID::dy, source), truth[1], 1.0e-3);
+   TUASSERTE(double, solver.getCovariance(vdx, vdx), solver.getVariance(vdx));
+   Variable vdy(dy);
+   vdy.setSource(source);
+   TUASSERTE(double, solver.getCovariance(vdx, vdy),
+             solver.getCovariance(vdy, vdx));
+
+   Variable missing(TypeID::dx);
+   missing.setSource(SourceID(SourceID::GPS, "NONE"));
+   TUASSERTE(int, -1, solver.getEquationSystem().getUnknownIndex(missing));
+   try
+   {
+      solver.getSolution(missing);
+      TUFAIL("getSolution() did not throw for an unknown Variable");
+   }
+   catch (InvalidRequest&)
+   {
+      TUPASS("getSolution() threw for an unknown Variable");
+   }
+
+   TURETURN();
+}
+
+
+int main()
+{
+   int errorTotal = 0;
+   SolverGeneral_T testClass;
+
+   errorTotal += testClass.kalmanTest();
+   errorTotal += testClass.weightsErrorTest();
+   errorTotal += testClass.networkTest();
+   errorTotal += testClass.trackingTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return( errorTotal );
+}
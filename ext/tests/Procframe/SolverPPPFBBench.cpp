@@ -0,0 +1,191 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+
+
+/** @file SolverPPPFBBench.cpp
+ * Memory held by SolverPPPFB for the stored epochs, against an estimate
+ * for the same epochs, reduced to the types the solver uses, kept as a
+ * std::list<gnssRinex>, and time of the
+ * forward pass, of one backward ReProcess() pass and of Smooth(), with
+ * the epochs kept in memory and spilled to a temporary file. Each epoch
+ * carries the types a typical PPP processing chain leaves in it, most of
+ * which the solver does not need. Not run by ctest.
+ *
+ * Usage: SolverPPPFBBench [epochs]
+ */
+
+#include "SolverPPPFB.hpp"
+#include "GPSWeekSecond.hpp"
+#include "SystemTime.hpp"
+#include "TestSupport.hpp"
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+
+using namespace std;
+using namespace gpstk;
+
+   /// One epoch of synthetic prefit data, with the other types the
+   /// PPP chain leaves in each epoch
+static gnssRinex makeEpoch(int n, int numSats, unsigned& seed)
+{
+   gnssRinex gRin(makePrefitEpoch(n, numSats, seed,
+                                  SourceID(SourceID::GPS, "BENCH")));
+   for (satTypeValueMap::iterator it = gRin.body.begin();
+        it != gRin.body.end(); ++it)
+   {
+      const int prn((*it).first.id);
+      typeValueMap& tv((*it).second);
+      tv[TypeID::cdt] = 1.0;
+      tv[TypeID::CSL1] = 0.0;
+      tv[TypeID::satArc] = 1.0 + (n + 5 * prn) / 50;
+         // Types left by the rest of the chain
+      tv[TypeID::C1] = 2.0e7;
+      tv[TypeID::P2] = 2.0e7;
+      tv[TypeID::L1] = 1.0e8;
+      tv[TypeID::L2] = 1.0e8;
+      tv[TypeID::PC] = 2.0e7;
+      tv[TypeID::LC] = 2.0e7;
+      tv[TypeID::elevation] = 45.0;
+      tv[TypeID::azimuth] = 90.0;
+      tv[TypeID::rho] = 2.0e7;
+      tv[TypeID::tropoSlant] = 2.5;
+      tv[TypeID::rel] = 1.0;
+      tv[TypeID::gravDelay] = 0.01;
+   }
+   return gRin;
+}
+
+   /// Rough size of a std::list<gnssRinex> holding 'g': one node per
+   /// satellite map entry and per type map entry, plus the list node
+static size_t listBytes(const gnssRinex& g)
+{
+   const size_t mapNode(4 * sizeof(void*));
+   size_t bytes(sizeof(gnssRinex) + 2 * sizeof(void*));
+   for (satTypeValueMap::const_iterator it = g.body.begin();
+        it != g.body.end(); ++it)
+   {
+      bytes += mapNode + sizeof(SatID) + sizeof(typeValueMap);
+      bytes += (*it).second.size()
+               * (mapNode + sizeof(TypeID) + sizeof(double));
+   }
+   return bytes;
+}
+
+int main(int argc, char *argv[])
+{
+   int epochs(2880);
+   if (argc > 1)
+      epochs = std::max(2, atoi(argv[1]));
+
+   const int numSats(14);
+   unsigned seed(7);
+   vector<gnssRinex> data;
+   for (int n = 0; n < epochs; n++)
+      data.push_back(makeEpoch(n, numSats, seed));
+
+      // Types the solver keeps, including the postfit residuals
+   TypeIDSet keepTypes;
+   keepTypes.insert(TypeID::dx);
+   keepTypes.insert(TypeID::dy);
+   keepTypes.insert(TypeID::dz);
+   keepTypes.insert(TypeID::cdt);
+   keepTypes.insert(TypeID::wetMap);
+   keepTypes.insert(TypeID::prefitC);
+   keepTypes.insert(TypeID::prefitL);
+   keepTypes.insert(TypeID::weight);
+   keepTypes.insert(TypeID::CSL1);
+   keepTypes.insert(TypeID::satArc);
+   keepTypes.insert(TypeID::postfitC);
+   keepTypes.insert(TypeID::postfitL);
+
+   cout << epochs << " epochs, seconds per pass" << endl;
+   cout << setw(8) << "spill" << setw(14) << "list MB"
+        << setw(12) << "stored MB" << setw(10) << "forward"
+        << setw(10) << "backward" << setw(10) << "smooth" << endl;
+
+   for (int spill = 0; spill < 2; spill++)
+   {
+      size_t bytesList(0);
+      CommonTime start;
+
+         // Forwards-backwards
+      SolverPPPFB fb;
+      if (spill)
+         fb.setSpillThreshold(0);
+      start = SystemTime().convertToCommonTime();
+      for (int n = 0; n < epochs; n++)
+      {
+         gnssRinex g(data[n]);
+         fb.Process(g);
+         bytesList += listBytes(g.extractTypeID(keepTypes));
+      }
+      const double forward(elapsed(start));
+      const size_t stored(fb.getStoredBytes());
+
+      start = SystemTime().convertToCommonTime();
+      fb.ReProcess(1);
+      const double backward(elapsed(start));
+
+         // Smoother
+      SolverPPPFB rts;
+      rts.setSmoothing(true);
+      if (spill)
+         rts.setSpillThreshold(0);
+      for (int n = 0; n < epochs; n++)
+      {
+         gnssRinex g(data[n]);
+         rts.Process(g);
+      }
+      start = SystemTime().convertToCommonTime();
+      rts.Smooth();
+      const double smooth(elapsed(start));
+
+      cout << setw(8) << (spill ? "yes" : "no")
+           << fixed << setprecision(2)
+           << setw(14) << bytesList / 1048576.0
+           << setw(12) << stored / 1048576.0
+           << setprecision(3)
+           << setw(10) << forward << setw(10) << backward
+           << setw(10) << smooth << endl;
+   }
+
+   return 0;
+}
@@ -0,0 +1,503 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S.
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software.
+//
+//Pursuant to DoD Directive 523024
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+
+   /* Check that GnssRinexStore gives back the epochs it was given, in
+    * memory and spilled to a temporary file, that SolverPPPFB gives the
+    * same forwards-backwards results as a list of gnssRinex epochs run
+    * through SolverPPP, and that its Rauch-Tung-Striebel smoother carries
+    * the final static coordinates back to every epoch. */
+
+#include "SolverPPPFB.hpp"
+#include "GnssRinexStore.hpp"
+#include "GPSWeekSecond.hpp"
+
+#include "TestUtil.hpp"
+#include "TestSupport.hpp"
+#include <cmath>
+#include <iostream>
+#include <list>
+
+using namespace std;
+using namespace gpstk;
+
+//============================================================
+// Class decalarations
+//============================================================
+
+class SolverPPPFB_T
+{
+public:
+
+      // return values indicate number of failures, i.e., 0=PASS, !0=FAIL
+   int storeTest( void );
+   int reProcessTest( void );
+   int smoothTest( void );
+
+private:
+
+      /// Simulated PPP data: a static receiver tracking satellites that
+      /// rise and set, one of them twice, with a constant ambiguity per
+      /// arc.
+   static std::vector<gnssRinex> simulate( size_t numEpochs );
+
+      /// Truth of the static coordinates
+   static const double truth[3];
+};
+
+
+const double SolverPPPFB_T::truth[3] = { 1.25, -0.75, 0.5 };
+
+
+std::vector<gnssRinex> SolverPPPFB_T::simulate( size_t numEpochs )
+{
+   const int numSats(10);
+   unsigned seed(29);
+   double tropo(0.1);
+
+   std::vector<double> ambiguity(2 * numSats);
+   for (size_t i = 0; i < ambiguity.size(); i++)
+   {
+      ambiguity[i] = 20.0 * uniform(seed);
+   }
+
+   std::vector<gnssRinex> data(numEpochs);
+   for (size_t k = 0; k < numEpochs; k++)
+   {
+      gnssRinex& g(data[k]);
+      g.header.source = SourceID(SourceID::GPS, "TEST");
+      g.header.epoch = GPSWeekSecond(1800, 3600.0 + 30.0 * k);
+      g.header.antennaType = "TESTANT";
+      g.header.antennaPosition = Triple(1000.0, 2000.0, 3000.0);
+      g.header.epochFlag = 0;
+
+      const double cdt(300.0 * uniform(seed));
+      tropo += 0.002 * uniform(seed);
+
+      for (int s = 0; s < numSats; s++)
+      {
+            // Satellites 0-5 are always in view, 6-7 set halfway, 8 rises
+            // halfway and 9 sets and rises again
+         bool inView(true);
+         int arc(1);
+         if (s == 6 || s == 7) inView = (k < numEpochs / 2);
+         if (s == 8) inView = (k >= numEpochs / 2);
+         if (s == 9)
+         {
+            inView = (k < numEpochs / 3 || k >= 2 * numEpochs / 3);
+            arc = (k < numEpochs / 3) ? 1 : 2;
+         }
+         if (!inView) continue;
+
+         const double az(0.8 * s + 0.002 * k);
+         const double el(0.3 + 0.1 * s - 0.0005 * k * (s % 3));
+         const double los[3] = { -cos(el) * sin(az),
+                                 -cos(el) * cos(az),
+                                 -sin(el) };
+         const double wetMap(1.0 / sin(el));
+
+         typeValueMap& tv(g.body[SatID(s + 1, SatID::systemGPS)]);
+         tv[TypeID::dx] = los[0];
+         tv[TypeID::dy] = los[1];
+         tv[TypeID::dz] = los[2];
+         tv[TypeID::cdt] = 1.0;
+         tv[TypeID::wetMap] = wetMap;
+         tv[TypeID::weight] = 1.0;
+         tv[TypeID::CSL1] = 0.0;
+         tv[TypeID::satArc] = arc;
+            // Not used by the solver, so not stored
+         tv[TypeID::elevation] = el;
+
+         const double rho( los[0] * truth[0] + los[1] * truth[1]
+                           + los[2] * truth[2] + cdt + wetMap * tropo );
+         tv[TypeID::prefitC] = rho + 0.5 * uniform(seed);
+         tv[TypeID::prefitL] = rho + ambiguity[2 * s + arc - 1]
+                               + 0.005 * uniform(seed);
+      }
+   }
+
+   return data;
+}
+
+
+int SolverPPPFB_T::storeTest( void )
+{
+   TUDEF("GnssRinexStore", "get");
+
+   std::vector<gnssRinex> data(simulate(20));
+
+   TypeIDSet types;
+   types.insert(TypeID::prefitC);
+   types.insert(TypeID::prefitL);
+   types.insert(TypeID::satArc);
+
+   for (int spill = 0; spill < 2; spill++)
+   {
+      GnssRinexStore store(types);
+      if (spill)
+      {
+         store.setSpillThreshold(0);
+      }
+
+      for (size_t k = 0; k < data.size(); k++)
+      {
+         store.push_back(data[k]);
+      }
+
+      TUASSERTE(size_t, data.size(), store.size());
+      if (spill)
+      {
+         TUASSERTE(size_t, 0, store.memoryBytes());
+         TUASSERT(store.spilledBytes() > 0);
+         store.mapSpill();
+      }
+      else
+      {
+         TUASSERTE(size_t, 0, store.spilledBytes());
+            // The chunk allocated, not the bytes of the records in it
+         TUASSERTE(size_t, 1048576, store.memoryBytes());
+      }
+
+      for (size_t k = data.size(); k > 0; --k)
+      {
+         gnssRinex g(store.get(k - 1));
+         const gnssRinex expected(data[k - 1].extractTypeID(types));
+
+         TUASSERTE(SourceID, expected.header.source, g.header.source);
+         TUASSERTE(CommonTime, expected.header.epoch, g.header.epoch);
+         TUASSERTE(std::string, expected.header.antennaType,
+                   g.header.antennaType);
+         TUASSERTE(double, expected.header.antennaPosition[2],
+                   g.header.antennaPosition[2]);
+         TUASSERTE(short, expected.header.epochFlag, g.header.epochFlag);
+         TUASSERTE(size_t, expected.numSats(), g.numSats());
+
+         bool same(true);
+         for (satTypeValueMap::const_iterator it = expected.body.begin();
+              it != expected.body.end(); ++it)
+         {
+            satTypeValueMap::const_iterator it2(g.body.find((*it).first));
+            same = same && (it2 != g.body.end())
+               && ((*it2).second.size() == (*it).second.size());
+            for (typeValueMap::const_iterator itT = (*it).second.begin();
+                 same && itT != (*it).second.end(); ++itT)
+            {
+               typeValueMap::const_iterator itT2(
+                  (*it2).second.find((*itT).first));
+               same = (itT2 != (*it2).second.end())
+                  && ((*itT2).second == (*itT).second);
+            }
+         }
+         TUASSERT(same);
+      }
+
+      testFramework.changeSourceMethod("set");
+
+         // Rewrite an epoch with fewer satellites and a new type
+      gnssRinex g(store.get(3));
+      SatIDSet removed;
+      removed.insert(g.body.begin()->first);
+      g.removeSatID(removed);
+      g.insertTypeIDVector(TypeID::postfitC,
+                           Vector<double>(g.numSats(), 0.25));
+      TypeIDSet moreTypes(types);
+      moreTypes.insert(TypeID::postfitC);
+      store.setTypeSet(moreTypes);
+      store.set(3, g);
+
+      gnssRinex g2(store.get(3));
+      TUASSERTE(size_t, data[3].numSats() - 1, g2.numSats());
+      TUASSERTE(double, 0.25, g2.body.begin()->second(TypeID::postfitC));
+      TUASSERTE(double, g.body.begin()->second(TypeID::prefitL),
+                g2.body.begin()->second(TypeID::prefitL));
+         // Neighbouring epochs are untouched
+      TUASSERTE(CommonTime, data[4].header.epoch,
+                store.get(4).header.epoch);
+
+      testFramework.changeSourceMethod("pop_front");
+
+      store.pop_front();
+      TUASSERTE(size_t, data.size() - 1, store.size());
+      TUASSERTE(CommonTime, data[1].header.epoch, store.front().header.epoch);
+      while (!store.empty())
+      {
+         store.pop_front();
+      }
+      TUASSERTE(size_t, 0, store.memoryBytes());
+      TUASSERTE(size_t, 0, store.spilledBytes());
+
+      testFramework.changeSourceMethod("get");
+   }
+
+   TURETURN();
+}
+
+
+int SolverPPPFB_T::reProcessTest( void )
+{
+   TUDEF("SolverPPPFB", "ReProcess");
+
+   std::vector<gnssRinex> data(simulate(60));
+
+      // Reference: the epochs kept in a list, run through SolverPPP
+   TypeIDSet keepTypes;
+   keepTypes.insert(TypeID::wetMap);
+   keepTypes.insert(TypeID::dx);
+   keepTypes.insert(TypeID::dy);
+   keepTypes.insert(TypeID::dz);
+   keepTypes.insert(TypeID::cdt);
+   keepTypes.insert(TypeID::prefitC);
+   keepTypes.insert(TypeID::prefitL);
+   keepTypes.insert(TypeID::weight);
+   keepTypes.insert(TypeID::CSL1);
+   keepTypes.insert(TypeID::satArc);
+
+   SolverPPP ppp;
+   std::list<gnssRinex> obsData;
+   for (size_t k = 0; k < data.size(); k++)
+   {
+      gnssRinex g(data[k]);
+      ppp.Process(g);
+      obsData.push_back(g.extractTypeID(keepTypes));
+   }
+   std::list<gnssRinex>::iterator pos;
+   std::list<gnssRinex>::reverse_iterator rpos;
+   for (rpos = obsData.rbegin(); rpos != obsData.rend(); ++rpos)
+      ppp.Process(*rpos);
+   for (pos = obsData.begin(); pos != obsData.end(); ++pos)
+      ppp.Process(*pos);
+   for (rpos = obsData.rbegin(); rpos != obsData.rend(); ++rpos)
+      ppp.Process(*rpos);
+
+   std::vector< Vector<double> > expected;
+   std::vector< Vector<double> > expectedPostfit;
+   for (pos = obsData.begin(); pos != obsData.end(); ++pos)
+   {
+      ppp.Process(*pos);
+      expected.push_back(ppp.solution);
+      expectedPostfit.push_back((*pos).getVectorOfTypeID(TypeID::postfitL));
+   }
+
+      // The stored epochs may be kept in memory or spilled
+   for (int spill = 0; spill < 2; spill++)
+   {
+      SolverPPPFB fb;
+      if (spill)
+      {
+         fb.setSpillThreshold(0);
+      }
+
+      for (size_t k = 0; k < data.size(); k++)
+      {
+         gnssRinex g(data[k]);
+         fb.Process(g);
+      }
+
+      fb.ReProcess(2);
+
+      if (spill)
+      {
+         TUASSERTE(size_t, 0, fb.getStoredBytes());
+      }
+      else
+      {
+         TUASSERT(fb.getStoredBytes() > 0);
+      }
+
+      size_t k(0);
+      bool same(true);
+      gnssRinex g;
+      while (fb.LastProcess(g))
+      {
+         same = same && (k < expected.size())
+            && (fb.solution.size() == expected[k].size());
+         for (size_t i = 0; same && i < expected[k].size(); i++)
+         {
+            same = (fb.solution(i) == expected[k](i));
+         }
+         Vector<double> postfit(g.getVectorOfTypeID(TypeID::postfitL));
+         for (size_t i = 0; same && i < postfit.size(); i++)
+         {
+            same = (postfit(i) == expectedPostfit[k](i));
+         }
+         ++k;
+      }
+      TUASSERTE(size_t, data.size(), k);
+      TUASSERT(same);
+      TUASSERTE(size_t, 0, fb.getStoredBytes());
+   }
+
+      // Limits on the postfit residuals reject the same satellites in
+      // memory and spilled
+   std::vector<double> xSolution[2];
+   int rejected[2];
+   for (int spill = 0; spill < 2; spill++)
+   {
+      SolverPPPFB fb;
+      if (spill)
+      {
+         fb.setSpillThreshold(0);
+      }
+
+      std::list<double> codeLimits, phaseLimits;
+      codeLimits.push_back(0.6);
+      phaseLimits.push_back(0.01);
+      fb.setCodeList(codeLimits);
+      fb.setPhaseList(phaseLimits);
+
+      for (size_t k = 0; k < data.size(); k++)
+      {
+         gnssRinex g(data[k]);
+         fb.Process(g);
+      }
+
+      fb.ReProcess();
+      rejected[spill] = fb.getRejectedMeasurements();
+
+      gnssRinex g;
+      while (fb.LastProcess(g))
+      {
+         xSolution[spill].push_back(fb.getSolution(TypeID::dx));
+      }
+   }
+   TUASSERTE(int, rejected[0], rejected[1]);
+   TUASSERT(xSolution[0] == xSolution[1]);
+   TUASSERTE(size_t, data.size(), xSolution[0].size());
+
+   TURETURN();
+}
+
+
+int SolverPPPFB_T::smoothTest( void )
+{
+   TUDEF("SolverPPPFB", "Smooth");
+
+   std::vector<gnssRinex> data(simulate(60));
+
+   for (int spill = 0; spill < 2; spill++)
+   {
+      SolverPPPFB fb;
+      fb.setSmoothing(true);
+      if (spill)
+      {
+         fb.setSpillThreshold(0);
+      }
+
+      SolverPPPFB empty;
+      try
+      {
+         empty.Smooth();
+         TUFAIL("Smooth() without recorded states should throw");
+      }
+      catch (ProcessingException& e)
+      {
+         TUPASS("Smooth() without recorded states");
+      }
+
+      Vector<double> lastFiltered;
+      Matrix<double> lastCovariance;
+      for (size_t k = 0; k < data.size(); k++)
+      {
+         gnssRinex g(data[k]);
+         fb.Process(g);
+         lastFiltered = fb.solution;
+         lastCovariance = fb.covMatrix;
+      }
+
+      fb.Smooth();
+
+         // Static coordinates are only known with the precision of the
+         // whole data set; the smoother carries the final solution back
+         // to every epoch
+      size_t k(0);
+      double maxCoordDiff(0.0), maxVarDiff(0.0), maxPostfit(0.0);
+      gnssRinex g;
+      while (fb.LastProcess(g))
+      {
+         for (int i = 1; i < 4; i++)
+         {
+            maxCoordDiff = std::max(maxCoordDiff,
+               std::fabs(fb.solution(i) - lastFiltered(i)));
+            maxVarDiff = std::max(maxVarDiff,
+               std::fabs(fb.covMatrix(i,i) - lastCovariance(i,i))
+               / lastCovariance(i,i));
+         }
+
+         Vector<double> postfit(g.getVectorOfTypeID(TypeID::postfitL));
+         TUASSERTE(size_t, data[k].numSats(), postfit.size());
+         for (size_t i = 0; i < postfit.size(); i++)
+         {
+            maxPostfit = std::max(maxPostfit, std::fabs(postfit(i)));
+         }
+
+         if (k + 1 == data.size())
+         {
+               // The last epoch keeps its filtered solution
+            bool same(fb.solution.size() == lastFiltered.size());
+            for (size_t i = 0; same && i < lastFiltered.size(); i++)
+            {
+               same = (fb.solution(i) == lastFiltered(i));
+            }
+            TUASSERT(same);
+         }
+         ++k;
+      }
+
+      TUASSERTE(size_t, data.size(), k);
+      TUASSERTFEPS(maxCoordDiff, 0.0, 1.0e-6);
+      TUASSERTFEPS(maxVarDiff, 0.0, 1.0e-6);
+         // Phase noise is 5 mm
+      TUASSERT(maxPostfit < 0.05);
+      TUASSERT(std::fabs(lastFiltered(1) - truth[0]) < 0.5);
+   }
+
+   TURETURN();
+}
+
+
+int main()
+{
+   int errorTotal = 0;
+   SolverPPPFB_T testClass;
+
+   errorTotal += testClass.storeTest();
+   errorTotal += testClass.reProcessTest();
+   errorTotal += testClass.smoothTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return( errorTotal );
+}
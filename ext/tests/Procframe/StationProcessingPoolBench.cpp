@@ -0,0 +1,195 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+
+/** @file StationProcessingPoolBench.cpp
+ * Time per epoch of StationProcessingPool running the preprocessing
+ * chain of a network (BasicModel, linear combinations, cycle slip
+ * detectors and a filter), against the number of threads.
+ * Not run by ctest.
+ *
+ * Usage: StationProcessingPoolBench [-s stations] [-t maxThreads]
+ * Each station processes the epochs of arlm200a.15o, with broadcast
+ * ephemerides from arlm2000.15n shared by all the stations.
+ */
+
+#include "StationProcessingPool.hpp"
+#include "ProcessingList.hpp"
+#include "BasicModel.hpp"
+#include "ComputeLinear.hpp"
+#include "LinearCombinations.hpp"
+#include "LICSDetector2.hpp"
+#include "MWCSDetector.hpp"
+#include "SimpleFilter.hpp"
+#include "GPSEphemerisStore.hpp"
+#include "GPSEphemeris.hpp"
+#include "Rinex3NavStream.hpp"
+#include "Rinex3NavHeader.hpp"
+#include "Rinex3NavData.hpp"
+#include "RinexObsStream.hpp"
+#include "RinexObsHeader.hpp"
+#include "SystemTime.hpp"
+#include "ThreadUtils.hpp"
+
+#include "build_config.h"
+
+#include <cstring>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace gpstk;
+
+   /// Processing chain of one station.
+struct StationChain
+{
+   StationChain(const Position& nominalPos, XvtStore<SatID>& store)
+      : model(nominalPos, store, TypeID::C1)
+   {
+      linear.addLinear(comb.pcCombination);
+      linear.addLinear(comb.liCombination);
+      linear.addLinear(comb.mwubbenaCombination);
+
+      pList.push_back(model);
+      pList.push_back(linear);
+      pList.push_back(markCSLI);
+      pList.push_back(markCSMW);
+      pList.push_back(filter);
+   }
+
+   LinearCombinations comb;
+   BasicModel model;
+   ComputeLinear linear;
+   LICSDetector2 markCSLI;
+   MWCSDetector markCSMW;
+   SimpleFilter filter;
+   ProcessingList pList;
+};
+
+
+int main(int argc, char *argv[])
+{
+   unsigned stations = 32;
+   unsigned maxThreads = numProcessors();
+
+   for (int i = 1; i < argc; i++)
+   {
+      if (strcmp(argv[i], "-s") == 0 && i+1 < argc)
+         stations = atoi(argv[++i]);
+      else if (strcmp(argv[i], "-t") == 0 && i+1 < argc)
+         maxThreads = atoi(argv[++i]);
+   }
+
+   string dir = getPathData() + getFileSep();
+
+   GPSEphemerisStore store;
+   Rinex3NavStream nstrm( (dir + "arlm2000.15n").c_str() );
+   Rinex3NavHeader nhdr;
+   Rinex3NavData nrec;
+   nstrm >> nhdr;
+   while (nstrm >> nrec)
+   {
+      if (nrec.sat.system == SatID::systemGPS)
+         store.addEphemeris(GPSEphemeris(nrec));
+   }
+   store.freezeIndex();
+
+   RinexObsStream ostrm( (dir + "arlm200a.15o").c_str() );
+   RinexObsHeader ohdr;
+   ostrm >> ohdr;
+   Position nominalPos(ohdr.antennaPosition);
+
+   vector<gnssRinex> epochs;
+   gnssRinex gRin;
+   while (ostrm >> gRin)
+      epochs.push_back(gRin);
+
+   vector<SourceID> sources;
+   for (unsigned s = 0; s < stations; s++)
+      sources.push_back( SourceID(SourceID::GPS,
+                                  "STA" + StringUtils::asString(s)) );
+
+   cout << stations << " stations, " << epochs.size() << " epochs, "
+        << numProcessors() << " processors" << endl
+        << setw(8) << "threads" << setw(12) << "us/epoch"
+        << setw(10) << "speedup" << endl;
+
+   double serial = 0;
+   for (unsigned threads = 1; threads <= maxThreads;
+        threads = (threads < 2 ? threads + 1 : threads * 2))
+   {
+      vector<StationChain*> chains;
+      StationProcessingPool pool(threads);
+      pool.addSharedStore(store);
+      for (unsigned s = 0; s < stations; s++)
+      {
+         chains.push_back(new StationChain(nominalPos, store));
+         pool.addStation(sources[s], chains.back()->pList);
+      }
+
+      CommonTime start = SystemTime().convertToCommonTime();
+
+         // One epoch of the network at a time, as a solver needs them
+      for (size_t e = 0; e < epochs.size(); e++)
+      {
+         gnssDataMap gds;
+         for (unsigned s = 0; s < stations; s++)
+         {
+            gRin = epochs[e];
+            gRin.header.source = sources[s];
+            gds.addGnssRinex(gRin);
+         }
+
+         pool.Process(gds);
+      }
+
+      double secs = SystemTime().convertToCommonTime() - start;
+      if (threads == 1)
+         serial = secs;
+
+      cout << setw(8) << threads << fixed
+           << setprecision(1) << setw(12) << 1.0e6 * secs / epochs.size()
+           << setprecision(2) << setw(10) << serial / secs << endl;
+
+      for (size_t s = 0; s < chains.size(); s++)
+         delete chains[s];
+   }
+
+   return 0;
+}
@@ -0,0 +1,519 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S.
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software.
+//
+//Pursuant to DoD Directive 523024
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+
+
+   /* Check that StationProcessingPool gives the same results as running
+    * the chain of each station one after another, with and without
+    * threads, that it only reads shared stores concurrently when they
+    * allow it, and that an exception only drops the data it came from. */
+
+#include "StationProcessingPool.hpp"
+#include "ProcessingList.hpp"
+#include "BasicModel.hpp"
+#include "ComputeLinear.hpp"
+#include "LinearCombinations.hpp"
+#include "LICSDetector2.hpp"
+#include "MWCSDetector.hpp"
+#include "SimpleFilter.hpp"
+#include "GPSEphemerisStore.hpp"
+#include "GPSEphemeris.hpp"
+#include "Rinex3NavStream.hpp"
+#include "Rinex3NavHeader.hpp"
+#include "Rinex3NavData.hpp"
+#include "RinexObsStream.hpp"
+#include "RinexObsHeader.hpp"
+
+#include "build_config.h"
+
+#include "TestUtil.hpp"
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace gpstk;
+
+//============================================================
+// Class decalarations
+//============================================================
+
+   // Processing chain of one station
+class StationChain
+{
+public:
+
+   StationChain(const Position& nominalPos, XvtStore<SatID>& store)
+      : model(nominalPos, store, TypeID::C1)
+   {
+      linear.addLinear(comb.pcCombination);
+      linear.addLinear(comb.liCombination);
+      linear.addLinear(comb.mwubbenaCombination);
+
+      pList.push_back(model);
+      pList.push_back(linear);
+      pList.push_back(markCSLI);
+      pList.push_back(markCSMW);
+      pList.push_back(filter);
+   }
+
+   ProcessingList pList;
+
+private:
+
+   LinearCombinations comb;
+   BasicModel model;
+   ComputeLinear linear;
+   LICSDetector2 markCSLI;
+   MWCSDetector markCSMW;
+   SimpleFilter filter;
+
+   StationChain(const StationChain&);
+   StationChain& operator=(const StationChain&);
+};
+
+
+   // Throws at one epoch
+class ThrowAt : public ProcessingClass
+{
+public:
+
+   ThrowAt(const CommonTime& t) : when(t) {}
+
+   virtual gnssSatTypeValue& Process(gnssSatTypeValue& gData)
+   { check(gData.header.epoch); return gData; }
+
+   virtual gnssRinex& Process(gnssRinex& gData)
+   { check(gData.header.epoch); return gData; }
+
+   virtual std::string getClassName(void) const
+   { return "ThrowAt"; }
+
+private:
+
+   void check(const CommonTime& t)
+   {
+      if (t == when)
+      {
+         ProcessingException e("epoch rejected");
+         GPSTK_THROW(e);
+      }
+   }
+
+   CommonTime when;
+};
+
+
+   // Store that does not allow concurrent reads
+class SerialStore : public XvtStore<SatID>
+{
+public:
+
+   SerialStore(const XvtStore<SatID>& s) : store(s) {}
+
+   virtual Xvt getXvt(const SatID& id, const CommonTime& t) const
+   { return store.getXvt(id, t); }
+   virtual void dump(std::ostream& s, short detail) const
+   { store.dump(s, detail); }
+   virtual void edit(const CommonTime& tmin, const CommonTime& tmax) {}
+   virtual void clear(void) {}
+   virtual TimeSystem getTimeSystem(void) const
+   { return store.getTimeSystem(); }
+   virtual CommonTime getInitialTime(void) const
+   { return store.getInitialTime(); }
+   virtual CommonTime getFinalTime(void) const
+   { return store.getFinalTime(); }
+   virtual bool hasVelocity(void) const
+   { return store.hasVelocity(); }
+   virtual bool isPresent(const SatID& id) const
+   { return store.isPresent(id); }
+
+private:
+
+   const XvtStore<SatID>& store;
+};
+
+
+class StationProcessingPool_T
+{
+public:
+
+   StationProcessingPool_T();
+
+      // return values indicate number of failures, i.e., 0=PASS, !0=FAIL
+   int dataMapTest( void );
+   int vectorTest( void );
+   int storeTest( void );
+   int errorTest( void );
+
+private:
+
+      /// Processed epochs of each station, one station at a time.
+   void reference(vector< vector<gnssRinex> >& result);
+
+      /// Whether 'gds' holds the same data as 'result'.
+   bool sameData(const gnssDataMap& gds,
+                 const vector< vector<gnssRinex> >& result,
+                 size_t skipStation = 99, size_t skipEpoch = 99) const;
+
+   static const size_t numStations = 6;
+
+   GPSEphemerisStore store;
+   Position nominalPos;
+
+      /// Input epochs of each station.
+   vector< vector<gnssRinex> > input;
+};
+
+
+const size_t StationProcessingPool_T::numStations;
+
+
+StationProcessingPool_T :: StationProcessingPool_T()
+{
+   string dataFilePath( gpstk::getPathData() + getFileSep() );
+
+   Rinex3NavStream nstrm( (dataFilePath + "arlm2000.15n").c_str() );
+   Rinex3NavHeader nhdr;
+   Rinex3NavData nrec;
+   nstrm >> nhdr;
+   while (nstrm >> nrec)
+   {
+      if (nrec.sat.system == SatID::systemGPS)
+         store.addEphemeris(GPSEphemeris(nrec));
+   }
+
+   RinexObsStream ostrm( (dataFilePath + "arlm200a.15o").c_str() );
+   RinexObsHeader ohdr;
+   ostrm >> ohdr;
+   nominalPos = ohdr.antennaPosition;
+
+   vector<gnssRinex> epochs;
+   gnssRinex gRin;
+   while (ostrm >> gRin)
+      epochs.push_back(gRin);
+
+      // Each station gets the same data with its own code bias
+   input.resize(numStations);
+   for (size_t s = 0; s < numStations; s++)
+   {
+      SourceID source(SourceID::GPS, "STA" + StringUtils::asString(s));
+      for (size_t e = 0; e < epochs.size(); e++)
+      {
+         gnssRinex g(epochs[e]);
+         g.header.source = source;
+         for (satTypeValueMap::iterator it = g.body.begin();
+              it != g.body.end();
+              ++it)
+         {
+            it->second[TypeID::C1] += double(s);
+            it->second[TypeID::P1] += double(s);
+            it->second[TypeID::P2] += double(s);
+         }
+         input[s].push_back(g);
+      }
+   }
+}
+
+
+void StationProcessingPool_T ::
+reference(vector< vector<gnssRinex> >& result)
+{
+   result = input;
+   for (size_t s = 0; s < numStations; s++)
+   {
+      StationChain chain(nominalPos, store);
+      for (size_t e = 0; e < result[s].size(); e++)
+         chain.pList.Process(result[s][e]);
+   }
+}
+
+
+bool StationProcessingPool_T ::
+sameData(const gnssDataMap& gds,
+         const vector< vector<gnssRinex> >& result,
+         size_t skipStation, size_t skipEpoch) const
+{
+   size_t found(0);
+   for (size_t s = 0; s < numStations; s++)
+   {
+      for (size_t e = 0; e < result[s].size(); e++)
+      {
+         const gnssRinex& g(result[s][e]);
+
+            // Each station has its own entry for the epoch
+         const satTypeValueMap* body(0);
+         for (gnssDataMap::const_iterator it = gds.lower_bound(g.header.epoch);
+              it != gds.upper_bound(g.header.epoch) && body == 0;
+              ++it)
+         {
+            sourceDataMap::const_iterator itSrc(it->second.find(g.header.source));
+            if (itSrc != it->second.end())
+               body = &itSrc->second;
+         }
+
+         if (s == skipStation && e == skipEpoch)
+         {
+            if (body != 0)
+               return false;
+            continue;
+         }
+         if (body == 0 || !(*body == g.body))
+            return false;
+         found++;
+      }
+   }
+
+   size_t stored(0);
+   for (gnssDataMap::const_iterator it = gds.begin(); it != gds.end(); ++it)
+      stored += it->second.size();
+
+   return (found > 0 && found == stored);
+}
+
+
+int StationProcessingPool_T :: dataMapTest( void )
+{
+   TUDEF("StationProcessingPool", "Process(gnssDataMap)");
+
+   vector< vector<gnssRinex> > result;
+   reference(result);
+
+   for (unsigned threads = 1; threads <= 4; threads += 3)
+   {
+      vector<StationChain*> chains;
+      StationProcessingPool pool(threads);
+      pool.addSharedStore(store);
+      for (size_t s = 0; s < numStations; s++)
+      {
+         chains.push_back(new StationChain(nominalPos, store));
+         pool.addStation(input[s][0].header.source, chains.back()->pList);
+      }
+
+         // All the epochs at once
+      gnssDataMap gds;
+      for (size_t s = 0; s < numStations; s++)
+         for (size_t e = 0; e < input[s].size(); e++)
+            gds.addGnssRinex(input[s][e]);
+
+      pool.Process(gds);
+      TUASSERT(sameData(gds, result));
+      TUASSERTE(bool, threads > 1, pool.lastRunConcurrent());
+      TUASSERT(pool.getErrorTexts().empty());
+
+      for (size_t s = 0; s < chains.size(); s++)
+         delete chains[s];
+   }
+
+   TURETURN();
+}
+
+
+int StationProcessingPool_T :: vectorTest( void )
+{
+   TUDEF("StationProcessingPool", "Process(vector<gnssRinex>)");
+
+   vector< vector<gnssRinex> > result;
+   reference(result);
+
+      // One epoch of every station at a time, through the frozen index
+   store.freezeIndex();
+
+   vector<StationChain*> chains;
+   StationProcessingPool pool(4);
+   pool.addSharedStore(store);
+   for (size_t s = 0; s < numStations; s++)
+   {
+      chains.push_back(new StationChain(nominalPos, store));
+      pool.addStation(input[s][0].header.source, chains.back()->pList);
+   }
+
+   gnssDataMap gds;
+   bool allConcurrent(true);
+   for (size_t e = 0; e < input[0].size(); e++)
+   {
+      vector<gnssRinex> epoch;
+      for (size_t s = 0; s < numStations; s++)
+         epoch.push_back(input[s][e]);
+
+      pool.Process(epoch);
+      allConcurrent = allConcurrent && pool.lastRunConcurrent();
+
+      TUASSERTE(size_t, numStations, epoch.size());
+      for (size_t s = 0; s < epoch.size(); s++)
+         gds.addGnssRinex(epoch[s]);
+   }
+
+   TUASSERT(allConcurrent);
+   TUASSERT(sameData(gds, result));
+   TUASSERT(store.isIndexFrozen());
+
+   store.thawIndex();
+   for (size_t s = 0; s < chains.size(); s++)
+      delete chains[s];
+
+   TURETURN();
+}
+
+
+int StationProcessingPool_T :: storeTest( void )
+{
+   TUDEF("StationProcessingPool", "addSharedStore");
+
+      // The chains read a store that must be read serially
+   SerialStore serial(store);
+
+   vector< vector<gnssRinex> > result(input);
+   for (size_t s = 0; s < numStations; s++)
+   {
+      StationChain chain(nominalPos, serial);
+      for (size_t e = 0; e < result[s].size(); e++)
+         chain.pList.Process(result[s][e]);
+   }
+
+   vector<StationChain*> chains;
+   StationProcessingPool pool(4);
+   pool.addSharedStore(store);
+   pool.addSharedStore(serial);
+   for (size_t s = 0; s < numStations; s++)
+   {
+      chains.push_back(new StationChain(nominalPos, serial));
+      pool.addStation(input[s][0].header.source, chains.back()->pList);
+   }
+
+   gnssDataMap gds;
+   for (size_t s = 0; s < numStations; s++)
+      for (size_t e = 0; e < input[s].size(); e++)
+         gds.addGnssRinex(input[s][e]);
+
+   pool.Process(gds);
+   TUASSERT(!pool.lastRunConcurrent());
+   TUASSERT(sameData(gds, result));
+
+      // A stopped pool works on the calling thread
+   pool.setNumThreads(2);
+   vector<gnssRinex> epoch(1, input[0][0]);
+   epoch.push_back(input[1][0]);
+   pool.stop();
+   pool.Process(epoch);
+   TUASSERT(!pool.lastRunConcurrent());
+   TUASSERTE(size_t, 2, epoch.size());
+
+   for (size_t s = 0; s < chains.size(); s++)
+      delete chains[s];
+
+   TURETURN();
+}
+
+
+int StationProcessingPool_T :: errorTest( void )
+{
+   TUDEF("StationProcessingPool", "getErrorTexts");
+
+   const size_t badStation(2), badEpoch(10);
+
+   vector< vector<gnssRinex> > result;
+   reference(result);
+
+      // Rebuild the reference without the rejected epoch, which the
+      // detectors of that station then never see
+   {
+      StationChain chain(nominalPos, store);
+      result[badStation] = input[badStation];
+      for (size_t e = 0; e < result[badStation].size(); e++)
+      {
+         if (e != badEpoch)
+            chain.pList.Process(result[badStation][e]);
+      }
+   }
+
+   ThrowAt thrower(input[badStation][badEpoch].header.epoch);
+
+   vector<StationChain*> chains;
+   StationProcessingPool pool(3);
+   pool.addSharedStore(store);
+   for (size_t s = 0; s < numStations; s++)
+   {
+      chains.push_back(new StationChain(nominalPos, store));
+      if (s == badStation)
+         chains.back()->pList.push_front(thrower);
+      pool.addStation(input[s][0].header.source, chains.back()->pList);
+   }
+
+   gnssDataMap gds;
+   for (size_t s = 0; s < numStations; s++)
+      for (size_t e = 0; e < input[s].size(); e++)
+         gds.addGnssRinex(input[s][e]);
+
+   pool.Process(gds);
+   TUASSERTE(size_t, 1, pool.getErrorTexts().size());
+   TUASSERT(sameData(gds, result, badStation, badEpoch));
+
+      // The same through a vector of gnssRinex
+   vector<gnssRinex> epoch;
+   for (size_t s = 0; s < numStations; s++)
+      epoch.push_back(input[s][badEpoch]);
+   pool.Process(epoch);
+   TUASSERTE(size_t, 1, pool.getErrorTexts().size());
+   TUASSERTE(size_t, numStations - 1, epoch.size());
+   bool badGone(true);
+   for (size_t s = 0; s < epoch.size(); s++)
+      badGone = badGone &&
+                !(epoch[s].header.source ==
+                  input[badStation][0].header.source);
+   TUASSERT(badGone);
+
+   for (size_t s = 0; s < chains.size(); s++)
+      delete chains[s];
+
+   TURETURN();
+}
+
+
+int main()
+{
+   int errorTotal = 0;
+   StationProcessingPool_T testClass;
+
+   errorTotal += testClass.dataMapTest();
+   errorTotal += testClass.vectorTest();
+   errorTotal += testClass.storeTest();
+   errorTotal += testClass.errorTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return( errorTotal );
+}
@@ -0,0 +1,281 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S.
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software.
+//
+//Pursuant to DoD Directive 523024
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+
+
+   /* Check the dense indices of TypeID, the string round trip, the
+    * frozen registry, and that TypeIDBitSet and the satTypeValueMap
+    * operations built on it agree with TypeIDSet. */
+
+#include "TypeID.hpp"
+#include "DataStructures.hpp"
+
+#include "TestUtil.hpp"
+#include <iostream>
+
+using namespace std;
+using namespace gpstk;
+
+//============================================================
+// Class decalarations
+//============================================================
+
+class TypeID_T
+{
+public:
+
+      // return values indicate number of failures, i.e., 0=PASS, !0=FAIL
+   int indexTest( void );
+   int stringTest( void );
+   int registryTest( void );
+   int bitSetTest( void );
+};
+
+
+int TypeID_T :: indexTest( void )
+{
+   TUDEF("TypeID", "index");
+
+      // Built-in types keep their enum values
+   TUASSERTE(int, int(TypeID::C1), TypeID(TypeID::C1).index());
+   TUASSERTE(int, int(TypeID::Last), TypeID(TypeID::Last).index());
+   TUASSERTE(int, int(TypeID::Last) + 1, TypeID(TypeID::Placeholder).index());
+
+      // New types follow without gaps
+   const int before( TypeID::numIndices() );
+   TypeID t1( TypeID::newValueType("indexTest1") );
+   TypeID t2( TypeID::newValueType("indexTest2") );
+   TUASSERTE(int, before, t1.index());
+   TUASSERTE(int, before + 1, t2.index());
+   TUASSERTE(int, before + 2, TypeID::numIndices());
+
+      // Every index maps back to its type
+   bool allBack(true);
+   for (int i = 0; i < TypeID::numIndices(); i++)
+   {
+      allBack = allBack && ( TypeID::fromIndex(i).index() == i );
+   }
+   TUASSERT(allBack);
+   TUASSERT(TypeID::fromIndex(t2.index()) == t2);
+
+   TURETURN();
+}
+
+
+int TypeID_T :: stringTest( void )
+{
+   TUDEF("TypeID", "fromString");
+
+      // Every registered type survives asString() and back
+   bool allBack(true);
+   for (std::map<TypeID::ValueType, std::string>::const_iterator it =
+           TypeID::tStrings.begin();
+        it != TypeID::tStrings.end();
+        ++it)
+   {
+      TypeID type(it->first);
+      allBack = allBack &&
+                ( TypeID::fromString( StringUtils::asString(type) ) == type );
+   }
+   TUASSERT(allBack);
+
+   TUASSERT(TypeID::fromString("prefitResidualCode") == TypeID::prefitC);
+
+      // Names given to regByName() are accepted too
+   TypeID reg( TypeID::regByName("stringTestName", "stringTest description") );
+   TUASSERT(TypeID::fromString("stringTestName") == reg);
+   TUASSERT(TypeID::fromString("stringTest description") == reg);
+
+   try
+   {
+      TypeID::fromString("noSuchType");
+      TUFAIL("fromString() accepted an unknown string");
+   }
+   catch (InvalidRequest&)
+   {
+      TUPASS("fromString() rejected an unknown string");
+   }
+
+      // Once unregistered, the description is gone
+   TypeID::unregByName("stringTestName");
+   try
+   {
+      TypeID::fromString("stringTest description");
+      TUFAIL("fromString() accepted an unregistered type");
+   }
+   catch (InvalidRequest&)
+   {
+      TUPASS("fromString() rejected an unregistered type");
+   }
+
+   TURETURN();
+}
+
+
+int TypeID_T :: registryTest( void )
+{
+   TUDEF("TypeID", "freezeRegistry");
+
+   TUASSERT(!TypeID::isRegistryFrozen());
+   TypeID::regByName("registryTestName", "registryTest description");
+
+   TypeID::freezeRegistry();
+   TUASSERT(TypeID::isRegistryFrozen());
+   const int frozenSize( TypeID::numIndices() );
+
+   try
+   {
+      TypeID::newValueType("registryTest");
+      TUFAIL("newValueType() worked on a frozen registry");
+   }
+   catch (InvalidRequest&)
+   {
+      TUPASS("newValueType() refused on a frozen registry");
+   }
+
+   try
+   {
+      TypeID::unregByName("registryTestName");
+      TUFAIL("unregByName() worked on a frozen registry");
+   }
+   catch (InvalidRequest&)
+   {
+      TUPASS("unregByName() refused on a frozen registry");
+   }
+   TUASSERTE(int, frozenSize, TypeID::numIndices());
+
+      // Lookups still work
+   TUASSERT(TypeID::byName("registryTestName") ==
+            TypeID::fromString("registryTest description"));
+
+   TypeID::thawRegistry();
+   TUASSERT(!TypeID::isRegistryFrozen());
+   TypeID::unregByName("registryTestName");
+
+   TURETURN();
+}
+
+
+int TypeID_T :: bitSetTest( void )
+{
+   TUDEF("TypeIDBitSet", "contains");
+
+   TypeID user( TypeID::newValueType("bitSetTest") );
+
+   TypeIDSet typeSet;
+   typeSet.insert(TypeID::C1);
+   typeSet.insert(TypeID::L2);
+   typeSet.insert(TypeID::Last);
+   typeSet.insert(user);
+
+   TypeIDBitSet bits(typeSet);
+   TUASSERTE(size_t, typeSet.size(), bits.size());
+   TUASSERT(bits.toSet() == typeSet);
+   TUASSERT(bits.contains(TypeID::C1));
+   TUASSERT(bits.contains(user));
+   TUASSERT(!bits.contains(TypeID::P1));
+   TUASSERT(!bits.contains(TypeID::Placeholder));
+
+   TypeIDBitSet sub;
+   sub.insert(TypeID::L2).insert(user);
+   TUASSERT(bits.containsAll(sub));
+   TUASSERT(!sub.containsAll(bits));
+   TUASSERT(sub.intersects(bits));
+
+   sub.erase(TypeID::L2).erase(user);
+   TUASSERT(sub.empty());
+   TUASSERT(!sub.intersects(bits));
+   TUASSERT(bits.containsAll(sub));
+
+   testFramework.changeSourceMethod("keepOnlyTypeID");
+
+      // satTypeValueMap operations agree with the TypeIDSet versions
+      // built on extractTypeID()
+   satTypeValueMap stvMap;
+   for (int prn = 1; prn <= 8; prn++)
+   {
+      SatID sat(prn, SatID::systemGPS);
+      stvMap[sat][TypeID::P1] = prn;
+      stvMap[sat][TypeID::L2] = 2 * prn;
+      if (prn % 2)
+      {
+         stvMap[sat][TypeID::C1] = 3 * prn;
+         stvMap[sat][user] = 4 * prn;
+      }
+   }
+
+   TypeIDSet keepSet;
+   keepSet.insert(TypeID::C1);
+   keepSet.insert(user);
+
+   satTypeValueMap kept(stvMap);
+   kept.keepOnlyTypeID(keepSet);
+   TUASSERT(kept == stvMap.extractTypeID(keepSet));
+   TUASSERTE(size_t, 4, kept.numSats());
+
+   testFramework.changeSourceMethod("removeTypeID");
+
+   satTypeValueMap removed(stvMap);
+   removed.removeTypeID(keepSet);
+   satTypeValueMap expected(stvMap);
+   for (satTypeValueMap::iterator it = expected.begin();
+        it != expected.end();
+        ++it)
+   {
+      it->second.erase(TypeID::C1);
+      it->second.erase(user);
+   }
+   TUASSERT(removed == expected);
+   TUASSERTE(size_t, 8, removed.numSats());
+
+   TURETURN();
+}
+
+
+int main()
+{
+   int errorTotal = 0;
+   TypeID_T testClass;
+
+   errorTotal += testClass.indexTest();
+   errorTotal += testClass.stringTest();
+   errorTotal += testClass.registryTest();
+   errorTotal += testClass.bitSetTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return( errorTotal );
+}
@@ -0,0 +1,177 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+/**
+ * @file TestSupport.hpp
+ * Helpers shared by the tests and timing programs under ext/tests: a
+ * reproducible random number generator, a wall clock, and epochs of
+ * synthetic observations and prefit data for the Procframe classes.
+ */
+
+#ifndef GPSTK_EXT_TESTSUPPORT_HPP
+#define GPSTK_EXT_TESTSUPPORT_HPP
+
+#include "DataStructures.hpp"
+#include "GPSWeekSecond.hpp"
+#include "StringUtils.hpp"
+#include "SystemTime.hpp"
+
+#include <cmath>
+
+namespace gpstk
+{
+      /// Advance the linear congruential generator of the tests and
+      /// return its new state.
+   inline unsigned nextRandom(unsigned& seed)
+   {
+      seed = seed * 1103515245u + 12345u;
+      return seed;
+   }
+
+      /// A reproducible value in [-1,1)
+   inline double uniform(unsigned& seed)
+   {
+      return double((nextRandom(seed) >> 8) % 20000) / 10000.0 - 1.0;
+   }
+
+      /// Seconds of wall clock time since 'start'
+   inline double elapsed(const CommonTime& start)
+   {
+      return SystemTime().convertToCommonTime() - start;
+   }
+
+      /** Epoch n, every 30 s, of synthetic dual frequency observations
+       * with the types of a typical RINEX file.
+       * @param[in] n the epoch number
+       * @param[in,out] seed the state of nextRandom()
+       * @param[in] faults if false, each of 32 satellites is in view 3
+       *  blocks of 40 epochs out of 8. If true, up to 12 satellites
+       *  arrive out of order, those with PRN a multiple of 5 have no
+       *  P2, and those with PRN a multiple of 7 have P1 out of bounds. */
+   inline gnssRinex makeObsEpoch(int n, unsigned& seed, bool faults = false)
+   {
+      gnssRinex gRin;
+      gRin.header.source = SourceID(SourceID::GPS, faults ? "TEST" : "BENCH");
+      gRin.header.epoch = GPSWeekSecond(1800, 3600.0 + 30.0 * n);
+      gRin.header.epochFlag = 0;
+      for (int i = 0; i < (faults ? 12 : 32); i++)
+      {
+         const int prn( faults ? (7 * i + n) % 31 + 1 : i + 1 );
+         if (faults ? (prn + n) % 9 == 0 : (n / 40 + 3 * prn) % 8 >= 3)
+            continue;
+         typeValueMap& tv(gRin.body[SatID(prn, SatID::systemGPS)]);
+         const double rho(2.2e7 + 1.0e6 * uniform(seed));
+         tv[TypeID::C1] = rho + uniform(seed);
+         tv[TypeID::P1] = rho + uniform(seed);
+         if (faults)
+         {
+            tv[TypeID::L1] = rho + 0.01 * uniform(seed);
+            tv[TypeID::L2] = rho + 0.01 * uniform(seed);
+            if (prn % 5 != 0)
+               tv[TypeID::P2] = rho + uniform(seed);
+            if (prn % 7 == 0)
+               tv[TypeID::P1] = 1.0e5;
+         }
+         else
+         {
+            tv[TypeID::P2] = rho + uniform(seed);
+            tv[TypeID::L1] = rho + 0.01 * uniform(seed);
+            tv[TypeID::L2] = rho + 0.01 * uniform(seed);
+            tv[TypeID::D1] = 1000.0 * uniform(seed);
+            tv[TypeID::D2] = 1000.0 * uniform(seed);
+            tv[TypeID::S1] = 45.0;
+            tv[TypeID::S2] = 40.0;
+            tv[TypeID::SSI1] = 7.0;
+            tv[TypeID::SSI2] = 7.0;
+         }
+         tv[TypeID::LLI1] = 0.0;
+         tv[TypeID::LLI2] = 0.0;
+      }
+      return gRin;
+   }
+
+      /** Epoch n, every 30 s, of synthetic prefit data for the
+       * coordinates, clock and wet troposphere of a receiver: dx, dy,
+       * dz, wetMap, prefitC, prefitL and weight.
+       * @param[in] n the epoch number
+       * @param[in] numSats satellites have PRN 1 to numSats
+       * @param[in,out] seed the state of nextRandom()
+       * @param[in] source the source of the data
+       * @param[in] rising if true, each satellite is in view 40 epochs
+       *  out of 50, starting at a different epoch for each satellite
+       *  and each offset; else all are always in view
+       * @param[in] offset shifts the visibility of all satellites */
+   inline gnssRinex makePrefitEpoch(int n, int numSats, unsigned& seed,
+                                    const SourceID& source,
+                                    bool rising = true, int offset = 0)
+   {
+      gnssRinex gRin;
+      gRin.header.source = source;
+      gRin.header.epoch = GPSWeekSecond(1800, 3600.0 + 30.0 * n);
+      for (int prn = 1; prn <= numSats; prn++)
+      {
+         if (rising && (n + 5 * prn + offset) % 50 >= 40)
+            continue;
+         typeValueMap& tv(gRin.body[SatID(prn, SatID::systemGPS)]);
+         tv[TypeID::dx] = uniform(seed);
+         tv[TypeID::dy] = uniform(seed);
+         tv[TypeID::dz] = uniform(seed);
+         tv[TypeID::wetMap] = 1.0 + 0.5 * std::fabs(uniform(seed));
+         tv[TypeID::prefitC] = 10.0 * uniform(seed);
+         tv[TypeID::prefitL] = 0.1 * uniform(seed);
+         tv[TypeID::weight] = 0.5 + std::fabs(uniform(seed));
+      }
+      return gRin;
+   }
+
+      /// As makePrefitEpoch(), for stations "S0", "S1", ..., with the
+      /// station number as offset
+   inline gnssDataMap makePrefitNetwork(int n, int stations, int numSats,
+                                        unsigned& seed, bool rising = true)
+   {
+      gnssDataMap gdsMap;
+      for (int s = 0; s < stations; s++)
+      {
+         SourceID source(SourceID::GPS, "S" + StringUtils::asString(s));
+         gdsMap.addGnssRinex(makePrefitEpoch(n, numSats, seed, source,
+                                             rising, s));
+      }
+      return gdsMap;
+   }
+
+}  // namespace gpstk
+
+#endif // GPSTK_EXT_TESTSUPPORT_HPP